@@ -253,7 +253,7 @@ function(mindspore_add_pkg pkg_name )
 
     if (NOT PKG_DIR)
 	if (PKG_GIT_REPOSITORY)
-	    __download_pkg_with_git(${pkg_name} ${PKG_GIT_REPOSITORY} ${PKG_GIT_TAG} ${PKG_MD5})
+	    __download_pkg_with_git(${pkg_name} ${PKG_GIT_REPOSITORY} ${PKG_GIT_TAG} "${PKG_MD5}")
 	else()
             __download_pkg(${pkg_name} ${PKG_URL} ${PKG_MD5})
 	endif()
@@ -59,7 +59,8 @@ static std::unordered_map<uint32_t, pFunction> g_parse_op_func_ = {{kStorage, &D
                                                                    {kVoc, &DEPipeline::ParseVOCOp},
                                                                    {kCifar10, &DEPipeline::ParseCifar10Op},
                                                                    {kCifar100, &DEPipeline::ParseCifar100Op},
-                                                                   {kCelebA, &DEPipeline::ParseCelebAOp}};
+                                                                   {kCelebA, &DEPipeline::ParseCelebAOp},
+                                                                   {kCache, &DEPipeline::ParseCacheOp}};
 
 DEPipeline::DEPipeline() : iterator_(nullptr) {
   try {
@@ -117,12 +118,33 @@ Status DEPipeline::AssignRootNode(const DsOpPtr &dataset_op) { return (tree_->As
 // Function to launch the tree execution.
 Status DEPipeline::LaunchTreeExec() {
   RETURN_IF_NOT_OK(tree_->Prepare());
+  if (!restore_state_.empty()) {
+    nlohmann::json state;
+    try {
+      state = nlohmann::json::parse(restore_state_);
+    } catch (const nlohmann::json::exception &e) {
+      RETURN_STATUS_UNEXPECTED("Invalid pipeline state: " + std::string(e.what()));
+    }
+    RETURN_IF_NOT_OK(tree_->RestoreState(state));
+  }
   RETURN_IF_NOT_OK(tree_->Launch());
   iterator_ = std::make_unique<DatasetIterator>(tree_);
   if (iterator_ == nullptr) RETURN_STATUS_UNEXPECTED("Cannot create an Iterator.");
   return Status::OK();
 }
 
+Status DEPipeline::SaveState(int64_t num_rows, std::string *state) {
+  nlohmann::json tree_state;
+  RETURN_IF_NOT_OK(tree_->SaveState(num_rows, &tree_state));
+  *state = tree_state.dump();
+  return Status::OK();
+}
+
+Status DEPipeline::SetRestoreState(const std::string &state) {
+  restore_state_ = state;
+  return Status::OK();
+}
+
 void DEPipeline::PrintTree() {
   for (auto itr = tree_->begin(); itr != tree_->end(); ++itr) {
     std::stringstream ss;
@@ -261,6 +283,23 @@ std::vector<DataType> ToTypeVector(const py::handle handle) {
   return vector;
 }
 
+PadInfo ToPadInfo(const py::handle handle) {
+  py::dict dict = py::reinterpret_borrow<py::dict>(handle);
+  PadInfo pad_info;
+  for (auto p : dict) {
+    py::tuple shape_and_value = py::reinterpret_borrow<py::tuple>(p.second);
+    std::vector<dsize_t> shape;
+    if (!shape_and_value[0].is_none()) {
+      for (auto dim : py::reinterpret_borrow<py::list>(shape_and_value[0])) {
+        shape.push_back(dim.is_none() ? TensorShape::kDimUnknown : ToInt(dim));
+      }
+    }
+    float value = shape_and_value[1].is_none() ? 0 : py::cast<float>(shape_and_value[1]);
+    (void)pad_info.insert(std::make_pair(ToString(p.first), std::make_pair(TensorShape(shape), value)));
+  }
+  return pad_info;
+}
+
 Status DEPipeline::SetBatchParameters(const py::dict &args) {
   if (args["batch_size"].is_none()) {
     std::string err_msg = "Error: batchSize is invalid or not set.";
@@ -353,12 +392,50 @@ Status DEPipeline::ParseShuffleOp(const py::dict &args, std::shared_ptr<DatasetO
     std::string err_msg = "Error: Shuffle buffer size is missing";
     RETURN_STATUS_UNEXPECTED(err_msg);
   }
+  // Optional arguments
+  for (auto arg : args) {
+    std::string key = py::str(arg.first);
+    py::handle value = arg.second;
+    if (!value.is_none()) {
+      if (key == "mem_size") {
+        (void)builder->SetMemSize(ToInt(value));
+      } else if (key == "block_size") {
+        (void)builder->SetBlockSize(ToInt(value));
+      } else if (key == "spill_dir") {
+        (void)builder->SetSpillDir(ToString(value));
+      }
+    }
+  }
   std::shared_ptr<ShuffleOp> op;
   RETURN_IF_NOT_OK(builder->Build(&op));
   *ptr = op;
   return Status::OK();
 }
 
+Status DEPipeline::ParseCacheOp(const py::dict &args, std::shared_ptr<DatasetOp> *ptr) {
+  std::shared_ptr<CacheOp::Builder> builder = std::make_shared<CacheOp::Builder>();
+  // Optional arguments
+  for (auto arg : args) {
+    std::string key = py::str(arg.first);
+    py::handle value = arg.second;
+    if (!value.is_none()) {
+      if (key == "mem_size") {
+        (void)builder->SetMemSize(ToInt(value));
+      } else if (key == "spill_dir") {
+        (void)builder->SetSpillDir(ToString(value));
+      } else if (key == "sampler") {
+        auto create = py::reinterpret_borrow<py::object>(value).attr("create");
+        std::shared_ptr<Sampler> sampler = create().cast<std::shared_ptr<Sampler>>();
+        (void)builder->SetSampler(std::move(sampler));
+      }
+    }
+  }
+  std::shared_ptr<CacheOp> op;
+  RETURN_IF_NOT_OK(builder->Build(&op));
+  *ptr = op;
+  return Status::OK();
+}
+
 Status DEPipeline::CheckMindRecordPartitionInfo(const py::dict &args, std::vector<int> *in_partitions) {
   if (args["partitions"].is_none()) {
     std::string err_msg = "Error: partitions is not set (None)";
@@ -419,6 +496,10 @@ Status DEPipeline::ParseMindRecordOp(const py::dict &args, std::shared_ptr<Datas
         (void)builder->SetNumMindRecordWorkers(ToInt(value));
       } else if (key == "block_reader" && ToBool(value) == true) {
         (void)builder->SetBlockReader();
+      } else if (key == "use_mmap" && ToBool(value) == true) {
+        (void)builder->SetUseMmap();
+      } else if (key == "io_depth") {
+        (void)builder->SetIoDepth(ToInt(value));
       } else if (key == "global_shuffle" && ToBool(value) == true) {
         uint32_t seed = args["partitions"].is_none() ? GetSeed() : 0;
         operators.push_back(std::make_shared<mindrecord::ShardShuffle>(seed));
@@ -567,8 +648,18 @@ Status DEPipeline::ParseBatchOp(const py::dict &args, std::shared_ptr<DatasetOp>
       if (key == "input_columns") {
         (void)builder->SetColumnsToMap(ToStringVector(value));
       }
+      if (key == "pad_info") {
+        (void)builder->SetPaddingMap(ToPadInfo(value));
+      }
     }
   }
+  if (args.contains("length_column") && !args["length_column"].is_none()) {
+    std::vector<int> boundaries = ToIntVector(args["bucket_boundaries"]);
+    std::vector<int> batch_sizes = ToIntVector(args["bucket_batch_sizes"]);
+    (void)builder->SetBucketing(ToString(args["length_column"]),
+                                std::vector<int32_t>(boundaries.begin(), boundaries.end()),
+                                std::vector<int32_t>(batch_sizes.begin(), batch_sizes.end()));
+  }
 
   std::shared_ptr<BatchOp> op;
   RETURN_IF_NOT_OK(builder->Build(&op));
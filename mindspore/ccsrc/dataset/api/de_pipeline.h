@@ -76,9 +76,15 @@ class DEPipeline {
   // Function to assign the node as root.
   Status AssignRootNode(const DsOpPtr &dataset_op);
 
-  // Function to launch the tree execution.
+  // Function to launch the tree execution. A state set by SetRestoreState is restored before the launch.
   Status LaunchTreeExec();
 
+  // Save the state of the pipeline, as a json string, after num_rows rows were taken from it.
+  Status SaveState(int64_t num_rows, std::string *state);
+
+  // Set a state saved by SaveState, the pipeline resumes from it when the tree is launched.
+  Status SetRestoreState(const std::string &state);
+
   // Get a row of data as dictionary of column name to the value.
   Status GetNextAsMap(py::dict *output);
 
@@ -99,6 +105,8 @@ class DEPipeline {
 
   Status ParseShuffleOp(const py::dict &args, std::shared_ptr<DatasetOp> *ptr);
 
+  Status ParseCacheOp(const py::dict &args, std::shared_ptr<DatasetOp> *ptr);
+
   Status CheckMindRecordPartitionInfo(const py::dict &args, std::vector<int> *ptr);
 
   Status ParseMindRecordOp(const py::dict &args, std::shared_ptr<DatasetOp> *ptr);
@@ -151,6 +159,9 @@ class DEPipeline {
 
   std::unique_ptr<DatasetIterator> iterator_;
 
+  // State to restore at launch, empty to start from the beginning
+  std::string restore_state_;
+
   // Validate required args passed to storage op.
   Status ValidateArgStorageOp(const py::dict &args);
 
@@ -25,6 +25,7 @@
 #include "dataset/kernels/image/distort_bounding_box_crop_op.h"
 #include "dataset/kernels/image/hwc_to_chw_op.h"
 #include "dataset/kernels/image/image_utils.h"
+#include "dataset/kernels/image/normalize_hwc_to_chw_op.h"
 #include "dataset/kernels/image/normalize_op.h"
 #include "dataset/kernels/image/pad_op.h"
 #include "dataset/kernels/image/random_color_adjust_op.h"
@@ -46,6 +47,7 @@
 #include "dataset/engine/datasetops/source/manifest_op.h"
 #include "dataset/engine/datasetops/source/mindrecord_op.h"
 #include "dataset/engine/datasetops/source/sampler/distributed_sampler.h"
+#include "dataset/engine/datasetops/source/sampler/elastic_distributed_sampler.h"
 #include "dataset/engine/datasetops/source/sampler/pk_sampler.h"
 #include "dataset/engine/datasetops/source/sampler/random_sampler.h"
 #include "dataset/engine/datasetops/source/sampler/sequential_sampler.h"
@@ -91,6 +93,14 @@ void bindDEPipeline(py::module *m) {
     .def("SetBatchParameters",
          [](DEPipeline &de, const py::dict &args) { THROW_IF_ERROR(de.SetBatchParameters(args)); })
     .def("LaunchTreeExec", [](DEPipeline &de) { THROW_IF_ERROR(de.LaunchTreeExec()); })
+    .def("SaveState",
+         [](DEPipeline &de, int64_t num_rows) {
+           std::string state;
+           THROW_IF_ERROR(de.SaveState(num_rows, &state));
+           return state;
+         })
+    .def("SetRestoreState",
+         [](DEPipeline &de, const std::string &state) { THROW_IF_ERROR(de.SetRestoreState(state)); })
     .def("GetNextAsMap",
          [](DEPipeline &de) {
            py::dict out;
@@ -186,11 +196,25 @@ void bindTensor(py::module *m) {
     .def("set_worker_connector_size", &ConfigManager::set_worker_connector_size)
     .def("set_op_connector_size", &ConfigManager::set_op_connector_size)
     .def("set_seed", &ConfigManager::set_seed)
+    .def("set_lock_free_connector", &ConfigManager::set_lock_free_connector)
+    .def("set_auto_tune", &ConfigManager::set_auto_tune)
+    .def("set_auto_tune_interval", &ConfigManager::set_auto_tune_interval)
+    .def("set_auto_tune_cpu_budget", &ConfigManager::set_auto_tune_cpu_budget)
+    .def("set_profiling_dir", &ConfigManager::set_profiling_dir)
+    .def("set_profiling_interval", &ConfigManager::set_profiling_interval)
+    .def("set_pinned_memory", &ConfigManager::set_pinned_memory)
     .def("get_rows_per_buffer", &ConfigManager::rows_per_buffer)
     .def("get_num_parallel_workers", &ConfigManager::num_parallel_workers)
     .def("get_worker_connector_size", &ConfigManager::worker_connector_size)
     .def("get_op_connector_size", &ConfigManager::op_connector_size)
     .def("get_seed", &ConfigManager::seed)
+    .def("get_lock_free_connector", &ConfigManager::lock_free_connector)
+    .def("get_auto_tune", &ConfigManager::auto_tune)
+    .def("get_auto_tune_interval", &ConfigManager::auto_tune_interval)
+    .def("get_auto_tune_cpu_budget", &ConfigManager::auto_tune_cpu_budget)
+    .def("get_profiling_dir", &ConfigManager::profiling_dir)
+    .def("get_profiling_interval", &ConfigManager::profiling_interval)
+    .def("get_pinned_memory", &ConfigManager::pinned_memory)
     .def("load", [](ConfigManager &c, std::string s) { (void)c.LoadFile(s); });
 
   (void)py::class_<Tensor, std::shared_ptr<Tensor>>(*m, "Tensor", py::buffer_protocol())
@@ -234,6 +258,12 @@ void bindTensorOps1(py::module *m) {
     .def(py::init<float, float, float, float, float, float>(), py::arg("meanR"), py::arg("meanG"), py::arg("meanB"),
          py::arg("stdR"), py::arg("stdG"), py::arg("stdB"));
 
+  (void)py::class_<NormalizeHwcToChwOp, TensorOp, std::shared_ptr<NormalizeHwcToChwOp>>(
+    *m, "NormalizeHwcToChwOp",
+    "Tensor operation to normalize an image and transpose it to CHW. Takes mean, std and whether to cast to float16.")
+    .def(py::init<float, float, float, float, float, float, bool>(), py::arg("meanR"), py::arg("meanG"),
+         py::arg("meanB"), py::arg("stdR"), py::arg("stdG"), py::arg("stdB"), py::arg("toFloat16") = false);
+
   (void)py::class_<RescaleOp, TensorOp, std::shared_ptr<RescaleOp>>(
     *m, "RescaleOp", "Tensor operation to rescale an image. Takes scale and shift.")
     .def(py::init<float, float>(), py::arg("rescale"), py::arg("shift"));
@@ -391,6 +421,11 @@ void bindSamplerOps(py::module *m) {
     .def(py::init<int64_t, int64_t, bool, uint32_t>(), py::arg("numDev"), py::arg("devId"), py::arg("shuffle"),
          py::arg("seed"));
 
+  (void)py::class_<ElasticDistributedSampler, Sampler, std::shared_ptr<ElasticDistributedSampler>>(
+    *m, "ElasticDistributedSampler")
+    .def(py::init<int64_t, int64_t, bool, uint32_t, int64_t, int64_t>(), py::arg("numDev"), py::arg("devId"),
+         py::arg("shuffle"), py::arg("seed"), py::arg("epoch"), py::arg("offset"));
+
   (void)py::class_<PKSampler, Sampler, std::shared_ptr<PKSampler>>(*m, "PKSampler")
     .def(py::init<int64_t, bool>(), py::arg("kVal"), py::arg("shuffle"));
 
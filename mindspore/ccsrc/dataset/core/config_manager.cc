@@ -15,9 +15,11 @@
  */
 #include "dataset/core/config_manager.h"
 
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 #include <string>
+#include <thread>
 
 #include "dataset/util/system_pool.h"
 
@@ -31,7 +33,12 @@ void ConfigManager::Print(std::ostream &out) const {
       << "\nDataCache Rows per buffer    : " << rows_per_buffer_
       << "\nParallelOp workers           : " << num_parallel_workers_
       << "\nParallelOp worker connector size    : " << worker_connector_size_
-      << "\nSize of each Connector : " << op_connector_size_ << std::endl;
+      << "\nSize of each Connector : " << op_connector_size_
+      << "\nLock free Connector    : " << std::boolalpha << lock_free_connector_ << std::noboolalpha
+      << "\nAuto tune              : " << std::boolalpha << auto_tune_ << std::noboolalpha
+      << "\nAuto tune interval(ms) : " << auto_tune_interval_ << "\nAuto tune CPU budget   : " << auto_tune_cpu_budget()
+      << "\nProfiling directory    : " << profiling_dir_ << "\nProfiling interval(ms) : " << profiling_interval_
+      << "\nPinned memory          : " << std::boolalpha << pinned_memory_ << std::noboolalpha << std::endl;
 }
 
 // Private helper function that taks a nlohmann json format and populates the settings
@@ -41,6 +48,13 @@ Status ConfigManager::FromJson(const nlohmann::json &j) {
   set_worker_connector_size(j.value("workerConnectorSize", worker_connector_size_));
   set_op_connector_size(j.value("opConnectorSize", op_connector_size_));
   set_seed(j.value("seed", seed_));
+  set_lock_free_connector(j.value("lockFreeConnector", lock_free_connector_));
+  set_auto_tune(j.value("autoTune", auto_tune_));
+  set_auto_tune_interval(j.value("autoTuneInterval", auto_tune_interval_));
+  set_auto_tune_cpu_budget(j.value("autoTuneCpuBudget", auto_tune_cpu_budget_));
+  set_profiling_dir(j.value("profilingDir", profiling_dir_));
+  set_profiling_interval(j.value("profilingInterval", profiling_interval_));
+  set_pinned_memory(j.value("pinnedMemory", pinned_memory_));
   return Status::OK();
 }
 
@@ -85,6 +99,34 @@ void ConfigManager::set_worker_connector_size(int32_t connector_size) { worker_c
 // Setter function
 void ConfigManager::set_op_connector_size(int32_t connector_size) { op_connector_size_ = connector_size; }
 
+// Setter function
+void ConfigManager::set_lock_free_connector(bool lock_free) { lock_free_connector_ = lock_free; }
+
+// Setter function
+void ConfigManager::set_auto_tune(bool auto_tune) { auto_tune_ = auto_tune; }
+
+// Setter function
+void ConfigManager::set_auto_tune_interval(uint32_t interval) { auto_tune_interval_ = interval; }
+
+// Setter function
+void ConfigManager::set_auto_tune_cpu_budget(int32_t budget) { auto_tune_cpu_budget_ = budget; }
+
+// Setter function
+void ConfigManager::set_profiling_dir(const std::string &dir) { profiling_dir_ = dir; }
+
+// Setter function
+void ConfigManager::set_profiling_interval(uint32_t interval) { profiling_interval_ = interval; }
+
+// Setter function
+void ConfigManager::set_pinned_memory(bool pinned) { pinned_memory_ = pinned; }
+
+int32_t ConfigManager::auto_tune_cpu_budget() const {
+  if (auto_tune_cpu_budget_ > 0) {
+    return auto_tune_cpu_budget_;
+  }
+  return std::max(1, static_cast<int32_t>(std::thread::hardware_concurrency()));
+}
+
 uint32_t ConfigManager::seed() const { return seed_; }
 
 void ConfigManager::set_seed(uint32_t seed) { seed_ = seed; }
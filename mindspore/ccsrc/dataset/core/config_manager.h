@@ -105,6 +105,62 @@ class ConfigManager {
   // @param connector_size - The setting to apply to the config
   void set_op_connector_size(int32_t connector_size);
 
+  // getter function
+  // @return Whether connectors are built on the lock free ring queue
+  bool lock_free_connector() const { return lock_free_connector_; }
+
+  // setter function
+  // @param lock_free - The setting to apply to the config
+  void set_lock_free_connector(bool lock_free);
+
+  // getter function
+  // @return Whether the execution tree tunes workers and connectors at runtime
+  bool auto_tune() const { return auto_tune_; }
+
+  // setter function
+  // @param auto_tune - The setting to apply to the config
+  void set_auto_tune(bool auto_tune);
+
+  // getter function
+  // @return The auto tune sampling interval in milliseconds
+  uint32_t auto_tune_interval() const { return auto_tune_interval_; }
+
+  // setter function
+  // @param interval - The setting to apply to the config
+  void set_auto_tune_interval(uint32_t interval);
+
+  // getter function
+  // @return The maximum number of active workers the auto tuner may hand out across all ops
+  int32_t auto_tune_cpu_budget() const;
+
+  // setter function
+  // @param budget - The setting to apply to the config. 0 means the number of cores.
+  void set_auto_tune_cpu_budget(int32_t budget);
+
+  // getter function
+  // @return The directory the pipeline profiler writes to. Profiling is off if empty.
+  std::string profiling_dir() const { return profiling_dir_; }
+
+  // setter function
+  // @param dir - The setting to apply to the config
+  void set_profiling_dir(const std::string &dir);
+
+  // getter function
+  // @return The profiler sampling interval in milliseconds
+  uint32_t profiling_interval() const { return profiling_interval_; }
+
+  // setter function
+  // @param interval - The setting to apply to the config
+  void set_profiling_interval(uint32_t interval);
+
+  // getter function
+  // @return Whether the data of new Tensors is allocated from the pinned, page aligned pool
+  bool pinned_memory() const { return pinned_memory_; }
+
+  // setter function
+  // @param pinned - The setting to apply to the config
+  void set_pinned_memory(bool pinned);
+
   uint32_t seed() const;
 
   // setter function
@@ -117,6 +173,13 @@ class ConfigManager {
   int32_t worker_connector_size_{kCfgWorkerConnectorSize};
   int32_t op_connector_size_{kCfgOpConnectorSize};
   uint32_t seed_{kCfgDefaultSeed};
+  bool lock_free_connector_{kCfgLockFreeConnector};
+  bool auto_tune_{kCfgAutoTune};
+  uint32_t auto_tune_interval_{kCfgAutoTuneInterval};
+  int32_t auto_tune_cpu_budget_{kCfgAutoTuneCpuBudget};
+  std::string profiling_dir_;
+  uint32_t profiling_interval_{kCfgProfilingInterval};
+  bool pinned_memory_{kCfgPinnedMemory};
 
   // Private helper function that taks a nlohmann json format and populates the settings
   // @param j - The json nlohmann json info
@@ -47,6 +47,12 @@ constexpr uint32_t kCfgParallelWorkers = 4;
 constexpr uint32_t kCfgWorkerConnectorSize = 16;
 constexpr uint32_t kCfgOpConnectorSize = 16;
 constexpr uint32_t kCfgDefaultSeed = std::mt19937::default_seed;
+constexpr bool kCfgLockFreeConnector = false;
+constexpr bool kCfgAutoTune = false;
+constexpr uint32_t kCfgAutoTuneInterval = 100;  // milliseconds
+constexpr int32_t kCfgAutoTuneCpuBudget = 0;    // 0 means the number of cores
+constexpr uint32_t kCfgProfilingInterval = 100;  // milliseconds
+constexpr bool kCfgPinnedMemory = false;
 
 // Invalid OpenCV type should not be from 0 to 7 (opencv4/opencv2/core/hal/interface.h)
 constexpr uint8_t kCVInvalidType = 255;
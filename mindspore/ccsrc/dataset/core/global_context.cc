@@ -23,6 +23,7 @@
 #include "dataset/core/tensor.h"
 #include "dataset/util/allocator.h"
 #include "dataset/util/circular_pool.h"
+#include "dataset/util/pinned_pool.h"
 #include "dataset/util/system_pool.h"
 
 namespace mindspore {
@@ -52,6 +53,7 @@ GlobalContext *GlobalContext::Instance() {
 Status GlobalContext::Init() {
   config_manager_ = std::make_shared<ConfigManager>();
   mem_pool_ = std::make_shared<SystemPool>();
+  pinned_pool_ = std::make_shared<PinnedPool>();
   // For testing we can use Dummy pool instead
 
   // Create some tensor allocators for the different types and hook them into the pool.
@@ -61,6 +63,13 @@ Status GlobalContext::Init() {
   return Status::OK();
 }
 
+std::shared_ptr<MemoryPool> GlobalContext::tensor_data_pool() const {
+  if (config_manager_->pinned_memory()) {
+    return pinned_pool_;
+  }
+  return mem_pool_;
+}
+
 // A print method typically used for debugging
 void GlobalContext::Print(std::ostream &out) const {
   out << "GlobalContext contains the following default config: " << *config_manager_ << "\n";
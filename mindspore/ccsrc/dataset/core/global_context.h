@@ -27,6 +27,7 @@ namespace mindspore {
 namespace dataset {
 // forward declare
 class MemoryPool;
+class PinnedPool;
 class ConfigManager;
 class Tensor;
 class CVTensor;
@@ -74,6 +75,15 @@ class GlobalContext {
   // @return the mem pool
   std::shared_ptr<MemoryPool> mem_pool() const { return mem_pool_; }
 
+  // Getter method
+  // @return the pool of pinned, page aligned and reference counted slabs
+  std::shared_ptr<PinnedPool> pinned_pool() const { return pinned_pool_; }
+
+  // The pool the data of a new Tensor comes from. This is the pinned pool if the pinned_memory config is on, or the
+  // mem pool otherwise.
+  // @return the pool for Tensor data
+  std::shared_ptr<MemoryPool> tensor_data_pool() const;
+
   // Getter method
   // @return the tensor allocator as raw pointer
   const TensorAlloc *tensor_allocator() const { return tensor_allocator_.get(); }
@@ -97,6 +107,7 @@ class GlobalContext {
   static std::once_flag init_instance_flag_;
   static std::unique_ptr<GlobalContext> global_context_;  // The instance of the singleton (global)
   std::shared_ptr<MemoryPool> mem_pool_;                  // A global memory pool
+  std::shared_ptr<PinnedPool> pinned_pool_;               // A global pool of pinned memory
   std::shared_ptr<ConfigManager> config_manager_;         // The configs
   std::unique_ptr<TensorAlloc> tensor_allocator_;         // An allocator for Tensors
   std::unique_ptr<CVTensorAlloc> cv_tensor_allocator_;    // An allocator for CV Tensors
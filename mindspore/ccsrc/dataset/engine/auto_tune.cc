@@ -0,0 +1,234 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "dataset/engine/auto_tune.h"
+#include <algorithm>
+#include "dataset/core/config_manager.h"
+#include "dataset/core/global_context.h"
+#include "dataset/engine/datasetops/dataset_op.h"
+#include "dataset/engine/datasetops/parallel_op.h"
+#include "dataset/engine/execution_tree.h"
+#include "dataset/util/task_manager.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace dataset {
+namespace {
+// Thresholds on the average connector occupancy
+constexpr double kLowOccupancy = 0.25;
+constexpr double kHighOccupancy = 0.75;
+constexpr double kInputBacklog = 0.5;
+// A connector is considered bursty if it was seen both empty and full in this fraction of the samples
+constexpr double kBurstyFraction = 0.2;
+}  // namespace
+
+AutoTune::AutoTune(ExecutionTree *tree) : tree_(tree), cpu_budget_(0), active_total_(0), interval_ms_(0) {}
+
+Status AutoTune::operator()() {
+  TaskManager::FindMe()->Post();
+  RETURN_IF_NOT_OK(Init());
+  int32_t num_samples = 0;
+  while (true) {
+    RETURN_IF_INTERRUPTED();
+    {
+      // Nothing notifies wait_cv_ but an interrupt of the tree, which ends the wait right away on shutdown
+      std::unique_lock<std::mutex> lck(wait_mux_);
+      RETURN_IF_NOT_OK(wait_cv_.WaitFor(&lck, std::chrono::milliseconds(interval_ms_), []() { return false; }));
+    }
+    Sample();
+    if (++num_samples == kSamplesPerWindow) {
+      RETURN_IF_NOT_OK(Tune());
+      num_samples = 0;
+    }
+  }
+  return Status::OK();
+}
+
+Status AutoTune::Init() {
+  RETURN_IF_NOT_OK(wait_cv_.Register(tree_->AllTasks()->GetIntrpService()));
+  std::shared_ptr<ConfigManager> cfg = GlobalContext::config_manager();
+  cpu_budget_ = cfg->auto_tune_cpu_budget();
+  interval_ms_ = std::max(cfg->auto_tune_interval(), 1u);
+  int32_t num_tunable = 0;
+  for (auto itr = tree_->begin(); itr != tree_->end(); ++itr) {
+    DatasetOp *op = itr.get().get();
+    if (op->out_connector_ == nullptr) {
+      continue;
+    }
+    OpStats stats{};
+    stats.op = op;
+    auto parallel_op = dynamic_cast<ParallelOp *>(op);
+    if (parallel_op != nullptr && parallel_op->AutoTunable()) {
+      stats.tunable = parallel_op;
+      num_tunable++;
+    }
+    stats.orig_queue_capacity = op->oc_queue_size_;
+    stats.last_push_count = op->out_connector_->push_count();
+    stats_.push_back(stats);
+  }
+  if (num_tunable == 0) {
+    MS_LOG(INFO) << "AutoTune found no tunable operator in the tree.";
+    return Status::OK();
+  }
+  // Every op starts with the workers it was configured with. Only when they add up to more than the budget, the
+  // largest pools give up workers until the total fits, or every op is down to a single worker.
+  for (auto &stats : stats_) {
+    if (stats.tunable != nullptr) {
+      stats.tunable->SetActiveWorkers(stats.tunable->num_workers());
+      active_total_ += stats.tunable->active_workers();
+    }
+  }
+  while (active_total_ > cpu_budget_) {
+    OpStats *largest = nullptr;
+    for (auto &stats : stats_) {
+      if (stats.tunable != nullptr && stats.tunable->active_workers() > 1 &&
+          (largest == nullptr || stats.tunable->active_workers() > largest->tunable->active_workers())) {
+        largest = &stats;
+      }
+    }
+    if (largest == nullptr) {
+      break;
+    }
+    largest->tunable->SetActiveWorkers(largest->tunable->active_workers() - 1);
+    active_total_--;
+  }
+  window_start_ = std::chrono::steady_clock::now();
+  MS_LOG(INFO) << "AutoTune started. Tunable ops: " << num_tunable << ". CPU budget: " << cpu_budget_
+               << ". Active workers: " << active_total_ << ".";
+  return Status::OK();
+}
+
+void AutoTune::Sample() {
+  for (auto &stats : stats_) {
+    const DbConnector *conn = stats.op->out_connector_.get();
+    int32_t capacity = conn->capacity();
+    if (capacity <= 0) {
+      continue;
+    }
+    int32_t size = conn->size();
+    double occupancy = static_cast<double>(size) / capacity;
+    stats.num_samples++;
+    stats.occupancy_sum += occupancy;
+    stats.max_occupancy = std::max(stats.max_occupancy, occupancy);
+    if (size == 0) {
+      stats.num_empty++;
+    } else if (size >= capacity) {
+      stats.num_full++;
+    }
+  }
+}
+
+double AutoTune::AvgOccupancy(const OpStats &stats) {
+  return (stats.num_samples > 0) ? stats.occupancy_sum / stats.num_samples : 0.0;
+}
+
+AutoTune::OpStats *AutoTune::ChildStats(const OpStats &stats) {
+  if (stats.op->child_.empty()) {
+    return nullptr;
+  }
+  DatasetOp *child = stats.op->child_[0].get();
+  for (auto &s : stats_) {
+    if (s.op == child) {
+      return &s;
+    }
+  }
+  return nullptr;
+}
+
+void AutoTune::GrowWorkers(OpStats *stats) {
+  ParallelOp *op = stats->tunable;
+  if (op->active_workers() >= op->num_workers()) {
+    return;
+  }
+  if (active_total_ >= cpu_budget_) {
+    // Budget is used up. Take a worker from the op that is producing far ahead of its consumer.
+    OpStats *donor = nullptr;
+    for (auto &s : stats_) {
+      if (s.tunable != nullptr && &s != stats && s.tunable->active_workers() > 1 &&
+          AvgOccupancy(s) >= kInputBacklog && (donor == nullptr || AvgOccupancy(s) > AvgOccupancy(*donor))) {
+        donor = &s;
+      }
+    }
+    if (donor == nullptr) {
+      return;
+    }
+    donor->tunable->SetActiveWorkers(donor->tunable->active_workers() - 1);
+    active_total_--;
+    MS_LOG(INFO) << "AutoTune moves a worker from operator " << donor->op->id() << " to operator " << op->id() << ".";
+  }
+  op->SetActiveWorkers(op->active_workers() + 1);
+  active_total_++;
+}
+
+Status AutoTune::Tune() {
+  auto now = std::chrono::steady_clock::now();
+  double elapsed = std::chrono::duration<double>(now - window_start_).count();
+  for (auto &stats : stats_) {
+    double occupancy = AvgOccupancy(stats);
+    DbConnector *conn = stats.op->out_connector_.get();
+    int64_t push_count = conn->push_count();
+    MS_LOG(DEBUG) << "AutoTune operator " << stats.op->id() << ": connector occupancy " << occupancy
+                  << ", buffers/sec " << ((elapsed > 0) ? (push_count - stats.last_push_count) / elapsed : 0) << ".";
+
+    // Worker pool
+    if (stats.tunable != nullptr) {
+      OpStats *child = ChildStats(stats);
+      int32_t before = stats.tunable->active_workers();
+      if (child != nullptr && AvgOccupancy(*child) >= kInputBacklog && occupancy < kLowOccupancy) {
+        GrowWorkers(&stats);
+      } else if (occupancy >= kHighOccupancy && before > 1) {
+        stats.tunable->SetActiveWorkers(before - 1);
+        active_total_--;
+      }
+      if (stats.tunable->active_workers() != before) {
+        MS_LOG(INFO) << "AutoTune changes the active workers of operator " << stats.op->id() << " from " << before
+                     << " to " << stats.tunable->active_workers() << ".";
+      }
+    }
+
+    // Connector capacity. The lock free ring can't be resized.
+    if (!conn->lock_free() && stats.num_samples > 0) {
+      int32_t num_queues = std::max(1, stats.op->num_producers());
+      int32_t queue_capacity = conn->capacity() / num_queues;
+      int32_t bursty = static_cast<int32_t>(kBurstyFraction * stats.num_samples);
+      int32_t new_capacity = queue_capacity;
+      if (stats.num_empty > bursty && stats.num_full > bursty &&
+          queue_capacity < stats.orig_queue_capacity * kMaxConnectorScale) {
+        new_capacity = std::min(queue_capacity * 2, stats.orig_queue_capacity * kMaxConnectorScale);
+      } else if (stats.max_occupancy <= kLowOccupancy && queue_capacity > stats.orig_queue_capacity) {
+        new_capacity = std::max(queue_capacity / 2, stats.orig_queue_capacity);
+      }
+      if (new_capacity != queue_capacity) {
+        RETURN_IF_NOT_OK(conn->Resize(new_capacity));
+        MS_LOG(INFO) << "AutoTune resizes the connector of operator " << stats.op->id() << " from " << queue_capacity
+                     << " to " << new_capacity << " per queue.";
+      }
+    }
+  }
+
+  // Start a new window
+  for (auto &stats : stats_) {
+    stats.num_samples = 0;
+    stats.num_empty = 0;
+    stats.num_full = 0;
+    stats.occupancy_sum = 0.0;
+    stats.max_occupancy = 0.0;
+    stats.last_push_count = stats.op->out_connector_->push_count();
+  }
+  window_start_ = now;
+  return Status::OK();
+}
+}  // namespace dataset
+}  // namespace mindspore
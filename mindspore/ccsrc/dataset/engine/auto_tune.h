@@ -0,0 +1,109 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef DATASET_ENGINE_AUTO_TUNE_H_
+#define DATASET_ENGINE_AUTO_TUNE_H_
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "dataset/util/cond_var.h"
+#include "dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+// Forward declares
+class ExecutionTree;
+class DatasetOp;
+class ParallelOp;
+
+// AutoTune runs as one more task of the ExecutionTree when the auto tune config is on. At a fixed interval it
+// samples the occupancy of every output connector in the tree. After a window of samples it:
+//   - gives one more active worker to a MapOp/BatchOp whose input connector is filling up while its output
+//     connector is draining (the op is the bottleneck),
+//   - takes one worker away from an op whose output connector stays full (the consumer is the bottleneck),
+//   - grows a connector whose occupancy swings between empty and full, and shrinks it back once it stays
+//     mostly empty.
+// The sum of active workers over the tuned ops never exceeds the CPU budget. An op never runs more workers
+// than the num_parallel_workers it was built with, so that value acts as the upper bound of its pool.
+class AutoTune {
+ public:
+  // Number of samples collected before the tuner makes a decision
+  static constexpr int32_t kSamplesPerWindow = 10;
+
+  // A connector can grow up to this multiple of its original capacity
+  static constexpr int32_t kMaxConnectorScale = 4;
+
+  // Constructor
+  // @param tree - The tree to tune. Must be prepared.
+  explicit AutoTune(ExecutionTree *tree);
+
+  // Destructor
+  ~AutoTune() = default;
+
+  // Main loop of the tuner, launched as a task of the tree
+  // @return Status - The error code return
+  Status operator()();
+
+ private:
+  // Statistics of one operator and its output connector over the current window
+  struct OpStats {
+    DatasetOp *op;
+    ParallelOp *tunable;         // Same as op if the worker pool can be tuned, nullptr otherwise
+    int32_t orig_queue_capacity;  // Per producer queue capacity at the start
+    int32_t num_samples;
+    int32_t num_empty;           // Number of samples where the connector was empty
+    int32_t num_full;            // Number of samples where the connector was full
+    double occupancy_sum;        // Sum of size/capacity over the window
+    double max_occupancy;
+    int64_t last_push_count;     // Connector push count at the start of the window
+  };
+
+  // Find the ops of the tree and trim their worker pools to the CPU budget
+  // @return Status - The error code return
+  Status Init();
+
+  // Take one sample of every connector
+  void Sample();
+
+  // Adjust the worker pools and the connectors from the statistics of the window, then start a new window
+  // @return Status - The error code return
+  Status Tune();
+
+  // Try to give one more worker to the given op. If the budget is used up, a worker is taken from the op
+  // whose output connector is the fullest.
+  void GrowWorkers(OpStats *stats);
+
+  // @return The stats of the op feeding the given one, nullptr if the child has no connector
+  OpStats *ChildStats(const OpStats &stats);
+
+  // @return The average connector occupancy over the window
+  static double AvgOccupancy(const OpStats &stats);
+
+  ExecutionTree *tree_;
+  std::vector<OpStats> stats_;
+  int32_t cpu_budget_;
+  int32_t active_total_;
+  uint32_t interval_ms_;
+  std::chrono::steady_clock::time_point window_start_;
+  // The tuner sleeps between samples on this condition variable, registered for interrupts of the tree
+  std::mutex wait_mux_;
+  CondVar wait_cv_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // DATASET_ENGINE_AUTO_TUNE_H_
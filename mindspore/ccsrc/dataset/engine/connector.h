@@ -16,6 +16,8 @@
 #ifndef DATASET_ENGINE_CONNECTOR_H_
 #define DATASET_ENGINE_CONNECTOR_H_
 
+#include <atomic>
+#include <chrono>
 #include <memory>
 #include <string>
 #include <utility>
@@ -71,8 +73,9 @@ class Connector {
   // @param n_producers The number of threads producing data into this DbConnector.
   // @param n_consumers The number of thread consuming data from this DbConnector.
   // @param queue_capacity The number of element (DataBuffer) for each queue.
-  Connector(int32_t n_producers, int32_t n_consumers, int32_t queue_capacity)
-      : num_producers_(n_producers), num_consumers_(n_consumers) {
+  // @param lock_free Use the lock free ring as the backend of the internal queues.
+  Connector(int32_t n_producers, int32_t n_consumers, int32_t queue_capacity, bool lock_free = false)
+      : num_producers_(n_producers), num_consumers_(n_consumers), lock_free_(lock_free) {
     MS_LOG(INFO) << "A connector is created with " << n_producers << " producers and " << n_consumers << " consumers.";
     my_name_ = Services::GetUniqueID();
     // We require the consumers to have ids sequentially from 0 to the num_consumers_-1,
@@ -84,7 +87,11 @@ class Connector {
 
     // Initialize the queues_ to have num_producers_ number of queues.
     // Each queue is a blocking queue and has the same queue_capacity.
-    queues_.Init(num_producers_, queue_capacity);
+    queues_.Init(num_producers_, queue_capacity, lock_free_);
+
+    // With a single consumer the round robin order is maintained by the consumer thread alone. A lock free
+    // connector can then skip the consumer turnstile (m_ and cv_) altogether.
+    bypass_turnstile_ = lock_free_ && (num_consumers_ == 1);
   }
 
   // Destructor of Connector
@@ -96,15 +103,21 @@ class Connector {
   // @param result The address of an object where the popped element will be placed.
   virtual Status Pop(int32_t worker_id,  // The worker-id of the caller. See the requirement at the top of this file.
                      T *result) noexcept {
+    WaitTimer timer(profiling_ ? &pop_wait_ns_ : nullptr);
     {
       DS_ASSERT(worker_id < num_consumers_);
-      std::unique_lock<std::mutex> lk(m_);
-      RETURN_IF_NOT_OK(cv_.Wait(&lk, [this, worker_id]() { return expect_consumer_ == worker_id; }));
+      std::unique_lock<std::mutex> lk(m_, std::defer_lock);
+      if (!bypass_turnstile_) {
+        lk.lock();
+        RETURN_IF_NOT_OK(cv_.Wait(&lk, [this, worker_id]() { return expect_consumer_ == worker_id; }));
+      }
       RETURN_IF_NOT_OK(queues_[pop_from_]->PopFront(result));
       pop_from_ = (pop_from_ + 1) % num_producers_;
       expect_consumer_ = (expect_consumer_ + 1) % num_consumers_;
     }
-    cv_.NotifyAll();
+    if (!bypass_turnstile_) {
+      cv_.NotifyAll();
+    }
     return Status::OK();
   }
 
@@ -116,6 +129,8 @@ class Connector {
   Status Push(int32_t worker_id, const T &el) noexcept {
     DS_ASSERT(worker_id < static_cast<int32_t>(queues_.size()));
     DS_ASSERT(queues_[worker_id] != nullptr);
+    push_count_.fetch_add(1, std::memory_order_relaxed);
+    WaitTimer timer(profiling_ ? &push_wait_ns_ : nullptr);
     return (queues_[worker_id]->Add(el));
   }
 
@@ -127,6 +142,8 @@ class Connector {
   virtual Status Push(int32_t worker_id, T &&el) noexcept {
     DS_ASSERT(worker_id < static_cast<int32_t>(queues_.size()));
     DS_ASSERT(queues_[worker_id] != nullptr);
+    push_count_.fetch_add(1, std::memory_order_relaxed);
+    WaitTimer timer(profiling_ ? &push_wait_ns_ : nullptr);
     return (queues_[worker_id]->Add(std::forward<T>(el)));
   }
 
@@ -144,7 +161,7 @@ class Connector {
   void Print(std::ostream &out, bool showAll) const {
     out << "\n--------- Connector ------------"
         << "\nConnector Name           : " << my_name_ << "\nNumber of consumers      : " << num_consumers_
-        << "\nNumber of producers      : " << num_producers_ << "\n";
+        << "\nNumber of producers      : " << num_producers_ << "\nLock free                : " << lock_free_ << "\n";
   }
 
   friend std::ostream &operator<<(std::ostream &out, const Connector &con) {
@@ -152,6 +169,61 @@ class Connector {
     return out;
   }
 
+  // Getter function
+  // @return The total number of elements currently held in the internal queues. The value is only a snapshot
+  // since producers and consumers keep running, but each queue is read under its own lock.
+  int32_t size() const {
+    int32_t total = 0;
+    for (int32_t i = 0; i < num_producers_; ++i) {
+      total += queues_[i]->SnapshotSize();
+    }
+    return total;
+  }
+
+  // Getter function
+  // @return The total capacity of the internal queues
+  int32_t capacity() const {
+    int32_t total = 0;
+    for (int32_t i = 0; i < num_producers_; ++i) {
+      total += queues_[i]->SnapshotCapacity();
+    }
+    return total;
+  }
+
+  // Getter function
+  // @return T/F if the internal queues are lock free
+  bool lock_free() const { return lock_free_; }
+
+  // Getter function
+  // @return The total number of elements pushed into this connector since creation
+  int64_t push_count() const { return push_count_.load(std::memory_order_relaxed); }
+
+  // Start measuring the time spent in Push() and Pop(). Must be called before any producer or consumer runs.
+  void EnableProfiling() { profiling_ = true; }
+
+  // Getter function
+  // @return T/F if the time spent in Push() and Pop() is measured
+  bool profiling() const { return profiling_; }
+
+  // Getter function
+  // @return The total time in nanoseconds producers spent in Push(), mostly blocked on a full queue
+  int64_t push_wait_ns() const { return push_wait_ns_.load(std::memory_order_relaxed); }
+
+  // Getter function
+  // @return The total time in nanoseconds consumers spent in Pop(), mostly blocked on an empty queue or on
+  // their turn
+  int64_t pop_wait_ns() const { return pop_wait_ns_.load(std::memory_order_relaxed); }
+
+  // Change the capacity of each internal queue while the connector is in use.
+  // @param queue_capacity The new number of element for each queue.
+  // @return Status
+  Status Resize(int32_t queue_capacity) {
+    for (int32_t i = 0; i < num_producers_; ++i) {
+      RETURN_IF_NOT_OK(queues_[i]->Resize(queue_capacity));
+    }
+    return Status::OK();
+  }
+
   // Register the internal resources with Task group for interruption service.
   // @param vg
   // @return
@@ -164,6 +236,29 @@ class Connector {
   }
 
  protected:
+  // Adds the time spent in its scope to a counter. Does nothing if the counter is null, so the clock is not
+  // read at all when profiling is off.
+  class WaitTimer {
+   public:
+    explicit WaitTimer(std::atomic<int64_t> *counter) : counter_(counter) {
+      if (counter_ != nullptr) {
+        start_ = std::chrono::steady_clock::now();
+      }
+    }
+
+    ~WaitTimer() {
+      if (counter_ != nullptr) {
+        auto elapsed = std::chrono::steady_clock::now() - start_;
+        counter_->fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count(),
+                            std::memory_order_relaxed);
+      }
+    }
+
+   private:
+    std::atomic<int64_t> *counter_;
+    std::chrono::steady_clock::time_point start_;
+  };
+
   std::string my_name_;
 
   // A list of Queues that are thread safe.
@@ -178,6 +273,20 @@ class Connector {
   int32_t num_producers_;
   int32_t num_consumers_;
 
+  // Whether the internal queues use the lock free ring.
+  bool lock_free_;
+
+  // True if Pop() can bypass m_ and cv_. See the constructor.
+  bool bypass_turnstile_;
+
+  // Number of elements pushed so far. Sampled by the auto tuner.
+  std::atomic<int64_t> push_count_{0};
+
+  // Time spent in Push() and Pop(). Only updated when profiling_ is set.
+  bool profiling_{false};
+  std::atomic<int64_t> push_wait_ns_{0};
+  std::atomic<int64_t> pop_wait_ns_{0};
+
   // Used in the Pop(), when a thread call pop() but it is not the expect_consumer_.
   std::mutex m_;
   CondVar cv_;
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "dataset/engine/datasetops/batch_op.h"
+#include <algorithm>
 #include <utility>
 #include "common/utils.h"
 #include "dataset/engine/data_buffer.h"
@@ -31,7 +32,9 @@ BatchOp::Builder::Builder(int32_t batch_size) : builder_drop_(false) {
 Status BatchOp::Builder::Build(std::shared_ptr<BatchOp> *ptr) {
   RETURN_IF_NOT_OK(SanityCheck());
   *ptr = std::make_shared<BatchOp>(builder_batch_size_, builder_drop_, builder_op_connector_size_, builder_num_workers_,
-                                   builder_cols_to_map_, builder_batch_size_func_, builder_batch_map_func_);
+                                   builder_cols_to_map_, builder_batch_size_func_, builder_batch_map_func_,
+                                   builder_pad_info_, builder_length_column_, builder_bucket_boundaries_,
+                                   builder_bucket_batch_sizes_);
   return Status::OK();
 }
 
@@ -40,17 +43,43 @@ Status BatchOp::Builder::SanityCheck() {
   err += builder_op_connector_size_ <= 0 ? "connector size <= 0\n" : "";
   err += builder_batch_size_ <= 0 ? "batch size <= 0\n" : "";
   err += builder_num_workers_ <= 0 ? "batch num_parallel_workers <= 0\n" : "";
+  if (!builder_length_column_.empty()) {
+    err += builder_batch_size_func_ != nullptr ? "batch size function can't be used with bucketing\n" : "";
+    err += builder_bucket_batch_sizes_.size() != builder_bucket_boundaries_.size() + 1
+             ? "number of bucket batch sizes != number of bucket boundaries + 1\n"
+             : "";
+    const std::vector<int32_t> &boundaries = builder_bucket_boundaries_;
+    for (size_t i = 0; i < boundaries.size(); i++) {
+      if (boundaries[i] <= 0 || (i > 0 && boundaries[i] <= boundaries[i - 1])) {
+        err += "bucket boundaries are not positive and increasing\n";
+        break;
+      }
+    }
+    for (int32_t bucket_batch_size : builder_bucket_batch_sizes_) {
+      if (bucket_batch_size <= 0) {
+        err += "bucket batch size <= 0\n";
+        break;
+      }
+    }
+  }
   return err.empty() ? Status::OK() : Status(StatusCode::kUnexpectedError, __LINE__, __FILE__, common::SafeCStr(err));
 }
 
 BatchOp::BatchOp(int32_t batch_size, bool drop, int32_t op_queue_size, int32_t num_workers,
-                 const std::vector<std::string> &cols_to_map, py::function batch_size_func, py::function batch_map_func)
+                 const std::vector<std::string> &cols_to_map, py::function batch_size_func, py::function batch_map_func,
+                 const PadInfo &pad_info, const std::string &length_column,
+                 const std::vector<int32_t> &bucket_boundaries, const std::vector<int32_t> &bucket_batch_sizes)
     : ParallelOp(num_workers, op_queue_size),
       start_batch_size_(batch_size),
       drop_(drop),
       input_column_names_(cols_to_map),
+      pad_info_(pad_info),
+      length_column_(length_column),
+      bucket_boundaries_(bucket_boundaries),
+      bucket_batch_sizes_(bucket_batch_sizes),
       batch_size_func_(batch_size_func),
-      batch_map_func_(batch_map_func) {
+      batch_map_func_(batch_map_func),
+      skipped_in_epoch_(0, 0) {
   worker_queues_.Init(num_workers, op_queue_size);
 }
 
@@ -63,10 +92,42 @@ Status BatchOp::operator()() {
   child_iterator_ = std::make_unique<ChildIterator>(this, 0, 0);
   RETURN_IF_NOT_OK(child_iterator_->FetchNextTensorRow(&new_row));
   column_name_map_ = child_iterator_->col_name_id_map();
+  RETURN_IF_NOT_OK(UnpackPadInfo());
+  // Bucketing mode, one table per bucket
+  int32_t length_col = -1;
+  std::vector<std::unique_ptr<TensorQTable>> buckets;
+  if (!length_column_.empty() && !column_name_map_.empty()) {
+    auto itr = column_name_map_.find(length_column_);
+    if (itr == column_name_map_.end()) {
+      RETURN_STATUS_UNEXPECTED("column : '" + length_column_ + "' to bucket by does not exist\n");
+    }
+    length_col = itr->second;
+    for (size_t i = 0; i < bucket_batch_sizes_.size(); i++) {
+      buckets.push_back(std::make_unique<TensorQTable>());
+    }
+  }
   int32_t cur_batch_size = 0;
-  RETURN_IF_NOT_OK(GetBatchSize(&cur_batch_size, CBatchInfo(0, 0, 0)));
+  int64_t epoch_rows = 0;
+  if (restored_epoch_sizes_.empty()) {
+    batch_num = skipped_in_epoch_.second;
+  }
+  RETURN_IF_NOT_OK(GetBatchSize(&cur_batch_size, CBatchInfo(0, batch_num, 0)));
   while (child_iterator_->eof_handled() == false) {
     while (new_row.empty() == false) {
+      epoch_rows++;
+      if (length_col >= 0) {
+        size_t b = 0;
+        RETURN_IF_NOT_OK(GetBucket(new_row, length_col, &b));
+        buckets[b]->emplace_back(new_row);
+        // a bucket that is full makes a batch of its own
+        if (buckets[b]->size() == static_cast<size_t>(bucket_batch_sizes_[b])) {
+          RETURN_IF_NOT_OK(worker_queues_[cnt++ % num_workers_]->EmplaceBack(
+            std::make_pair(std::move(buckets[b]), CBatchInfo(epoch_num, batch_num++, cnt - epoch_num))));
+          buckets[b] = std::make_unique<TensorQTable>();
+        }
+        RETURN_IF_NOT_OK(child_iterator_->FetchNextTensorRow(&new_row));
+        continue;
+      }
       table->emplace_back(new_row);
       // if # of rows is enough to make 1 batch (1 batch is buffer), send it to worker_queue
       if (table->size() == static_cast<size_t>(cur_batch_size)) {
@@ -77,15 +138,26 @@ Status BatchOp::operator()() {
       }
       RETURN_IF_NOT_OK(child_iterator_->FetchNextTensorRow(&new_row));
     }
+    // Flush the leftovers of each bucket at the end of the epoch, unless they are dropped
+    for (auto &bucket : buckets) {
+      if (drop_ == false && bucket->empty() == false) {
+        RETURN_IF_NOT_OK(worker_queues_[cnt++ % num_workers_]->EmplaceBack(
+          std::make_pair(std::move(bucket), CBatchInfo(epoch_num, batch_num++, cnt - epoch_num))));
+      }
+      bucket = std::make_unique<TensorQTable>();
+    }
     // Reminder logic, execute only when there is a remainder (table is non empty) and don't drop
     if (drop_ == false && table->empty() == false) {
       RETURN_IF_NOT_OK(worker_queues_[cnt++ % num_workers_]->EmplaceBack(
         std::make_pair(std::move(table), CBatchInfo(epoch_num, batch_num++, cnt - epoch_num))));
     }
     table = std::make_unique<TensorQTable>();  // this drops when drop == true
-    // end of the current epoch, batch_num should start from 0 again
-    batch_num = 0;
+    RETURN_IF_NOT_OK(AddEpochSize(epoch_num, epoch_rows, batch_num));
+    // end of the current epoch, batch_num should start from 0 again, or from the skipped batches if the epoch was
+    // partly skipped by a restore
+    epoch_rows = 0;
     epoch_num++;
+    batch_num = static_cast<size_t>(epoch_num) == restored_epoch_sizes_.size() ? skipped_in_epoch_.second : 0;
     RETURN_IF_NOT_OK(
       worker_queues_[cnt++ % num_workers_]->EmplaceBack(std::make_pair(nullptr, CBatchInfo(batchCtrl::kEOE))));
     RETURN_IF_NOT_OK(GetBatchSize(&cur_batch_size, CBatchInfo(epoch_num, batch_num, cnt - epoch_num)));
@@ -105,7 +177,121 @@ void BatchOp::Print(std::ostream &out, bool show_all) const {
   ParallelOp::Print(out, show_all);
   out << "\nBatchOp:\n"
       << "number of parallel workers: " << num_workers_ << "\nBatch size: " << start_batch_size_
-      << "\nDrop remainder: " << (drop_ ? "yes" : "no") << "\n\n";
+      << "\nDrop remainder: " << (drop_ ? "yes" : "no") << "\nPadded columns:";
+  for (const auto &p : pad_info_) {
+    out << " " << p.first << p.second.first;
+  }
+  if (!length_column_.empty()) {
+    out << "\nBucket by length of: " << length_column_ << "\nBucket boundaries:";
+    for (auto boundary : bucket_boundaries_) {
+      out << " " << boundary;
+    }
+    out << "\nBucket batch sizes:";
+    for (auto bucket_batch_size : bucket_batch_sizes_) {
+      out << " " << bucket_batch_size;
+    }
+  }
+  out << "\n\n";
+}
+
+// Fill count elements at dst with a pad value converted to the given type
+static Status FillPadValue(unsigned char *dst, dsize_t count, const DataType &type, float value) {
+  switch (type.value()) {
+    case DataType::DE_BOOL:
+      std::fill_n(reinterpret_cast<bool *>(dst), count, value != 0);
+      break;
+    case DataType::DE_INT8:
+      std::fill_n(reinterpret_cast<int8_t *>(dst), count, static_cast<int8_t>(value));
+      break;
+    case DataType::DE_UINT8:
+      std::fill_n(reinterpret_cast<uint8_t *>(dst), count, static_cast<uint8_t>(value));
+      break;
+    case DataType::DE_INT16:
+      std::fill_n(reinterpret_cast<int16_t *>(dst), count, static_cast<int16_t>(value));
+      break;
+    case DataType::DE_UINT16:
+      std::fill_n(reinterpret_cast<uint16_t *>(dst), count, static_cast<uint16_t>(value));
+      break;
+    case DataType::DE_INT32:
+      std::fill_n(reinterpret_cast<int32_t *>(dst), count, static_cast<int32_t>(value));
+      break;
+    case DataType::DE_UINT32:
+      std::fill_n(reinterpret_cast<uint32_t *>(dst), count, static_cast<uint32_t>(value));
+      break;
+    case DataType::DE_INT64:
+      std::fill_n(reinterpret_cast<int64_t *>(dst), count, static_cast<int64_t>(value));
+      break;
+    case DataType::DE_UINT64:
+      std::fill_n(reinterpret_cast<uint64_t *>(dst), count, static_cast<uint64_t>(value));
+      break;
+    case DataType::DE_FLOAT16:
+      std::fill_n(reinterpret_cast<float16 *>(dst), count, static_cast<float16>(value));
+      break;
+    case DataType::DE_FLOAT32:
+      std::fill_n(reinterpret_cast<float *>(dst), count, value);
+      break;
+    case DataType::DE_FLOAT64:
+      std::fill_n(reinterpret_cast<double *>(dst), count, static_cast<double>(value));
+      break;
+    default:
+      RETURN_STATUS_UNEXPECTED("[Batch ERROR] Can't pad a column of unknown type\n");
+  }
+  return Status::OK();
+}
+
+// Copy a tensor into a slot of the given shape at dst. Each dim of the tensor is at most the dim of the slot.
+// The trailing dims that match are copied as one block, so a tensor that fills the slot is a single memcpy.
+static Status CopyIntoSlot(const std::shared_ptr<Tensor> &src, const std::vector<dsize_t> &slot_shape,
+                           unsigned char *dst) {
+  std::vector<dsize_t> src_shape = src->shape().AsVector();
+  dsize_t src_bytes = src->SizeInBytes();
+  if (src_bytes == 0) {
+    return Status::OK();
+  }
+  unsigned char *src_addr = src->StartAddr();
+  // The block is made of the last dim that differs and all the dims after it
+  int32_t rank = static_cast<int32_t>(src_shape.size());
+  int32_t k = rank - 1;
+  while (k >= 0 && src_shape[k] == slot_shape[k]) {
+    k--;
+  }
+  if (k < 0) {
+    int ret_code = memcpy_s(dst, src_bytes, src_addr, src_bytes);
+    if (ret_code != 0) {
+      RETURN_STATUS_UNEXPECTED("[Batch ERROR] Failed to copy a row\n");
+    }
+    return Status::OK();
+  }
+  dsize_t elem_bytes = src->type().SizeInBytes();
+  dsize_t block = elem_bytes;
+  for (int32_t d = k; d < rank; d++) {
+    block *= src_shape[d];
+  }
+  // Strides of the slot in bytes
+  std::vector<dsize_t> slot_strides(rank, elem_bytes);
+  for (int32_t d = rank - 2; d >= 0; d--) {
+    slot_strides[d] = slot_strides[d + 1] * slot_shape[d + 1];
+  }
+  // Walk the dims before k like an odometer, one block per step
+  std::vector<dsize_t> index(k, 0);
+  dsize_t num_blocks = src_bytes / block;
+  for (dsize_t b = 0; b < num_blocks; b++) {
+    dsize_t offset = 0;
+    for (int32_t d = 0; d < k; d++) {
+      offset += index[d] * slot_strides[d];
+    }
+    int ret_code = memcpy_s(dst + offset, block, src_addr + b * block, block);
+    if (ret_code != 0) {
+      RETURN_STATUS_UNEXPECTED("[Batch ERROR] Failed to copy a row\n");
+    }
+    for (int32_t d = k - 1; d >= 0; d--) {
+      if (++index[d] < src_shape[d]) {
+        break;
+      }
+      index[d] = 0;
+    }
+  }
+  return Status::OK();
 }
 
 Status BatchOp::BatchRows(const std::unique_ptr<TensorQTable> *source_table,
@@ -113,36 +299,114 @@ Status BatchOp::BatchRows(const std::unique_ptr<TensorQTable> *source_table,
   if ((*source_table)->size() < batch_size || (*source_table)->size() == 0) {
     RETURN_STATUS_UNEXPECTED("[Internal Batch ERROR] Insufficient rows in source_table\n");
   }
-  TensorRow row = std::move((*source_table)->front());
-  (*source_table)->pop_front();
-  if (batch_size == 1) {
+  if (batch_size == 1 && pad_cols_.empty()) {
+    TensorRow row = std::move((*source_table)->front());
+    (*source_table)->pop_front();
     for (std::shared_ptr<Tensor> tensor : row) {
       RETURN_IF_NOT_OK(tensor->ExpandDim(0));
     }
     (*dest_table)->push_back(row);
-  } else {  // batch_size > 1
-    std::vector<TensorShape> row_shapes;
-    TensorRow batched_row;
-    for (size_t i = 0; i < row.size(); i++) {  // Handle the first row popped
-      row_shapes.push_back(row[i]->shape());
-      std::shared_ptr<Tensor> ts;
-      RETURN_IF_NOT_OK(Tensor::CreateTensor(
-        &ts, TensorImpl::kFlexible, row[i]->shape().PrependDim(static_cast<int64_t>(batch_size)), row[i]->type()));
-      batched_row.emplace_back(ts);
-      RETURN_IF_NOT_OK(batched_row[i]->InsertTensor(std::vector<dsize_t>(1, 0), row[i]));  // {j} = 0
+    return Status::OK();
+  }
+  TensorRow batched_row;
+  size_t num_cols = (*source_table)->front().size();
+  for (size_t i = 0; i < num_cols; i++) {
+    std::shared_ptr<Tensor> batched;
+    RETURN_IF_NOT_OK(CollateColumn(**source_table, i, batch_size, &batched));
+    batched_row.emplace_back(std::move(batched));
+  }
+  (void)(*source_table)->erase((*source_table)->begin(), (*source_table)->begin() + batch_size);
+  (*dest_table)->emplace_back(std::move(batched_row));
+  return Status::OK();
+}
+
+Status BatchOp::CollateColumn(const TensorQTable &rows, size_t col, size_t batch_size,
+                              std::shared_ptr<Tensor> *batched) {
+  const std::shared_ptr<Tensor> &first = rows[0][col];
+  std::vector<dsize_t> slot_shape = first->shape().AsVector();
+  auto pad_itr = pad_cols_.find(col);
+  bool pad = (pad_itr != pad_cols_.end());
+  for (size_t j = 0; j < batch_size; j++) {
+    if (rows[j].size() <= col) {
+      RETURN_STATUS_UNEXPECTED("[Batch ERROR] Inconsistent number of columns\n");
     }
-    for (size_t j = 1; j < batch_size; j++) {  // Handle the rest of the rows
-      row = std::move((*source_table)->front());
-      (*source_table)->pop_front();
-      for (size_t i = 0; i < row.size(); i++) {
-        if (row[i]->shape() == row_shapes[i]) {  // check the newly popped rows have the same dim as the first
-          RETURN_IF_NOT_OK(batched_row[i]->InsertTensor(std::vector<dsize_t>(1, j), row[i]));
-        } else {
-          RETURN_STATUS_UNEXPECTED("[Batch ERROR] Inconsistent TensorShapes\n");
-        }
+    const std::shared_ptr<Tensor> &t = rows[j][col];
+    if (t->type() != first->type()) {
+      RETURN_STATUS_UNEXPECTED("[Batch ERROR] Inconsistent Tensor types\n");
+    }
+    if (!pad) {
+      if (t->shape() != first->shape()) {
+        RETURN_STATUS_UNEXPECTED("[Batch ERROR] Inconsistent TensorShapes\n");
+      }
+      continue;
+    }
+    if (t->shape().Rank() != static_cast<dsize_t>(slot_shape.size())) {
+      RETURN_STATUS_UNEXPECTED("[Batch ERROR] Inconsistent ranks in a padded column\n");
+    }
+    for (size_t d = 0; d < slot_shape.size(); d++) {
+      slot_shape[d] = std::max(slot_shape[d], t->shape()[d]);
+    }
+  }
+  if (pad) {
+    // An empty pad shape pads every dim to the largest of the batch
+    const std::vector<dsize_t> &pad_shape = pad_itr->second.first;
+    if (!pad_shape.empty() && pad_shape.size() != slot_shape.size()) {
+      RETURN_STATUS_UNEXPECTED("[Batch ERROR] The pad shape and the rows have different ranks\n");
+    }
+    for (size_t d = 0; d < pad_shape.size(); d++) {
+      if (pad_shape[d] < 0) {
+        continue;
+      }
+      if (slot_shape[d] > pad_shape[d]) {
+        RETURN_STATUS_UNEXPECTED("[Batch ERROR] A row is larger than the pad shape\n");
       }
+      slot_shape[d] = pad_shape[d];
     }
-    (*dest_table)->emplace_back(batched_row);
+  }
+
+  TensorShape slot(slot_shape);
+  RETURN_IF_NOT_OK(Tensor::CreateTensor(batched, TensorImpl::kFlexible,
+                                        slot.PrependDim(static_cast<int64_t>(batch_size)), first->type()));
+  unsigned char *dst = (*batched)->StartAddr();
+  dsize_t slot_elements = slot.NumOfElements();
+  dsize_t slot_bytes = slot_elements * first->type().SizeInBytes();
+  if (dst == nullptr && slot_bytes > 0) {
+    RETURN_STATUS_UNEXPECTED("[Batch ERROR] Failed to allocate the batched tensor\n");
+  }
+  for (size_t j = 0; j < batch_size; j++) {
+    const std::shared_ptr<Tensor> &t = rows[j][col];
+    unsigned char *slot_addr = dst + j * slot_bytes;
+    // Only the rows smaller than the slot need the pad value
+    if (pad && t->shape().NumOfElements() != slot_elements) {
+      RETURN_IF_NOT_OK(FillPadValue(slot_addr, slot_elements, first->type(), pad_itr->second.second));
+    }
+    RETURN_IF_NOT_OK(CopyIntoSlot(t, slot_shape, slot_addr));
+  }
+  return Status::OK();
+}
+
+Status BatchOp::GetBucket(const TensorRow &row, int32_t length_col, size_t *bucket) const {
+  if (row.size() <= static_cast<size_t>(length_col) || row[length_col]->shape().Rank() == 0) {
+    RETURN_STATUS_UNEXPECTED("[Batch ERROR] The column to bucket by has no length\n");
+  }
+  dsize_t length = row[length_col]->shape()[0];
+  // the number of boundaries not above the length is the index of the bucket
+  *bucket = static_cast<size_t>(std::upper_bound(bucket_boundaries_.begin(), bucket_boundaries_.end(), length) -
+                                bucket_boundaries_.begin());
+  return Status::OK();
+}
+
+Status BatchOp::UnpackPadInfo() {
+  pad_cols_.clear();
+  if (column_name_map_.empty()) {
+    return Status::OK();  // empty dataset, nothing to batch
+  }
+  for (const auto &p : pad_info_) {
+    auto itr = column_name_map_.find(p.first);
+    if (itr == column_name_map_.end()) {
+      RETURN_STATUS_UNEXPECTED("column : '" + p.first + "' to pad does not exist\n");
+    }
+    pad_cols_[static_cast<size_t>(itr->second)] = std::make_pair(p.second.first.AsVector(), p.second.second);
   }
   return Status::OK();
 }
@@ -158,7 +422,10 @@ Status BatchOp::WorkerEntry(int32_t workerId) {
       RETURN_IF_NOT_OK(out_connector_->Add(workerId, std::make_unique<DataBuffer>(0, DataBuffer::kDeBFlagEOF)));
     } else if (table_pair.second.ctrl_ == batchCtrl::kNoCtrl) {
       std::unique_ptr<DataBuffer> db = nullptr;
-      RETURN_IF_NOT_OK(MakeBatchedBuffer(std::move(table_pair), &db));
+      RETURN_IF_NOT_OK(AcquireWorkerSlot(workerId));
+      Status rc = MakeBatchedBuffer(std::move(table_pair), &db);
+      ReleaseWorkerSlot(workerId);
+      RETURN_IF_NOT_OK(rc);
       RETURN_IF_NOT_OK(out_connector_->Add(workerId, std::move(db)));
     }
     RETURN_IF_NOT_OK(worker_queues_[workerId]->PopFront(&table_pair));
@@ -185,6 +452,51 @@ Status BatchOp::LaunchThreadsAndInitOp() {
   return Status::OK();
 }
 
+// Record the size of a finished epoch. Epochs skipped by a restore were not seen by this op, their sizes come from
+// the restored state.
+Status BatchOp::AddEpochSize(int64_t epoch_num, int64_t num_rows, int64_t num_batches) {
+  std::lock_guard<std::mutex> lock(state_mux_);
+  auto epoch = static_cast<size_t>(epoch_num);
+  if (epoch < restored_epoch_sizes_.size()) {
+    epoch_sizes_.push_back(restored_epoch_sizes_[epoch]);
+  } else if (epoch == restored_epoch_sizes_.size()) {
+    epoch_sizes_.emplace_back(num_rows + skipped_in_epoch_.first, num_batches);
+  } else {
+    epoch_sizes_.emplace_back(num_rows, num_batches);
+  }
+  return Status::OK();
+}
+
+Status BatchOp::SaveState(nlohmann::json *state) const {
+  std::lock_guard<std::mutex> lock(state_mux_);
+  (*state)["epoch_sizes"] = epoch_sizes_;
+  return Status::OK();
+}
+
+Status BatchOp::RestoreState(const nlohmann::json &state) {
+  std::lock_guard<std::mutex> lock(state_mux_);
+  restored_epoch_sizes_ = state.at("epoch_sizes").get<std::vector<std::pair<int64_t, int64_t>>>();
+  return Status::OK();
+}
+
+Status BatchOp::SkipRows(int64_t num_rows) {
+  if (batch_size_func_ != nullptr || !length_column_.empty()) {
+    return DatasetOp::SkipRows(num_rows);
+  }
+  std::lock_guard<std::mutex> lock(state_mux_);
+  // Whole epochs first, their last batch may be partial or dropped, then full batches of the next epoch
+  int64_t child_rows = 0;
+  size_t num_epochs = 0;
+  while (num_epochs < restored_epoch_sizes_.size() && num_rows >= restored_epoch_sizes_[num_epochs].second) {
+    child_rows += restored_epoch_sizes_[num_epochs].first;
+    num_rows -= restored_epoch_sizes_[num_epochs].second;
+    num_epochs++;
+  }
+  restored_epoch_sizes_.resize(num_epochs);
+  skipped_in_epoch_ = std::make_pair(num_rows * start_batch_size_, num_rows);
+  return child_[0]->SkipRows(child_rows + skipped_in_epoch_.first);
+}
+
 Status BatchOp::EofReceived(int32_t) { return Status::OK(); }
 
 Status BatchOp::EoeReceived(int32_t) {
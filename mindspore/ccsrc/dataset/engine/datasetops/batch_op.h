@@ -16,7 +16,9 @@
 #ifndef DATASET_ENGINE_DATASETOPS_BATCH_OP_H_
 #define DATASET_ENGINE_DATASETOPS_BATCH_OP_H_
 
+#include <map>
 #include <memory>
+#include <mutex>
 #include <queue>
 #include <string>
 #include <unordered_map>
@@ -35,6 +37,9 @@ class DataBuffer;
 
 using TensorBatch = std::vector<std::shared_ptr<Tensor>>;
 using TensorBatchTable = std::vector<TensorBatch>;
+// Map of column name to the shape each row of the column is padded to, and the value it is padded with.
+// A dim of -1 in the shape pads to the largest dim of the batch.
+using PadInfo = std::map<std::string, std::pair<TensorShape, float>>;
 
 class BatchOp : public ParallelOp {
  public:
@@ -91,6 +96,28 @@ class BatchOp : public ParallelOp {
       return *this;
     }
 
+    // set the columns to pad, rows of other columns must all have the same shape
+    // @param const PadInfo &pad_info - map of column name to the pad shape and the pad value
+    // @return Builder & reference to builder class object
+    Builder &SetPaddingMap(const PadInfo &pad_info) {
+      builder_pad_info_ = pad_info;
+      return *this;
+    }
+
+    // set bucketing by length, rows are routed into buckets by their length and each bucket makes its own batches.
+    // Bucket i takes the rows whose length is in [boundaries[i-1], boundaries[i]), the last bucket has no upper bound.
+    // @param const std::string &length_column - name of the column whose first dim is the length of a row
+    // @param const std::vector<int32_t> &boundaries - increasing upper bounds (exclusive) of the buckets
+    // @param const std::vector<int32_t> &batch_sizes - batch size of each bucket, one more than the boundaries
+    // @return Builder & reference to builder class object
+    Builder &SetBucketing(const std::string &length_column, const std::vector<int32_t> &boundaries,
+                          const std::vector<int32_t> &batch_sizes) {
+      builder_length_column_ = length_column;
+      builder_bucket_boundaries_ = boundaries;
+      builder_bucket_batch_sizes_ = batch_sizes;
+      return *this;
+    }
+
     // SetBatchSizeFunc, a function that calls to python after every batch is made
     // @param py::function batch_size_func - python function to call, GIL required before calling
     // @return Builder & reference to builder class object
@@ -113,6 +140,10 @@ class BatchOp : public ParallelOp {
     int32_t builder_num_workers_;
     int32_t builder_op_connector_size_;
     std::vector<std::string> builder_cols_to_map_;
+    PadInfo builder_pad_info_;
+    std::string builder_length_column_;
+    std::vector<int32_t> builder_bucket_boundaries_;
+    std::vector<int32_t> builder_bucket_batch_sizes_;
 
     py::function builder_batch_size_func_;
     py::function builder_batch_map_func_;
@@ -143,8 +174,15 @@ class BatchOp : public ParallelOp {
   // @param int32_t op_queue_size
   // @param int32_t rows_per_buf
   // @param int32_t num_workers
+  // @param const PadInfo &pad_info
+  // @param const std::string &length_column - empty if not bucketing
+  // @param const std::vector<int32_t> &bucket_boundaries
+  // @param const std::vector<int32_t> &bucket_batch_sizes
   BatchOp(int32_t batch_size, bool drop, int32_t op_queue_size, int32_t num_workers, const std::vector<std::string> &,
-          py::function batch_size_func, py::function batch_map_func);
+          py::function batch_size_func, py::function batch_map_func, const PadInfo &pad_info,
+          const std::string &length_column, const std::vector<int32_t> &bucket_boundaries,
+          const std::vector<int32_t> &bucket_batch_sizes);
+
 
   // BatchOp destructor
   ~BatchOp() {}
@@ -176,6 +214,26 @@ class BatchOp : public ParallelOp {
   // @return Status - The error code return
   Status operator()() override;
 
+  // Getter
+  // @return T/F if the auto tuner is allowed to change the number of active workers of this op
+  bool AutoTunable() const override { return true; }
+
+  // Base-class override. Saves the number of rows and batches of every finished epoch.
+  // @param state - The json object to write the state into
+  // @return Status - The error code return
+  Status SaveState(nlohmann::json *state) const override;
+
+  // Base-class override. Restores the sizes of the epochs that were finished when the state was saved.
+  // @param state - The json object holding the state
+  // @return Status - The error code return
+  Status RestoreState(const nlohmann::json &state) override;
+
+  // Base-class override. With a fixed batch size the skipped batches are turned into rows, using the saved epoch
+  // sizes, and skipped by the child. Batch size functions and bucketing fall back to dropping the batches.
+  // @param num_rows - The number of batches to skip
+  // @return Status - The error code return
+  Status SkipRows(int64_t num_rows) override;
+
  private:
   // Worker thread for doing the memcpy of batch
   // @param int32_t param workerId
@@ -194,6 +252,33 @@ class BatchOp : public ParallelOp {
   // @return Status - The error code return
   Status BatchRows(const std::unique_ptr<TensorQTable> *src, const std::unique_ptr<TensorQTable> *dest, size_t size);
 
+  // Collate one column of the rows into a batched tensor. The batched tensor is allocated once, each row is copied
+  // into its slot with contiguous copies and padded in the same pass if the column is padded.
+  // @param const TensorQTable &rows - the rows of the batch
+  // @param size_t col - index of the column
+  // @param size_t batch_size - number of rows of the batch
+  // @param std::shared_ptr<Tensor> *batched - the batched tensor, actual return arg
+  // @return Status - The error code return
+  Status CollateColumn(const TensorQTable &rows, size_t col, size_t batch_size, std::shared_ptr<Tensor> *batched);
+
+  // Find the bucket of a row from the first dim of the length column
+  // @param const TensorRow &row - the row
+  // @param int32_t length_col - index of the length column
+  // @param size_t *bucket - index of the bucket, actual return arg
+  // @return Status - The error code return
+  Status GetBucket(const TensorRow &row, int32_t length_col, size_t *bucket) const;
+
+  // Record the number of rows and batches of a finished epoch for SaveState
+  // @param int64_t epoch_num - index of the epoch
+  // @param int64_t num_rows - number of rows taken from the child in the epoch
+  // @param int64_t num_batches - number of batches sent in the epoch
+  // @return Status - The error code return
+  Status AddEpochSize(int64_t epoch_num, int64_t num_rows, int64_t num_batches);
+
+  // Turn the column names of the pad info into column indices
+  // @return Status - The error code return
+  Status UnpackPadInfo();
+
   // Function that calls pyfunc to perform map on batch
   // @param (std::pair<std::unique_ptr<TensorQTable>, batch_stats> *table_pair - contains un-batched tensor
   // @return Status - The error code return
@@ -227,12 +312,29 @@ class BatchOp : public ParallelOp {
   std::unique_ptr<ChildIterator> child_iterator_;
   // Map of column_name: column_index
   std::unordered_map<std::string, int32_t> column_name_map_;
+  // Map of column_name: pad shape and pad value
+  PadInfo pad_info_;
+  // Map of column_index: pad shape and pad value
+  std::map<size_t, std::pair<std::vector<dsize_t>, float>> pad_cols_;
+  // Name of the column the length of a row is read from, empty if not bucketing
+  std::string length_column_;
+  // Upper bounds (exclusive) of the lengths of the buckets, the last bucket has no upper bound
+  std::vector<int32_t> bucket_boundaries_;
+  // Batch size of each bucket
+  std::vector<int32_t> bucket_batch_sizes_;
   // Internal queue for task distribution
   QueueList<std::pair<std::unique_ptr<TensorQTable>, CBatchInfo>> worker_queues_;
   // Function pointer of batch size function
   py::function batch_size_func_;
   // Function pointer of per batch map function
   py::function batch_map_func_;
+  // Number of rows taken from the child and batches sent of each finished epoch, saved in the state
+  std::vector<std::pair<int64_t, int64_t>> epoch_sizes_;
+  // Epoch sizes read from a restored state
+  std::vector<std::pair<int64_t, int64_t>> restored_epoch_sizes_;
+  // Rows and batches skipped in the first epoch that was not finished when the state was saved
+  std::pair<int64_t, int64_t> skipped_in_epoch_;
+  mutable std::mutex state_mux_;
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -0,0 +1,394 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "dataset/engine/datasetops/cache_op.h"
+
+#include <securec.h>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "dataset/core/config_manager.h"
+#include "dataset/core/global_context.h"
+#include "dataset/engine/data_buffer.h"
+#include "dataset/engine/db_connector.h"
+#include "dataset/engine/execution_tree.h"
+#include "dataset/util/path.h"
+#include "dataset/util/services.h"
+#include "dataset/util/task_manager.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace dataset {
+constexpr int64_t CacheOp::kDefaultMemSize;
+
+CacheOp::Builder::Builder() : build_mem_size_(kDefaultMemSize), build_sampler_(nullptr) {
+  std::shared_ptr<ConfigManager> cfg = GlobalContext::config_manager();
+  build_rows_per_buffer_ = cfg->rows_per_buffer();
+  build_op_connector_size_ = cfg->op_connector_size();
+}
+
+Status CacheOp::Builder::SanityCheck() const {
+  if (build_mem_size_ < 0) {
+    RETURN_STATUS_UNEXPECTED("Cache memory size must not be negative.");
+  }
+  if (build_rows_per_buffer_ <= 0) {
+    RETURN_STATUS_UNEXPECTED("Rows per buffer must be greater than 0.");
+  }
+  return Status::OK();
+}
+
+Status CacheOp::Builder::Build(std::shared_ptr<CacheOp> *ptr) {
+  RETURN_IF_NOT_OK(SanityCheck());
+  *ptr = std::make_shared<CacheOp>(build_mem_size_, build_spill_dir_, std::move(build_sampler_), build_rows_per_buffer_,
+                                   build_op_connector_size_);
+  return Status::OK();
+}
+
+CacheOp::CacheOp(int64_t mem_size, const std::string &spill_dir, std::shared_ptr<Sampler> sampler,
+                 int32_t rows_per_buffer, int32_t op_connector_size)
+    : PipelineOp(op_connector_size),
+      mem_size_(mem_size),
+      spill_dir_(spill_dir),
+      sampler_(std::move(sampler)),
+      rows_per_buffer_(rows_per_buffer),
+      buffer_id_(0),
+      caching_(false),
+      cache_complete_(false),
+      arena_(nullptr),
+      spill_size_(0),
+      num_rows_in_mem_(0),
+      num_rows_spilled_(0) {
+  if (spill_dir_.empty()) {
+    const char *tmp_dir = std::getenv("TMPDIR");
+    spill_dir_ = (tmp_dir != nullptr) ? tmp_dir : "/tmp";
+  }
+}
+
+CacheOp::~CacheOp() {
+  if (spill_stream_.is_open()) {
+    spill_stream_.close();
+  }
+  if (!spill_file_.empty()) {
+    (void)std::remove(spill_file_.c_str());
+  }
+  if (arena_ != nullptr) {
+    for (auto &row : rows_) {
+      if (row.addr != nullptr) {
+        arena_->Deallocate(row.addr);
+      }
+    }
+  }
+}
+
+void CacheOp::Print(std::ostream &out, bool show_all) const {
+  // Call base class printer first
+  PipelineOp::Print(out, show_all);
+
+  // Then display our own stuff
+  out << "CacheOp:\n  Memory size (MB): " << mem_size_ << "\n  Spill dir: " << spill_dir_
+      << "\n  Rows per buffer: " << rows_per_buffer_ << "\n  Cache complete: " << cache_complete_
+      << "\n  Rows in memory: " << num_rows_in_mem_ << "\n  Rows spilled: " << num_rows_spilled_;
+  out << "\n-------------------------\n\n";  // End the display with this line
+}
+
+Status CacheOp::PrepareNodeAction() {
+  // Run any common code from super class first before adding our own specific logic
+  RETURN_IF_NOT_OK(PipelineOp::PrepareNodeAction());
+  if (BitTest(tree_->PrepareFlags(), ExecutionTree::kDePrepRepeat)) {
+    // Our subtree has already been prepared, so its leaf ops are on top of the repeat stack. They only have to
+    // produce one epoch, so flag them as being in their last repeat. Leaf ops from other branches of the tree are
+    // put back for the RepeatOp.
+    std::set<DatasetOp *> subtree;
+    for (auto itr = tree_->begin(shared_from_this()); itr != tree_->end(); ++itr) {
+      (void)subtree.insert(itr.get().get());
+    }
+    std::vector<std::shared_ptr<DatasetOp>> others;
+    std::shared_ptr<DatasetOp> leaf_op = tree_->PopFromRepeatStack();
+    while (leaf_op != nullptr) {
+      if (subtree.find(leaf_op.get()) != subtree.end()) {
+        leaf_op->set_control_flag(kDeOpLastRepeat);
+      } else {
+        others.push_back(leaf_op);
+      }
+      leaf_op = tree_->PopFromRepeatStack();
+    }
+    for (auto itr = others.rbegin(); itr != others.rend(); ++itr) {
+      tree_->AddToRepeatStack(*itr);
+    }
+
+    // The RepeatOp above now treats us as the leaf.
+    BitSet(&op_ctrl_flags_, kDeOpRepeated);
+    tree_->AddToRepeatStack(shared_from_this());
+    caching_ = true;
+  }
+  wp_.Register(tree_->AllTasks());
+  return Status::OK();
+}
+
+Status CacheOp::operator()() {
+  // Synchronize with TaskManager once the thread is launched.
+  TaskManager::FindMe()->Post();
+
+  // Cache op does not have workers, and only consumes from child 0.
+  child_iterator_ = std::make_unique<ChildIterator>(this, 0, 0);
+  if (!caching_) {
+    // Not in a repeat path. Pass every epoch of the child through.
+    while (true) {
+      RETURN_IF_NOT_OK(FillCache());
+      if (child_iterator_->eof_handled()) {
+        return out_connector_->Add(0, std::make_unique<DataBuffer>(0, DataBuffer::kDeBFlagEOF));
+      }
+      RETURN_IF_NOT_OK(out_connector_->Add(0, std::make_unique<DataBuffer>(0, DataBuffer::kDeBFlagEOE)));
+    }
+  }
+
+  RETURN_IF_NOT_OK(FillCache());
+  // The leaf ops below were flagged to stop after one epoch, so the child sends eof right after. Drain it here, it is
+  // not flown up.
+  TensorRow row;
+  RETURN_IF_NOT_OK(child_iterator_->FetchNextTensorRow(&row));
+  if (!child_iterator_->eof_handled()) {
+    RETURN_STATUS_UNEXPECTED("Cache operator expects a single epoch from its child.");
+  }
+  if (spill_stream_.is_open()) {
+    (void)spill_stream_.flush();
+    if (!spill_stream_.good()) {
+      RETURN_STATUS_UNEXPECTED("Failed to write the cache spill file " + spill_file_);
+    }
+  }
+  cache_complete_ = true;
+  // Hand shake with the sampler now that the number of rows is known.
+  if (sampler_ != nullptr && !rows_.empty()) {
+    RETURN_IF_NOT_OK(sampler_->Init(this));
+  }
+  MS_LOG(INFO) << "Cache operator cached " << rows_.size() << " rows. In memory: " << num_rows_in_mem_
+               << ". Spilled: " << num_rows_spilled_ << ".";
+
+  while (true) {
+    MS_LOG(INFO) << "Cache operator sending EOE.";
+    RETURN_IF_NOT_OK(out_connector_->Add(0, std::make_unique<DataBuffer>(0, DataBuffer::kDeBFlagEOE)));
+    if (BitTest(op_ctrl_flags_, kDeOpLastRepeat)) {
+      MS_LOG(INFO) << "Cache operator sending EOF.";
+      return out_connector_->Add(0, std::make_unique<DataBuffer>(0, DataBuffer::kDeBFlagEOF));
+    }
+    // Not the last repeat. Sleep until the reset from the RepeatOp above, then serve the next epoch from the cache.
+    RETURN_IF_NOT_OK(wp_.Wait());
+    wp_.Clear();
+    RETURN_IF_NOT_OK(SendFromCache());
+  }
+}
+
+Status CacheOp::FillCache() {
+  TensorRow row;
+  RETURN_IF_NOT_OK(child_iterator_->FetchNextTensorRow(&row));
+  if (child_iterator_->eof_handled()) {
+    return Status::OK();
+  }
+  column_name_map_ = child_iterator_->col_name_id_map();
+  std::unique_ptr<TensorQTable> table = std::make_unique<TensorQTable>();
+  while (!row.empty()) {
+    if (caching_) {
+      RETURN_IF_NOT_OK(AddToCache(row));
+    }
+    table->push_back(std::move(row));
+    if (table->size() == static_cast<size_t>(rows_per_buffer_)) {
+      RETURN_IF_NOT_OK(SendBuffer(std::move(table)));
+      table = std::make_unique<TensorQTable>();
+    }
+    RETURN_IF_NOT_OK(child_iterator_->FetchNextTensorRow(&row));
+  }
+  if (!table->empty()) {
+    RETURN_IF_NOT_OK(SendBuffer(std::move(table)));
+  }
+  return Status::OK();
+}
+
+Status CacheOp::SendFromCache() {
+  std::unique_ptr<TensorQTable> table = std::make_unique<TensorQTable>();
+  auto add_row = [this, &table](int64_t row_id) -> Status {
+    TensorRow row;
+    RETURN_IF_NOT_OK(ReadFromCache(row_id, &row));
+    table->push_back(std::move(row));
+    if (table->size() == static_cast<size_t>(rows_per_buffer_)) {
+      RETURN_IF_NOT_OK(SendBuffer(std::move(table)));
+      table = std::make_unique<TensorQTable>();
+    }
+    return Status::OK();
+  };
+
+  int64_t num_rows = static_cast<int64_t>(rows_.size());
+  if (sampler_ == nullptr || num_rows == 0) {
+    for (int64_t i = 0; i < num_rows; i++) {
+      RETURN_IF_NOT_OK(add_row(i));
+    }
+  } else {
+    std::unique_ptr<DataBuffer> sampler_buffer;
+    RETURN_IF_NOT_OK(sampler_->GetNextBuffer(&sampler_buffer));
+    while (!sampler_buffer->eoe()) {
+      TensorRow sample_row;
+      RETURN_IF_NOT_OK(sampler_buffer->PopRow(&sample_row));
+      std::shared_ptr<Tensor> sample_ids = sample_row[0];
+      if (sample_ids->type() != DataType(DataType::DE_INT64)) {
+        RETURN_STATUS_UNEXPECTED("Sampler Tensor isn't int64");
+      }
+      for (auto itr = sample_ids->begin<int64_t>(); itr != sample_ids->end<int64_t>(); ++itr) {
+        if ((*itr) >= num_rows) continue;  // index out of bound, skipping
+        RETURN_IF_NOT_OK(add_row(*itr));
+      }
+      RETURN_IF_NOT_OK(sampler_->GetNextBuffer(&sampler_buffer));
+    }
+  }
+  if (!table->empty()) {
+    RETURN_IF_NOT_OK(SendBuffer(std::move(table)));
+  }
+  return Status::OK();
+}
+
+Status CacheOp::AddToCache(const TensorRow &row) {
+  CachedRow cached;
+  cached.addr = nullptr;
+  cached.offset = 0;
+  cached.size = 0;
+  for (const auto &t : row) {
+    cached.shapes.push_back(t->shape());
+    cached.types.push_back(t->type());
+    cached.size += t->SizeInBytes();
+  }
+
+  if (mem_size_ > 0 && arena_ == nullptr) {
+    RETURN_IF_NOT_OK(Arena::CreateArena(&arena_, mem_size_));
+  }
+  // The Arena fails the request when it is full, or when the row alone is larger than the Arena.
+  // Either way the row goes to the spill file.
+  if (arena_ != nullptr && cached.size > 0 && arena_->Allocate(cached.size, &cached.addr).IsOk()) {
+    auto dest = static_cast<unsigned char *>(cached.addr);
+    for (const auto &t : row) {
+      dsize_t sz = t->SizeInBytes();
+      if (sz > 0) {
+        int ret_code = memcpy_s(dest, sz, t->StartAddr(), sz);
+        if (ret_code != 0) {
+          RETURN_STATUS_UNEXPECTED("Failed to copy a row into the cache.");
+        }
+        dest += sz;
+      }
+    }
+    num_rows_in_mem_++;
+  } else {
+    if (!spill_stream_.is_open()) {
+      Path dir(spill_dir_);
+      if (!dir.Exists()) {
+        RETURN_IF_NOT_OK(dir.CreateDirectories());
+      }
+      spill_file_ = (dir / ("cache_op_" + Services::GetUniqueID() + ".bin")).toString();
+      spill_stream_.open(spill_file_, std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
+      if (!spill_stream_.is_open()) {
+        RETURN_STATUS_UNEXPECTED("Failed to open the cache spill file " + spill_file_);
+      }
+      MS_LOG(INFO) << "Cache operator spills to " << spill_file_ << ".";
+    }
+    cached.addr = nullptr;
+    cached.offset = spill_size_;
+    for (const auto &t : row) {
+      dsize_t sz = t->SizeInBytes();
+      if (sz > 0) {
+        (void)spill_stream_.write(reinterpret_cast<const char *>(t->StartAddr()), sz);
+      }
+    }
+    if (!spill_stream_.good()) {
+      RETURN_STATUS_UNEXPECTED("Failed to write the cache spill file " + spill_file_);
+    }
+    spill_size_ += cached.size;
+    num_rows_spilled_++;
+  }
+  rows_.push_back(std::move(cached));
+  return Status::OK();
+}
+
+Status CacheOp::ReadFromCache(int64_t row_id, TensorRow *row) {
+  const CachedRow &cached = rows_[row_id];
+  const unsigned char *src = static_cast<const unsigned char *>(cached.addr);
+  if (src == nullptr && cached.size > 0) {
+    (void)spill_stream_.seekg(cached.offset);
+  }
+  row->clear();
+  row->reserve(cached.shapes.size());
+  for (size_t i = 0; i < cached.shapes.size(); i++) {
+    std::shared_ptr<Tensor> t;
+    RETURN_IF_NOT_OK(Tensor::CreateTensor(&t, TensorImpl::kFlexible, cached.shapes[i], cached.types[i]));
+    dsize_t sz = t->SizeInBytes();
+    if (sz > 0) {
+      if (src != nullptr) {
+        int ret_code = memcpy_s(t->StartAddr(), sz, src, sz);
+        if (ret_code != 0) {
+          RETURN_STATUS_UNEXPECTED("Failed to copy a row from the cache.");
+        }
+        src += sz;
+      } else {
+        (void)spill_stream_.read(reinterpret_cast<char *>(t->StartAddr()), sz);
+        if (!spill_stream_.good()) {
+          RETURN_STATUS_UNEXPECTED("Failed to read the cache spill file " + spill_file_);
+        }
+      }
+    }
+    row->push_back(std::move(t));
+  }
+  return Status::OK();
+}
+
+Status CacheOp::SendBuffer(std::unique_ptr<TensorQTable> table) {
+  auto buffer = std::make_unique<DataBuffer>(buffer_id_++, DataBuffer::kDeBFlagNone);
+  buffer->set_tensor_table(std::move(table));
+  buffer->set_column_name_map(column_name_map_);
+  return out_connector_->Add(0, std::move(buffer));
+}
+
+Status CacheOp::EoeReceived(int32_t worker_id) {
+  state_ = OpState::kDeOpIdle;
+  return Status::OK();
+}
+
+Status CacheOp::EofReceived(int32_t worker_id) { return Status::OK(); }
+
+Status CacheOp::Reset() {
+  if (sampler_ != nullptr && !rows_.empty()) {
+    RETURN_IF_NOT_OK(sampler_->Reset());
+  }
+  buffer_id_ = 0;
+  wp_.Set();  // wake up master thread after reset is done
+  return Status::OK();
+}
+
+Status CacheOp::ResetSubtree() {
+  if (cache_complete_) {
+    return Reset();
+  }
+  return DatasetOp::ResetSubtree();
+}
+
+Status CacheOp::GetNumSamples(int64_t *num) const {
+  if (num == nullptr || !cache_complete_) {
+    RETURN_STATUS_UNEXPECTED("NumRow not set");
+  }
+  (*num) = static_cast<int64_t>(rows_.size());
+  return Status::OK();
+}
+
+Status CacheOp::GetNumRowsInDataset(int64_t *num) const { return GetNumSamples(num); }
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,246 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef DATASET_ENGINE_DATASETOPS_CACHE_OP_H_
+#define DATASET_ENGINE_DATASETOPS_CACHE_OP_H_
+
+#include <fstream>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "dataset/core/tensor.h"
+#include "dataset/core/tensor_shape.h"
+#include "dataset/engine/dataset_iterator.h"
+#include "dataset/engine/datasetops/pipeline_op.h"
+#include "dataset/engine/datasetops/source/sampler/sampler.h"
+#include "dataset/util/arena.h"
+#include "dataset/util/status.h"
+#include "dataset/util/wait_post.h"
+
+namespace mindspore {
+namespace dataset {
+// Forward declare
+class ExecutionTree;
+
+class DataBuffer;
+
+// CacheOp keeps a copy of every row produced by the subtree below it during the first epoch, and serves all the
+// later epochs from that copy instead of running the subtree again. The rows are kept in an Arena of a fixed size.
+// Once the Arena is full the remaining rows are appended to a spill file on local disk.
+// Inside a repeat path the CacheOp takes the role of the leaf: the leaf ops below it are told to stop after one
+// epoch, and the RepeatOp above it resets the CacheOp only. If a sampler is given, the later epochs fetch the
+// cached rows in the order of the sampler, as a leaf op would.
+// Outside of a repeat path there is only one epoch, so the rows are passed through without being cached.
+class CacheOp : public PipelineOp, public RandomAccessOp {
+ public:
+  // Default size of the memory budget in MB
+  static constexpr int64_t kDefaultMemSize = 1024;
+
+  class Builder {
+   public:
+    // Builder constructor.  Creates the builder object.
+    // @note No default args
+    // @return This is a constructor.
+    Builder();
+
+    // Default destructor
+    ~Builder() = default;
+
+    // Setter method.
+    // @param mem_size - The size of the memory budget in MB. 0 sends every row to the spill file.
+    // @return Builder setter method returns reference to the builder.
+    Builder &SetMemSize(int64_t mem_size) {
+      build_mem_size_ = mem_size;
+      return *this;
+    }
+
+    // Setter method.
+    // @param spill_dir - The directory of the spill file. Empty means $TMPDIR, or /tmp if it is not set.
+    // @return Builder setter method returns reference to the builder.
+    Builder &SetSpillDir(const std::string &spill_dir) {
+      build_spill_dir_ = spill_dir;
+      return *this;
+    }
+
+    // Setter method.
+    // @param sampler - The sampler for the epochs served from the cache. Optional.
+    // @return Builder setter method returns reference to the builder.
+    Builder &SetSampler(std::shared_ptr<Sampler> sampler) {
+      build_sampler_ = std::move(sampler);
+      return *this;
+    }
+
+    // Setter method.
+    // @return Builder setter method returns reference to the builder.
+    Builder &SetRowsPerBuffer(int32_t rows_per_buffer) {
+      build_rows_per_buffer_ = rows_per_buffer;
+      return *this;
+    }
+
+    // Setter method.
+    // @return Builder setter method returns reference to the builder.
+    Builder &SetOpConnectorSize(int32_t op_connector_size) {
+      build_op_connector_size_ = op_connector_size;
+      return *this;
+    }
+
+    // The builder "build" method creates the final object.
+    // @param ptr - Returns the new CacheOp object
+    // @return Status - The error code return
+    Status Build(std::shared_ptr<CacheOp> *ptr);
+
+   private:
+    int64_t build_mem_size_;
+    std::string build_spill_dir_;
+    std::shared_ptr<Sampler> build_sampler_;
+    int32_t build_rows_per_buffer_;
+    int32_t build_op_connector_size_;
+
+    Status SanityCheck() const;
+  };
+
+  // Constructor of the CacheOp
+  // @note The builder class should be used to call it
+  // @param mem_size - The size of the memory budget in MB
+  // @param spill_dir - The directory of the spill file
+  // @param sampler - The sampler for the epochs served from the cache, can be nullptr
+  // @param rows_per_buffer - The requested number of rows per buffer
+  // @param op_connector_size - The output connector queue size
+  CacheOp(int64_t mem_size, const std::string &spill_dir, std::shared_ptr<Sampler> sampler, int32_t rows_per_buffer,
+          int32_t op_connector_size);
+
+  // Destructor. Removes the spill file.
+  ~CacheOp();
+
+  // A print method typically used for debugging
+  // @param out - The output stream to write output to
+  // @param show_all - A bool to control if you want to show all info or just a summary
+  void Print(std::ostream &out, bool show_all) const override;
+
+  // << Stream output operator overload
+  // @notes This allows you to write the debug print info using stream operators
+  // @param out - reference to the output stream being overloaded
+  // @param co - reference to the CacheOp to display
+  // @return - the output stream must be returned
+  friend std::ostream &operator<<(std::ostream &out, const CacheOp &co) {
+    co.Print(out, false);
+    return out;
+  }
+
+  // Class functor operator () override.
+  // All dataset ops operate by launching a thread (see ExecutionTree). This class functor will
+  // provide the master loop that drives the logic for performing the work
+  // @return Status - The error code return
+  Status operator()() override;
+
+  // Base-class override for special eoe handler.
+  // CacheOp sends its own eoe once it has drained an epoch from the child or from the cache.
+  // @return Status - The error code return
+  Status EoeReceived(int32_t worker_id) override;
+
+  // Base-class override for special eof handler.
+  // The eof of the child is drained after its only epoch, CacheOp sends its own eof after the last repeat.
+  // @return Status - The error code return
+  Status EofReceived(int32_t worker_id) override;
+
+  // Takes over the repeat flags of the leaf ops below, and registers the wait post.
+  // @return Status - The error code return
+  Status PrepareNodeAction() override;
+
+  // Reset the sampler and wake up the master thread for the next epoch.
+  // @return Status - The error code return
+  Status Reset() override;
+
+  // Once the cache is complete the subtree below has quit, so only this op is reset.
+  // @return Status - The error code return
+  Status ResetSubtree() override;
+
+  // Derived from RandomAccessOp
+  // @param num - Returns the number of cached rows
+  // @return Status - The error code return
+  Status GetNumSamples(int64_t *num) const override;
+
+  // Derived from RandomAccessOp
+  // @param num - Returns the number of cached rows
+  // @return Status - The error code return
+  Status GetNumRowsInDataset(int64_t *num) const override;
+
+  // Getter
+  // @return The number of rows kept in memory
+  int64_t num_rows_in_mem() const { return num_rows_in_mem_; }
+
+  // Getter
+  // @return The number of rows written to the spill file
+  int64_t num_rows_spilled() const { return num_rows_spilled_; }
+
+ private:
+  // Where and how a cached row is stored. The tensor data of all the columns are laid out back to back, either at
+  // addr in the Arena, or at offset in the spill file when addr is nullptr.
+  struct CachedRow {
+    std::vector<TensorShape> shapes;
+    std::vector<DataType> types;
+    void *addr;
+    int64_t offset;
+    int64_t size;
+  };
+
+  // Pass the rows of the child through for one epoch, adding each of them to the cache if caching.
+  // @return Status - The error code return
+  Status FillCache();
+
+  // Send one epoch of rows from the cache, in sampler order if there is a sampler.
+  // @return Status - The error code return
+  Status SendFromCache();
+
+  // Copy a row into the Arena, or into the spill file if the Arena is full.
+  // @param row - The row to add
+  // @return Status - The error code return
+  Status AddToCache(const TensorRow &row);
+
+  // Rebuild a row from the cache.
+  // @param row_id - The index of the row in the order it was cached
+  // @param row - Returns the row
+  // @return Status - The error code return
+  Status ReadFromCache(int64_t row_id, TensorRow *row);
+
+  // Send a table of rows to the output connector.
+  // @param table - The rows to send
+  // @return Status - The error code return
+  Status SendBuffer(std::unique_ptr<TensorQTable> table);
+
+  int64_t mem_size_;  // In MB
+  std::string spill_dir_;
+  std::string spill_file_;
+  std::shared_ptr<Sampler> sampler_;
+  int32_t rows_per_buffer_;
+  int32_t buffer_id_;
+  bool caching_;         // True if the op is in a repeat path, so the rows have to be cached
+  bool cache_complete_;  // True after the first epoch
+  std::shared_ptr<Arena> arena_;
+  std::fstream spill_stream_;
+  int64_t spill_size_;
+  std::vector<CachedRow> rows_;
+  int64_t num_rows_in_mem_;
+  int64_t num_rows_spilled_;
+  std::unordered_map<std::string, int32_t> column_name_map_;
+  std::unique_ptr<ChildIterator> child_iterator_;
+  WaitPost wp_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // DATASET_ENGINE_DATASETOPS_CACHE_OP_H_
@@ -21,6 +21,8 @@
 #include <utility>
 #include <string>
 
+#include "dataset/core/config_manager.h"
+#include "dataset/core/global_context.h"
 #include "dataset/engine/execution_tree.h"
 #include "dataset/engine/datasetops/device_queue_op.h"
 #include "dataset/engine/data_buffer.h"
@@ -36,7 +38,8 @@ DatasetOp::DatasetOp(int32_t op_connector_size)
       operator_id_(kInvalidOperatorId),
       tree_(nullptr),
       state_(OpState::kDeOpIdle),
-      op_ctrl_flags_(kDeOpNone) {
+      op_ctrl_flags_(kDeOpNone),
+      profiling_(false) {
   // The operator starts out with an invalid operator id.  The only way to
   // get it out of invalid state is to assign the operator to an execution tree.
 }
@@ -82,7 +85,8 @@ void DatasetOp::CreateConnector(int32_t num_producers, int32_t num_consumers) {
   if (oc_queue_size_ > 0) {
     out_connector_ = std::make_unique<DbConnector>(num_producers,  // The number of producers
                                                    num_consumers,  // Only one consumer (the training App)
-                                                   oc_queue_size_);
+                                                   oc_queue_size_,
+                                                   GlobalContext::config_manager()->lock_free_connector());
   } else {
     // Some op's may choose not to have an output connector
     MS_LOG(INFO) << "Bypassed connector creation for tree operator: " << operator_id_ << ".";
@@ -90,6 +94,14 @@ void DatasetOp::CreateConnector(int32_t num_producers, int32_t num_consumers) {
   }
 }
 
+// Turn on the collection of runtime statistics for the profiler
+void DatasetOp::EnableProfiling() {
+  profiling_ = true;
+  if (out_connector_) {
+    out_connector_->EnableProfiling();
+  }
+}
+
 // A print method typically used for debugging.  showAll of true will recursively descend to child prints
 void DatasetOp::Print(std::ostream &out, bool show_all) const {
   if (show_all) {
@@ -117,6 +129,15 @@ Status DatasetOp::GetNextBuffer(std::unique_ptr<DataBuffer> *p_buffer, int32_t w
   return Status::OK();
 }
 
+// Drops the first rows this op sends from the output connector
+Status DatasetOp::SkipRows(int64_t num_rows) {
+  if (out_connector_ == nullptr) {
+    RETURN_STATUS_UNEXPECTED("Operator " + std::to_string(operator_id_) + " has no output connector to skip rows.");
+  }
+  out_connector_->SkipRows(num_rows);
+  return Status::OK();
+}
+
 // Gets the next buffer from the given child .  This function also has built-in eoe and eof
 // message handling so that child classes don't have to manually code pass-through logic when
 // those messages are received.
@@ -18,6 +18,7 @@
 
 #include <memory>
 #include <vector>
+#include <nlohmann/json.hpp>
 #include "dataset/core/constants.h"
 #include "dataset/engine/db_connector.h"
 #include "dataset/util/status.h"
@@ -27,6 +28,10 @@ namespace dataset {
 // Forward declare
 class ExecutionTree;
 
+class AutoTune;
+
+class PipelineProfiler;
+
 class DataBuffer;
 
 // The base class DatasetOp is the main tree node.  It is an abstract class, so
@@ -35,6 +40,12 @@ class DatasetOp : public std::enable_shared_from_this<DatasetOp> {
   // Allow execution tree to access internal members
   friend class ExecutionTree;
 
+  // Allow the auto tuner to sample and resize the connectors
+  friend class AutoTune;
+
+  // Allow the profiler to sample the connectors
+  friend class PipelineProfiler;
+
  public:
   static constexpr int32_t kInvalidOperatorId = -1;
 
@@ -188,6 +199,32 @@ class DatasetOp : public std::enable_shared_from_this<DatasetOp> {
   // @return Status
   virtual Status RegisterWorkerConnectors() { return Status::OK(); }
 
+  // Turn on the collection of runtime statistics for the profiler. Called by the tree before the op is launched.
+  // @notes Derived versions of this function should always call it's superclass version first.
+  virtual void EnableProfiling();
+
+  // Getter function
+  // @return T/F if runtime statistics are collected
+  bool profiling() const { return profiling_; }
+
+  // Save what this op needs to replay its output after a restart, such as the seeds of its random generators.
+  // The base class implementation saves nothing.
+  // @param state - The json object to write the state into
+  // @return Status - The error code return
+  virtual Status SaveState(nlohmann::json *state) const { return Status::OK(); }
+
+  // Restore the state written by SaveState. Called by the tree after it is prepared and before it is launched.
+  // @param state - The json object holding the state
+  // @return Status - The error code return
+  virtual Status RestoreState(const nlohmann::json &state) { return Status::OK(); }
+
+  // Drop the first rows this op would send, they were already consumed before the restart. Called by the tree
+  // before it is launched. The base class implementation drops the rows when the parent pops them from the output
+  // connector, derived classes may pass the skip down to their child or skip the rows without loading them.
+  // @param num_rows - The number of rows to skip
+  // @return Status - The error code return
+  virtual Status SkipRows(int64_t num_rows);
+
  protected:
   // Adds a parent operator to this operator
   // @notes External callers do not have access to this function.
@@ -202,6 +239,7 @@ class DatasetOp : public std::enable_shared_from_this<DatasetOp> {
   OpState state_;                                  // The state of the operator, Running, Idle, Terminated
   uint32_t op_ctrl_flags_;                         // Flags for the operator
   std::unique_ptr<DbConnector> out_connector_;     // Output Connector
+  bool profiling_;                                 // Collect runtime statistics for the profiler
 
  private:
   // Sets the operator id.
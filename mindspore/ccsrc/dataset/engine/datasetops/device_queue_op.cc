@@ -22,6 +22,7 @@
 #include "dataset/core/global_context.h"
 #include "dataset/engine/data_buffer.h"
 #include "dataset/engine/dataset_iterator.h"
+#include "dataset/util/pinned_pool.h"
 #include "dataset/util/status.h"
 #include "dataset/util/task_manager.h"
 
@@ -38,17 +39,54 @@ DeviceQueueOp::DeviceQueueOp(std::string channel_name, DeviceType device_type, i
       device_type_(device_type),
       device_id_(device_id),
       prefetch_size_(prefetch_size),
-      num_batch_(num_batch) {}
+      num_batch_(num_batch),
+      bytes_copied_(0) {}
 
 DeviceQueueOp::~DeviceQueueOp() {}
 
 #ifdef ENABLE_GPUQUE
-void ReleaseData(void *addr) {
-  if (addr != nullptr) {
+void ReleaseData(void *addr) { DeviceQueueOp::ReleaseHostBuffer(addr); }
+#endif
+
+Status DeviceQueueOp::AcquireHostBuffer(const std::shared_ptr<Tensor> &tensor, unsigned char **addr,
+                                        int64_t *bytes_copied) {
+  if (tensor == nullptr || addr == nullptr || bytes_copied == nullptr) {
+    RETURN_STATUS_UNEXPECTED("Invalid arguments to acquire a host buffer.");
+  }
+  unsigned char *data = tensor->StartAddr();
+  std::shared_ptr<PinnedPool> pinned_pool = GlobalContext::Instance()->pinned_pool();
+  if (data != nullptr && pinned_pool->Owns(data)) {
+    // The tensor data is a pinned slab already. Take a reference so it stays alive after the tensor is gone.
+    RETURN_IF_NOT_OK(pinned_pool->AddRef(data));
+    *addr = data;
+    *bytes_copied = 0;
+    return Status::OK();
+  }
+  dsize_t size = tensor->SizeInBytes();
+  *addr = static_cast<unsigned char *>(malloc(size));
+  if (*addr == nullptr) {
+    return Status(StatusCode::kOutOfMemory, __LINE__, __FILE__, "host buffer malloc failed.");
+  }
+  if (size > 0 && memcpy_s(*addr, size, data, size) != 0) {
+    free(*addr);
+    *addr = nullptr;
+    RETURN_STATUS_UNEXPECTED("host buffer memcpy_s failed.");
+  }
+  *bytes_copied = size;
+  return Status::OK();
+}
+
+void DeviceQueueOp::ReleaseHostBuffer(void *addr) {
+  if (addr == nullptr) {
+    return;
+  }
+  std::shared_ptr<PinnedPool> pinned_pool = GlobalContext::Instance()->pinned_pool();
+  if (pinned_pool->Owns(addr)) {
+    pinned_pool->Deallocate(addr);
+  } else {
     free(addr);
   }
 }
-#endif
 
 DeviceQueueOp::Builder::Builder(int32_t prefetch_size)
     : builder_prefetch_size_(prefetch_size),
@@ -165,6 +203,9 @@ Status DeviceQueueOp::SendDataToGPU() {
   }
 
   MS_LOG(INFO) << "Device queue total batch is " << total_batch << ", number of batches is " << num_batch_ << ".";
+  if (total_batch > 0) {
+    MS_LOG(INFO) << "Device queue copied " << bytes_copied_ / total_batch << " bytes per batch on the host.";
+  }
 
   GpuBufferMgr::GetInstance().Close(handle);
 
@@ -181,8 +222,8 @@ Status DeviceQueueOp::RetryPushGPUData(uint32_t feature_size, uint32_t label_siz
     RETURN_IF_NOT_OK(MallocForGPUData(&feature_addr, feature_size, &label_addr, label_size, curr_row));
     auto ret = GpuBufferMgr::GetInstance().Push(handle, feature_addr, feature_size, label_addr, label_size, WAIT_TIME);
     if (ret) {
-      free(feature_addr);
-      free(label_addr);
+      ReleaseHostBuffer(feature_addr);
+      ReleaseHostBuffer(label_addr);
       MS_LOG(WARNING) << "Retry pushing data...";
       continue;
     } else {
@@ -194,29 +235,15 @@ Status DeviceQueueOp::RetryPushGPUData(uint32_t feature_size, uint32_t label_siz
 
 Status DeviceQueueOp::MallocForGPUData(unsigned char **feature_addr, uint32_t feature_size, unsigned char **label_addr,
                                        uint32_t label_size, const TensorRow &curr_row) {
-  *feature_addr = (unsigned char *)malloc(feature_size);
-  if (*feature_addr == nullptr) {
-    return Status(StatusCode::kUnexpectedError, __LINE__, __FILE__, "feature memory malloc failed.");
-  }
-  (void)memset_s(*feature_addr, feature_size, 0, feature_size);
-  unsigned char *feature = curr_row[0]->StartAddr();
-  if (memcpy_s(*feature_addr, feature_size, feature, static_cast<uint32_t>(curr_row[0]->SizeInBytes())) != 0) {
-    MS_LOG(ERROR) << "Feature memcpy_s failed!";
-    return Status(StatusCode::kUnexpectedError, __LINE__, __FILE__, "feature memcpy_s failed.");
+  int64_t bytes_copied = 0;
+  RETURN_IF_NOT_OK(AcquireHostBuffer(curr_row[0], feature_addr, &bytes_copied));
+  bytes_copied_ += bytes_copied;
+  Status rc = AcquireHostBuffer(curr_row[1], label_addr, &bytes_copied);
+  if (rc.IsError()) {
+    ReleaseHostBuffer(*feature_addr);
+    return rc;
   }
-
-  *label_addr = (unsigned char *)malloc(label_size);
-  if (*label_addr == nullptr) {
-    free(*feature_addr);
-    return Status(StatusCode::kUnexpectedError, __LINE__, __FILE__, "label memory malloc failed.");
-  }
-  (void)memset_s(*label_addr, label_size, 0, label_size);
-  unsigned char *label = curr_row[1]->StartAddr();
-  if (memcpy_s(*label_addr, label_size, label, static_cast<uint32_t>(curr_row[1]->SizeInBytes())) != 0) {
-    MS_LOG(ERROR) << "Label memcpy_s failed!";
-    return Status(StatusCode::kUnexpectedError, __LINE__, __FILE__, "label memcpy_s failed.");
-  }
-
+  bytes_copied_ += bytes_copied;
   return Status::OK();
 }
 #endif
@@ -20,6 +20,7 @@
 #include <string>
 #include <vector>
 
+#include "dataset/core/tensor.h"
 #include "dataset/engine/datasetops/pipeline_op.h"
 #include "dataset/util/status.h"
 
@@ -119,6 +120,9 @@ class DeviceQueueOp : public PipelineOp {
 
   Status EoeReceived(int32_t worker_id) override;
 
+  // The rows to skip were already sent to the device before the restart, the child does not send them again.
+  Status SkipRows(int64_t num_rows) override { return child_[0]->SkipRows(num_rows); }
+
   const int32_t get_prefetch_size() { return prefetch_size_; }
 
   // Name: Print()
@@ -134,6 +138,18 @@ class DeviceQueueOp : public PipelineOp {
 
   Status operator()() override;
 
+  // Get a host buffer with the data of a tensor to hand over to a device queue. If the data of the tensor is a
+  // pinned slab it is shared without a copy, otherwise it is copied to a new buffer.
+  // @param tensor - The tensor to hand over
+  // @param addr - Returns the host buffer, to be given back with ReleaseHostBuffer()
+  // @param bytes_copied - Returns the number of bytes copied, 0 if the data is shared
+  // @return Status - The error code return
+  static Status AcquireHostBuffer(const std::shared_ptr<Tensor> &tensor, unsigned char **addr, int64_t *bytes_copied);
+
+  // Give back a host buffer from AcquireHostBuffer()
+  // @param addr - The host buffer
+  static void ReleaseHostBuffer(void *addr);
+
  private:
   //  Name: checkExceptions(DataBuffer);
   //  Description: Check whether the dataBuffer meets the condition for performing DeviceQueueOp
@@ -156,6 +172,7 @@ class DeviceQueueOp : public PipelineOp {
   const int32_t device_id_;
   const int32_t prefetch_size_;
   const int64_t num_batch_;
+  int64_t bytes_copied_;  // The bytes copied on the host to hand the data over to the device
 
 #ifdef ENABLE_TDTQUE
   std::shared_ptr<TdtPlugin> tdtInstancePtr;
@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 #include "dataset/engine/datasetops/map_op.h"
+#include <algorithm>
+#include <chrono>
 #include <cstring>
 #include <iostream>
 #include <memory>
@@ -27,13 +29,14 @@
 #include "dataset/engine/db_connector.h"
 #include "dataset/engine/execution_tree.h"
 #include "dataset/kernels/tensor_op.h"
+#include "dataset/kernels/tensor_op_fusion.h"
 #include "utils/log_adapter.h"
 #include "dataset/util/task_manager.h"
 
 namespace mindspore {
 namespace dataset {
 // Builder constructor. Creates the builder object.
-MapOp::Builder::Builder() : build_perf_mode_(true) {
+MapOp::Builder::Builder() : build_perf_mode_(true), build_fuse_ops_(true) {
   std::shared_ptr<ConfigManager> cfg = GlobalContext::config_manager();
   build_num_workers_ = cfg->num_parallel_workers();
   build_op_connector_size_ = cfg->op_connector_size();
@@ -53,16 +56,19 @@ Status MapOp::Builder::Build(std::shared_ptr<MapOp> *ptr) {
   RETURN_IF_NOT_OK(sanityCheck());
   *ptr = std::make_shared<MapOp>(std::move(build_in_col_names_), std::move(build_out_col_names_),
                                  std::move(build_tensor_funcs_), build_num_workers_, build_op_connector_size_,
-                                 build_perf_mode_);
+                                 build_perf_mode_, build_fuse_ops_);
   return Status::OK();
 }
 
 // Constructor of MapOp
 MapOp::MapOp(const std::vector<std::string> &in_col_names, const std::vector<std::string> &out_col_names,
              std::vector<std::shared_ptr<TensorOp>> tensor_funcs, int32_t num_workers, int32_t op_connector_size,
-             bool perf_mode)
+             bool perf_mode, bool fuse_ops)
     : ParallelOp(num_workers, op_connector_size),
-      tfuncs_(std::move(tensor_funcs)),
+      tfuncs_(fuse_ops ? FuseTensorOps(tensor_funcs) : tensor_funcs),
+      num_fused_ops_(static_cast<int32_t>(tensor_funcs.size() - tfuncs_.size())),
+      in_place_computes_(0),
+      rows_computed_(0),
       in_columns_(in_col_names),
       out_columns_(out_col_names),
       perf_mode_(perf_mode) {
@@ -70,7 +76,13 @@ MapOp::MapOp(const std::vector<std::string> &in_col_names, const std::vector<std
   if (out_columns_.empty() || out_columns_[0].empty()) {
     out_columns_ = in_columns_;
   }
+  compute_by_column_ = std::all_of(tfuncs_.begin(), tfuncs_.end(),
+                                   [](const std::shared_ptr<TensorOp> &op) { return op->OneToOne(); });
   MS_LOG(DEBUG) << "Performance Mode in map operator is " << perf_mode_ << ".";
+  if (num_fused_ops_ > 0) {
+    MS_LOG(INFO) << "Map operator fused " << tensor_funcs.size() << " TensorOps into " << tfuncs_.size()
+                 << ", saving " << num_fused_ops_ << " allocations per row.";
+  }
 }
 
 // The number of threads consuming data from previous op's output Connector.
@@ -94,14 +106,38 @@ void MapOp::Print(std::ostream &out, bool show_all) const {
   for (size_t i = 0; i < tfuncs_.size(); i++) {
     out << " " << tfuncs_[i];
   }
+  out << "\n  Fused TensorOps: " << num_fused_ops_;
+  out << "\n  Allocations avoided per row: " << allocations_avoided_per_row();
   out << "\n";
 }
 
+// Override base class to also measure the compute time of each TensorOp
+void MapOp::EnableProfiling() {
+  ParallelOp::EnableProfiling();
+  tfunc_compute_ns_ = std::make_unique<std::atomic<int64_t>[]>(tfuncs_.size());
+  for (size_t i = 0; i < tfuncs_.size(); i++) {
+    tfunc_compute_ns_[i] = 0;
+  }
+}
+
+int64_t MapOp::tfunc_compute_ns(size_t index) const {
+  if (tfunc_compute_ns_ == nullptr || index >= tfuncs_.size()) {
+    return 0;
+  }
+  return tfunc_compute_ns_[index].load(std::memory_order_relaxed);
+}
+
+double MapOp::allocations_avoided_per_row() const {
+  int64_t rows = rows_computed_.load(std::memory_order_relaxed);
+  int64_t in_place = in_place_computes_.load(std::memory_order_relaxed);
+  return num_fused_ops_ + (rows > 0 ? static_cast<double>(in_place) / rows : 0.0);
+}
+
 // This class functor will provide the master loop that drives the logic for performing the work
 Status MapOp::operator()() {
   if (perf_mode_) {
     // Create and register the local queues.
-    local_queues_.Init(num_workers_, oc_queue_size_);
+    local_queues_.Init(num_workers_, oc_queue_size_, GlobalContext::config_manager()->lock_free_connector());
     RETURN_IF_NOT_OK(local_queues_.Register(tree_->AllTasks()));
   }
 
@@ -181,8 +217,12 @@ Status MapOp::WorkerEntry(int32_t worker_id) {
 
     std::unique_ptr<TensorQTable> new_tensor_table(std::make_unique<TensorQTable>());
     // Perform the compute function of TensorOp(s) and store the result in new_tensor_table.
-    RETURN_IF_NOT_OK(WorkerCompute(in_buffer.get(), to_process_indices, new_tensor_table.get(), keep_input_columns,
-                                   &input_columns, &output_columns));
+    // The number of workers computing at the same time may be limited by the auto tuner.
+    RETURN_IF_NOT_OK(AcquireWorkerSlot(worker_id));
+    Status rc = WorkerCompute(in_buffer.get(), to_process_indices, new_tensor_table.get(), keep_input_columns,
+                              &input_columns, &output_columns);
+    ReleaseWorkerSlot(worker_id);
+    RETURN_IF_NOT_OK(rc);
 
     // Update column name to index mapping because tensorOp might add/remove column.
     in_buffer->set_column_name_map(final_col_name_id_map);
@@ -199,9 +239,14 @@ Status MapOp::WorkerEntry(int32_t worker_id) {
 Status MapOp::WorkerCompute(DataBuffer *in_buffer, const std::vector<size_t> &to_process_indices,
                             TensorQTable *new_tensor_table, const std::vector<bool> &keep_input_columns,
                             std::vector<std::string> *input_columns, std::vector<std::string> *output_columns) {
+  if (compute_by_column_ && to_process_indices.size() == 1 && output_columns->size() == 1) {
+    return WorkerComputeColumn(in_buffer, to_process_indices[0], new_tensor_table);
+  }
+
   // Getting number of rows and cols in this buffer.
   int32_t num_rows = in_buffer->NumRows();
   int32_t num_cols = in_buffer->NumCols();
+  int64_t in_place_computes = 0;
 
   for (int32_t r = 0; r < num_rows; r++) {
     // to_process   : A vector of Tensors only holding cols in input_columns.
@@ -222,7 +267,24 @@ Status MapOp::WorkerCompute(DataBuffer *in_buffer, const std::vector<size_t> &to
       // TensorOp base class will call the single column Compute() depending on the ops.
       // Note: The columns of the result_row is not preallocated, the compute function of each tensor op are
       // required to resize/push back the result_row
-      RETURN_IF_NOT_OK(tfuncs_[i]->Compute(to_process, &result_row));
+      // A 1-1 TensorOp whose input is referenced by nobody else may overwrite it instead of allocating its output.
+      auto start = profiling_ ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point();
+      bool done = false;
+      if (to_process.size() == 1 && to_process[0] != nullptr && to_process[0].use_count() == 1 &&
+          tfuncs_[i]->OneToOne()) {
+        RETURN_IF_NOT_OK(tfuncs_[i]->ComputeInPlace(to_process[0], &done));
+      }
+      if (done) {
+        result_row = std::move(to_process);
+        in_place_computes++;
+      } else {
+        RETURN_IF_NOT_OK(tfuncs_[i]->Compute(to_process, &result_row));
+      }
+      if (profiling_) {
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        tfunc_compute_ns_[i].fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count(),
+                                       std::memory_order_relaxed);
+      }
 
       // Assign result_row to to_process for the next TensorOp processing, except for the last TensorOp in the list.
       if (i + 1 < tfuncs_.size()) {
@@ -252,7 +314,71 @@ Status MapOp::WorkerCompute(DataBuffer *in_buffer, const std::vector<size_t> &to
       new_tensor_table->push_back(std::move(result_row));
     }
   }
+  in_place_computes_.fetch_add(in_place_computes, std::memory_order_relaxed);
+  rows_computed_.fetch_add(num_rows, std::memory_order_relaxed);
+
+  return Status::OK();
+}
+
+// Applying the 1-1 TensorOps to a single column, a whole buffer at a time.
+Status MapOp::WorkerComputeColumn(DataBuffer *in_buffer, size_t col_index, TensorQTable *new_tensor_table) {
+  int32_t num_rows = in_buffer->NumRows();
+  int64_t in_place_computes = 0;
+  std::vector<TensorRow> rows(num_rows);
+  TensorRow column(num_rows);
+  for (int32_t r = 0; r < num_rows; r++) {
+    RETURN_IF_NOT_OK(in_buffer->PopRow(&rows[r]));
+    column[r] = std::move(rows[r][col_index]);
+  }
+
+  // pending        : The Tensors of the rows that could not be computed in place.
+  // pending_rows   : The row of each of the pending Tensors.
+  TensorRow pending, result;
+  std::vector<int32_t> pending_rows;
+  pending.reserve(num_rows);
+  pending_rows.reserve(num_rows);
+  for (size_t i = 0; i < tfuncs_.size(); i++) {
+    auto start = profiling_ ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point();
+    // A Tensor referenced by nobody else may be overwritten, the others go to the batched compute. Once a row goes
+    // there the next ones follow, so that the random TensorOps still see the rows in order.
+    for (int32_t r = 0; r < num_rows; r++) {
+      bool done = false;
+      if (pending.empty() && column[r] != nullptr && column[r].use_count() == 1) {
+        RETURN_IF_NOT_OK(tfuncs_[i]->ComputeInPlace(column[r], &done));
+      }
+      if (done) {
+        in_place_computes++;
+      } else {
+        pending.push_back(std::move(column[r]));
+        pending_rows.push_back(r);
+      }
+    }
+    if (!pending.empty()) {
+      result.clear();
+      RETURN_IF_NOT_OK(tfuncs_[i]->ComputeBatch(pending, &result));
+      if (result.size() != pending.size()) {
+        return Status(StatusCode::kUnexpectedError, __LINE__, __FILE__,
+                      "Result of a tensorOp doesn't match the number of rows");
+      }
+      for (size_t j = 0; j < result.size(); j++) {
+        column[pending_rows[j]] = std::move(result[j]);
+      }
+      pending.clear();
+      pending_rows.clear();
+    }
+    if (profiling_) {
+      auto elapsed = std::chrono::steady_clock::now() - start;
+      tfunc_compute_ns_[i].fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count(),
+                                     std::memory_order_relaxed);
+    }
+  }
 
+  for (int32_t r = 0; r < num_rows; r++) {
+    rows[r][col_index] = std::move(column[r]);
+    new_tensor_table->push_back(std::move(rows[r]));
+  }
+  in_place_computes_.fetch_add(in_place_computes, std::memory_order_relaxed);
+  rows_computed_.fetch_add(num_rows, std::memory_order_relaxed);
   return Status::OK();
 }
 
@@ -16,6 +16,7 @@
 #ifndef DATASET_ENGINE_DATASETOPS_MAP_OP_H_
 #define DATASET_ENGINE_DATASETOPS_MAP_OP_H_
 
+#include <atomic>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -114,6 +115,14 @@ class MapOp : public ParallelOp {
       return *this;
     }
 
+    // Setter method.
+    // @param fuse_ops Replace the chains of TensorOps that have a fused TensorOp with it, see FuseTensorOps().
+    // @return Builder setter method returns reference to the builder.
+    Builder &SetTensorOpFusion(bool fuse_ops) {
+      build_fuse_ops_ = fuse_ops;
+      return *this;
+    }
+
     // The builder "build" method creates the final object.
     // @param ptr The shared_ptr to the new MapOp object
     // @return Status
@@ -126,6 +135,7 @@ class MapOp : public ParallelOp {
     int32_t build_num_workers_;
     int32_t build_op_connector_size_;
     bool build_perf_mode_;  // Default true.
+    bool build_fuse_ops_;   // Default true.
 
     // Check if the required parameters are set by the builder.
     // @return Status The error code return
@@ -139,9 +149,11 @@ class MapOp : public ParallelOp {
   // @param tensor_funcs A list of TensorOp pointers for MapOp to apply to each data.
   // @param num_workers The number of worker threads.
   // @param op_connector_size The size of each queue in the connector.
+  // @param perf_mode Whether the main thread distributes the buffers to local queues of the workers.
+  // @param fuse_ops Whether the chains of tensor_funcs that have a fused TensorOp are replaced with it.
   MapOp(const std::vector<std::string> &in_col_names, const std::vector<std::string> &out_col_names,
         std::vector<std::shared_ptr<TensorOp>> tensor_funcs, int32_t num_workers, int32_t op_connector_size,
-        bool perf_mode);
+        bool perf_mode, bool fuse_ops = false);
 
   // Destructor
   ~MapOp() = default;
@@ -171,6 +183,38 @@ class MapOp : public ParallelOp {
   // @return the number of threads consuming data from previous op's output Connector.
   int32_t num_consumers() const override;
 
+  // Getter
+  // @return T/F if the auto tuner is allowed to change the number of active workers of this op
+  bool AutoTunable() const override { return true; }
+
+  // Override base class to also measure the compute time of each TensorOp
+  void EnableProfiling() override;
+
+  // Base-class override. Each input row gives one output row, so the skipped rows are skipped by the child
+  // before any TensorOp runs on them.
+  // @param num_rows - The number of rows to skip
+  // @return Status - The error code return
+  Status SkipRows(int64_t num_rows) override { return child_[0]->SkipRows(num_rows); }
+
+  // Getter
+  // @return the list of TensorOps applied by this op
+  const std::vector<std::shared_ptr<TensorOp>> &tfuncs() const { return tfuncs_; }
+
+  // Getter
+  // @param index The position of the TensorOp in tfuncs().
+  // @return the total time in nanoseconds spent in the Compute() of that TensorOp, summed over all workers. Always 0
+  // if profiling is off.
+  int64_t tfunc_compute_ns(size_t index) const;
+
+  // Getter
+  // @return the number of TensorOps removed by the fusion, each of them allocated an output Tensor per row
+  int32_t num_fused_ops() const { return num_fused_ops_; }
+
+  // Getter
+  // @return the number of output Tensors per row not allocated thanks to the fusion and to the TensorOps computed in
+  //     place, averaged over the rows computed so far
+  double allocations_avoided_per_row() const;
+
  private:
   // Local queues where worker threads can pop from.
   // Popping directly from the Connector can block if the previous designated threads haven't pop.
@@ -180,6 +224,19 @@ class MapOp : public ParallelOp {
   // Static variables to be ready by worker threads, no modification and readonly
   const std::vector<std::shared_ptr<TensorOp>> tfuncs_;
 
+  // Number of TensorOps given to the constructor minus the number of tfuncs_
+  const int32_t num_fused_ops_;
+
+  // Number of TensorOps computed in place and number of rows computed, summed over all workers
+  std::atomic<int64_t> in_place_computes_;
+  std::atomic<int64_t> rows_computed_;
+
+  // True if every TensorOp is 1-1, a single column is then computed a whole buffer at a time, see ComputeBatch()
+  bool compute_by_column_;
+
+  // Compute time of each TensorOp, only allocated when profiling
+  std::unique_ptr<std::atomic<int64_t>[]> tfunc_compute_ns_;
+
   // Variable to store the column name that the tensorOps are consuming
   std::vector<std::string> in_columns_;
 
@@ -213,6 +270,13 @@ class MapOp : public ParallelOp {
                        TensorQTable *new_tensor_table, const std::vector<bool> &keep_input_columns,
                        std::vector<std::string> *input_columns, std::vector<std::string> *output_columns);
 
+  // Private function for worker thread to apply the 1-1 TensorOps to a single column of the DataBuffer, each TensorOp
+  // gets all the rows of the buffer at once.
+  // @param in_buffer A raw pointer to the DataBuffer.
+  // @param col_index Index of the column processed by the TensorOps, replaced by their result.
+  // @param[out] new_tensor_table A new Tensor Table to be populated in this function.
+  Status WorkerComputeColumn(DataBuffer *in_buffer, size_t col_index, TensorQTable *new_tensor_table);
+
   // Private function for validating if each of the user specified input column names
   // exist in the DataBuffer.
   // @param col_name_id_map The column name to index mapping obtained from DataBuffer.
@@ -15,6 +15,7 @@
  */
 #include "dataset/engine/datasetops/parallel_op.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <iostream>
 #include <map>
@@ -23,6 +24,7 @@
 #include "dataset/engine/datasetops/dataset_op.h"
 #include "dataset/engine/execution_tree.h"
 #include "dataset/core/config_manager.h"
+#include "dataset/core/global_context.h"
 #include "dataset/engine/db_connector.h"
 
 #include "dataset/engine/datasetops/source/storage_client.h"
@@ -36,7 +38,10 @@ ParallelOp::ParallelOp(int32_t num_workers, int32_t op_connector_size)
       num_workers_(num_workers),
       num_producers_(num_workers),
       worker_connector_size_(1),
-      worker_connector_(nullptr) {}
+      worker_connector_(nullptr),
+      active_workers_(num_workers),
+      busy_workers_(0),
+      waiting_workers_(0) {}
 
 // Creates the internal worker connector for the parallel op if the derived class wants to use it
 Status ParallelOp::CreateWorkerConnector(int32_t worker_connector_size) {
@@ -48,7 +53,8 @@ Status ParallelOp::CreateWorkerConnector(int32_t worker_connector_size) {
   // Instantiate the worker connector.  This is the internal connector, not the operators
   // output connector.  It has single master consuming from it (num producers is 1), and the number
   // of workers is the defined count from the op.
-  worker_connector_ = std::make_unique<DbConnector>(num_workers_, num_producers_, worker_connector_size);
+  worker_connector_ = std::make_unique<DbConnector>(num_workers_, num_producers_, worker_connector_size,
+                                                    GlobalContext::config_manager()->lock_free_connector());
 
   return Status::OK();
 }
@@ -60,7 +66,8 @@ void ParallelOp::Print(std::ostream &out, bool show_all) const {
 
   // Then show our own stuff
   out << "ParallelOp:";
-  out << "\n  Num workers                   : " << num_workers_ << "\n";
+  out << "\n  Num workers                   : " << num_workers_;
+  out << "\n  Num active workers            : " << active_workers_ << "\n";
 }
 
 // Override base class reset to provide reset actions specific to the ParallelOp class.
@@ -78,10 +85,77 @@ Status ParallelOp::Reset() {
 
 // Register the internal worker connectors
 Status ParallelOp::RegisterWorkerConnectors() {
+  RETURN_IF_NOT_OK(slot_cv_.Register(tree_->AllTasks()->GetIntrpService()));
   if (worker_connector_) {
     return (worker_connector_->Register(tree_->AllTasks()));
   }
   return Status::OK();
 }
+
+void ParallelOp::SetActiveWorkers(int32_t n) {
+  n = std::max(1, std::min(n, num_workers_));
+  active_workers_ = n;
+  std::unique_lock<std::mutex> lck(slot_mux_);
+  slot_cv_.NotifyAll();
+}
+
+void ParallelOp::EnableProfiling() {
+  DatasetOp::EnableProfiling();
+  worker_busy_ns_ = std::make_unique<std::atomic<int64_t>[]>(num_workers_);
+  for (int32_t i = 0; i < num_workers_; ++i) {
+    worker_busy_ns_[i] = 0;
+  }
+  worker_busy_start_.resize(num_workers_);
+}
+
+int64_t ParallelOp::worker_busy_ns(int32_t worker_id) const {
+  if (worker_busy_ns_ == nullptr || worker_id < 0 || worker_id >= num_workers_) {
+    return 0;
+  }
+  return worker_busy_ns_[worker_id].load(std::memory_order_relaxed);
+}
+
+Status ParallelOp::AcquireWorkerSlot(int32_t worker_id) {
+  // Fast path. Take a slot without locking as long as we are below the limit.
+  int32_t busy = busy_workers_.load();
+  while (busy < active_workers_.load()) {
+    if (busy_workers_.compare_exchange_weak(busy, busy + 1)) {
+      if (worker_busy_ns_ != nullptr) {
+        worker_busy_start_[worker_id] = std::chrono::steady_clock::now();
+      }
+      return Status::OK();
+    }
+  }
+  // Slow path. Park until a slot is released or the limit is raised.
+  std::unique_lock<std::mutex> lck(slot_mux_);
+  waiting_workers_.fetch_add(1);
+  Status rc = slot_cv_.Wait(&lck, [this]() -> bool {
+    int32_t cur = busy_workers_.load();
+    while (cur < active_workers_.load()) {
+      if (busy_workers_.compare_exchange_weak(cur, cur + 1)) {
+        return true;
+      }
+    }
+    return false;
+  });
+  waiting_workers_.fetch_sub(1);
+  if (rc.IsOk() && worker_busy_ns_ != nullptr) {
+    worker_busy_start_[worker_id] = std::chrono::steady_clock::now();
+  }
+  return rc;
+}
+
+void ParallelOp::ReleaseWorkerSlot(int32_t worker_id) {
+  if (worker_busy_ns_ != nullptr) {
+    auto elapsed = std::chrono::steady_clock::now() - worker_busy_start_[worker_id];
+    worker_busy_ns_[worker_id].fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count(),
+                                         std::memory_order_relaxed);
+  }
+  busy_workers_.fetch_sub(1);
+  if (waiting_workers_.load() > 0) {
+    std::unique_lock<std::mutex> lck(slot_mux_);
+    slot_cv_.NotifyOne();
+  }
+}
 }  // namespace dataset
 }  // namespace mindspore
@@ -16,10 +16,14 @@
 #ifndef DATASET_ENGINE_DATASETOPS_PARALLEL_OP_H_
 #define DATASET_ENGINE_DATASETOPS_PARALLEL_OP_H_
 
+#include <atomic>
+#include <chrono>
 #include <memory>
+#include <mutex>
 #include <vector>
 #include "dataset/core/constants.h"
 #include "dataset/engine/datasetops/dataset_op.h"
+#include "dataset/util/cond_var.h"
 #include "dataset/util/status.h"
 
 namespace mindspore {
@@ -98,16 +102,59 @@ class ParallelOp : public DatasetOp {
   // @return Status
   Status RegisterWorkerConnectors() override;
 
+  // Getter
+  // @return T/F if the auto tuner is allowed to change the number of active workers of this op
+  virtual bool AutoTunable() const { return false; }
+
+  // Getter
+  // @return the number of workers allowed to compute at the same time
+  int32_t active_workers() const { return active_workers_.load(); }
+
+  // Limit the number of workers that can compute at the same time. All num_workers_ threads stay alive, the ones
+  // above the limit block in AcquireWorkerSlot until the limit is raised again.
+  // @param n - the new limit, clamped to [1, num_workers_]
+  void SetActiveWorkers(int32_t n);
+
+  // Override base class to also measure the busy time of each worker
+  void EnableProfiling() override;
+
+  // Getter
+  // @param worker_id - the worker to query
+  // @return the total time in nanoseconds the worker spent between AcquireWorkerSlot and ReleaseWorkerSlot. Always
+  // 0 if profiling is off or if the op doesn't report its work through the worker slots.
+  int64_t worker_busy_ns(int32_t worker_id) const;
+
  protected:
   // Interface for derived classes to implement. All derived classes must provide the entry
   // function with the main execution loop for worker threads.
   // @return Status - The error code return
   virtual Status WorkerEntry(int32_t workerId) = 0;
 
+  // Called by a worker before it starts computing a unit of work. Blocks while active_workers_ workers are
+  // already busy.
+  // @param worker_id - the id of the calling worker
+  // @return Status - The error code return
+  Status AcquireWorkerSlot(int32_t worker_id);
+
+  // Called by a worker when it is done with a unit of work.
+  // @param worker_id - the id of the calling worker
+  void ReleaseWorkerSlot(int32_t worker_id);
+
   int32_t num_workers_;    // The number of worker threads
   int32_t num_producers_;  // The number of threads pushing to the out_connector_
   int32_t worker_connector_size_;
   std::unique_ptr<DbConnector> worker_connector_;  // The internal connector for worker threads
+
+ private:
+  std::atomic<int32_t> active_workers_;   // The number of workers allowed to compute at the same time
+  std::atomic<int32_t> busy_workers_;     // The number of workers currently computing
+  std::atomic<int32_t> waiting_workers_;  // The number of workers blocked in AcquireWorkerSlot
+  std::mutex slot_mux_;
+  CondVar slot_cv_;
+
+  // Busy time of each worker, only allocated when profiling. Each start time is only touched by its own worker.
+  std::unique_ptr<std::atomic<int64_t>[]> worker_busy_ns_;
+  std::vector<std::chrono::steady_clock::time_point> worker_busy_start_;
 };
 }  // namespace dataset
 }  // namespace mindspore
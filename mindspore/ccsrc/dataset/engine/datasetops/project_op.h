@@ -101,6 +101,11 @@ class ProjectOp : public PipelineOp {
   // @return Status - The error code returned.
   Status EofReceived(int32_t worker_id) override;
 
+  // Base-class override. Projecting does not change the rows count, the skip is passed down to the child.
+  // @param num_rows - The number of rows to skip
+  // @return Status - The error code return
+  Status SkipRows(int64_t num_rows) override { return child_[0]->SkipRows(num_rows); }
+
  private:
   std::vector<std::string> columns_to_project_;
 
@@ -93,6 +93,11 @@ class RenameOp : public PipelineOp {
 
   Status EoeReceived(int32_t) override;
 
+  // Base-class override. Renaming does not change the rows count, the skip is passed down to the child.
+  // @param num_rows - The number of rows to skip
+  // @return Status - The error code return
+  Status SkipRows(int64_t num_rows) override { return child_[0]->SkipRows(num_rows); }
+
   // Print function for Rename
   // @param out output stream to print to
   // @param show_all if it should print everything
@@ -110,6 +110,12 @@ class RepeatOp : public PipelineOp {
   // @param worker_id - The worker id
   Status EofReceived(int32_t worker_id) override;
 
+  // Base-class override. The child replays all the repeats, so the skip is passed down to it and the repeat
+  // counter catches up from the eoe messages of the skipped repeats.
+  // @param num_rows - The number of rows to skip
+  // @return Status - The error code return
+  Status SkipRows(int64_t num_rows) override { return child_[0]->SkipRows(num_rows); }
+
   // Base-class override. Return the number of workers in the first parent.
   // @param workerId - The worker id
   int32_t num_consumers() const override;
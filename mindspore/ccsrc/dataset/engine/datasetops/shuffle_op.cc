@@ -16,6 +16,8 @@
 #include <securec.h>
 #include <algorithm>
 #include <chrono>
+#include <cstdio>
+#include <cstdlib>
 #include <iostream>
 #include <limits>
 #include <random>
@@ -26,7 +28,9 @@
 #include "dataset/engine/dataset_iterator.h"
 #include "dataset/engine/data_buffer.h"
 #include "dataset/engine/db_connector.h"
+#include "dataset/util/path.h"
 #include "dataset/util/random.h"
+#include "dataset/util/services.h"
 #include "dataset/util/status.h"
 
 #include "utils/log_adapter.h"
@@ -38,7 +42,8 @@ constexpr int32_t ShuffleOp::kShuffleStateActive;
 constexpr int32_t ShuffleOp::kShuffleStateDrain;
 
 // Builder constructor. Creates the builder object.
-ShuffleOp::Builder::Builder() : build_shuffle_size_(0), build_reshuffle_each_epoch_(true) {
+ShuffleOp::Builder::Builder()
+    : build_shuffle_size_(0), build_reshuffle_each_epoch_(true), build_mem_size_(0), build_block_size_(0) {
   std::shared_ptr<ConfigManager> cfg = GlobalContext::config_manager();
   build_op_connector_size_ = cfg->op_connector_size();
   build_rows_per_buffer_ = cfg->rows_per_buffer();
@@ -49,6 +54,12 @@ Status ShuffleOp::Builder::SanityCheck() const {
   if (build_shuffle_size_ < 2) {
     RETURN_STATUS_UNEXPECTED("Shuffle buffer size must be greater than 1.");
   }
+  if (build_mem_size_ < 0) {
+    RETURN_STATUS_UNEXPECTED("Shuffle buffer memory size must not be negative.");
+  }
+  if (build_block_size_ < 0) {
+    RETURN_STATUS_UNEXPECTED("Shuffle block size must not be negative.");
+  }
   return Status::OK();
 }
 
@@ -56,23 +67,67 @@ Status ShuffleOp::Builder::SanityCheck() const {
 Status ShuffleOp::Builder::Build(std::shared_ptr<ShuffleOp> *ptr) {
   RETURN_IF_NOT_OK(SanityCheck());
   *ptr = std::make_shared<ShuffleOp>(build_shuffle_size_, build_shuffle_seed_, build_op_connector_size_,
-                                     build_reshuffle_each_epoch_, build_rows_per_buffer_);
+                                     build_reshuffle_each_epoch_, build_rows_per_buffer_, build_mem_size_,
+                                     build_block_size_, build_spill_dir_);
   return Status::OK();
 }
 
 // Constructor of the ShuffleOp
 ShuffleOp::ShuffleOp(int32_t shuffle_size, uint32_t shuffle_seed, int32_t op_connector_size, bool reset_every_epoch,
-                     int32_t rows_per_buffer)
+                     int32_t rows_per_buffer, int64_t mem_size, int32_t block_size, const std::string &spill_dir)
     : PipelineOp(op_connector_size),
       shuffle_size_(shuffle_size),
       shuffle_seed_(shuffle_seed),
       reshuffle_each_epoch_(reset_every_epoch),
       rng_(shuffle_seed),
+      epoch_seeds_({shuffle_seed}),
+      epoch_(0),
       buffer_counter_(0),
       rows_per_buffer_(rows_per_buffer),
-      shuffle_buffer_(std::make_unique<TensorTable>()),
-      shuffle_last_row_idx_(0),
-      shuffle_buffer_state_(kShuffleStateInit) {}
+      shuffle_buffer_state_(kShuffleStateInit),
+      mem_size_(mem_size),
+      arena_(nullptr),
+      block_size_(block_size),
+      spill_dir_(spill_dir),
+      next_block_(0),
+      next_row_in_block_(0) {
+  if (spill_dir_.empty()) {
+    const char *tmp_dir = std::getenv("TMPDIR");
+    spill_dir_ = (tmp_dir != nullptr) ? tmp_dir : "/tmp";
+  }
+}
+
+ShuffleOp::~ShuffleOp() {
+  if (spill_stream_.is_open()) {
+    spill_stream_.close();
+  }
+  if (!spill_file_.empty()) {
+    (void)std::remove(spill_file_.c_str());
+  }
+  if (arena_ != nullptr) {
+    for (auto &slot : shuffle_buffer_) {
+      if (slot.addr != nullptr) {
+        arena_->Deallocate(slot.addr);
+      }
+    }
+  }
+}
+
+Status ShuffleOp::SaveState(nlohmann::json *state) const {
+  std::lock_guard<std::mutex> lock(state_mux_);
+  (*state)["epoch_seeds"] = epoch_seeds_;
+  return Status::OK();
+}
+
+Status ShuffleOp::RestoreState(const nlohmann::json &state) {
+  std::lock_guard<std::mutex> lock(state_mux_);
+  epoch_seeds_ = state.at("epoch_seeds").get<std::vector<uint32_t>>();
+  CHECK_FAIL_RETURN_UNEXPECTED(!epoch_seeds_.empty(), "Shuffle state has no seed.");
+  epoch_ = 0;
+  shuffle_seed_ = epoch_seeds_[0];
+  rng_ = std::mt19937_64(shuffle_seed_);
+  return Status::OK();
+}
 
 // Private function to re-init the shuffle op for another epoch.  Shuffle op calls this by
 // itself rather than waiting for the reset driven from operators above it in the pipeline.
@@ -82,17 +137,27 @@ Status ShuffleOp::SelfReset() {
   // epoch.
   // If ReshuffleEachEpoch is true, then the first epoch uses the given seed,
   // and all subsequent epochs will then reset the seed based on random device.
+  // The seeds of the epochs before a restore are replayed.
   if (!reshuffle_each_epoch_) {
     rng_ = std::mt19937_64(shuffle_seed_);
   } else {
-    std::random_device random_device("/dev/urandom");
-    std::uniform_int_distribution<int32_t> distribution(0, std::numeric_limits<int32_t>::max());
-    shuffle_seed_ = distribution(random_device);
+    std::lock_guard<std::mutex> lock(state_mux_);
+    epoch_++;
+    if (epoch_ < epoch_seeds_.size()) {
+      shuffle_seed_ = epoch_seeds_[epoch_];
+    } else {
+      std::random_device random_device("/dev/urandom");
+      std::uniform_int_distribution<int32_t> distribution(0, std::numeric_limits<int32_t>::max());
+      shuffle_seed_ = distribution(random_device);
+      epoch_seeds_.push_back(shuffle_seed_);
+    }
     rng_ = std::mt19937_64(shuffle_seed_);
   }
-  shuffle_buffer_ = std::make_unique<TensorTable>();
+  // The buffer has been drained, so the Arena is empty again and is kept for the next epoch
+  shuffle_buffer_.clear();
+  pending_row_.clear();
+  spill_blocks_.clear();
   buffer_counter_ = 0;
-  shuffle_last_row_idx_ = 0;
   shuffle_buffer_state_ = kShuffleStateInit;
   return Status::OK();
 }
@@ -104,28 +169,90 @@ void ShuffleOp::Print(std::ostream &out, bool show_all) const {
 
   // Then display our own stuff
   out << "ShuffleOp:\n  Shuffle size: " << shuffle_size_ << "\n  rows_per_buffer_: " << rows_per_buffer_
-      << "\n  shuffle_buffer_state_: " << shuffle_buffer_state_ << "\n  shuffle_seed_: " << shuffle_seed_;
+      << "\n  shuffle_buffer_state_: " << shuffle_buffer_state_ << "\n  shuffle_seed_: " << shuffle_seed_
+      << "\n  Memory size (MB): " << mem_size_ << "\n  Block size: " << block_size_;
   out << "\n-------------------------\n\n";  // End the display with this line
 }
 
 // Private function to add a new row to the shuffle buffer.
-Status ShuffleOp::AddRowToShuffleBuffer(TensorRow new_shuffle_row) {
-  // If the last slot of our shuffle buffer was not the full size of the shuffle buffer then we are
-  // filling it during the initial fill codepath and thus growing it's size. In that case, we push
-  // back the new row to grow our shuffle buffer size by 1.
-  // If we are already at the full size, then we overwrite the last slot with our row (and the last
-  // slot better be empty because it should already have been swapped out during the random row
-  // selection that was done previously!)
-  if (shuffle_last_row_idx_ < (shuffle_size_ - 1)) {
-    shuffle_buffer_->push_back(std::move(new_shuffle_row));
-    shuffle_last_row_idx_ = (shuffle_buffer_->size()) - 1;
+Status ShuffleOp::AddRowToShuffleBuffer(TensorRow *new_shuffle_row, bool *added) {
+  BufferedRow slot;
+  slot.addr = nullptr;
+  slot.layout.size = 0;
+  if (mem_size_ == 0) {
+    slot.row = std::move(*new_shuffle_row);
+    new_shuffle_row->clear();
+    shuffle_buffer_.push_back(std::move(slot));
+    *added = true;
+    return Status::OK();
+  }
+
+  for (const auto &t : *new_shuffle_row) {
+    slot.layout.shapes.push_back(t->shape());
+    slot.layout.types.push_back(t->type());
+    slot.layout.size += t->SizeInBytes();
+  }
+  if (arena_ == nullptr) {
+    RETURN_IF_NOT_OK(Arena::CreateArena(&arena_, mem_size_));
+  }
+  // The Arena fails the request when it is full. The row then waits until enough rows are drained, unless there
+  // is nothing left to drain.
+  if (slot.layout.size > 0 && arena_->Allocate(slot.layout.size, &slot.addr).IsError()) {
+    if (shuffle_buffer_.empty()) {
+      RETURN_STATUS_UNEXPECTED("A row of " + std::to_string(slot.layout.size) +
+                               " bytes does not fit in the shuffle buffer of " + std::to_string(mem_size_) + " MB.");
+    }
+    *added = false;
+    return Status::OK();
+  }
+  auto dest = static_cast<unsigned char *>(slot.addr);
+  for (const auto &t : *new_shuffle_row) {
+    dsize_t sz = t->SizeInBytes();
+    if (sz > 0) {
+      int ret_code = memcpy_s(dest, sz, t->StartAddr(), sz);
+      if (ret_code != 0) {
+        RETURN_STATUS_UNEXPECTED("Failed to copy a row into the shuffle buffer.");
+      }
+      dest += sz;
+    }
+  }
+  new_shuffle_row->clear();
+  shuffle_buffer_.push_back(std::move(slot));
+  *added = true;
+  return Status::OK();
+}
+
+// Private function to remove a row from the shuffle buffer. The last row is moved into its slot.
+Status ShuffleOp::TakeRowFromShuffleBuffer(int64_t slot, TensorRow *row) {
+  BufferedRow &taken = shuffle_buffer_[slot];
+  if (mem_size_ == 0) {
+    *row = std::move(taken.row);
   } else {
-    if (!(*shuffle_buffer_)[shuffle_last_row_idx_].empty()) {
-      return Status(StatusCode::kUnexpectedError, __LINE__, __FILE__,
-                    "Last row of shuffle buffer should not be occupied!");
+    const unsigned char *src = static_cast<const unsigned char *>(taken.addr);
+    row->clear();
+    row->reserve(taken.layout.shapes.size());
+    for (size_t i = 0; i < taken.layout.shapes.size(); i++) {
+      std::shared_ptr<Tensor> t;
+      RETURN_IF_NOT_OK(
+        Tensor::CreateTensor(&t, TensorImpl::kFlexible, taken.layout.shapes[i], taken.layout.types[i]));
+      dsize_t sz = t->SizeInBytes();
+      if (sz > 0) {
+        int ret_code = memcpy_s(t->StartAddr(), sz, src, sz);
+        if (ret_code != 0) {
+          RETURN_STATUS_UNEXPECTED("Failed to copy a row from the shuffle buffer.");
+        }
+        src += sz;
+      }
+      row->push_back(std::move(t));
     }
-    (*shuffle_buffer_)[shuffle_last_row_idx_] = std::move(new_shuffle_row);
+    if (taken.addr != nullptr) {
+      arena_->Deallocate(taken.addr);
+    }
+  }
+  if (static_cast<size_t>(slot) != shuffle_buffer_.size() - 1) {
+    taken = std::move(shuffle_buffer_.back());
   }
+  shuffle_buffer_.pop_back();
   return Status::OK();
 }
 
@@ -155,9 +282,8 @@ Status ShuffleOp::operator()() {
     }
 
     // Next, enter into the main execution loop of the shuffle op.
-    // When the tail index position of our shuffle buffer goes negative it means that we've
-    // fully drained the data from the shuffle buffer and we're done.
-    while (shuffle_last_row_idx_ >= 0) {
+    // When the shuffle buffer is empty it means that we've fully drained the data from it and we're done.
+    while (!shuffle_buffer_.empty()) {
       // Step 1)
       // Create an output tensor table if one is not created yet.
       if (!new_buffer_table) {
@@ -165,17 +291,27 @@ Status ShuffleOp::operator()() {
       }
 
       // Step 2)
-      // Randomly select a slot from our shuffle buffer and copy that row into the output
-      // tensor table. We remove the data from the shuffle buffer, leaving that slot
-      // in the table as an empty vector
-      int64_t random_slot = rng_() % (shuffle_last_row_idx_ + 1);
-      new_buffer_table->push_back(std::move((*shuffle_buffer_)[random_slot]));
+      // Randomly select a slot from our shuffle buffer and move that row into the output
+      // tensor table. The last row of the shuffle buffer takes its slot, keeping the shuffle
+      // buffer contiguous.
+      int64_t random_slot = rng_() % shuffle_buffer_.size();
+      TensorRow row;
+      RETURN_IF_NOT_OK(TakeRowFromShuffleBuffer(random_slot, &row));
+      new_buffer_table->push_back(std::move(row));
 
       // Step 3)
+      // Refill the shuffle buffer with the next rows from input if we are in the active state.
+      // If we are in the draining state, we do not need to fetch another row to replace the one we
+      // just drained.
+      if (shuffle_buffer_state_ == kShuffleStateActive) {
+        RETURN_IF_NOT_OK(FillShuffleBuffer());
+      }
+
+      // Step 4)
       // If the output tensor table is at the requested size, then create a buffer for it
       // and send this buffer on it's way up the pipeline. Special case is if this is the
       // last row then we also send it.
-      if (new_buffer_table->size() == rows_per_buffer_ || shuffle_last_row_idx_ == 0) {
+      if (new_buffer_table->size() == rows_per_buffer_ || shuffle_buffer_.empty()) {
         auto new_buffer = std::make_unique<DataBuffer>(buffer_counter_, DataBuffer::kDeBFlagNone);
         new_buffer->set_tensor_table(std::move(new_buffer_table));
         new_buffer->set_column_name_map(column_name_map_);
@@ -183,36 +319,6 @@ Status ShuffleOp::operator()() {
         MS_LOG(DEBUG) << "Shuffle operator sending a buffer to output.";
         RETURN_IF_NOT_OK(out_connector_->Add(0, std::move(new_buffer)));
       }
-
-      // Step 4)
-      // Take the last row from shuffle buffer, and swap it into the row position that was
-      // just vacated.  This makes the shuffle buffer contiguous, with an empty slot at the
-      // tail of the shuffle buffer.
-      if (random_slot != shuffle_last_row_idx_) {
-        (*shuffle_buffer_)[random_slot] = std::move((*shuffle_buffer_)[shuffle_last_row_idx_]);
-      }
-
-      // Step 5)
-      // Refill the last slot of the shuffle buffer with the next row from input if we are in the
-      // active state.
-      // If we are in the draining state, we do not need to fetch another row to replace the one we
-      // just drained.
-      if (shuffle_buffer_state_ == kShuffleStateActive) {
-        TensorRow new_row;
-        RETURN_IF_NOT_OK(child_iterator_->FetchNextTensorRow(&new_row));
-
-        if (!new_row.empty()) {
-          RETURN_IF_NOT_OK(AddRowToShuffleBuffer(std::move(new_row)));
-        } else {
-          shuffle_buffer_state_ = kShuffleStateDrain;
-        }
-      }
-
-      // If we are draining, reposition (decrement) our tail index in the shuffle buffer since we
-      // just drained a row from it.
-      if (shuffle_buffer_state_ == kShuffleStateDrain) {
-        shuffle_last_row_idx_--;
-      }
     }
 
     // Since we overloaded eoeReceived function, we are responsible to flow the EOE up the
@@ -245,17 +351,20 @@ Status ShuffleOp::InitShuffleBuffer() {
                   "Invalid shuffle buffer state (SHUFFLE_STATE_INIT expected)");
   }
 
+  if (block_size_ > 0) {
+    RETURN_IF_NOT_OK(SpillEpoch());
+  }
+
   // Before we drop into the fetching loop, call the fetch once for the first time
   // to fill the first row and grab the first buffer.
-  TensorRow new_row;
-  RETURN_IF_NOT_OK(child_iterator_->FetchNextTensorRow(&new_row));
+  RETURN_IF_NOT_OK(FetchRow(&pending_row_));
 
   if (child_iterator_->eof_handled()) {
     MS_LOG(INFO) << "Shuffle operator init picked up EOF. No more epochs.";
     return Status::OK();
   }
 
-  if (new_row.empty()) {
+  if (pending_row_.empty()) {
     RETURN_STATUS_UNEXPECTED("Unable to fetch a single row for shuffle buffer.");
   }
 
@@ -263,26 +372,123 @@ Status ShuffleOp::InitShuffleBuffer() {
   column_name_map_ = child_iterator_->col_name_id_map();
 
   // Now fill the rest of the shuffle buffer until we are unable to get the next row or we reached
-  // the desired shuffle buffer size.
-  while (!new_row.empty() && shuffle_buffer_->size() < static_cast<size_t>(shuffle_size_ - 1)) {
-    // Add the previously fetched row
-    RETURN_IF_NOT_OK(AddRowToShuffleBuffer(std::move(new_row)));
+  // the desired shuffle buffer size. If init phase doesn't have more rows, then the fill skips the
+  // active state and jumps straight to the shuffle buffer draining state.
+  shuffle_buffer_state_ = kShuffleStateActive;
+  RETURN_IF_NOT_OK(FillShuffleBuffer());
 
-    // Fetch the next row
-    RETURN_IF_NOT_OK(child_iterator_->FetchNextTensorRow(&new_row));
+  MS_LOG(INFO) << "Shuffle operator finished intializing the shuffle buffer.";
+  return Status::OK();
+}
+
+// Private function to add rows to the shuffle buffer until it is full, or there are no more rows in the epoch.
+Status ShuffleOp::FillShuffleBuffer() {
+  while (shuffle_buffer_.size() < static_cast<size_t>(shuffle_size_)) {
+    // A row which did not fit in the Arena before is tried again first
+    if (pending_row_.empty()) {
+      RETURN_IF_NOT_OK(FetchRow(&pending_row_));
+      if (pending_row_.empty()) {
+        shuffle_buffer_state_ = kShuffleStateDrain;
+        break;
+      }
+    }
+    bool added = false;
+    RETURN_IF_NOT_OK(AddRowToShuffleBuffer(&pending_row_, &added));
+    if (!added) {
+      break;
+    }
   }
+  return Status::OK();
+}
 
-  // If we quit the loop due to being at the shuffle size, still need to add the last row here.
-  if (!new_row.empty()) {
-    RETURN_IF_NOT_OK(AddRowToShuffleBuffer(std::move(new_row)));
-    shuffle_buffer_state_ = kShuffleStateActive;  // Transition to the active state
+// Private function to fetch the next row of the epoch, from the child or from the spill file.
+Status ShuffleOp::FetchRow(TensorRow *row) {
+  if (block_size_ == 0) {
+    return child_iterator_->FetchNextTensorRow(row);
+  }
+  row->clear();
+  if (next_block_ == spill_blocks_.size()) {
+    return Status::OK();
+  }
+  const SpillBlock &block = spill_blocks_[next_block_];
+  if (next_row_in_block_ == 0) {
+    (void)spill_stream_.seekg(block.offset);
+  }
+  const RowLayout &layout = block.rows[next_row_in_block_];
+  row->reserve(layout.shapes.size());
+  for (size_t i = 0; i < layout.shapes.size(); i++) {
+    std::shared_ptr<Tensor> t;
+    RETURN_IF_NOT_OK(Tensor::CreateTensor(&t, TensorImpl::kFlexible, layout.shapes[i], layout.types[i]));
+    dsize_t sz = t->SizeInBytes();
+    if (sz > 0) {
+      (void)spill_stream_.read(reinterpret_cast<char *>(t->StartAddr()), sz);
+      if (!spill_stream_.good()) {
+        RETURN_STATUS_UNEXPECTED("Failed to read the shuffle spill file " + spill_file_);
+      }
+    }
+    row->push_back(std::move(t));
+  }
+  if (++next_row_in_block_ == block.rows.size()) {
+    next_block_++;
+    next_row_in_block_ = 0;
+  }
+  return Status::OK();
+}
+
+// Private function to write all the rows of an epoch of the child to the spill file, and to shuffle the order of
+// the blocks.
+Status ShuffleOp::SpillEpoch() {
+  TensorRow row;
+  RETURN_IF_NOT_OK(child_iterator_->FetchNextTensorRow(&row));
+  if (child_iterator_->eof_handled()) {
+    return Status::OK();
+  }
+
+  if (!spill_stream_.is_open()) {
+    Path dir(spill_dir_);
+    if (!dir.Exists()) {
+      RETURN_IF_NOT_OK(dir.CreateDirectories());
+    }
+    spill_file_ = (dir / ("shuffle_op_" + Services::GetUniqueID() + ".bin")).toString();
+    MS_LOG(INFO) << "Shuffle operator spills to " << spill_file_ << ".";
   } else {
-    // If init phase doesn't have more rows, then skip the active state and jump straight to the
-    // shuffle buffer draining state
-    shuffle_buffer_state_ = kShuffleStateDrain;
+    spill_stream_.close();
+  }
+  // Every epoch starts from an empty file
+  spill_stream_.open(spill_file_, std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!spill_stream_.is_open()) {
+    RETURN_STATUS_UNEXPECTED("Failed to open the shuffle spill file " + spill_file_);
   }
 
-  MS_LOG(INFO) << "Shuffle operator finished intializing the shuffle buffer.";
+  int64_t spill_size = 0;
+  while (!row.empty()) {
+    if (spill_blocks_.empty() || spill_blocks_.back().rows.size() == static_cast<size_t>(block_size_)) {
+      spill_blocks_.push_back({spill_size, {}});
+    }
+    RowLayout layout;
+    layout.size = 0;
+    for (const auto &t : row) {
+      layout.shapes.push_back(t->shape());
+      layout.types.push_back(t->type());
+      dsize_t sz = t->SizeInBytes();
+      if (sz > 0) {
+        (void)spill_stream_.write(reinterpret_cast<const char *>(t->StartAddr()), sz);
+      }
+      layout.size += sz;
+    }
+    if (!spill_stream_.good()) {
+      RETURN_STATUS_UNEXPECTED("Failed to write the shuffle spill file " + spill_file_);
+    }
+    spill_size += layout.size;
+    spill_blocks_.back().rows.push_back(std::move(layout));
+    RETURN_IF_NOT_OK(child_iterator_->FetchNextTensorRow(&row));
+  }
+  (void)spill_stream_.flush();
+
+  std::shuffle(spill_blocks_.begin(), spill_blocks_.end(), rng_);
+  next_block_ = 0;
+  next_row_in_block_ = 0;
+  MS_LOG(INFO) << "Shuffle operator spilled " << spill_blocks_.size() << " blocks of " << block_size_ << " rows.";
   return Status::OK();
 }
 
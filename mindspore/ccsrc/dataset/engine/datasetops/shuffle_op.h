@@ -16,8 +16,10 @@
 #ifndef DATASET_ENGINE_DATASETOPS_SHUFFLE_OP_H_
 #define DATASET_ENGINE_DATASETOPS_SHUFFLE_OP_H_
 
+#include <fstream>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <queue>
 #include <random>
 #include <string>
@@ -28,6 +30,7 @@
 #include "dataset/core/tensor_shape.h"
 #include "dataset/engine/dataset_iterator.h"
 #include "dataset/engine/datasetops/pipeline_op.h"
+#include "dataset/util/arena.h"
 #include "dataset/util/status.h"
 
 namespace mindspore {
@@ -39,6 +42,12 @@ class DbConnector;
 
 class DataBuffer;
 
+// ShuffleOp keeps a buffer of rows and sends a random one of them for every new row it takes from its child.
+// The buffer holds up to shuffle_size rows. With a memory budget the rows are copied into an Arena of that size
+// instead, and the buffer also stops growing once the Arena is full, so large rows are bounded in bytes.
+// With a block size the shuffle has two levels: the rows of the epoch are first written to a spill file in blocks
+// of that many rows, and the blocks are read back in a random order through the (smaller) buffer. This mixes rows
+// from the whole epoch while holding only the buffer in memory.
 class ShuffleOp : public PipelineOp {
   // Shuffle buffer state flags
   //
@@ -79,6 +88,30 @@ class ShuffleOp : public PipelineOp {
       return *this;
     }
 
+    // Setter method.
+    // @param mem_size - The size of the memory budget of the shuffle buffer in MB. 0 keeps the rows as they are.
+    // @return Builder setter method returns reference to the builder.
+    Builder &SetMemSize(int64_t mem_size) {
+      build_mem_size_ = mem_size;
+      return *this;
+    }
+
+    // Setter method.
+    // @param block_size - The number of rows per block of the two level shuffle. 0 disables the block level.
+    // @return Builder setter method returns reference to the builder.
+    Builder &SetBlockSize(int32_t block_size) {
+      build_block_size_ = block_size;
+      return *this;
+    }
+
+    // Setter method.
+    // @param spill_dir - The directory of the block spill file. Empty means $TMPDIR, or /tmp if it is not set.
+    // @return Builder setter method returns reference to the builder.
+    Builder &SetSpillDir(const std::string &spill_dir) {
+      build_spill_dir_ = spill_dir;
+      return *this;
+    }
+
     // Setter method.
     // @return Builder setter method returns reference to the builder.
     Builder &SetRowsPerBuffer(int32_t rows_per_buffer) {
@@ -112,6 +145,9 @@ class ShuffleOp : public PipelineOp {
     int32_t build_rows_per_buffer_;
     bool build_reshuffle_each_epoch_;
     int32_t build_op_connector_size_;
+    int64_t build_mem_size_;
+    int32_t build_block_size_;
+    std::string build_spill_dir_;
 
     Status SanityCheck() const;
   };
@@ -122,11 +158,14 @@ class ShuffleOp : public PipelineOp {
   // @param shuffle_seed - The seed to use for random number generation
   // @param op_connector_size - The output connector queue size
   // @param rows_per_buffer - The requested number of rows per buffer
+  // @param mem_size - The size of the memory budget of the shuffle buffer in MB, 0 for no budget
+  // @param block_size - The number of rows per block of the two level shuffle, 0 for a single level
+  // @param spill_dir - The directory of the block spill file
   ShuffleOp(int32_t shuffle_size, uint32_t shuffle_seed, int32_t op_connector_size, bool reset_every_epoch,
-            int32_t rows_per_buffer);
+            int32_t rows_per_buffer, int64_t mem_size = 0, int32_t block_size = 0, const std::string &spill_dir = "");
 
-  // Destructor
-  ~ShuffleOp() = default;
+  // Destructor. Removes the spill file.
+  ~ShuffleOp();
 
   // A print method typically used for debugging
   // @param out - The output stream to write output to
@@ -155,16 +194,70 @@ class ShuffleOp : public PipelineOp {
   // @return Status - The error code return
   Status EoeReceived(int32_t worker_id) override;
 
+  // Base-class override. Saves the seeds of the epochs shuffled so far, the seeds drawn for reshuffling are not
+  // reproducible otherwise.
+  // @param state - The json object to write the state into
+  // @return Status - The error code return
+  Status SaveState(nlohmann::json *state) const override;
+
+  // Base-class override. The epochs are shuffled again with the saved seeds, the following epochs draw new ones.
+  // @param state - The json object holding the state
+  // @return Status - The error code return
+  Status RestoreState(const nlohmann::json &state) override;
+
  private:
+  // The shapes and types of the tensors of a row, and their total size in bytes
+  struct RowLayout {
+    std::vector<TensorShape> shapes;
+    std::vector<DataType> types;
+    int64_t size;
+  };
+
+  // A slot of the shuffle buffer. Without a memory budget the row itself is kept, otherwise the tensor data of
+  // all the columns are laid out back to back at addr in the Arena.
+  struct BufferedRow {
+    TensorRow row;
+    RowLayout layout;
+    void *addr;
+  };
+
+  // A block of rows in the spill file, starting at offset
+  struct SpillBlock {
+    int64_t offset;
+    std::vector<RowLayout> rows;
+  };
+
   // Private function to add a new row to the shuffle buffer.
+  // @param new_shuffle_row - The row to add, it is moved from only if it was added
+  // @param added - Returns false if the Arena has no room for the row yet
   // @return Status - The error code return
-  Status AddRowToShuffleBuffer(TensorRow new_shuffle_row);
+  Status AddRowToShuffleBuffer(TensorRow *new_shuffle_row, bool *added);
+
+  // Private function to remove a row from the shuffle buffer. The last row is moved into its slot.
+  // @param slot - The slot of the row
+  // @param row - Returns the row
+  // @return Status - The error code return
+  Status TakeRowFromShuffleBuffer(int64_t slot, TensorRow *row);
 
   // Private function to populate the shuffle buffer initially by fetching from the child output
   // connector until the shuffle buffer is full (or there is no more data coming).
   // @return Status - The error code return
   Status InitShuffleBuffer();
 
+  // Private function to add rows to the shuffle buffer until it is full, or there are no more rows in the epoch.
+  // @return Status - The error code return
+  Status FillShuffleBuffer();
+
+  // Private function to fetch the next row of the epoch, from the child or from the spill file.
+  // @param row - Returns the row, empty at the end of the epoch
+  // @return Status - The error code return
+  Status FetchRow(TensorRow *row);
+
+  // Private function to write all the rows of an epoch of the child to the spill file, and to shuffle the order of
+  // the blocks.
+  // @return Status - The error code return
+  Status SpillEpoch();
+
   // Private function to re-init the shuffle op for another epoch.  Shuffle op calls this by
   // itself rather than waiting for the reset driven from operators above it in the pipeline.
   // @return Status - The error code return
@@ -179,12 +272,24 @@ class ShuffleOp : public PipelineOp {
   // (ie uniform_int_distribution) because we will need to create up to |dataset| instances
   // of the distribution object in the common case of a perfect shuffle
   std::mt19937_64 rng_;
+  std::vector<uint32_t> epoch_seeds_;  // The seed of every epoch so far, or to replay after a restore
+  size_t epoch_;                       // Index of the current epoch in epoch_seeds_
+  mutable std::mutex state_mux_;       // Guards epoch_seeds_ against SaveState
   int32_t buffer_counter_;   // For creating new buffer id's
   int32_t rows_per_buffer_;  // Number of rows to pack into output buffer
   // A single (potentially large) buffer of tensor rows for performing shuffling.
-  std::unique_ptr<TensorTable> shuffle_buffer_;
-  int32_t shuffle_last_row_idx_;  // Internal tracking of the last slot of our shuffle buffer
+  std::vector<BufferedRow> shuffle_buffer_;
   int32_t shuffle_buffer_state_;  // State tracking for the shuffle buffer phases of work
+  TensorRow pending_row_;         // A row fetched already, waiting for room in the Arena
+  int64_t mem_size_;              // In MB
+  std::shared_ptr<Arena> arena_;
+  int32_t block_size_;
+  std::string spill_dir_;
+  std::string spill_file_;
+  std::fstream spill_stream_;
+  std::vector<SpillBlock> spill_blocks_;  // In the random order they are read back
+  size_t next_block_;
+  size_t next_row_in_block_;
   std::unordered_map<std::string, int32_t> column_name_map_;  // A mapping between column index to column name.
 
   std::unique_ptr<ChildIterator> child_iterator_;  // An iterator for fetching.
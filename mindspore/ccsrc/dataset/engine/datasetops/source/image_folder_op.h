@@ -199,6 +199,14 @@ class ImageFolderOp : public ParallelOp, public RandomAccessOp {
   // @return Status - The error code return
   Status operator()() override;
 
+  // Base-class overrides. The sampler holds the state of the op, and leaves out the ids of the skipped rows so they
+  // are never loaded.
+  Status SaveState(nlohmann::json *state) const override { return sampler_->SaveState(state); }
+
+  Status RestoreState(const nlohmann::json &state) override { return sampler_->RestoreState(state); }
+
+  Status SkipRows(int64_t num_rows) override { return sampler_->SkipRows(num_rows); }
+
   // Method derived from RandomAccess Op, enable Sampler to get numRows
   // @param int64_t num - to return numRows
   // @return Status - The error code return
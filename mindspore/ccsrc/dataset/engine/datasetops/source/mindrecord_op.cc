@@ -18,6 +18,7 @@
 #include <algorithm>
 #include <cstdint>
 #include <limits>
+#include <type_traits>
 #include <utility>
 
 #include "common/utils.h"
@@ -37,6 +38,28 @@ using mindrecord::MSRStatus;
 using mindrecord::Schema;
 using mindrecord::ShardOperator;
 using mindrecord::ShardReader;
+using mindrecord::ShardShuffle;
+
+namespace {
+// Cast a label read from a typed column, integers out of the range of the tensor type fail like in GetInt
+template <typename S, typename T>
+Status CastLabel(const uint8_t *value, T *label) {
+  S raw = 0;
+  (void)std::copy(value, value + sizeof(S), reinterpret_cast<uint8_t *>(&raw));
+  if (std::is_integral<T>::value) {
+    if (!std::is_integral<S>::value) {
+      RETURN_STATUS_UNEXPECTED("Conversion to int failed.");
+    }
+    auto temp_value = static_cast<int64_t>(raw);
+    if ((temp_value < 0 && temp_value < static_cast<int64_t>(std::numeric_limits<T>::min())) ||
+        (temp_value >= 0 && static_cast<uint64_t>(temp_value) > static_cast<uint64_t>(std::numeric_limits<T>::max()))) {
+      RETURN_STATUS_UNEXPECTED("Conversion to int failed. Out of range");
+    }
+  }
+  *label = static_cast<T>(raw);
+  return Status::OK();
+}
+}  // namespace
 
 // Builder constructor.  Creates the builder object.
 MindRecordOp::Builder::Builder() : build_dataset_file_("") {
@@ -50,6 +73,8 @@ MindRecordOp::Builder::Builder() : build_dataset_file_("") {
   build_rows_per_buffer_ = cfg->rows_per_buffer();
   build_op_connector_queue_size_ = cfg->op_connector_size();
   build_block_reader_ = false;
+  build_use_mmap_ = false;
+  build_io_depth_ = 0;
   builder_num_workers_ = 0;
 }
 
@@ -64,7 +89,8 @@ Status MindRecordOp::Builder::Build(std::shared_ptr<MindRecordOp> *ptr) {
 
   new_mind_record_op = std::make_shared<MindRecordOp>(build_num_mind_record_workers_, build_rows_per_buffer_,
                                                       build_dataset_file_, build_op_connector_queue_size_,
-                                                      build_columns_to_load_, build_operators_, build_block_reader_);
+                                                      build_columns_to_load_, build_operators_, build_block_reader_,
+                                                      build_use_mmap_, build_io_depth_);
 
   RETURN_IF_NOT_OK(new_mind_record_op->Init());
 
@@ -77,7 +103,8 @@ Status MindRecordOp::Builder::SanityCheck() const { return Status::OK(); }
 // Constructor of the MindRecordOp.
 MindRecordOp::MindRecordOp(int32_t num_mind_record_workers, int32_t rows_per_buffer, std::string dataset_file,
                            int32_t op_connector_queue_size, const std::vector<std::string> &columns_to_load,
-                           const std::vector<std::shared_ptr<ShardOperator>> &operators, const bool &block_reader)
+                           const std::vector<std::shared_ptr<ShardOperator>> &operators, const bool &block_reader,
+                           const bool &use_mmap, int32_t io_depth)
     : ParallelOp(num_mind_record_workers, op_connector_queue_size),
       rows_per_buffer_(rows_per_buffer),
       dataset_file_(dataset_file),
@@ -85,12 +112,21 @@ MindRecordOp::MindRecordOp(int32_t num_mind_record_workers, int32_t rows_per_buf
       operators_(operators),
       num_mind_record_workers_(num_mind_record_workers),
       block_reader_(block_reader),
+      use_mmap_(use_mmap),
+      io_depth_(io_depth),
       buffers_needed_(0),
       buf_cnt_(0),
       num_rows_(0),
       ended_worker_(0),
-      buffer_water_mark_(0) {
+      buffer_water_mark_(0),
+      rows_to_skip_(0) {
   io_blk_queues_.Init(num_workers_, op_connector_queue_size);
+  for (const auto &op : operators_) {
+    auto shuffle_op = std::dynamic_pointer_cast<ShardShuffle>(op);
+    if (shuffle_op != nullptr) {
+      shuffle_seeds_.push_back(shuffle_op->get_shuffle_seed());
+    }
+  }
   if (!block_reader_) return;
   for (int32_t i = 0; i < num_workers_; ++i) {
     block_buffer_.emplace_back(std::make_unique<std::vector<ShardTuple>>(std::vector<ShardTuple>{}));
@@ -100,10 +136,14 @@ MindRecordOp::MindRecordOp(int32_t num_mind_record_workers, int32_t rows_per_buf
 // Private helper method to encapsulate some common construction/reset tasks
 Status MindRecordOp::Init() {
   shard_reader_ = std::make_unique<ShardReader>();
-  auto rc = shard_reader_->Open(dataset_file_, num_mind_record_workers_, columns_to_load_, operators_, block_reader_);
+  auto rc = shard_reader_->Open(dataset_file_, num_mind_record_workers_, columns_to_load_, operators_, block_reader_,
+                                use_mmap_);
 
   CHECK_FAIL_RETURN_UNEXPECTED(rc != MSRStatus::FAILED,
                                "MindRecordOp init failed. Error message: " + ErrnoToMessage(rc));
+  shard_reader_->set_io_depth(io_depth_);
+  // Labels of rows are loaded from the typed columns of the reader, so it doesn't need to build json for them
+  shard_reader_->set_columnar_labels(!block_reader_);
 
   data_schema_ = std::make_unique<DataSchema>();
 
@@ -189,13 +229,16 @@ void MindRecordOp::Print(std::ostream &out, bool show_all) const {
   out << "\n  Rows per buffer               : " << rows_per_buffer_;
   out << "\n  Number of buffers             : " << buffers_needed_;
   out << "\n  Number of ShardReader workers : " << num_mind_record_workers_;
+  out << "\n  Memory mapped                 : " << use_mmap_;
+  out << "\n  Async reads in flight         : " << io_depth_;
 
   out << "\n\n";
 }
 
 template <typename T>
-Status MindRecordOp::LoadFeature(std::shared_ptr<Tensor> *tensor, int32_t i_col,
-                                 const std::vector<uint8_t> &columns_blob, const mindrecord::json &columns_json) const {
+Status MindRecordOp::LoadFeature(std::shared_ptr<Tensor> *tensor, int32_t i_col, const uint8_t *columns_blob,
+                                 uint64_t columns_blob_size, const mindrecord::json &columns_json,
+                                 const mindrecord::LABEL_ROW &label_row) const {
   TensorShape new_shape = TensorShape::CreateUnknownRankShape();
   const unsigned char *data = nullptr;
 
@@ -205,11 +248,15 @@ Status MindRecordOp::LoadFeature(std::shared_ptr<Tensor> *tensor, int32_t i_col,
   const ColDescriptor &cur_column = data_schema_->column(i_col);
   std::string column_name = columns_to_load_[i_col];
   DataType type = cur_column.type();
+  int32_t label_id = label_row.first == nullptr ? -1 : label_row.first->GetColumnId(column_name);
 
   // load blob column
-  if (columns_blob_index_[i_col] >= 0 && columns_blob.size() > 0) {
+  if (columns_blob_index_[i_col] >= 0 && columns_blob_size > 0) {
     int32_t pos = columns_blob_.size() == 1 ? -1 : columns_blob_index_[i_col];
-    RETURN_IF_NOT_OK(LoadBlob(&new_shape, &data, columns_blob, pos, cur_column));
+    RETURN_IF_NOT_OK(LoadBlob(&new_shape, &data, columns_blob, columns_blob_size, pos, cur_column));
+  } else if (label_id >= 0) {
+    // load label column
+    RETURN_IF_NOT_OK(LoadLabel(&new_shape, &array_data, &data, label_row, label_id));
   } else {
     switch (type.value()) {
       case DataType::DE_UINT8: {
@@ -244,9 +291,8 @@ Status MindRecordOp::LoadFeature(std::shared_ptr<Tensor> *tensor, int32_t i_col,
   return Status::OK();
 }
 
-Status MindRecordOp::LoadBlob(TensorShape *new_shape, const unsigned char **data,
-                              const std::vector<uint8_t> &columns_blob, const int32_t pos,
-                              const ColDescriptor &column) {
+Status MindRecordOp::LoadBlob(TensorShape *new_shape, const unsigned char **data, const uint8_t *columns_blob,
+                              uint64_t columns_blob_size, const int32_t pos, const ColDescriptor &column) {
   const auto kColumnSize = column.type().SizeInBytes();
   if (kColumnSize == 0) {
     RETURN_STATUS_UNEXPECTED("column size is null");
@@ -255,12 +301,12 @@ Status MindRecordOp::LoadBlob(TensorShape *new_shape, const unsigned char **data
     if (column.hasShape()) {
       *new_shape = TensorShape::CreateUnknownRankShape();
       RETURN_IF_NOT_OK(
-        column.MaterializeTensorShape(static_cast<int32_t>(columns_blob.size() / kColumnSize), new_shape));
+        column.MaterializeTensorShape(static_cast<int32_t>(columns_blob_size / kColumnSize), new_shape));
     } else {
-      std::vector<dsize_t> shapeDetails = {static_cast<dsize_t>(columns_blob.size() / kColumnSize)};
+      std::vector<dsize_t> shapeDetails = {static_cast<dsize_t>(columns_blob_size / kColumnSize)};
       *new_shape = TensorShape(shapeDetails);
     }
-    *data = reinterpret_cast<const uint8_t *>(&(columns_blob[0]));
+    *data = columns_blob;
     return Status::OK();
   }
   auto uint64_from_bytes = [&](int64_t pos) {
@@ -284,7 +330,7 @@ Status MindRecordOp::LoadBlob(TensorShape *new_shape, const unsigned char **data
     std::vector<dsize_t> shapeDetails = {static_cast<dsize_t>(num_bytes / kColumnSize)};
     *new_shape = TensorShape(shapeDetails);
   }
-  *data = reinterpret_cast<const uint8_t *>(&(columns_blob[iStart]));
+  *data = columns_blob + iStart;
   return Status::OK();
 }
 
@@ -423,6 +469,49 @@ Status MindRecordOp::LoadByte(TensorShape *new_shape, std::string *string_data,
   return Status::OK();
 }
 
+template <typename T>
+Status MindRecordOp::LoadLabel(TensorShape *new_shape, std::unique_ptr<T[]> *array_data, const unsigned char **data,
+                               const mindrecord::LABEL_ROW &label_row, int32_t label_id) {
+  const uint8_t *value = nullptr;
+  uint64_t n_bytes = 0;
+  if (label_row.first->GetColumnValue(label_row.second, label_id, &value, &n_bytes) == MSRStatus::FAILED) {
+    RETURN_STATUS_UNEXPECTED("Failed to get label of row " + std::to_string(label_row.second));
+  }
+
+  // Labels are scalars, strings are loaded as their characters
+  T label = 0;
+  switch (label_row.first->GetColumnType(label_id)) {
+    case mindrecord::ColumnString: {
+      std::vector<dsize_t> shape_details = {static_cast<dsize_t>(n_bytes)};
+      *new_shape = TensorShape(shape_details);
+      *data = value;
+      return Status::OK();
+    }
+    case mindrecord::ColumnInt32: {
+      RETURN_IF_NOT_OK(CastLabel<int32_t>(value, &label));
+      break;
+    }
+    case mindrecord::ColumnInt64: {
+      RETURN_IF_NOT_OK(CastLabel<int64_t>(value, &label));
+      break;
+    }
+    case mindrecord::ColumnFloat32: {
+      RETURN_IF_NOT_OK(CastLabel<float>(value, &label));
+      break;
+    }
+    default: {
+      RETURN_IF_NOT_OK(CastLabel<double>(value, &label));
+      break;
+    }
+  }
+  *new_shape = TensorShape::CreateScalar();
+  *array_data = std::make_unique<T[]>(1);
+  (*array_data)[0] = label;
+  *data = reinterpret_cast<const unsigned char *>(array_data->get());
+
+  return Status::OK();
+}
+
 Status MindRecordOp::WorkerEntry(int32_t worker_id) {
   TaskManager::FindMe()->Post();
   std::unique_ptr<IOBlock> io_block;
@@ -454,13 +543,15 @@ Status MindRecordOp::WorkerEntry(int32_t worker_id) {
     }
 
     const uint64_t buffer_id = keys[0];
+    // The first buffer after skipped rows starts in the middle
+    const int32_t first_row = keys.size() > 1 ? static_cast<int32_t>(keys[1]) : 0;
     std::unique_ptr<DataBuffer> fetched_buffer;
 
     // Get the next buffer. Push it up to the output connector.
     if (buffer_id % LOG_INTERVAL == 0) {
       MS_LOG(DEBUG) << "MindRecord operator consumed buffer " << buffer_id << " by worker " << worker_id << ".";
     }
-    RETURN_IF_NOT_OK(GetBufferFromReader(&fetched_buffer, buffer_id, worker_id));
+    RETURN_IF_NOT_OK(GetBufferFromReader(&fetched_buffer, buffer_id, worker_id, first_row));
     RETURN_IF_NOT_OK(out_connector_->Add(worker_id, std::move(fetched_buffer)));
     if (!block_reader_) {
       RETURN_IF_NOT_OK(io_blk_queues_[worker_id]->PopFront(&io_block));
@@ -485,12 +576,29 @@ Status MindRecordOp::WorkerEntry(int32_t worker_id) {
 }
 
 Status MindRecordOp::GetBufferFromReader(std::unique_ptr<DataBuffer> *fetched_buffer, int64_t buffer_id,
-                                         int32_t worker_id) {
+                                         int32_t worker_id, int32_t first_row) {
   *fetched_buffer = std::make_unique<DataBuffer>(buffer_id, DataBuffer::kDeBFlagNone);
   (*fetched_buffer)->set_column_name_map(column_name_mapping_);
   std::unique_ptr<TensorQTable> tensor_table = std::make_unique<TensorQTable>();
-  for (int32_t i = 0; i < rows_per_buffer_; ++i) {
+  for (int32_t i = first_row; i < rows_per_buffer_; ++i) {
+    if (use_mmap_ && !block_reader_ && !shard_reader_->get_compressed()) {
+      int32_t row_id = buffer_id * rows_per_buffer_ + i;
+      // Views into the mapped shard files, the blob data is only copied into the tensors. Compressed rows are
+      // uncompressed into a copy instead
+      auto tupled_view = shard_reader_->GetNextViewById(row_id);
+      if (tupled_view.empty()) break;
+      auto label_row = shard_reader_->GetLabelRow(row_id);
+      for (const auto &tupled_row : tupled_view) {
+        const mindrecord::BLOB_VIEW &columns_blob = std::get<0>(tupled_row);
+        TensorRow tensor_row;
+        RETURN_IF_NOT_OK(
+          LoadTensorRow(&tensor_row, columns_blob.first, columns_blob.second, std::get<1>(tupled_row), label_row));
+        tensor_table->push_back(std::move(tensor_row));
+      }
+      continue;
+    }
     ShardTuple tupled_buffer;
+    mindrecord::LABEL_ROW label_row = {nullptr, 0};
     if (block_reader_) {
       if (i >= block_buffer_[buffer_id % num_workers_]->size()) break;
       tupled_buffer = block_buffer_[buffer_id % num_workers_]->at(i);
@@ -498,21 +606,13 @@ Status MindRecordOp::GetBufferFromReader(std::unique_ptr<DataBuffer> *fetched_bu
       int32_t row_id = buffer_id * rows_per_buffer_ + i;
       tupled_buffer = shard_reader_->GetNextById(row_id, worker_id);
       if (tupled_buffer.empty()) break;
+      label_row = shard_reader_->GetLabelRow(row_id);
     }
     for (const auto &tupled_row : tupled_buffer) {
-      std::vector<uint8_t> columnsBlob = std::get<0>(tupled_row);
-      mindrecord::json columns_json = std::get<1>(tupled_row);
+      const std::vector<uint8_t> &columns_blob = std::get<0>(tupled_row);
       TensorRow tensor_row;
-      for (uint32_t j = 0; j < columns_to_load_.size(); ++j) {
-        std::shared_ptr<Tensor> tensor;
-
-        const ColDescriptor &cur_column = data_schema_->column(j);
-        DataType type = cur_column.type();
-        RETURN_IF_NOT_OK(SwitchLoadFeature(type, &tensor, j, columnsBlob, columns_json));
-
-        tensor_row.push_back(std::move(tensor));
-      }
-
+      RETURN_IF_NOT_OK(
+        LoadTensorRow(&tensor_row, columns_blob.data(), columns_blob.size(), std::get<1>(tupled_row), label_row));
       tensor_table->push_back(std::move(tensor_row));
     }
   }
@@ -522,42 +622,57 @@ Status MindRecordOp::GetBufferFromReader(std::unique_ptr<DataBuffer> *fetched_bu
   return Status::OK();
 }
 
+Status MindRecordOp::LoadTensorRow(TensorRow *tensor_row, const uint8_t *columns_blob, uint64_t columns_blob_size,
+                                   const mindrecord::json &columns_json, const mindrecord::LABEL_ROW &label_row) const {
+  for (uint32_t j = 0; j < columns_to_load_.size(); ++j) {
+    std::shared_ptr<Tensor> tensor;
+
+    const ColDescriptor &cur_column = data_schema_->column(j);
+    DataType type = cur_column.type();
+    RETURN_IF_NOT_OK(SwitchLoadFeature(type, &tensor, j, columns_blob, columns_blob_size, columns_json, label_row));
+
+    tensor_row->push_back(std::move(tensor));
+  }
+  return Status::OK();
+}
+
 Status MindRecordOp::SwitchLoadFeature(const DataType &type, std::shared_ptr<Tensor> *tensor, int32_t i_col,
-                                       const std::vector<uint8_t> &columns_blob,
-                                       const mindrecord::json &columns_json) const {
+                                       const uint8_t *columns_blob, uint64_t columns_blob_size,
+                                       const mindrecord::json &columns_json,
+                                       const mindrecord::LABEL_ROW &label_row) const {
   switch (type.value()) {
     case DataType::DE_BOOL: {
-      return LoadFeature<bool>(tensor, i_col, columns_blob, columns_json);
+      return LoadFeature<bool>(tensor, i_col, columns_blob, columns_blob_size, columns_json, label_row);
     }
     case DataType::DE_INT8: {
-      return LoadFeature<int8_t>(tensor, i_col, columns_blob, columns_json);
+      return LoadFeature<int8_t>(tensor, i_col, columns_blob, columns_blob_size, columns_json, label_row);
     }
     case DataType::DE_UINT8: {
-      return LoadFeature<uint8_t>(tensor, i_col, columns_blob, columns_json);
+      return LoadFeature<uint8_t>(tensor, i_col, columns_blob, columns_blob_size, columns_json, label_row);
     }
     case DataType::DE_INT16: {
-      return LoadFeature<int16_t>(tensor, i_col, columns_blob, columns_json);
+      return LoadFeature<int16_t>(tensor, i_col, columns_blob, columns_blob_size, columns_json, label_row);
     }
     case DataType::DE_UINT16: {
-      return LoadFeature<uint16_t>(tensor, i_col, columns_blob, columns_json);
+      return LoadFeature<uint16_t>(tensor, i_col, columns_blob, columns_blob_size, columns_json, label_row);
     }
     case DataType::DE_INT32: {
-      return LoadFeature<int32_t>(tensor, i_col, columns_blob, columns_json);
+      return LoadFeature<int32_t>(tensor, i_col, columns_blob, columns_blob_size, columns_json, label_row);
     }
     case DataType::DE_UINT32: {
-      return LoadFeature<uint32_t>(tensor, i_col, columns_blob, columns_json);
+      return LoadFeature<uint32_t>(tensor, i_col, columns_blob, columns_blob_size, columns_json, label_row);
     }
     case DataType::DE_INT64: {
-      return LoadFeature<int64_t>(tensor, i_col, columns_blob, columns_json);
+      return LoadFeature<int64_t>(tensor, i_col, columns_blob, columns_blob_size, columns_json, label_row);
     }
     case DataType::DE_UINT64: {
-      return LoadFeature<uint64_t>(tensor, i_col, columns_blob, columns_json);
+      return LoadFeature<uint64_t>(tensor, i_col, columns_blob, columns_blob_size, columns_json, label_row);
     }
     case DataType::DE_FLOAT32: {
-      return LoadFeature<float>(tensor, i_col, columns_blob, columns_json);
+      return LoadFeature<float>(tensor, i_col, columns_blob, columns_blob_size, columns_json, label_row);
     }
     case DataType::DE_FLOAT64: {
-      return LoadFeature<double>(tensor, i_col, columns_blob, columns_json);
+      return LoadFeature<double>(tensor, i_col, columns_blob, columns_blob_size, columns_json, label_row);
     }
     default: {
       return Status(StatusCode::kUnexpectedError, __LINE__, __FILE__,
@@ -594,9 +709,16 @@ Status MindRecordOp::operator()() {
   }
 
   while (true) {  // each iterator is 1 epoch
-    for (int32_t i = 0; i < buffers_needed_; ++i) {
+    // Skipped rows are never read, an epoch skipped as a whole only sends its eoe
+    int64_t skipped = std::min(rows_to_skip_, static_cast<int64_t>(num_rows_));
+    rows_to_skip_ -= skipped;
+    for (int32_t i = skipped / rows_per_buffer_; i < buffers_needed_; ++i) {
       if (block_reader_) RETURN_IF_NOT_OK(FetchBlockBuffer(i));
       std::vector<int64_t> keys(1, i);
+      if (skipped % rows_per_buffer_ != 0) {
+        keys.push_back(skipped % rows_per_buffer_);
+        skipped = 0;
+      }
       RETURN_IF_NOT_OK(io_blk_queues_[buf_cnt_++ % num_workers_]->Add(
         std::make_unique<IOBlock>(IOBlock(keys, IOBlock::kDeIoBlockNone))));
     }
@@ -638,6 +760,33 @@ Status MindRecordOp::Reset() {
   return Status::OK();
 }
 
+Status MindRecordOp::SaveState(nlohmann::json *state) const {
+  (*state)["shuffle_seeds"] = shuffle_seeds_;
+  return Status::OK();
+}
+
+Status MindRecordOp::RestoreState(const nlohmann::json &state) {
+  auto seeds = state.at("shuffle_seeds").get<std::vector<uint32_t>>();
+  CHECK_FAIL_RETURN_UNEXPECTED(seeds.size() == shuffle_seeds_.size(), "MindRecord state does not match the shuffles.");
+  shuffle_seeds_ = seeds;
+  size_t i = 0;
+  for (const auto &op : operators_) {
+    auto shuffle_op = std::dynamic_pointer_cast<ShardShuffle>(op);
+    if (shuffle_op != nullptr) {
+      shuffle_op->set_shuffle_seed(shuffle_seeds_[i++]);
+    }
+  }
+  return Status::OK();
+}
+
+Status MindRecordOp::SkipRows(int64_t num_rows) {
+  if (block_reader_) {
+    return DatasetOp::SkipRows(num_rows);
+  }
+  rows_to_skip_ += num_rows;
+  return Status::OK();
+}
+
 Status MindRecordOp::LaunchThreadAndInitOp() {
   if (tree_ == nullptr) {
     RETURN_STATUS_UNEXPECTED("tree_ not set");
@@ -98,6 +98,18 @@ class MindRecordOp : public ParallelOp {
       return *this;
     }
 
+    // Setter method. Reads the shard files through memory maps, the blob data is copied once into the tensors.
+    Builder &SetUseMmap() {
+      build_use_mmap_ = true;
+      return *this;
+    }
+
+    // Setter method. Number of page reads the ShardReader keeps in flight in block-reader mode, 0 for blocking reads.
+    Builder &SetIoDepth(int32_t io_depth) {
+      build_io_depth_ = io_depth;
+      return *this;
+    }
+
     Status SanityCheck() const;
 
     static int32_t num_mind_record_workers() { return kDefaultMindRecordWorkers; }
@@ -114,6 +126,8 @@ class MindRecordOp : public ParallelOp {
     std::vector<std::string> build_columns_to_load_;
     std::vector<std::shared_ptr<ShardOperator>> build_operators_;
     bool build_block_reader_;
+    bool build_use_mmap_;
+    int32_t build_io_depth_;
   };
 
   // Constructor of the MindRecordOp.
@@ -124,9 +138,13 @@ class MindRecordOp : public ParallelOp {
   // @param op_connector_queue_size - The output connector queue size
   // @param columns_to_load - The list of columns to use (column name)
   // @param operators - ShardOperators for Shuffle, Category, Sample
+  // @param block_reader - Read the data by block
+  // @param use_mmap - Map the shard files into memory instead of reading them through file streams
+  // @param io_depth - The number of async reads in flight, 0 for blocking reads
   MindRecordOp(int32_t num_mind_record_workers, int32_t rows_per_buffer, std::string dataset_file,
                int32_t op_connector_queue_size, const std::vector<std::string> &columns_to_load,
-               const std::vector<std::shared_ptr<ShardOperator>> &operators, const bool &block_reader);
+               const std::vector<std::shared_ptr<ShardOperator>> &operators, const bool &block_reader,
+               const bool &use_mmap = false, int32_t io_depth = 0);
 
   // Destructor
   ~MindRecordOp() override;
@@ -167,6 +185,23 @@ class MindRecordOp : public ParallelOp {
   // @return Status - The error code return
   Status Reset() override;
 
+  // Base-class override. Saves the seeds the global shuffles started from.
+  // @param state - The json object to write the state into
+  // @return Status - The error code return
+  Status SaveState(nlohmann::json *state) const override;
+
+  // Base-class override. The global shuffles start again from the saved seeds, must be called before the reader
+  // creates its tasks at launch.
+  // @param state - The json object holding the state
+  // @return Status - The error code return
+  Status RestoreState(const nlohmann::json &state) override;
+
+  // Base-class override. The row reader starts each epoch at the first row not skipped, without reading the rows
+  // before it. The block reader drops the skipped rows.
+  // @param num_rows - The number of rows to skip
+  // @return Status - The error code return
+  Status SkipRows(int64_t num_rows) override;
+
   // Getter method
   int32_t num_rows() const { return num_rows_; }
 
@@ -184,27 +219,51 @@ class MindRecordOp : public ParallelOp {
 
   bool block_reader() const { return block_reader_; }
 
+  bool use_mmap() const { return use_mmap_; }
+
+  int32_t io_depth() const { return io_depth_; }
+
   Status Init();
 
   Status SetColumnsBlob();
 
  private:
-  Status GetBufferFromReader(std::unique_ptr<DataBuffer> *fetched_buffer, int64_t buffer_id, int32_t worker_id);
+  // Load the rows of a buffer
+  // @param fetched_buffer - returns the buffer
+  // @param buffer_id - the id of the buffer
+  // @param worker_id - the id of the worker loading it
+  // @param first_row - index in the buffer of the first row to load, the rows before it are skipped
+  // @return Status - The error code return
+  Status GetBufferFromReader(std::unique_ptr<DataBuffer> *fetched_buffer, int64_t buffer_id, int32_t worker_id,
+                             int32_t first_row = 0);
+
+  // Parses all the columns of a row received from the reader into tensors
+  // @param tensor_row - the row to put the tensors in
+  // @param columns_blob - the blob data received from the reader, a copy or a view into a mapped shard file
+  // @param columns_blob_size - the size of the blob data
+  // @param columns_json - the data for fields received from the reader
+  // @param label_row - the typed label columns of the row, if the reader holds them
+  Status LoadTensorRow(TensorRow *tensor_row, const uint8_t *columns_blob, uint64_t columns_blob_size,
+                       const mindrecord::json &columns_json, const mindrecord::LABEL_ROW &label_row) const;
 
   // Parses a single cell and puts the data into a tensor
   // @param tensor - the tensor to put the parsed data in
   // @param i_col - the id of column to parse
   // @param columns_blob - the blob data received from the reader
+  // @param columns_blob_size - the size of the blob data
   // @param columns_json - the data for fields received from the reader
+  // @param label_row - the typed label columns of the row, if the reader holds them
   template <typename T>
-  Status LoadFeature(std::shared_ptr<Tensor> *tensor, int32_t i_col, const std::vector<uint8_t> &columns_blob,
-                     const mindrecord::json &columns_json) const;
+  Status LoadFeature(std::shared_ptr<Tensor> *tensor, int32_t i_col, const uint8_t *columns_blob,
+                     uint64_t columns_blob_size, const mindrecord::json &columns_json,
+                     const mindrecord::LABEL_ROW &label_row) const;
 
   Status SwitchLoadFeature(const DataType &type, std::shared_ptr<Tensor> *tensor, int32_t i_col,
-                           const std::vector<uint8_t> &columns_blob, const mindrecord::json &columns_json) const;
+                           const uint8_t *columns_blob, uint64_t columns_blob_size,
+                           const mindrecord::json &columns_json, const mindrecord::LABEL_ROW &label_row) const;
 
-  static Status LoadBlob(TensorShape *new_shape, const unsigned char **data, const std::vector<uint8_t> &columns_blob,
-                         const int32_t pos, const ColDescriptor &column);
+  static Status LoadBlob(TensorShape *new_shape, const unsigned char **data, const uint8_t *columns_blob,
+                         uint64_t columns_blob_size, const int32_t pos, const ColDescriptor &column);
 
   // Get shape and data (scalar or array) for tensor to be created (for floats and doubles)
   // @param new_shape - the shape of tensor to be created.
@@ -230,6 +289,16 @@ class MindRecordOp : public ParallelOp {
   static Status LoadByte(TensorShape *new_shape, std::string *string_data, const std::string &column_name,
                          const mindrecord::json &columns_json);
 
+  // Get shape and data for tensor to be created from a typed label column, without going through json
+  // @param new_shape - the shape of tensor to be created.
+  // @param array_data - the array where a number should be put in
+  // @param data - the data of tensor to be created, pointing to array_data or to the characters of a string
+  // @param label_row - the typed label columns of the row
+  // @param label_id - id of the label column to be processed
+  template <typename T>
+  static Status LoadLabel(TensorShape *new_shape, std::unique_ptr<T[]> *array_data, const unsigned char **data,
+                          const mindrecord::LABEL_ROW &label_row, int32_t label_id);
+
   // Get a single float value from the given json
   // @param value - the float to put the value in
   // @param arrayData - the given json containing the float
@@ -251,11 +320,15 @@ class MindRecordOp : public ParallelOp {
   std::vector<std::shared_ptr<ShardOperator>> operators_;  // ShardOperators to use
   int32_t num_mind_record_workers_;                        // number of workers to be spawned by ShardReader
   bool block_reader_;                                      // block reader switch
+  bool use_mmap_;                                          // mmap switch
+  int32_t io_depth_;                                       // number of async reads in flight
   int32_t buffers_needed_;                                 // Counter for the buffers that were fetched
   int64_t buf_cnt_;                                        // Buffer counter
   int32_t num_rows_;                                       // One more than the last row id in the range for this cache
   std::atomic<int32_t> ended_worker_;
   std::atomic<int32_t> buffer_water_mark_;
+  int64_t rows_to_skip_;                // Rows left to skip by the row reader, through the epochs
+  std::vector<uint32_t> shuffle_seeds_;  // Seeds the global shuffles started from
 
   std::unique_ptr<DataSchema> data_schema_;  // Data schema for column typing
   std::vector<std::string> columns_blob_;    // Blob Columns to load from dataset
@@ -27,6 +27,7 @@ DistributedSampler::DistributedSampler(int64_t num_dev, int64_t dev_id, bool shu
     : Sampler(),
       cnt_(0),
       seed_(seed == std::numeric_limits<uint32_t>::max() ? GetSeed() : seed),
+      start_seed_(seed_),
       device_id_(dev_id),
       num_devices_(num_dev),
       shuffle_(shuffle) {}
@@ -77,5 +78,16 @@ Status DistributedSampler::Reset() {
   }
   return Status::OK();
 }
+
+Status DistributedSampler::SaveState(nlohmann::json *state) const {
+  (*state)["seed"] = start_seed_;
+  return Status::OK();
+}
+
+Status DistributedSampler::RestoreState(const nlohmann::json &state) {
+  start_seed_ = state.at("seed").get<uint32_t>();
+  seed_ = start_seed_;
+  return Status::OK();
+}
 }  // namespace dataset
 }  // namespace mindspore
@@ -50,9 +50,20 @@ class DistributedSampler : public Sampler {
   // @return - The error code return
   Status Reset() override;
 
+  // The seed is increased every epoch, the seed of the first epoch is saved to replay all of them
+  // @param state - The json object to write the state into
+  // @return - The error code return
+  Status SaveState(nlohmann::json *state) const override;
+
+  // Restore the seed of the first epoch, must be called before Init
+  // @param state - The json object holding the state
+  // @return - The error code return
+  Status RestoreState(const nlohmann::json &state) override;
+
  private:
   int64_t cnt_;  // number of samples that have already been filled in to buffer
   uint32_t seed_;
+  uint32_t start_seed_;
   int64_t device_id_;
   int64_t num_devices_;
   bool shuffle_;
@@ -0,0 +1,119 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "dataset/engine/datasetops/source/sampler/elastic_distributed_sampler.h"
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <random>
+#include <utility>
+
+#include "dataset/core/config_manager.h"
+#include "dataset/core/global_context.h"
+#include "dataset/engine/data_buffer.h"
+
+namespace mindspore {
+namespace dataset {
+ElasticDistributedSampler::ElasticDistributedSampler(int64_t num_dev, int64_t dev_id, bool shuffle, uint32_t seed,
+                                                     int64_t epoch, int64_t offset)
+    : Sampler(),
+      cnt_(0),
+      seed_(seed == std::numeric_limits<uint32_t>::max() ? GlobalContext::config_manager()->seed() : seed),
+      device_id_(dev_id),
+      num_devices_(num_dev),
+      shuffle_(shuffle),
+      epoch_(epoch),
+      offset_(offset) {}
+
+Status ElasticDistributedSampler::Init(const RandomAccessOp *op) {
+  RETURN_IF_NOT_OK(Sampler::Init(op));
+  CHECK_FAIL_RETURN_UNEXPECTED(device_id_ < num_devices_ && device_id_ >= 0 && num_rows_ > 0 && num_samples_ > 0,
+                               "fail to init ElasticDistributedSampler");
+  CHECK_FAIL_RETURN_UNEXPECTED(epoch_ >= 0 && offset_ >= 0, "invalid cursor of ElasticDistributedSampler");
+  // A cursor at the end of an epoch resumes from the start of the next one
+  if (offset_ >= num_rows_) {
+    epoch_++;
+    offset_ = 0;
+  }
+  InitEpoch();
+  return Status::OK();
+}
+
+void ElasticDistributedSampler::InitEpoch() {
+  cnt_ = 0;
+  // ceil((num_rows - offset - device_id) / num_devices), the rows left in the epoch for this device
+  int64_t rows_left = num_rows_ - offset_ - device_id_;
+  samples_per_buffer_ = rows_left > 0 ? (rows_left + num_devices_ - 1) / num_devices_ : 0;
+  samples_per_buffer_ = num_samples_ < samples_per_buffer_ ? num_samples_ : samples_per_buffer_;
+  if (shuffle_ == true) {
+    shuffle_vec_.resize(num_rows_);
+    for (int64_t i = 0; i < num_rows_; i++) {
+      shuffle_vec_[i] = i;
+    }
+    // Fisher-Yates shuffle written out rather than std::shuffle, so that every device computes the same order
+    // whatever standard library it is built with
+    std::seed_seq seq{seed_, static_cast<uint32_t>(epoch_), static_cast<uint32_t>(epoch_ >> 32)};
+    std::mt19937_64 rnd(seq);
+    for (int64_t i = num_rows_ - 1; i > 0; i--) {
+      std::swap(shuffle_vec_[i], shuffle_vec_[rnd() % static_cast<uint64_t>(i + 1)]);
+    }
+  }
+}
+
+Status ElasticDistributedSampler::GetNextBuffer(std::unique_ptr<DataBuffer> *out_buffer) {
+  if (cnt_ > samples_per_buffer_) {
+    RETURN_STATUS_UNEXPECTED("Elastic Distributed Sampler Error");
+  } else if (cnt_ == samples_per_buffer_) {
+    (*out_buffer) = std::make_unique<DataBuffer>(0, DataBuffer::kDeBFlagEOE);
+  } else {
+    (*out_buffer) = std::make_unique<DataBuffer>(cnt_, DataBuffer::kDeBFlagNone);
+    std::shared_ptr<Tensor> sample_ids;
+    RETURN_IF_NOT_OK(CreateSamplerTensor(&sample_ids, samples_per_buffer_));
+    int64_t *id_ptr = reinterpret_cast<int64_t *>(sample_ids->StartAddr());
+    while (cnt_ < samples_per_buffer_) {
+      int64_t next_id = offset_ + num_devices_ * (cnt_++) + device_id_;
+      *(id_ptr++) = shuffle_ ? shuffle_vec_[static_cast<size_t>(next_id)] : next_id;
+    }
+    TensorRow row(1, sample_ids);
+    (*out_buffer)->set_tensor_table(std::make_unique<TensorQTable>(1, row));
+  }
+  return Status::OK();
+}
+
+Status ElasticDistributedSampler::Reset() {
+  CHECK_FAIL_RETURN_UNEXPECTED(cnt_ == samples_per_buffer_, "ERROR Reset() called early/late");
+  epoch_++;
+  offset_ = 0;
+  InitEpoch();
+  return Status::OK();
+}
+
+void ElasticDistributedSampler::GetCursor(int64_t rows_read, int64_t *epoch, int64_t *offset) const {
+  *epoch = epoch_;
+  *offset = std::min(offset_ + rows_read * num_devices_, num_rows_);
+}
+
+Status ElasticDistributedSampler::SaveState(nlohmann::json *state) const {
+  (*state)["seed"] = seed_;
+  return Status::OK();
+}
+
+Status ElasticDistributedSampler::RestoreState(const nlohmann::json &state) {
+  seed_ = state.at("seed").get<uint32_t>();
+  return Status::OK();
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,99 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef DATASET_ENGINE_DATASETOPS_SOURCE_SAMPLER_ELASTIC_DISTRIBUTED_SAMPLER_H_
+#define DATASET_ENGINE_DATASETOPS_SOURCE_SAMPLER_ELASTIC_DISTRIBUTED_SAMPLER_H_
+
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "dataset/engine/datasetops/source/sampler/sampler.h"
+
+namespace mindspore {
+namespace dataset {
+// A distributed sampler whose position can be saved and restored on a different number of devices.
+// The order of the rows of an epoch only depends on (seed, epoch). All the devices together walk through that
+// order from a global offset: device i of n takes the rows at offset + i, offset + i + n, and so on. After every
+// device has read k rows of the epoch, the rows before offset + k * n have been read exactly once, which is the
+// cursor (epoch, offset) to resume from, with any number of devices. The devices differ by at most one row in the
+// last round of an epoch, no row is repeated to even them out.
+class ElasticDistributedSampler : public Sampler {
+ public:
+  // @param num_dev - Number of devices of the job
+  // @param dev_id - Id of this device
+  // @param shuffle - If true the order of the rows is a permutation of (seed, epoch), else the natural order
+  // @param seed - Seed of the permutations, shared by all the devices. Defaults to the seed of the config manager.
+  // @param epoch - Epoch of the cursor to start from
+  // @param offset - Offset of the cursor to start from, the number of rows of the epoch already read by all the
+  //     devices together
+  ElasticDistributedSampler(int64_t num_dev, int64_t dev_id, bool shuffle = true,
+                            uint32_t seed = std::numeric_limits<uint32_t>::max(), int64_t epoch = 0,
+                            int64_t offset = 0);
+
+  // default destructor
+  ~ElasticDistributedSampler() = default;
+
+  // @param std::unique_ptr<DataBuffer> * pBuffer
+  // @param int32_t workerId
+  // @return - The error code return
+  Status GetNextBuffer(std::unique_ptr<DataBuffer> *out_buffer) override;
+
+  // first handshake between StorageOp and Sampler
+  // @param op - StorageOp pointer, pass in so Sampler can call GetNumSamples() and get ClassIds()
+  // @return
+  Status Init(const RandomAccessOp *) override;
+
+  // for next epoch of sampleIds, starting from offset 0
+  // @return - The error code return
+  Status Reset() override;
+
+  // Get the cursor to save once every device has read the same number of rows of the current epoch.
+  // @param rows_read - The number of rows of the current epoch read by each device
+  // @param epoch - Returns the epoch of the cursor
+  // @param offset - Returns the offset of the cursor
+  void GetCursor(int64_t rows_read, int64_t *epoch, int64_t *offset) const;
+
+  // Getter
+  // @return The current epoch
+  int64_t epoch() const { return epoch_; }
+
+  // The seed defaults to the one of the config manager, it is saved so that the permutations are the same
+  // @param state - The json object to write the state into
+  // @return - The error code return
+  Status SaveState(nlohmann::json *state) const override;
+
+  // Restore the seed of the permutations, must be called before Init
+  // @param state - The json object holding the state
+  // @return - The error code return
+  Status RestoreState(const nlohmann::json &state) override;
+
+ private:
+  // Compute the order of the rows of the current epoch, and the number of them this device reads.
+  void InitEpoch();
+
+  int64_t cnt_;  // number of samples that have already been filled in to buffer
+  uint32_t seed_;
+  int64_t device_id_;
+  int64_t num_devices_;
+  bool shuffle_;
+  int64_t epoch_;
+  int64_t offset_;  // offset of the cursor the current epoch started from
+  std::vector<int64_t> shuffle_vec_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // DATASET_ENGINE_DATASETOPS_SOURCE_SAMPLER_ELASTIC_DISTRIBUTED_SAMPLER_H_
@@ -24,6 +24,7 @@ PKSampler::PKSampler(int64_t val, bool shuffle, int64_t samples_per_buffer)
     : Sampler(samples_per_buffer),
       shuffle_(shuffle),
       seed_(GetSeed()),
+      start_seed_(seed_),
       next_id_(0),
       num_pk_samples_(0),
       samples_per_class_(val) {}
@@ -79,5 +80,16 @@ Status PKSampler::Reset() {
   rnd_.seed(seed_++);
   return Status::OK();
 }
+
+Status PKSampler::SaveState(nlohmann::json *state) const {
+  (*state)["seed"] = start_seed_;
+  return Status::OK();
+}
+
+Status PKSampler::RestoreState(const nlohmann::json &state) {
+  start_seed_ = state.at("seed").get<uint32_t>();
+  seed_ = start_seed_;
+  return Status::OK();
+}
 }  // namespace dataset
 }  // namespace mindspore
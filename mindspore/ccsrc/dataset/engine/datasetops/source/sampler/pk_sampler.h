@@ -51,9 +51,20 @@ class PKSampler : public Sampler {  // NOT YET FINISHED
   // @return - The error code return
   Status Reset() override;
 
+  // The seed is increased every epoch, the seed of the first epoch is saved to replay all of them
+  // @param state - The json object to write the state into
+  // @return - The error code return
+  Status SaveState(nlohmann::json *state) const override;
+
+  // Restore the seed of the first epoch, must be called before Init
+  // @param state - The json object holding the state
+  // @return - The error code return
+  Status RestoreState(const nlohmann::json &state) override;
+
  private:
   bool shuffle_;
   uint32_t seed_;
+  uint32_t start_seed_;
   int64_t next_id_;
   int64_t num_pk_samples_;
   int64_t samples_per_class_;
@@ -23,6 +23,7 @@ namespace dataset {
 RandomSampler::RandomSampler(bool replacement, int64_t num_samples, int64_t samples_per_buffer)
     : Sampler(samples_per_buffer),
       seed_(GetSeed()),
+      start_seed_(seed_),
       replacement_(replacement),
       user_num_samples_(num_samples),
       next_id_(0),
@@ -76,5 +77,16 @@ Status RandomSampler::Reset() {
   }
   return Status::OK();
 }
+
+Status RandomSampler::SaveState(nlohmann::json *state) const {
+  (*state)["seed"] = start_seed_;
+  return Status::OK();
+}
+
+Status RandomSampler::RestoreState(const nlohmann::json &state) {
+  start_seed_ = state.at("seed").get<uint32_t>();
+  seed_ = start_seed_;
+  return Status::OK();
+}
 }  // namespace dataset
 }  // namespace mindspore
@@ -51,8 +51,19 @@ class RandomSampler : public Sampler {
   // @return - The error code return
   Status Reset() override;
 
+  // The seed is increased every epoch, the seed of the first epoch is saved to replay all of them
+  // @param state - The json object to write the state into
+  // @return - The error code return
+  Status SaveState(nlohmann::json *state) const override;
+
+  // Restore the seed of the first epoch, must be called before Init
+  // @param state - The json object holding the state
+  // @return - The error code return
+  Status RestoreState(const nlohmann::json &state) override;
+
  private:
   uint32_t seed_;
+  uint32_t start_seed_;
   bool replacement_;
   int64_t user_num_samples_;
   std::vector<int64_t> shuffled_ids_;  // only used for NO REPLACEMENT
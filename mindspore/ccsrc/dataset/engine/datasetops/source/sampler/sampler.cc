@@ -15,10 +15,17 @@
  */
 #include "dataset/engine/datasetops/source/sampler/sampler.h"
 
+#include <memory>
+
 namespace mindspore {
 namespace dataset {
 Sampler::Sampler(int64_t samples_per_buffer)
-    : DatasetOp(0), num_rows_(0), num_samples_(0), samples_per_buffer_(samples_per_buffer), col_desc_(nullptr) {}
+    : DatasetOp(0),
+      num_rows_(0),
+      num_samples_(0),
+      samples_per_buffer_(samples_per_buffer),
+      col_desc_(nullptr),
+      skip_samples_(0) {}
 
 Status Sampler::Init(const RandomAccessOp *op) {
   CHECK_FAIL_RETURN_UNEXPECTED(op != nullptr && samples_per_buffer_ > 0, "Fail to init Sampler()\n");
@@ -29,6 +36,38 @@ Status Sampler::Init(const RandomAccessOp *op) {
   return Status::OK();
 }
 
+Status Sampler::SkipRows(int64_t num_rows) {
+  skip_samples_ += num_rows;
+  return Status::OK();
+}
+
+Status Sampler::GetNextSampleBuffer(std::unique_ptr<DataBuffer> *out_buffer) {
+  RETURN_IF_NOT_OK(GetNextBuffer(out_buffer));
+  while (skip_samples_ > 0 && !(*out_buffer)->eoe() && !(*out_buffer)->eof()) {
+    TensorRow sample_row;
+    RETURN_IF_NOT_OK((*out_buffer)->PopRow(&sample_row));
+    CHECK_FAIL_RETURN_UNEXPECTED(!sample_row.empty(), "Sampler buffer has no sample ids");
+    std::shared_ptr<Tensor> sample_ids = sample_row[0];
+    int64_t num_ids = sample_ids->Size();
+    if (num_ids > skip_samples_) {
+      // Keep the tail of the ids in a new tensor
+      std::shared_ptr<Tensor> kept_ids;
+      RETURN_IF_NOT_OK(CreateSamplerTensor(&kept_ids, num_ids - skip_samples_));
+      auto out_itr = kept_ids->begin<int64_t>();
+      for (auto itr = sample_ids->begin<int64_t>() + skip_samples_; itr != sample_ids->end<int64_t>(); ++itr) {
+        *out_itr = *itr;
+        ++out_itr;
+      }
+      skip_samples_ = 0;
+      (*out_buffer)->set_tensor_table(std::make_unique<TensorQTable>(1, TensorRow(1, kept_ids)));
+      break;
+    }
+    skip_samples_ -= num_ids;
+    RETURN_IF_NOT_OK(GetNextBuffer(out_buffer));
+  }
+  return Status::OK();
+}
+
 Status Sampler::CreateSamplerTensor(std::shared_ptr<Tensor> *sample_ids, int64_t num_elements) {
   if (num_elements == 0) {
     RETURN_STATUS_UNEXPECTED("num of Elements is 0");
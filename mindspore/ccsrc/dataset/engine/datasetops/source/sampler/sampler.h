@@ -82,6 +82,17 @@ class Sampler : public DatasetOp {
   // @return - The error code return
   Status Reset() override = 0;
 
+  // Get the next list of sample ids, leaving out the ids still to be skipped. Leaf operators call this rather than
+  // GetNextBuffer so that skipped rows are never loaded.
+  // @param std::unique_ptr<DataBuffer> out_buffer - Buffer to be returned to the leaf operator
+  // @return - The error code return
+  Status GetNextSampleBuffer(std::unique_ptr<DataBuffer> *out_buffer);
+
+  // Base-class override. The ids of the skipped rows are left out by GetNextSampleBuffer, through the epochs.
+  // @param int64_t num_rows - number of sample ids to skip
+  // @return - The error code return
+  Status SkipRows(int64_t num_rows) override;
+
   // first handshake between StorageOp and Sampler. Base class init will call both GetNumRows and GetNumSamples
   // @param op - StorageOp pointer, pass in so Sampler can call GetNumSamples() and get ClassIds()
   // @return
@@ -114,6 +125,7 @@ class Sampler : public DatasetOp {
   int64_t num_samples_;
   int64_t samples_per_buffer_;
   std::unique_ptr<ColDescriptor> col_desc_;
+  int64_t skip_samples_;
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -107,7 +107,9 @@ TFReaderOp::TFReaderOp(int32_t num_workers, int32_t worker_connector_size, int64
       load_jagged_connector_(true),
       num_rows_(0),
       num_rows_per_shard_(0),
-      equal_rows_per_shard_(equal_rows_per_shard) {
+      equal_rows_per_shard_(equal_rows_per_shard),
+      rows_to_skip_(0),
+      file_shuffles_(0) {
   worker_connector_size_ = worker_connector_size;
 }
 
@@ -128,7 +130,8 @@ Status TFReaderOp::Init() {
   // parallel op base.
   RETURN_IF_NOT_OK(ParallelOp::CreateWorkerConnector(worker_connector_size_));
 
-  jagged_buffer_connector_ = std::make_unique<JaggedConnector>(num_workers_, 1, worker_connector_size_);
+  jagged_buffer_connector_ = std::make_unique<JaggedConnector>(num_workers_, 1, worker_connector_size_,
+                                                               GlobalContext::config_manager()->lock_free_connector());
 
   // temporary: make size large enough to hold all files + EOE to avoid hangs
   int32_t safe_queue_size = static_cast<int32_t>(std::ceil(dataset_files_list_.size() / num_workers_)) + 1;
@@ -199,6 +202,17 @@ Status TFReaderOp::operator()() {
         }
 
         rows_read += fetched_buffer->NumRows();
+        if (rows_to_skip_ > 0) {
+          // drop the rows consumed before a restore, a buffer skipped as a whole is not sent
+          TensorRow skipped_row;
+          while (rows_to_skip_ > 0 && fetched_buffer->NumRows() > 0) {
+            RETURN_IF_NOT_OK(fetched_buffer->PopRow(&skipped_row));
+            rows_to_skip_--;
+          }
+          if (fetched_buffer->NumRows() == 0) {
+            continue;
+          }
+        }
         fetched_buffer->set_id(buffer_id);
         buffer_id++;
         RETURN_IF_NOT_OK(out_connector_->Add(0, std::move(fetched_buffer)));
@@ -452,7 +466,18 @@ Status TFReaderOp::WaitToFillIOBlockQueue() {
     }
 
     if (shuffle_files_) {
-      shuffleKeys(&i_keys, num_devices_ == 1 ? GetSeed() : ++seed);
+      uint32_t file_seed = num_devices_ == 1 ? GetSeed() : ++seed;
+      {
+        // replay the seeds saved before a restore
+        std::unique_lock<std::mutex> lock(file_seeds_mutex_);
+        if (file_shuffles_ < file_seeds_.size()) {
+          file_seed = file_seeds_[file_shuffles_];
+        } else {
+          file_seeds_.push_back(file_seed);
+        }
+        file_shuffles_++;
+      }
+      shuffleKeys(&i_keys, file_seed);
       RETURN_IF_NOT_OK(FillIOBlockShuffle(i_keys));
     } else {  // shuffle_files_ == false
       RETURN_IF_NOT_OK(FillIOBlockNoShuffle());
@@ -462,6 +487,24 @@ Status TFReaderOp::WaitToFillIOBlockQueue() {
   return Status::OK();
 }
 
+Status TFReaderOp::SaveState(nlohmann::json *state) const {
+  std::unique_lock<std::mutex> lock(file_seeds_mutex_);
+  (*state)["file_seeds"] = file_seeds_;
+  return Status::OK();
+}
+
+Status TFReaderOp::RestoreState(const nlohmann::json &state) {
+  std::unique_lock<std::mutex> lock(file_seeds_mutex_);
+  file_seeds_ = state.at("file_seeds").get<std::vector<uint32_t>>();
+  file_shuffles_ = 0;
+  return Status::OK();
+}
+
+Status TFReaderOp::SkipRows(int64_t num_rows) {
+  rows_to_skip_ += num_rows;
+  return Status::OK();
+}
+
 // Notifies the thread which called WaitToFillIOBlockQueue to resume execution.
 void TFReaderOp::NotifyToFillIOBlockQueue() { io_block_queue_wait_post_.Set(); }
 
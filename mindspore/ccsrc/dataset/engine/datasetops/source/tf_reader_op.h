@@ -203,6 +203,22 @@ class TFReaderOp : public ParallelOp {
   // @return Status - the error code returned.
   Status Reset() override;
 
+  // Base-class override. Saves the seeds the files were shuffled with in every epoch so far.
+  // @param state - the json object to write the state into.
+  // @return Status - the error code returned.
+  Status SaveState(nlohmann::json *state) const override;
+
+  // Base-class override. The files of the epochs before the restore are shuffled again with the saved seeds.
+  // @param state - the json object holding the state.
+  // @return Status - the error code returned.
+  Status RestoreState(const nlohmann::json &state) override;
+
+  // Base-class override. The skipped rows are parsed by the workers, to keep the interleaving of the files, and
+  // thrown away by the master thread instead of being sent.
+  // @param num_rows - the number of rows to skip.
+  // @return Status - the error code returned.
+  Status SkipRows(int64_t num_rows) override;
+
   // Getter method
   int64_t rows_per_buffer() const { return rows_per_buffer_; }
 
@@ -379,6 +395,10 @@ class TFReaderOp : public ParallelOp {
   int64_t num_rows_;
   int64_t num_rows_per_shard_;
   bool equal_rows_per_shard_;
+  int64_t rows_to_skip_;                // Rows left to skip, through the epochs
+  std::vector<uint32_t> file_seeds_;    // Seeds of the file shuffles so far, or to replay after a restore
+  size_t file_shuffles_;                // Number of file shuffles done
+  mutable std::mutex file_seeds_mutex_;
 };
 }  // namespace dataset
 }  // namespace mindspore
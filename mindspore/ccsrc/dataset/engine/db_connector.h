@@ -16,6 +16,7 @@
 #ifndef DATASET_ENGINE_DB_CONNECTOR_H_
 #define DATASET_ENGINE_DB_CONNECTOR_H_
 
+#include <atomic>
 #include <memory>
 #include <utility>
 #include "dataset/engine/connector.h"
@@ -34,8 +35,11 @@ class DbConnector : public Connector<std::unique_ptr<DataBuffer>> {
   // @param n_producers The number of threads producing data into this DbConnector.
   // @param n_consumers The number of thread consuming data from this DbConnector.
   // @param queue_capacity The number of element (DataBuffer) for each internal queue.
-  DbConnector(int32_t n_producers, int32_t n_consumers, int32_t queue_capacity)
-      : Connector<std::unique_ptr<DataBuffer>>(n_producers, n_consumers, queue_capacity), end_of_file_(false) {}
+  // @param lock_free Use the lock free ring as the backend of the internal queues.
+  DbConnector(int32_t n_producers, int32_t n_consumers, int32_t queue_capacity, bool lock_free = false)
+      : Connector<std::unique_ptr<DataBuffer>>(n_producers, n_consumers, queue_capacity, lock_free),
+        end_of_file_(false),
+        skip_rows_(0) {}
 
   // Destructor of DbConnector
   ~DbConnector() = default;
@@ -45,6 +49,9 @@ class DbConnector : public Connector<std::unique_ptr<DataBuffer>> {
   // @param worker_id The id of a worker thread calling this method.
   // @param el A rvalue reference to an element to be passed/added/pushed.
   Status Add(int32_t worker_id, std::unique_ptr<DataBuffer> &&el) noexcept {
+    if (profiling_ && el != nullptr) {
+      row_count_.fetch_add(el->NumRows(), std::memory_order_relaxed);
+    }
     return (Connector<std::unique_ptr<DataBuffer>>::Push(worker_id, std::move(el)));
   }
 
@@ -57,39 +64,81 @@ class DbConnector : public Connector<std::unique_ptr<DataBuffer>> {
   // @param result The address of a unique_ptr<DataBuffer> where the popped element will be placed.
   // @param retry_if_eoe A flag to allow the same thread invoke pop() again if the current pop returns eoe buffer.
   Status PopWithRetry(int32_t worker_id, std::unique_ptr<DataBuffer> *result, bool retry_if_eoe = false) noexcept {
+    WaitTimer timer(profiling_ ? &pop_wait_ns_ : nullptr);
     if (result == nullptr) {
       return Status(StatusCode::kUnexpectedError, __LINE__, __FILE__,
                     "[ERROR] nullptr detected when getting data from db connector");
     } else {
-      std::unique_lock<std::mutex> lk(m_);
-      RETURN_IF_NOT_OK(cv_.Wait(&lk, [this, worker_id]() { return expect_consumer_ == worker_id; }));
+      std::unique_lock<std::mutex> lk(m_, std::defer_lock);
+      if (!bypass_turnstile_) {
+        lk.lock();
+        RETURN_IF_NOT_OK(cv_.Wait(&lk, [this, worker_id]() { return expect_consumer_ == worker_id; }));
+      }
       // Once an EOF message is encountered this flag will be set and we can return early.
       if (end_of_file_) {
         *result = std::make_unique<DataBuffer>(0, DataBuffer::kDeBFlagEOF);
       } else {
-        RETURN_IF_NOT_OK(queues_[pop_from_]->PopFront(result));
-        if (*result == nullptr) {
-          return Status(StatusCode::kUnexpectedError, __LINE__, __FILE__,
-                        "[ERROR] nullptr detected when getting data from db connector");
-        }
+        RETURN_IF_NOT_OK(PopSkippingRows(result));
         // Setting the internal flag once the first EOF is encountered.
         if ((*result)->eof()) {
           end_of_file_ = true;
         }
-        pop_from_ = (pop_from_ + 1) % num_producers_;
       }
       // Do not increment expect_consumer_ when result is eoe and retry_if_eoe is set.
       if (!((*result)->eoe() && retry_if_eoe)) {
         expect_consumer_ = (expect_consumer_ + 1) % num_consumers_;
       }
     }
-    cv_.NotifyAll();
+    if (!bypass_turnstile_) {
+      cv_.NotifyAll();
+    }
     return Status::OK();
   }
 
+  // Drop the next rows of the stream instead of handing them to the consumers. Rows are dropped in the order
+  // the consumers take their turns, so the rows kept are the same no matter how many consumers there are.
+  // @note Must be called before the consumers start popping.
+  // @param num_rows The number of rows to drop.
+  void SkipRows(int64_t num_rows) { skip_rows_ += num_rows; }
+
+  // Getter function
+  // @return The total number of rows added so far. Only counted when profiling is enabled.
+  int64_t row_count() const { return row_count_.load(std::memory_order_relaxed); }
+
  private:
+  // Pop the next buffer from the queue in turn, dropping the rows still to be skipped. EOE and EOF buffers are
+  // returned as is, the skipping carries on in the next epoch.
+  // @param result The address of a unique_ptr<DataBuffer> where the popped element will be placed.
+  Status PopSkippingRows(std::unique_ptr<DataBuffer> *result) {
+    while (true) {
+      RETURN_IF_NOT_OK(queues_[pop_from_]->PopFront(result));
+      if (*result == nullptr) {
+        return Status(StatusCode::kUnexpectedError, __LINE__, __FILE__,
+                      "[ERROR] nullptr detected when getting data from db connector");
+      }
+      pop_from_ = (pop_from_ + 1) % num_producers_;
+      if (skip_rows_ == 0 || (*result)->eoe() || (*result)->eof()) {
+        return Status::OK();
+      }
+      int64_t num_rows = (*result)->NumRows();
+      if (num_rows > skip_rows_) {
+        TensorRow row;
+        for (; skip_rows_ > 0; --skip_rows_) {
+          RETURN_IF_NOT_OK((*result)->PopRow(&row));
+        }
+        return Status::OK();
+      }
+      skip_rows_ -= num_rows;
+    }
+  }
+
   // A flag to indicate the end of stream has been encountered.
   bool end_of_file_;
+
+  // The number of rows left to drop, only touched by the consumer holding the turn
+  int64_t skip_rows_;
+
+  std::atomic<int64_t> row_count_{0};
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -15,9 +15,15 @@
  */
 #include "dataset/engine/execution_tree.h"
 #include <iostream>
+#include <memory>
 #include <string>
+#include <vector>
+#include "dataset/core/config_manager.h"
+#include "dataset/core/global_context.h"
+#include "dataset/engine/auto_tune.h"
 #include "dataset/engine/datasetops/dataset_op.h"
 #include "dataset/engine/datasetops/shuffle_op.h"
+#include "dataset/engine/pipeline_profiler.h"
 #include "dataset/util/task_manager.h"
 
 namespace mindspore {
@@ -100,6 +106,11 @@ Status ExecutionTree::Launch() {
       " Expected state: " + std::to_string(static_cast<int>(kDeTStateReady));
     RETURN_STATUS_UNEXPECTED(err_msg);
   }
+  // The profiler turns on the statistics of every op, so it must be set up before the ops start running.
+  if (!GlobalContext::config_manager()->profiling_dir().empty()) {
+    profiler_ = std::make_unique<PipelineProfiler>(this);
+    RETURN_IF_NOT_OK(profiler_->Init());
+  }
   for (auto itr = this->begin(); itr != this->end(); ++itr) {
     // An inlined operator is one that has an output connector size of 0, and it does not
     // require a thread to execute.  Instead, the work of this operator is executed inlined
@@ -111,6 +122,14 @@ Status ExecutionTree::Launch() {
       // Set the state of the Operator as running. This only matters in Leaf ops, CacheOp and TakeOp
     }
   }
+  // The auto tuner runs as one more task of the tree and is stopped together with the operators.
+  if (GlobalContext::config_manager()->auto_tune()) {
+    auto_tune_ = std::make_unique<AutoTune>(this);
+    RETURN_IF_NOT_OK(tg_->CreateAsyncTask("AutoTune", std::ref(*auto_tune_)));
+  }
+  if (profiler_ != nullptr) {
+    RETURN_IF_NOT_OK(tg_->CreateAsyncTask("PipelineProfiler", std::ref(*profiler_)));
+  }
   tree_state_ = kDeTStateExecuting;
   return Status::OK();
 }
@@ -189,6 +208,54 @@ Status ExecutionTree::PrepareNode(const std::shared_ptr<DatasetOp> &dataset_op)
   return Status::OK();
 }
 
+// Save the state of the operators and the position of the root
+Status ExecutionTree::SaveState(int64_t num_rows, nlohmann::json *state) const {
+  CHECK_FAIL_RETURN_UNEXPECTED(root_ != nullptr, "Cannot save the state of a tree without root.");
+  CHECK_FAIL_RETURN_UNEXPECTED(num_rows >= 0, "Number of rows to save must not be negative.");
+  nlohmann::json op_states;
+  for (auto itr = this->begin(); itr != this->end(); ++itr) {
+    nlohmann::json op_state = nlohmann::json::object();
+    RETURN_IF_NOT_OK(itr->SaveState(&op_state));
+    op_states[std::to_string(itr->id())] = op_state;
+  }
+  *state = {{"num_rows", num_rows}, {"ops", op_states}};
+  return Status::OK();
+}
+
+// Restore the state of the operators and skip the rows consumed before the state was saved
+Status ExecutionTree::RestoreState(const nlohmann::json &state) {
+  if (tree_state_ != kDeTStateReady) {
+    std::string err_msg =
+      "Invalid tree state for restoring the tree. Current state: " + std::to_string(static_cast<int>(tree_state_)) +
+      " Expected state: " + std::to_string(static_cast<int>(kDeTStateReady));
+    RETURN_STATUS_UNEXPECTED(err_msg);
+  }
+  try {
+    const nlohmann::json &op_states = state.at("ops");
+    int64_t num_rows = state.at("num_rows");
+    std::vector<std::shared_ptr<DatasetOp>> ops;
+    for (auto itr = this->begin(); itr != this->end(); ++itr) {
+      ops.push_back(itr.get());
+    }
+    if (op_states.size() != ops.size()) {
+      RETURN_STATUS_UNEXPECTED("The saved state has " + std::to_string(op_states.size()) + " operators, the tree has " +
+                               std::to_string(ops.size()) + ".");
+    }
+    for (auto &op : ops) {
+      std::string key = std::to_string(op->id());
+      CHECK_FAIL_RETURN_UNEXPECTED(op_states.count(key) > 0, "No saved state for operator " + key + ".");
+      RETURN_IF_NOT_OK(op->RestoreState(op_states[key]));
+    }
+    if (num_rows > 0) {
+      RETURN_IF_NOT_OK(root_->SkipRows(num_rows));
+    }
+    MS_LOG(INFO) << "Pipeline state restored, skipping " << num_rows << " rows.";
+  } catch (const nlohmann::json::exception &e) {
+    RETURN_STATUS_UNEXPECTED("Invalid pipeline state: " + std::string(e.what()));
+  }
+  return Status::OK();
+}
+
 // Adds an operator to the repeat stack during prepare phase.
 void ExecutionTree::AddToRepeatStack(std::shared_ptr<DatasetOp> dataset_op) { repeat_stack_.push(dataset_op); }
 
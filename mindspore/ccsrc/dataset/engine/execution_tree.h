@@ -28,6 +28,8 @@ namespace dataset {
 // Forward declares
 class TaskGroup;
 class DatasetOp;
+class AutoTune;
+class PipelineProfiler;
 
 class ExecutionTree {
  public:
@@ -173,6 +175,20 @@ class ExecutionTree {
   // @return shared_ptr to the popped operator
   std::shared_ptr<DatasetOp> PopFromRepeatStack();
 
+  // Save the state needed to resume the pipeline after a restart: the state of every operator, such as the
+  // seeds of the samplers and shuffles, and the number of rows taken from the root so far.
+  // @param num_rows - The number of rows consumed from the root so far
+  // @param state - The json object to write the state into
+  // @return Status - The error code return
+  Status SaveState(int64_t num_rows, nlohmann::json *state) const;
+
+  // Restore a state saved by SaveState from the same pipeline. Must be called after Prepare and before Launch.
+  // The operators replay their output and the rows already consumed are skipped, as far down the tree as
+  // possible, so that the first row the root sends is the one following them.
+  // @param state - The json object holding the state
+  // @return Status - The error code return
+  Status RestoreState(const nlohmann::json &state);
+
   // Return the pointer to the TaskGroup
   // @return raw pointer to the TaskGroup
   TaskGroup *AllTasks() const { return tg_.get(); }
@@ -184,6 +200,8 @@ class ExecutionTree {
   uint32_t prepare_flags_;                               // Flags used during tree prepare
   TreeState tree_state_;                                 // Tracking the current tree state
   std::stack<std::shared_ptr<DatasetOp>> repeat_stack_;  // A stack used during prepare phase
+  std::unique_ptr<AutoTune> auto_tune_;                  // Runtime tuner, only created if auto tune is on
+  std::unique_ptr<PipelineProfiler> profiler_;           // Only created if a profiling directory is set
 };
 }  // namespace dataset
 }  // namespace mindspore
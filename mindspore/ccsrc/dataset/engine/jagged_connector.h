@@ -29,8 +29,8 @@ namespace mindspore {
 namespace dataset {
 class JaggedConnector : public Connector<std::unique_ptr<DataBuffer>> {
  public:
-  JaggedConnector(int32_t num_producers, int32_t num_consumers, int32_t queue_capacity)
-      : Connector<std::unique_ptr<DataBuffer>>(num_producers, num_consumers, queue_capacity) {
+  JaggedConnector(int32_t num_producers, int32_t num_consumers, int32_t queue_capacity, bool lock_free = false)
+      : Connector<std::unique_ptr<DataBuffer>>(num_producers, num_consumers, queue_capacity, lock_free) {
     for (int i = 0; i < num_producers; i++) {
       is_queue_finished_.push_back(false);
     }
@@ -43,10 +43,14 @@ class JaggedConnector : public Connector<std::unique_ptr<DataBuffer>> {
   }
 
   Status Pop(int32_t worker_id, std::unique_ptr<DataBuffer> *result) noexcept override {
+    WaitTimer timer(profiling_ ? &pop_wait_ns_ : nullptr);
     {
       DS_ASSERT(worker_id < num_consumers_);
-      std::unique_lock<std::mutex> lock(m_);
-      RETURN_IF_NOT_OK(cv_.Wait(&lock, [this, worker_id]() { return expect_consumer_ == worker_id; }));
+      std::unique_lock<std::mutex> lock(m_, std::defer_lock);
+      if (!bypass_turnstile_) {
+        lock.lock();
+        RETURN_IF_NOT_OK(cv_.Wait(&lock, [this, worker_id]() { return expect_consumer_ == worker_id; }));
+      }
       if (is_queue_finished_[pop_from_]) {
         std::string errMsg = "ERROR: popping from a finished queue in JaggedConnector";
         RETURN_STATUS_UNEXPECTED(errMsg);
@@ -68,7 +72,9 @@ class JaggedConnector : public Connector<std::unique_ptr<DataBuffer>> {
       expect_consumer_ = (expect_consumer_ + 1) % num_consumers_;
     }
 
-    cv_.NotifyAll();
+    if (!bypass_turnstile_) {
+      cv_.NotifyAll();
+    }
     return Status::OK();
   }
 
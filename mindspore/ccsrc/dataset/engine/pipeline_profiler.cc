@@ -0,0 +1,268 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "dataset/engine/pipeline_profiler.h"
+#include <cxxabi.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <sstream>
+#include <thread>
+#include <typeinfo>
+#include "dataset/core/config_manager.h"
+#include "dataset/core/global_context.h"
+#include "dataset/engine/datasetops/dataset_op.h"
+#include "dataset/engine/datasetops/map_op.h"
+#include "dataset/engine/datasetops/parallel_op.h"
+#include "dataset/engine/execution_tree.h"
+#include "dataset/util/path.h"
+#include "dataset/util/task_manager.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace dataset {
+namespace {
+constexpr double kNsPerMs = 1000000.0;
+
+// Used to tell apart the files of several trees in the same process
+std::atomic<int32_t> g_tree_seq{0};
+
+// @return The class name of the op followed by its id, e.g. MapOp(2)
+std::string OpName(const DatasetOp *op) {
+  const char *mangled = typeid(*op).name();
+  int status = -1;
+  std::unique_ptr<char, void (*)(void *)> res{abi::__cxa_demangle(mangled, nullptr, nullptr, &status), std::free};
+  std::string name = (status == 0) ? std::string(res.get()) : std::string(mangled);
+  auto pos = name.rfind("::");
+  if (pos != std::string::npos) {
+    name = name.substr(pos + 2);
+  }
+  return name + "(" + std::to_string(op->id()) + ")";
+}
+
+// @return The first word of the debug print of the TensorOp, e.g. ResizeOp
+std::string TensorOpName(const TensorOp &tfunc) {
+  std::ostringstream ss;
+  tfunc.Print(ss);
+  std::string name = ss.str();
+  auto pos = name.find_first_of(": \n");
+  return (pos == std::string::npos) ? name : name.substr(0, pos);
+}
+}  // namespace
+
+PipelineProfiler::PipelineProfiler(ExecutionTree *tree)
+    : tree_(tree), interval_ms_(0), pid_(static_cast<int32_t>(getpid())), first_event_(true) {}
+
+Status PipelineProfiler::Init() {
+  std::shared_ptr<ConfigManager> cfg = GlobalContext::config_manager();
+  interval_ms_ = std::max(cfg->profiling_interval(), 1u);
+  Path dir(cfg->profiling_dir());
+  if (!dir.Exists()) {
+    RETURN_IF_NOT_OK(dir.CreateDirectories());
+  }
+  std::string suffix = std::to_string(pid_) + "_" + std::to_string(g_tree_seq.fetch_add(1)) + ".json";
+  trace_file_ = (dir / ("pipeline_trace_" + suffix)).toString();
+  summary_file_ = (dir / ("pipeline_summary_" + suffix)).toString();
+  trace_.open(trace_file_, std::ios::out | std::ios::trunc);
+  if (!trace_.is_open()) {
+    RETURN_STATUS_UNEXPECTED("Failed to open the profiling trace file " + trace_file_);
+  }
+
+  for (auto itr = tree_->begin(); itr != tree_->end(); ++itr) {
+    DatasetOp *op = itr.get().get();
+    op->EnableProfiling();
+    OpCounters counters{};
+    counters.op = op;
+    counters.name = OpName(op);
+    auto parallel_op = dynamic_cast<ParallelOp *>(op);
+    if (parallel_op != nullptr) {
+      counters.worker_busy_ns.resize(parallel_op->num_workers(), 0);
+    }
+    auto map_op = dynamic_cast<MapOp *>(op);
+    if (map_op != nullptr) {
+      for (const auto &tfunc : map_op->tfuncs()) {
+        counters.tfunc_names.push_back(TensorOpName(*tfunc));
+      }
+      counters.tfunc_ns.resize(map_op->tfuncs().size(), 0);
+    }
+    ops_.push_back(std::move(counters));
+  }
+
+  start_ = std::chrono::steady_clock::now();
+  last_sample_ = start_;
+  trace_ << "[\n";
+  WriteEvent({{"name", "process_name"}, {"ph", "M"}, {"pid", pid_}, {"args", {{"name", "MindData pipeline"}}}});
+  MS_LOG(INFO) << "Pipeline profiling is on. Trace file: " << trace_file_ << ".";
+  return Status::OK();
+}
+
+Status PipelineProfiler::operator()() {
+  TaskManager::FindMe()->Post();
+  while (!this_thread::is_interrupted()) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(interval_ms_));
+    Sample();
+  }
+  return Finish();
+}
+
+double PipelineProfiler::NowUs() const {
+  return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start_).count();
+}
+
+void PipelineProfiler::WriteEvent(const nlohmann::json &event) {
+  if (!first_event_) {
+    trace_ << ",\n";
+  }
+  trace_ << event.dump();
+  first_event_ = false;
+}
+
+void PipelineProfiler::Sample() {
+  auto now = std::chrono::steady_clock::now();
+  double elapsed_ns = std::chrono::duration<double, std::nano>(now - last_sample_).count();
+  if (elapsed_ns <= 0) {
+    return;
+  }
+  double ts = NowUs();
+  for (auto &c : ops_) {
+    const DbConnector *conn = c.op->out_connector_.get();
+    if (conn != nullptr) {
+      int64_t rows = conn->row_count();
+      int64_t buffers = conn->push_count();
+      int64_t push_wait_ns = conn->push_wait_ns();
+      int64_t pop_wait_ns = conn->pop_wait_ns();
+      int32_t size = conn->size();
+      WriteEvent({{"name", c.name + " throughput"},
+                  {"ph", "C"},
+                  {"ts", ts},
+                  {"pid", pid_},
+                  {"args",
+                   {{"rows/sec", (rows - c.rows) * 1e9 / elapsed_ns},
+                    {"buffers/sec", (buffers - c.buffers) * 1e9 / elapsed_ns}}}});
+      WriteEvent({{"name", c.name + " connector"},
+                  {"ph", "C"},
+                  {"ts", ts},
+                  {"pid", pid_},
+                  {"args", {{"size", size}, {"capacity", conn->capacity()}}}});
+      // Summed over all the producer/consumer threads, so this is the average number of threads blocked.
+      WriteEvent({{"name", c.name + " blocked threads"},
+                  {"ph", "C"},
+                  {"ts", ts},
+                  {"pid", pid_},
+                  {"args",
+                   {{"push", (push_wait_ns - c.push_wait_ns) / elapsed_ns},
+                    {"pop", (pop_wait_ns - c.pop_wait_ns) / elapsed_ns}}}});
+      c.rows = rows;
+      c.buffers = buffers;
+      c.push_wait_ns = push_wait_ns;
+      c.pop_wait_ns = pop_wait_ns;
+      c.size_sum += size;
+      c.num_samples++;
+    }
+
+    auto parallel_op = dynamic_cast<const ParallelOp *>(c.op);
+    if (parallel_op != nullptr) {
+      nlohmann::json busy;
+      for (size_t i = 0; i < c.worker_busy_ns.size(); i++) {
+        int64_t ns = parallel_op->worker_busy_ns(static_cast<int32_t>(i));
+        busy["worker " + std::to_string(i)] = 100.0 * (ns - c.worker_busy_ns[i]) / elapsed_ns;
+        c.worker_busy_ns[i] = ns;
+      }
+      if (!busy.empty()) {
+        WriteEvent({{"name", c.name + " worker busy %"}, {"ph", "C"}, {"ts", ts}, {"pid", pid_}, {"args", busy}});
+      }
+    }
+
+    auto map_op = dynamic_cast<const MapOp *>(c.op);
+    if (map_op != nullptr && !c.tfunc_ns.empty()) {
+      nlohmann::json compute;
+      for (size_t i = 0; i < c.tfunc_ns.size(); i++) {
+        int64_t ns = map_op->tfunc_compute_ns(i);
+        compute[std::to_string(i) + " " + c.tfunc_names[i]] = (ns - c.tfunc_ns[i]) / kNsPerMs;
+        c.tfunc_ns[i] = ns;
+      }
+      WriteEvent({{"name", c.name + " TensorOp compute ms"}, {"ph", "C"}, {"ts", ts}, {"pid", pid_}, {"args", compute}});
+    }
+  }
+  // Flush so that the trace is usable while the job is still running
+  trace_.flush();
+  last_sample_ = now;
+}
+
+Status PipelineProfiler::Finish() {
+  Sample();
+  trace_ << "\n]\n";
+  trace_.close();
+
+  double elapsed_ms = std::chrono::duration<double, std::milli>(last_sample_ - start_).count();
+  nlohmann::json summary;
+  summary["elapsed_ms"] = elapsed_ms;
+  summary["interval_ms"] = interval_ms_;
+  summary["trace_file"] = trace_file_;
+  nlohmann::json ops = nlohmann::json::array();
+  for (const auto &c : ops_) {
+    nlohmann::json op;
+    op["name"] = c.name;
+    op["id"] = c.op->id();
+    op["num_workers"] = c.op->num_workers();
+    if (c.op->out_connector_ != nullptr) {
+      double seconds = elapsed_ms / 1000.0;
+      op["rows"] = c.rows;
+      op["buffers"] = c.buffers;
+      op["rows_per_sec"] = (seconds > 0) ? c.rows / seconds : 0.0;
+      op["buffers_per_sec"] = (seconds > 0) ? c.buffers / seconds : 0.0;
+      op["connector_capacity"] = c.op->out_connector_->capacity();
+      op["connector_avg_size"] = (c.num_samples > 0) ? c.size_sum / c.num_samples : 0.0;
+      op["push_wait_ms"] = c.push_wait_ns / kNsPerMs;
+      op["pop_wait_ms"] = c.pop_wait_ns / kNsPerMs;
+    }
+    int64_t busy_total = 0;
+    nlohmann::json workers = nlohmann::json::array();
+    for (auto ns : c.worker_busy_ns) {
+      busy_total += ns;
+      workers.push_back({{"busy_ms", ns / kNsPerMs}, {"idle_ms", std::max(0.0, elapsed_ms - ns / kNsPerMs)}});
+    }
+    if (busy_total > 0) {
+      op["workers"] = workers;
+    }
+    if (!c.tfunc_ns.empty()) {
+      nlohmann::json tfuncs = nlohmann::json::array();
+      for (size_t i = 0; i < c.tfunc_ns.size(); i++) {
+        tfuncs.push_back({{"name", c.tfunc_names[i]}, {"compute_ms", c.tfunc_ns[i] / kNsPerMs}});
+      }
+      op["tensor_ops"] = tfuncs;
+    }
+    auto map_op = dynamic_cast<const MapOp *>(c.op);
+    if (map_op != nullptr) {
+      op["fused_tensor_ops"] = map_op->num_fused_ops();
+      op["allocations_avoided_per_row"] = map_op->allocations_avoided_per_row();
+    }
+    MS_LOG(INFO) << "Pipeline profiling: " << op.dump() << ".";
+    ops.push_back(op);
+  }
+  summary["ops"] = ops;
+
+  std::ofstream out(summary_file_, std::ios::out | std::ios::trunc);
+  if (!out.is_open()) {
+    RETURN_STATUS_UNEXPECTED("Failed to open the profiling summary file " + summary_file_);
+  }
+  out << summary.dump(2) << std::endl;
+  out.close();
+  MS_LOG(INFO) << "Pipeline profiling summary is written to " << summary_file_ << ".";
+  return Status::OK();
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,112 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef DATASET_ENGINE_PIPELINE_PROFILER_H_
+#define DATASET_ENGINE_PIPELINE_PROFILER_H_
+
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+// Forward declares
+class ExecutionTree;
+class DatasetOp;
+
+// PipelineProfiler runs as one more task of the ExecutionTree when a profiling directory is configured. It turns on
+// the runtime statistics of every op before the ops are launched, then samples them at a fixed interval:
+//   - rows/sec and buffers/sec pushed into the output connector of each op,
+//   - time producers spent blocked in Push() and consumers spent blocked in Pop() of that connector,
+//   - busy time of each worker of a MapOp/BatchOp (the rest of the wall time is idle),
+//   - compute time of each TensorOp of a MapOp.
+// Every sample is appended to a Chrome trace (chrome://tracing, JSON array format) as counter events, so the file
+// can be loaded even if the job dies. When the tree is stopped a JSON summary with the totals is written as well.
+// The collection itself is a few relaxed atomic adds and clock reads per buffer/row.
+class PipelineProfiler {
+ public:
+  // Constructor
+  // @param tree - The tree to profile. Must be prepared.
+  explicit PipelineProfiler(ExecutionTree *tree);
+
+  // Destructor
+  ~PipelineProfiler() = default;
+
+  // Turn on the statistics of every op and open the trace file. Must be called before the ops are launched.
+  // @return Status - The error code return
+  Status Init();
+
+  // Main loop of the profiler, launched as a task of the tree. Samples until the tree is stopped, then writes the
+  // summary.
+  // @return Status - The error code return
+  Status operator()();
+
+  // Getter
+  // @return The path of the Chrome trace file
+  const std::string &trace_file() const { return trace_file_; }
+
+  // Getter
+  // @return The path of the summary file
+  const std::string &summary_file() const { return summary_file_; }
+
+ private:
+  // Counter values of one operator at the last sample
+  struct OpCounters {
+    DatasetOp *op;
+    std::string name;
+    int64_t rows;
+    int64_t buffers;
+    int64_t push_wait_ns;
+    int64_t pop_wait_ns;
+    std::vector<int64_t> worker_busy_ns;
+    std::vector<std::string> tfunc_names;
+    std::vector<int64_t> tfunc_ns;
+    double size_sum;  // Sum of the connector size over all samples
+    int64_t num_samples;
+  };
+
+  // Take one sample of every op and append it to the trace
+  void Sample();
+
+  // Close the trace and write the summary
+  // @return Status - The error code return
+  Status Finish();
+
+  // Append one event to the trace
+  // @param event - The Chrome trace event
+  void WriteEvent(const nlohmann::json &event);
+
+  // @return The time since Init() in microseconds, the time unit of the Chrome trace
+  double NowUs() const;
+
+  ExecutionTree *tree_;
+  std::vector<OpCounters> ops_;
+  uint32_t interval_ms_;
+  int32_t pid_;
+  std::string trace_file_;
+  std::string summary_file_;
+  std::ofstream trace_;
+  bool first_event_;
+  std::chrono::steady_clock::time_point start_;
+  std::chrono::steady_clock::time_point last_sample_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // DATASET_ENGINE_PIPELINE_PROFILER_H_
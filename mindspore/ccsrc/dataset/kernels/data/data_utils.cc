@@ -15,64 +15,37 @@
  */
 
 #include "dataset/kernels/data/data_utils.h"
+#include <algorithm>
 #include <vector>
 #include "dataset/core/constants.h"
 #include "dataset/core/tensor.h"
 #include "dataset/core/tensor_shape.h"
 #include "dataset/core/data_type.h"
 #include "dataset/core/pybind_support.h"
+#include "dataset/kernels/simd_kernels.h"
 
 namespace mindspore {
 namespace dataset {
-Status OneHotEncodingUnsigned(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output,
-                              dsize_t num_classes, int64_t index) {
-  uint64_t class_idx;
-  if (input->Rank() == 0) {
-    RETURN_IF_NOT_OK(input->GetItemAt<uint64_t>(&class_idx, {}));
-  } else {
-    RETURN_IF_NOT_OK(input->GetItemAt<uint64_t>(&class_idx, {index}));
-  }
-  if (class_idx >= static_cast<uint64_t>(num_classes)) {
-    RETURN_STATUS_UNEXPECTED("One_hot index values are not in range");
-  }
-  if (input->type() == DataType::DE_UINT64) {
-    RETURN_IF_NOT_OK((*output)->SetItemAt<uint64_t>({index, static_cast<dsize_t>(class_idx)}, 1));
-  } else if (input->type() == DataType::DE_UINT32) {
-    RETURN_IF_NOT_OK((*output)->SetItemAt<uint32_t>({index, static_cast<dsize_t>(class_idx)}, 1));
-  } else if (input->type() == DataType::DE_UINT16) {
-    RETURN_IF_NOT_OK((*output)->SetItemAt<uint16_t>({index, static_cast<dsize_t>(class_idx)}, 1));
-  } else if (input->type() == DataType::DE_UINT8) {
-    RETURN_IF_NOT_OK((*output)->SetItemAt<uint8_t>({index, static_cast<dsize_t>(class_idx)}, 1));
-  } else {
-    RETURN_STATUS_UNEXPECTED("One hot unsigned only supports unsigned int as input.");
-  }
-  return Status::OK();
-}
-
-Status OneHotEncodingSigned(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, dsize_t num_classes,
-                            int64_t index) {
-  int64_t class_idx;
-  if (input->Rank() == 0) {
-    RETURN_IF_NOT_OK(input->GetItemAt<int64_t>(&class_idx, {}));
-  } else {
-    RETURN_IF_NOT_OK(input->GetItemAt<int64_t>(&class_idx, {index}));
-  }
-  if (class_idx >= static_cast<int64_t>(num_classes)) {
-    RETURN_STATUS_UNEXPECTED("One_hot index values are not in range");
-  }
-  if (input->type() == DataType::DE_INT64) {
-    RETURN_IF_NOT_OK((*output)->SetItemAt<int64_t>({index, static_cast<dsize_t>(class_idx)}, 1));
-  } else if (input->type() == DataType::DE_INT32) {
-    RETURN_IF_NOT_OK((*output)->SetItemAt<int32_t>({index, static_cast<dsize_t>(class_idx)}, 1));
-  } else if (input->type() == DataType::DE_INT16) {
-    RETURN_IF_NOT_OK((*output)->SetItemAt<int16_t>({index, static_cast<dsize_t>(class_idx)}, 1));
-  } else if (input->type() == DataType::DE_INT8) {
-    RETURN_IF_NOT_OK((*output)->SetItemAt<int8_t>({index, static_cast<dsize_t>(class_idx)}, 1));
-  } else {
-    RETURN_STATUS_UNEXPECTED("One hot signed only supports signed int as input.");
+namespace {
+// Writes the one hot encoding of the labels, num_classes values per label
+template <typename T>
+Status OneHotEncode(const std::shared_ptr<Tensor> &input, const std::shared_ptr<Tensor> &output, dsize_t num_classes) {
+  auto labels = reinterpret_cast<const T *>(input->StartAddr());
+  auto one_hot = reinterpret_cast<T *>(output->StartAddr());
+  RETURN_UNEXPECTED_IF_NULL(labels);
+  RETURN_UNEXPECTED_IF_NULL(one_hot);
+  dsize_t num_labels = input->Size();
+  (void)std::fill(one_hot, one_hot + num_labels * num_classes, static_cast<T>(0));
+  for (dsize_t i = 0; i < num_labels; ++i) {
+    auto class_idx = static_cast<int64_t>(labels[i]);
+    if (class_idx < 0 || class_idx >= num_classes) {
+      RETURN_STATUS_UNEXPECTED("One_hot index values are not in range");
+    }
+    one_hot[i * num_classes + class_idx] = 1;
   }
   return Status::OK();
 }
+}  // namespace
 
 Status OneHotEncoding(std::shared_ptr<Tensor> input, std::shared_ptr<Tensor> *output, dsize_t num_classes) {
   input->Squeeze();
@@ -82,26 +55,50 @@ Status OneHotEncoding(std::shared_ptr<Tensor> input, std::shared_ptr<Tensor> *ou
   if (!input->type().IsInt()) {
     RETURN_STATUS_UNEXPECTED("One hot does not support input of this type.");
   }
-  try {
-    dsize_t num_elements = 1;
-    if (input->Rank() == 1) num_elements = input->shape()[0];
-    TensorShape out_shape({num_elements, num_classes});
-    std::shared_ptr<Tensor> out;
-    RETURN_IF_NOT_OK(Tensor::CreateTensor(&out, TensorImpl::kFlexible, out_shape, input->type()));
-    RETURN_IF_NOT_OK(out->Zero());
-    for (dsize_t i = 0; i < num_elements; ++i) {
-      if (input->type().IsUnsignedInt()) {
-        RETURN_IF_NOT_OK(OneHotEncodingUnsigned(input, &out, num_classes, i));
-      } else {
-        RETURN_IF_NOT_OK(OneHotEncodingSigned(input, &out, num_classes, i));
-      }
-    }
-    out->Squeeze();
-    *output = out;
-    return Status::OK();
-  } catch (const std::exception &e) {
-    RETURN_STATUS_UNEXPECTED("Unexpected error in OneHotOp");
+  dsize_t num_elements = 1;
+  if (input->Rank() == 1) num_elements = input->shape()[0];
+  TensorShape out_shape({num_elements, num_classes});
+  std::shared_ptr<Tensor> out;
+  RETURN_IF_NOT_OK(Tensor::CreateTensor(&out, TensorImpl::kFlexible, out_shape, input->type()));
+  switch (input->type().value()) {
+    case DataType::DE_INT8:
+      RETURN_IF_NOT_OK(OneHotEncode<int8_t>(input, out, num_classes));
+      break;
+    case DataType::DE_UINT8:
+      RETURN_IF_NOT_OK(OneHotEncode<uint8_t>(input, out, num_classes));
+      break;
+    case DataType::DE_INT16:
+      RETURN_IF_NOT_OK(OneHotEncode<int16_t>(input, out, num_classes));
+      break;
+    case DataType::DE_UINT16:
+      RETURN_IF_NOT_OK(OneHotEncode<uint16_t>(input, out, num_classes));
+      break;
+    case DataType::DE_INT32:
+      RETURN_IF_NOT_OK(OneHotEncode<int32_t>(input, out, num_classes));
+      break;
+    case DataType::DE_UINT32:
+      RETURN_IF_NOT_OK(OneHotEncode<uint32_t>(input, out, num_classes));
+      break;
+    case DataType::DE_INT64:
+      RETURN_IF_NOT_OK(OneHotEncode<int64_t>(input, out, num_classes));
+      break;
+    case DataType::DE_UINT64:
+      RETURN_IF_NOT_OK(OneHotEncode<uint64_t>(input, out, num_classes));
+      break;
+    default:
+      RETURN_STATUS_UNEXPECTED("One hot does not support input of this type.");
   }
+  out->Squeeze();
+  *output = out;
+  return Status::OK();
+}
+
+Status OneHotEncoding(const TensorRow &input, TensorRow *output, dsize_t num_classes) {
+  output->resize(input.size());
+  for (size_t i = 0; i < input.size(); ++i) {
+    RETURN_IF_NOT_OK(OneHotEncoding(input[i], &(*output)[i], num_classes));
+  }
+  return Status::OK();
 }
 
 template <typename FROM, typename TO>
@@ -113,96 +110,112 @@ void Cast(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output)
     *out_itr = static_cast<TO>(*in_itr);
 }
 
+namespace {
+using CastFunc = void (*)(const std::shared_ptr<Tensor> &, std::shared_ptr<Tensor> *);
+
+// The vector conversion rounds like Eigen::half
+void CastFloatToHalf(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) {
+  FloatToHalf(reinterpret_cast<const float *>(input->StartAddr()), reinterpret_cast<uint16_t *>((*output)->StartAddr()),
+              input->Size());
+}
+
 template <typename T>
-void CastFrom(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) {
-  switch ((*output)->type().value()) {
+CastFunc GetCastFrom(const DataType &data_type) {
+  switch (data_type.value()) {
     case DataType::DE_BOOL:
-      Cast<T, bool>(input, output);
-      break;
+      return &Cast<T, bool>;
     case DataType::DE_INT8:
-      Cast<T, int8_t>(input, output);
-      break;
+      return &Cast<T, int8_t>;
     case DataType::DE_UINT8:
-      Cast<T, uint8_t>(input, output);
-      break;
+      return &Cast<T, uint8_t>;
     case DataType::DE_INT16:
-      Cast<T, int16_t>(input, output);
-      break;
+      return &Cast<T, int16_t>;
     case DataType::DE_UINT16:
-      Cast<T, uint16_t>(input, output);
-      break;
+      return &Cast<T, uint16_t>;
     case DataType::DE_INT32:
-      Cast<T, int32_t>(input, output);
-      break;
+      return &Cast<T, int32_t>;
     case DataType::DE_UINT32:
-      Cast<T, uint32_t>(input, output);
-      break;
+      return &Cast<T, uint32_t>;
     case DataType::DE_INT64:
-      Cast<T, int64_t>(input, output);
-      break;
+      return &Cast<T, int64_t>;
     case DataType::DE_UINT64:
-      Cast<T, uint64_t>(input, output);
-      break;
+      return &Cast<T, uint64_t>;
     case DataType::DE_FLOAT16:
-      Cast<T, float16>(input, output);
-      break;
+      return &Cast<T, float16>;
     case DataType::DE_FLOAT32:
-      Cast<T, float>(input, output);
-      break;
+      return &Cast<T, float>;
     case DataType::DE_FLOAT64:
-      Cast<T, double>(input, output);
-      break;
-    case DataType::DE_UNKNOWN:
-      MS_LOG(ERROR) << "Unknown data type.";
-      break;
+      return &Cast<T, double>;
+    default:
+      return nullptr;
   }
 }
 
-// Type cast operator
-Status TypeCast(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, const DataType &data_type) {
-  RETURN_IF_NOT_OK(Tensor::CreateTensor(output, TensorImpl::kFlexible, input->shape(), data_type));
-
-  static_cast<void>((*output)->StartAddr());
-  switch (input->type().value()) {
+// Returns the function casting a Tensor of type from to a Tensor of type to, null if the types are not supported
+CastFunc GetCastFunc(const DataType &from, const DataType &to) {
+  if (from == DataType::DE_FLOAT32 && to == DataType::DE_FLOAT16) {
+    return &CastFloatToHalf;
+  }
+  switch (from.value()) {
     case DataType::DE_BOOL:
-      CastFrom<bool>(input, output);
-      break;
+      return GetCastFrom<bool>(to);
     case DataType::DE_INT8:
-      CastFrom<int8_t>(input, output);
-      break;
+      return GetCastFrom<int8_t>(to);
     case DataType::DE_UINT8:
-      CastFrom<uint8_t>(input, output);
-      break;
+      return GetCastFrom<uint8_t>(to);
     case DataType::DE_INT16:
-      CastFrom<int16_t>(input, output);
-      break;
+      return GetCastFrom<int16_t>(to);
     case DataType::DE_UINT16:
-      CastFrom<uint16_t>(input, output);
-      break;
+      return GetCastFrom<uint16_t>(to);
     case DataType::DE_INT32:
-      CastFrom<int32_t>(input, output);
-      break;
+      return GetCastFrom<int32_t>(to);
     case DataType::DE_UINT32:
-      CastFrom<uint32_t>(input, output);
-      break;
+      return GetCastFrom<uint32_t>(to);
     case DataType::DE_INT64:
-      CastFrom<int64_t>(input, output);
-      break;
+      return GetCastFrom<int64_t>(to);
     case DataType::DE_UINT64:
-      CastFrom<uint64_t>(input, output);
-      break;
+      return GetCastFrom<uint64_t>(to);
     case DataType::DE_FLOAT16:
-      CastFrom<float16>(input, output);
-      break;
+      return GetCastFrom<float16>(to);
     case DataType::DE_FLOAT32:
-      CastFrom<float>(input, output);
-      break;
+      return GetCastFrom<float>(to);
     case DataType::DE_FLOAT64:
-      CastFrom<double>(input, output);
-      break;
-    case DataType::DE_UNKNOWN:
-      // sanity check, unreachable code.
-      RETURN_STATUS_UNEXPECTED("TypeCast does not support input of this type.");
+      return GetCastFrom<double>(to);
+    default:
+      return nullptr;
+  }
+}
+}  // namespace
+
+// Type cast operator
+Status TypeCast(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, const DataType &data_type) {
+  CastFunc cast = GetCastFunc(input->type(), data_type);
+  if (cast == nullptr) {
+    RETURN_STATUS_UNEXPECTED("TypeCast does not support input of this type.");
+  }
+  RETURN_IF_NOT_OK(Tensor::CreateTensor(output, TensorImpl::kFlexible, input->shape(), data_type));
+
+  static_cast<void>((*output)->StartAddr());
+  cast(input, output);
+  return Status::OK();
+}
+
+Status TypeCast(const TensorRow &input, TensorRow *output, const DataType &data_type) {
+  output->resize(input.size());
+  // The cast function is looked up again only when the type of the rows changes
+  CastFunc cast = nullptr;
+  DataType cast_from;
+  for (size_t i = 0; i < input.size(); ++i) {
+    if (cast == nullptr || input[i]->type() != cast_from) {
+      cast_from = input[i]->type();
+      cast = GetCastFunc(cast_from, data_type);
+      if (cast == nullptr) {
+        RETURN_STATUS_UNEXPECTED("TypeCast does not support input of this type.");
+      }
+    }
+    RETURN_IF_NOT_OK(Tensor::CreateTensor(&(*output)[i], TensorImpl::kFlexible, input[i]->shape(), data_type));
+    static_cast<void>((*output)[i]->StartAddr());
+    cast(input[i], &(*output)[i]);
   }
   return Status::OK();
 }
@@ -213,6 +226,11 @@ Status ToFloat16(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *
   RETURN_IF_NOT_OK(Tensor::CreateTensor(output, TensorImpl::kFlexible, input->shape(), new_type));
   static_cast<void>((*output)->StartAddr());
 
+  if (input->type() == DataType::DE_FLOAT32) {
+    auto out = reinterpret_cast<uint16_t *>((*output)->StartAddr());
+    FloatToHalf(reinterpret_cast<const float *>(input->StartAddr()), out, input->Size());
+    return Status::OK();
+  }
   auto in_itr = input->begin<float>();
   auto out_itr = (*output)->begin<float16>();
   auto out_end = (*output)->end<float16>();
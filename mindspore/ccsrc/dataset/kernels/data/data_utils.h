@@ -36,11 +36,8 @@ namespace dataset {
 // @param num_classes: Number of classes to.
 Status OneHotEncoding(std::shared_ptr<Tensor> input, std::shared_ptr<Tensor> *output, dsize_t num_classes);
 
-Status OneHotEncodingUnsigned(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output,
-                              dsize_t num_classes, int64_t index);
-
-Status OneHotEncodingSigned(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, dsize_t num_classes,
-                            int64_t index);
+// Returns the Onehot encoding of each Tensor of a batch, see above.
+Status OneHotEncoding(const TensorRow &input, TensorRow *output, dsize_t num_classes);
 
 // Returns a type changed input tensor.
 //          Example: if input tensor is float64, the output will the specified dataType. See DataTypes.cpp
@@ -48,16 +45,15 @@ Status OneHotEncodingSigned(const std::shared_ptr<Tensor> &input, std::shared_pt
 // @param output Tensor. The shape of the output tensor is same as input with the type changed.
 // @param data_type: type of data to cast data to
 // @note: this operation will do a memcpy and if the value is truncated then precision will be lost
+Status TypeCast(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, const DataType &data_type);
 
-template <typename T>
-void CastFrom(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output);
+// Returns each Tensor of a batch type changed, the cast function is picked once for rows of the same type.
+Status TypeCast(const TensorRow &input, TensorRow *output, const DataType &data_type);
 
 template <typename FROM, typename TO>
 void Cast(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output);
 
 Status ToFloat16(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output);
-
-Status TypeCast(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, const DataType &data_type);
 }  // namespace dataset
 }  // namespace mindspore
 
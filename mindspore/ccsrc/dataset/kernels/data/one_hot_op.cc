@@ -27,6 +27,11 @@ Status OneHotOp::Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<T
   return s;
 }
 
+Status OneHotOp::ComputeBatch(const TensorRow &input, TensorRow *output) {
+  IO_CHECK_VECTOR(input, output);
+  return OneHotEncoding(input, output, num_classes_);
+}
+
 Status OneHotOp::OutputShape(const std::vector<TensorShape> &inputs, std::vector<TensorShape> &outputs) {
   RETURN_IF_NOT_OK(TensorOp::OutputShape(inputs, outputs));
   outputs.clear();
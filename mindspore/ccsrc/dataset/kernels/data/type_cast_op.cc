@@ -28,6 +28,12 @@ TypeCastOp::TypeCastOp(const std::string &data_type) { type_ = DataType(data_typ
 Status TypeCastOp::Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) {
   return TypeCast(input, output, type_);
 }
+
+Status TypeCastOp::ComputeBatch(const TensorRow &input, TensorRow *output) {
+  IO_CHECK_VECTOR(input, output);
+  return TypeCast(input, output, type_);
+}
+
 Status TypeCastOp::OutputType(const std::vector<DataType> &inputs, std::vector<DataType> &outputs) {
   RETURN_IF_NOT_OK(TensorOp::OutputType(inputs, outputs));
   outputs[0] = type_;
@@ -39,9 +39,15 @@ class TypeCastOp : public TensorOp {
 
   Status Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) override;
 
+  Status ComputeBatch(const TensorRow &input, TensorRow *output) override;
+
   void Print(std::ostream &out) const override { out << "TypeCastOp"; }
   Status OutputType(const std::vector<DataType> &inputs, std::vector<DataType> &outputs) override;
 
+  // Getter
+  // @return the type to cast to
+  const DataType &type() const { return type_; }
+
  private:
   DataType type_;
 };
@@ -40,6 +40,10 @@ class DecodeOp : public TensorOp {
   Status OutputShape(const std::vector<TensorShape>& inputs, std::vector<TensorShape>& outputs) override;
   Status OutputType(const std::vector<DataType>& inputs, std::vector<DataType>& outputs) override;
 
+  // Getter
+  // @return true if the images are decoded in RGB order, false for BGR
+  bool is_rgb_format() const { return is_rgb_format_; }
+
  private:
   bool is_rgb_format_ = true;
 };
@@ -18,12 +18,14 @@
 #include <algorithm>
 #include <stdexcept>
 #include <utility>
+#include <vector>
 #include <opencv2/imgcodecs.hpp>
 #include "common/utils.h"
 #include "dataset/core/constants.h"
 #include "dataset/core/cv_tensor.h"
 #include "dataset/core/tensor.h"
 #include "dataset/core/tensor_shape.h"
+#include "dataset/kernels/simd_kernels.h"
 #include "dataset/util/random.h"
 
 #define MAX_INT_PRECISION 16777216  // float int precision is 16777216
@@ -59,7 +61,40 @@ int GetCVBorderType(BorderType type) {
   }
 }
 
+// Scratch row of the in place and fused kernels, each worker thread keeps its own
+static uchar *ScratchRow(size_t size) {
+  thread_local std::vector<uchar> row;
+  if (row.size() < size) {
+    row.resize(size);
+  }
+  return row.data();
+}
+
+// Horizontal and vertical flips only move whole pixels, they work on any type without OpenCV
+static Status FlipPixels(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, bool horizontal) {
+  const uchar *in = input->StartAddr();
+  if (in == nullptr) {
+    RETURN_STATUS_UNEXPECTED("Could not convert to CV Tensor, the input data is null");
+  }
+  std::shared_ptr<CVTensor> output_cv = std::make_shared<CVTensor>(input->shape(), input->type());
+  RETURN_UNEXPECTED_IF_NULL(output_cv);
+  int64_t height = input->shape()[0];
+  int64_t width = input->shape()[1];
+  int32_t pixel_size = input->type().SizeInBytes() * (input->Rank() == 3 ? input->shape()[2] : 1);
+  if (horizontal) {
+    FlipHorizontal(in, output_cv->StartAddr(), height, width, pixel_size);
+  } else {
+    FlipVertical(in, output_cv->StartAddr(), height, width, pixel_size);
+  }
+  *output = std::static_pointer_cast<Tensor>(output_cv);
+  return Status::OK();
+}
+
 Status Flip(std::shared_ptr<Tensor> input, std::shared_ptr<Tensor> *output, int flip_code) {
+  if ((flip_code == 0 || flip_code == 1) && (input->Rank() == 2 || input->Rank() == 3) &&
+      input->type().SizeInBytes() > 0) {
+    return FlipPixels(input, output, flip_code == 1);
+  }
   std::shared_ptr<CVTensor> input_cv = CVTensor::AsCVTensor(std::move(input));
 
   std::shared_ptr<CVTensor> output_cv = std::make_shared<CVTensor>(input_cv->shape(), input_cv->type());
@@ -86,6 +121,34 @@ Status VerticalFlip(std::shared_ptr<Tensor> input, std::shared_ptr<Tensor> *outp
   return Flip(std::move(input), output, 0);
 }
 
+bool CanFlipInPlace(const std::shared_ptr<Tensor> &input) {
+  return (input->Rank() == 2 || input->Rank() == 3) && input->type().SizeInBytes() > 0;
+}
+
+Status FlipInPlace(const std::shared_ptr<Tensor> &tensor, bool horizontal) {
+  if (!CanFlipInPlace(tensor)) {
+    RETURN_STATUS_UNEXPECTED("The image is not of shape <H,W,C> or <H,W> and of a numeric type");
+  }
+  uchar *data = tensor->StartAddr();
+  RETURN_UNEXPECTED_IF_NULL(data);
+  int64_t height = tensor->shape()[0];
+  int64_t width = tensor->shape()[1];
+  int32_t pixel_size = tensor->type().SizeInBytes() * (tensor->Rank() == 3 ? tensor->shape()[2] : 1);
+  size_t row_size = static_cast<size_t>(width) * pixel_size;
+  uchar *row = ScratchRow(row_size);
+  if (horizontal) {
+    for (int64_t y = 0; y < height; y++) {
+      (void)std::copy(data + y * row_size, data + (y + 1) * row_size, row);
+      FlipHorizontal(row, data + y * row_size, 1, width, pixel_size);
+    }
+  } else {
+    for (int64_t y = 0; y < height / 2; y++) {
+      (void)std::swap_ranges(data + y * row_size, data + (y + 1) * row_size, data + (height - 1 - y) * row_size);
+    }
+  }
+  return Status::OK();
+}
+
 Status Resize(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, int32_t output_height,
               int32_t output_width, double fx, double fy, InterpolationMode mode) {
   std::shared_ptr<CVTensor> input_cv = CVTensor::AsCVTensor(input);
@@ -322,6 +385,18 @@ Status JpegCropAndDecode(const std::shared_ptr<Tensor> &input, std::shared_ptr<T
 }
 
 Status Rescale(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, float rescale, float shift) {
+  if (input->type() == DataType::DE_UINT8 || input->type() == DataType::DE_FLOAT32) {
+    std::shared_ptr<CVTensor> output_cv = std::make_shared<CVTensor>(input->shape(), DataType(DataType::DE_FLOAT32));
+    RETURN_UNEXPECTED_IF_NULL(output_cv);
+    auto out = reinterpret_cast<float *>(output_cv->StartAddr());
+    if (input->type() == DataType::DE_UINT8) {
+      ScaleShiftChannels(input->StartAddr(), out, input->Size(), 1, &rescale, &shift);
+    } else {
+      ScaleShiftChannels(reinterpret_cast<const float *>(input->StartAddr()), out, input->Size(), 1, &rescale, &shift);
+    }
+    *output = std::static_pointer_cast<Tensor>(output_cv);
+    return Status::OK();
+  }
   std::shared_ptr<CVTensor> input_cv = CVTensor::AsCVTensor(input);
   if (!input_cv->mat().data) {
     RETURN_STATUS_UNEXPECTED("Could not convert to CV Tensor");
@@ -338,6 +413,18 @@ Status Rescale(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *ou
   return Status::OK();
 }
 
+Status RescaleInPlace(const std::shared_ptr<Tensor> &tensor, float rescale, float shift, bool *done) {
+  *done = false;
+  if (tensor->type() != DataType::DE_FLOAT32) {
+    return Status::OK();
+  }
+  auto data = reinterpret_cast<float *>(tensor->StartAddr());
+  RETURN_UNEXPECTED_IF_NULL(data);
+  ScaleShiftChannels(data, data, tensor->Size(), 1, &rescale, &shift);
+  *done = true;
+  return Status::OK();
+}
+
 Status Crop(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, int x, int y, int w, int h) {
   std::shared_ptr<CVTensor> input_cv = CVTensor::AsCVTensor(input);
   if (!input_cv->mat().data) {
@@ -361,31 +448,23 @@ Status Crop(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *outpu
 }
 
 Status HwcToChw(std::shared_ptr<Tensor> input, std::shared_ptr<Tensor> *output) {
-  try {
-    std::shared_ptr<CVTensor> input_cv = CVTensor::AsCVTensor(input);
-    if (!input_cv->mat().data) {
-      RETURN_STATUS_UNEXPECTED("Could not convert to CV Tensor");
-    }
-    if (input_cv->shape().Size() != 3 && input_cv->shape()[2] != 3) {
-      RETURN_STATUS_UNEXPECTED("The shape is incorrect: number of channels is not equal 3");
-    }
-    cv::Mat output_img;
-
-    int height = input_cv->shape()[0];
-    int width = input_cv->shape()[1];
-    int num_channels = input_cv->shape()[2];
-
-    auto output_cv = std::make_unique<CVTensor>(TensorShape{num_channels, height, width}, input_cv->type());
-    for (int i = 0; i < num_channels; ++i) {
-      cv::Mat mat;
-      RETURN_IF_NOT_OK(output_cv->Mat({i}, &mat));
-      cv::extractChannel(input_cv->mat(), mat, i);
-    }
-    *output = std::move(output_cv);
-    return Status::OK();
-  } catch (const cv::Exception &e) {
-    RETURN_STATUS_UNEXPECTED("Unexpected error in ChannelSwap.");
+  if (input->Rank() != 3) {
+    RETURN_STATUS_UNEXPECTED("The shape is incorrect: the image is not of shape <H,W,C>");
+  }
+  const uchar *in = input->StartAddr();
+  if (in == nullptr || input->type().SizeInBytes() == 0) {
+    RETURN_STATUS_UNEXPECTED("Could not convert to CV Tensor");
   }
+  int height = input->shape()[0];
+  int width = input->shape()[1];
+  int num_channels = input->shape()[2];
+
+  auto output_cv = std::make_shared<CVTensor>(TensorShape{num_channels, height, width}, input->type());
+  RETURN_UNEXPECTED_IF_NULL(output_cv);
+  InterleavedToPlanar(in, output_cv->StartAddr(), static_cast<int64_t>(height) * width, num_channels,
+                      input->type().SizeInBytes());
+  *output = std::static_pointer_cast<Tensor>(output_cv);
+  return Status::OK();
 }
 
 Status SwapRedAndBlue(std::shared_ptr<Tensor> input, std::shared_ptr<Tensor> *output) {
@@ -489,15 +568,9 @@ Status Rotate(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *out
   return Status::OK();
 }
 
-Status Normalize(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output,
-                 const std::shared_ptr<Tensor> &mean, const std::shared_ptr<Tensor> &std) {
-  std::shared_ptr<CVTensor> input_cv = CVTensor::AsCVTensor(input);
-  if (!(input_cv->mat().data && input_cv->Rank() == 3)) {
-    RETURN_STATUS_UNEXPECTED("Could not convert to CV Tensor");
-  }
-  cv::Mat in_image = input_cv->mat();
-  std::shared_ptr<CVTensor> output_cv = std::make_shared<CVTensor>(input_cv->shape(), DataType(DataType::DE_FLOAT32));
-  RETURN_UNEXPECTED_IF_NULL(output_cv);
+// Checks the mean and std tensors and turns them into the scale and shift of each channel
+static Status GetNormalizeScaleShift(const std::shared_ptr<Tensor> &mean, const std::shared_ptr<Tensor> &std,
+                                     float *scale, float *shift) {
   mean->Squeeze();
   if (mean->type() != DataType::DE_FLOAT32 || mean->Rank() != 1 || mean->shape()[0] != 3) {
     std::string err_msg = "Mean tensor should be of size 3 and type float.";
@@ -508,16 +581,62 @@ Status Normalize(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *
     std::string err_msg = "Std tensor should be of size 3 and type float.";
     return Status(StatusCode::kShapeMisMatch, err_msg);
   }
+  for (uint8_t i = 0; i < 3; i++) {
+    float mean_c, std_c;
+    RETURN_IF_NOT_OK(mean->GetItemAt<float>(&mean_c, {i}));
+    RETURN_IF_NOT_OK(std->GetItemAt<float>(&std_c, {i}));
+    scale[i] = 1.0f / std_c;
+    shift[i] = -mean_c / std_c;
+  }
+  return Status::OK();
+}
+
+// Images, or batches of images, of 3 interleaved channels that the vector kernels can normalize
+static bool CanNormalizeChannels(const std::shared_ptr<Tensor> &input) {
+  return input->Rank() >= 3 && input->shape()[input->Rank() - 1] == 3 &&
+         (input->type() == DataType::DE_UINT8 || input->type() == DataType::DE_FLOAT32);
+}
+
+static Status NormalizeChannels(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output,
+                                const float *scale, const float *shift) {
+  std::shared_ptr<CVTensor> output_cv = std::make_shared<CVTensor>(input->shape(), DataType(DataType::DE_FLOAT32));
+  RETURN_UNEXPECTED_IF_NULL(output_cv);
+  auto out = reinterpret_cast<float *>(output_cv->StartAddr());
+  RETURN_UNEXPECTED_IF_NULL(out);
+  int64_t num_pixels = input->Size() / 3;
+  if (input->type() == DataType::DE_UINT8) {
+    ScaleShiftChannels(input->StartAddr(), out, num_pixels, 3, scale, shift);
+  } else {
+    ScaleShiftChannels(reinterpret_cast<const float *>(input->StartAddr()), out, num_pixels, 3, scale, shift);
+  }
+  *output = std::static_pointer_cast<Tensor>(output_cv);
+  return Status::OK();
+}
+
+Status Normalize(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output,
+                 const std::shared_ptr<Tensor> &mean, const std::shared_ptr<Tensor> &std) {
+  // NOTE: We are assuming the input image is in RGB and the mean
+  // and std are in RGB
+  float scale[3];
+  float shift[3];
+  if (CanNormalizeChannels(input)) {
+    RETURN_IF_NOT_OK(GetNormalizeScaleShift(mean, std, scale, shift));
+    return NormalizeChannels(input, output, scale, shift);
+  }
+
+  std::shared_ptr<CVTensor> input_cv = CVTensor::AsCVTensor(input);
+  if (!(input_cv->mat().data && input_cv->Rank() == 3)) {
+    RETURN_STATUS_UNEXPECTED("Could not convert to CV Tensor");
+  }
+  cv::Mat in_image = input_cv->mat();
+  std::shared_ptr<CVTensor> output_cv = std::make_shared<CVTensor>(input_cv->shape(), DataType(DataType::DE_FLOAT32));
+  RETURN_UNEXPECTED_IF_NULL(output_cv);
+  RETURN_IF_NOT_OK(GetNormalizeScaleShift(mean, std, scale, shift));
   try {
-    // NOTE: We are assuming the input image is in RGB and the mean
-    // and std are in RGB
     cv::Mat rgb[3];
     cv::split(in_image, rgb);
     for (uint8_t i = 0; i < 3; i++) {
-      float mean_c, std_c;
-      RETURN_IF_NOT_OK(mean->GetItemAt<float>(&mean_c, {i}));
-      RETURN_IF_NOT_OK(std->GetItemAt<float>(&std_c, {i}));
-      rgb[i].convertTo(rgb[i], CV_32F, 1.0 / std_c, (-mean_c / std_c));
+      rgb[i].convertTo(rgb[i], CV_32F, scale[i], shift[i]);
     }
     cv::merge(rgb, 3, output_cv->mat());
     *output = std::static_pointer_cast<Tensor>(output_cv);
@@ -527,6 +646,95 @@ Status Normalize(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *
   }
 }
 
+Status NormalizeInPlace(const std::shared_ptr<Tensor> &tensor, const std::shared_ptr<Tensor> &mean,
+                        const std::shared_ptr<Tensor> &std, bool *done) {
+  *done = false;
+  if (!CanNormalizeChannels(tensor) || tensor->type() != DataType::DE_FLOAT32) {
+    return Status::OK();
+  }
+  float scale[3];
+  float shift[3];
+  RETURN_IF_NOT_OK(GetNormalizeScaleShift(mean, std, scale, shift));
+  auto data = reinterpret_cast<float *>(tensor->StartAddr());
+  RETURN_UNEXPECTED_IF_NULL(data);
+  ScaleShiftChannels(data, data, tensor->Size() / 3, 3, scale, shift);
+  *done = true;
+  return Status::OK();
+}
+
+Status Normalize(const TensorRow &input, TensorRow *output, const std::shared_ptr<Tensor> &mean,
+                 const std::shared_ptr<Tensor> &std) {
+  float scale[3];
+  float shift[3];
+  RETURN_IF_NOT_OK(GetNormalizeScaleShift(mean, std, scale, shift));
+  output->resize(input.size());
+  for (size_t i = 0; i < input.size(); ++i) {
+    if (CanNormalizeChannels(input[i])) {
+      RETURN_IF_NOT_OK(NormalizeChannels(input[i], &(*output)[i], scale, shift));
+    } else {
+      RETURN_IF_NOT_OK(Normalize(input[i], &(*output)[i], mean, std));
+    }
+  }
+  return Status::OK();
+}
+
+// Normalizes and transposes one image of type T into planes of type U, reading the image a row at a time when the
+// rows are flipped on the way
+template <typename T, typename U>
+static void NormalizeToPlanar(const T *in, U *out, int64_t height, int64_t width, const float *scale,
+                             const float *shift, bool horizontal_flip) {
+  int64_t plane_size = height * width;
+  if (!horizontal_flip) {
+    ScaleShiftToPlanar(in, out, plane_size, 3, plane_size, scale, shift);
+    return;
+  }
+  int32_t pixel_size = 3 * sizeof(T);
+  auto row = reinterpret_cast<T *>(ScratchRow(static_cast<size_t>(width) * pixel_size));
+  for (int64_t y = 0; y < height; y++) {
+    FlipHorizontal(reinterpret_cast<const uchar *>(in + y * width * 3), reinterpret_cast<uchar *>(row), 1, width,
+                   pixel_size);
+    ScaleShiftToPlanar(row, out + y * width, width, 3, plane_size, scale, shift);
+  }
+}
+
+Status NormalizeHwcToChw(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output,
+                         const std::shared_ptr<Tensor> &mean, const std::shared_ptr<Tensor> &std,
+                         const DataType &output_type, bool horizontal_flip) {
+  if (input->Rank() != 3 || input->shape()[2] != 3) {
+    RETURN_STATUS_UNEXPECTED("The shape is incorrect: the image is not of shape <H,W,3>");
+  }
+  if (input->type() != DataType::DE_UINT8 && input->type() != DataType::DE_FLOAT32) {
+    RETURN_STATUS_UNEXPECTED("The image should be of type uint8 or float32");
+  }
+  if (output_type != DataType::DE_FLOAT32 && output_type != DataType::DE_FLOAT16) {
+    RETURN_STATUS_UNEXPECTED("The output type should be float32 or float16");
+  }
+  float scale[3];
+  float shift[3];
+  RETURN_IF_NOT_OK(GetNormalizeScaleShift(mean, std, scale, shift));
+  dsize_t height = input->shape()[0];
+  dsize_t width = input->shape()[1];
+  std::shared_ptr<Tensor> output_tensor;
+  RETURN_IF_NOT_OK(
+    Tensor::CreateTensor(&output_tensor, TensorImpl::kFlexible, TensorShape{3, height, width}, output_type));
+  uchar *out = output_tensor->StartAddr();
+  RETURN_UNEXPECTED_IF_NULL(out);
+  const uchar *in = input->StartAddr();
+  if (input->type() == DataType::DE_UINT8 && output_type == DataType::DE_FLOAT32) {
+    NormalizeToPlanar(in, reinterpret_cast<float *>(out), height, width, scale, shift, horizontal_flip);
+  } else if (input->type() == DataType::DE_UINT8) {
+    NormalizeToPlanar(in, reinterpret_cast<uint16_t *>(out), height, width, scale, shift, horizontal_flip);
+  } else if (output_type == DataType::DE_FLOAT32) {
+    NormalizeToPlanar(reinterpret_cast<const float *>(in), reinterpret_cast<float *>(out), height, width, scale,
+                      shift, horizontal_flip);
+  } else {
+    NormalizeToPlanar(reinterpret_cast<const float *>(in), reinterpret_cast<uint16_t *>(out), height, width, scale,
+                      shift, horizontal_flip);
+  }
+  *output = std::move(output_tensor);
+  return Status::OK();
+}
+
 Status AdjustBrightness(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, const float &alpha) {
   try {
     std::shared_ptr<CVTensor> input_cv = CVTensor::AsCVTensor(input);
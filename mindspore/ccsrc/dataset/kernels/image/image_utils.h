@@ -69,6 +69,14 @@ Status HorizontalFlip(std::shared_ptr<Tensor> input, std::shared_ptr<Tensor> *ou
 // The flipping happens in place.
 Status VerticalFlip(std::shared_ptr<Tensor> input, std::shared_ptr<Tensor> *output);
 
+// Returns true if FlipInPlace() supports the image: rank 2 or 3 and a numeric type
+bool CanFlipInPlace(const std::shared_ptr<Tensor> &input);
+
+// Flips the image in place, without allocating a new Tensor
+// @param tensor: Tensor of shape <H,W,C> or <H,W>, see CanFlipInPlace()
+// @param horizontal: true to flip around the y-axis, false to flip around the x-axis
+Status FlipInPlace(const std::shared_ptr<Tensor> &tensor, bool horizontal);
+
 // Returns Resized image.
 // @param input/output: Tensor of shape <H,W,C> or <H,W> and any OpenCv compatible type, see CVTensor.
 // @param output_height: height of output
@@ -105,6 +113,11 @@ Status JpegCropAndDecode(const std::shared_ptr<Tensor> &input, std::shared_ptr<T
 // @param output: Rescaled image Tensor of same input shape and type DE_FLOAT32
 Status Rescale(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, float rescale, float shift);
 
+// Rescales the image in place, only float images keep their type and can be rescaled in place
+// @param tensor: Tensor of any shape
+// @param done: false if the tensor is not of type DE_FLOAT32, it is then left unchanged
+Status RescaleInPlace(const std::shared_ptr<Tensor> &tensor, float rescale, float shift, bool *done);
+
 // Returns cropped ROI of an image
 // @param input: Tensor of shape <H,W,C> or <H,W> and any OpenCv compatible type, see CVTensor.
 // @param x: starting horizontal position of ROI
@@ -115,8 +128,8 @@ Status Rescale(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *ou
 Status Crop(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, int x, int y, int w, int h);
 
 // Swaps the channels in the image, i.e. converts HWC to CHW
-// @param input: Tensor of shape <H,W,C> or <H,W> and any OpenCv compatible type, see CVTensor.
-// @param output: Tensor of shape <C,H,W> or <H,W> and same input type.
+// @param input: Tensor of shape <H,W,C> and any numeric type.
+// @param output: Tensor of shape <C,H,W> and same input type.
 Status HwcToChw(std::shared_ptr<Tensor> input, std::shared_ptr<Tensor> *output);
 
 // Swap the red and blue pixels (RGB <-> BGR)
@@ -150,13 +163,35 @@ Status Rotate(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *out
               uint8_t fill_r = 0, uint8_t fill_g = 0, uint8_t fill_b = 0);
 
 // Returns Normalized image
-// @param input: Tensor of shape <H,W,C> in RGB order and any OpenCv compatible type, see CVTensor.
+// @param input: Tensor of shape <H,W,C> in RGB order and any OpenCv compatible type, see CVTensor. A batch of
+//     shape <N,H,W,3> and type DE_UINT8 or DE_FLOAT32 is normalized as a whole.
 // @param mean: Tensor of shape <3> and type DE_FLOAT32 which are mean of each channel in RGB order
 // @param std:  Tensor of shape <3> and type DE_FLOAT32 which are std of each channel in RGB order
 // @param output: Normalized image Tensor of same input shape and type DE_FLOAT32
 Status Normalize(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output,
                  const std::shared_ptr<Tensor> &mean, const std::shared_ptr<Tensor> &std);
 
+// Normalizes the image in place
+// @param tensor: Tensor of shape <H,W,C> in RGB order
+// @param done: false unless the tensor is of shape <...,3> and type DE_FLOAT32, it is then left unchanged
+Status NormalizeInPlace(const std::shared_ptr<Tensor> &tensor, const std::shared_ptr<Tensor> &mean,
+                        const std::shared_ptr<Tensor> &std, bool *done);
+
+// Returns each image of the batch Normalized, the mean and std are checked once for the whole batch
+Status Normalize(const TensorRow &input, TensorRow *output, const std::shared_ptr<Tensor> &mean,
+                 const std::shared_ptr<Tensor> &std);
+
+// Returns Normalized image transposed to CHW, in a single pass over the image
+// @param input: Tensor of shape <H,W,3> in RGB order and type DE_UINT8 or DE_FLOAT32.
+// @param mean: Tensor of shape <3> and type DE_FLOAT32 which are mean of each channel in RGB order
+// @param std:  Tensor of shape <3> and type DE_FLOAT32 which are std of each channel in RGB order
+// @param output_type: DE_FLOAT32, or DE_FLOAT16 to also cast the result
+// @param horizontal_flip: also flip the image around the y-axis, each row is flipped while it is in cache
+// @param output: Normalized image Tensor of shape <3,H,W> and type output_type
+Status NormalizeHwcToChw(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output,
+                         const std::shared_ptr<Tensor> &mean, const std::shared_ptr<Tensor> &std,
+                         const DataType &output_type, bool horizontal_flip = false);
+
 // Returns image with adjusted brightness.
 // @param input: Tensor of shape <H,W,3> in RGB order and any OpenCv compatible type, see CVTensor.
 // @param alpha: Alpha value to adjust brightness by. Should be a positive number.
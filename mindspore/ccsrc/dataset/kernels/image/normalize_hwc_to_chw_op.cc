@@ -0,0 +1,99 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "dataset/kernels/image/normalize_hwc_to_chw_op.h"
+
+#include <utility>
+
+#include "dataset/core/cv_tensor.h"
+#include "dataset/kernels/image/image_utils.h"
+#include "dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+NormalizeHwcToChwOp::NormalizeHwcToChwOp(float mean_r, float mean_g, float mean_b, float std_r, float std_g,
+                                         float std_b, bool to_float16)
+    : output_type_(to_float16 ? DataType::DE_FLOAT16 : DataType::DE_FLOAT32) {
+  int size[] = {3};
+  cv::Mat mean_cv(1, size, CV_32F);
+  mean_cv.at<float>(0) = mean_r;
+  mean_cv.at<float>(1) = mean_g;
+  mean_cv.at<float>(2) = mean_b;
+  mean_ = std::make_shared<CVTensor>(mean_cv);
+  mean_->Squeeze();
+
+  cv::Mat std_cv(1, size, CV_32F);
+  std_cv.at<float>(0) = std_r;
+  std_cv.at<float>(1) = std_g;
+  std_cv.at<float>(2) = std_b;
+  std_ = std::make_shared<CVTensor>(std_cv);
+  std_->Squeeze();
+}
+
+NormalizeHwcToChwOp::NormalizeHwcToChwOp(const NormalizeOp &normalize, std::shared_ptr<RandomHorizontalFlipOp> flip,
+                                         bool to_float16, std::vector<std::shared_ptr<TensorOp>> ops)
+    : mean_(normalize.mean()),
+      std_(normalize.std()),
+      output_type_(to_float16 ? DataType::DE_FLOAT16 : DataType::DE_FLOAT32),
+      flip_(std::move(flip)),
+      ops_(std::move(ops)) {}
+
+Status NormalizeHwcToChwOp::Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) {
+  IO_CHECK(input, output);
+  bool supported = input->Rank() == 3 && input->shape()[2] == 3 &&
+                   (input->type() == DataType::DE_UINT8 || input->type() == DataType::DE_FLOAT32);
+  if (!supported && !ops_.empty()) {
+    std::shared_ptr<Tensor> tensor = input;
+    for (const auto &op : ops_) {
+      std::shared_ptr<Tensor> result;
+      RETURN_IF_NOT_OK(op->Compute(tensor, &result));
+      tensor = std::move(result);
+    }
+    *output = std::move(tensor);
+    return Status::OK();
+  }
+  bool horizontal_flip = flip_ != nullptr && flip_->DrawFlip();
+  return NormalizeHwcToChw(input, output, mean_, std_, output_type_, horizontal_flip);
+}
+
+Status NormalizeHwcToChwOp::OutputShape(const std::vector<TensorShape> &inputs, std::vector<TensorShape> &outputs) {
+  RETURN_IF_NOT_OK(TensorOp::OutputShape(inputs, outputs));
+  outputs.clear();
+  TensorShape in = inputs[0];
+  if (in.Rank() == 3) outputs.emplace_back(TensorShape{in[2], in[0], in[1]});
+  if (!outputs.empty()) return Status::OK();
+  return Status(StatusCode::kUnexpectedError, "Input has a wrong shape");
+}
+
+Status NormalizeHwcToChwOp::OutputType(const std::vector<DataType> &inputs, std::vector<DataType> &outputs) {
+  RETURN_IF_NOT_OK(TensorOp::OutputType(inputs, outputs));
+  outputs[0] = output_type_;
+  return Status::OK();
+}
+
+void NormalizeHwcToChwOp::Print(std::ostream &out) const {
+  out << "NormalizeHwcToChwOp, mean: " << mean_->mat().at<float>(0) << ", " << mean_->mat().at<float>(1) << ", "
+      << mean_->mat().at<float>(2) << " std: " << std_->mat().at<float>(0) << ", " << std_->mat().at<float>(1)
+      << ", " << std_->mat().at<float>(2) << " output type: " << output_type_;
+  if (!ops_.empty()) {
+    out << " fused:";
+    for (const auto &op : ops_) {
+      out << " " << *op;
+    }
+  }
+  out << std::endl;
+}
+}  // namespace dataset
+}  // namespace mindspore
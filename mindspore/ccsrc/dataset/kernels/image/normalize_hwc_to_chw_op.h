@@ -0,0 +1,65 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef DATASET_KERNELS_IMAGE_NORMALIZE_HWC_TO_CHW_OP_H_
+#define DATASET_KERNELS_IMAGE_NORMALIZE_HWC_TO_CHW_OP_H_
+
+#include <memory>
+#include <vector>
+
+#include "dataset/core/cv_tensor.h"
+#include "dataset/core/tensor.h"
+#include "dataset/kernels/image/normalize_op.h"
+#include "dataset/kernels/image/random_horizontal_flip_op.h"
+#include "dataset/kernels/tensor_op.h"
+#include "dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+// Fuses NormalizeOp, HwcToChwOp and optionally ToFloat16Op, the image is read and written once
+class NormalizeHwcToChwOp : public TensorOp {
+ public:
+  NormalizeHwcToChwOp(float mean_r, float mean_g, float mean_b, float std_r, float std_g, float std_b,
+                      bool to_float16);
+
+  // Fused form of a NormalizeOp followed by a HwcToChwOp, built by FuseTensorOps()
+  // @param normalize: the fused NormalizeOp
+  // @param flip: a RandomHorizontalFlipOp before the NormalizeOp, drawn for each image, or null
+  // @param to_float16: true if a cast to float16 follows the HwcToChwOp
+  // @param ops: all the fused ops in order, run one after the other on images the fused kernel does not support
+  NormalizeHwcToChwOp(const NormalizeOp &normalize, std::shared_ptr<RandomHorizontalFlipOp> flip, bool to_float16,
+                      std::vector<std::shared_ptr<TensorOp>> ops);
+
+  ~NormalizeHwcToChwOp() override = default;
+
+  void Print(std::ostream &out) const override;
+
+  Status Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) override;
+
+  Status OutputShape(const std::vector<TensorShape> &inputs, std::vector<TensorShape> &outputs) override;
+
+  Status OutputType(const std::vector<DataType> &inputs, std::vector<DataType> &outputs) override;
+
+ private:
+  std::shared_ptr<CVTensor> mean_;
+  std::shared_ptr<CVTensor> std_;
+  DataType output_type_;
+  std::shared_ptr<RandomHorizontalFlipOp> flip_;
+  std::vector<std::shared_ptr<TensorOp>> ops_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // DATASET_KERNELS_IMAGE_NORMALIZE_HWC_TO_CHW_OP_H_
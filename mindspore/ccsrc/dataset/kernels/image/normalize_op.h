@@ -35,6 +35,15 @@ class NormalizeOp : public TensorOp {
 
   Status Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) override;
 
+  Status ComputeInPlace(const std::shared_ptr<Tensor> &tensor, bool *done) override;
+
+  Status ComputeBatch(const TensorRow &input, TensorRow *output) override;
+
+  // Getters
+  // @return the mean and std of each channel, tensors of shape <3>
+  const std::shared_ptr<CVTensor> &mean() const { return mean_; }
+  const std::shared_ptr<CVTensor> &std() const { return std_; }
+
  private:
   std::shared_ptr<CVTensor> mean_;
   std::shared_ptr<CVTensor> std_;
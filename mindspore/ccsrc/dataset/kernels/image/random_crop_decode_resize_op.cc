@@ -27,6 +27,9 @@ RandomCropDecodeResizeOp::RandomCropDecodeResizeOp(int32_t target_height, int32_
     : RandomCropAndResizeOp(target_height, target_width, scale_lb, scale_ub, aspect_lb, aspect_ub, interpolation,
                             max_iter) {}
 
+RandomCropDecodeResizeOp::RandomCropDecodeResizeOp(const RandomCropAndResizeOp &crop_and_resize)
+    : RandomCropAndResizeOp(crop_and_resize) {}
+
 Status RandomCropDecodeResizeOp::Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) {
   if (input == nullptr) {
     RETURN_STATUS_UNEXPECTED("input tensor is null");
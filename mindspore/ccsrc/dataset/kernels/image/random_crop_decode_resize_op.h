@@ -35,6 +35,10 @@ class RandomCropDecodeResizeOp : public RandomCropAndResizeOp {
                            float scale_ub = kDefScaleUb, float aspect_lb = kDefAspectLb, float aspect_ub = kDefAspectUb,
                            InterpolationMode interpolation = kDefInterpolation, int32_t max_iter = kDefMaxIter);
 
+  // Fused form of a DecodeOp and the RandomCropAndResizeOp after it, built by FuseTensorOps().
+  // It copies the random generator of that op, so that it draws the same crops.
+  explicit RandomCropDecodeResizeOp(const RandomCropAndResizeOp &crop_and_resize);
+
   ~RandomCropDecodeResizeOp() override = default;
 
   void Print(std::ostream &out) const override {
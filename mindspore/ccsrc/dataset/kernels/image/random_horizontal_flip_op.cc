@@ -24,11 +24,22 @@ const float RandomHorizontalFlipOp::kDefProbability = 0.5;
 
 Status RandomHorizontalFlipOp::Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) {
   IO_CHECK(input, output);
-  if (distribution_(rnd_)) {
+  if (DrawFlip()) {
     return HorizontalFlip(input, output);
   }
   *output = input;
   return Status::OK();
 }
+
+Status RandomHorizontalFlipOp::ComputeInPlace(const std::shared_ptr<Tensor> &tensor, bool *done) {
+  RETURN_UNEXPECTED_IF_NULL(tensor);
+  RETURN_UNEXPECTED_IF_NULL(done);
+  // Checked before drawing, so that Compute() draws only once when the image can't be flipped in place
+  *done = CanFlipInPlace(tensor);
+  if (*done && DrawFlip()) {
+    return FlipInPlace(tensor, true);
+  }
+  return Status::OK();
+}
 }  // namespace dataset
 }  // namespace mindspore
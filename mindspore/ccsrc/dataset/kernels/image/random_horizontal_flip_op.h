@@ -47,6 +47,12 @@ class RandomHorizontalFlipOp : public TensorOp {
 
   Status Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) override;
 
+  Status ComputeInPlace(const std::shared_ptr<Tensor> &tensor, bool *done) override;
+
+  // Draws whether the next image is flipped, NormalizeHwcToChwOp draws it this way when the flip is fused into it
+  // @return true to flip the image
+  bool DrawFlip() { return distribution_(rnd_); }
+
  private:
   std::mt19937 rnd_;
   std::bernoulli_distribution distribution_;
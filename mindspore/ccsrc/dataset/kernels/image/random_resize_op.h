@@ -45,6 +45,11 @@ class RandomResizeOp : public ResizeOp {
 
   Status Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) override;
 
+  // Each image draws its own interpolation, the batch is computed a row at a time
+  Status ComputeBatch(const TensorRow &input, TensorRow *output) override {
+    return TensorOp::ComputeBatch(input, output);
+  }
+
  private:
   std::mt19937 random_generator_;
   std::uniform_int_distribution<int> distribution_{0, 3};
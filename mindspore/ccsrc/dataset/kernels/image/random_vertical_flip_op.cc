@@ -31,5 +31,16 @@ Status RandomVerticalFlipOp::Compute(const std::shared_ptr<Tensor> &input, std::
   *output = input;
   return Status::OK();
 }
+
+Status RandomVerticalFlipOp::ComputeInPlace(const std::shared_ptr<Tensor> &tensor, bool *done) {
+  RETURN_UNEXPECTED_IF_NULL(tensor);
+  RETURN_UNEXPECTED_IF_NULL(done);
+  // Checked before drawing, so that Compute() draws only once when the image can't be flipped in place
+  *done = CanFlipInPlace(tensor);
+  if (*done && distribution_(rnd_)) {
+    return FlipInPlace(tensor, false);
+  }
+  return Status::OK();
+}
 }  // namespace dataset
 }  // namespace mindspore
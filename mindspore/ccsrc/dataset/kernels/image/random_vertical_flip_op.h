@@ -41,6 +41,8 @@ class RandomVerticalFlipOp : public TensorOp {
 
   Status Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) override;
 
+  Status ComputeInPlace(const std::shared_ptr<Tensor> &tensor, bool *done) override;
+
  private:
   std::mt19937 rnd_;
   std::bernoulli_distribution distribution_;
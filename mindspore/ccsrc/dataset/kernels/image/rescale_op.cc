@@ -24,6 +24,22 @@ Status RescaleOp::Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<
   IO_CHECK(input, output);
   return Rescale(input, output, rescale_, shift_);
 }
+
+Status RescaleOp::ComputeInPlace(const std::shared_ptr<Tensor> &tensor, bool *done) {
+  RETURN_UNEXPECTED_IF_NULL(tensor);
+  RETURN_UNEXPECTED_IF_NULL(done);
+  return RescaleInPlace(tensor, rescale_, shift_, done);
+}
+
+Status RescaleOp::ComputeBatch(const TensorRow &input, TensorRow *output) {
+  IO_CHECK_VECTOR(input, output);
+  output->resize(input.size());
+  for (size_t i = 0; i < input.size(); ++i) {
+    RETURN_IF_NOT_OK(Rescale(input[i], &(*output)[i], rescale_, shift_));
+  }
+  return Status::OK();
+}
+
 Status RescaleOp::OutputType(const std::vector<DataType> &inputs, std::vector<DataType> &outputs) {
   RETURN_IF_NOT_OK(TensorOp::OutputType(inputs, outputs));
   outputs[0] = DataType(DataType::DE_FLOAT32);
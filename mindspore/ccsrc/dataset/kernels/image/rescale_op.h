@@ -36,6 +36,10 @@ class RescaleOp : public TensorOp {
   }
 
   Status Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) override;
+
+  Status ComputeInPlace(const std::shared_ptr<Tensor> &tensor, bool *done) override;
+
+  Status ComputeBatch(const TensorRow &input, TensorRow *output) override;
   Status OutputType(const std::vector<DataType> &inputs, std::vector<DataType> &outputs) override;
 
  private:
@@ -23,30 +23,49 @@ namespace dataset {
 const int32_t ResizeOp::kDefWidth = 0;
 const InterpolationMode ResizeOp::kDefInterpolation = InterpolationMode::kLinear;
 
-Status ResizeOp::Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) {
-  IO_CHECK(input, output);
+Status ResizeOp::GetOutputSize(const std::shared_ptr<Tensor> &input, int32_t *output_h, int32_t *output_w) const {
   CHECK_FAIL_RETURN_UNEXPECTED(input->shape().Size() >= 2, "The shape size " + std::to_string(input->shape().Size()) +
                                                              " of input tensor is invalid");
-  int32_t output_h, output_w = 0;
   int32_t input_h = static_cast<int>(input->shape()[0]);
   int32_t input_w = static_cast<int>(input->shape()[1]);
   if (size2_ == 0) {
     if (input_h < input_w) {
       CHECK_FAIL_RETURN_UNEXPECTED(input_h != 0, "The input height is 0");
-      output_h = size1_;
-      output_w = static_cast<int>(std::lround(static_cast<float>(input_w) / input_h * output_h));
+      *output_h = size1_;
+      *output_w = static_cast<int>(std::lround(static_cast<float>(input_w) / input_h * *output_h));
     } else {
       CHECK_FAIL_RETURN_UNEXPECTED(input_w != 0, "The input width is 0");
-      output_w = size1_;
-      output_h = static_cast<int>(std::lround(static_cast<float>(input_h) / input_w * output_w));
+      *output_w = size1_;
+      *output_h = static_cast<int>(std::lround(static_cast<float>(input_h) / input_w * *output_w));
     }
   } else {
-    output_h = size1_;
-    output_w = size2_;
+    *output_h = size1_;
+    *output_w = size2_;
   }
+  return Status::OK();
+}
+
+Status ResizeOp::Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) {
+  IO_CHECK(input, output);
+  int32_t output_h = 0, output_w = 0;
+  RETURN_IF_NOT_OK(GetOutputSize(input, &output_h, &output_w));
   return Resize(input, output, output_h, output_w, 0, 0, interpolation_);
 }
 
+Status ResizeOp::ComputeBatch(const TensorRow &input, TensorRow *output) {
+  IO_CHECK_VECTOR(input, output);
+  output->resize(input.size());
+  int32_t output_h = 0, output_w = 0;
+  for (size_t i = 0; i < input.size(); ++i) {
+    if (i == 0 || input[i]->shape().Size() < 2 || input[i - 1]->shape().Size() < 2 ||
+        input[i]->shape()[0] != input[i - 1]->shape()[0] || input[i]->shape()[1] != input[i - 1]->shape()[1]) {
+      RETURN_IF_NOT_OK(GetOutputSize(input[i], &output_h, &output_w));
+    }
+    RETURN_IF_NOT_OK(Resize(input[i], &(*output)[i], output_h, output_w, 0, 0, interpolation_));
+  }
+  return Status::OK();
+}
+
 Status ResizeOp::OutputShape(const std::vector<TensorShape> &inputs, std::vector<TensorShape> &outputs) {
   RETURN_IF_NOT_OK(TensorOp::OutputShape(inputs, outputs));
   outputs.clear();
@@ -48,9 +48,18 @@ class ResizeOp : public TensorOp {
   void Print(std::ostream &out) const override { out << "ResizeOp: " << size1_ << " " << size2_; }
 
   Status Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) override;
+
+  // The output size is computed once for the consecutive images of the same size
+  Status ComputeBatch(const TensorRow &input, TensorRow *output) override;
+
   Status OutputShape(const std::vector<TensorShape> &inputs, std::vector<TensorShape> &outputs) override;
 
  protected:
+  // Computes the size of the resized image
+  // @param input: the image, of shape <H,W> or <H,W,C>
+  // @param output_h, output_w: the size of the resized image
+  Status GetOutputSize(const std::shared_ptr<Tensor> &input, int32_t *output_h, int32_t *output_w) const;
+
   int32_t size1_;
   int32_t size2_;
   InterpolationMode interpolation_;
@@ -0,0 +1,680 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "dataset/kernels/simd_kernels.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+// The x86 vector code is compiled with target attributes so that the library still runs on cpus without avx2
+#if defined(__GNUC__) && defined(__x86_64__)
+#include <immintrin.h>
+#define DE_SIMD_X86
+#define DE_TARGET_AVX2 __attribute__((target("avx2,fma,f16c")))
+#define DE_TARGET_AVX512 __attribute__((target("avx512f,avx2,fma,f16c")))
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#define DE_SIMD_NEON
+#endif
+
+namespace mindspore {
+namespace dataset {
+namespace {
+// Length of the repeated per channel scale and shift, a multiple of the vector widths and of 1, 2, 3 and 4 channels
+constexpr int32_t kPatternLen = 48;
+// Pixels of 3 uint8 channels deinterleaved at once, they fill three 16 bytes registers
+constexpr int32_t kBlockPixels = 16;
+
+SimdLevel DetectSimdLevel() {
+#if defined(DE_SIMD_X86)
+  // Every cpu with avx2 and fma also has the f16c conversions
+  __builtin_cpu_init();
+  if (!__builtin_cpu_supports("avx2") || !__builtin_cpu_supports("fma")) return SimdLevel::kScalar;
+  if (__builtin_cpu_supports("avx512f")) return SimdLevel::kAvx512;
+  return SimdLevel::kAvx2;
+#elif defined(DE_SIMD_NEON)
+  return SimdLevel::kNeon;
+#else
+  return SimdLevel::kScalar;
+#endif
+}
+
+std::atomic<SimdLevel> &CurrentLevel() {
+  static std::atomic<SimdLevel> level(DetectSimdLevel());
+  return level;
+}
+
+// Same rounding as Eigen::half: to nearest even, nan becomes 0x7e00 and out of range values become infinity
+uint16_t FloatToHalfScalar(float value) {
+  const uint32_t kF16Max = (127 + 16) << 23;
+  const uint32_t kF32Infinity = 255 << 23;
+  const uint32_t kMinNormal = (127 - 14) << 23;
+  const uint32_t kDenormMagic = ((127 - 15) + (23 - 10) + 1) << 23;
+  uint32_t bits;
+  (void)std::memcpy(&bits, &value, sizeof(bits));
+  uint32_t sign = bits & 0x80000000u;
+  bits ^= sign;
+  uint16_t half;
+  if (bits >= kF16Max) {
+    half = bits > kF32Infinity ? 0x7e00 : 0x7c00;
+  } else if (bits < kMinNormal) {
+    // Subnormal or zero, the float addition does the rounding
+    float magic;
+    float abs_value;
+    (void)std::memcpy(&magic, &kDenormMagic, sizeof(magic));
+    (void)std::memcpy(&abs_value, &bits, sizeof(abs_value));
+    abs_value += magic;
+    (void)std::memcpy(&bits, &abs_value, sizeof(bits));
+    half = static_cast<uint16_t>(bits - kDenormMagic);
+  } else {
+    uint32_t mantissa_odd = (bits >> 13) & 1;
+    bits += (static_cast<uint32_t>(15 - 127) << 23) + 0xfff;
+    bits += mantissa_odd;
+    half = static_cast<uint16_t>(bits >> 13);
+  }
+  return half | static_cast<uint16_t>(sign >> 16);
+}
+
+inline void StoreScalar(float value, float *out) { *out = value; }
+
+inline void StoreScalar(float value, uint16_t *out) { *out = FloatToHalfScalar(value); }
+
+template <typename T>
+void ScaleShiftChannelsScalar(const T *in, float *out, int64_t num_pixels, int32_t num_channels, const float *scale,
+                              const float *shift) {
+  for (int64_t i = 0; i < num_pixels; ++i) {
+    for (int32_t c = 0; c < num_channels; ++c) {
+      out[c] = static_cast<float>(in[c]) * scale[c] + shift[c];
+    }
+    in += num_channels;
+    out += num_channels;
+  }
+}
+
+template <typename T, typename U>
+void ScaleShiftToPlanarScalar(const T *in, U *out, int64_t begin, int64_t num_pixels, int32_t num_channels,
+                              int64_t plane_stride, const float *scale, const float *shift) {
+  for (int64_t p = begin; p < num_pixels; ++p) {
+    for (int32_t c = 0; c < num_channels; ++c) {
+      StoreScalar(static_cast<float>(in[p * num_channels + c]) * scale[c] + shift[c], out + c * plane_stride + p);
+    }
+  }
+}
+
+template <int32_t N>
+void InterleavedToPlanarScalar(const uint8_t *in, uint8_t *out, int64_t begin, int64_t num_pixels,
+                               int32_t num_channels) {
+  for (int32_t c = 0; c < num_channels; ++c) {
+    uint8_t *plane = out + c * num_pixels * N;
+    for (int64_t p = begin; p < num_pixels; ++p) {
+      (void)std::memcpy(plane + p * N, in + (p * num_channels + c) * N, N);
+    }
+  }
+}
+
+template <int32_t N>
+void FlipRowScalar(const uint8_t *in, uint8_t *out, int64_t begin, int64_t width) {
+  for (int64_t x = begin; x < width; ++x) {
+    (void)std::memcpy(out + (width - 1 - x) * N, in + x * N, N);
+  }
+}
+
+void FlipRowScalar(const uint8_t *in, uint8_t *out, int64_t begin, int64_t width, int32_t pixel_size) {
+  switch (pixel_size) {
+    case 1:
+      return FlipRowScalar<1>(in, out, begin, width);
+    case 2:
+      return FlipRowScalar<2>(in, out, begin, width);
+    case 3:
+      return FlipRowScalar<3>(in, out, begin, width);
+    case 4:
+      return FlipRowScalar<4>(in, out, begin, width);
+    case 8:
+      return FlipRowScalar<8>(in, out, begin, width);
+    case 12:
+      return FlipRowScalar<12>(in, out, begin, width);
+    default:
+      for (int64_t x = begin; x < width; ++x) {
+        (void)std::memcpy(out + (width - 1 - x) * pixel_size, in + x * pixel_size, pixel_size);
+      }
+  }
+}
+
+#if defined(DE_SIMD_X86)
+// pshufb masks moving the bytes of 16 pixels of 3 channels between 3 interleaved blocks and 3 planes,
+// -1 entries give zero bytes
+struct ShuffleMasks {
+  // deinterleave[c][b]: bytes of block b going to plane c
+  int8_t deinterleave[3][3][16];
+  // interleave[b][c]: bytes of plane c going to block b
+  int8_t interleave[3][3][16];
+};
+
+ShuffleMasks MakeShuffleMasks() {
+  ShuffleMasks masks;
+  (void)std::fill(&masks.deinterleave[0][0][0], &masks.deinterleave[0][0][0] + sizeof(masks.deinterleave), -1);
+  (void)std::fill(&masks.interleave[0][0][0], &masks.interleave[0][0][0] + sizeof(masks.interleave), -1);
+  for (int32_t s = 0; s < 3 * kBlockPixels; ++s) {
+    int32_t pixel = s / 3;
+    int32_t channel = s % 3;
+    int32_t block = s / 16;
+    int32_t byte = s % 16;
+    masks.deinterleave[channel][block][pixel] = static_cast<int8_t>(byte);
+    masks.interleave[block][channel][byte] = static_cast<int8_t>(pixel);
+  }
+  return masks;
+}
+
+const ShuffleMasks &GetShuffleMasks() {
+  static const ShuffleMasks masks = MakeShuffleMasks();
+  return masks;
+}
+
+DE_TARGET_AVX2 inline void LoadMasks(const int8_t (*src)[3][16], __m128i (*dst)[3]) {
+  for (int32_t i = 0; i < 3; ++i) {
+    for (int32_t j = 0; j < 3; ++j) {
+      dst[i][j] = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src[i][j]));
+    }
+  }
+}
+
+DE_TARGET_AVX2 inline void Shuffle3(const __m128i *in, const __m128i (*masks)[3], __m128i *out) {
+  for (int32_t i = 0; i < 3; ++i) {
+    out[i] = _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(in[0], masks[i][0]), _mm_shuffle_epi8(in[1], masks[i][1])),
+                          _mm_shuffle_epi8(in[2], masks[i][2]));
+  }
+}
+
+DE_TARGET_AVX2 inline void Deinterleave3(const uint8_t *in, const __m128i (*masks)[3], __m128i *planes) {
+  __m128i blocks[3];
+  for (int32_t b = 0; b < 3; ++b) {
+    blocks[b] = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + b * 16));
+  }
+  Shuffle3(blocks, masks, planes);
+}
+
+DE_TARGET_AVX2 inline void Load16Avx2(const uint8_t *in, __m256 *lo, __m256 *hi) {
+  __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in));
+  *lo = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(bytes));
+  *hi = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_srli_si128(bytes, 8)));
+}
+
+DE_TARGET_AVX2 inline void Load16Avx2(const float *in, __m256 *lo, __m256 *hi) {
+  *lo = _mm256_loadu_ps(in);
+  *hi = _mm256_loadu_ps(in + 8);
+}
+
+DE_TARGET_AVX2 inline void Store8Avx2(__m256 value, float *out) { _mm256_storeu_ps(out, value); }
+
+DE_TARGET_AVX2 inline void Store8Avx2(__m256 value, uint16_t *out) {
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(out), _mm256_cvtps_ph(value, _MM_FROUND_TO_NEAREST_INT));
+}
+
+DE_TARGET_AVX512 inline __m512 Load16Avx512(const uint8_t *in) {
+  return _mm512_cvtepi32_ps(_mm512_cvtepu8_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(in))));
+}
+
+DE_TARGET_AVX512 inline __m512 Load16Avx512(const float *in) { return _mm512_loadu_ps(in); }
+
+DE_TARGET_AVX512 inline void Store16Avx512(__m512 value, float *out) { _mm512_storeu_ps(out, value); }
+
+DE_TARGET_AVX512 inline void Store16Avx512(__m512 value, uint16_t *out) {
+  _mm256_storeu_si256(reinterpret_cast<__m256i *>(out), _mm512_cvtps_ph(value, _MM_FROUND_TO_NEAREST_INT));
+}
+
+// The vector loops below return the number of values or pixels they did, the scalar code does the rest
+template <typename T>
+DE_TARGET_AVX2 int64_t ScaleShiftChannelsAvx2(const T *in, float *out, int64_t count, const float *scale,
+                                              const float *shift) {
+  int64_t i = 0;
+  for (; i + kPatternLen <= count; i += kPatternLen) {
+    for (int32_t j = 0; j < kPatternLen; j += 16) {
+      __m256 lo;
+      __m256 hi;
+      Load16Avx2(in + i + j, &lo, &hi);
+      lo = _mm256_fmadd_ps(lo, _mm256_loadu_ps(scale + j), _mm256_loadu_ps(shift + j));
+      hi = _mm256_fmadd_ps(hi, _mm256_loadu_ps(scale + j + 8), _mm256_loadu_ps(shift + j + 8));
+      Store8Avx2(lo, out + i + j);
+      Store8Avx2(hi, out + i + j + 8);
+    }
+  }
+  return i;
+}
+
+template <typename T>
+DE_TARGET_AVX512 int64_t ScaleShiftChannelsAvx512(const T *in, float *out, int64_t count, const float *scale,
+                                                  const float *shift) {
+  int64_t i = 0;
+  for (; i + kPatternLen <= count; i += kPatternLen) {
+    for (int32_t j = 0; j < kPatternLen; j += 16) {
+      __m512 value = Load16Avx512(in + i + j);
+      value = _mm512_fmadd_ps(value, _mm512_loadu_ps(scale + j), _mm512_loadu_ps(shift + j));
+      Store16Avx512(value, out + i + j);
+    }
+  }
+  return i;
+}
+
+template <typename U>
+DE_TARGET_AVX2 int64_t ScaleShiftToPlanarAvx2(const uint8_t *in, U *out, int64_t num_pixels, int64_t plane_stride,
+                                              const float *scale, const float *shift) {
+  __m128i masks[3][3];
+  LoadMasks(GetShuffleMasks().deinterleave, masks);
+  __m256 scales[3];
+  __m256 shifts[3];
+  for (int32_t c = 0; c < 3; ++c) {
+    scales[c] = _mm256_set1_ps(scale[c]);
+    shifts[c] = _mm256_set1_ps(shift[c]);
+  }
+  int64_t p = 0;
+  for (; p + kBlockPixels <= num_pixels; p += kBlockPixels) {
+    __m128i planes[3];
+    Deinterleave3(in + p * 3, masks, planes);
+    for (int32_t c = 0; c < 3; ++c) {
+      __m256 lo = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(planes[c]));
+      __m256 hi = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_srli_si128(planes[c], 8)));
+      Store8Avx2(_mm256_fmadd_ps(lo, scales[c], shifts[c]), out + c * plane_stride + p);
+      Store8Avx2(_mm256_fmadd_ps(hi, scales[c], shifts[c]), out + c * plane_stride + p + 8);
+    }
+  }
+  return p;
+}
+
+template <typename U>
+DE_TARGET_AVX512 int64_t ScaleShiftToPlanarAvx512(const uint8_t *in, U *out, int64_t num_pixels,
+                                                  int64_t plane_stride, const float *scale, const float *shift) {
+  __m128i masks[3][3];
+  LoadMasks(GetShuffleMasks().deinterleave, masks);
+  __m512 scales[3];
+  __m512 shifts[3];
+  for (int32_t c = 0; c < 3; ++c) {
+    scales[c] = _mm512_set1_ps(scale[c]);
+    shifts[c] = _mm512_set1_ps(shift[c]);
+  }
+  int64_t p = 0;
+  for (; p + kBlockPixels <= num_pixels; p += kBlockPixels) {
+    __m128i planes[3];
+    Deinterleave3(in + p * 3, masks, planes);
+    for (int32_t c = 0; c < 3; ++c) {
+      __m512 value = _mm512_cvtepi32_ps(_mm512_cvtepu8_epi32(planes[c]));
+      Store16Avx512(_mm512_fmadd_ps(value, scales[c], shifts[c]), out + c * plane_stride + p);
+    }
+  }
+  return p;
+}
+
+DE_TARGET_AVX2 int64_t FloatToHalfAvx2(const float *in, uint16_t *out, int64_t count) {
+  int64_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    Store8Avx2(_mm256_loadu_ps(in + i), out + i);
+  }
+  return i;
+}
+
+DE_TARGET_AVX512 int64_t FloatToHalfAvx512(const float *in, uint16_t *out, int64_t count) {
+  int64_t i = 0;
+  for (; i + 16 <= count; i += 16) {
+    Store16Avx512(_mm512_loadu_ps(in + i), out + i);
+  }
+  return i;
+}
+
+DE_TARGET_AVX2 int64_t InterleavedToPlanarAvx2(const uint8_t *in, uint8_t *out, int64_t num_pixels) {
+  __m128i masks[3][3];
+  LoadMasks(GetShuffleMasks().deinterleave, masks);
+  int64_t p = 0;
+  for (; p + kBlockPixels <= num_pixels; p += kBlockPixels) {
+    __m128i planes[3];
+    Deinterleave3(in + p * 3, masks, planes);
+    for (int32_t c = 0; c < 3; ++c) {
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(out + c * num_pixels + p), planes[c]);
+    }
+  }
+  return p;
+}
+
+DE_TARGET_AVX2 bool FlipHorizontalAvx2(const uint8_t *in, uint8_t *out, int64_t height, int64_t width,
+                                       int32_t pixel_size) {
+  if (pixel_size != 1 && pixel_size != 3 && pixel_size != 4) {
+    return false;
+  }
+  const __m128i reverse = _mm_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+  __m128i deinterleave[3][3];
+  __m128i interleave[3][3];
+  LoadMasks(GetShuffleMasks().deinterleave, deinterleave);
+  LoadMasks(GetShuffleMasks().interleave, interleave);
+  // Pixels per vector step
+  int64_t step = pixel_size == 4 ? 4 : 16;
+  for (int64_t y = 0; y < height; ++y) {
+    const uint8_t *in_row = in + y * width * pixel_size;
+    uint8_t *out_row = out + y * width * pixel_size;
+    int64_t x = 0;
+    for (; x + step <= width; x += step) {
+      uint8_t *dst = out_row + (width - x - step) * pixel_size;
+      if (pixel_size == 1) {
+        __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in_row + x));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst), _mm_shuffle_epi8(value, reverse));
+      } else if (pixel_size == 4) {
+        __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in_row + x * 4));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst), _mm_shuffle_epi32(value, _MM_SHUFFLE(0, 1, 2, 3)));
+      } else {
+        __m128i planes[3];
+        __m128i blocks[3];
+        Deinterleave3(in_row + x * 3, deinterleave, planes);
+        for (int32_t c = 0; c < 3; ++c) {
+          planes[c] = _mm_shuffle_epi8(planes[c], reverse);
+        }
+        Shuffle3(planes, interleave, blocks);
+        for (int32_t b = 0; b < 3; ++b) {
+          _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + b * 16), blocks[b]);
+        }
+      }
+    }
+    FlipRowScalar(in_row, out_row, x, width, pixel_size);
+  }
+  return true;
+}
+#endif
+
+#if defined(DE_SIMD_NEON)
+inline void Widen16Neon(uint8x16_t bytes, float32x4_t *values) {
+  uint16x8_t lo = vmovl_u8(vget_low_u8(bytes));
+  uint16x8_t hi = vmovl_u8(vget_high_u8(bytes));
+  values[0] = vcvtq_f32_u32(vmovl_u16(vget_low_u16(lo)));
+  values[1] = vcvtq_f32_u32(vmovl_u16(vget_high_u16(lo)));
+  values[2] = vcvtq_f32_u32(vmovl_u16(vget_low_u16(hi)));
+  values[3] = vcvtq_f32_u32(vmovl_u16(vget_high_u16(hi)));
+}
+
+inline void Load16Neon(const uint8_t *in, float32x4_t *values) { Widen16Neon(vld1q_u8(in), values); }
+
+inline void Load16Neon(const float *in, float32x4_t *values) {
+  for (int32_t k = 0; k < 4; ++k) {
+    values[k] = vld1q_f32(in + k * 4);
+  }
+}
+
+inline void Store4Neon(float32x4_t value, float *out) { vst1q_f32(out, value); }
+
+inline void Store4Neon(float32x4_t value, uint16_t *out) { vst1_u16(out, vreinterpret_u16_f16(vcvt_f16_f32(value))); }
+
+inline uint8x16_t Reverse16Neon(uint8x16_t value) {
+  uint8x16_t reversed = vrev64q_u8(value);
+  return vextq_u8(reversed, reversed, 8);
+}
+
+template <typename T>
+int64_t ScaleShiftChannelsNeon(const T *in, float *out, int64_t count, const float *scale, const float *shift) {
+  int64_t i = 0;
+  for (; i + kPatternLen <= count; i += kPatternLen) {
+    for (int32_t j = 0; j < kPatternLen; j += 16) {
+      float32x4_t values[4];
+      Load16Neon(in + i + j, values);
+      for (int32_t k = 0; k < 4; ++k) {
+        float32x4_t value = vfmaq_f32(vld1q_f32(shift + j + k * 4), values[k], vld1q_f32(scale + j + k * 4));
+        Store4Neon(value, out + i + j + k * 4);
+      }
+    }
+  }
+  return i;
+}
+
+template <typename U>
+int64_t ScaleShiftToPlanarNeon(const uint8_t *in, U *out, int64_t num_pixels, int64_t plane_stride,
+                               const float *scale, const float *shift) {
+  int64_t p = 0;
+  for (; p + kBlockPixels <= num_pixels; p += kBlockPixels) {
+    uint8x16x3_t planes = vld3q_u8(in + p * 3);
+    for (int32_t c = 0; c < 3; ++c) {
+      float32x4_t values[4];
+      Widen16Neon(planes.val[c], values);
+      for (int32_t k = 0; k < 4; ++k) {
+        float32x4_t value = vfmaq_f32(vdupq_n_f32(shift[c]), values[k], vdupq_n_f32(scale[c]));
+        Store4Neon(value, out + c * plane_stride + p + k * 4);
+      }
+    }
+  }
+  return p;
+}
+
+int64_t FloatToHalfNeon(const float *in, uint16_t *out, int64_t count) {
+  int64_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    Store4Neon(vld1q_f32(in + i), out + i);
+  }
+  return i;
+}
+
+int64_t InterleavedToPlanarNeon(const uint8_t *in, uint8_t *out, int64_t num_pixels) {
+  int64_t p = 0;
+  for (; p + kBlockPixels <= num_pixels; p += kBlockPixels) {
+    uint8x16x3_t planes = vld3q_u8(in + p * 3);
+    for (int32_t c = 0; c < 3; ++c) {
+      vst1q_u8(out + c * num_pixels + p, planes.val[c]);
+    }
+  }
+  return p;
+}
+
+bool FlipHorizontalNeon(const uint8_t *in, uint8_t *out, int64_t height, int64_t width, int32_t pixel_size) {
+  if (pixel_size != 1 && pixel_size != 3 && pixel_size != 4) {
+    return false;
+  }
+  int64_t step = pixel_size == 4 ? 4 : 16;
+  for (int64_t y = 0; y < height; ++y) {
+    const uint8_t *in_row = in + y * width * pixel_size;
+    uint8_t *out_row = out + y * width * pixel_size;
+    int64_t x = 0;
+    for (; x + step <= width; x += step) {
+      uint8_t *dst = out_row + (width - x - step) * pixel_size;
+      if (pixel_size == 1) {
+        vst1q_u8(dst, Reverse16Neon(vld1q_u8(in_row + x)));
+      } else if (pixel_size == 4) {
+        uint32x4_t reversed = vrev64q_u32(vreinterpretq_u32_u8(vld1q_u8(in_row + x * 4)));
+        vst1q_u8(dst, vreinterpretq_u8_u32(vextq_u32(reversed, reversed, 2)));
+      } else {
+        uint8x16x3_t planes = vld3q_u8(in_row + x * 3);
+        for (int32_t c = 0; c < 3; ++c) {
+          planes.val[c] = Reverse16Neon(planes.val[c]);
+        }
+        vst3q_u8(dst, planes);
+      }
+    }
+    FlipRowScalar(in_row, out_row, x, width, pixel_size);
+  }
+  return true;
+}
+#endif
+
+template <typename T>
+void ScaleShiftChannelsImpl(const T *in, float *out, int64_t num_pixels, int32_t num_channels, const float *scale,
+                            const float *shift) {
+  int64_t done = 0;
+  SimdLevel level = GetSimdLevel();
+  if (level != SimdLevel::kScalar && num_channels > 0 && kPatternLen % num_channels == 0) {
+    // Vectors start on a pixel boundary, so the per channel values repeat every kPatternLen values
+    float scale_pattern[kPatternLen];
+    float shift_pattern[kPatternLen];
+    for (int32_t i = 0; i < kPatternLen; ++i) {
+      scale_pattern[i] = scale[i % num_channels];
+      shift_pattern[i] = shift[i % num_channels];
+    }
+    int64_t count = num_pixels * num_channels;
+#if defined(DE_SIMD_X86)
+    if (level == SimdLevel::kAvx512) {
+      done = ScaleShiftChannelsAvx512(in, out, count, scale_pattern, shift_pattern);
+    } else if (level == SimdLevel::kAvx2) {
+      done = ScaleShiftChannelsAvx2(in, out, count, scale_pattern, shift_pattern);
+    }
+#elif defined(DE_SIMD_NEON)
+    done = ScaleShiftChannelsNeon(in, out, count, scale_pattern, shift_pattern);
+#endif
+    done /= num_channels;
+  }
+  ScaleShiftChannelsScalar(in + done * num_channels, out + done * num_channels, num_pixels - done, num_channels, scale,
+                           shift);
+}
+
+// Only uint8 images of 3 channels have a vector transpose
+template <typename U>
+int64_t ScaleShiftToPlanarVector(const uint8_t *in, U *out, int64_t num_pixels, int32_t num_channels,
+                                 int64_t plane_stride, const float *scale, const float *shift) {
+  if (num_channels != 3) {
+    return 0;
+  }
+  SimdLevel level = GetSimdLevel();
+#if defined(DE_SIMD_X86)
+  if (level == SimdLevel::kAvx512) {
+    return ScaleShiftToPlanarAvx512(in, out, num_pixels, plane_stride, scale, shift);
+  } else if (level == SimdLevel::kAvx2) {
+    return ScaleShiftToPlanarAvx2(in, out, num_pixels, plane_stride, scale, shift);
+  }
+#elif defined(DE_SIMD_NEON)
+  if (level == SimdLevel::kNeon) {
+    return ScaleShiftToPlanarNeon(in, out, num_pixels, plane_stride, scale, shift);
+  }
+#endif
+  return 0;
+}
+
+template <typename U>
+int64_t ScaleShiftToPlanarVector(const float *in, U *out, int64_t num_pixels, int32_t num_channels,
+                                 int64_t plane_stride, const float *scale, const float *shift) {
+  return 0;
+}
+
+template <typename T, typename U>
+void ScaleShiftToPlanarImpl(const T *in, U *out, int64_t num_pixels, int32_t num_channels, int64_t plane_stride,
+                            const float *scale, const float *shift) {
+  int64_t done = ScaleShiftToPlanarVector(in, out, num_pixels, num_channels, plane_stride, scale, shift);
+  ScaleShiftToPlanarScalar(in, out, done, num_pixels, num_channels, plane_stride, scale, shift);
+}
+}  // namespace
+
+SimdLevel GetSimdLevel() { return CurrentLevel().load(std::memory_order_relaxed); }
+
+void SetSimdLevel(SimdLevel level) {
+  CurrentLevel().store(std::min(level, DetectSimdLevel()), std::memory_order_relaxed);
+}
+
+void ScaleShiftChannels(const uint8_t *in, float *out, int64_t num_pixels, int32_t num_channels, const float *scale,
+                        const float *shift) {
+  ScaleShiftChannelsImpl(in, out, num_pixels, num_channels, scale, shift);
+}
+
+void ScaleShiftChannels(const float *in, float *out, int64_t num_pixels, int32_t num_channels, const float *scale,
+                        const float *shift) {
+  ScaleShiftChannelsImpl(in, out, num_pixels, num_channels, scale, shift);
+}
+
+void ScaleShiftToPlanar(const uint8_t *in, float *out, int64_t num_pixels, int32_t num_channels,
+                        int64_t plane_stride, const float *scale, const float *shift) {
+  ScaleShiftToPlanarImpl(in, out, num_pixels, num_channels, plane_stride, scale, shift);
+}
+
+void ScaleShiftToPlanar(const float *in, float *out, int64_t num_pixels, int32_t num_channels,
+                        int64_t plane_stride, const float *scale, const float *shift) {
+  ScaleShiftToPlanarImpl(in, out, num_pixels, num_channels, plane_stride, scale, shift);
+}
+
+void ScaleShiftToPlanar(const uint8_t *in, uint16_t *out, int64_t num_pixels, int32_t num_channels,
+                        int64_t plane_stride, const float *scale, const float *shift) {
+  ScaleShiftToPlanarImpl(in, out, num_pixels, num_channels, plane_stride, scale, shift);
+}
+
+void ScaleShiftToPlanar(const float *in, uint16_t *out, int64_t num_pixels, int32_t num_channels,
+                        int64_t plane_stride, const float *scale, const float *shift) {
+  ScaleShiftToPlanarImpl(in, out, num_pixels, num_channels, plane_stride, scale, shift);
+}
+
+void FloatToHalf(const float *in, uint16_t *out, int64_t count) {
+  int64_t done = 0;
+  SimdLevel level = GetSimdLevel();
+#if defined(DE_SIMD_X86)
+  if (level == SimdLevel::kAvx512) {
+    done = FloatToHalfAvx512(in, out, count);
+  } else if (level == SimdLevel::kAvx2) {
+    done = FloatToHalfAvx2(in, out, count);
+  }
+#elif defined(DE_SIMD_NEON)
+  if (level == SimdLevel::kNeon) {
+    done = FloatToHalfNeon(in, out, count);
+  }
+#endif
+  for (int64_t i = done; i < count; ++i) {
+    out[i] = FloatToHalfScalar(in[i]);
+  }
+}
+
+void InterleavedToPlanar(const uint8_t *in, uint8_t *out, int64_t num_pixels, int32_t num_channels,
+                         int32_t elem_size) {
+  int64_t done = 0;
+  if (elem_size == 1 && num_channels == 3) {
+    SimdLevel level = GetSimdLevel();
+#if defined(DE_SIMD_X86)
+    if (level >= SimdLevel::kAvx2) {
+      done = InterleavedToPlanarAvx2(in, out, num_pixels);
+    }
+#elif defined(DE_SIMD_NEON)
+    if (level == SimdLevel::kNeon) {
+      done = InterleavedToPlanarNeon(in, out, num_pixels);
+    }
+#endif
+  }
+  switch (elem_size) {
+    case 1:
+      return InterleavedToPlanarScalar<1>(in, out, done, num_pixels, num_channels);
+    case 2:
+      return InterleavedToPlanarScalar<2>(in, out, done, num_pixels, num_channels);
+    case 4:
+      return InterleavedToPlanarScalar<4>(in, out, done, num_pixels, num_channels);
+    case 8:
+      return InterleavedToPlanarScalar<8>(in, out, done, num_pixels, num_channels);
+    default:
+      for (int32_t c = 0; c < num_channels; ++c) {
+        for (int64_t p = 0; p < num_pixels; ++p) {
+          (void)std::memcpy(out + (c * num_pixels + p) * elem_size, in + (p * num_channels + c) * elem_size,
+                            elem_size);
+        }
+      }
+  }
+}
+
+void FlipHorizontal(const uint8_t *in, uint8_t *out, int64_t height, int64_t width, int32_t pixel_size) {
+  SimdLevel level = GetSimdLevel();
+#if defined(DE_SIMD_X86)
+  if (level >= SimdLevel::kAvx2 && FlipHorizontalAvx2(in, out, height, width, pixel_size)) {
+    return;
+  }
+#elif defined(DE_SIMD_NEON)
+  if (level == SimdLevel::kNeon && FlipHorizontalNeon(in, out, height, width, pixel_size)) {
+    return;
+  }
+#endif
+  for (int64_t y = 0; y < height; ++y) {
+    FlipRowScalar(in + y * width * pixel_size, out + y * width * pixel_size, 0, width, pixel_size);
+  }
+}
+
+void FlipVertical(const uint8_t *in, uint8_t *out, int64_t height, int64_t width, int32_t pixel_size) {
+  // Whole rows move, memcpy is as fast as it gets
+  int64_t row_size = width * pixel_size;
+  for (int64_t y = 0; y < height; ++y) {
+    (void)std::memcpy(out + (height - 1 - y) * row_size, in + y * row_size, row_size);
+  }
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,74 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef DATASET_KERNELS_SIMD_KERNELS_H_
+#define DATASET_KERNELS_SIMD_KERNELS_H_
+
+#include <cstdint>
+
+namespace mindspore {
+namespace dataset {
+// Vectorized loops over raw image buffers, shared by the image and data ops.
+// Every kernel has a scalar version, the vector versions are picked at runtime from the instruction sets of the cpu.
+// The vector versions use fused multiply-add, their results may differ from the scalar ones in the last bit.
+enum class SimdLevel { kScalar = 0, kNeon = 1, kAvx2 = 2, kAvx512 = 3 };
+
+// Returns the instruction set the kernels run with
+SimdLevel GetSimdLevel();
+
+// Limits the kernels to the given instruction set, so that the vector code can be compared to the scalar code
+// @param level: requested instruction set, capped to the best one supported by the cpu
+void SetSimdLevel(SimdLevel level);
+
+// Per channel transform out = in * scale[c] + shift[c] of interleaved <..., C> data
+// @param in: num_pixels * num_channels values, the float version may work in place with in == out
+// @param out: num_pixels * num_channels floats, in the same layout
+// @param scale, shift: num_channels values
+void ScaleShiftChannels(const uint8_t *in, float *out, int64_t num_pixels, int32_t num_channels, const float *scale,
+                        const float *shift);
+void ScaleShiftChannels(const float *in, float *out, int64_t num_pixels, int32_t num_channels, const float *scale,
+                        const float *shift);
+
+// Same transform fused with the <H,W,C> to <C,H,W> transpose. The uint16_t versions write the result as float16 bits.
+// @param out: num_channels planes, each receiving num_pixels values
+// @param plane_stride: distance between the planes in values, num_pixels for a whole image, the image size when
+//     writing a single row
+void ScaleShiftToPlanar(const uint8_t *in, float *out, int64_t num_pixels, int32_t num_channels,
+                        int64_t plane_stride, const float *scale, const float *shift);
+void ScaleShiftToPlanar(const float *in, float *out, int64_t num_pixels, int32_t num_channels,
+                        int64_t plane_stride, const float *scale, const float *shift);
+void ScaleShiftToPlanar(const uint8_t *in, uint16_t *out, int64_t num_pixels, int32_t num_channels,
+                        int64_t plane_stride, const float *scale, const float *shift);
+void ScaleShiftToPlanar(const float *in, uint16_t *out, int64_t num_pixels, int32_t num_channels,
+                        int64_t plane_stride, const float *scale, const float *shift);
+
+// Converts floats to float16 bits, rounding to nearest even like Eigen::half
+void FloatToHalf(const float *in, uint16_t *out, int64_t count);
+
+// Transposes num_pixels pixels of num_channels elements into num_channels planes
+// @param elem_size: size of an element in bytes
+void InterleavedToPlanar(const uint8_t *in, uint8_t *out, int64_t num_pixels, int32_t num_channels,
+                         int32_t elem_size);
+
+// Mirrors an image around its vertical axis, in and out must not overlap
+// @param pixel_size: size of a pixel in bytes, all channels included
+void FlipHorizontal(const uint8_t *in, uint8_t *out, int64_t height, int64_t width, int32_t pixel_size);
+
+// Mirrors an image around its horizontal axis, in and out must not overlap
+void FlipVertical(const uint8_t *in, uint8_t *out, int64_t height, int64_t width, int32_t pixel_size);
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // DATASET_KERNELS_SIMD_KERNELS_H_
@@ -49,6 +49,30 @@ Status TensorOp::Compute(const std::vector<std::shared_ptr<Tensor>> &input,
                 "Is this TensorOp oneToOne? If no, please implement this Compute() in the derived class.");
 }
 
+// Name: ComputeBatch()
+// Description: By default the rows of the batch are computed one by one.
+Status TensorOp::ComputeBatch(const TensorRow &input, TensorRow *output) {
+  IO_CHECK_VECTOR(input, output);
+  if (!OneToOne()) {
+    return Status(StatusCode::kUnexpectedError, "Wrong ComputeBatch() function is called. This is not 1-1 TensorOp.");
+  }
+  output->resize(input.size());
+  for (size_t i = 0; i < input.size(); ++i) {
+    RETURN_IF_NOT_OK(Compute(input[i], &(*output)[i]));
+  }
+  return Status::OK();
+}
+
+// Name: ComputeInPlace()
+// Description: By default a TensorOp can't work in place, MapOp falls back on Compute().
+Status TensorOp::ComputeInPlace(const std::shared_ptr<Tensor> &tensor, bool *done) {
+  if (done == nullptr) {
+    return Status(StatusCode::kUnexpectedError, "done is null");
+  }
+  *done = false;
+  return Status::OK();
+}
+
 void TensorOp::Print(std::ostream &out) const { out << "TensorOp" << std::endl; }
 
 Status TensorOp::OutputShape(const std::vector<TensorShape> &inputs, std::vector<TensorShape> &outputs) {
@@ -70,6 +70,23 @@ class TensorOp {
   // @return Status
   virtual Status Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output);
 
+  // Perform the operation of a 1-1 TensorOp in place, the output overwrites the input.
+  // MapOp calls this instead of Compute() when it holds the only reference to the input, so that element-wise ops
+  // don't allocate a new Tensor for their output.
+  // @param tensor the input Tensor, holding the output when done
+  // @param done set to false if the op can't work in place on this input, the Tensor is then left unchanged and
+  //     Compute() is called instead.
+  // @return Status
+  virtual Status ComputeInPlace(const std::shared_ptr<Tensor> &tensor, bool *done);
+
+  // Perform a 1-1 operation on a whole column of a DataBuffer, one Tensor per row.
+  // MapOp calls this with all the rows of a buffer when every op of the map is 1-1, ops overriding it can check their
+  // arguments, build their tables and pick their typed kernel once per batch instead of once per row.
+  // @param input the Tensors of the column, one per row.
+  // @param output the address to an empty TensorRow, receiving one Tensor per row in the same order.
+  // @return Status
+  virtual Status ComputeBatch(const TensorRow &input, TensorRow *output);
+
   // Perform an operation on Tensors from multiple columns, and produce multiple Tensors.
   // This is for m-to-n column MapOp.
   // @param input is a vector of shared_ptr to Tensor (pass by const reference).
@@ -0,0 +1,104 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "dataset/kernels/tensor_op_fusion.h"
+
+#include <typeinfo>
+#include <utility>
+
+#include "dataset/kernels/data/to_float16_op.h"
+#include "dataset/kernels/data/type_cast_op.h"
+#include "dataset/kernels/image/decode_op.h"
+#include "dataset/kernels/image/hwc_to_chw_op.h"
+#include "dataset/kernels/image/normalize_hwc_to_chw_op.h"
+#include "dataset/kernels/image/normalize_op.h"
+#include "dataset/kernels/image/random_crop_and_resize_op.h"
+#include "dataset/kernels/image/random_crop_decode_resize_op.h"
+#include "dataset/kernels/image/random_horizontal_flip_op.h"
+
+namespace mindspore {
+namespace dataset {
+namespace {
+using TensorOpList = std::vector<std::shared_ptr<TensorOp>>;
+
+// Returns the op if it is exactly of class T, a derived class may compute something else
+template <typename T>
+std::shared_ptr<T> OpAs(const std::shared_ptr<TensorOp> &op) {
+  if (op == nullptr || typeid(*op) != typeid(T)) {
+    return nullptr;
+  }
+  return std::static_pointer_cast<T>(op);
+}
+
+// Each Fuse function tries to fuse the chain starting at ops[begin], it returns the number of ops it replaced
+size_t FuseDecodeCrop(const TensorOpList &ops, size_t begin, TensorOpList *fused_ops) {
+  if (begin + 1 >= ops.size()) {
+    return 0;
+  }
+  auto decode = OpAs<DecodeOp>(ops[begin]);
+  auto crop = OpAs<RandomCropAndResizeOp>(ops[begin + 1]);
+  if (decode == nullptr || !decode->is_rgb_format() || crop == nullptr) {
+    return 0;
+  }
+  fused_ops->push_back(std::make_shared<RandomCropDecodeResizeOp>(*crop));
+  return 2;
+}
+
+size_t FuseNormalize(const TensorOpList &ops, size_t begin, TensorOpList *fused_ops) {
+  size_t end = begin;
+  auto flip = OpAs<RandomHorizontalFlipOp>(ops[end]);
+  if (flip != nullptr) {
+    end++;
+  }
+  if (end + 1 >= ops.size()) {
+    return 0;
+  }
+  auto normalize = OpAs<NormalizeOp>(ops[end]);
+  if (normalize == nullptr || OpAs<HwcToChwOp>(ops[end + 1]) == nullptr) {
+    return 0;
+  }
+  end += 2;
+  bool to_float16 = false;
+  if (end < ops.size()) {
+    auto cast = OpAs<TypeCastOp>(ops[end]);
+    to_float16 = OpAs<ToFloat16Op>(ops[end]) != nullptr || (cast != nullptr && cast->type() == DataType::DE_FLOAT16);
+    if (to_float16) {
+      end++;
+    }
+  }
+  TensorOpList chain(ops.begin() + begin, ops.begin() + end);
+  fused_ops->push_back(std::make_shared<NormalizeHwcToChwOp>(*normalize, flip, to_float16, std::move(chain)));
+  return end - begin;
+}
+}  // namespace
+
+std::vector<std::shared_ptr<TensorOp>> FuseTensorOps(const std::vector<std::shared_ptr<TensorOp>> &ops) {
+  TensorOpList fused_ops;
+  size_t i = 0;
+  while (i < ops.size()) {
+    size_t num_fused = FuseDecodeCrop(ops, i, &fused_ops);
+    if (num_fused == 0) {
+      num_fused = FuseNormalize(ops, i, &fused_ops);
+    }
+    if (num_fused == 0) {
+      fused_ops.push_back(ops[i]);
+      num_fused = 1;
+    }
+    i += num_fused;
+  }
+  return fused_ops;
+}
+}  // namespace dataset
+}  // namespace mindspore
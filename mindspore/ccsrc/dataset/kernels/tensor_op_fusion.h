@@ -0,0 +1,39 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef DATASET_KERNELS_TENSOR_OP_H_
+#ifndef DATASET_KERNELS_TENSOR_OP_FUSION_H_
+#define DATASET_KERNELS_TENSOR_OP_FUSION_H_
+
+#include <memory>
+#include <vector>
+
+#include "dataset/kernels/tensor_op.h"
+
+namespace mindspore {
+namespace dataset {
+// Fusion pass run by MapOp on its list of TensorOps. Each chain of ops below is replaced with a single op which
+// makes one pass over the image, so that the intermediate Tensors are never allocated:
+//   DecodeOp (RGB), RandomCropAndResizeOp -> RandomCropDecodeResizeOp, only the crop is decoded
+//   [RandomHorizontalFlipOp], NormalizeOp, HwcToChwOp, [ToFloat16Op or TypeCastOp to float16] -> NormalizeHwcToChwOp
+// The fused ops draw the same random numbers as the ops they replace. Their results match up to the rounding of the
+// vector kernels, and the decode of a JPEG crop may differ slightly from the crop of the whole decoded image.
+// @param ops The TensorOps applied one after the other.
+// @return The TensorOps to apply instead, ops that are not part of a chain are kept as is.
+std::vector<std::shared_ptr<TensorOp>> FuseTensorOps(const std::vector<std::shared_ptr<TensorOp>> &ops);
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // DATASET_KERNELS_TENSOR_OP_FUSION_H_
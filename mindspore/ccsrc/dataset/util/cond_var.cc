@@ -47,6 +47,25 @@ Status CondVar::Wait(std::unique_lock<std::mutex> *lck, const std::function<bool
   return Status::OK();
 }
 
+Status CondVar::WaitFor(std::unique_lock<std::mutex> *lck, std::chrono::milliseconds timeout,
+                        const std::function<bool()> &pred) {
+  auto f = [this, &pred]() -> bool { return (pred() || (CurState() == State::kInterrupted)); };
+  auto deadline = std::chrono::steady_clock::now() + timeout;
+  if (svc_) {
+    (void)cv_.wait_until(*lck, deadline, f);
+  } else {
+    // Without interrupt service, poll for the interrupt like interruptible_wait does
+    while (!f() && std::chrono::steady_clock::now() < deadline) {
+      RETURN_IF_INTERRUPTED();
+      (void)cv_.wait_for(*lck, std::chrono::milliseconds(1));
+    }
+  }
+  if (CurState() == State::kInterrupted) {
+    return Status(StatusCode::kInterrupted);
+  }
+  return Status::OK();
+}
+
 CondVar::~CondVar() noexcept {
   if (svc_ != nullptr) {
     (void)svc_->Deregister(my_name_);
@@ -16,6 +16,7 @@
 #ifndef DATASET_UTIL_COND_VAR_H_
 #define DATASET_UTIL_COND_VAR_H_
 
+#include <chrono>
 #include <condition_variable>
 #include <functional>
 #include <memory>
@@ -35,6 +36,10 @@ class CondVar : public IntrpResource {
 
   Status Wait(std::unique_lock<std::mutex> *lck, const std::function<bool()> &pred);
 
+  // Same as Wait, but also returns once the timeout has passed. The caller checks pred to tell the two apart.
+  Status WaitFor(std::unique_lock<std::mutex> *lck, std::chrono::milliseconds timeout,
+                 const std::function<bool()> &pred);
+
   Status Interrupt() override;
 
   void NotifyOne() noexcept;
@@ -0,0 +1,176 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "dataset/util/pinned_pool.h"
+#include <sys/mman.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+#include <utility>
+#include "./securec.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace dataset {
+constexpr uint64_t PinnedPool::kDefaultMaxCachedBytes;
+
+PinnedPool::PinnedPool(uint64_t max_cached_bytes)
+    : cached_bytes_(0), max_cached_bytes_(max_cached_bytes), lock_failed_(false) {}
+
+PinnedPool::~PinnedPool() {
+  std::unique_lock<std::mutex> lck(mux_);
+  for (auto &el : free_list_) {
+    Release(el.second.first, el.second.second);
+  }
+  free_list_.clear();
+  // Slabs still referenced by someone else are leaked on purpose rather than freed under their feet.
+  if (!in_use_.empty()) {
+    MS_LOG(WARNING) << in_use_.size() << " pinned slabs are still in use when the pool is destroyed.";
+  }
+}
+
+size_t PinnedPool::PageSize() {
+  static const size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  return page_size;
+}
+
+void PinnedPool::Release(void *p, const Slab &slab) {
+  if (slab.locked) {
+    (void)munlock(p, slab.size);
+  }
+  free(p);
+}
+
+Status PinnedPool::Allocate(size_t n, void **pp) {
+  if (pp == nullptr) {
+    RETURN_STATUS_UNEXPECTED("pp is null");
+  }
+  size_t page_size = PageSize();
+  size_t sz = ((std::max(n, static_cast<size_t>(1)) + page_size - 1) / page_size) * page_size;
+  std::unique_lock<std::mutex> lck(mux_);
+  auto it = free_list_.find(sz);
+  if (it != free_list_.end()) {
+    void *p = it->second.first;
+    Slab slab = it->second.second;
+    free_list_.erase(it);
+    cached_bytes_ -= sz;
+    slab.ref_count = 1;
+    in_use_[p] = slab;
+    *pp = p;
+    return Status::OK();
+  }
+  lck.unlock();
+
+  void *p = nullptr;
+  if (posix_memalign(&p, page_size, sz) != 0 || p == nullptr) {
+    return Status(StatusCode::kOutOfMemory, __LINE__, __FILE__);
+  }
+  Slab slab{sz, 1, false};
+  if (mlock(p, sz) == 0) {
+    slab.locked = true;
+  }
+
+  lck.lock();
+  if (!slab.locked && !lock_failed_) {
+    // Most likely RLIMIT_MEMLOCK. The slabs are still page aligned and shared, they are just not pinned.
+    lock_failed_ = true;
+    MS_LOG(INFO) << "Failed to lock pinned pool memory, errno " << errno << ". Falling back to pageable memory.";
+  }
+  in_use_[p] = slab;
+  *pp = p;
+  return Status::OK();
+}
+
+void PinnedPool::Deallocate(void *p) {
+  if (p == nullptr) {
+    return;
+  }
+  std::unique_lock<std::mutex> lck(mux_);
+  auto it = in_use_.find(p);
+  if (it == in_use_.end()) {
+    MS_LOG(ERROR) << "Address " << p << " is not a pinned slab in use.";
+    return;
+  }
+  if (--it->second.ref_count > 0) {
+    return;
+  }
+  Slab slab = it->second;
+  in_use_.erase(it);
+  if (cached_bytes_ + slab.size <= max_cached_bytes_) {
+    cached_bytes_ += slab.size;
+    (void)free_list_.emplace(slab.size, std::make_pair(p, slab));
+    return;
+  }
+  lck.unlock();
+  Release(p, slab);
+}
+
+Status PinnedPool::Reallocate(void **pp, size_t old_sz, size_t new_sz) {
+  if (pp == nullptr) {
+    RETURN_STATUS_UNEXPECTED("pp is null");
+  }
+  {
+    std::unique_lock<std::mutex> lck(mux_);
+    auto it = in_use_.find(*pp);
+    if (it == in_use_.end()) {
+      RETURN_STATUS_UNEXPECTED("Address is not a pinned slab in use.");
+    }
+    // Someone else sees this data, so it can't be moved.
+    if (it->second.ref_count > 1) {
+      RETURN_STATUS_UNEXPECTED("Can't reallocate a pinned slab that is shared.");
+    }
+    if (new_sz <= it->second.size) {
+      return Status::OK();
+    }
+  }
+  void *q = nullptr;
+  RETURN_IF_NOT_OK(Allocate(new_sz, &q));
+  if (old_sz > 0) {
+    errno_t err = memcpy_s(q, new_sz, *pp, old_sz);
+    if (err) {
+      Deallocate(q);
+      RETURN_STATUS_UNEXPECTED(std::to_string(err));
+    }
+  }
+  Deallocate(*pp);
+  *pp = q;
+  return Status::OK();
+}
+
+uint64_t PinnedPool::get_max_size() const { return std::numeric_limits<uint64_t>::max(); }
+
+Status PinnedPool::AddRef(void *p) {
+  std::unique_lock<std::mutex> lck(mux_);
+  auto it = in_use_.find(p);
+  if (it == in_use_.end()) {
+    RETURN_STATUS_UNEXPECTED("Address is not a pinned slab in use.");
+  }
+  it->second.ref_count++;
+  return Status::OK();
+}
+
+bool PinnedPool::Owns(const void *p) const {
+  std::unique_lock<std::mutex> lck(mux_);
+  return in_use_.find(p) != in_use_.end();
+}
+
+int32_t PinnedPool::ref_count(const void *p) const {
+  std::unique_lock<std::mutex> lck(mux_);
+  auto it = in_use_.find(p);
+  return (it == in_use_.end()) ? 0 : it->second.ref_count;
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,97 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef DATASET_UTIL_PINNED_POOL_H_
+#define DATASET_UTIL_PINNED_POOL_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include "dataset/util/memory_pool.h"
+#include "dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+// A MemoryPool of page aligned slabs that are locked into physical memory (mlock) when the system allows it, so a
+// device can DMA from them without a staging copy. Each slab carries a reference count: Allocate() returns a slab
+// with one reference, AddRef() takes another one and Deallocate() drops one. The slab is only recycled when the last
+// reference is dropped. This lets the data of a Tensor be handed over to a consumer such as a device queue while
+// the Tensor itself goes away.
+// Recycled slabs are kept in free lists by size up to a byte limit, because locking and unlocking memory are
+// system calls.
+class PinnedPool : public MemoryPool {
+ public:
+  // Default limit of the bytes kept in the free lists
+  static constexpr uint64_t kDefaultMaxCachedBytes = 256 * 1048576L;
+
+  // Constructor
+  // @param max_cached_bytes - The limit of the bytes kept in the free lists
+  explicit PinnedPool(uint64_t max_cached_bytes = kDefaultMaxCachedBytes);
+
+  // Destructor. Gives back all the slabs in the free lists.
+  ~PinnedPool() override;
+
+  // Allocate a slab of at least n bytes, rounded up to whole pages, with a reference count of 1.
+  Status Allocate(size_t n, void **pp) override;
+
+  // Drop one reference. The slab is recycled once no reference is left.
+  void Deallocate(void *p) override;
+
+  Status Reallocate(void **pp, size_t old_sz, size_t new_sz) override;
+
+  uint64_t get_max_size() const override;
+
+  int PercentFree() const override { return 100; }
+
+  // Take one more reference on a slab
+  // @param p - The start address of the slab
+  // @return Status - The error code return
+  Status AddRef(void *p);
+
+  // @param p - An address
+  // @return True if p is the start address of a slab in use from this pool
+  bool Owns(const void *p) const;
+
+  // @param p - The start address of the slab
+  // @return The reference count of the slab, 0 if it is not in use
+  int32_t ref_count(const void *p) const;
+
+  // @return The size of a page
+  static size_t PageSize();
+
+ private:
+  struct Slab {
+    size_t size;
+    int32_t ref_count;
+    bool locked;
+  };
+
+  // Give a slab back to the system
+  static void Release(void *p, const Slab &slab);
+
+  mutable std::mutex mux_;
+  std::unordered_map<const void *, Slab> in_use_;
+  std::multimap<size_t, std::pair<void *, Slab>> free_list_;
+  uint64_t cached_bytes_;
+  uint64_t max_cached_bytes_;
+  bool lock_failed_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // DATASET_UTIL_PINNED_POOL_H_
@@ -16,6 +16,7 @@
 #ifndef DATASET_UTIL_QUEUE_H_
 #define DATASET_UTIL_QUEUE_H_
 
+#include <algorithm>
 #include <atomic>
 #include <memory>
 #include <mutex>
@@ -30,6 +31,7 @@
 #include "dataset/util/allocator.h"
 #include "dataset/util/services.h"
 #include "dataset/util/cond_var.h"
+#include "dataset/util/ring_queue.h"
 #include "dataset/util/task_manager.h"
 
 namespace mindspore {
@@ -46,7 +48,9 @@ struct is_unique_ptr : public std::false_type {};
 template <typename T>
 struct is_unique_ptr<std::unique_ptr<T>> : public std::true_type {};
 
-// A simple thread safe queue using a fixed size array
+// A simple thread safe queue using a fixed size array.
+// If the queue is created with lock_free set to true, all operations are forwarded to a RingQueue which
+// does not take a mutex unless the caller has to block.
 template <typename T>
 class Queue {
  public:
@@ -57,6 +61,9 @@ class Queue {
   using const_reference = const T &;
 
   void Init() {
+    if (ring_ != nullptr) {
+      return;
+    }
     if (sz_ > 0) {
       // We allocate a block of memory and then call the default constructor for each slot. Maybe simpler to call
       // new[] but we want to control where the memory is allocated from.
@@ -78,6 +85,21 @@ class Queue {
     MS_LOG(DEBUG) << "Create Q with uuid " << my_name_ << " of size " << sz_ << ".";
   }
 
+  Queue(int sz, bool lock_free)
+      : sz_(sz),
+        arr_(nullptr),
+        head_(0),
+        tail_(0),
+        my_name_(std::move(Services::GetUniqueID())),
+        alloc_(Services::GetInstance().GetServiceMemPool()) {
+    if (lock_free) {
+      ring_ = std::make_unique<RingQueue<T>>(sz);
+    }
+    Init();
+    MS_LOG(DEBUG) << "Create Q with uuid " << my_name_ << " of size " << capacity() << ". Lock free: " << lock_free
+                  << ".";
+  }
+
   virtual ~Queue() {
     ResetQue();
     if (arr_) {
@@ -89,18 +111,44 @@ class Queue {
   }
 
   int size() const {
+    if (ring_ != nullptr) {
+      return ring_->size();
+    }
     int v = tail_ - head_;
     return (v >= 0) ? v : 0;
   }
 
-  int capacity() const { return sz_; }
+  int capacity() const { return (ring_ != nullptr) ? ring_->capacity() : sz_; }
+
+  // Same as size() and capacity(), for an observer running beside the producers and consumers. The mutex based
+  // queue takes its lock since head_, tail_ and sz_ are only written under it.
+  int SnapshotSize() const {
+    if (ring_ != nullptr) {
+      return ring_->size();
+    }
+    std::unique_lock<std::mutex> _lock(mux_);
+    return size();
+  }
+
+  int SnapshotCapacity() const {
+    if (ring_ != nullptr) {
+      return ring_->capacity();
+    }
+    std::unique_lock<std::mutex> _lock(mux_);
+    return capacity();
+  }
+
+  bool empty() const { return (ring_ != nullptr) ? ring_->empty() : (head_ == tail_); }
 
-  bool empty() const { return head_ == tail_; }
+  bool lock_free() const { return ring_ != nullptr; }
 
   void Reset() { ResetQue(); }
 
   // Producer
   Status Add(const_reference ele) noexcept {
+    if (ring_ != nullptr) {
+      return ring_->Add(ele);
+    }
     std::unique_lock<std::mutex> _lock(mux_);
     // Block when full
     Status rc = full_cv_.Wait(&_lock, [this]() -> bool { return (size() != capacity()); });
@@ -116,6 +164,9 @@ class Queue {
   }
 
   Status Add(T &&ele) noexcept {
+    if (ring_ != nullptr) {
+      return ring_->Add(std::forward<T>(ele));
+    }
     std::unique_lock<std::mutex> _lock(mux_);
     // Block when full
     Status rc = full_cv_.Wait(&_lock, [this]() -> bool { return (size() != capacity()); });
@@ -132,6 +183,9 @@ class Queue {
 
   template <typename... Ts>
   Status EmplaceBack(Ts &&... args) noexcept {
+    if (ring_ != nullptr) {
+      return ring_->EmplaceBack(std::forward<Ts>(args)...);
+    }
     std::unique_lock<std::mutex> _lock(mux_);
     // Block when full
     Status rc = full_cv_.Wait(&_lock, [this]() -> bool { return (size() != capacity()); });
@@ -148,6 +202,9 @@ class Queue {
 
   // Consumer
   Status PopFront(pointer p) {
+    if (ring_ != nullptr) {
+      return ring_->PopFront(p);
+    }
     std::unique_lock<std::mutex> _lock(mux_);
     // Block when empty
     Status rc = empty_cv_.Wait(&_lock, [this]() -> bool { return !empty(); });
@@ -166,6 +223,10 @@ class Queue {
   }
 
   void ResetQue() noexcept {
+    if (ring_ != nullptr) {
+      ring_->ResetQue();
+      return;
+    }
     std::unique_lock<std::mutex> _lock(mux_);
     // If there are elements in the queue, invoke its destructor one by one.
     if (!empty() && std::is_destructible<T>::value) {
@@ -180,7 +241,43 @@ class Queue {
     tail_ = 0;
   }
 
+  // Change the capacity of the queue. Elements already in the queue are kept in order, so the new capacity
+  // can't go below the current size. Producers blocked on a full queue are woken up if the queue grows.
+  // Only supported by the mutex based queue.
+  Status Resize(int sz) {
+    if (ring_ != nullptr) {
+      RETURN_STATUS_UNEXPECTED("Resize is not supported by a lock free queue.");
+    }
+    std::unique_lock<std::mutex> _lock(mux_);
+    uint64_t num_elements = tail_ - head_;
+    uint64_t new_sz = std::max(static_cast<uint64_t>(std::max(sz, 1)), num_elements);
+    if (new_sz == sz_) {
+      return Status::OK();
+    }
+    pointer new_arr = alloc_.allocate(new_sz);
+    for (uint64_t i = 0; i < new_sz; i++) {
+      std::allocator_traits<Allocator<T>>::construct(alloc_, &(new_arr[i]));
+    }
+    for (uint64_t i = 0; i < num_elements; i++) {
+      uint32_t k = (head_ + i) % sz_;
+      new_arr[i] = std::move(arr_[k]);
+      arr_[k].~T();
+    }
+    if (arr_) {
+      alloc_.deallocate(arr_);
+    }
+    arr_ = new_arr;
+    sz_ = new_sz;
+    head_ = 0;
+    tail_ = num_elements;
+    full_cv_.NotifyAll();
+    return Status::OK();
+  }
+
   Status Register(TaskGroup *vg) {
+    if (ring_ != nullptr) {
+      return ring_->Register(vg);
+    }
     Status rc1 = empty_cv_.Register(vg->GetIntrpService());
     Status rc2 = full_cv_.Register(vg->GetIntrpService());
     if (rc1.IsOk()) {
@@ -196,10 +293,11 @@ class Queue {
   uint64_t head_;
   uint64_t tail_;
   std::string my_name_;
-  std::mutex mux_;
+  mutable std::mutex mux_;
   CondVar empty_cv_;
   CondVar full_cv_;
   Allocator<T> alloc_;
+  std::unique_ptr<RingQueue<T>> ring_;
 };
 
 // A container of queues with [] operator accessors.  Basically this is a wrapper over of a vector of queues
@@ -209,10 +307,10 @@ class QueueList {
  public:
   QueueList() {}
 
-  void Init(int num_queues, int capacity) {
+  void Init(int num_queues, int capacity, bool lock_free = false) {
     queue_list_.reserve(num_queues);
     for (int i = 0; i < num_queues; i++) {
-      queue_list_.emplace_back(std::make_unique<Queue<T>>(capacity));
+      queue_list_.emplace_back(std::make_unique<Queue<T>>(capacity, lock_free));
     }
   }
 
@@ -230,6 +328,8 @@ class QueueList {
 
   std::unique_ptr<Queue<T>> &operator[](const int index) { return queue_list_[index]; }
 
+  const std::unique_ptr<Queue<T>> &operator[](const int index) const { return queue_list_[index]; }
+
   ~QueueList() = default;
 
  private:
@@ -0,0 +1,295 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef DATASET_UTIL_RING_QUEUE_H_
+#define DATASET_UTIL_RING_QUEUE_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include "dataset/util/cond_var.h"
+#include "dataset/util/status.h"
+#include "dataset/util/task_manager.h"
+
+namespace mindspore {
+namespace dataset {
+// A bounded multi-producer/multi-consumer ring queue. Each slot carries a sequence number so that producers and
+// consumers only need a single CAS on the tail/head counter to claim a slot; no mutex is taken on the fast path.
+// When the ring is full (or empty), the caller spins for a short while and then parks on a CondVar. The CondVar is
+// only signaled when somebody is actually parked, so an uncontended Add/PopFront never enters the kernel.
+// The CondVar also gives us the same interrupt semantics as Queue, i.e. the ring can be registered with a
+// TaskGroup and a parked thread will return kInterrupted.
+//
+// The number of slots is the requested capacity rounded up to a power of 2 (minimum 2), but the ring never holds
+// more elements than the requested capacity, which is also what capacity() reports.
+template <typename T>
+class RingQueue {
+ public:
+  using value_type = T;
+  using pointer = T *;
+  using const_reference = const T &;
+
+  // Number of attempts before a blocked producer/consumer parks itself.
+  static constexpr int kSpinCount = 64;
+
+  explicit RingQueue(int sz)
+      : cap_(static_cast<uint64_t>(std::max(sz, 1))), sz_(RoundUpCapacity(sz)), mask_(sz_ - 1), head_(0), tail_(0) {
+    slots_ = std::make_unique<Slot[]>(sz_);
+    for (uint64_t i = 0; i < sz_; i++) {
+      slots_[i].seq.store(i, std::memory_order_relaxed);
+    }
+    waiting_producers_ = 0;
+    waiting_consumers_ = 0;
+    active_ops_ = 0;
+    resetting_ = false;
+  }
+
+  ~RingQueue() { ResetQue(); }
+
+  RingQueue(const RingQueue &) = delete;
+
+  RingQueue &operator=(const RingQueue &) = delete;
+
+  int size() const {
+    int64_t v = static_cast<int64_t>(tail_.load()) - static_cast<int64_t>(head_.load());
+    return (v >= 0) ? static_cast<int>(v) : 0;
+  }
+
+  int capacity() const { return static_cast<int>(cap_); }
+
+  bool empty() const { return size() == 0; }
+
+  bool full() const { return size() >= capacity(); }
+
+  // Producer
+  Status Add(const_reference ele) noexcept { return EmplaceBack(ele); }
+
+  Status Add(T &&ele) noexcept { return EmplaceBack(std::move(ele)); }
+
+  template <typename... Ts>
+  Status EmplaceBack(Ts &&... args) noexcept {
+    int spin = 0;
+    while (!TryPush(std::forward<Ts>(args)...)) {
+      if (spin < kSpinCount) {
+        ++spin;
+        std::this_thread::yield();
+        continue;
+      }
+      std::unique_lock<std::mutex> _lock(mux_);
+      waiting_producers_.fetch_add(1);
+      Status rc = full_cv_.Wait(&_lock, [this]() -> bool { return !full(); });
+      waiting_producers_.fetch_sub(1);
+      if (rc.IsError()) {
+        _lock.unlock();
+        (void)empty_cv_.Interrupt();
+        return rc;
+      }
+    }
+    WakeUp(&waiting_consumers_, &empty_cv_);
+    return Status::OK();
+  }
+
+  // Consumer
+  Status PopFront(pointer p) noexcept {
+    int spin = 0;
+    while (!TryPop(p)) {
+      if (spin < kSpinCount) {
+        ++spin;
+        std::this_thread::yield();
+        continue;
+      }
+      std::unique_lock<std::mutex> _lock(mux_);
+      waiting_consumers_.fetch_add(1);
+      Status rc = empty_cv_.Wait(&_lock, [this]() -> bool { return !empty(); });
+      waiting_consumers_.fetch_sub(1);
+      if (rc.IsError()) {
+        _lock.unlock();
+        (void)full_cv_.Interrupt();
+        return rc;
+      }
+    }
+    WakeUp(&waiting_producers_, &full_cv_);
+    return Status::OK();
+  }
+
+  // Producers and consumers may still run, e.g. a worker that has not seen the end of the epoch yet. The reset waits
+  // for the ones inside TryPush/TryPop, and holds back new ones until the counters are back to 0.
+  void ResetQue() noexcept {
+    std::unique_lock<std::mutex> _lock(reset_mux_);
+    resetting_.store(true);
+    while (active_ops_.load() > 0) {
+      std::this_thread::yield();
+    }
+    uint64_t head = head_.load();
+    uint64_t tail = tail_.load();
+    for (uint64_t i = head; i < tail; i++) {
+      Slot &s = slots_[i & mask_];
+      if (s.seq.load(std::memory_order_acquire) == i + 1) {
+        reinterpret_cast<pointer>(&s.data)->~T();
+      }
+    }
+    for (uint64_t i = 0; i < sz_; i++) {
+      slots_[i].seq.store(i, std::memory_order_relaxed);
+    }
+    head_ = 0;
+    tail_ = 0;
+    empty_cv_.ResetIntrpState();
+    full_cv_.ResetIntrpState();
+    resetting_.store(false);
+  }
+
+  Status Register(TaskGroup *vg) {
+    Status rc1 = empty_cv_.Register(vg->GetIntrpService());
+    Status rc2 = full_cv_.Register(vg->GetIntrpService());
+    if (rc1.IsOk()) {
+      return rc2;
+    } else {
+      return rc1;
+    }
+  }
+
+ private:
+  static constexpr int kCacheLineSize = 64;
+
+  struct Slot {
+    std::atomic<uint64_t> seq;
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type data;
+  };
+
+  static uint64_t RoundUpCapacity(int sz) {
+    uint64_t n = 2;
+    while (n < static_cast<uint64_t>(sz)) {
+      n <<= 1;
+    }
+    return n;
+  }
+
+  // Pairs with ResetQue. Either the reset sees this op in active_ops_ and waits for it, or the op sees the reset
+  // and waits for it to finish.
+  void EnterOp() {
+    while (true) {
+      active_ops_.fetch_add(1);
+      if (!resetting_.load()) {
+        return;
+      }
+      active_ops_.fetch_sub(1);
+      while (resetting_.load()) {
+        std::this_thread::yield();
+      }
+    }
+  }
+
+  void LeaveOp() { active_ops_.fetch_sub(1); }
+
+  template <typename... Ts>
+  bool TryPush(Ts &&... args) {
+    EnterOp();
+    bool pushed = TryPushSlot(std::forward<Ts>(args)...);
+    LeaveOp();
+    return pushed;
+  }
+
+  bool TryPop(pointer p) {
+    EnterOp();
+    bool popped = TryPopSlot(p);
+    LeaveOp();
+    return popped;
+  }
+
+  template <typename... Ts>
+  bool TryPushSlot(Ts &&... args) {
+    uint64_t pos = tail_.load(std::memory_order_relaxed);
+    Slot *s;
+    while (true) {
+      s = &slots_[pos & mask_];
+      uint64_t seq = s->seq.load(std::memory_order_acquire);
+      int64_t diff = static_cast<int64_t>(seq) - static_cast<int64_t>(pos);
+      if (diff == 0) {
+        // head_ only moves forward, so a ring seen below its capacity here stays below it until the slot is taken
+        if (static_cast<int64_t>(pos - head_.load()) >= static_cast<int64_t>(cap_)) {
+          return false;
+        }
+        if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = tail_.load(std::memory_order_relaxed);
+      }
+    }
+    new (&s->data) T(std::forward<Ts>(args)...);
+    s->seq.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  bool TryPopSlot(pointer p) {
+    uint64_t pos = head_.load(std::memory_order_relaxed);
+    Slot *s;
+    while (true) {
+      s = &slots_[pos & mask_];
+      uint64_t seq = s->seq.load(std::memory_order_acquire);
+      int64_t diff = static_cast<int64_t>(seq) - static_cast<int64_t>(pos + 1);
+      if (diff == 0) {
+        if (head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = head_.load(std::memory_order_relaxed);
+      }
+    }
+    pointer ele = reinterpret_cast<pointer>(&s->data);
+    *p = std::move(*ele);
+    ele->~T();
+    s->seq.store(pos + sz_, std::memory_order_release);
+    return true;
+  }
+
+  // Pairs with the fetch_add in the slow path. Either the parked thread sees the slot we just published, or we
+  // see its waiting count and signal it under the mutex.
+  void WakeUp(std::atomic<int32_t> *waiters, CondVar *cv) {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiters->load() > 0) {
+      std::unique_lock<std::mutex> _lock(mux_);
+      cv->NotifyAll();
+    }
+  }
+
+  const uint64_t cap_;  // The requested capacity, at most sz_
+  const uint64_t sz_;   // The number of slots
+  const uint64_t mask_;
+  std::unique_ptr<Slot[]> slots_;
+  alignas(kCacheLineSize) std::atomic<uint64_t> head_;
+  alignas(kCacheLineSize) std::atomic<uint64_t> tail_;
+  alignas(kCacheLineSize) std::atomic<int32_t> waiting_producers_;
+  std::atomic<int32_t> waiting_consumers_;
+  alignas(kCacheLineSize) std::atomic<int32_t> active_ops_;  // Producers and consumers inside TryPush/TryPop
+  std::atomic<bool> resetting_;
+  std::mutex mux_;
+  std::mutex reset_mux_;
+  CondVar empty_cv_;
+  CondVar full_cv_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // DATASET_UTIL_RING_QUEUE_H_
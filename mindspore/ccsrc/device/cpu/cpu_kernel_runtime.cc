@@ -14,31 +14,235 @@
  * limitations under the License.
  */
 #include "device/cpu/cpu_kernel_runtime.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
 #include <string>
 #include <vector>
 #include <memory>
+#include <mutex>
 #include <numeric>
+#include <set>
 #include <utility>
 #include <functional>
 #include <unordered_map>
+#include <unordered_set>
 #include "kernel/kernel.h"
 #include "device/cpu/cpu_device_address.h"
+#include "device/cpu/cpu_thread_pool.h"
 #include "utils/context/ms_context.h"
 #include "utils/config_manager.h"
 #include "common/utils.h"
 #include "session/anf_runtime_algorithm.h"
 #include "operator/ops.h"
+#include "utils/graph_utils.h"
 
 namespace mindspore {
 namespace device {
 namespace cpu {
 const size_t INIT_NODE_REF = 1;
+namespace {
+// Adds the indices of the kernels the value of node comes from, through the nodes which are not kernels
+void GetPriorKernels(const AnfNodePtr &node, const std::unordered_map<AnfNode *, size_t> &kernel_index,
+                     std::unordered_set<AnfNode *> *visited, std::set<size_t> *prior_kernels) {
+  MS_EXCEPTION_IF_NULL(node);
+  auto iter = kernel_index.find(node.get());
+  if (iter != kernel_index.end()) {
+    (void)prior_kernels->insert(iter->second);
+    return;
+  }
+  if (!node->isa<CNode>() || !visited->insert(node.get()).second) {
+    return;
+  }
+  auto cnode = node->cast<CNodePtr>();
+  MS_EXCEPTION_IF_NULL(cnode);
+  for (size_t i = 1; i < cnode->inputs().size(); ++i) {
+    GetPriorKernels(cnode->input(i), kernel_index, visited, prior_kernels);
+  }
+}
+}  // namespace
+
 void CPUKernelRuntime::AssignKernelAddress(session::KernelGraph *kernel_graph) {
   AssignValueNodeAddress(kernel_graph);
   AssignInputNodeAddress(kernel_graph);
   AssignKernelOutputAddress(kernel_graph);
   resource_manager_.MemPlan(kernel_graph);
   resource_manager_.MemMalloc(kernel_graph);
+  BuildLaunchPlan(kernel_graph);
+}
+
+void CPUKernelRuntime::BuildLaunchPlan(const session::KernelGraph *kernel_graph) {
+  MS_EXCEPTION_IF_NULL(kernel_graph);
+  auto &plan = launch_plans_[kernel_graph];
+  plan.kernels = kernel_graph->execution_order();
+  size_t kernel_num = plan.kernels.size();
+  std::unordered_map<AnfNode *, size_t> kernel_index;
+  for (size_t i = 0; i < kernel_num; ++i) {
+    kernel_index[plan.kernels[i].get()] = i;
+  }
+  std::vector<std::set<size_t>> successors(kernel_num);
+  // The execution order is a valid serial order, an edge against it would be a cycle
+  auto add_edge = [&successors](size_t prior, size_t behind) {
+    if (prior < behind) {
+      (void)successors[prior].insert(behind);
+    }
+  };
+
+  // data edges, and the weights read and updated in place by several kernels are accessed in execution order
+  std::unordered_map<AnfNode *, std::vector<size_t>> parameter_readers;
+  for (size_t i = 0; i < kernel_num; ++i) {
+    auto &kernel = plan.kernels[i];
+    MS_EXCEPTION_IF_NULL(kernel);
+    std::set<size_t> prior_kernels;
+    std::unordered_set<AnfNode *> visited;
+    for (size_t j = 1; j < kernel->inputs().size(); ++j) {
+      GetPriorKernels(kernel->input(j), kernel_index, &visited, &prior_kernels);
+    }
+    for (auto prior : prior_kernels) {
+      add_edge(prior, i);
+    }
+    size_t input_num = AnfAlgo::GetInputTensorNum(kernel);
+    for (size_t j = 0; j < input_num; ++j) {
+      auto input_node = AnfAlgo::GetPrevNodeOutput(kernel, j).first;
+      MS_EXCEPTION_IF_NULL(input_node);
+      if (!input_node->isa<Parameter>()) {
+        continue;
+      }
+      auto &readers = parameter_readers[input_node.get()];
+      auto parameter = input_node->cast<ParameterPtr>();
+      MS_EXCEPTION_IF_NULL(parameter);
+      if (parameter->has_default() && !readers.empty()) {
+        add_edge(readers.back(), i);
+      }
+      if (readers.empty() || readers.back() != i) {
+        readers.push_back(i);
+      }
+    }
+  }
+
+  // control edges
+  auto get_kernels = [&kernel_index, &parameter_readers](const AnfNodePtr &node) {
+    std::set<size_t> kernels;
+    MS_EXCEPTION_IF_NULL(node);
+    if (node->isa<Parameter>()) {
+      auto &readers = parameter_readers[node.get()];
+      kernels.insert(readers.begin(), readers.end());
+    } else {
+      std::unordered_set<AnfNode *> visited;
+      GetPriorKernels(node, kernel_index, &visited, &kernels);
+    }
+    return kernels;
+  };
+  for (const auto &node : TopoSort(kernel_graph->get_return())) {
+    if (!AnfAlgo::CheckPrimitiveType(node, prim::kPrimControlDepend)) {
+      continue;
+    }
+    auto cnode = node->cast<CNodePtr>();
+    MS_EXCEPTION_IF_NULL(cnode);
+    auto behind_kernels = get_kernels(cnode->input(kControlDependBehindIndex));
+    for (auto prior : get_kernels(cnode->input(kControlDependPriorIndex))) {
+      for (auto behind : behind_kernels) {
+        add_edge(prior, behind);
+      }
+    }
+  }
+
+  // kernels writing memory planned for addresses used before
+  for (const auto &edge : resource_manager_.GetMemReuseDepends(kernel_graph)) {
+    if (edge.second < kernel_num) {
+      add_edge(edge.first, edge.second);
+    }
+  }
+
+  plan.successors.assign(kernel_num, {});
+  plan.prior_num.assign(kernel_num, 0);
+  for (size_t i = 0; i < kernel_num; ++i) {
+    plan.successors[i].assign(successors[i].begin(), successors[i].end());
+    for (auto behind : successors[i]) {
+      plan.prior_num[behind]++;
+    }
+  }
+  plan.waiting_num.reset(new std::atomic<size_t>[kernel_num]);
+  BuildLaunchArgs(&plan, kernel_graph);
+}
+
+void CPUKernelRuntime::BuildLaunchArgs(KernelLaunchPlan *plan, const session::KernelGraph *kernel_graph) {
+  MS_EXCEPTION_IF_NULL(plan);
+  MS_EXCEPTION_IF_NULL(kernel_graph);
+  // The parameters and the outputs of the graph are bound to the tensors of each run
+  std::unordered_set<DeviceAddress *> bound_addresses;
+  for (const auto &input : kernel_graph->inputs()) {
+    MS_EXCEPTION_IF_NULL(input);
+    if (input->isa<Parameter>() && AnfAlgo::OutputAddrExist(input, 0)) {
+      (void)bound_addresses.insert(AnfAlgo::GetMutableOutputAddr(input, 0).get());
+    }
+  }
+  std::function<void(const AnfNodePtr &)> add_output = [&add_output, &bound_addresses](const AnfNodePtr &node) {
+    auto item_with_index = AnfAlgo::VisitKernelWithReturnType(node, 0);
+    auto item = item_with_index.first;
+    MS_EXCEPTION_IF_NULL(item);
+    if (AnfAlgo::CheckPrimitiveType(item, prim::kPrimMakeTuple)) {
+      auto make_tuple = item->cast<CNodePtr>();
+      MS_EXCEPTION_IF_NULL(make_tuple);
+      for (size_t i = 1; i < make_tuple->inputs().size(); ++i) {
+        add_output(make_tuple->input(i));
+      }
+    } else if (item->isa<CNode>() && AnfAlgo::OutputAddrExist(item, item_with_index.second)) {
+      (void)bound_addresses.insert(AnfAlgo::GetMutableOutputAddr(item, item_with_index.second).get());
+    }
+  };
+  if (kernel_graph->output() != nullptr) {
+    add_output(kernel_graph->output());
+  }
+
+  // The kernels using the same device address share its launch address
+  std::unordered_map<DeviceAddress *, kernel::AddressPtr> launch_addresses;
+  plan->bound_addresses.clear();
+  auto get_launch_address = [plan, &bound_addresses, &launch_addresses](DeviceAddress *device_address) {
+    MS_EXCEPTION_IF_NULL(device_address);
+    auto iter = launch_addresses.find(device_address);
+    if (iter != launch_addresses.end()) {
+      return iter->second;
+    }
+    auto address = std::make_shared<kernel::Address>();
+    address->addr = device_address->ptr_;
+    address->size = device_address->size_;
+    launch_addresses[device_address] = address;
+    if (device_address->ptr_ == nullptr || bound_addresses.count(device_address) != 0) {
+      plan->bound_addresses.emplace_back(address.get(), device_address);
+    }
+    return address;
+  };
+  plan->launch_args.clear();
+  plan->launch_args.resize(plan->kernels.size());
+  for (size_t i = 0; i < plan->kernels.size(); ++i) {
+    auto &kernel = plan->kernels[i];
+    auto &args = plan->launch_args[i];
+    args.kernel_mod = AnfAlgo::GetKernelMod(kernel);
+    MS_EXCEPTION_IF_NULL(args.kernel_mod);
+    size_t input_num = AnfAlgo::GetInputTensorNum(kernel);
+    for (size_t j = 0; j < input_num; ++j) {
+      args.inputs.push_back(get_launch_address(AnfAlgo::GetPrevNodeMutableOutputAddr(kernel, j).get()));
+    }
+    size_t output_num = AnfAlgo::GetOutputTensorNum(kernel);
+    for (size_t j = 0; j < output_num; ++j) {
+      args.outputs.push_back(get_launch_address(AnfAlgo::GetMutableOutputAddr(kernel, j).get()));
+    }
+    for (size_t j = 0; j < args.kernel_mod->GetWorkspaceSizeList().size(); ++j) {
+      args.workspaces.push_back(get_launch_address(AnfAlgo::GetWorkspaceAddr(kernel, j)));
+    }
+  }
+}
+
+void CPUKernelRuntime::BindLaunchArgs(const KernelLaunchPlan &plan) {
+  for (const auto &bound_address : plan.bound_addresses) {
+    auto device_address = bound_address.second;
+    if (device_address->ptr_ == nullptr) {
+      device_address->ptr_ = resource_manager_.MemMalloc(device_address->size_);
+    }
+    bound_address.first->addr = device_address->ptr_;
+  }
 }
 
 void CPUKernelRuntime::AssignValueNodeAddress(session::KernelGraph *kernel_graph) {
@@ -235,39 +439,123 @@ void CPUKernelRuntime::AddRuntimeAddress(DeviceAddress *address, std::vector<ker
   input_list->push_back(input);
 }
 
-bool CPUKernelRuntime::Run(session::KernelGraph *kernel_graph) {
-  MS_EXCEPTION_IF_NULL(kernel_graph);
-  resource_manager_.ResetAddressRefCount(kernel_graph);
-  auto kernels = kernel_graph->execution_order();
-  for (const auto &kernel : kernels) {
-    std::vector<kernel::AddressPtr> kernel_inputs;
-    std::vector<kernel::AddressPtr> kernel_workspaces;
-    std::vector<kernel::AddressPtr> kernel_outputs;
-    size_t input_num = AnfAlgo::GetInputTensorNum(kernel);
-    for (size_t i = 0; i < input_num; ++i) {
-      auto device_address = AnfAlgo::GetPrevNodeMutableOutputAddr(kernel, i).get();
-      MS_EXCEPTION_IF_NULL(device_address);
-      AddRuntimeAddress(device_address, &kernel_inputs);
+void CPUKernelRuntime::LaunchKernel(const CNodePtr &kernel) {
+  std::vector<kernel::AddressPtr> kernel_inputs;
+  std::vector<kernel::AddressPtr> kernel_workspaces;
+  std::vector<kernel::AddressPtr> kernel_outputs;
+  size_t input_num = AnfAlgo::GetInputTensorNum(kernel);
+  for (size_t i = 0; i < input_num; ++i) {
+    auto device_address = AnfAlgo::GetPrevNodeMutableOutputAddr(kernel, i).get();
+    MS_EXCEPTION_IF_NULL(device_address);
+    AddRuntimeAddress(device_address, &kernel_inputs);
+  }
+  size_t output_num = AnfAlgo::GetOutputTensorNum(kernel);
+  for (size_t i = 0; i < output_num; ++i) {
+    auto device_address = AnfAlgo::GetMutableOutputAddr(kernel, i).get();
+    MS_EXCEPTION_IF_NULL(device_address);
+    AddRuntimeAddress(device_address, &kernel_outputs);
+  }
+  auto kernel_mod = AnfAlgo::GetKernelMod(kernel);
+  MS_EXCEPTION_IF_NULL(kernel_mod);
+  for (size_t i = 0; i < kernel_mod->GetWorkspaceSizeList().size(); ++i) {
+    auto device_address = AnfAlgo::GetWorkspaceAddr(kernel, i);
+    MS_EXCEPTION_IF_NULL(device_address);
+    AddRuntimeAddress(device_address, &kernel_workspaces);
+  }
+  auto ret = kernel_mod->Launch(kernel_inputs, kernel_workspaces, kernel_outputs, 0);
+  resource_manager_.DecreaseAddressRefCount(kernel);
+  if (!ret) {
+    MS_LOG(EXCEPTION) << "Launch kernel failed.";
+  }
+}
+
+void CPUKernelRuntime::LaunchKernel(const KernelLaunchPlan &plan, size_t index) {
+  if (resource_manager_.dynamic_malloc()) {
+    LaunchKernel(plan.kernels[index]);
+    return;
+  }
+  auto &args = plan.launch_args[index];
+  if (!args.kernel_mod->Launch(args.inputs, args.workspaces, args.outputs, 0)) {
+    MS_LOG(EXCEPTION) << "Launch kernel failed.";
+  }
+}
+
+void CPUKernelRuntime::RunParallel(KernelLaunchPlan *plan) {
+  MS_EXCEPTION_IF_NULL(plan);
+  auto &thread_pool = CPUThreadPool::GetInstance();
+  size_t kernel_num = plan->kernels.size();
+  for (size_t i = 0; i < kernel_num; ++i) {
+    plan->waiting_num[i] = plan->prior_num[i];
+  }
+  std::atomic<size_t> running_num(0);
+  std::atomic<bool> failed(false);
+  std::exception_ptr error = nullptr;
+  std::mutex mutex;
+  std::condition_variable cond;
+  size_t unfinished_num = kernel_num;
+
+  // After a failure the remaining kernels are only counted as finished
+  auto run_kernel = [&](auto &self, size_t index) -> void {
+    if (!failed) {
+      // the threads are shared among the kernels running side by side
+      size_t intra_op_thread_num = CPUThreadPool::GetIntraOpThreadNum();
+      CPUThreadPool::SetIntraOpThreadNum(std::max<size_t>(thread_pool.GetThreadNum() / ++running_num, 1));
+      try {
+        LaunchKernel(*plan, index);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (error == nullptr) {
+          error = std::current_exception();
+        }
+        failed = true;
+      }
+      --running_num;
+      CPUThreadPool::SetIntraOpThreadNum(intra_op_thread_num);
     }
-    size_t output_num = AnfAlgo::GetOutputTensorNum(kernel);
-    for (size_t i = 0; i < output_num; ++i) {
-      auto device_address = AnfAlgo::GetMutableOutputAddr(kernel, i).get();
-      MS_EXCEPTION_IF_NULL(device_address);
-      AddRuntimeAddress(device_address, &kernel_outputs);
+    for (auto behind : plan->successors[index]) {
+      if (--plan->waiting_num[behind] == 0) {
+        thread_pool.Submit([&self, behind]() { self(self, behind); });
+      }
     }
-    auto kernel_mod = AnfAlgo::GetKernelMod(kernel);
-    MS_EXCEPTION_IF_NULL(kernel_mod);
-    for (size_t i = 0; i < kernel_mod->GetWorkspaceSizeList().size(); ++i) {
-      auto device_address = AnfAlgo::GetWorkspaceAddr(kernel, i);
-      MS_EXCEPTION_IF_NULL(device_address);
-      AddRuntimeAddress(device_address, &kernel_workspaces);
+    std::lock_guard<std::mutex> lock(mutex);
+    if (--unfinished_num == 0) {
+      cond.notify_all();
     }
-    auto ret = kernel_mod->Launch(kernel_inputs, kernel_workspaces, kernel_outputs, 0);
-    resource_manager_.DecreaseAddressRefCount(kernel);
-    if (!ret) {
-      MS_LOG(EXCEPTION) << "Launch kernel failed.";
+  };
+
+  for (size_t i = 0; i < kernel_num; ++i) {
+    if (plan->prior_num[i] == 0) {
+      thread_pool.Submit([&run_kernel, i]() { run_kernel(run_kernel, i); });
     }
   }
+  std::unique_lock<std::mutex> lock(mutex);
+  cond.wait(lock, [&unfinished_num] { return unfinished_num == 0; });
+  if (error != nullptr) {
+    std::rethrow_exception(error);
+  }
+}
+
+bool CPUKernelRuntime::Run(session::KernelGraph *kernel_graph) {
+  MS_EXCEPTION_IF_NULL(kernel_graph);
+  auto iter = launch_plans_.find(kernel_graph);
+  if (iter == launch_plans_.end() || iter->second.kernels != kernel_graph->execution_order()) {
+    BuildLaunchPlan(kernel_graph);
+    iter = launch_plans_.find(kernel_graph);
+  }
+  auto &plan = iter->second;
+  // Without the planned memory the addresses are allocated and freed while the kernels run
+  if (resource_manager_.dynamic_malloc()) {
+    resource_manager_.ResetAddressRefCount(kernel_graph);
+  } else {
+    BindLaunchArgs(plan);
+  }
+  if (plan.kernels.size() > 1 && CPUThreadPool::GetInstance().GetThreadNum() > 1) {
+    RunParallel(&plan);
+    return true;
+  }
+  for (size_t i = 0; i < plan.kernels.size(); ++i) {
+    LaunchKernel(plan, i);
+  }
   return true;
 }
 }  // namespace cpu
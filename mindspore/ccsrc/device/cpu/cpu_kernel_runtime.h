@@ -16,10 +16,12 @@
 #ifndef MINDSPORE_CCSRC_DEVICE_CPU_CPU_KERNEL_RUNTIME_H_
 #define MINDSPORE_CCSRC_DEVICE_CPU_CPU_KERNEL_RUNTIME_H_
 
+#include <atomic>
 #include <memory>
 #include <vector>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include "device/kernel_runtime.h"
 #include "session/kernel_graph.h"
 #include "device/cpu/cpu_resource_manager.h"
@@ -50,7 +52,34 @@ class CPUKernelRuntime : public KernelRuntime {
   void AssignInputNodeAddress(const session::KernelGraph *kernel_graph);
   void AssignKernelOutputAddress(const session::KernelGraph *kernel_graph);
   void AddRuntimeAddress(DeviceAddress *address, std::vector<kernel::AddressPtr> *input_list);
+  // Launch arguments of a kernel, resolved once from the graph
+  struct KernelLaunchArgs {
+    kernel::KernelMod *kernel_mod{nullptr};
+    std::vector<kernel::AddressPtr> inputs;
+    std::vector<kernel::AddressPtr> workspaces;
+    std::vector<kernel::AddressPtr> outputs;
+  };
+  // Kernels of a graph in execution order, with their launch arguments and the kernels each one has to run before.
+  // The arguments point to the planned memory, only the addresses bound to the input and output tensors are updated
+  // before each run.
+  struct KernelLaunchPlan {
+    std::vector<CNodePtr> kernels;
+    std::vector<KernelLaunchArgs> launch_args;
+    std::vector<std::pair<kernel::Address *, DeviceAddress *>> bound_addresses;
+    std::vector<std::vector<size_t>> successors;
+    std::vector<size_t> prior_num;
+    // kernels left to wait for in a parallel run
+    std::unique_ptr<std::atomic<size_t>[]> waiting_num;
+  };
+  void BuildLaunchPlan(const session::KernelGraph *kernel_graph);
+  void BuildLaunchArgs(KernelLaunchPlan *plan, const session::KernelGraph *kernel_graph);
+  void BindLaunchArgs(const KernelLaunchPlan &plan);
+  void LaunchKernel(const CNodePtr &kernel);
+  void LaunchKernel(const KernelLaunchPlan &plan, size_t index);
+  // Launches the kernels on the threads of the pool, a kernel as soon as the kernels before it are done
+  void RunParallel(KernelLaunchPlan *plan);
   CPUResourceManager resource_manager_;
+  std::unordered_map<const session::KernelGraph *, KernelLaunchPlan> launch_plans_;
 };
 }  // namespace cpu
 }  // namespace device
@@ -57,9 +57,17 @@ void CPUResourceManager::MemMalloc(const session::KernelGraph *graph) {
   mem_plan_.MemAssign(graph, mem_ptr_);
 }
 
+std::vector<std::pair<size_t, size_t>> CPUResourceManager::GetMemReuseDepends(const session::KernelGraph *graph) {
+  if (dynamic_malloc_) {
+    return {};
+  }
+  return mem_plan_.GetGraphReuseDepends(graph);
+}
+
 void *CPUResourceManager::MemMalloc(size_t mem_size) {
   void *ptr = malloc(mem_size);
   if (ptr != nullptr) {
+    std::lock_guard<std::mutex> lock(mem_mutex_);
     dynamic_mem_[ptr] = mem_size;
     return ptr;
   } else {
@@ -68,6 +76,7 @@ void *CPUResourceManager::MemMalloc(size_t mem_size) {
 }
 
 void CPUResourceManager::MemFree(void *ptr) {
+  std::lock_guard<std::mutex> lock(mem_mutex_);
   auto iter = dynamic_mem_.find(ptr);
   if (iter != dynamic_mem_.end()) {
     (void)dynamic_mem_.erase(iter);
@@ -109,11 +118,7 @@ void CPUResourceManager::DecreaseAddressRefCount(const AnfNodePtr &kernel) {
   for (size_t i = 0; i < input_num; ++i) {
     auto address = AnfAlgo::GetPrevNodeMutableOutputAddr(kernel, i);
     MS_EXCEPTION_IF_NULL(address);
-    address->ref_count_--;
-    if (address->ref_count_ == 0 && address->ptr_ != nullptr) {
-      MemFree(address->ptr_);
-      address->ptr_ = nullptr;
-    }
+    DecreaseAddressRefCount(address.get());
   }
 
   auto kernel_mod = AnfAlgo::GetKernelMod(kernel);
@@ -121,12 +126,23 @@ void CPUResourceManager::DecreaseAddressRefCount(const AnfNodePtr &kernel) {
   for (size_t i = 0; i < kernel_mod->GetWorkspaceSizeList().size(); ++i) {
     auto address = AnfAlgo::GetWorkspaceAddr(kernel, i);
     MS_EXCEPTION_IF_NULL(address);
+    DecreaseAddressRefCount(address);
+  }
+}
+
+void CPUResourceManager::DecreaseAddressRefCount(DeviceAddress *address) {
+  void *ptr = nullptr;
+  {
+    // kernels reading the same address may end at the same time, only the last one frees it
+    std::lock_guard<std::mutex> lock(mem_mutex_);
     address->ref_count_--;
-    if (address->ref_count_ == 0 && address->ptr_ != nullptr) {
-      MemFree(address->ptr_);
-      address->ptr_ = nullptr;
+    if (address->ref_count_ != 0 || address->ptr_ == nullptr) {
+      return;
     }
+    ptr = address->ptr_;
+    address->ptr_ = nullptr;
   }
+  MemFree(ptr);
 }
 }  // namespace cpu
 }  // namespace device
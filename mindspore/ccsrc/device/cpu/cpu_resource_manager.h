@@ -16,6 +16,8 @@
 #ifndef MINDSPORE_CCSRC_DEVICE_CPU_CPU_RESOURCE_MANAGER_H_
 #define MINDSPORE_CCSRC_DEVICE_CPU_CPU_RESOURCE_MANAGER_H_
 
+#include <mutex>
+#include <utility>
 #include <vector>
 #include <unordered_map>
 #include "session/kernel_graph.h"
@@ -32,18 +34,25 @@ class CPUResourceManager {
   void MemPlan(const session::KernelGraph *graph);
   void MemMalloc(const session::KernelGraph *graph);
   void ResetAddressRefCount(const session::KernelGraph *graph);
+  // May be called by kernels running at the same time
   void DecreaseAddressRefCount(const AnfNodePtr &kernel);
   void *MemMalloc(size_t mem_size);
   void MemFree(void *ptr);
+  // Orders between kernels of the execution order needed by the memory they share, see CPUSimpleMemPlan
+  std::vector<std::pair<size_t, size_t>> GetMemReuseDepends(const session::KernelGraph *graph);
+  // Whether the addresses are allocated while the kernels run, the planned memory did not fit
+  bool dynamic_malloc() const { return dynamic_malloc_; }
 
  private:
   void MemFree();
+  void DecreaseAddressRefCount(DeviceAddress *address);
   CPUSimpleMemPlan mem_plan_;
 
   size_t mem_size_{0};
   uint8_t *mem_ptr_{nullptr};
   bool dynamic_malloc_{false};
   std::unordered_map<void *, size_t> dynamic_mem_;
+  std::mutex mem_mutex_;
 };
 }  // namespace cpu
 }  // namespace device
@@ -24,6 +24,12 @@
 #include "device/kernel_runtime.h"
 #include "predict/predict.h"
 #include "device/cpu/cpu_kernel_factory.h"
+#include "pre_activate/common/optimizer.h"
+#include "pre_activate/common/pass_manager.h"
+#include "pre_activate/pass/convert_const_input_to_attr.h"
+#include "pre_activate/cpu/ir_fusion/bias_add_fusion.h"
+#include "pre_activate/cpu/ir_fusion/activation_fusion.h"
+#include "pre_activate/cpu/ir_fusion/elementwise_chain_fusion.h"
 
 namespace mindspore {
 namespace session {
@@ -31,11 +37,17 @@ GraphId CPUSession::CompileGraph(const AnfNodePtrList &lst, const AnfNodePtrList
   auto graph_id = graph_sum_;
   auto graph = ConstructKernelGraph(lst, outputs);
   MS_EXCEPTION_IF_NULL(graph);
+  MS_LOG(INFO) << "Optimize graph";
+  Optimize(graph);
   MS_LOG(INFO) << "Set kernel info";
   SetKernelInfo(graph.get());
   predictmodel::StepConvertGraph(graph);
   MS_LOG(INFO) << "Build kernel";
   BuildKernel(graph.get());
+  // The memory plan reuses memory in the order the kernels run, the order is settled before it
+  auto execution_order = graph->execution_order();
+  Reorder(&execution_order);
+  graph->set_execution_order(execution_order);
   MS_LOG(INFO) << "Assign kernel address";
   runtime_.AssignKernelAddress(graph.get());
   return graph_id;
@@ -48,9 +60,6 @@ void CPUSession::RunGraph(const GraphId &graph_id, const std::vector<tensor::Ten
   runtime_.BindInputOutput(kernel_graph.get(), inputs, outputs);
   MS_LOG(INFO) << "Run graph start";
   predictmodel::StepConvertWeight(inputs);
-  auto execution_order = kernel_graph->execution_order();
-  Reorder(&execution_order);
-  kernel_graph->set_execution_order(execution_order);
   bool ret = runtime_.Run(kernel_graph.get());
   if (!ret) {
     MS_LOG(EXCEPTION) << "Run graph failed";
@@ -58,6 +67,23 @@ void CPUSession::RunGraph(const GraphId &graph_id, const std::vector<tensor::Ten
   MS_LOG(INFO) << "Run graph end";
 }
 
+void CPUSession::Optimize(const std::shared_ptr<KernelGraph> &kernel_graph) {
+  MS_EXCEPTION_IF_NULL(kernel_graph);
+  auto optimizer = std::make_shared<opt::GraphOptimizer>();
+  auto pm = std::make_shared<opt::PassManager>();
+  // The kernels read constant inputs such as the cast type or the reduce axis from attributes, only tensor value
+  // nodes get a device address
+  pm->AddPass(std::make_shared<opt::ConvertConstInputToAttr>());
+  // Conv2D and MatMul take a following BiasAdd first and then the activation, the elementwise chain fusion only sees
+  // the ops left over
+  pm->AddPass(std::make_shared<opt::BiasAddFusion>());
+  pm->AddPass(std::make_shared<opt::ActivationFusion>());
+  pm->AddPass(std::make_shared<opt::ElementwiseChainFusion>());
+  optimizer->AddPassManager(pm);
+  (void)optimizer->Optimize(kernel_graph);
+  kernel_graph->SetExecOrderByDefault();
+}
+
 void CPUSession::SetKernelInfo(const KernelGraph *kernel_graph) {
   MS_EXCEPTION_IF_NULL(kernel_graph);
   auto &kernel_nodes = kernel_graph->execution_order();
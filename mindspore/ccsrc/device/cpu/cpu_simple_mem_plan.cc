@@ -14,64 +14,227 @@
  * limitations under the License.
  */
 #include "device/cpu/cpu_simple_mem_plan.h"
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <set>
+#include <unordered_set>
 #include "session/anf_runtime_algorithm.h"
+#include "operator/ops.h"
 
 namespace mindspore {
 namespace device {
 namespace cpu {
-void CPUSimpleMemPlan::MemPlan(const session::KernelGraph *graph) {
-  MS_EXCEPTION_IF_NULL(graph);
-  size_t total_mem_size = 0;
-  auto kernels = graph->execution_order();
-  for (const auto &kernel : kernels) {
-    MS_EXCEPTION_IF_NULL(kernel);
-    size_t input_num = AnfAlgo::GetInputTensorNum(kernel);
-    for (size_t i = 0; i < input_num; ++i) {
-      auto address = AnfAlgo::GetPrevNodeOutputAddr(kernel, i);
-      MS_EXCEPTION_IF_NULL(address);
-      if (address->ptr_ == nullptr) {
-        total_mem_size += address->size_;
-      }
+namespace {
+// Alignment of the blocks in the buffer, a cache line
+constexpr size_t kMemAlignSize = 64;
+
+size_t AlignMemorySize(size_t size) { return (size + kMemAlignSize - 1) / kMemAlignSize * kMemAlignSize; }
+
+// Collects the addresses of the kernels output by the graph, they are read after the last kernel ran
+void GetGraphOutputAddress(const AnfNodePtr &node, std::unordered_set<DeviceAddress *> *output_address) {
+  MS_EXCEPTION_IF_NULL(node);
+  auto item_with_index = AnfAlgo::VisitKernelWithReturnType(node, 0);
+  auto item = item_with_index.first;
+  MS_EXCEPTION_IF_NULL(item);
+  if (AnfAlgo::CheckPrimitiveType(item, prim::kPrimMakeTuple)) {
+    auto make_tuple = item->cast<CNodePtr>();
+    MS_EXCEPTION_IF_NULL(make_tuple);
+    for (size_t i = 1; i < make_tuple->inputs().size(); ++i) {
+      GetGraphOutputAddress(make_tuple->input(i), output_address);
     }
+    return;
+  }
+  if (item->isa<CNode>() && AnfAlgo::OutputAddrExist(item, item_with_index.second)) {
+    (void)output_address->insert(AnfAlgo::GetMutableOutputAddr(item, item_with_index.second).get());
+  }
+}
 
-    size_t output_num = AnfAlgo::GetOutputTensorNum(kernel);
-    for (size_t i = 0; i < output_num; ++i) {
-      auto address = AnfAlgo::GetOutputAddr(kernel, i);
-      MS_EXCEPTION_IF_NULL(address);
-      if (address->ptr_ == nullptr) {
-        total_mem_size += address->size_;
+// Liveness of the addresses a graph has to plan, in the order of the execution order
+class AddressLiveness {
+ public:
+  explicit AddressLiveness(size_t num_kernels) : num_kernels_(num_kernels) {}
+
+  // An address written by the kernel of index step
+  void Define(DeviceAddress *address, size_t step) { Use(address, step, step); }
+
+  // An address read by the kernel of index step. An address with no kernel before it writing it comes from outside of
+  // the kernels, it is kept from the start.
+  void Read(DeviceAddress *address, size_t step) { Use(address, 0, step); }
+
+  // An address kept until the end of the graph
+  void KeepToEnd(DeviceAddress *address) {
+    auto iter = block_index_.find(address);
+    if (iter != block_index_.end()) {
+      blocks_[iter->second].last_use = num_kernels_ - 1;
+    }
+  }
+
+  std::vector<MemBlock> *blocks() { return &blocks_; }
+  const std::vector<DeviceAddress *> &addresses() const { return addresses_; }
+  // The kernels using each address, in increasing order
+  const std::vector<std::vector<size_t>> &uses() const { return uses_; }
+
+ private:
+  void Use(DeviceAddress *address, size_t first_use, size_t step) {
+    auto iter = block_index_.find(address);
+    if (iter != block_index_.end()) {
+      auto &block = blocks_[iter->second];
+      block.last_use = std::max(block.last_use, step);
+      auto &uses = uses_[iter->second];
+      if (uses.back() != step) {
+        uses.push_back(step);
       }
+      return;
     }
+    MemBlock block;
+    block.size = address->size_;
+    block.first_use = first_use;
+    block.last_use = step;
+    blocks_.push_back(block);
+    addresses_.push_back(address);
+    uses_.push_back({step});
+    block_index_[address] = blocks_.size() - 1;
+  }
 
-    auto kernel_mod = AnfAlgo::GetKernelMod(kernel);
-    MS_EXCEPTION_IF_NULL(kernel_mod);
-    for (size_t i = 0; i < kernel_mod->GetWorkspaceSizeList().size(); ++i) {
-      auto address = AnfAlgo::GetWorkspaceAddr(kernel, i);
-      MS_EXCEPTION_IF_NULL(address);
-      if (address->ptr_ == nullptr) {
-        total_mem_size += address->size_;
+  size_t num_kernels_;
+  std::vector<MemBlock> blocks_;
+  std::vector<DeviceAddress *> addresses_;
+  std::vector<std::vector<size_t>> uses_;
+  std::unordered_map<DeviceAddress *, size_t> block_index_;
+};
+
+// Orders the blocks by first use, the order AssignOffsets places them in
+std::vector<size_t> FirstUseOrder(const std::vector<MemBlock> &blocks) {
+  std::vector<size_t> order(blocks.size());
+  for (size_t i = 0; i < order.size(); ++i) {
+    order[i] = i;
+  }
+  std::stable_sort(order.begin(), order.end(),
+                   [&blocks](size_t a, size_t b) { return blocks[a].first_use < blocks[b].first_use; });
+  return order;
+}
+
+// Returns for each block the blocks which held its memory last before it, the blocks before those are ordered before
+// it through them
+std::vector<std::vector<size_t>> GetPrevOccupants(const std::vector<MemBlock> &blocks) {
+  std::vector<std::vector<size_t>> prev_occupants(blocks.size());
+  // memory ranges of the buffer, start to end and block which used the range last
+  std::map<size_t, std::pair<size_t, size_t>> occupants;
+  for (auto index : FirstUseOrder(blocks)) {
+    size_t start = blocks[index].offset;
+    size_t end = start + AlignMemorySize(blocks[index].size);
+    if (start == end) {
+      continue;
+    }
+    auto iter = occupants.upper_bound(start);
+    if (iter != occupants.begin()) {
+      --iter;
+    }
+    while (iter != occupants.end() && iter->first < end) {
+      size_t range_start = iter->first;
+      size_t range_end = iter->second.first;
+      size_t occupant = iter->second.second;
+      if (range_end <= start) {
+        ++iter;
+        continue;
+      }
+      auto &prev = prev_occupants[index];
+      if (std::find(prev.begin(), prev.end(), occupant) == prev.end()) {
+        prev.push_back(occupant);
+      }
+      iter = occupants.erase(iter);
+      if (range_start < start) {
+        occupants[range_start] = std::make_pair(start, occupant);
+      }
+      if (range_end > end) {
+        iter = occupants.emplace(end, std::make_pair(range_end, occupant)).first;
+        ++iter;
       }
     }
+    occupants[start] = std::make_pair(end, index);
   }
-  graph_mem_size_[graph] = total_mem_size;
+  return prev_occupants;
 }
+}  // namespace
 
-size_t CPUSimpleMemPlan::GetGraphMemSize(const session::KernelGraph *graph) { return graph_mem_size_[graph]; }
+size_t CPUSimpleMemPlan::AssignOffsets(std::vector<MemBlock> *blocks) {
+  MS_EXCEPTION_IF_NULL(blocks);
+  size_t mem_size = 0;
+  // free memory in the buffer, offset to size, adjacent ranges are merged
+  std::map<size_t, size_t> free_mem;
+  auto release = [&free_mem, &mem_size](size_t offset, size_t size) {
+    auto next = free_mem.lower_bound(offset);
+    if (next != free_mem.end() && offset + size == next->first) {
+      size += next->second;
+      next = free_mem.erase(next);
+    }
+    if (next != free_mem.begin()) {
+      auto prev = std::prev(next);
+      if (prev->first + prev->second == offset) {
+        prev->second += size;
+        return;
+      }
+    }
+    free_mem[offset] = size;
+  };
 
-void CPUSimpleMemPlan::MemAssign(const session::KernelGraph *graph, uint8_t *base_ptr) {
+  // blocks holding memory, ordered by the step after which they are released
+  std::multimap<size_t, size_t> live_blocks;
+  for (auto index : FirstUseOrder(*blocks)) {
+    auto &block = (*blocks)[index];
+    while (!live_blocks.empty() && live_blocks.begin()->first < block.first_use) {
+      auto &released = (*blocks)[live_blocks.begin()->second];
+      release(released.offset, AlignMemorySize(released.size));
+      (void)live_blocks.erase(live_blocks.begin());
+    }
+    size_t size = AlignMemorySize(block.size);
+    if (size == 0) {
+      block.offset = 0;
+      continue;
+    }
+    auto best_fit = free_mem.end();
+    for (auto iter = free_mem.begin(); iter != free_mem.end(); ++iter) {
+      if (iter->second >= size && (best_fit == free_mem.end() || iter->second < best_fit->second)) {
+        best_fit = iter;
+      }
+    }
+    if (best_fit != free_mem.end()) {
+      block.offset = best_fit->first;
+      if (best_fit->second > size) {
+        free_mem[best_fit->first + size] = best_fit->second - size;
+      }
+      (void)free_mem.erase(best_fit);
+    } else if (!free_mem.empty() && free_mem.rbegin()->first + free_mem.rbegin()->second == mem_size) {
+      // the free memory at the end of the buffer is too small, the buffer grows from it
+      block.offset = free_mem.rbegin()->first;
+      (void)free_mem.erase(std::prev(free_mem.end()));
+      mem_size = block.offset + size;
+    } else {
+      block.offset = mem_size;
+      mem_size += size;
+    }
+    (void)live_blocks.emplace(block.last_use, index);
+  }
+  return mem_size;
+}
+
+void CPUSimpleMemPlan::MemPlan(const session::KernelGraph *graph) {
   MS_EXCEPTION_IF_NULL(graph);
-  MS_EXCEPTION_IF_NULL(base_ptr);
-  uint8_t *mem_ptr = base_ptr;
   auto kernels = graph->execution_order();
-  for (const auto &kernel : kernels) {
+  AddressLiveness liveness(kernels.size());
+  for (size_t step = 0; step < kernels.size(); ++step) {
+    auto &kernel = kernels[step];
     MS_EXCEPTION_IF_NULL(kernel);
     size_t input_num = AnfAlgo::GetInputTensorNum(kernel);
     for (size_t i = 0; i < input_num; ++i) {
       auto address = AnfAlgo::GetPrevNodeMutableOutputAddr(kernel, i);
       MS_EXCEPTION_IF_NULL(address);
-      if (address->ptr_ == nullptr) {
-        address->ptr_ = mem_ptr;
-        mem_ptr = mem_ptr + address->size_;
+      // The parameters are bound to the memory of the input tensors before each run
+      auto input_node = AnfAlgo::GetPrevNodeOutput(kernel, i).first;
+      MS_EXCEPTION_IF_NULL(input_node);
+      if (address->ptr_ == nullptr && !input_node->isa<Parameter>()) {
+        liveness.Read(address.get(), step);
       }
     }
 
@@ -80,8 +243,7 @@ void CPUSimpleMemPlan::MemAssign(const session::KernelGraph *graph, uint8_t *bas
       auto address = AnfAlgo::GetMutableOutputAddr(kernel, i);
       MS_EXCEPTION_IF_NULL(address);
       if (address->ptr_ == nullptr) {
-        address->ptr_ = mem_ptr;
-        mem_ptr = mem_ptr + address->size_;
+        liveness.Define(address.get(), step);
       }
     }
 
@@ -91,11 +253,65 @@ void CPUSimpleMemPlan::MemAssign(const session::KernelGraph *graph, uint8_t *bas
       auto address = AnfAlgo::GetWorkspaceAddr(kernel, i);
       MS_EXCEPTION_IF_NULL(address);
       if (address->ptr_ == nullptr) {
-        address->ptr_ = mem_ptr;
-        mem_ptr = mem_ptr + address->size_;
+        liveness.Define(address.get(), step);
+      }
+    }
+  }
+  if (graph->output() != nullptr) {
+    std::unordered_set<DeviceAddress *> output_address;
+    GetGraphOutputAddress(graph->output(), &output_address);
+    for (auto address : output_address) {
+      liveness.KeepToEnd(address);
+    }
+  }
+
+  auto blocks = liveness.blocks();
+  auto &mem_plan = graph_mem_plan_[graph];
+  mem_plan.mem_size = AssignOffsets(blocks);
+  mem_plan.total_size = 0;
+  mem_plan.address_offsets.clear();
+  for (size_t i = 0; i < blocks->size(); ++i) {
+    mem_plan.total_size += (*blocks)[i].size;
+    mem_plan.address_offsets.emplace_back(liveness.addresses()[i], (*blocks)[i].offset);
+  }
+  // The kernels writing an address first wait for the kernels using the addresses whose memory it takes
+  std::set<std::pair<size_t, size_t>> reuse_depends;
+  auto prev_occupants = GetPrevOccupants(*blocks);
+  for (size_t i = 0; i < blocks->size(); ++i) {
+    for (auto prev : prev_occupants[i]) {
+      for (auto step : liveness.uses()[prev]) {
+        (void)reuse_depends.emplace(step, (*blocks)[i].first_use);
       }
     }
   }
+  mem_plan.reuse_depends.assign(reuse_depends.begin(), reuse_depends.end());
+  MS_LOG(INFO) << "Memory plan of graph " << graph->graph_id() << ": " << mem_plan.mem_size << " bytes for "
+               << blocks->size() << " addresses of " << mem_plan.total_size << " bytes";
+}
+
+size_t CPUSimpleMemPlan::GetGraphMemSize(const session::KernelGraph *graph) {
+  return graph_mem_plan_[graph].mem_size;
+}
+
+size_t CPUSimpleMemPlan::GetGraphTotalSize(const session::KernelGraph *graph) {
+  return graph_mem_plan_[graph].total_size;
+}
+
+std::vector<std::pair<size_t, size_t>> CPUSimpleMemPlan::GetGraphReuseDepends(const session::KernelGraph *graph) {
+  return graph_mem_plan_[graph].reuse_depends;
+}
+
+void CPUSimpleMemPlan::MemAssign(const session::KernelGraph *graph, uint8_t *base_ptr) {
+  MS_EXCEPTION_IF_NULL(graph);
+  MS_EXCEPTION_IF_NULL(base_ptr);
+  auto iter = graph_mem_plan_.find(graph);
+  if (iter == graph_mem_plan_.end()) {
+    MS_LOG(EXCEPTION) << "No memory plan for graph " << graph->graph_id();
+  }
+  for (auto &address_offset : iter->second.address_offsets) {
+    MS_EXCEPTION_IF_NULL(address_offset.first);
+    address_offset.first->ptr_ = base_ptr + address_offset.second;
+  }
 }
 }  // namespace cpu
 }  // namespace device
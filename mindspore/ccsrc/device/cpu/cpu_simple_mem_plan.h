@@ -16,6 +16,7 @@
 #ifndef MINDSPORE_CCSRC_DEVICE_CPU_CPU_SIMPLE_MEM_PLAN_H_
 #define MINDSPORE_CCSRC_DEVICE_CPU_CPU_SIMPLE_MEM_PLAN_H_
 
+#include <utility>
 #include <vector>
 #include <unordered_map>
 #include "session/kernel_graph.h"
@@ -24,6 +25,16 @@
 namespace mindspore {
 namespace device {
 namespace cpu {
+// Memory of an address, used by the kernels of the execution order from first_use to last_use, both included
+struct MemBlock {
+  size_t size{0};
+  size_t first_use{0};
+  size_t last_use{0};
+  size_t offset{0};
+};
+
+// Plans the memory of the addresses of a graph in one buffer. The addresses which are not used at the same time in
+// the execution order share the same memory.
 class CPUSimpleMemPlan {
  public:
   CPUSimpleMemPlan() = default;
@@ -31,10 +42,26 @@ class CPUSimpleMemPlan {
 
   void MemPlan(const session::KernelGraph *graph);
   void MemAssign(const session::KernelGraph *graph, uint8_t *base_ptr);
+  // Size of the buffer planned for the graph
   size_t GetGraphMemSize(const session::KernelGraph *graph);
+  // Size the graph would take without memory reuse, the sum of the sizes of its addresses
+  size_t GetGraphTotalSize(const session::KernelGraph *graph);
+  // Pairs of indices in the execution order of kernels that must run one after the other because the second one
+  // writes memory the first one uses. A serial run meets them all.
+  std::vector<std::pair<size_t, size_t>> GetGraphReuseDepends(const session::KernelGraph *graph);
+  // Gives the blocks offsets such that blocks used at the same time don't overlap, a block takes the best fitting
+  // memory freed by the blocks before it, in the order of first use
+  // @return size of the memory of all the blocks
+  static size_t AssignOffsets(std::vector<MemBlock> *blocks);
 
  private:
-  std::unordered_map<const session::KernelGraph *, size_t> graph_mem_size_;
+  struct GraphMemPlan {
+    std::vector<std::pair<DeviceAddress *, size_t>> address_offsets;
+    size_t mem_size{0};
+    size_t total_size{0};
+    std::vector<std::pair<size_t, size_t>> reuse_depends;
+  };
+  std::unordered_map<const session::KernelGraph *, GraphMemPlan> graph_mem_plan_;
 };
 }  // namespace cpu
 }  // namespace device
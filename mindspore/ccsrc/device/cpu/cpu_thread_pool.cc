@@ -0,0 +1,182 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "device/cpu/cpu_thread_pool.h"
+#include <algorithm>
+#include <cstdint>
+#include <exception>
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+namespace {
+// Index of the thread of the pool running the calling code, kNotInPool for the other threads
+constexpr size_t kNotInPool = SIZE_MAX;
+thread_local size_t t_worker_index = kNotInPool;
+// Zero when not set, the kernels may then use all threads
+thread_local size_t t_intra_op_thread_num = 0;
+}  // namespace
+
+CPUThreadPool::CPUThreadPool() {
+  size_t thread_num = std::max(std::thread::hardware_concurrency(), 1U);
+  for (size_t i = 0; i < thread_num; ++i) {
+    queues_.push_back(std::make_unique<TaskQueue>());
+  }
+  for (size_t i = 0; i < thread_num; ++i) {
+    threads_.emplace_back(&CPUThreadPool::WorkerLoop, this, i);
+  }
+  MS_LOG(INFO) << "Started " << thread_num << " cpu kernel threads";
+}
+
+CPUThreadPool::~CPUThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  cond_.notify_all();
+  for (auto &thread : threads_) {
+    if (thread.joinable()) {
+      thread.join();
+    }
+  }
+}
+
+void CPUThreadPool::Submit(Task &&task) {
+  size_t index = t_worker_index != kNotInPool ? t_worker_index : next_queue_++ % queues_.size();
+  {
+    // counted before it is queued, a thread taking it right away never sees fewer pending tasks than queued ones
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++pending_;
+  }
+  {
+    std::lock_guard<std::mutex> lock(queues_[index]->mutex);
+    queues_[index]->tasks.push_front(std::move(task));
+  }
+  cond_.notify_one();
+}
+
+bool CPUThreadPool::PopTask(size_t index, Task *task) {
+  size_t queue_num = queues_.size();
+  if (index != kNotInPool) {
+    auto &queue = *queues_[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (!queue.tasks.empty()) {
+      *task = std::move(queue.tasks.front());
+      queue.tasks.pop_front();
+      --pending_;
+      return true;
+    }
+  }
+  size_t first = index != kNotInPool ? index + 1 : 0;
+  for (size_t i = 0; i < queue_num; ++i) {
+    size_t victim = (first + i) % queue_num;
+    if (victim == index) {
+      continue;
+    }
+    auto &queue = *queues_[victim];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (!queue.tasks.empty()) {
+      *task = std::move(queue.tasks.back());
+      queue.tasks.pop_back();
+      --pending_;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool CPUThreadPool::RunPendingTask() {
+  Task task;
+  if (!PopTask(t_worker_index, &task)) {
+    return false;
+  }
+  task();
+  return true;
+}
+
+void CPUThreadPool::WorkerLoop(size_t index) {
+  t_worker_index = index;
+  while (true) {
+    Task task;
+    if (PopTask(index, &task)) {
+      try {
+        task();
+      } catch (const std::exception &e) {
+        MS_LOG(ERROR) << "Cpu kernel thread task failed: " << e.what();
+      }
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(mutex_);
+    cond_.wait(lock, [this] { return stop_ || pending_ > 0; });
+    if (stop_ && pending_ == 0) {
+      return;
+    }
+  }
+}
+
+void CPUThreadPool::ParallelFor(size_t count, const std::function<void(size_t, size_t)> &task, size_t min_part_size) {
+  size_t part_num = std::min(count / std::max<size_t>(min_part_size, 1), GetIntraOpThreadNum());
+  if (part_num <= 1) {
+    if (count > 0) {
+      task(0, count);
+    }
+    return;
+  }
+  std::atomic<size_t> remaining(part_num - 1);
+  std::exception_ptr error = nullptr;
+  std::mutex error_mutex;
+  auto run_part = [&](size_t part) {
+    try {
+      task(count * part / part_num, count * (part + 1) / part_num);
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(error_mutex);
+      if (error == nullptr) {
+        error = std::current_exception();
+      }
+    }
+  };
+  for (size_t part = 1; part < part_num; ++part) {
+    Submit([&run_part, &remaining, part]() {
+      // a part is not split again
+      size_t intra_op_thread_num = t_intra_op_thread_num;
+      t_intra_op_thread_num = 1;
+      run_part(part);
+      t_intra_op_thread_num = intra_op_thread_num;
+      --remaining;
+    });
+  }
+  run_part(0);
+  while (remaining > 0) {
+    if (!RunPendingTask()) {
+      std::this_thread::yield();
+    }
+  }
+  if (error != nullptr) {
+    std::rethrow_exception(error);
+  }
+}
+
+size_t CPUThreadPool::GetIntraOpThreadNum() {
+  if (t_intra_op_thread_num == 0) {
+    return GetInstance().GetThreadNum();
+  }
+  return t_intra_op_thread_num;
+}
+
+void CPUThreadPool::SetIntraOpThreadNum(size_t thread_num) { t_intra_op_thread_num = thread_num; }
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
@@ -0,0 +1,88 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_DEVICE_CPU_CPU_THREAD_POOL_H_
+#define MINDSPORE_CCSRC_DEVICE_CPU_CPU_THREAD_POOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "common/utils.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+// Threads shared by the kernels of the cpu runtime, both to run independent kernels at the same time and to split the
+// work of a kernel. Each thread has its own queue of tasks: a thread takes the newest task of its queue and, when its
+// queue is empty, steals the oldest task of the queue of another thread.
+class CPUThreadPool {
+ public:
+  using Task = std::function<void()>;
+
+  static CPUThreadPool &GetInstance() {
+    static CPUThreadPool instance;
+    return instance;
+  }
+  DISABLE_COPY_AND_ASSIGN(CPUThreadPool)
+
+  size_t GetThreadNum() const { return threads_.size(); }
+
+  // Runs the task on a thread of the pool. A task submitted from a thread of the pool goes to the queue of that
+  // thread, other tasks are spread over the queues.
+  void Submit(Task &&task);
+
+  // Runs one pending task on the calling thread, returns false if there is none
+  bool RunPendingTask();
+
+  // Runs task(begin, end) on parts of [0, count), in at most GetIntraOpThreadNum() parts of at least min_part_size
+  // items. The calling thread runs a part and the pending tasks while it waits for the others, so that it may be
+  // called from a task of the pool. The first exception thrown by a part is thrown again once all parts are done.
+  void ParallelFor(size_t count, const std::function<void(size_t, size_t)> &task, size_t min_part_size = 1);
+
+  // Number of threads a kernel launched by the calling thread may split its work in. The runtime lowers it while
+  // kernels run side by side so that the two levels of parallelism don't use more threads than the pool has.
+  static size_t GetIntraOpThreadNum();
+  static void SetIntraOpThreadNum(size_t thread_num);
+
+ private:
+  CPUThreadPool();
+  ~CPUThreadPool();
+
+  struct TaskQueue {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+  };
+
+  void WorkerLoop(size_t index);
+  bool PopTask(size_t index, Task *task);
+
+  std::vector<std::unique_ptr<TaskQueue>> queues_;
+  std::vector<std::thread> threads_;
+  std::atomic<size_t> pending_{0};
+  std::atomic<size_t> next_queue_{0};
+  std::mutex mutex_;
+  std::condition_variable cond_;
+  bool stop_{false};
+};
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_DEVICE_CPU_CPU_THREAD_POOL_H_
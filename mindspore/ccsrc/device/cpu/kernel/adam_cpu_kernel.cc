@@ -0,0 +1,73 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "device/cpu/kernel/adam_cpu_kernel.h"
+#include <cmath>
+#include "device/cpu/kernel/cpu_vector_ops.h"
+#include "device/cpu/cpu_thread_pool.h"
+#include "common/utils.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+namespace {
+constexpr size_t kAdamInputNum = 10;
+}  // namespace
+
+void AdamCPUKernel::InitKernel(const CNodePtr &kernel_node) {
+  MS_EXCEPTION_IF_NULL(kernel_node);
+  if (AnfAlgo::HasNodeAttr(USE_NESTEROV, kernel_node)) {
+    use_nesterov_ = AnfAlgo::GetNodeAttr<bool>(kernel_node, USE_NESTEROV);
+  }
+}
+
+bool AdamCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
+                           const std::vector<kernel::AddressPtr> & /*workspace*/,
+                           const std::vector<kernel::AddressPtr> & /*outputs*/) {
+  if (inputs.size() < kAdamInputNum) {
+    MS_LOG(EXCEPTION) << "error input output size!";
+  }
+  size_t var_size = inputs[0]->size;
+  if (inputs[1]->size != var_size || inputs[2]->size != var_size || inputs[9]->size != var_size) {
+    MS_LOG(EXCEPTION) << "error input data size!";
+  }
+  auto var = reinterpret_cast<float *>(inputs[0]->addr);
+  auto m = reinterpret_cast<float *>(inputs[1]->addr);
+  auto v = reinterpret_cast<float *>(inputs[2]->addr);
+  float beta1_power = reinterpret_cast<float *>(inputs[3]->addr)[0];
+  float beta2_power = reinterpret_cast<float *>(inputs[4]->addr)[0];
+  float lr = reinterpret_cast<float *>(inputs[5]->addr)[0];
+  float beta1 = reinterpret_cast<float *>(inputs[6]->addr)[0];
+  float beta2 = reinterpret_cast<float *>(inputs[7]->addr)[0];
+  float epsilon = reinterpret_cast<float *>(inputs[8]->addr)[0];
+  auto gradient = reinterpret_cast<float *>(inputs[9]->addr);
+  if (beta1_power == 1.0f) {
+    MS_LOG(EXCEPTION) << "adam beta1_power can not be 1";
+  }
+  // The bias corrections of m and v are folded into the learning rate
+  float lr_t = lr * std::sqrt(1.0f - beta2_power) / (1.0f - beta1_power);
+  size_t elem_num = var_size / sizeof(float);
+  CPUThreadPool::GetInstance().ParallelFor(
+    elem_num,
+    [this, var, m, v, gradient, lr_t, beta1, beta2, epsilon](size_t begin, size_t end) {
+      AdamUpdate(var + begin, m + begin, v + begin, gradient + begin, lr_t, beta1, beta2, epsilon, use_nesterov_,
+                 end - begin);
+    },
+    kMinParallelElements);
+  return true;
+}
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
@@ -14,14 +14,19 @@
  * limitations under the License.
  */
 #include "device/cpu/kernel/apply_momentum_cpu_kernel.h"
-#include "device/cpu/kernel/mkldnn/mkl_kernel_engine.h"
-#include "device/cpu/cpu_device_address.h"
+#include "device/cpu/kernel/cpu_vector_ops.h"
+#include "device/cpu/cpu_thread_pool.h"
 #include "common/utils.h"
 
 namespace mindspore {
 namespace device {
 namespace cpu {
-void ApplyMomentumCPUKernel::InitKernel(const CNodePtr & /*kernel_node*/) {}
+void ApplyMomentumCPUKernel::InitKernel(const CNodePtr &kernel_node) {
+  MS_EXCEPTION_IF_NULL(kernel_node);
+  if (AnfAlgo::HasNodeAttr(USE_NESTEROV, kernel_node)) {
+    use_nesterov_ = AnfAlgo::GetNodeAttr<bool>(kernel_node, USE_NESTEROV);
+  }
+}
 
 bool ApplyMomentumCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
                                     const std::vector<kernel::AddressPtr> & /*workspace*/,
@@ -38,10 +43,13 @@ bool ApplyMomentumCPUKernel::Launch(const std::vector<kernel::AddressPtr> &input
   auto gradient = reinterpret_cast<float *>(inputs[3]->addr);
   float moment = reinterpret_cast<float *>(inputs[4]->addr)[0];
   size_t elem_num = inputs[0]->size / sizeof(float);
-  for (size_t i = 0; i < elem_num; ++i) {
-    accumulate[i] = accumulate[i] * moment + gradient[i];
-    weight[i] -= accumulate[i] * learning_rate;
-  }
+  CPUThreadPool::GetInstance().ParallelFor(
+    elem_num,
+    [this, weight, accumulate, learning_rate, gradient, moment](size_t begin, size_t end) {
+      MomentumUpdate(weight + begin, accumulate + begin, gradient + begin, learning_rate, moment, use_nesterov_,
+                     end - begin);
+    },
+    kMinParallelElements);
   return true;
 }
 }  // namespace cpu
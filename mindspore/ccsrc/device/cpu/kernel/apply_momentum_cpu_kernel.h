@@ -18,12 +18,13 @@
 
 #include <vector>
 #include <memory>
-#include "device/cpu/kernel/mkldnn/mkl_cpu_kernel.h"
+#include "device/cpu/cpu_kernel.h"
+#include "device/cpu/cpu_kernel_factory.h"
 
 namespace mindspore {
 namespace device {
 namespace cpu {
-class ApplyMomentumCPUKernel : public MKLCPUKernel {
+class ApplyMomentumCPUKernel : public CPUKernel {
  public:
   ApplyMomentumCPUKernel() = default;
   ~ApplyMomentumCPUKernel() override = default;
@@ -32,6 +33,9 @@ class ApplyMomentumCPUKernel : public MKLCPUKernel {
 
   bool Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
               const std::vector<AddressPtr> &outputs) override;
+
+ private:
+  bool use_nesterov_{false};
 };
 
 MS_REG_CPU_KERNEL(ApplyMomentum, ApplyMomentumCPUKernel);
@@ -0,0 +1,159 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "device/cpu/kernel/arithmetic_cpu_kernel.h"
+#include <algorithm>
+#include <map>
+#include <string>
+#include "device/cpu/cpu_thread_pool.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+namespace {
+const std::map<std::string, BinaryOpType> kBinaryOpTypes = {
+  {"TensorAdd", BinaryOpType::kAdd},   {"Sub", BinaryOpType::kSub},   {"Mul", BinaryOpType::kMul},
+  {"RealDiv", BinaryOpType::kDiv},     {"Div", BinaryOpType::kDiv},   {"Maximum", BinaryOpType::kMaximum},
+  {"Minimum", BinaryOpType::kMinimum}, {"Pow", BinaryOpType::kPow},   {"Greater", BinaryOpType::kGreater},
+  {"Less", BinaryOpType::kLess}};
+
+struct MergedDim {
+  size_t size;
+  bool a_walks;
+  bool b_walks;
+};
+}  // namespace
+
+bool GetBinaryOpType(const std::string &kernel_name, BinaryOpType *op_type) {
+  MS_EXCEPTION_IF_NULL(op_type);
+  auto iter = kBinaryOpTypes.find(kernel_name);
+  if (iter == kBinaryOpTypes.end()) {
+    return false;
+  }
+  *op_type = iter->second;
+  return true;
+}
+
+void ArithmeticCPUKernel::InitKernel(const CNodePtr &kernel_node) {
+  MS_EXCEPTION_IF_NULL(kernel_node);
+  std::string kernel_name = AnfAlgo::GetCNodeName(kernel_node);
+  if (!GetBinaryOpType(kernel_name, &op_type_)) {
+    MS_LOG(EXCEPTION) << "arithmetic kernel not support " << kernel_name;
+  }
+  for (size_t i = 0; i < 2; ++i) {
+    if (IsIntStorageType(AnfAlgo::GetPrevNodeOutputInferDataType(kernel_node, i))) {
+      MS_LOG(EXCEPTION) << kernel_name << " only supports float inputs, cast the int input " << i << " first";
+    }
+  }
+
+  std::vector<size_t> a_shape = AnfAlgo::GetInputDeviceShape(kernel_node, 0);
+  std::vector<size_t> b_shape = AnfAlgo::GetInputDeviceShape(kernel_node, 1);
+  std::vector<size_t> out_shape = AnfAlgo::GetOutputDeviceShape(kernel_node, 0);
+  size_t rank = out_shape.size();
+  if (a_shape.size() > rank || b_shape.size() > rank) {
+    MS_LOG(EXCEPTION) << kernel_name << " input dims " << a_shape.size() << " and " << b_shape.size()
+                      << " exceed output dims " << rank;
+  }
+  (void)a_shape.insert(a_shape.begin(), rank - a_shape.size(), 1);
+  (void)b_shape.insert(b_shape.begin(), rank - b_shape.size(), 1);
+
+  std::vector<MergedDim> dims;
+  for (size_t i = 0; i < rank; ++i) {
+    if ((a_shape[i] != out_shape[i] && a_shape[i] != 1) || (b_shape[i] != out_shape[i] && b_shape[i] != 1)) {
+      MS_LOG(EXCEPTION) << kernel_name << " inputs can not broadcast at dim " << i << ": " << a_shape[i] << " and "
+                        << b_shape[i] << " to " << out_shape[i];
+    }
+    if (out_shape[i] == 1) {
+      continue;
+    }
+    bool a_walks = a_shape[i] != 1;
+    bool b_walks = b_shape[i] != 1;
+    if (!dims.empty() && dims.back().a_walks == a_walks && dims.back().b_walks == b_walks) {
+      dims.back().size *= out_shape[i];
+    } else {
+      dims.push_back({out_shape[i], a_walks, b_walks});
+    }
+  }
+  if (dims.empty()) {
+    dims.push_back({1, true, true});
+  }
+
+  inner_size_ = dims.back().size;
+  a_inner_step_ = dims.back().a_walks ? 1 : 0;
+  b_inner_step_ = dims.back().b_walks ? 1 : 0;
+  size_t outer_num = dims.size() - 1;
+  outer_shape_.resize(outer_num);
+  a_strides_.resize(outer_num);
+  b_strides_.resize(outer_num);
+  size_t a_stride = dims.back().a_walks ? inner_size_ : 1;
+  size_t b_stride = dims.back().b_walks ? inner_size_ : 1;
+  row_num_ = 1;
+  for (size_t i = outer_num; i > 0; --i) {
+    const auto &dim = dims[i - 1];
+    outer_shape_[i - 1] = dim.size;
+    a_strides_[i - 1] = dim.a_walks ? a_stride : 0;
+    b_strides_[i - 1] = dim.b_walks ? b_stride : 0;
+    a_stride *= dim.a_walks ? dim.size : 1;
+    b_stride *= dim.b_walks ? dim.size : 1;
+    row_num_ *= dim.size;
+  }
+}
+
+void ArithmeticCPUKernel::GetRowOffsets(size_t row, size_t *a_offset, size_t *b_offset) const {
+  *a_offset = 0;
+  *b_offset = 0;
+  for (size_t i = outer_shape_.size(); i > 0; --i) {
+    size_t index = row % outer_shape_[i - 1];
+    row /= outer_shape_[i - 1];
+    *a_offset += index * a_strides_[i - 1];
+    *b_offset += index * b_strides_[i - 1];
+  }
+}
+
+bool ArithmeticCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
+                                 const std::vector<kernel::AddressPtr> & /*workspace*/,
+                                 const std::vector<kernel::AddressPtr> &outputs) {
+  if (inputs.size() < 2 || outputs.empty()) {
+    MS_LOG(EXCEPTION) << "arithmetic error input output size!";
+  }
+  if (outputs[0]->size != row_num_ * inner_size_ * sizeof(float)) {
+    MS_LOG(EXCEPTION) << "arithmetic error output data size!";
+  }
+  auto a = reinterpret_cast<float *>(inputs[0]->addr);
+  auto b = reinterpret_cast<float *>(inputs[1]->addr);
+  auto output = reinterpret_cast<float *>(outputs[0]->addr);
+
+  // The rows are cut in chunks of kMinParallelElements values, a thread computes at least that many values
+  size_t chunk_num = (inner_size_ + kMinParallelElements - 1) / kMinParallelElements;
+  size_t min_part_size = kMinParallelElements / std::min(inner_size_, kMinParallelElements);
+  auto task = [this, a, b, output, chunk_num](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      size_t row = i / chunk_num;
+      size_t chunk_begin = (i % chunk_num) * kMinParallelElements;
+      size_t chunk_size = std::min(kMinParallelElements, inner_size_ - chunk_begin);
+      size_t a_offset;
+      size_t b_offset;
+      GetRowOffsets(row, &a_offset, &b_offset);
+      ElementwiseBinary(op_type_, a + a_offset + chunk_begin * a_inner_step_, a_inner_step_,
+                        b + b_offset + chunk_begin * b_inner_step_, b_inner_step_,
+                        output + row * inner_size_ + chunk_begin, chunk_size);
+    }
+  };
+  CPUThreadPool::GetInstance().ParallelFor(row_num_ * chunk_num, task, min_part_size);
+  return true;
+}
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
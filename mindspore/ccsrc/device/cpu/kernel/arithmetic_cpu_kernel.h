@@ -0,0 +1,73 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_DEVICE_CPU_ARITHMETIC_CPU_KERNEL_H_
+#define MINDSPORE_CCSRC_DEVICE_CPU_ARITHMETIC_CPU_KERNEL_H_
+#include <vector>
+#include <memory>
+#include <string>
+#include "device/cpu/cpu_kernel.h"
+#include "device/cpu/cpu_kernel_factory.h"
+#include "device/cpu/kernel/cpu_vector_ops.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+// The vector op of an arithmetic kernel name, false if the name is not one of the kernels registered below
+bool GetBinaryOpType(const std::string &kernel_name, BinaryOpType *op_type);
+
+// Elementwise binary ops with numpy broadcasting. The dimensions along which both inputs either walk or broadcast
+// are merged, the output is then rows of inner_size_ values computed by one vector loop each.
+class ArithmeticCPUKernel : public CPUKernel {
+ public:
+  ArithmeticCPUKernel() = default;
+  ~ArithmeticCPUKernel() override = default;
+
+  void InitKernel(const CNodePtr &kernel_node) override;
+
+  bool Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
+              const std::vector<AddressPtr> &outputs) override;
+
+ private:
+  // Offsets of the first values of a row in the two inputs
+  void GetRowOffsets(size_t row, size_t *a_offset, size_t *b_offset) const;
+
+  BinaryOpType op_type_{BinaryOpType::kAdd};
+  // Merged dimensions out of the innermost one, with the strides of the inputs along them, 0 when broadcast
+  std::vector<size_t> outer_shape_;
+  std::vector<size_t> a_strides_;
+  std::vector<size_t> b_strides_;
+  size_t row_num_{1};
+  size_t inner_size_{1};
+  // 1 if the input walks the innermost dimension, 0 if it is broadcast along it
+  size_t a_inner_step_{1};
+  size_t b_inner_step_{1};
+};
+
+MS_REG_CPU_KERNEL(TensorAdd, ArithmeticCPUKernel);
+MS_REG_CPU_KERNEL(Sub, ArithmeticCPUKernel);
+MS_REG_CPU_KERNEL(Mul, ArithmeticCPUKernel);
+MS_REG_CPU_KERNEL(RealDiv, ArithmeticCPUKernel);
+MS_REG_CPU_KERNEL(Div, ArithmeticCPUKernel);
+MS_REG_CPU_KERNEL(Maximum, ArithmeticCPUKernel);
+MS_REG_CPU_KERNEL(Minimum, ArithmeticCPUKernel);
+MS_REG_CPU_KERNEL(Pow, ArithmeticCPUKernel);
+MS_REG_CPU_KERNEL(Greater, ArithmeticCPUKernel);
+MS_REG_CPU_KERNEL(Less, ArithmeticCPUKernel);
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_DEVICE_CPU_ARITHMETIC_CPU_KERNEL_H_
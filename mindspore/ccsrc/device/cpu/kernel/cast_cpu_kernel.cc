@@ -0,0 +1,94 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "device/cpu/kernel/cast_cpu_kernel.h"
+#include <cmath>
+#include "device/cpu/kernel/cpu_vector_ops.h"
+#include "device/cpu/cpu_thread_pool.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+namespace {
+bool IsIntegerType(TypeId type_id) { return type_id >= kNumberTypeInt && type_id <= kNumberTypeUInt64; }
+}  // namespace
+
+void CastCPUKernel::InitKernel(const CNodePtr &kernel_node) {
+  MS_EXCEPTION_IF_NULL(kernel_node);
+  src_type_ = AnfAlgo::GetPrevNodeOutputInferDataType(kernel_node, 0);
+  dst_type_ = AnfAlgo::GetOutputInferDataType(kernel_node, 0);
+}
+
+bool CastCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
+                           const std::vector<kernel::AddressPtr> & /*workspace*/,
+                           const std::vector<kernel::AddressPtr> &outputs) {
+  if (inputs.empty() || outputs.empty()) {
+    MS_LOG(EXCEPTION) << "input or output empty!";
+  }
+  if (inputs[0]->size != outputs[0]->size) {
+    MS_LOG(EXCEPTION) << "invalid input or output data size!";
+  }
+  size_t mem_bits = outputs[0]->size;
+  size_t elem_num = mem_bits / sizeof(float);
+  bool src_int = IsIntStorageType(src_type_);
+  bool dst_int = IsIntStorageType(dst_type_);
+  bool dst_bool = dst_type_ == kNumberTypeBool;
+  bool dst_integer = IsIntegerType(dst_type_);
+
+  if (src_int == dst_int && !dst_bool && (src_int || !dst_integer)) {
+    if (inputs[0]->addr != outputs[0]->addr) {
+      auto ret = memcpy_s(outputs[0]->addr, mem_bits, inputs[0]->addr, mem_bits);
+      if (ret != 0) {
+        MS_LOG(EXCEPTION) << "memcpy_s error, errorno " << ret;
+      }
+    }
+    return true;
+  }
+  auto task = [src_int, dst_int, dst_bool, &inputs, &outputs](size_t begin, size_t end) {
+    size_t count = end - begin;
+    if (src_int) {
+      auto input = reinterpret_cast<int32_t *>(inputs[0]->addr) + begin;
+      auto output = reinterpret_cast<float *>(outputs[0]->addr) + begin;
+      if (dst_bool) {
+        for (size_t i = 0; i < count; ++i) {
+          output[i] = input[i] != 0 ? 1.0f : 0.0f;
+        }
+      } else {
+        CastIntToFloat(input, output, count);
+      }
+      return;
+    }
+    auto input = reinterpret_cast<float *>(inputs[0]->addr) + begin;
+    if (dst_int) {
+      CastFloatToInt(input, reinterpret_cast<int32_t *>(outputs[0]->addr) + begin, count);
+      return;
+    }
+    auto output = reinterpret_cast<float *>(outputs[0]->addr) + begin;
+    if (dst_bool) {
+      for (size_t i = 0; i < count; ++i) {
+        output[i] = input[i] != 0.0f ? 1.0f : 0.0f;
+      }
+    } else {
+      for (size_t i = 0; i < count; ++i) {
+        output[i] = std::trunc(input[i]);
+      }
+    }
+  };
+  CPUThreadPool::GetInstance().ParallelFor(elem_num, task, kMinParallelElements);
+  return true;
+}
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
@@ -0,0 +1,529 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_DEVICE_CPU_KERNEL_CPU_VECTOR_LOOPS_H_
+#define MINDSPORE_CCSRC_DEVICE_CPU_KERNEL_CPU_VECTOR_LOOPS_H_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include "device/cpu/kernel/cpu_vector_ops.h"
+
+// The loops of cpu_vector_ops, written once over the vector operations of an instruction set.
+// Each instruction set has its own translation unit defining its Ops and including this file after its target
+// pragma, so that the loops are compiled for that instruction set. Everything here is a template on Ops, the
+// instantiations of the translation units never mix.
+//
+// Ops provides, for a vector V of kWidth floats and a comparison result Mask:
+//   Load, Store, Set1, Add, Sub, Mul, Div, Max, Min, Sqrt, Abs, CopySign, Round (to nearest),
+//   Fmadd(a, b, c) = a * b + c, Fnmadd(a, b, c) = c - a * b,
+//   CmpGt, CmpLt, CmpEq, CmpNe (true for nan), Blend(mask, if_true, if_false), MaskToFloat (1.0 or 0.0),
+//   Pow2(n) = 2^n for integral n in [-126, 127], Frexp(x, &e) = mantissa in [0.5, 1) of a positive normal x,
+//   HorizontalAdd, HorizontalMax, LoadInt and StoreInt converting from and to int32 (truncating).
+// The scalar Ops has kWidth 1, the math functions then call the standard library.
+namespace mindspore {
+namespace device {
+namespace cpu {
+struct VectorKernelTable {
+  void (*binary)(BinaryOpType op, const float *a, size_t a_step, const float *b, size_t b_step, float *out,
+                 size_t count);
+  void (*unary)(UnaryOpType op, const float *in, float *out, size_t count);
+  void (*select)(const float *cond, const float *x, const float *y, float *out, size_t count);
+  float (*reduce_sum)(const float *in, size_t count);
+  float (*reduce_max)(const float *in, size_t count);
+  void (*momentum)(float *var, float *accum, const float *grad, float lr, float momentum, bool use_nesterov,
+                   size_t count);
+  void (*adam)(float *var, float *m, float *v, const float *grad, float lr, float beta1, float beta2, float epsilon,
+               bool use_nesterov, size_t count);
+  void (*float_to_int)(const float *in, int32_t *out, size_t count);
+  void (*int_to_float)(const int32_t *in, float *out, size_t count);
+};
+
+// Tables of the vector instruction sets, defined by their translation units
+const VectorKernelTable &Avx2KernelTable();
+const VectorKernelTable &Avx512KernelTable();
+
+namespace vector_loops {
+// The last count % kWidth values of a loop, copied to a zero padded vector and back
+template <size_t kWidth>
+struct Tail {
+  float data[kWidth] = {};
+
+  void CopyIn(const float *src, size_t count) { (void)std::copy_n(src, count, data); }
+  void CopyOut(float *dst, size_t count) const { (void)std::copy_n(data, count, dst); }
+};
+
+// Cephes expf: e^x = 2^n * e^r with |r| <= ln(2) / 2, out of range values give inf and 0
+template <typename Ops>
+typename Ops::V Exp(typename Ops::V x) {
+  if constexpr (Ops::kWidth == 1) {
+    return std::exp(x);
+  } else {
+    const float kMaxInput = 88.72283935546875f;
+    const float kMinInput = -87.33654475f;
+    // The constant comes first, so that a nan input goes through the clamp
+    auto in = x;
+    x = Ops::Min(Ops::Set1(kMaxInput), Ops::Max(Ops::Set1(kMinInput), x));
+    auto n = Ops::Round(Ops::Mul(x, Ops::Set1(1.44269504088896341f)));
+    x = Ops::Fnmadd(n, Ops::Set1(0.693359375f), x);
+    x = Ops::Fnmadd(n, Ops::Set1(-2.12194440e-4f), x);
+    auto y = Ops::Set1(1.9875691500e-4f);
+    y = Ops::Fmadd(y, x, Ops::Set1(1.3981999507e-3f));
+    y = Ops::Fmadd(y, x, Ops::Set1(8.3334519073e-3f));
+    y = Ops::Fmadd(y, x, Ops::Set1(4.1665795894e-2f));
+    y = Ops::Fmadd(y, x, Ops::Set1(1.6666665459e-1f));
+    y = Ops::Fmadd(y, x, Ops::Set1(5.0000001201e-1f));
+    y = Ops::Add(Ops::Fmadd(y, Ops::Mul(x, x), x), Ops::Set1(1.0f));
+    // 2^128 has no float, the last doubling goes to the mantissa
+    auto over = Ops::CmpGt(n, Ops::Set1(127.0f));
+    n = Ops::Blend(over, Ops::Sub(n, Ops::Set1(1.0f)), n);
+    y = Ops::Blend(over, Ops::Add(y, y), y);
+    auto result = Ops::Mul(y, Ops::Pow2(n));
+    result = Ops::Blend(Ops::CmpGt(in, Ops::Set1(kMaxInput)), Ops::Set1(std::numeric_limits<float>::infinity()),
+                        result);
+    return Ops::Blend(Ops::CmpLt(in, Ops::Set1(kMinInput)), Ops::Set1(0.0f), result);
+  }
+}
+
+// Cephes logf: log(x) = log(m) + e * ln(2) with m in [sqrt(2) / 2, sqrt(2))
+template <typename Ops>
+typename Ops::V Log(typename Ops::V x) {
+  if constexpr (Ops::kWidth == 1) {
+    return std::log(x);
+  } else {
+    auto in = x;
+    // subnormals are scaled into the range of Frexp
+    auto tiny = Ops::CmpLt(x, Ops::Set1(std::numeric_limits<float>::min()));
+    x = Ops::Blend(tiny, Ops::Mul(x, Ops::Set1(8388608.0f)), x);
+    typename Ops::V e;
+    auto m = Ops::Frexp(x, &e);
+    e = Ops::Blend(tiny, Ops::Sub(e, Ops::Set1(23.0f)), e);
+    auto small = Ops::CmpLt(m, Ops::Set1(0.707106781186547524f));
+    e = Ops::Blend(small, Ops::Sub(e, Ops::Set1(1.0f)), e);
+    m = Ops::Sub(Ops::Blend(small, Ops::Add(m, m), m), Ops::Set1(1.0f));
+    auto z = Ops::Mul(m, m);
+    auto y = Ops::Set1(7.0376836292e-2f);
+    y = Ops::Fmadd(y, m, Ops::Set1(-1.1514610310e-1f));
+    y = Ops::Fmadd(y, m, Ops::Set1(1.1676998740e-1f));
+    y = Ops::Fmadd(y, m, Ops::Set1(-1.2420140846e-1f));
+    y = Ops::Fmadd(y, m, Ops::Set1(1.4249322787e-1f));
+    y = Ops::Fmadd(y, m, Ops::Set1(-1.6668057665e-1f));
+    y = Ops::Fmadd(y, m, Ops::Set1(2.0000714765e-1f));
+    y = Ops::Fmadd(y, m, Ops::Set1(-2.4999993993e-1f));
+    y = Ops::Fmadd(y, m, Ops::Set1(3.3333331174e-1f));
+    y = Ops::Mul(Ops::Mul(y, m), z);
+    y = Ops::Fmadd(e, Ops::Set1(-2.12194440e-4f), y);
+    y = Ops::Fnmadd(z, Ops::Set1(0.5f), y);
+    auto result = Ops::Fmadd(e, Ops::Set1(0.693359375f), Ops::Add(m, y));
+    const float kInf = std::numeric_limits<float>::infinity();
+    result = Ops::Blend(Ops::CmpLt(in, Ops::Set1(0.0f)), Ops::Set1(std::numeric_limits<float>::quiet_NaN()), result);
+    result = Ops::Blend(Ops::CmpEq(in, Ops::Set1(0.0f)), Ops::Set1(-kInf), result);
+    result = Ops::Blend(Ops::CmpEq(in, Ops::Set1(kInf)), Ops::Set1(kInf), result);
+    return Ops::Blend(Ops::CmpNe(in, in), in, result);
+  }
+}
+
+// Cephes tanhf: a polynomial below 0.625, 1 - 2 / (e^2x + 1) above
+template <typename Ops>
+typename Ops::V Tanh(typename Ops::V x) {
+  if constexpr (Ops::kWidth == 1) {
+    return std::tanh(x);
+  } else {
+    auto abs_x = Ops::Abs(x);
+    auto e = Exp<Ops>(Ops::Add(abs_x, abs_x));
+    auto large = Ops::Sub(Ops::Set1(1.0f), Ops::Div(Ops::Set1(2.0f), Ops::Add(e, Ops::Set1(1.0f))));
+    auto z = Ops::Mul(x, x);
+    auto y = Ops::Set1(-5.70498872745e-3f);
+    y = Ops::Fmadd(y, z, Ops::Set1(2.06390887954e-2f));
+    y = Ops::Fmadd(y, z, Ops::Set1(-5.37397155531e-2f));
+    y = Ops::Fmadd(y, z, Ops::Set1(1.33314422036e-1f));
+    y = Ops::Fmadd(y, z, Ops::Set1(-3.33332819422e-1f));
+    auto small = Ops::Fmadd(Ops::Mul(y, z), x, x);
+    return Ops::Blend(Ops::CmpLt(abs_x, Ops::Set1(0.625f)), small, Ops::CopySign(large, x));
+  }
+}
+
+template <typename Ops>
+typename Ops::V Sigmoid(typename Ops::V x) {
+  auto one = Ops::Set1(1.0f);
+  return Ops::Div(one, Ops::Add(one, Exp<Ops>(Ops::Sub(Ops::Set1(0.0f), x))));
+}
+
+// The power of each lane, from the standard library whatever the instruction set
+template <typename Ops>
+typename Ops::V Pow(typename Ops::V x, typename Ops::V y) {
+  float base[Ops::kWidth];
+  float exponent[Ops::kWidth];
+  Ops::Store(base, x);
+  Ops::Store(exponent, y);
+  for (size_t i = 0; i < Ops::kWidth; ++i) {
+    base[i] = std::pow(base[i], exponent[i]);
+  }
+  return Ops::Load(base);
+}
+
+// out = f(a, b), kAVector and kBVector tell whether a and b are walked or broadcast
+template <typename Ops, bool kAVector, bool kBVector, typename F>
+void MapBinary(const float *a, const float *b, float *out, size_t count, F f) {
+  constexpr size_t kWidth = Ops::kWidth;
+  if (count == 0) {
+    return;
+  }
+  auto a_scalar = Ops::Set1(a[0]);
+  auto b_scalar = Ops::Set1(b[0]);
+  size_t i = 0;
+  for (; i + kWidth <= count; i += kWidth) {
+    auto x = kAVector ? Ops::Load(a + i) : a_scalar;
+    auto y = kBVector ? Ops::Load(b + i) : b_scalar;
+    Ops::Store(out + i, f(x, y));
+  }
+  if (i < count) {
+    size_t rest = count - i;
+    Tail<kWidth> a_tail, b_tail, out_tail;
+    if constexpr (kAVector) {
+      a_tail.CopyIn(a + i, rest);
+    }
+    if constexpr (kBVector) {
+      b_tail.CopyIn(b + i, rest);
+    }
+    auto x = kAVector ? Ops::Load(a_tail.data) : a_scalar;
+    auto y = kBVector ? Ops::Load(b_tail.data) : b_scalar;
+    Ops::Store(out_tail.data, f(x, y));
+    out_tail.CopyOut(out + i, rest);
+  }
+}
+
+template <typename Ops, typename F>
+void MapBinary(const float *a, size_t a_step, const float *b, size_t b_step, float *out, size_t count, F f) {
+  if (a_step != 0 && b_step != 0) {
+    MapBinary<Ops, true, true>(a, b, out, count, f);
+  } else if (a_step != 0) {
+    MapBinary<Ops, true, false>(a, b, out, count, f);
+  } else if (b_step != 0) {
+    MapBinary<Ops, false, true>(a, b, out, count, f);
+  } else {
+    MapBinary<Ops, false, false>(a, b, out, count, f);
+  }
+}
+
+template <typename Ops, typename F>
+void MapUnary(const float *in, float *out, size_t count, F f) {
+  constexpr size_t kWidth = Ops::kWidth;
+  size_t i = 0;
+  for (; i + kWidth <= count; i += kWidth) {
+    Ops::Store(out + i, f(Ops::Load(in + i)));
+  }
+  if (i < count) {
+    size_t rest = count - i;
+    Tail<kWidth> tail;
+    tail.CopyIn(in + i, rest);
+    Ops::Store(tail.data, f(Ops::Load(tail.data)));
+    tail.CopyOut(out + i, rest);
+  }
+}
+
+// The operations are function objects rather than lambdas, the closures created when a template is instantiated
+// don't get the target of the pragma
+template <typename Ops, BinaryOpType kOp>
+struct BinaryFunc {
+  typename Ops::V operator()(typename Ops::V x, typename Ops::V y) const {
+    if constexpr (kOp == BinaryOpType::kAdd) {
+      return Ops::Add(x, y);
+    } else if constexpr (kOp == BinaryOpType::kSub) {
+      return Ops::Sub(x, y);
+    } else if constexpr (kOp == BinaryOpType::kMul) {
+      return Ops::Mul(x, y);
+    } else if constexpr (kOp == BinaryOpType::kDiv) {
+      return Ops::Div(x, y);
+    } else if constexpr (kOp == BinaryOpType::kMaximum) {
+      return Ops::Max(x, y);
+    } else if constexpr (kOp == BinaryOpType::kMinimum) {
+      return Ops::Min(x, y);
+    } else if constexpr (kOp == BinaryOpType::kPow) {
+      return Pow<Ops>(x, y);
+    } else if constexpr (kOp == BinaryOpType::kGreater) {
+      return Ops::MaskToFloat(Ops::CmpGt(x, y));
+    } else {
+      return Ops::MaskToFloat(Ops::CmpLt(x, y));
+    }
+  }
+};
+
+template <typename Ops, UnaryOpType kOp>
+struct UnaryFunc {
+  typename Ops::V operator()(typename Ops::V x) const {
+    if constexpr (kOp == UnaryOpType::kNeg) {
+      return Ops::Sub(Ops::Set1(-0.0f), x);
+    } else if constexpr (kOp == UnaryOpType::kAbs) {
+      return Ops::Abs(x);
+    } else if constexpr (kOp == UnaryOpType::kSquare) {
+      return Ops::Mul(x, x);
+    } else if constexpr (kOp == UnaryOpType::kSqrt) {
+      return Ops::Sqrt(x);
+    } else if constexpr (kOp == UnaryOpType::kRsqrt) {
+      return Ops::Div(Ops::Set1(1.0f), Ops::Sqrt(x));
+    } else if constexpr (kOp == UnaryOpType::kReciprocal) {
+      return Ops::Div(Ops::Set1(1.0f), x);
+    } else if constexpr (kOp == UnaryOpType::kExp) {
+      return Exp<Ops>(x);
+    } else if constexpr (kOp == UnaryOpType::kLog) {
+      return Log<Ops>(x);
+    } else if constexpr (kOp == UnaryOpType::kSigmoid) {
+      return Sigmoid<Ops>(x);
+    } else if constexpr (kOp == UnaryOpType::kTanh) {
+      return Tanh<Ops>(x);
+    } else if constexpr (kOp == UnaryOpType::kRelu) {
+      return Ops::Max(Ops::Set1(0.0f), x);
+    } else {
+      return Ops::Min(Ops::Set1(6.0f), Ops::Max(Ops::Set1(0.0f), x));
+    }
+  }
+};
+
+template <typename Ops, BinaryOpType kOp>
+void Binary(const float *a, size_t a_step, const float *b, size_t b_step, float *out, size_t count) {
+  MapBinary<Ops>(a, a_step, b, b_step, out, count, BinaryFunc<Ops, kOp>());
+}
+
+template <typename Ops>
+void Binary(BinaryOpType op, const float *a, size_t a_step, const float *b, size_t b_step, float *out,
+            size_t count) {
+  switch (op) {
+    case BinaryOpType::kAdd:
+      return Binary<Ops, BinaryOpType::kAdd>(a, a_step, b, b_step, out, count);
+    case BinaryOpType::kSub:
+      return Binary<Ops, BinaryOpType::kSub>(a, a_step, b, b_step, out, count);
+    case BinaryOpType::kMul:
+      return Binary<Ops, BinaryOpType::kMul>(a, a_step, b, b_step, out, count);
+    case BinaryOpType::kDiv:
+      return Binary<Ops, BinaryOpType::kDiv>(a, a_step, b, b_step, out, count);
+    case BinaryOpType::kMaximum:
+      return Binary<Ops, BinaryOpType::kMaximum>(a, a_step, b, b_step, out, count);
+    case BinaryOpType::kMinimum:
+      return Binary<Ops, BinaryOpType::kMinimum>(a, a_step, b, b_step, out, count);
+    case BinaryOpType::kPow:
+      return Binary<Ops, BinaryOpType::kPow>(a, a_step, b, b_step, out, count);
+    case BinaryOpType::kGreater:
+      return Binary<Ops, BinaryOpType::kGreater>(a, a_step, b, b_step, out, count);
+    case BinaryOpType::kLess:
+      return Binary<Ops, BinaryOpType::kLess>(a, a_step, b, b_step, out, count);
+  }
+}
+
+template <typename Ops>
+void Unary(UnaryOpType op, const float *in, float *out, size_t count) {
+  switch (op) {
+    case UnaryOpType::kNeg:
+      return MapUnary<Ops>(in, out, count, UnaryFunc<Ops, UnaryOpType::kNeg>());
+    case UnaryOpType::kAbs:
+      return MapUnary<Ops>(in, out, count, UnaryFunc<Ops, UnaryOpType::kAbs>());
+    case UnaryOpType::kSquare:
+      return MapUnary<Ops>(in, out, count, UnaryFunc<Ops, UnaryOpType::kSquare>());
+    case UnaryOpType::kSqrt:
+      return MapUnary<Ops>(in, out, count, UnaryFunc<Ops, UnaryOpType::kSqrt>());
+    case UnaryOpType::kRsqrt:
+      return MapUnary<Ops>(in, out, count, UnaryFunc<Ops, UnaryOpType::kRsqrt>());
+    case UnaryOpType::kReciprocal:
+      return MapUnary<Ops>(in, out, count, UnaryFunc<Ops, UnaryOpType::kReciprocal>());
+    case UnaryOpType::kExp:
+      return MapUnary<Ops>(in, out, count, UnaryFunc<Ops, UnaryOpType::kExp>());
+    case UnaryOpType::kLog:
+      return MapUnary<Ops>(in, out, count, UnaryFunc<Ops, UnaryOpType::kLog>());
+    case UnaryOpType::kSigmoid:
+      return MapUnary<Ops>(in, out, count, UnaryFunc<Ops, UnaryOpType::kSigmoid>());
+    case UnaryOpType::kTanh:
+      return MapUnary<Ops>(in, out, count, UnaryFunc<Ops, UnaryOpType::kTanh>());
+    case UnaryOpType::kRelu:
+      return MapUnary<Ops>(in, out, count, UnaryFunc<Ops, UnaryOpType::kRelu>());
+    case UnaryOpType::kRelu6:
+      return MapUnary<Ops>(in, out, count, UnaryFunc<Ops, UnaryOpType::kRelu6>());
+  }
+}
+
+template <typename Ops>
+void Select(const float *cond, const float *x, const float *y, float *out, size_t count) {
+  constexpr size_t kWidth = Ops::kWidth;
+  auto zero = Ops::Set1(0.0f);
+  size_t i = 0;
+  for (; i + kWidth <= count; i += kWidth) {
+    Ops::Store(out + i, Ops::Blend(Ops::CmpNe(Ops::Load(cond + i), zero), Ops::Load(x + i), Ops::Load(y + i)));
+  }
+  for (; i < count; ++i) {
+    out[i] = cond[i] != 0 ? x[i] : y[i];
+  }
+}
+
+// Four accumulators hide the latency of the additions
+template <typename Ops>
+float ReduceSum(const float *in, size_t count) {
+  constexpr size_t kWidth = Ops::kWidth;
+  auto acc0 = Ops::Set1(0.0f);
+  auto acc1 = acc0;
+  auto acc2 = acc0;
+  auto acc3 = acc0;
+  size_t i = 0;
+  for (; i + 4 * kWidth <= count; i += 4 * kWidth) {
+    acc0 = Ops::Add(acc0, Ops::Load(in + i));
+    acc1 = Ops::Add(acc1, Ops::Load(in + i + kWidth));
+    acc2 = Ops::Add(acc2, Ops::Load(in + i + 2 * kWidth));
+    acc3 = Ops::Add(acc3, Ops::Load(in + i + 3 * kWidth));
+  }
+  for (; i + kWidth <= count; i += kWidth) {
+    acc0 = Ops::Add(acc0, Ops::Load(in + i));
+  }
+  float sum = Ops::HorizontalAdd(Ops::Add(Ops::Add(acc0, acc1), Ops::Add(acc2, acc3)));
+  for (; i < count; ++i) {
+    sum += in[i];
+  }
+  return sum;
+}
+
+template <typename Ops>
+float ReduceMax(const float *in, size_t count) {
+  constexpr size_t kWidth = Ops::kWidth;
+  auto acc0 = Ops::Set1(-std::numeric_limits<float>::infinity());
+  auto acc1 = acc0;
+  size_t i = 0;
+  for (; i + 2 * kWidth <= count; i += 2 * kWidth) {
+    acc0 = Ops::Max(acc0, Ops::Load(in + i));
+    acc1 = Ops::Max(acc1, Ops::Load(in + i + kWidth));
+  }
+  for (; i + kWidth <= count; i += kWidth) {
+    acc0 = Ops::Max(acc0, Ops::Load(in + i));
+  }
+  float max = Ops::HorizontalMax(Ops::Max(acc0, acc1));
+  for (; i < count; ++i) {
+    max = std::max(max, in[i]);
+  }
+  return max;
+}
+
+template <typename Ops>
+void MomentumStep(float *var, float *accum, const float *grad, typename Ops::V lr, typename Ops::V momentum,
+                  bool use_nesterov) {
+  auto g = Ops::Load(grad);
+  auto a = Ops::Fmadd(Ops::Load(accum), momentum, g);
+  Ops::Store(accum, a);
+  auto delta = use_nesterov ? Ops::Fmadd(a, momentum, g) : a;
+  Ops::Store(var, Ops::Fnmadd(delta, lr, Ops::Load(var)));
+}
+
+template <typename Ops>
+void Momentum(float *var, float *accum, const float *grad, float lr, float momentum, bool use_nesterov,
+              size_t count) {
+  constexpr size_t kWidth = Ops::kWidth;
+  auto lr_v = Ops::Set1(lr);
+  auto momentum_v = Ops::Set1(momentum);
+  size_t i = 0;
+  for (; i + kWidth <= count; i += kWidth) {
+    MomentumStep<Ops>(var + i, accum + i, grad + i, lr_v, momentum_v, use_nesterov);
+  }
+  if (i < count) {
+    size_t rest = count - i;
+    Tail<kWidth> var_tail, accum_tail, grad_tail;
+    var_tail.CopyIn(var + i, rest);
+    accum_tail.CopyIn(accum + i, rest);
+    grad_tail.CopyIn(grad + i, rest);
+    MomentumStep<Ops>(var_tail.data, accum_tail.data, grad_tail.data, lr_v, momentum_v, use_nesterov);
+    var_tail.CopyOut(var + i, rest);
+    accum_tail.CopyOut(accum + i, rest);
+  }
+}
+
+template <typename Ops>
+struct AdamParams {
+  typename Ops::V lr;
+  typename Ops::V beta1;
+  typename Ops::V one_minus_beta1;
+  typename Ops::V one_minus_beta2;
+  typename Ops::V epsilon;
+  bool use_nesterov;
+};
+
+template <typename Ops>
+void AdamStep(float *var, float *m, float *v, const float *grad, const AdamParams<Ops> &params) {
+  auto g = Ops::Load(grad);
+  auto m_t = Ops::Load(m);
+  m_t = Ops::Fmadd(Ops::Sub(g, m_t), params.one_minus_beta1, m_t);
+  auto v_t = Ops::Load(v);
+  v_t = Ops::Fmadd(Ops::Fmadd(g, g, Ops::Sub(Ops::Set1(0.0f), v_t)), params.one_minus_beta2, v_t);
+  Ops::Store(m, m_t);
+  Ops::Store(v, v_t);
+  auto numerator = params.use_nesterov ? Ops::Fmadd(m_t, params.beta1, Ops::Mul(g, params.one_minus_beta1)) : m_t;
+  auto delta = Ops::Div(Ops::Mul(numerator, params.lr), Ops::Add(Ops::Sqrt(v_t), params.epsilon));
+  Ops::Store(var, Ops::Sub(Ops::Load(var), delta));
+}
+
+template <typename Ops>
+void Adam(float *var, float *m, float *v, const float *grad, float lr, float beta1, float beta2, float epsilon,
+          bool use_nesterov, size_t count) {
+  constexpr size_t kWidth = Ops::kWidth;
+  AdamParams<Ops> params{Ops::Set1(lr),          Ops::Set1(beta1),   Ops::Set1(1.0f - beta1),
+                         Ops::Set1(1.0f - beta2), Ops::Set1(epsilon), use_nesterov};
+  size_t i = 0;
+  for (; i + kWidth <= count; i += kWidth) {
+    AdamStep<Ops>(var + i, m + i, v + i, grad + i, params);
+  }
+  if (i < count) {
+    size_t rest = count - i;
+    Tail<kWidth> var_tail, m_tail, v_tail, grad_tail;
+    var_tail.CopyIn(var + i, rest);
+    m_tail.CopyIn(m + i, rest);
+    v_tail.CopyIn(v + i, rest);
+    grad_tail.CopyIn(grad + i, rest);
+    AdamStep<Ops>(var_tail.data, m_tail.data, v_tail.data, grad_tail.data, params);
+    var_tail.CopyOut(var + i, rest);
+    m_tail.CopyOut(m + i, rest);
+    v_tail.CopyOut(v + i, rest);
+  }
+}
+
+template <typename Ops>
+void FloatToInt(const float *in, int32_t *out, size_t count) {
+  constexpr size_t kWidth = Ops::kWidth;
+  size_t i = 0;
+  for (; i + kWidth <= count; i += kWidth) {
+    Ops::StoreInt(out + i, Ops::Load(in + i));
+  }
+  for (; i < count; ++i) {
+    out[i] = static_cast<int32_t>(in[i]);
+  }
+}
+
+template <typename Ops>
+void IntToFloat(const int32_t *in, float *out, size_t count) {
+  constexpr size_t kWidth = Ops::kWidth;
+  size_t i = 0;
+  for (; i + kWidth <= count; i += kWidth) {
+    Ops::Store(out + i, Ops::LoadInt(in + i));
+  }
+  for (; i < count; ++i) {
+    out[i] = static_cast<float>(in[i]);
+  }
+}
+
+template <typename Ops>
+VectorKernelTable MakeKernelTable() {
+  return {&Binary<Ops>,   &Unary<Ops>, &Select<Ops>,      &ReduceSum<Ops>, &ReduceMax<Ops>,
+          &Momentum<Ops>, &Adam<Ops>,  &FloatToInt<Ops>, &IntToFloat<Ops>};
+}
+}  // namespace vector_loops
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_DEVICE_CPU_KERNEL_CPU_VECTOR_LOOPS_H_
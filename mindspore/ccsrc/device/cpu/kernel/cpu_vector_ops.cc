@@ -0,0 +1,129 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "device/cpu/kernel/cpu_vector_ops.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include "device/cpu/kernel/cpu_vector_loops.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+namespace {
+struct ScalarOps {
+  using V = float;
+  using Mask = bool;
+  static constexpr size_t kWidth = 1;
+
+  static V Load(const float *p) { return *p; }
+  static void Store(float *p, V v) { *p = v; }
+  static V Set1(float x) { return x; }
+  static V Add(V a, V b) { return a + b; }
+  static V Sub(V a, V b) { return a - b; }
+  static V Mul(V a, V b) { return a * b; }
+  static V Div(V a, V b) { return a / b; }
+  // Same choice as the vector instructions: the second operand when the comparison fails or has a nan
+  static V Max(V a, V b) { return a > b ? a : b; }
+  static V Min(V a, V b) { return a < b ? a : b; }
+  static V Sqrt(V a) { return std::sqrt(a); }
+  static V Abs(V a) { return std::fabs(a); }
+  static V CopySign(V magnitude, V sign) { return std::copysign(magnitude, sign); }
+  static V Round(V a) { return std::nearbyint(a); }
+  static V Fmadd(V a, V b, V c) { return a * b + c; }
+  static V Fnmadd(V a, V b, V c) { return c - a * b; }
+  static Mask CmpGt(V a, V b) { return a > b; }
+  static Mask CmpLt(V a, V b) { return a < b; }
+  static Mask CmpEq(V a, V b) { return a == b; }
+  static Mask CmpNe(V a, V b) { return a != b; }
+  static V Blend(Mask mask, V if_true, V if_false) { return mask ? if_true : if_false; }
+  static V MaskToFloat(Mask mask) { return mask ? 1.0f : 0.0f; }
+  static V HorizontalAdd(V a) { return a; }
+  static V HorizontalMax(V a) { return a; }
+  static V LoadInt(const int32_t *p) { return static_cast<float>(*p); }
+  static void StoreInt(int32_t *p, V v) { *p = static_cast<int32_t>(v); }
+};
+
+CPUSimdLevel DetectSimdLevel() {
+#if defined(__x86_64__) && defined(__GNUC__) && !defined(__clang__)
+  __builtin_cpu_init();
+  if (!__builtin_cpu_supports("avx2") || !__builtin_cpu_supports("fma")) return CPUSimdLevel::kScalar;
+  if (__builtin_cpu_supports("avx512f")) return CPUSimdLevel::kAvx512;
+  return CPUSimdLevel::kAvx2;
+#else
+  return CPUSimdLevel::kScalar;
+#endif
+}
+
+std::atomic<CPUSimdLevel> &CurrentLevel() {
+  static std::atomic<CPUSimdLevel> level(DetectSimdLevel());
+  return level;
+}
+
+const VectorKernelTable &Kernels() {
+  static const VectorKernelTable scalar_table = vector_loops::MakeKernelTable<ScalarOps>();
+  switch (CurrentLevel().load(std::memory_order_relaxed)) {
+#if defined(__x86_64__) && defined(__GNUC__) && !defined(__clang__)
+    case CPUSimdLevel::kAvx512:
+      return Avx512KernelTable();
+    case CPUSimdLevel::kAvx2:
+      return Avx2KernelTable();
+#endif
+    default:
+      return scalar_table;
+  }
+}
+}  // namespace
+
+CPUSimdLevel GetCPUSimdLevel() { return CurrentLevel(); }
+
+void SetCPUSimdLevel(CPUSimdLevel level) {
+  static const CPUSimdLevel supported = DetectSimdLevel();
+  CurrentLevel() = std::min(level, supported);
+}
+
+void ElementwiseBinary(BinaryOpType op, const float *a, size_t a_step, const float *b, size_t b_step, float *out,
+                       size_t count) {
+  Kernels().binary(op, a, a_step, b, b_step, out, count);
+}
+
+void ElementwiseUnary(UnaryOpType op, const float *in, float *out, size_t count) {
+  Kernels().unary(op, in, out, count);
+}
+
+void ElementwiseSelect(const float *cond, const float *x, const float *y, float *out, size_t count) {
+  Kernels().select(cond, x, y, out, count);
+}
+
+float ReduceSum(const float *in, size_t count) { return Kernels().reduce_sum(in, count); }
+
+float ReduceMax(const float *in, size_t count) { return Kernels().reduce_max(in, count); }
+
+void MomentumUpdate(float *var, float *accum, const float *grad, float lr, float momentum, bool use_nesterov,
+                    size_t count) {
+  Kernels().momentum(var, accum, grad, lr, momentum, use_nesterov, count);
+}
+
+void AdamUpdate(float *var, float *m, float *v, const float *grad, float lr, float beta1, float beta2, float epsilon,
+                bool use_nesterov, size_t count) {
+  Kernels().adam(var, m, v, grad, lr, beta1, beta2, epsilon, use_nesterov, count);
+}
+
+void CastFloatToInt(const float *in, int32_t *out, size_t count) { Kernels().float_to_int(in, out, count); }
+
+void CastIntToFloat(const int32_t *in, float *out, size_t count) { Kernels().int_to_float(in, out, count); }
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
@@ -0,0 +1,92 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_DEVICE_CPU_KERNEL_CPU_VECTOR_OPS_H_
+#define MINDSPORE_CCSRC_DEVICE_CPU_KERNEL_CPU_VECTOR_OPS_H_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+// Vectorized loops over float buffers, shared by the elementwise, reduction and optimizer kernels.
+// Every loop has a scalar version, the avx2 and avx512 versions are picked at runtime from the instruction sets of the
+// cpu. The loops run on the calling thread, the kernels split their work over the threads of the pool.
+// The vector versions use fused multiply-add and polynomial exp and log, their results may differ from the scalar
+// ones in the last bits.
+enum class CPUSimdLevel { kScalar = 0, kAvx2 = 1, kAvx512 = 2 };
+
+// Returns the instruction set the loops run with
+CPUSimdLevel GetCPUSimdLevel();
+
+// Limits the loops to the given instruction set, so that the vector code can be compared to the scalar code
+// @param level: requested instruction set, capped to the best one supported by the cpu
+void SetCPUSimdLevel(CPUSimdLevel level);
+
+// Comparisons give 1.0 for true and 0.0 for false, the cpu device keeps the bool tensors as floats
+enum class BinaryOpType { kAdd, kSub, kMul, kDiv, kMaximum, kMinimum, kPow, kGreater, kLess };
+
+enum class UnaryOpType {
+  kNeg,
+  kAbs,
+  kSquare,
+  kSqrt,
+  kRsqrt,
+  kReciprocal,
+  kExp,
+  kLog,
+  kSigmoid,
+  kTanh,
+  kRelu,
+  kRelu6
+};
+
+// out[i] = a[i * a_step] op b[i * b_step] for i in [0, count)
+// @param a_step, b_step: 1 to walk the input, 0 to broadcast its first value
+// @param out: may be a or b to work in place
+void ElementwiseBinary(BinaryOpType op, const float *a, size_t a_step, const float *b, size_t b_step, float *out,
+                       size_t count);
+
+// out[i] = op(in[i]), out may be in
+void ElementwiseUnary(UnaryOpType op, const float *in, float *out, size_t count);
+
+// out[i] = cond[i] != 0 ? x[i] : y[i]
+void ElementwiseSelect(const float *cond, const float *x, const float *y, float *out, size_t count);
+
+// Sum and maximum of count values, -inf for the maximum of nothing
+float ReduceSum(const float *in, size_t count);
+float ReduceMax(const float *in, size_t count);
+
+// accum = accum * momentum + grad
+// var -= accum * lr, or var -= (grad + accum * momentum) * lr with nesterov
+void MomentumUpdate(float *var, float *accum, const float *grad, float lr, float momentum, bool use_nesterov,
+                    size_t count);
+
+// m += (grad - m) * (1 - beta1)
+// v += (grad * grad - v) * (1 - beta2)
+// var -= lr * m / (sqrt(v) + epsilon), or var -= lr * (m * beta1 + grad * (1 - beta1)) / (sqrt(v) + epsilon) with
+// nesterov. lr is the learning rate already scaled by sqrt(1 - beta2^t) / (1 - beta1^t).
+void AdamUpdate(float *var, float *m, float *v, const float *grad, float lr, float beta1, float beta2, float epsilon,
+                bool use_nesterov, size_t count);
+
+// Conversions between the two element types of the cpu device, float to int truncates toward zero
+void CastFloatToInt(const float *in, int32_t *out, size_t count);
+void CastIntToFloat(const int32_t *in, float *out, size_t count);
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_DEVICE_CPU_KERNEL_CPU_VECTOR_OPS_H_
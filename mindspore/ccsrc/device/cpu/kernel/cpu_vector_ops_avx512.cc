@@ -0,0 +1,95 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+// The avx512 loops of cpu_vector_ops. The code is compiled with a target pragma rather than compiler flags, so that
+// the library still runs on cpus without avx512: the loops are only called once the cpu is known to support them. The
+// pragma holds until the end of the file, where the templates are instantiated.
+#if defined(__x86_64__) && defined(__GNUC__) && !defined(__clang__)
+#include <immintrin.h>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include "device/cpu/kernel/cpu_vector_ops.h"
+
+// The avx512 intrinsics of gcc 12 start from self initialized registers, which the warnings take for uninitialized
+// values once the intrinsics are inlined under a target pragma
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#pragma GCC target("avx512f,avx2,fma")
+#include "device/cpu/kernel/cpu_vector_loops.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+namespace {
+struct Avx512Ops {
+  using V = __m512;
+  using Mask = __mmask16;
+  static constexpr size_t kWidth = 16;
+
+  static V Load(const float *p) { return _mm512_loadu_ps(p); }
+  static void Store(float *p, V v) { _mm512_storeu_ps(p, v); }
+  static V Set1(float x) { return _mm512_set1_ps(x); }
+  static V Add(V a, V b) { return _mm512_add_ps(a, b); }
+  static V Sub(V a, V b) { return _mm512_sub_ps(a, b); }
+  static V Mul(V a, V b) { return _mm512_mul_ps(a, b); }
+  static V Div(V a, V b) { return _mm512_div_ps(a, b); }
+  static V Max(V a, V b) { return _mm512_max_ps(a, b); }
+  static V Min(V a, V b) { return _mm512_min_ps(a, b); }
+  static V Sqrt(V a) { return _mm512_sqrt_ps(a); }
+  static V Abs(V a) { return _mm512_abs_ps(a); }
+  // The float logic instructions need avx512dq, the integer ones are used instead
+  static V CopySign(V magnitude, V sign) {
+    const __m512i sign_bit = _mm512_set1_epi32(static_cast<int32_t>(0x80000000u));
+    __m512i bits = _mm512_or_si512(_mm512_andnot_si512(sign_bit, _mm512_castps_si512(magnitude)),
+                                   _mm512_and_si512(sign_bit, _mm512_castps_si512(sign)));
+    return _mm512_castsi512_ps(bits);
+  }
+  static V Round(V a) { return _mm512_roundscale_ps(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+  static V Fmadd(V a, V b, V c) { return _mm512_fmadd_ps(a, b, c); }
+  static V Fnmadd(V a, V b, V c) { return _mm512_fnmadd_ps(a, b, c); }
+  static Mask CmpGt(V a, V b) { return _mm512_cmp_ps_mask(a, b, _CMP_GT_OQ); }
+  static Mask CmpLt(V a, V b) { return _mm512_cmp_ps_mask(a, b, _CMP_LT_OQ); }
+  static Mask CmpEq(V a, V b) { return _mm512_cmp_ps_mask(a, b, _CMP_EQ_OQ); }
+  static Mask CmpNe(V a, V b) { return _mm512_cmp_ps_mask(a, b, _CMP_NEQ_UQ); }
+  static V Blend(Mask mask, V if_true, V if_false) { return _mm512_mask_blend_ps(mask, if_false, if_true); }
+  static V MaskToFloat(Mask mask) { return _mm512_maskz_mov_ps(mask, _mm512_set1_ps(1.0f)); }
+  static V Pow2(V n) {
+    __m512i exponent = _mm512_add_epi32(_mm512_cvtps_epi32(n), _mm512_set1_epi32(127));
+    return _mm512_castsi512_ps(_mm512_slli_epi32(exponent, 23));
+  }
+  static V Frexp(V x, V *exponent) {
+    __m512i bits = _mm512_castps_si512(x);
+    *exponent = _mm512_cvtepi32_ps(_mm512_sub_epi32(_mm512_srli_epi32(bits, 23), _mm512_set1_epi32(126)));
+    bits = _mm512_or_si512(_mm512_and_si512(bits, _mm512_set1_epi32(0x007fffff)), _mm512_set1_epi32(0x3f000000));
+    return _mm512_castsi512_ps(bits);
+  }
+  static float HorizontalAdd(V a) { return _mm512_reduce_add_ps(a); }
+  static float HorizontalMax(V a) { return _mm512_reduce_max_ps(a); }
+  static V LoadInt(const int32_t *p) { return _mm512_cvtepi32_ps(_mm512_loadu_si512(p)); }
+  static void StoreInt(int32_t *p, V v) { _mm512_storeu_si512(p, _mm512_cvttps_epi32(v)); }
+};
+}  // namespace
+
+const VectorKernelTable &Avx512KernelTable() {
+  static const VectorKernelTable table = vector_loops::MakeKernelTable<Avx512Ops>();
+  return table;
+}
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
+#endif
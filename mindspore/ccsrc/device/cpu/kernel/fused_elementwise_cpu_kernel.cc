@@ -0,0 +1,134 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "device/cpu/kernel/fused_elementwise_cpu_kernel.h"
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <string>
+#include "utils/convert_utils.h"
+#include "device/cpu/cpu_thread_pool.h"
+#include "device/cpu/kernel/arithmetic_cpu_kernel.h"
+#include "device/cpu/kernel/unary_cpu_kernel.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+namespace {
+// Values a thread runs the whole chain on at once, the output block and the input blocks stay in the L1 cache
+constexpr size_t kFusedBlockSize = 1024;
+constexpr int kPreviousStep = -1;
+}  // namespace
+
+void FusedElementwiseCPUKernel::InitKernel(const CNodePtr &kernel_node) {
+  MS_EXCEPTION_IF_NULL(kernel_node);
+  auto ops = AnfAlgo::GetNodeAttr<std::vector<std::string>>(kernel_node, FUSED_OPS);
+  auto lhs = AnfAlgo::GetNodeAttr<std::vector<int>>(kernel_node, FUSED_LHS);
+  auto rhs = AnfAlgo::GetNodeAttr<std::vector<int>>(kernel_node, FUSED_RHS);
+  if (ops.empty() || lhs.size() != ops.size() || rhs.size() != ops.size()) {
+    MS_LOG(EXCEPTION) << "fused elementwise got " << ops.size() << " ops, " << lhs.size() << " lhs and " << rhs.size()
+                      << " rhs";
+  }
+  std::vector<size_t> out_shape = AnfAlgo::GetOutputDeviceShape(kernel_node, 0);
+  elem_num_ = std::accumulate(out_shape.begin(), out_shape.end(), size_t(1), std::multiplies<size_t>());
+  size_t input_num = AnfAlgo::GetInputTensorNum(kernel_node);
+  input_steps_.clear();
+  for (size_t i = 0; i < input_num; ++i) {
+    if (IsIntStorageType(AnfAlgo::GetPrevNodeOutputInferDataType(kernel_node, i))) {
+      MS_LOG(EXCEPTION) << "fused elementwise only supports float inputs, input " << i << " is int";
+    }
+    std::vector<size_t> shape = AnfAlgo::GetInputDeviceShape(kernel_node, i);
+    size_t input_elem_num = std::accumulate(shape.begin(), shape.end(), size_t(1), std::multiplies<size_t>());
+    if (input_elem_num != elem_num_ && input_elem_num != 1) {
+      MS_LOG(EXCEPTION) << "fused elementwise input " << i << " has " << input_elem_num << " values, the output has "
+                        << elem_num_;
+    }
+    input_steps_.push_back(input_elem_num == elem_num_ ? 1 : 0);
+  }
+
+  steps_.clear();
+  for (size_t i = 0; i < ops.size(); ++i) {
+    Step step{false, BinaryOpType::kAdd, UnaryOpType::kNeg, lhs[i], rhs[i]};
+    if (GetBinaryOpType(ops[i], &step.binary_op)) {
+      step.is_binary = true;
+    } else if (!GetUnaryOpType(ops[i], &step.unary_op)) {
+      MS_LOG(EXCEPTION) << "fused elementwise not support " << ops[i];
+    }
+    std::vector<int> operands{step.lhs};
+    if (step.is_binary) {
+      operands.push_back(step.rhs);
+    }
+    for (int operand : operands) {
+      if (operand == kPreviousStep ? i == 0 : (operand < 0 || IntToSize(operand) >= input_num)) {
+        MS_LOG(EXCEPTION) << "fused elementwise step " << i << " has invalid input " << operand;
+      }
+    }
+    if (!step.is_binary && step.lhs != kPreviousStep && input_steps_[IntToSize(step.lhs)] == 0 && elem_num_ != 1) {
+      MS_LOG(EXCEPTION) << "fused elementwise step " << i << " can not broadcast the input of unary " << ops[i];
+    }
+    steps_.push_back(step);
+  }
+}
+
+void FusedElementwiseCPUKernel::RunBlock(const std::vector<AddressPtr> &inputs, float *output, size_t begin,
+                                         size_t end) const {
+  size_t count = end - begin;
+  float *out = output + begin;
+  auto operand = [&inputs, this, begin, out](int index, size_t *step) -> const float * {
+    if (index == kPreviousStep) {
+      *step = 1;
+      return out;
+    }
+    size_t input_index = IntToSize(index);
+    *step = input_steps_[input_index];
+    return reinterpret_cast<const float *>(inputs[input_index]->addr) + begin * *step;
+  };
+  for (const auto &step : steps_) {
+    size_t a_step;
+    const float *a = operand(step.lhs, &a_step);
+    if (step.is_binary) {
+      size_t b_step;
+      const float *b = operand(step.rhs, &b_step);
+      ElementwiseBinary(step.binary_op, a, a_step, b, b_step, out, count);
+    } else {
+      ElementwiseUnary(step.unary_op, a, out, count);
+    }
+  }
+}
+
+bool FusedElementwiseCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
+                                       const std::vector<kernel::AddressPtr> & /*workspace*/,
+                                       const std::vector<kernel::AddressPtr> &outputs) {
+  if (inputs.size() != input_steps_.size() || outputs.empty()) {
+    MS_LOG(EXCEPTION) << "fused elementwise error input output size!";
+  }
+  if (outputs[0]->size != elem_num_ * sizeof(float)) {
+    MS_LOG(EXCEPTION) << "fused elementwise error output data size!";
+  }
+  auto output = reinterpret_cast<float *>(outputs[0]->addr);
+  // The memory plan never gives the output the memory of an input, so the steps can work in place on it
+  CPUThreadPool::GetInstance().ParallelFor(
+    elem_num_,
+    [this, &inputs, output](size_t begin, size_t end) {
+      for (size_t block = begin; block < end; block += kFusedBlockSize) {
+        RunBlock(inputs, output, block, std::min(block + kFusedBlockSize, end));
+      }
+    },
+    kMinParallelElements);
+  return true;
+}
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
@@ -0,0 +1,63 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_DEVICE_CPU_FUSED_ELEMENTWISE_CPU_KERNEL_H_
+#define MINDSPORE_CCSRC_DEVICE_CPU_FUSED_ELEMENTWISE_CPU_KERNEL_H_
+#include <vector>
+#include <memory>
+#include "device/cpu/cpu_kernel.h"
+#include "device/cpu/cpu_kernel_factory.h"
+#include "device/cpu/kernel/cpu_vector_ops.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+// A chain of elementwise ops collapsed by ElementwiseChainFusion. The steps all run on a block of the output before
+// the next block is started, each step reads the value of the previous one from the output block while it is still
+// in cache.
+class FusedElementwiseCPUKernel : public CPUKernel {
+ public:
+  FusedElementwiseCPUKernel() = default;
+  ~FusedElementwiseCPUKernel() override = default;
+
+  void InitKernel(const CNodePtr &kernel_node) override;
+
+  bool Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
+              const std::vector<AddressPtr> &outputs) override;
+
+ private:
+  struct Step {
+    bool is_binary;
+    BinaryOpType binary_op;
+    UnaryOpType unary_op;
+    // Index of the kernel input, or -1 for the value of the previous step
+    int lhs;
+    int rhs;
+  };
+  // Runs the steps on the output values [begin, end)
+  void RunBlock(const std::vector<AddressPtr> &inputs, float *output, size_t begin, size_t end) const;
+
+  std::vector<Step> steps_;
+  // 1 if the input has a value per output value, 0 if its single value is broadcast
+  std::vector<size_t> input_steps_;
+  size_t elem_num_{1};
+};
+
+MS_REG_CPU_KERNEL(FusedElementwise, FusedElementwiseCPUKernel);
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_DEVICE_CPU_FUSED_ELEMENTWISE_CPU_KERNEL_H_
@@ -64,26 +64,43 @@ void Conv2dCPUKernel::InitKernel(const CNodePtr &kernel_node) {
   }
   dnnl::memory::dims padding_l{int_padding_l[0], int_padding_l[1]};
   dnnl::memory::dims padding_r{int_padding_r[0], int_padding_r[1]};
+  // A BiasAdd and an activation folded in by the cpu fusion passes run inside the convolution primitive
+  has_bias_ = AnfAlgo::HasNodeAttr(HAS_BIAS, kernel_node) && AnfAlgo::GetNodeAttr<bool>(kernel_node, HAS_BIAS);
+  dnnl::memory::desc bias_desc = GetDefaultMemDesc({weight_shape[0]});
   dnnl::convolution_forward::desc desc =
-    dnnl::convolution_forward::desc(dnnl::prop_kind::forward_training, dnnl::algorithm::convolution_auto, src_desc,
-                                    weights_desc, dst_desc, strides, dilates, padding_l, padding_r);
+    has_bias_ ? dnnl::convolution_forward::desc(dnnl::prop_kind::forward_training, dnnl::algorithm::convolution_auto,
+                                                src_desc, weights_desc, bias_desc, dst_desc, strides, dilates,
+                                                padding_l, padding_r)
+              : dnnl::convolution_forward::desc(dnnl::prop_kind::forward_training, dnnl::algorithm::convolution_auto,
+                                                src_desc, weights_desc, dst_desc, strides, dilates, padding_l,
+                                                padding_r);
+  dnnl::primitive_attr attr;
+  if (AnfAlgo::HasNodeAttr(FUSED_ACTIVATION, kernel_node)) {
+    attr.set_post_ops(GetActivationPostOps(AnfAlgo::GetNodeAttr<std::string>(kernel_node, FUSED_ACTIVATION)));
+  }
 
-  auto prim_desc = dnnl::convolution_forward::primitive_desc(desc, MKLKernelEngine::Get().engine());
+  auto prim_desc = dnnl::convolution_forward::primitive_desc(desc, attr, MKLKernelEngine::Get().engine());
   primitive_ = std::make_shared<dnnl::convolution_forward>(prim_desc);
 
   AddArgument(DNNL_ARG_SRC, src_desc);
   AddArgument(DNNL_ARG_WEIGHTS, weights_desc);
+  if (has_bias_) {
+    AddArgument(DNNL_ARG_BIAS, bias_desc);
+  }
   AddArgument(DNNL_ARG_DST, dst_desc);
 }
 
 bool Conv2dCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
                              const std::vector<kernel::AddressPtr> & /*workspace*/,
                              const std::vector<kernel::AddressPtr> &outputs) {
-  if (inputs.size() < 2 || outputs.empty()) {
+  if (inputs.size() < (has_bias_ ? 3 : 2) || outputs.empty()) {
     MS_LOG(EXCEPTION) << "error input output size!";
   }
   SetArgumentHandle(DNNL_ARG_SRC, inputs[0]->addr);
   SetArgumentHandle(DNNL_ARG_WEIGHTS, inputs[1]->addr);
+  if (has_bias_) {
+    SetArgumentHandle(DNNL_ARG_BIAS, inputs[2]->addr);
+  }
   SetArgumentHandle(DNNL_ARG_DST, outputs[0]->addr);
   ExecutePrimitive();
   return true;
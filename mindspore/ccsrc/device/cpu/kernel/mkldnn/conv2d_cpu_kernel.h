@@ -32,6 +32,9 @@ class Conv2dCPUKernel : public MKLCPUKernel {
 
   bool Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
               const std::vector<AddressPtr> &outputs) override;
+
+ private:
+  bool has_bias_{false};
 };
 
 MS_REG_CPU_KERNEL(Conv2D, Conv2dCPUKernel);
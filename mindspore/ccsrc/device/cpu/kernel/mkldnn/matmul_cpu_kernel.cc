@@ -15,10 +15,13 @@
  */
 #include "device/cpu/kernel/mkldnn/matmul_cpu_kernel.h"
 #include <algorithm>
+#include <string>
 #include <utility>
 #include "device/cpu/kernel/mkldnn/mkl_kernel_engine.h"
 #include "common/utils.h"
 #include "device/cpu/cpu_device_address.h"
+#include "device/cpu/cpu_thread_pool.h"
+#include "device/cpu/kernel/unary_cpu_kernel.h"
 
 namespace mindspore {
 namespace device {
@@ -46,12 +49,27 @@ void MatMulCPUKernel::InitKernel(const CNodePtr &kernel_node) {
     trans_b_ = TRANSPOSE_YES;
   }
   dim_n_ = static_cast<dnnl_dim_t>(dst_shape[1]);
+  // A BiasAdd and an activation folded in by the cpu fusion passes are applied to the rows right after the gemm
+  has_bias_ = AnfAlgo::HasNodeAttr(HAS_BIAS, kernel_node) && AnfAlgo::GetNodeAttr<bool>(kernel_node, HAS_BIAS);
+  if (has_bias_) {
+    std::vector<size_t> bias_shape = AnfAlgo::GetInputDeviceShape(kernel_node, 2);
+    if (bias_shape.size() != 1 || bias_shape[0] != dst_shape[1]) {
+      MS_LOG(EXCEPTION) << "matmul bias shape not match";
+    }
+  }
+  has_activation_ = AnfAlgo::HasNodeAttr(FUSED_ACTIVATION, kernel_node);
+  if (has_activation_) {
+    auto activation = AnfAlgo::GetNodeAttr<std::string>(kernel_node, FUSED_ACTIVATION);
+    if (!GetUnaryOpType(activation, &activation_)) {
+      MS_LOG(EXCEPTION) << "matmul can not fuse activation " << activation;
+    }
+  }
 }
 
 bool MatMulCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
                              const std::vector<kernel::AddressPtr> & /*workspace*/,
                              const std::vector<kernel::AddressPtr> &outputs) {
-  if (inputs.size() < 2 || outputs.empty()) {
+  if (inputs.size() < (has_bias_ ? 3 : 2) || outputs.empty()) {
     MS_LOG(EXCEPTION) << "matmul error input output size!";
   }
   dnnl_dim_t lda = dim_m_;
@@ -64,8 +82,29 @@ bool MatMulCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
   }
   auto input_a = reinterpret_cast<float *>(inputs[0]->addr);
   auto input_b = reinterpret_cast<float *>(inputs[1]->addr);
+  auto bias = has_bias_ ? reinterpret_cast<float *>(inputs[2]->addr) : nullptr;
   auto output = reinterpret_cast<float *>(outputs[0]->addr);
-  (void)dnnl_sgemm(trans_a_, trans_b_, dim_m_, dim_n_, dim_k_, 1.f, input_a, lda, input_b, ldb, 0.f, output, dim_n_);
+  // The sgemm of the sequential mkldnn runtime uses one thread, the rows of the output are split over the pool. A
+  // thread computes at least kMinParallelElements products.
+  size_t n = LongToSize(dim_n_);
+  size_t row_products = std::max<size_t>(n * LongToSize(dim_k_), 1);
+  size_t min_rows = std::max<size_t>(kMinParallelElements / row_products, 1);
+  auto task = [this, input_a, input_b, bias, output, lda, ldb, n](size_t begin, size_t end) {
+    float *out = output + begin * n;
+    if (has_bias_) {
+      for (size_t i = begin; i < end; ++i) {
+        (void)std::copy(bias, bias + n, output + i * n);
+      }
+    }
+    // Row i of A is at i * lda when A is not transposed, column i of the stored matrix otherwise
+    const float *a = input_a + (trans_a_ == TRANSPOSE_NO ? begin * LongToSize(lda) : begin);
+    (void)dnnl_sgemm(trans_a_, trans_b_, SizeToLong(end - begin), dim_n_, dim_k_, 1.f, a, lda, input_b, ldb,
+                     has_bias_ ? 1.f : 0.f, out, dim_n_);
+    if (has_activation_) {
+      ElementwiseUnary(activation_, out, out, (end - begin) * n);
+    }
+  };
+  CPUThreadPool::GetInstance().ParallelFor(LongToSize(dim_m_), task, min_rows);
   return true;
 }
 }  // namespace cpu
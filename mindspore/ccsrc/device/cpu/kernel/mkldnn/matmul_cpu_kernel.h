@@ -19,6 +19,7 @@
 #include <vector>
 #include <memory>
 #include "device/cpu/kernel/mkldnn/mkl_cpu_kernel.h"
+#include "device/cpu/kernel/cpu_vector_ops.h"
 
 namespace mindspore {
 namespace device {
@@ -39,6 +40,9 @@ class MatMulCPUKernel : public MKLCPUKernel {
   dnnl_dim_t dim_m_{0};
   dnnl_dim_t dim_n_{0};
   dnnl_dim_t dim_k_{0};
+  bool has_bias_{false};
+  bool has_activation_{false};
+  UnaryOpType activation_{UnaryOpType::kRelu};
 };
 
 MS_REG_CPU_KERNEL(MatMul, MatMulCPUKernel);
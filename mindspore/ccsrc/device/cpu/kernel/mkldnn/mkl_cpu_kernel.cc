@@ -87,6 +87,22 @@ dnnl::memory::desc MKLCPUKernel::GetDefaultMemDesc(const std::vector<size_t> &sh
   return mem_desc;
 }
 
+dnnl::post_ops MKLCPUKernel::GetActivationPostOps(const std::string &activation) const {
+  dnnl::post_ops ops;
+  if (activation == "ReLU") {
+    ops.append_eltwise(1.0f, dnnl::algorithm::eltwise_relu, 0.0f, 0.0f);
+  } else if (activation == "ReLU6") {
+    ops.append_eltwise(1.0f, dnnl::algorithm::eltwise_bounded_relu, 6.0f, 0.0f);
+  } else if (activation == "Sigmoid") {
+    ops.append_eltwise(1.0f, dnnl::algorithm::eltwise_logistic, 0.0f, 0.0f);
+  } else if (activation == "Tanh") {
+    ops.append_eltwise(1.0f, dnnl::algorithm::eltwise_tanh, 0.0f, 0.0f);
+  } else {
+    MS_LOG(EXCEPTION) << "activation " << activation << " can not be fused";
+  }
+  return ops;
+}
+
 void MKLCPUKernel::AddArgument(int arg_key, const dnnl::memory::desc &mem_desc, bool alloc) {
   arguments_[arg_key] = MKLKernelEngine::Get().CreateMemory(mem_desc, alloc);
 }
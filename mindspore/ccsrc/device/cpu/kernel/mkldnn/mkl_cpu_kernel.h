@@ -39,6 +39,8 @@ class MKLCPUKernel : public CPUKernel {
   void SetArgumentHandle(int arg_key, void *ptr);
   dnnl::memory::format_tag GetDefaultFormatTag(const dnnl::memory::dims &dims) const;
   dnnl::memory::desc GetDefaultMemDesc(const std::vector<size_t> &shape);
+  // The eltwise post-op of an activation fused into the primitive, ReLU, ReLU6, Sigmoid or Tanh
+  dnnl::post_ops GetActivationPostOps(const std::string &activation) const;
   void ExecutePrimitive();
   std::unordered_map<int, dnnl::memory> arguments_;
   std::shared_ptr<dnnl::primitive> primitive_{nullptr};
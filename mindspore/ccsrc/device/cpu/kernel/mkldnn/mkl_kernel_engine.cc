@@ -23,8 +23,10 @@ namespace cpu {
 void MKLKernelEngine::Execute(const std::shared_ptr<dnnl::primitive> &primitive,
                               const std::unordered_map<int, dnnl::memory> &arguments) {
   MS_EXCEPTION_IF_NULL(primitive);
-  primitive->execute(stream_, arguments);
-  (void)stream_.wait();
+  // kernels may run on several threads at the same time, each thread uses its own stream
+  thread_local dnnl::stream stream(engine_);
+  primitive->execute(stream, arguments);
+  (void)stream.wait();
 }
 
 dnnl::memory MKLKernelEngine::CreateMemory(const dnnl::memory::desc &mem_desc, bool alloc) {
@@ -0,0 +1,164 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "device/cpu/kernel/reduce_cpu_kernel.h"
+#include <algorithm>
+#include <limits>
+#include <string>
+#include "device/cpu/kernel/cpu_vector_ops.h"
+#include "device/cpu/cpu_thread_pool.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+void ReduceCPUKernel::InitKernel(const CNodePtr &kernel_node) {
+  MS_EXCEPTION_IF_NULL(kernel_node);
+  std::string kernel_name = AnfAlgo::GetCNodeName(kernel_node);
+  is_max_ = kernel_name == "ReduceMax";
+  is_mean_ = kernel_name == "ReduceMean";
+  if (IsIntStorageType(AnfAlgo::GetPrevNodeOutputInferDataType(kernel_node, 0))) {
+    MS_LOG(EXCEPTION) << kernel_name << " only supports float input, cast the int input first";
+  }
+  std::vector<size_t> shape = AnfAlgo::GetInputDeviceShape(kernel_node, 0);
+  int rank = SizeToInt(shape.size());
+
+  std::vector<int> axis;
+  auto primitive = AnfAlgo::GetCNodePrimitive(kernel_node);
+  MS_EXCEPTION_IF_NULL(primitive);
+  auto axis_attr = primitive->GetAttr(AXIS);
+  MS_EXCEPTION_IF_NULL(axis_attr);
+  if (axis_attr->isa<ValueSequeue>()) {
+    axis = AnfAlgo::GetNodeAttr<std::vector<int>>(kernel_node, AXIS);
+  } else if (axis_attr->isa<Int32Imm>()) {
+    axis.push_back(AnfAlgo::GetNodeAttr<int>(kernel_node, AXIS));
+  } else {
+    MS_LOG(EXCEPTION) << kernel_name << " attribute axis type is invalid";
+  }
+  // An empty axis reduces all the dimensions
+  std::vector<bool> reduced(shape.size(), axis.empty());
+  for (int dim : axis) {
+    if (dim < -rank || dim >= rank) {
+      MS_LOG(EXCEPTION) << kernel_name << " axis " << dim << " out of range for dims " << rank;
+    }
+    reduced[IntToSize(dim < 0 ? dim + rank : dim)] = true;
+  }
+
+  groups_.clear();
+  input_num_ = 1;
+  output_num_ = 1;
+  for (size_t i = 0; i < shape.size(); ++i) {
+    input_num_ *= shape[i];
+    if (!reduced[i]) {
+      output_num_ *= shape[i];
+    }
+    if (shape[i] == 1) {
+      continue;
+    }
+    if (!groups_.empty() && groups_.back().reduced == reduced[i]) {
+      groups_.back().size *= shape[i];
+    } else {
+      groups_.push_back({shape[i], reduced[i], 0, 0});
+    }
+  }
+  if (groups_.empty()) {
+    groups_.push_back({1, false, 0, 0});
+  }
+  size_t input_stride = 1;
+  size_t output_stride = 1;
+  for (size_t i = groups_.size(); i > 0; --i) {
+    auto &group = groups_[i - 1];
+    group.input_stride = input_stride;
+    group.output_stride = group.reduced ? 0 : output_stride;
+    input_stride *= group.size;
+    output_stride *= group.reduced ? 1 : group.size;
+  }
+  parallel_level_ = groups_.size();
+  for (size_t i = 0; i < groups_.size(); ++i) {
+    if (!groups_[i].reduced) {
+      parallel_level_ = i;
+      break;
+    }
+  }
+}
+
+void ReduceCPUKernel::Accumulate(size_t level, const float *input, float *output, size_t begin, size_t end) const {
+  const auto &group = groups_[level];
+  size_t first = level == parallel_level_ ? begin : 0;
+  size_t last = level == parallel_level_ ? end : group.size;
+  if (level + 1 == groups_.size()) {
+    if (group.reduced) {
+      float value = is_max_ ? ReduceMax(input, group.size) : ReduceSum(input, group.size);
+      *output = is_max_ ? std::max(*output, value) : *output + value;
+    } else {
+      ElementwiseBinary(is_max_ ? BinaryOpType::kMaximum : BinaryOpType::kAdd, output + first, 1, input + first, 1,
+                        output + first, last - first);
+    }
+    return;
+  }
+  for (size_t i = first; i < last; ++i) {
+    Accumulate(level + 1, input + i * group.input_stride, output + i * group.output_stride, begin, end);
+  }
+}
+
+void ReduceCPUKernel::ReduceAll(const float *input, float *output) const {
+  // Each chunk is reduced apart, the partial results are then combined in order
+  size_t chunk_num = std::max<size_t>((input_num_ + kMinParallelElements - 1) / kMinParallelElements, 1);
+  std::vector<float> partial(chunk_num);
+  CPUThreadPool::GetInstance().ParallelFor(chunk_num, [this, input, &partial](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      size_t offset = i * kMinParallelElements;
+      size_t count = std::min(kMinParallelElements, input_num_ - offset);
+      partial[i] = is_max_ ? ReduceMax(input + offset, count) : ReduceSum(input + offset, count);
+    }
+  });
+  *output = is_max_ ? ReduceMax(partial.data(), chunk_num) : ReduceSum(partial.data(), chunk_num);
+}
+
+bool ReduceCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
+                             const std::vector<kernel::AddressPtr> & /*workspace*/,
+                             const std::vector<kernel::AddressPtr> &outputs) {
+  if (inputs.empty() || outputs.empty()) {
+    MS_LOG(EXCEPTION) << "input or output empty!";
+  }
+  if (inputs[0]->size != input_num_ * sizeof(float) || outputs[0]->size != output_num_ * sizeof(float)) {
+    MS_LOG(EXCEPTION) << "invalid input or output data size!";
+  }
+  auto input = reinterpret_cast<float *>(inputs[0]->addr);
+  auto output = reinterpret_cast<float *>(outputs[0]->addr);
+  if (input_num_ == 0) {
+    std::fill(output, output + output_num_, is_max_ ? -std::numeric_limits<float>::infinity() : 0.0f);
+    return true;
+  }
+
+  if (parallel_level_ == groups_.size()) {
+    ReduceAll(input, output);
+  } else {
+    std::fill(output, output + output_num_, is_max_ ? -std::numeric_limits<float>::infinity() : 0.0f);
+    size_t parallel_size = groups_[parallel_level_].size;
+    size_t work_per_index = input_num_ / parallel_size;
+    size_t min_part_size = (kMinParallelElements + work_per_index - 1) / work_per_index;
+    CPUThreadPool::GetInstance().ParallelFor(
+      parallel_size, [this, input, output](size_t begin, size_t end) { Accumulate(0, input, output, begin, end); },
+      min_part_size);
+  }
+  if (is_mean_) {
+    float scale = static_cast<float>(output_num_) / static_cast<float>(input_num_);
+    ElementwiseBinary(BinaryOpType::kMul, output, 1, &scale, 0, output, output_num_);
+  }
+  return true;
+}
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
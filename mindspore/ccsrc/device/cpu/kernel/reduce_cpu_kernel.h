@@ -0,0 +1,65 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_DEVICE_CPU_REDUCE_CPU_KERNEL_H_
+#define MINDSPORE_CCSRC_DEVICE_CPU_REDUCE_CPU_KERNEL_H_
+#include <vector>
+#include <memory>
+#include "device/cpu/cpu_kernel.h"
+#include "device/cpu/cpu_kernel_factory.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+// The adjacent input dimensions that are all reduced or all kept are merged into groups. The output is initialized,
+// then every group of the input is accumulated into it, the innermost group by one vector loop.
+class ReduceCPUKernel : public CPUKernel {
+ public:
+  ReduceCPUKernel() = default;
+  ~ReduceCPUKernel() override = default;
+
+  void InitKernel(const CNodePtr &kernel_node) override;
+
+  bool Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
+              const std::vector<AddressPtr> &outputs) override;
+
+ private:
+  struct DimGroup {
+    size_t size;
+    bool reduced;
+    size_t input_stride;
+    size_t output_stride;
+  };
+  // Accumulates the input under group level into the output, only [begin, end) of the parallel group is visited
+  void Accumulate(size_t level, const float *input, float *output, size_t begin, size_t end) const;
+  void ReduceAll(const float *input, float *output) const;
+
+  bool is_max_{false};
+  bool is_mean_{false};
+  std::vector<DimGroup> groups_;
+  // The first kept group, whose indices write apart outputs, or groups_.size() when all are reduced
+  size_t parallel_level_{0};
+  size_t input_num_{1};
+  size_t output_num_{1};
+};
+
+MS_REG_CPU_KERNEL(ReduceSum, ReduceCPUKernel);
+MS_REG_CPU_KERNEL(ReduceMean, ReduceCPUKernel);
+MS_REG_CPU_KERNEL(ReduceMax, ReduceCPUKernel);
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_DEVICE_CPU_REDUCE_CPU_KERNEL_H_
@@ -0,0 +1,60 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "device/cpu/kernel/select_cpu_kernel.h"
+#include "device/cpu/kernel/cpu_vector_ops.h"
+#include "device/cpu/cpu_thread_pool.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+void SelectCPUKernel::InitKernel(const CNodePtr &kernel_node) {
+  MS_EXCEPTION_IF_NULL(kernel_node);
+  std::vector<size_t> cond_shape = AnfAlgo::GetInputDeviceShape(kernel_node, 0);
+  std::vector<size_t> x_shape = AnfAlgo::GetInputDeviceShape(kernel_node, 1);
+  std::vector<size_t> y_shape = AnfAlgo::GetInputDeviceShape(kernel_node, 2);
+  if (cond_shape != x_shape || x_shape != y_shape) {
+    MS_LOG(EXCEPTION) << "select kernel needs the condition and values of the same shape";
+  }
+  if (IsIntStorageType(AnfAlgo::GetPrevNodeOutputInferDataType(kernel_node, 1))) {
+    MS_LOG(EXCEPTION) << "select kernel only supports float values, cast the int values first";
+  }
+}
+
+bool SelectCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
+                             const std::vector<kernel::AddressPtr> & /*workspace*/,
+                             const std::vector<kernel::AddressPtr> &outputs) {
+  if (inputs.size() < 3 || outputs.empty()) {
+    MS_LOG(EXCEPTION) << "select error input output size!";
+  }
+  size_t size = outputs[0]->size;
+  if (inputs[0]->size != size || inputs[1]->size != size || inputs[2]->size != size) {
+    MS_LOG(EXCEPTION) << "select error input data size!";
+  }
+  auto cond = reinterpret_cast<float *>(inputs[0]->addr);
+  auto x = reinterpret_cast<float *>(inputs[1]->addr);
+  auto y = reinterpret_cast<float *>(inputs[2]->addr);
+  auto output = reinterpret_cast<float *>(outputs[0]->addr);
+  CPUThreadPool::GetInstance().ParallelFor(
+    size / sizeof(float),
+    [cond, x, y, output](size_t begin, size_t end) {
+      ElementwiseSelect(cond + begin, x + begin, y + begin, output + begin, end - begin);
+    },
+    kMinParallelElements);
+  return true;
+}
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
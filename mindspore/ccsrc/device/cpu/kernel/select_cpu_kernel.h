@@ -13,20 +13,21 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
-#ifndef MINDSPORE_CCSRC_DEVICE_CPU_MUL_CPU_KERNEL_H_
-#define MINDSPORE_CCSRC_DEVICE_CPU_MUL_CPU_KERNEL_H_
-
+#ifndef MINDSPORE_CCSRC_DEVICE_CPU_SELECT_CPU_KERNEL_H_
+#define MINDSPORE_CCSRC_DEVICE_CPU_SELECT_CPU_KERNEL_H_
 #include <vector>
 #include <memory>
-#include "device/cpu/kernel/mkldnn/mkl_cpu_kernel.h"
+#include "device/cpu/cpu_kernel.h"
+#include "device/cpu/cpu_kernel_factory.h"
 
 namespace mindspore {
 namespace device {
 namespace cpu {
-class MulCPUKernel : public MKLCPUKernel {
+// The condition is a bool tensor of the shape of the values, stored as 1.0 and 0.0 floats
+class SelectCPUKernel : public CPUKernel {
  public:
-  MulCPUKernel() = default;
-  ~MulCPUKernel() override = default;
+  SelectCPUKernel() = default;
+  ~SelectCPUKernel() override = default;
 
   void InitKernel(const CNodePtr &kernel_node) override;
 
@@ -34,9 +35,9 @@ class MulCPUKernel : public MKLCPUKernel {
               const std::vector<AddressPtr> &outputs) override;
 };
 
-MS_REG_CPU_KERNEL(Mul, MulCPUKernel);
+MS_REG_CPU_KERNEL(Select, SelectCPUKernel);
 }  // namespace cpu
 }  // namespace device
 }  // namespace mindspore
 
-#endif  // MINDSPORE_CCSRC_DEVICE_CPU_MUL_CPU_KERNEL_H_
+#endif  // MINDSPORE_CCSRC_DEVICE_CPU_SELECT_CPU_KERNEL_H_
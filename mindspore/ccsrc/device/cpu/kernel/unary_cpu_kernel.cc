@@ -0,0 +1,75 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "device/cpu/kernel/unary_cpu_kernel.h"
+#include <map>
+#include <string>
+#include "device/cpu/cpu_thread_pool.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+namespace {
+const std::map<std::string, UnaryOpType> kUnaryOpTypes = {
+  {"Neg", UnaryOpType::kNeg},       {"Abs", UnaryOpType::kAbs},     {"Square", UnaryOpType::kSquare},
+  {"Sqrt", UnaryOpType::kSqrt},     {"Rsqrt", UnaryOpType::kRsqrt}, {"Reciprocal", UnaryOpType::kReciprocal},
+  {"Exp", UnaryOpType::kExp},       {"Log", UnaryOpType::kLog},     {"Sigmoid", UnaryOpType::kSigmoid},
+  {"Tanh", UnaryOpType::kTanh},     {"ReLU6", UnaryOpType::kRelu6}, {"ReLU", UnaryOpType::kRelu}};
+}  // namespace
+
+bool GetUnaryOpType(const std::string &kernel_name, UnaryOpType *op_type) {
+  MS_EXCEPTION_IF_NULL(op_type);
+  auto iter = kUnaryOpTypes.find(kernel_name);
+  if (iter == kUnaryOpTypes.end()) {
+    return false;
+  }
+  *op_type = iter->second;
+  return true;
+}
+
+void UnaryCPUKernel::InitKernel(const CNodePtr &kernel_node) {
+  MS_EXCEPTION_IF_NULL(kernel_node);
+  std::string kernel_name = AnfAlgo::GetCNodeName(kernel_node);
+  if (!GetUnaryOpType(kernel_name, &op_type_)) {
+    MS_LOG(EXCEPTION) << "unary kernel not support " << kernel_name;
+  }
+  if (IsIntStorageType(AnfAlgo::GetPrevNodeOutputInferDataType(kernel_node, 0))) {
+    MS_LOG(EXCEPTION) << kernel_name << " only supports float input, cast the int input first";
+  }
+}
+
+bool UnaryCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
+                            const std::vector<kernel::AddressPtr> & /*workspace*/,
+                            const std::vector<kernel::AddressPtr> &outputs) {
+  if (inputs.empty() || outputs.empty()) {
+    MS_LOG(EXCEPTION) << "input or output empty!";
+  }
+  if (inputs[0]->size != outputs[0]->size) {
+    MS_LOG(EXCEPTION) << "invalid input or output data size!";
+  }
+  auto input = reinterpret_cast<float *>(inputs[0]->addr);
+  auto output = reinterpret_cast<float *>(outputs[0]->addr);
+  size_t elem_num = outputs[0]->size / sizeof(float);
+  CPUThreadPool::GetInstance().ParallelFor(
+    elem_num,
+    [this, input, output](size_t begin, size_t end) {
+      ElementwiseUnary(op_type_, input + begin, output + begin, end - begin);
+    },
+    kMinParallelElements);
+  return true;
+}
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
@@ -0,0 +1,61 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_DEVICE_CPU_UNARY_CPU_KERNEL_H_
+#define MINDSPORE_CCSRC_DEVICE_CPU_UNARY_CPU_KERNEL_H_
+#include <vector>
+#include <memory>
+#include <string>
+#include "device/cpu/cpu_kernel.h"
+#include "device/cpu/cpu_kernel_factory.h"
+#include "device/cpu/kernel/cpu_vector_ops.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+// The vector op of a unary kernel name, false if the name is unknown. ReLU is known for the fused kernels, the ReLU
+// kernel itself stays the mkldnn one.
+bool GetUnaryOpType(const std::string &kernel_name, UnaryOpType *op_type);
+
+class UnaryCPUKernel : public CPUKernel {
+ public:
+  UnaryCPUKernel() = default;
+  ~UnaryCPUKernel() override = default;
+
+  void InitKernel(const CNodePtr &kernel_node) override;
+
+  bool Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
+              const std::vector<AddressPtr> &outputs) override;
+
+ private:
+  UnaryOpType op_type_{UnaryOpType::kNeg};
+};
+
+MS_REG_CPU_KERNEL(Neg, UnaryCPUKernel);
+MS_REG_CPU_KERNEL(Abs, UnaryCPUKernel);
+MS_REG_CPU_KERNEL(Square, UnaryCPUKernel);
+MS_REG_CPU_KERNEL(Sqrt, UnaryCPUKernel);
+MS_REG_CPU_KERNEL(Rsqrt, UnaryCPUKernel);
+MS_REG_CPU_KERNEL(Reciprocal, UnaryCPUKernel);
+MS_REG_CPU_KERNEL(Exp, UnaryCPUKernel);
+MS_REG_CPU_KERNEL(Log, UnaryCPUKernel);
+MS_REG_CPU_KERNEL(Sigmoid, UnaryCPUKernel);
+MS_REG_CPU_KERNEL(Tanh, UnaryCPUKernel);
+MS_REG_CPU_KERNEL(ReLU6, UnaryCPUKernel);
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_DEVICE_CPU_UNARY_CPU_KERNEL_H_
@@ -70,6 +70,8 @@ enum ShardType {
 
 enum SamplerType { kCustomTopNSampler, kCustomTopPercentSampler, kSubsetRandomSampler, kPKSampler };
 
+enum CompressionType { kCompressionNone = 0, kCompressionLz4 = 1, kCompressionZstd = 2 };
+
 const double kEpsilon = 1e-7;
 
 const int kThreadNumber = 14;
@@ -102,6 +104,18 @@ const int kMaxSchemaCount = 1;
 const int kMaxThreadCount = 32;
 const int kMaxFieldCount = 100;
 
+// Index build: variables bound in one insert, the default limit of sqlite, and raw pages scanned ahead by a worker
+const int kMaxSqlVariables = 999;
+const int kNumPageToScanAhead = 2;
+
+// Async write: batches queued for the background flush while the next one is serialized, and the alignment of
+// direct io
+const int kWriteQueueDepth = 1;
+const uint64_t kDirectIoAlignment = 4096;
+
+// Level of zstd compressed blob pages
+const int kZstdLevel = 3;
+
 // Minimum free disk size
 const int kMinFreeDiskSize = 10;  // 10M
 
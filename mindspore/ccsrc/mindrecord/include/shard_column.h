@@ -0,0 +1,130 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDRECORD_INCLUDE_SHARD_COLUMN_H_
+#define MINDRECORD_INCLUDE_SHARD_COLUMN_H_
+
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+#include "mindrecord/include/common/shard_utils.h"
+#include "mindrecord/include/shard_error.h"
+#include "mindrecord/include/shard_schema.h"
+
+namespace mindspore {
+namespace mindrecord {
+enum ColumnDataType { ColumnInt32 = 0, ColumnInt64 = 1, ColumnFloat32 = 2, ColumnFloat64 = 3, ColumnString = 4 };
+
+// First byte of a raw row in the binary label format. msgpack never uses it, so rows written
+// by older versions as msgpack are told apart by their first byte.
+const uint8_t kBinaryRowMarker = 0xc1;
+
+/// \brief Typed values of the non-blob columns of a schema, one array per column.
+///        Also the codec of raw rows: the binary label format is the marker byte followed by the non-blob fields
+///        in schema order, numbers at their fixed width and strings as an 8 byte length and the characters.
+class ShardColumn {
+ public:
+  /// \brief hold the columns of a schema
+  /// \param[in] schema the schema of the rows
+  /// \param[in] columns the columns to hold, all of them if empty. Fields of msgpack rows which are not held in
+  ///            columns, like blob fields or fields out of the schema, are kept as json when they are asked for
+  explicit ShardColumn(const std::shared_ptr<Schema> &schema, const std::vector<std::string> &columns = {});
+
+  ~ShardColumn() = default;
+
+  /// \brief serialize a row in the binary label format
+  /// \param[in] row the non-blob fields of the row
+  /// \param[out] bin the serialized row
+  /// \return MSRStatus FAILED if a field is missing, out of the schema or of the wrong type
+  MSRStatus SerializeRow(const json &row, std::vector<uint8_t> *bin) const;
+
+  /// \brief decode a raw row, in the binary label format or in msgpack
+  /// \param[in] data the raw row
+  /// \param[in] size size of the raw row
+  /// \param[out] row the fields of the row
+  /// \return MSRStatus the status of MSRStatus
+  MSRStatus DeserializeRow(const uint8_t *data, uint64_t size, json *row) const;
+
+  /// \brief append a raw row, in the binary label format or in msgpack
+  MSRStatus AppendRow(const uint8_t *data, uint64_t size);
+
+  /// \brief append a row of json fields
+  MSRStatus AppendRow(const json &row);
+
+  /// \brief append a row of values as text, like the fields of the index
+  /// \param[in] columns names of the values
+  /// \param[in] values the values, values[first_value + i] is the value of columns[i]
+  /// \param[in] first_value index of the first value
+  MSRStatus AppendRow(const std::vector<std::string> &columns, const std::vector<std::string> &values,
+                      size_t first_value = 0);
+
+  /// \brief get number of rows held
+  uint64_t num_rows() const { return num_rows_; }
+
+  /// \brief get names of the columns held
+  const std::vector<std::string> &get_column_names() const { return column_names_; }
+
+  /// \brief get id of a column held, -1 if it is not held
+  int GetColumnId(const std::string &column_name) const;
+
+  /// \brief get data type of a column held
+  ColumnDataType GetColumnType(int column_id) const { return column_types_[column_id]; }
+
+  /// \brief get the value of a column in a row
+  /// \param[in] row_id row id
+  /// \param[in] column_id column id
+  /// \param[out] data the value, a number of the column type or the characters of a string
+  /// \param[out] n_bytes size of the value
+  /// \return MSRStatus FAILED if the row or the column is out of range
+  MSRStatus GetColumnValue(uint64_t row_id, int column_id, const uint8_t **data, uint64_t *n_bytes) const;
+
+  /// \brief get the columns of a row as json
+  json GetRowJson(uint64_t row_id) const;
+
+ private:
+  /// \brief split a row in the binary label format into the values of its fields
+  MSRStatus SplitRow(const uint8_t *data, uint64_t size,
+                     std::vector<std::pair<const uint8_t *, uint64_t>> *fields) const;
+
+  /// \brief append the value of a field
+  MSRStatus AppendValue(int column_id, const json &value);
+
+  /// \brief append the raw value of a field
+  void AppendBytes(int column_id, const uint8_t *data, uint64_t n_bytes);
+
+  /// \brief get size of a value of a fixed width type
+  static uint64_t TypeSize(ColumnDataType type);
+
+  std::vector<std::string> schema_names_;              // names of the non-blob fields, in schema order
+  std::vector<ColumnDataType> schema_types_;           // types of the non-blob fields
+  std::vector<int> schema_to_column_;                  // column id of each non-blob field, -1 if not held
+  std::vector<std::string> column_names_;              // names of the columns held
+  std::vector<ColumnDataType> column_types_;           // types of the columns held
+  std::unordered_map<std::string, int> column_ids_;    // column name to column id
+  std::vector<std::vector<uint8_t>> values_;           // values of each column, or characters for strings
+  std::vector<std::vector<uint64_t>> string_offsets_;  // start of each string in values_, num_rows_ + 1 of them
+  std::unordered_set<std::string> extra_columns_;      // fields kept as json, all of them if empty
+  std::map<uint64_t, json> extra_fields_;              // fields kept as json, by row
+  uint64_t num_rows_;                                  // number of rows
+};
+}  // namespace mindrecord
+}  // namespace mindspore
+
+#endif  // MINDRECORD_INCLUDE_SHARD_COLUMN_H_
@@ -0,0 +1,62 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDRECORD_INCLUDE_SHARD_COMPRESSOR_H_
+#define MINDRECORD_INCLUDE_SHARD_COMPRESSOR_H_
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+#include "mindrecord/include/common/shard_utils.h"
+#include "mindrecord/include/shard_error.h"
+
+namespace mindspore {
+namespace mindrecord {
+/// \brief Codecs of compressed blob data. A compressed blob is its uncompressed size as 8 bytes followed by the
+///        compressed data: an LZ4 block or a zstd frame. Blob data which does not shrink follows the size as is.
+class ShardCompressor {
+ public:
+  /// \brief get the codec of a name
+  /// \param[in] name "none", "lz4" or "zstd"
+  /// \return the codec, FAILED if the name is unknown
+  static std::pair<MSRStatus, CompressionType> GetCompressionType(const std::string &name);
+
+  /// \brief get the name of a codec, as recorded in the page metadata
+  static std::string GetCompressionName(CompressionType compression);
+
+  /// \brief compress blob data
+  /// \param[in] compression the codec
+  /// \param[in] data the blob data
+  /// \param[in] size size of the blob data
+  /// \param[out] out the compressed blob
+  /// \return MSRStatus FAILED if the codec fails
+  static MSRStatus Compress(CompressionType compression, const uint8_t *data, uint64_t size,
+                            std::vector<uint8_t> *out);
+
+  /// \brief uncompress a compressed blob
+  /// \param[in] compression the codec
+  /// \param[in] data the compressed blob
+  /// \param[in] size size of the compressed blob
+  /// \param[out] out the blob data
+  /// \return MSRStatus FAILED if the compressed blob is broken
+  static MSRStatus Uncompress(CompressionType compression, const uint8_t *data, uint64_t size,
+                              std::vector<uint8_t> *out);
+};
+}  // namespace mindrecord
+}  // namespace mindspore
+
+#endif  // MINDRECORD_INCLUDE_SHARD_COMPRESSOR_H_
@@ -103,6 +103,8 @@ class ShardHeader {
 
   const std::pair<MSRStatus, std::shared_ptr<Page>> GetPageByGroupId(const int &group_id, const int &shard_id);
 
+  bool HasCompressedPage() const;
+
   std::vector<std::string> get_shard_addresses() const { return shard_addresses_; }
 
   int get_shard_count() const { return shard_count_; }
@@ -145,7 +147,7 @@ class ShardHeader {
 
   MSRStatus CheckIndexField(const std::string &field, const json &schema);
 
-  void ParsePage(const json &page);
+  MSRStatus ParsePage(const json &page);
 
   MSRStatus ParseStatistics(const json &statistics);
 
@@ -17,14 +17,17 @@
 #ifndef MINDRECORD_INCLUDE_SHARD_INDEX_GENERATOR_H_
 #define MINDRECORD_INCLUDE_SHARD_INDEX_GENERATOR_H_
 
+#include <atomic>
 #include <fstream>
 #include <iostream>
 #include <map>
 #include <memory>
 #include <string>
 #include <tuple>
+#include <unordered_map>
 #include <utility>
 #include <vector>
+#include "mindrecord/include/shard_column.h"
 #include "mindrecord/include/shard_header.h"
 #include "./sqlite3.h"
 
@@ -32,6 +35,7 @@ namespace mindspore {
 namespace mindrecord {
 using INDEX_FIELDS = std::pair<MSRStatus, std::vector<std::tuple<std::string, std::string, std::string>>>;
 using ROW_DATA = std::pair<MSRStatus, std::vector<std::vector<std::tuple<std::string, std::string, std::string>>>>;
+using PLACE_HOLDERS = std::pair<MSRStatus, std::vector<std::string>>;
 class ShardIndexGenerator {
  public:
   explicit ShardIndexGenerator(const std::string &file_path, bool append = false);
@@ -57,6 +61,11 @@ class ShardIndexGenerator {
   /// \brief create databases for indexes
   MSRStatus WriteToDatabase();
 
+  /// \brief set number of workers scanning the raw pages of a shard concurrently, in addition to the shards
+  ///        built concurrently. Call before WriteToDatabase
+  /// \param[in] num_scan_workers number of workers per shard, 0 to share the cores among the shards
+  void set_num_scan_workers(int num_scan_workers) { num_scan_workers_ = num_scan_workers; }
+
  private:
   static int Callback(void *not_used, int argc, char **argv, char **az_col_name);
 
@@ -68,7 +77,11 @@ class ShardIndexGenerator {
 
   std::pair<MSRStatus, std::vector<json>> GetSchemaDetails(const std::vector<uint64_t> &schema_lens, std::fstream &in);
 
-  static std::pair<MSRStatus, std::string> GenerateRawSQL(const std::vector<std::pair<uint64_t, std::string>> &fields);
+  /// \brief get the place holders of the index fields, in the order of the columns of the index table
+  static PLACE_HOLDERS GeneratePlaceHolders(const std::vector<std::pair<uint64_t, std::string>> &fields);
+
+  /// \brief get the statement inserting rows of the index fields at once, bound by position
+  static std::string GenerateRawSQL(const std::vector<std::string> &place_holders, uint64_t num_rows);
 
   std::pair<MSRStatus, sqlite3 *> CheckDatabase(const std::string &shard_address);
 
@@ -81,18 +94,29 @@ class ShardIndexGenerator {
   ROW_DATA GenerateRowData(int shard_no, const std::map<int, int> &blob_id_to_page_id, int raw_page_id,
                            std::fstream &in);
   ///
-  /// \param db
-  /// \param sql
-  /// \param data
+  /// \param stmt prepared statement inserting num_rows rows
+  /// \param place_holder_ids position of each place holder in a row
+  /// \param data rows of field name, db type, field value
+  /// \param start first row to insert
+  /// \param num_rows number of rows to insert
   /// \return
   MSRStatus BindParameterExecuteSQL(
-    sqlite3 *db, const std::string &sql,
-    const std::vector<std::vector<std::tuple<std::string, std::string, std::string>>> &data);
+    sqlite3_stmt *stmt, const std::unordered_map<std::string, int> &place_holder_ids,
+    const std::vector<std::vector<std::tuple<std::string, std::string, std::string>>> &data, uint64_t start,
+    uint64_t num_rows);
+
+  /// \brief insert rows of index fields, by statements of as many rows as sqlite binds
+  MSRStatus InsertRows(sqlite3 *db, const std::vector<std::string> &place_holders,
+                       const std::vector<std::vector<std::tuple<std::string, std::string, std::string>>> &data);
+
+  /// \brief create the indexes of the index table, after all its rows are inserted
+  MSRStatus CreateIndexes(sqlite3 *db);
 
   INDEX_FIELDS GenerateIndexFields(const std::vector<json> &schema_detail);
 
   MSRStatus ExecuteTransaction(const int &shard_no, const std::pair<MSRStatus, sqlite3 *> &db,
-                               const std::vector<int> &raw_page_ids, const std::map<int, int> &blob_id_to_page_id);
+                               const std::vector<int> &raw_page_ids, const std::map<int, int> &blob_id_to_page_id,
+                               int num_scanners);
 
   MSRStatus CreateShardNameTable(sqlite3 *db, const std::string &shard_name);
 
@@ -103,7 +127,7 @@ class ShardIndexGenerator {
   void AddIndexFieldByRawData(const std::vector<json> &schema_detail,
                               std::vector<std::tuple<std::string, std::string, std::string>> &row_data);
 
-  void DatabaseWriter();  // worker thread
+  void DatabaseWriter(int num_scanners);  // worker thread
 
   std::string file_path_;
   bool append_;
@@ -111,6 +135,8 @@ class ShardIndexGenerator {
   uint64_t page_size_;
   uint64_t header_size_;
   int schema_count_;
+  std::vector<std::shared_ptr<ShardColumn>> shard_columns_;
+  int num_scan_workers_;
   std::atomic_int task_;
   std::atomic_bool write_success_;
   std::vector<std::pair<uint64_t, std::string>> fields_;
@@ -0,0 +1,166 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDRECORD_INCLUDE_SHARD_IO_ENGINE_H_
+#define MINDRECORD_INCLUDE_SHARD_IO_ENGINE_H_
+
+#include <sys/uio.h>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "mindrecord/include/shard_error.h"
+
+namespace mindspore {
+namespace mindrecord {
+/// \brief Asynchronous positional reads of file ranges, with up to queue_depth reads in flight.
+///        Reads are submitted and reaped by one thread, completions come back in any order.
+class ShardIoEngine {
+ public:
+  /// \brief create an engine on io_uring if the kernel supports it, on a pool of pread threads otherwise
+  /// \param[in] queue_depth number of reads in flight
+  /// \param[in] try_io_uring use io_uring when available
+  /// \return the engine, nullptr if neither backend could be set up
+  static std::unique_ptr<ShardIoEngine> Create(int queue_depth, bool try_io_uring = true);
+
+  explicit ShardIoEngine(int queue_depth);
+
+  virtual ~ShardIoEngine() = default;
+
+  /// \brief set up the backend
+  /// \return MSRStatus the status of MSRStatus
+  virtual MSRStatus Init() = 0;
+
+  /// \brief start reading length bytes of fd at offset into buf, the buffer must stay valid until the read is reaped
+  /// \param[in] fd file descriptor
+  /// \param[in] offset offset in file
+  /// \param[in] length number of bytes to read
+  /// \param[in] buf destination
+  /// \param[in] tag returned when the read is reaped
+  /// \return MSRStatus FAILED if queue_depth reads are in flight already
+  MSRStatus Submit(int fd, uint64_t offset, uint64_t length, uint8_t *buf, uint64_t tag);
+
+  /// \brief wait until one of the reads in flight is done
+  /// \param[out] tag tag of the read
+  /// \return MSRStatus FAILED if nothing is in flight, or if the read failed or hit the end of file
+  MSRStatus Reap(uint64_t *tag);
+
+  /// \brief wait until all the reads in flight are done, whatever their results
+  void Drain();
+
+  /// \brief get number of reads in flight
+  int in_flight() const { return in_flight_; }
+
+  /// \brief get number of reads in flight allowed
+  int queue_depth() const { return queue_depth_; }
+
+  /// \brief get the name of the backend
+  virtual const char *name() const = 0;
+
+ protected:
+  /// \brief one read in flight, short reads are resubmitted for the rest of the range
+  struct Request {
+    int fd;
+    uint64_t offset;
+    uint64_t remaining;
+    struct iovec iov;
+    uint64_t tag;
+  };
+
+  /// \brief queue the read of a slot to the backend
+  virtual MSRStatus SubmitSlot(int slot) = 0;
+
+  /// \brief wait for the backend to finish a read
+  /// \param[out] slot slot of the read
+  /// \param[out] result number of bytes read, or -errno
+  virtual MSRStatus WaitSlot(int *slot, int64_t *result) = 0;
+
+  int queue_depth_;
+  int in_flight_;
+  std::vector<Request> slots_;
+  std::vector<int> free_slots_;
+  std::deque<int> done_;  // empty reads, done without the backend
+};
+
+/// \brief ShardIoEngine on a pool of threads running blocking preads
+class ShardIoThreadPool : public ShardIoEngine {
+ public:
+  explicit ShardIoThreadPool(int queue_depth);
+
+  ~ShardIoThreadPool() override;
+
+  MSRStatus Init() override;
+
+  const char *name() const override { return "thread pool"; }
+
+ protected:
+  MSRStatus SubmitSlot(int slot) override;
+
+  MSRStatus WaitSlot(int *slot, int64_t *result) override;
+
+ private:
+  void IoThread();
+
+  std::vector<std::thread> threads_;
+  std::mutex mtx_;
+  std::condition_variable cv_submit_;
+  std::condition_variable cv_complete_;
+  std::deque<int> submitted_;
+  std::deque<std::pair<int, int64_t>> completed_;
+  bool stop_;
+};
+
+/// \brief ShardIoEngine on an io_uring, driven by raw system calls
+class ShardIoUring : public ShardIoEngine {
+ public:
+  explicit ShardIoUring(int queue_depth);
+
+  ~ShardIoUring() override;
+
+  MSRStatus Init() override;
+
+  const char *name() const override { return "io_uring"; }
+
+ protected:
+  MSRStatus SubmitSlot(int slot) override;
+
+  MSRStatus WaitSlot(int *slot, int64_t *result) override;
+
+ private:
+  int ring_fd_;
+  void *sq_ring_;
+  void *cq_ring_;
+  void *sqes_;
+  size_t sq_ring_size_;
+  size_t cq_ring_size_;
+  size_t sqes_size_;
+  // Pointers into the shared rings
+  unsigned *sq_tail_;
+  unsigned *sq_mask_;
+  unsigned *sq_array_;
+  unsigned *cq_head_;
+  unsigned *cq_tail_;
+  unsigned *cq_mask_;
+  void *cqes_;
+};
+}  // namespace mindrecord
+}  // namespace mindspore
+
+#endif  // MINDRECORD_INCLUDE_SHARD_IO_ENGINE_H_
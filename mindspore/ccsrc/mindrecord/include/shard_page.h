@@ -37,7 +37,8 @@ class Page {
  public:
   Page(const int &page_id, const int &shard_id, const std::string &page_type, const int &page_type_id,
        const uint64_t &start_row_id, const uint64_t end_row_id,
-       const std::vector<std::pair<int, uint64_t>> &row_group_ids, const uint64_t page_size)
+       const std::vector<std::pair<int, uint64_t>> &row_group_ids, const uint64_t page_size,
+       const CompressionType compression = kCompressionNone)
       : page_id_(page_id),
         shard_id_(shard_id),
         page_type_(page_type),
@@ -45,7 +46,8 @@ class Page {
         start_row_id_(start_row_id),
         end_row_id_(end_row_id),
         row_group_ids_(row_group_ids),
-        page_size_(page_size) {}
+        page_size_(page_size),
+        compression_(compression) {}
 
   ~Page() = default;
 
@@ -71,6 +73,8 @@ class Page {
 
   void set_page_size(const uint64_t &page_size) { page_size_ = page_size; }
 
+  CompressionType get_compression() const { return compression_; }
+
   std::pair<int, uint64_t> get_last_row_group_id() const { return row_group_ids_.back(); }
 
   std::vector<std::pair<int, uint64_t>> get_row_group_ids() const { return row_group_ids_; }
@@ -90,6 +94,7 @@ class Page {
   uint64_t end_row_id_;
   std::vector<std::pair<int, uint64_t>> row_group_ids_;
   uint64_t page_size_;
+  CompressionType compression_;
   // JSON page: {
   //            "page_id":X,
   //            "shard_id":X,
@@ -99,6 +104,7 @@ class Page {
   //            "end_row_id":X,
   //            "row_group_ids":[{"id":X, "offset":X}],
   //            "page_size":X,
+  //            "compression":"XXX", (enum "lz4", "zstd", blob pages only, absent if not compressed)
 };
 }  // namespace mindrecord
 }  // namespace mindspore
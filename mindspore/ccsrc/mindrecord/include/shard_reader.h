@@ -18,7 +18,9 @@
 #define MINDRECORD_INCLUDE_SHARD_READER_H_
 
 #include <dirent.h>
+#include <fcntl.h>
 #include <signal.h>
+#include <sys/mman.h>
 #include <sys/prctl.h>
 #include <sys/stat.h>
 #include <sys/types.h>
@@ -41,8 +43,11 @@
 #include <vector>
 #include "mindrecord/include/common/shard_utils.h"
 #include "mindrecord/include/shard_category.h"
+#include "mindrecord/include/shard_column.h"
+#include "mindrecord/include/shard_compressor.h"
 #include "mindrecord/include/shard_error.h"
 #include "mindrecord/include/shard_index_generator.h"
+#include "mindrecord/include/shard_io_engine.h"
 #include "mindrecord/include/shard_operator.h"
 #include "mindrecord/include/shard_reader.h"
 #include "mindrecord/include/shard_sample.h"
@@ -52,12 +57,16 @@
 namespace mindspore {
 namespace mindrecord {
 using ROW_GROUPS =
-  std::tuple<MSRStatus, std::vector<std::vector<std::vector<uint64_t>>>, std::vector<std::vector<json>>>;
+  std::tuple<MSRStatus, std::vector<std::vector<std::vector<uint64_t>>>, std::vector<std::shared_ptr<ShardColumn>>>;
 using ROW_GROUP_BRIEF =
   std::tuple<MSRStatus, std::string, int, uint64_t, std::vector<std::vector<uint64_t>>, std::vector<json>>;
 using TASK_RETURN_CONTENT = std::pair<MSRStatus, std::vector<std::tuple<std::vector<uint8_t>, json>>>;
-const int kNumBatchInMap = 1000;  // iterator buffer size in row-reader mode
-const int kNumPageInBuffer = 16;  // page buffer size in block-reader mode
+using BLOB_VIEW = std::pair<const uint8_t *, uint64_t>;  // start address and size of blob data in a mapped file
+using TASK_RETURN_VIEW = std::pair<MSRStatus, std::vector<std::tuple<BLOB_VIEW, json>>>;
+using LABEL_ROW = std::pair<const ShardColumn *, uint64_t>;  // label columns of a shard and row id in them
+const int kNumBatchInMap = 1000;    // iterator buffer size in row-reader mode
+const int kNumPageInBuffer = 16;    // page buffer size in block-reader mode
+const int kNumTaskToPrefetch = 64;  // number of upcoming tasks whose pages are prefetched in mmap mode
 
 class ShardReader {
  public:
@@ -71,10 +80,12 @@ class ShardReader {
   /// \param[in] selected_columns column list to be populated
   /// \param[in] operators operators applied to data, operator type is shuffle, sample or category
   /// \param[in] block_reader block-reader mode if true, otherwise row-reader mode
+  /// \param[in] use_mmap map the shard files into memory instead of reading them through file streams
   /// \return MSRStatus the status of MSRStatus
   MSRStatus Open(const std::string &file_path, int n_consumer = 4,
                  const std::vector<std::string> &selected_columns = {},
-                 const std::vector<std::shared_ptr<ShardOperator>> &operators = {}, const bool &block_reader = false);
+                 const std::vector<std::shared_ptr<ShardOperator>> &operators = {}, const bool &block_reader = false,
+                 const bool &use_mmap = false);
 
   /// \brief open files and initialize reader, python API
   /// \param[in] file_path the path of ONE file, any file in dataset is fine
@@ -172,6 +183,16 @@ class ShardReader {
   /// \return a batch of images and image data
   std::vector<std::tuple<std::vector<uint8_t>, json>> GetNextById(const int64_t &task_id, const int32_t &consumer_id);
 
+  /// \brief return a row by id without copying the blob data, row-reader mode with mmap only
+  /// \param[in] task_id task ID
+  /// \return a batch of views into the mapped files and image data. The views are valid until the reader is closed
+  std::vector<std::tuple<BLOB_VIEW, json>> GetNextViewById(const int64_t &task_id);
+
+  /// \brief get the typed label columns of a row by id, row-reader mode only
+  /// \param[in] task_id task ID
+  /// \return the label columns and the row id in them, nullptr if the labels of the row are only held as json
+  LABEL_ROW GetLabelRow(const int64_t &task_id);
+
   /// \brief return a batch in block-reader mode, given that one is ready
   /// \return a batch of images and image data
   std::vector<std::tuple<std::vector<uint8_t>, json>> GetBlockNext();
@@ -195,15 +216,33 @@ class ShardReader {
   /// \brief get NLP flag
   bool get_nlp_flag();
 
+  /// \brief get mmap flag
+  bool get_use_mmap() const { return use_mmap_; }
+
+  /// \brief get flag of compressed blob pages. Rows of compressed pages are not delivered as views
+  bool get_compressed() const { return compressed_; }
+
+  /// \brief set number of reads kept in flight by an async io engine, ahead of delivery. Call before Launch
+  /// \param[in] io_depth number of reads in flight, 0 for blocking reads by n_consumer threads
+  void set_io_depth(int io_depth) { io_depth_ = io_depth; }
+
+  /// \brief set flag of columnar labels. If set, rows are delivered without json labels in row-reader mode and
+  ///        their labels are read from GetLabelRow instead
+  void set_columnar_labels(bool columnar_labels) { columnar_labels_ = columnar_labels; }
+
  protected:
   /// \brief sqlite call back function
   static int SelectCallback(void *p_data, int num_fields, char **p_fields, char **p_col_names);
 
+  /// \brief uncompress the blob data of a row in place, if its page is compressed
+  MSRStatus UncompressBlob(CompressionType compression, std::vector<uint8_t> *blob);
+
  private:
-  /// \brief wrap up labels to json format
-  MSRStatus ConvertLabelToJson(const std::vector<std::vector<std::string>> &labels, std::shared_ptr<std::fstream> fs,
-                               std::vector<std::vector<std::vector<uint64_t>>> &offsets, int shard_id,
-                               const std::vector<std::string> &columns, std::vector<std::vector<json>> &column_values);
+  /// \brief wrap up labels to typed columns
+  MSRStatus ConvertLabelToColumns(const std::vector<std::vector<std::string>> &labels, std::shared_ptr<std::fstream> fs,
+                                  std::vector<std::vector<std::vector<uint64_t>>> &offsets, int shard_id,
+                                  const std::vector<std::string> &columns,
+                                  std::vector<std::shared_ptr<ShardColumn>> &column_values);
 
   /// \brief read all rows for specified columns
   ROW_GROUPS ReadAllRowGroup(std::vector<std::string> &columns);
@@ -211,7 +250,7 @@ class ShardReader {
   /// \brief read all rows in one shard
   MSRStatus ReadAllRowsInShard(int shard_id, const std::string &sql, const std::vector<std::string> &columns,
                                std::vector<std::vector<std::vector<uint64_t>>> &offsets,
-                               std::vector<std::vector<json>> &column_values);
+                               std::vector<std::shared_ptr<ShardColumn>> &column_values);
 
   /// \brief initialize reader
   MSRStatus Init(const std::string &file_path);
@@ -225,6 +264,15 @@ class ShardReader {
   /// \brief populate one row by task list in block-reader mode
   MSRStatus ConsumerByBlock(int consumer_id);
 
+  /// \brief populate rows by task list in row-reader mode, with io_depth_ reads in flight
+  MSRStatus AsyncConsumerByRow();
+
+  /// \brief populate pages by task list in block-reader mode, with io_depth_ reads in flight
+  MSRStatus AsyncConsumerByBlock();
+
+  /// \brief open file descriptors for the async io engine
+  MSRStatus OpenFileDescriptors();
+
   /// \brief get offset address of images within page
   std::vector<std::vector<uint64_t>> GetImageOffset(int group_id, int shard_id,
                                                     const std::pair<std::string, std::string> &criteria = {"", ""});
@@ -270,6 +318,36 @@ class ShardReader {
   /// \brief read one row by one task
   TASK_RETURN_CONTENT ConsumerOneTask(int task_id, uint32_t consumer_id);
 
+  /// \brief read one row by one task as a view into the mapped file
+  TASK_RETURN_VIEW ConsumerOneTaskView(int task_id);
+
+  /// \brief get offset address of blob data in file
+  std::pair<MSRStatus, uint64_t> GetBlobOffset(int group_id, int shard_id, uint64_t offset_in_page);
+
+  /// \brief get the codec of the blob page of a row group
+  CompressionType GetBlobCompression(int group_id, int shard_id);
+
+  /// \brief get the address of blob data in the mapped file and prefetch the pages of the upcoming tasks
+  const uint8_t *GetMappedBlob(int task_id, int shard_id, uint64_t file_offset, uint64_t blob_size);
+
+  /// \brief advise the kernel to read ahead the pages of tasks [begin, end) in mmap mode
+  void PrefetchTasks(int begin, int end);
+
+  /// \brief pick the selected blob fields and the labels of one row in NLP mode
+  json MergeBlobFields(const json &blob_fields, const json &label_json);
+
+  /// \brief get the labels of a task as json
+  json GetLabelJson(const std::tuple<std::tuple<int, int>, std::vector<uint64_t>, json> &task);
+
+  /// \brief pack the blob data and the labels of one row
+  std::vector<std::tuple<std::vector<uint8_t>, json>> PackRow(std::vector<uint8_t> images, json label_json);
+
+  /// \brief map all the shard files into memory
+  MSRStatus MapFiles();
+
+  /// \brief unmap all the shard files
+  void UnmapFiles();
+
   /// \brief get all the column names by schema
   vector<std::string> GetAllColumns();
 
@@ -293,18 +371,27 @@ class ShardReader {
   std::vector<string> file_paths_;                                               // file paths
   std::vector<std::shared_ptr<std::fstream>> file_streams_;                      // single-file handle list
   std::vector<std::vector<std::shared_ptr<std::fstream>>> file_streams_random_;  // multiple-file handle list
+  bool use_mmap_ = false;                                                        // mmap mode
+  std::vector<std::pair<uint8_t *, uint64_t>> mapped_files_;                     // address and size of mapped files
+  int io_depth_ = 0;                                                             // number of async reads in flight
+  std::unique_ptr<ShardIoEngine> io_engine_;                                     // async io engine
+  std::vector<int> file_descriptors_;                                            // file descriptors of async reads
+  std::shared_ptr<ShardColumn> shard_column_;                                    // label codec of raw rows
+  bool compressed_ = false;                                                      // some blob pages are compressed
 
  private:
-  int n_consumer_;                                         // number of workers (threads)
-  std::vector<std::string> selected_columns_;              // columns which will be read
-  std::map<string, uint64_t> column_schema_id_;            // column-schema map
-  std::vector<std::shared_ptr<ShardOperator>> operators_;  // data operators, including shuffle, sample and category
-  ShardTask tasks_;                                        // shard task
-  std::mutex shard_locker_;                                // locker of shard
+  int n_consumer_;                                           // number of workers (threads)
+  std::vector<std::string> selected_columns_;                // columns which will be read
+  std::map<string, uint64_t> column_schema_id_;              // column-schema map
+  std::vector<std::shared_ptr<ShardOperator>> operators_;    // data operators, including shuffle, sample and category
+  ShardTask tasks_;                                          // shard task
+  std::vector<std::shared_ptr<ShardColumn>> label_columns_;  // labels of row tasks, by shard
+  std::mutex shard_locker_;                                  // locker of shard
 
   // flags
-  bool all_in_index_ = true;  // if all columns are stored in index-table
-  bool interrupt_ = false;    // reader interrupted
+  bool all_in_index_ = true;      // if all columns are stored in index-table
+  bool interrupt_ = false;        // reader interrupted
+  bool columnar_labels_ = false;  // labels of rows are read from label columns
 
   // Delivery/Iterator mode begin
   const std::string kThreadName = "THRD_ITER_";  // prefix of thread name
@@ -320,13 +407,15 @@ class ShardReader {
   // Delivery/Iterator mode end
 
   // Block reader mode begin
-  bool block_reader_;  // block-reader mode
-  int row_id_;         // row id in one page
-  int num_blocks_;     // number of pages
+  bool block_reader_;       // block-reader mode
+  int row_id_;              // row id in one page
+  int num_blocks_;          // number of pages
+  int num_page_in_buffer_;  // number of pages in buffer
   // raw data page
   std::vector<std::shared_ptr<std::pair<std::vector<std::vector<uint64_t>>, std::vector<json>>>> delivery_block_;
-  std::unordered_set<int> delivery_block_set_;  // set of delivered pages
-  std::vector<std::vector<uint8_t>> buf_;       // page buffer
+  std::unordered_set<int> delivery_block_set_;    // set of delivered pages
+  std::vector<std::vector<uint8_t>> buf_;         // page buffer
+  std::vector<CompressionType> buf_compression_;  // codec of the pages in buffer
   // Block reader mode end
 };
 }  // namespace mindrecord
@@ -30,6 +30,11 @@ class ShardShuffle : public ShardOperator {
 
   MSRStatus execute(ShardTask &tasks) override;
 
+  // The seed of the next shuffle, it is increased by every shuffle
+  uint32_t get_shuffle_seed() const { return shuffle_seed_; }
+
+  void set_shuffle_seed(uint32_t seed) { shuffle_seed_ = seed; }
+
  private:
   uint32_t shuffle_seed_;
 };
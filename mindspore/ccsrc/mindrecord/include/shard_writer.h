@@ -22,6 +22,8 @@
 #include <algorithm>
 #include <array>
 #include <chrono>
+#include <condition_variable>
+#include <deque>
 #include <exception>
 #include <fstream>
 #include <functional>
@@ -35,6 +37,8 @@
 #include <utility>
 #include <vector>
 #include "mindrecord/include/common/shard_utils.h"
+#include "mindrecord/include/shard_column.h"
+#include "mindrecord/include/shard_compressor.h"
 #include "mindrecord/include/shard_error.h"
 #include "mindrecord/include/shard_header.h"
 #include "mindrecord/include/shard_index.h"
@@ -81,9 +85,23 @@ class ShardWriter {
   /// \return MSRStatus the status of MSRStatus
   MSRStatus SetShardHeader(std::shared_ptr<ShardHeader> header_data);
 
+  /// \brief set flag of async write. If set, a batch is written to disk in the background while the next one is
+  ///        serialized, WriteRawData takes blob_data away and returns the errors of earlier batches, and Commit
+  ///        waits for all of them to be written. Call before WriteRawData
+  void set_async_write(bool async_write) { async_write_ = async_write; }
+
+  /// \brief set flag of direct io. If set, new blob pages are written with O_DIRECT, bypassing the page cache,
+  ///        where the file system supports it. Call before Open
+  void set_direct_io(bool direct_io) { direct_io_ = direct_io; }
+
+  /// \brief set the codec of new blob pages. Rows are only appended to a blob page of the same codec
+  /// \param[in] compression "none", "lz4" or "zstd"
+  /// \return MSRStatus FAILED if the codec is unknown
+  MSRStatus set_compression(const std::string &compression);
+
   /// \brief write raw data by group size
   /// \param[in] raw_data the vector of raw json data, vector format
-  /// \param[in] blob_data the vector of image data
+  /// \param[in] blob_data the vector of image data, left empty with async write
   /// \param[in] sign validate data or not
   /// \return MSRStatus the status of MSRStatus to judge if write successfully
   MSRStatus WriteRawData(std::map<uint64_t, std::vector<json>> &raw_data, vector<vector<uint8_t>> &blob_data,
@@ -106,9 +124,38 @@ class ShardWriter {
                          std::map<uint64_t, std::vector<py::handle>> &blob_data, bool sign = true);
 
  private:
+  /// \brief a serialized batch of rows, with the size of each row as written to the pages
+  struct WriteBatch {
+    uint32_t row_count;
+    std::vector<std::vector<uint8_t>> blob_data;
+    std::vector<std::vector<uint8_t>> bin_raw_data;
+    std::vector<uint64_t> raw_data_size;
+    std::vector<uint64_t> blob_data_size;
+  };
+
   /// \brief write shard header data to disk
   MSRStatus WriteShardHeader();
 
+  /// \brief write a batch to disk, on the caller thread or on the flush thread
+  MSRStatus WriteBatchData(const std::shared_ptr<WriteBatch> &batch);
+
+  /// \brief queue a batch for the flush thread, waiting while the queue is full
+  MSRStatus PushWriteBatch(const std::shared_ptr<WriteBatch> &batch);
+
+  /// \brief write the queued batches in order until stopped and drained
+  void FlushWorker();
+
+  /// \brief stop the flush thread once the queue is drained
+  /// \return MSRStatus FAILED if any batch failed to be written
+  MSRStatus StopFlushWorker();
+
+  /// \brief write a chunk assembled in the page buffer of a shard
+  /// \param[in] shard_id shard id
+  /// \param[in] offset offset of the chunk in the file
+  /// \param[in] n_bytes size of the chunk
+  /// \param[in] direct write with direct io if possible, the chunk starts a page which is not written yet
+  MSRStatus WriteChunk(int shard_id, uint64_t offset, uint64_t n_bytes, bool direct);
+
   /// \brief erase error data
   void DeleteErrorData(std::map<uint64_t, std::vector<json>> &raw_data, std::vector<std::vector<uint8_t>> &blob_data);
 
@@ -125,20 +172,24 @@ class ShardWriter {
 
   /// \brief fill data array in multiple thread run
   void FillArray(int start, int end, std::map<uint64_t, vector<json>> &raw_data,
-                 std::vector<std::vector<uint8_t>> &bin_data);
+                 std::vector<std::vector<uint8_t>> &bin_data, bool binary_labels);
 
-  /// \brief serialized raw data
+  /// \brief serialized raw data, labels in the binary label format and blob data in msgpack
   MSRStatus SerializeRawData(std::map<uint64_t, std::vector<json>> &raw_data,
-                             std::vector<std::vector<uint8_t>> &bin_data, uint32_t row_count);
+                             std::vector<std::vector<uint8_t>> &bin_data, uint32_t row_count,
+                             bool binary_labels = false);
 
   /// \brief write all data parallel
   MSRStatus ParallelWriteData(const std::vector<std::vector<uint8_t>> &blob_data,
-                              const std::vector<std::vector<uint8_t>> &bin_raw_data);
+                              const std::vector<std::vector<uint8_t>> &bin_raw_data, uint32_t row_count);
 
   /// \brief write data shard by shard
   MSRStatus WriteByShard(int shard_id, int start_row, int end_row, const std::vector<std::vector<uint8_t>> &blob_data,
                          const std::vector<std::vector<uint8_t>> &bin_raw_data);
 
+  /// \brief compress the blob data of rows [start_row, end_row) and update their size
+  MSRStatus CompressBlobData(int start_row, int end_row, const std::vector<std::vector<uint8_t>> &blob_data);
+
   /// \brief break image data up into multiple row groups
   MSRStatus CutRowGroup(int start_row, int end_row, const std::vector<std::vector<uint8_t>> &blob_data,
                         std::vector<std::pair<int, int>> &rows_in_group, const std::shared_ptr<Page> &last_raw_page,
@@ -171,22 +222,23 @@ class ShardWriter {
                           const std::vector<std::vector<uint8_t>> &bin_raw_data);
 
   /// \brief write blob chunk to disk
-  MSRStatus FlushBlobChunk(const std::shared_ptr<std::fstream> &out, const std::vector<std::vector<uint8_t>> &blob_data,
-                           const std::pair<int, int> &blob_row);
+  MSRStatus FlushBlobChunk(const int &shard_id, uint64_t offset, const std::vector<std::vector<uint8_t>> &blob_data,
+                           const std::pair<int, int> &blob_row, bool direct = false);
 
   /// \brief write raw chunk to disk
-  MSRStatus FlushRawChunk(const std::shared_ptr<std::fstream> &out,
-                          const std::vector<std::pair<int, int>> &rows_in_group, const int &chunk_id,
-                          const std::vector<std::vector<uint8_t>> &bin_raw_data);
+  MSRStatus FlushRawChunk(const int &shard_id, uint64_t offset, const std::vector<std::pair<int, int>> &rows_in_group,
+                          const int &chunk_id, const std::vector<std::vector<uint8_t>> &bin_raw_data);
 
   /// \brief break up into tasks by shard
-  std::vector<std::pair<int, int>> BreakIntoShards();
+  std::vector<std::pair<int, int>> BreakIntoShards(uint32_t row_count);
 
   /// \brief calculate raw data size row by row
-  MSRStatus SetRawDataSize(const std::vector<std::vector<uint8_t>> &bin_raw_data);
+  MSRStatus SetRawDataSize(const std::vector<std::vector<uint8_t>> &bin_raw_data, uint32_t row_count,
+                           std::vector<uint64_t> *raw_data_size);
 
   /// \brief calculate blob data size row by row
-  MSRStatus SetBlobDataSize(const std::vector<std::vector<uint8_t>> &blob_data);
+  MSRStatus SetBlobDataSize(const std::vector<std::vector<uint8_t>> &blob_data, uint32_t row_count,
+                            std::vector<uint64_t> *blob_data_size);
 
   /// \brief populate last raw page pointer
   void SetLastRawPage(const int &shard_id, std::shared_ptr<Page> &last_raw_page);
@@ -208,17 +260,32 @@ class ShardWriter {
   uint32_t row_count_;     // count of rows
   uint32_t schema_count_;  // count of schemas
 
-  std::vector<uint64_t> raw_data_size_;   // Raw data size
-  std::vector<uint64_t> blob_data_size_;  // Blob data size
+  std::vector<uint64_t> raw_data_size_;   // Raw data size of the batch being written
+  std::vector<uint64_t> blob_data_size_;  // Blob data size of the batch being written
+
+  CompressionType compression_;                         // codec of new blob pages
+  std::vector<std::vector<uint8_t>> compressed_blobs_;  // Compressed blob data of the batch being written
 
-  std::vector<string> file_paths_;                           // file paths
-  std::vector<std::shared_ptr<std::fstream>> file_streams_;  // file handles
-  std::shared_ptr<ShardHeader> shard_header_;                // shard headers
+  std::vector<string> file_paths_;                                  // file paths
+  std::vector<std::shared_ptr<std::fstream>> file_streams_;         // file handles
+  std::vector<int> direct_fds_;                                     // file descriptors for direct io, -1 if none
+  std::vector<std::shared_ptr<uint8_t>> page_buffers_;              // aligned buffer of a page by shard
+  std::shared_ptr<ShardHeader> shard_header_;                       // shard headers
+  std::map<uint64_t, std::shared_ptr<ShardColumn>> shard_columns_;  // label codec by schema id
 
   std::map<uint64_t, std::map<int, std::string>> err_mg_;  // used for storing error raw_data info
 
   std::mutex check_mutex_;  // mutex for data check
   std::atomic<bool> flag_{false};
+
+  bool async_write_;                                      // write batches on the flush thread
+  bool direct_io_;                                        // write new blob pages with direct io
+  std::thread flush_thread_;                              // thread writing the queued batches
+  std::deque<std::shared_ptr<WriteBatch>> write_queue_;   // batches queued or being written, in order
+  std::mutex queue_mutex_;                                // mutex for the write queue
+  std::condition_variable queue_cv_;                      // signaled when the write queue changes
+  bool flush_stop_;                                       // flush thread stops once the queue is drained
+  MSRStatus flush_status_;                                // FAILED once a batch failed to be written
 };
 }  // namespace mindrecord
 }  // namespace mindspore
@@ -13,6 +13,10 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
 #include <thread>
 
 #include "mindrecord/include/shard_index_generator.h"
@@ -32,6 +36,7 @@ ShardIndexGenerator::ShardIndexGenerator(const std::string &file_path, bool appe
       page_size_(0),
       header_size_(0),
       schema_count_(0),
+      num_scan_workers_(0),
       task_(0),
       write_success_(true) {}
 
@@ -242,9 +247,8 @@ std::pair<MSRStatus, sqlite3 *> ShardIndexGenerator::CreateDatabase(int shard_no
     }
     sql += ",INC_" + std::to_string(field_no++) + " INT, " + ret.second + " " + type;
   }
-  sql += ", PRIMARY KEY(ROW_ID";
-  for (uint64_t i = 0; i < fields_.size(); ++i) sql += ",INC_" + std::to_string(i);
-  sql += "));";
+  // The key of the table is created by CreateIndexes once the rows are inserted
+  sql += ");";
   if (ExecuteSQL(sql, db, "create table successfully.") != SUCCESS) {
     return {FAILED, nullptr};
   }
@@ -260,76 +264,87 @@ std::pair<MSRStatus, std::vector<json>> ShardIndexGenerator::GetSchemaDetails(co
   std::vector<json> schema_details;
   if (schema_count_ <= kMaxSchemaCount) {
     for (int sc = 0; sc < schema_count_; ++sc) {
-      std::vector<char> schema_detail(schema_lens[sc]);
+      std::vector<uint8_t> schema_detail(schema_lens[sc]);
 
-      auto &io_read = in.read(&schema_detail[0], schema_lens[sc]);
+      auto &io_read = in.read(reinterpret_cast<char *>(&schema_detail[0]), schema_lens[sc]);
       if (!io_read.good() || io_read.fail() || io_read.bad()) {
         MS_LOG(ERROR) << "File read failed";
         in.close();
         return {FAILED, {}};
       }
 
-      schema_details.emplace_back(json::from_msgpack(std::string(schema_detail.begin(), schema_detail.end())));
+      json detail;
+      if (shard_columns_[sc]->DeserializeRow(schema_detail.data(), schema_detail.size(), &detail) == FAILED) {
+        in.close();
+        return {FAILED, {}};
+      }
+      schema_details.emplace_back(std::move(detail));
     }
   }
 
   return {SUCCESS, schema_details};
 }
 
-std::pair<MSRStatus, std::string> ShardIndexGenerator::GenerateRawSQL(
-  const std::vector<std::pair<uint64_t, std::string>> &fields) {
-  std::string sql =
-    "INSERT INTO INDEXES (ROW_ID,ROW_GROUP_ID,PAGE_ID_RAW,PAGE_OFFSET_RAW,PAGE_OFFSET_RAW_END,"
-    "PAGE_ID_BLOB,PAGE_OFFSET_BLOB,PAGE_OFFSET_BLOB_END";
-
+PLACE_HOLDERS ShardIndexGenerator::GeneratePlaceHolders(const std::vector<std::pair<uint64_t, std::string>> &fields) {
+  std::vector<std::string> place_holders = {":ROW_ID",          ":ROW_GROUP_ID",        ":PAGE_ID_RAW",
+                                            ":PAGE_OFFSET_RAW", ":PAGE_OFFSET_RAW_END", ":PAGE_ID_BLOB",
+                                            ":PAGE_OFFSET_BLOB", ":PAGE_OFFSET_BLOB_END"};
   int field_no = 0;
   for (const auto &field : fields) {
     auto ret = GenerateFieldName(field);
     if (ret.first != SUCCESS) {
-      return {FAILED, ""};
+      return {FAILED, {}};
     }
-    sql += ",INC_" + std::to_string(field_no++) + "," + ret.second;
+    place_holders.emplace_back(":INC_" + std::to_string(field_no++));
+    place_holders.emplace_back(":" + ret.second);
   }
-  sql +=
-    ") VALUES( :ROW_ID,:ROW_GROUP_ID,:PAGE_ID_RAW,:PAGE_OFFSET_RAW,:PAGE_OFFSET_RAW_END,:PAGE_ID_BLOB,"
-    ":PAGE_OFFSET_BLOB,:PAGE_OFFSET_BLOB_END";
-  field_no = 0;
-  for (const auto &field : fields) {
-    auto ret = GenerateFieldName(field);
-    if (ret.first != SUCCESS) {
-      return {FAILED, ""};
-    }
-    sql += ",:INC_" + std::to_string(field_no++) + ",:" + ret.second;
+  return {SUCCESS, place_holders};
+}
+
+std::string ShardIndexGenerator::GenerateRawSQL(const std::vector<std::string> &place_holders, uint64_t num_rows) {
+  std::string sql = "INSERT INTO INDEXES (";
+  std::string values = "(";
+  for (size_t i = 0; i < place_holders.size(); ++i) {
+    sql += (i == 0 ? "" : ",") + place_holders[i].substr(1);
+    values += (i == 0 ? "?" : ",?");
+  }
+  values += ")";
+  sql += ") VALUES ";
+  for (uint64_t i = 0; i < num_rows; ++i) {
+    sql += (i == 0 ? "" : ",") + values;
   }
-  sql += " )";
-  return {SUCCESS, sql};
+  sql += ";";
+  return sql;
 }
 
 MSRStatus ShardIndexGenerator::BindParameterExecuteSQL(
-  sqlite3 *db, const std::string &sql,
-  const std::vector<std::vector<std::tuple<std::string, std::string, std::string>>> &data) {
-  sqlite3_stmt *stmt = nullptr;
-  if (sqlite3_prepare_v2(db, common::SafeCStr(sql), -1, &stmt, 0) != SQLITE_OK) {
-    MS_LOG(ERROR) << "SQL error: could not prepare statement, sql: " << sql;
-    return FAILED;
-  }
-  for (auto &row : data) {
-    for (auto &field : row) {
+  sqlite3_stmt *stmt, const std::unordered_map<std::string, int> &place_holder_ids,
+  const std::vector<std::vector<std::tuple<std::string, std::string, std::string>>> &data, uint64_t start,
+  uint64_t num_rows) {
+  (void)sqlite3_reset(stmt);
+  (void)sqlite3_clear_bindings(stmt);
+  for (uint64_t i = 0; i < num_rows; ++i) {
+    // Parameters of the rows follow each other, a row has one per place holder
+    int row_index = static_cast<int>(i * place_holder_ids.size()) + 1;
+    for (auto &field : data[start + i]) {
       const auto &place_holder = std::get<0>(field);
       const auto &field_type = std::get<1>(field);
       const auto &field_value = std::get<2>(field);
 
-      int index = sqlite3_bind_parameter_index(stmt, common::SafeCStr(place_holder));
+      auto it = place_holder_ids.find(place_holder);
+      if (it == place_holder_ids.end()) {
+        MS_LOG(ERROR) << "SQL error: could not find parameter: " << place_holder;
+        return FAILED;
+      }
+      int index = row_index + it->second;
       if (field_type == "INTEGER") {
-        if (sqlite3_bind_int(stmt, index, std::stoi(field_value)) != SQLITE_OK) {
-          MS_LOG(ERROR) << "SQL error: could not bind parameter, index: " << index
-                        << ", field value: " << std::stoi(field_value);
+        if (sqlite3_bind_int64(stmt, index, std::stoll(field_value)) != SQLITE_OK) {
+          MS_LOG(ERROR) << "SQL error: could not bind parameter, index: " << index << ", field value: " << field_value;
           return FAILED;
         }
       } else if (field_type == "NUMERIC") {
         if (sqlite3_bind_double(stmt, index, std::stod(field_value)) != SQLITE_OK) {
-          MS_LOG(ERROR) << "SQL error: could not bind parameter, index: " << index
-                        << ", field value: " << std::stoi(field_value);
+          MS_LOG(ERROR) << "SQL error: could not bind parameter, index: " << index << ", field value: " << field_value;
           return FAILED;
         }
       } else if (field_type == "NULL") {
@@ -344,16 +359,60 @@ MSRStatus ShardIndexGenerator::BindParameterExecuteSQL(
         }
       }
     }
-    if (sqlite3_step(stmt) != SQLITE_DONE) {
-      MS_LOG(ERROR) << "SQL error: Could not step (execute) stmt.";
+  }
+  if (sqlite3_step(stmt) != SQLITE_DONE) {
+    MS_LOG(ERROR) << "SQL error: Could not step (execute) stmt.";
+    return FAILED;
+  }
+  return SUCCESS;
+}
+
+MSRStatus ShardIndexGenerator::InsertRows(
+  sqlite3 *db, const std::vector<std::string> &place_holders,
+  const std::vector<std::vector<std::tuple<std::string, std::string, std::string>>> &data) {
+  std::unordered_map<std::string, int> place_holder_ids;
+  for (size_t i = 0; i < place_holders.size(); ++i) {
+    place_holder_ids[place_holders[i]] = static_cast<int>(i);
+  }
+  const uint64_t rows_per_sql = std::max(1, kMaxSqlVariables / static_cast<int>(place_holders.size()));
+
+  // One statement for all the full batches of rows and one for the rest
+  sqlite3_stmt *stmt = nullptr;
+  uint64_t stmt_rows = 0;
+  uint64_t start = 0;
+  while (start < data.size()) {
+    uint64_t num_rows = std::min(rows_per_sql, data.size() - start);
+    if (stmt == nullptr || num_rows != stmt_rows) {
+      (void)sqlite3_finalize(stmt);
+      stmt_rows = num_rows;
+      std::string sql = GenerateRawSQL(place_holders, stmt_rows);
+      if (sqlite3_prepare_v2(db, common::SafeCStr(sql), -1, &stmt, 0) != SQLITE_OK) {
+        MS_LOG(ERROR) << "SQL error: could not prepare statement, sql: " << sql;
+        return FAILED;
+      }
+    }
+    if (BindParameterExecuteSQL(stmt, place_holder_ids, data, start, num_rows) != SUCCESS) {
+      (void)sqlite3_finalize(stmt);
       return FAILED;
     }
-    (void)sqlite3_reset(stmt);
+    start += num_rows;
   }
   (void)sqlite3_finalize(stmt);
   return SUCCESS;
 }
 
+MSRStatus ShardIndexGenerator::CreateIndexes(sqlite3 *db) {
+  // Rows are unique by row id and index fields, the reader looks rows up by blob page
+  std::string sql = "CREATE UNIQUE INDEX INDEXES_KEY ON INDEXES(ROW_ID";
+  for (uint64_t i = 0; i < fields_.size(); ++i) sql += ",INC_" + std::to_string(i);
+  sql += ");";
+  if (ExecuteSQL(sql, db, "create index successfully.") != SUCCESS) {
+    return FAILED;
+  }
+  sql = "CREATE INDEX INDEXES_PAGE_ID_BLOB ON INDEXES(PAGE_ID_BLOB);";
+  return ExecuteSQL(sql, db, "create index successfully.");
+}
+
 MSRStatus ShardIndexGenerator::AddBlobPageInfo(std::vector<std::tuple<std::string, std::string, std::string>> &row_data,
                                                const std::shared_ptr<Page> cur_blob_page,
                                                uint64_t &cur_blob_page_offset, std::fstream &in) {
@@ -502,37 +561,119 @@ INDEX_FIELDS ShardIndexGenerator::GenerateIndexFields(const std::vector<json> &s
 
 MSRStatus ShardIndexGenerator::ExecuteTransaction(const int &shard_no, const std::pair<MSRStatus, sqlite3 *> &db,
                                                   const std::vector<int> &raw_page_ids,
-                                                  const std::map<int, int> &blob_id_to_page_id) {
+                                                  const std::map<int, int> &blob_id_to_page_id, int num_scanners) {
   // Add index data to database
   std::string shard_address = shard_header_.get_shard_address_by_id(shard_no);
   if (shard_address.empty()) {
     MS_LOG(ERROR) << "Shard address is null";
+    (void)sqlite3_close(db.second);
     return FAILED;
   }
-
-  std::fstream in;
-  in.open(common::SafeCStr(shard_address), std::ios::in | std::ios::binary);
-  if (!in.good()) {
-    MS_LOG(ERROR) << "File could not opened";
+  auto place_holders = GeneratePlaceHolders(fields_);
+  if (place_holders.first != SUCCESS) {
+    (void)sqlite3_close(db.second);
     return FAILED;
   }
+
+  // The db is built again if the build fails, so it is not synced nor journaled on disk while building
+  (void)sqlite3_exec(db.second, "PRAGMA synchronous = OFF;", nullptr, nullptr, nullptr);
+  (void)sqlite3_exec(db.second, "PRAGMA journal_mode = WAL;", nullptr, nullptr, nullptr);
+
+  // Raw pages are scanned by workers, a few pages ahead of the inserts which are done here in page order
+  const int num_pages = static_cast<int>(raw_page_ids.size());
+  num_scanners = std::max(1, std::min(num_scanners, num_pages));
+  std::vector<ROW_DATA> page_rows(num_pages);
+  std::vector<bool> scanned(num_pages, false);
+  std::mutex mtx;
+  std::condition_variable cv;
+  std::atomic_int next_page(0);
+  int num_inserted = 0;
+  bool interrupt = false;
+  auto scan_pages = [&]() {
+    std::fstream in;
+    in.open(common::SafeCStr(shard_address), std::ios::in | std::ios::binary);
+    while (true) {
+      int page = next_page++;
+      if (page >= num_pages) {
+        break;
+      }
+      {
+        std::unique_lock<std::mutex> lck(mtx);
+        cv.wait(lck, [&] { return interrupt || page < num_inserted + num_scanners * kNumPageToScanAhead; });
+        if (interrupt) {
+          break;
+        }
+      }
+      ROW_DATA data = {FAILED, {}};
+      if (in.good()) {
+        data = GenerateRowData(shard_no, blob_id_to_page_id, raw_page_ids[page], in);
+      } else {
+        MS_LOG(ERROR) << "File could not opened";
+      }
+      {
+        std::lock_guard<std::mutex> lck(mtx);
+        page_rows[page] = std::move(data);
+        scanned[page] = true;
+      }
+      cv.notify_all();
+    }
+    in.close();
+  };
+  std::vector<std::thread> scanners;
+  for (int i = 0; i < num_scanners; ++i) {
+    scanners.emplace_back(scan_pages);
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  auto rows_per_second = [&start](uint64_t num_rows) {
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return static_cast<uint64_t>(num_rows / std::max(elapsed.count(), 1e-6));
+  };
+  uint64_t num_rows = 0;
+  MSRStatus ret = SUCCESS;
   (void)sqlite3_exec(db.second, "BEGIN TRANSACTION;", nullptr, nullptr, nullptr);
-  for (int raw_page_id : raw_page_ids) {
-    auto sql = GenerateRawSQL(fields_);
-    if (sql.first != SUCCESS) {
-      return FAILED;
+  for (int page = 0; page < num_pages; ++page) {
+    ROW_DATA data;
+    {
+      std::unique_lock<std::mutex> lck(mtx);
+      cv.wait(lck, [&] { return scanned[page]; });
+      data = std::move(page_rows[page]);
     }
-    auto data = GenerateRowData(shard_no, blob_id_to_page_id, raw_page_id, in);
-    if (data.first != SUCCESS) {
-      return FAILED;
+    if (data.first != SUCCESS || InsertRows(db.second, place_holders.second, data.second) != SUCCESS) {
+      ret = FAILED;
+      break;
     }
-    if (BindParameterExecuteSQL(db.second, sql.second, data.second) == FAILED) {
-      return FAILED;
+    num_rows += data.second.size();
+    {
+      std::lock_guard<std::mutex> lck(mtx);
+      num_inserted = page + 1;
     }
-    MS_LOG(INFO) << "Insert " << data.second.size() << " rows to index db.";
+    cv.notify_all();
+    MS_LOG(INFO) << "Shard: " << shard_no << ", page: " << page + 1 << "/" << num_pages << ", insert "
+                 << data.second.size() << " rows to index db, " << rows_per_second(num_rows) << " rows/sec.";
+  }
+  {
+    std::lock_guard<std::mutex> lck(mtx);
+    interrupt = true;
+  }
+  cv.notify_all();
+  for (auto &scanner : scanners) {
+    scanner.join();
+  }
+  if (ret != SUCCESS) {
+    (void)sqlite3_close(db.second);
+    return FAILED;
   }
   (void)sqlite3_exec(db.second, "END TRANSACTION;", nullptr, nullptr, nullptr);
-  in.close();
+
+  // Indexes are built in one pass over the loaded table, and the db is left in the default journal mode
+  if (CreateIndexes(db.second) != SUCCESS) {
+    (void)sqlite3_close(db.second);
+    return FAILED;
+  }
+  (void)sqlite3_exec(db.second, "PRAGMA journal_mode = DELETE;", nullptr, nullptr, nullptr);
+  MS_LOG(INFO) << "Shard: " << shard_no << ", index " << num_rows << " rows, " << rows_per_second(num_rows)
+               << " rows/sec.";
 
   // Close database
   if (sqlite3_close(db.second) != SQLITE_OK) {
@@ -547,6 +688,10 @@ MSRStatus ShardIndexGenerator::WriteToDatabase() {
   page_size_ = shard_header_.get_page_size();
   header_size_ = shard_header_.get_header_size();
   schema_count_ = shard_header_.get_schema_count();
+  shard_columns_.clear();
+  for (const auto &schema : shard_header_.get_schemas()) {
+    shard_columns_.emplace_back(std::make_shared<ShardColumn>(schema));
+  }
   if (shard_header_.get_shard_count() > kMaxShardCount) {
     MS_LOG(ERROR) << "num shards: " << shard_header_.get_shard_count() << " exceeds max count:" << kMaxSchemaCount;
     return FAILED;
@@ -557,12 +702,16 @@ MSRStatus ShardIndexGenerator::WriteToDatabase() {
   // spawn half the physical threads or total number of shards whichever is smaller
   const unsigned int num_workers =
     std::min(std::thread::hardware_concurrency() / 2 + 1, static_cast<unsigned int>(shard_header_.get_shard_count()));
+  // and share the threads among them to scan raw pages, unless the number of scan workers is set
+  const int num_scanners = num_scan_workers_ > 0
+                             ? num_scan_workers_
+                             : static_cast<int>(std::max(1u, std::thread::hardware_concurrency() / num_workers));
 
   std::vector<std::thread> threads;
   threads.reserve(num_workers);
 
   for (size_t t = 0; t < threads.capacity(); t++) {
-    threads.emplace_back(std::thread(&ShardIndexGenerator::DatabaseWriter, this));
+    threads.emplace_back(std::thread(&ShardIndexGenerator::DatabaseWriter, this, num_scanners));
   }
 
   for (size_t t = 0; t < threads.capacity(); t++) {
@@ -571,7 +720,7 @@ MSRStatus ShardIndexGenerator::WriteToDatabase() {
   return write_success_ ? SUCCESS : FAILED;
 }
 
-void ShardIndexGenerator::DatabaseWriter() {
+void ShardIndexGenerator::DatabaseWriter(int num_scanners) {
   int shard_no = task_++;
   while (shard_no < shard_header_.get_shard_count()) {
     auto db = CreateDatabase(shard_no);
@@ -596,7 +745,7 @@ void ShardIndexGenerator::DatabaseWriter() {
       }
     }
 
-    if (ExecuteTransaction(shard_no, db, raw_page_ids, blob_id_to_page_id) != SUCCESS) {
+    if (ExecuteTransaction(shard_no, db, raw_page_ids, blob_id_to_page_id, num_scanners) != SUCCESS) {
       write_success_ = false;
       return;
     }
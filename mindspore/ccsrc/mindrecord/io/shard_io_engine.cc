@@ -0,0 +1,330 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mindrecord/include/shard_io_engine.h"
+#include <errno.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <algorithm>
+#include "mindrecord/include/common/shard_utils.h"
+#include "utils/log_adapter.h"
+
+// io_uring is driven by raw system calls, so only the kernel headers are needed, not liburing
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#endif
+#endif
+#if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter) && defined(IORING_OFF_SQ_RING)
+#define MINDRECORD_IO_URING
+#endif
+
+using mindspore::LogStream;
+using mindspore::ExceptionType::NoExceptionType;
+using mindspore::MsLogLevel::ERROR;
+using mindspore::MsLogLevel::INFO;
+
+namespace mindspore {
+namespace mindrecord {
+std::unique_ptr<ShardIoEngine> ShardIoEngine::Create(int queue_depth, bool try_io_uring) {
+  if (queue_depth <= 0) {
+    MS_LOG(ERROR) << "Queue depth of io engine should be positive, but got " << queue_depth;
+    return nullptr;
+  }
+  if (try_io_uring) {
+    std::unique_ptr<ShardIoEngine> engine = std::make_unique<ShardIoUring>(queue_depth);
+    if (engine->Init() == SUCCESS) {
+      return engine;
+    }
+    MS_LOG(INFO) << "io_uring is not available, falling back to a pread thread pool.";
+  }
+  std::unique_ptr<ShardIoEngine> engine = std::make_unique<ShardIoThreadPool>(queue_depth);
+  if (engine->Init() == SUCCESS) {
+    return engine;
+  }
+  return nullptr;
+}
+
+ShardIoEngine::ShardIoEngine(int queue_depth) : queue_depth_(queue_depth), in_flight_(0), slots_(queue_depth) {
+  for (int i = queue_depth - 1; i >= 0; --i) {
+    free_slots_.push_back(i);
+  }
+}
+
+MSRStatus ShardIoEngine::Submit(int fd, uint64_t offset, uint64_t length, uint8_t *buf, uint64_t tag) {
+  if (free_slots_.empty()) {
+    MS_LOG(ERROR) << "Too many reads in flight, queue depth is " << queue_depth_;
+    return FAILED;
+  }
+  int slot = free_slots_.back();
+  free_slots_.pop_back();
+  Request &request = slots_[slot];
+  request.fd = fd;
+  request.offset = offset;
+  request.remaining = length;
+  request.iov.iov_base = buf;
+  request.iov.iov_len = length;
+  request.tag = tag;
+  if (length == 0) {
+    done_.push_back(slot);
+  } else if (SubmitSlot(slot) != SUCCESS) {
+    free_slots_.push_back(slot);
+    return FAILED;
+  }
+  in_flight_++;
+  return SUCCESS;
+}
+
+MSRStatus ShardIoEngine::Reap(uint64_t *tag) {
+  while (in_flight_ > 0) {
+    int slot = 0;
+    int64_t result = 0;
+    if (!done_.empty()) {
+      slot = done_.front();
+      done_.pop_front();
+    } else if (WaitSlot(&slot, &result) != SUCCESS) {
+      return FAILED;
+    }
+    Request &request = slots_[slot];
+    if (result > 0 && static_cast<uint64_t>(result) < request.remaining) {
+      // Short read, go on with the rest of the range
+      request.offset += result;
+      request.remaining -= result;
+      request.iov.iov_base = static_cast<uint8_t *>(request.iov.iov_base) + result;
+      request.iov.iov_len = request.remaining;
+      if (SubmitSlot(slot) == SUCCESS) {
+        continue;
+      }
+      result = -EIO;
+    }
+    in_flight_--;
+    free_slots_.push_back(slot);
+    *tag = request.tag;
+    if (result < 0 || (result == 0 && request.remaining > 0)) {
+      MS_LOG(ERROR) << "Failed to read " << request.remaining << " bytes at offset " << request.offset << ", "
+                    << (result < 0 ? "errno " + std::to_string(-result) : std::string("end of file"));
+      return FAILED;
+    }
+    return SUCCESS;
+  }
+  MS_LOG(ERROR) << "No read in flight";
+  return FAILED;
+}
+
+void ShardIoEngine::Drain() {
+  while (in_flight_ > 0) {
+    int in_flight = in_flight_;
+    uint64_t tag = 0;
+    if (Reap(&tag) != SUCCESS && in_flight_ == in_flight) {
+      break;  // the backend is broken, nothing more will come back
+    }
+  }
+}
+
+ShardIoThreadPool::ShardIoThreadPool(int queue_depth) : ShardIoEngine(queue_depth), stop_(false) {}
+
+ShardIoThreadPool::~ShardIoThreadPool() {
+  {
+    std::lock_guard<std::mutex> lck(mtx_);
+    stop_ = true;
+  }
+  cv_submit_.notify_all();
+  for (auto &thread : threads_) {
+    if (thread.joinable()) {
+      thread.join();
+    }
+  }
+}
+
+MSRStatus ShardIoThreadPool::Init() {
+  // A blocking pread holds its thread, so there is one thread per read in flight
+  int num_threads = std::min(queue_depth_, kMaxConsumerCount);
+  for (int i = 0; i < num_threads; ++i) {
+    threads_.emplace_back(&ShardIoThreadPool::IoThread, this);
+  }
+  return SUCCESS;
+}
+
+void ShardIoThreadPool::IoThread() {
+  for (;;) {
+    int slot = 0;
+    {
+      std::unique_lock<std::mutex> lck(mtx_);
+      cv_submit_.wait(lck, [this] { return stop_ || !submitted_.empty(); });
+      if (stop_) {
+        return;
+      }
+      slot = submitted_.front();
+      submitted_.pop_front();
+    }
+    // The slot is not touched by anyone else until its completion is reaped
+    const Request &request = slots_[slot];
+    ssize_t ret = 0;
+    do {
+      ret = pread(request.fd, request.iov.iov_base, request.iov.iov_len, static_cast<off_t>(request.offset));
+    } while (ret < 0 && errno == EINTR);
+    int64_t result = ret < 0 ? -static_cast<int64_t>(errno) : static_cast<int64_t>(ret);
+    {
+      std::lock_guard<std::mutex> lck(mtx_);
+      completed_.emplace_back(slot, result);
+    }
+    cv_complete_.notify_one();
+  }
+}
+
+MSRStatus ShardIoThreadPool::SubmitSlot(int slot) {
+  {
+    std::lock_guard<std::mutex> lck(mtx_);
+    submitted_.push_back(slot);
+  }
+  cv_submit_.notify_one();
+  return SUCCESS;
+}
+
+MSRStatus ShardIoThreadPool::WaitSlot(int *slot, int64_t *result) {
+  std::unique_lock<std::mutex> lck(mtx_);
+  cv_complete_.wait(lck, [this] { return !completed_.empty(); });
+  *slot = completed_.front().first;
+  *result = completed_.front().second;
+  completed_.pop_front();
+  return SUCCESS;
+}
+
+ShardIoUring::ShardIoUring(int queue_depth)
+    : ShardIoEngine(queue_depth),
+      ring_fd_(-1),
+      sq_ring_(nullptr),
+      cq_ring_(nullptr),
+      sqes_(nullptr),
+      sq_ring_size_(0),
+      cq_ring_size_(0),
+      sqes_size_(0),
+      sq_tail_(nullptr),
+      sq_mask_(nullptr),
+      sq_array_(nullptr),
+      cq_head_(nullptr),
+      cq_tail_(nullptr),
+      cq_mask_(nullptr),
+      cqes_(nullptr) {}
+
+ShardIoUring::~ShardIoUring() {
+  if (sqes_ != nullptr) {
+    (void)munmap(sqes_, sqes_size_);
+  }
+  if (cq_ring_ != nullptr) {
+    (void)munmap(cq_ring_, cq_ring_size_);
+  }
+  if (sq_ring_ != nullptr) {
+    (void)munmap(sq_ring_, sq_ring_size_);
+  }
+  if (ring_fd_ >= 0) {
+    (void)close(ring_fd_);
+  }
+}
+
+MSRStatus ShardIoUring::Init() {
+#ifdef MINDRECORD_IO_URING
+  struct io_uring_params params = {};
+  ring_fd_ = static_cast<int>(syscall(__NR_io_uring_setup, static_cast<unsigned>(queue_depth_), &params));
+  if (ring_fd_ < 0) {
+    MS_LOG(INFO) << "Failed to set up io_uring, errno " << errno;
+    return FAILED;
+  }
+  sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+  cq_ring_size_ = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+  sqes_size_ = params.sq_entries * sizeof(struct io_uring_sqe);
+  auto map_ring = [this](size_t size, off_t offset) -> void * {
+    void *addr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_, offset);
+    return addr == MAP_FAILED ? nullptr : addr;
+  };
+  sq_ring_ = map_ring(sq_ring_size_, IORING_OFF_SQ_RING);
+  cq_ring_ = map_ring(cq_ring_size_, IORING_OFF_CQ_RING);
+  sqes_ = map_ring(sqes_size_, IORING_OFF_SQES);
+  if (sq_ring_ == nullptr || cq_ring_ == nullptr || sqes_ == nullptr) {
+    MS_LOG(INFO) << "Failed to map io_uring, errno " << errno;
+    return FAILED;
+  }
+  auto sq_ring = static_cast<uint8_t *>(sq_ring_);
+  auto cq_ring = static_cast<uint8_t *>(cq_ring_);
+  sq_tail_ = reinterpret_cast<unsigned *>(sq_ring + params.sq_off.tail);
+  sq_mask_ = reinterpret_cast<unsigned *>(sq_ring + params.sq_off.ring_mask);
+  sq_array_ = reinterpret_cast<unsigned *>(sq_ring + params.sq_off.array);
+  cq_head_ = reinterpret_cast<unsigned *>(cq_ring + params.cq_off.head);
+  cq_tail_ = reinterpret_cast<unsigned *>(cq_ring + params.cq_off.tail);
+  cq_mask_ = reinterpret_cast<unsigned *>(cq_ring + params.cq_off.ring_mask);
+  cqes_ = cq_ring + params.cq_off.cqes;
+  return SUCCESS;
+#else
+  return FAILED;
+#endif
+}
+
+MSRStatus ShardIoUring::SubmitSlot(int slot) {
+#ifdef MINDRECORD_IO_URING
+  // This thread is the only producer of the submission ring
+  unsigned tail = *sq_tail_;
+  unsigned index = tail & *sq_mask_;
+  struct io_uring_sqe *sqe = static_cast<struct io_uring_sqe *>(sqes_) + index;
+  *sqe = {};
+  Request &request = slots_[slot];
+  sqe->opcode = IORING_OP_READV;
+  sqe->fd = request.fd;
+  sqe->off = request.offset;
+  sqe->addr = reinterpret_cast<uint64_t>(&request.iov);
+  sqe->len = 1;
+  sqe->user_data = static_cast<uint64_t>(slot);
+  sq_array_[index] = index;
+  __atomic_store_n(sq_tail_, tail + 1, __ATOMIC_RELEASE);
+
+  int ret = 0;
+  do {
+    ret = static_cast<int>(syscall(__NR_io_uring_enter, ring_fd_, 1, 0, 0, nullptr, 0));
+  } while (ret < 0 && (errno == EINTR || errno == EAGAIN));
+  if (ret < 0) {
+    MS_LOG(ERROR) << "Failed to submit to io_uring, errno " << errno;
+    return FAILED;
+  }
+  return SUCCESS;
+#else
+  return FAILED;
+#endif
+}
+
+MSRStatus ShardIoUring::WaitSlot(int *slot, int64_t *result) {
+#ifdef MINDRECORD_IO_URING
+  for (;;) {
+    // This thread is the only consumer of the completion ring
+    unsigned head = *cq_head_;
+    if (head != __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE)) {
+      struct io_uring_cqe *cqe = static_cast<struct io_uring_cqe *>(cqes_) + (head & *cq_mask_);
+      *slot = static_cast<int>(cqe->user_data);
+      *result = cqe->res;
+      __atomic_store_n(cq_head_, head + 1, __ATOMIC_RELEASE);
+      return SUCCESS;
+    }
+    int ret = static_cast<int>(syscall(__NR_io_uring_enter, ring_fd_, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0));
+    if (ret < 0 && errno != EINTR) {
+      MS_LOG(ERROR) << "Failed to wait for io_uring, errno " << errno;
+      return FAILED;
+    }
+  }
+#else
+  return FAILED;
+#endif
+}
+}  // namespace mindrecord
+}  // namespace mindspore
@@ -44,6 +44,7 @@ ShardReader::ShardReader() {
   num_rows_ = 0;
   row_id_ = 0;
   num_blocks_ = 0;
+  num_page_in_buffer_ = kNumPageInBuffer;
   block_reader_ = false;
 }
 
@@ -59,6 +60,10 @@ MSRStatus ShardReader::Init(const std::string &file_path) {
   header_size_ = shard_header_->get_header_size();
   page_size_ = shard_header_->get_page_size();
   file_paths_ = shard_header_->get_shard_addresses();
+  compressed_ = shard_header_->HasCompressedPage();
+  if (!shard_header_->get_schemas().empty()) {
+    shard_column_ = std::make_shared<ShardColumn>(shard_header_->get_schemas()[0]);
+  }
 
   for (const auto &file : file_paths_) {
     sqlite3 *db = nullptr;
@@ -137,6 +142,58 @@ MSRStatus ShardReader::Open() {
   return SUCCESS;
 }
 
+MSRStatus ShardReader::MapFiles() {
+  UnmapFiles();
+  for (const auto &file : file_paths_) {
+    int fd = open(common::SafeCStr(file), O_RDONLY);
+    if (fd < 0) {
+      MS_LOG(ERROR) << "File could not opened";
+      return FAILED;
+    }
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) != 0 || file_stat.st_size <= 0) {
+      MS_LOG(ERROR) << "Failed to get the size of shard file";
+      (void)close(fd);
+      return FAILED;
+    }
+    auto file_size = static_cast<uint64_t>(file_stat.st_size);
+    void *addr = mmap(nullptr, file_size, PROT_READ, MAP_SHARED, fd, 0);
+    (void)close(fd);
+    if (addr == MAP_FAILED) {
+      MS_LOG(ERROR) << "Failed to map shard file, errno " << errno;
+      return FAILED;
+    }
+    // Rows are visited in task order, which is usually shuffled, so the read ahead of the kernel is of no use.
+    // The pages of the upcoming tasks are prefetched instead.
+    if (!block_reader_) {
+      (void)madvise(addr, file_size, MADV_RANDOM);
+    }
+    mapped_files_.emplace_back(static_cast<uint8_t *>(addr), file_size);
+    MS_LOG(INFO) << "Map shard file successfully.";
+  }
+
+  return SUCCESS;
+}
+
+void ShardReader::UnmapFiles() {
+  for (auto &mapped_file : mapped_files_) {
+    (void)munmap(mapped_file.first, mapped_file.second);
+  }
+  mapped_files_.clear();
+}
+
+MSRStatus ShardReader::OpenFileDescriptors() {
+  for (const auto &file : file_paths_) {
+    int fd = open(common::SafeCStr(file), O_RDONLY);
+    if (fd < 0) {
+      MS_LOG(ERROR) << "File could not opened";
+      return FAILED;
+    }
+    file_descriptors_.push_back(fd);
+  }
+  return SUCCESS;
+}
+
 MSRStatus ShardReader::Open(int n_consumer) {
   file_streams_random_ =
     std::vector<std::vector<std::shared_ptr<std::fstream>>>(n_consumer, std::vector<std::shared_ptr<std::fstream>>());
@@ -169,6 +226,10 @@ void ShardReader::FileStreamsOperator() {
       }
     }
   }
+  for (int fd : file_descriptors_) {
+    (void)close(fd);
+  }
+  file_descriptors_.clear();
   for (int i = static_cast<int>(database_paths_.size()) - 1; i >= 0; --i) {
     if (database_paths_[i] != nullptr) {
       (void)sqlite3_close(database_paths_[i]);
@@ -181,6 +242,7 @@ ShardReader::~ShardReader() { Close(); }
 void ShardReader::Close() {
   (void)Finish();  // interrupt reading and stop threads
   FileStreamsOperator();
+  UnmapFiles();
 }
 
 std::shared_ptr<ShardHeader> ShardReader::get_shard_header() const { return shard_header_; }
@@ -218,23 +280,25 @@ std::vector<std::tuple<int, int, int, uint64_t>> ShardReader::ReadRowGroupSummar
   return row_group_summary;
 }
 
-MSRStatus ShardReader::ConvertLabelToJson(const std::vector<std::vector<std::string>> &labels,
-                                          std::shared_ptr<std::fstream> fs,
-                                          std::vector<std::vector<std::vector<uint64_t>>> &offsets, int shard_id,
-                                          const std::vector<std::string> &columns,
-                                          std::vector<std::vector<json>> &column_values) {
+MSRStatus ShardReader::ConvertLabelToColumns(const std::vector<std::vector<std::string>> &labels,
+                                             std::shared_ptr<std::fstream> fs,
+                                             std::vector<std::vector<std::vector<uint64_t>>> &offsets, int shard_id,
+                                             const std::vector<std::string> &columns,
+                                             std::vector<std::shared_ptr<ShardColumn>> &column_values) {
+  auto label_columns = std::make_shared<ShardColumn>(shard_header_->get_schemas()[0], columns);
+  std::vector<uint8_t> label_raw;
   for (int i = 0; i < static_cast<int>(labels.size()); ++i) {
     uint64_t group_id = std::stoull(labels[i][0]);
     uint64_t offset_start = std::stoull(labels[i][1]) + kInt64Len;
     uint64_t offset_end = std::stoull(labels[i][2]);
-    offsets[shard_id].emplace_back(
-      std::vector<uint64_t>{static_cast<uint64_t>(shard_id), group_id, offset_start, offset_end});
+    offsets[shard_id].emplace_back(std::vector<uint64_t>{static_cast<uint64_t>(shard_id), group_id, offset_start,
+                                                         offset_end, label_columns->num_rows()});
     if (!all_in_index_) {
       int raw_page_id = std::stoi(labels[i][3]);
       uint64_t label_start = std::stoull(labels[i][4]) + kInt64Len;
       uint64_t label_end = std::stoull(labels[i][5]);
       auto len = label_end - label_start;
-      auto label_raw = std::vector<uint8_t>(len);
+      label_raw.resize(len);
       auto &io_seekg = fs->seekg(page_size_ * raw_page_id + header_size_ + label_start, std::ios::beg);
       if (!io_seekg.good() || io_seekg.fail() || io_seekg.bad()) {
         MS_LOG(ERROR) << "File seekg failed";
@@ -249,47 +313,24 @@ MSRStatus ShardReader::ConvertLabelToJson(const std::vector<std::vector<std::str
         return FAILED;
       }
 
-      json label_json = json::from_msgpack(label_raw);
-      json tmp;
-      if (!columns.empty()) {
-        for (auto &col : columns) {
-          if (label_json.find(col) != label_json.end()) {
-            tmp[col] = label_json[col];
-          }
-        }
-      } else {
-        tmp = label_json;
+      // Binary labels go straight into the columns, msgpack labels of older files are decoded once here
+      if (label_columns->AppendRow(label_raw.data(), len) == FAILED) {
+        fs->close();
+        return FAILED;
       }
-      column_values[shard_id].emplace_back(tmp);
     } else {
-      json construct_json;
-      for (unsigned int j = 0; j < columns.size(); ++j) {
-        // construct json "f1": value
-        auto schema = shard_header_->get_schemas()[0]->GetSchema()["schema"];
-
-        // convert the string to base type by schema
-        if (schema[columns[j]]["type"] == "int32") {
-          construct_json[columns[j]] = StringToNum<int32_t>(labels[i][j + 3]);
-        } else if (schema[columns[j]]["type"] == "int64") {
-          construct_json[columns[j]] = StringToNum<int64_t>(labels[i][j + 3]);
-        } else if (schema[columns[j]]["type"] == "float32") {
-          construct_json[columns[j]] = StringToNum<float>(labels[i][j + 3]);
-        } else if (schema[columns[j]]["type"] == "float64") {
-          construct_json[columns[j]] = StringToNum<double>(labels[i][j + 3]);
-        } else {
-          construct_json[columns[j]] = std::string(labels[i][j + 3]);
-        }
-      }
-      column_values[shard_id].emplace_back(construct_json);
+      // Index fields come as text, converted to the column types by schema
+      (void)label_columns->AppendRow(columns, labels[i], 3);
     }
   }
+  column_values[shard_id] = label_columns;
 
   return SUCCESS;
 }
 
 MSRStatus ShardReader::ReadAllRowsInShard(int shard_id, const std::string &sql, const std::vector<std::string> &columns,
                                           std::vector<std::vector<std::vector<uint64_t>>> &offsets,
-                                          std::vector<std::vector<json>> &column_values) {
+                                          std::vector<std::shared_ptr<ShardColumn>> &column_values) {
   auto db = database_paths_[shard_id];
   std::vector<std::vector<std::string>> labels;
   char *errmsg = nullptr;
@@ -312,13 +353,13 @@ MSRStatus ShardReader::ReadAllRowsInShard(int shard_id, const std::string &sql,
     }
   }
   sqlite3_free(errmsg);
-  return ConvertLabelToJson(labels, fs, offsets, shard_id, columns, column_values);
+  return ConvertLabelToColumns(labels, fs, offsets, shard_id, columns, column_values);
 }
 
 ROW_GROUPS ShardReader::ReadAllRowGroup(std::vector<std::string> &columns) {
   std::string fields = "ROW_GROUP_ID, PAGE_OFFSET_BLOB, PAGE_OFFSET_BLOB_END";
   std::vector<std::vector<std::vector<uint64_t>>> offsets(shard_count_, std::vector<std::vector<uint64_t>>{});
-  std::vector<std::vector<json>> column_values(shard_count_, std::vector<json>{});
+  std::vector<std::shared_ptr<ShardColumn>> column_values(shard_count_, nullptr);
   if (all_in_index_) {
     for (unsigned int i = 0; i < columns.size(); ++i) {
       fields += ',';
@@ -544,7 +585,12 @@ std::pair<MSRStatus, std::vector<json>> ShardReader::GetLabelsFromBinaryFile(
       return {FAILED, {}};
     }
 
-    json label_json = json::from_msgpack(label_raw);
+    json label_json;
+    if (shard_column_ == nullptr || shard_column_->DeserializeRow(label_raw.data(), len, &label_json) == FAILED) {
+      MS_LOG(ERROR) << "Failed to decode labels.";
+      fs->close();
+      return {FAILED, {}};
+    }
     json tmp = label_json;
     for (auto &col : columns) {
       if (label_json.find(col) != label_json.end()) {
@@ -677,7 +723,8 @@ MSRStatus ShardReader::CountTotalRows(const std::string &file_path, int64_t *cou
 
 MSRStatus ShardReader::Open(const std::string &file_path, int n_consumer,
                             const std::vector<std::string> &selected_columns,
-                            const std::vector<std::shared_ptr<ShardOperator>> &operators, const bool &block_reader) {
+                            const std::vector<std::shared_ptr<ShardOperator>> &operators, const bool &block_reader,
+                            const bool &use_mmap) {
   // Open file and set header by ShardReader
   if (Init(file_path) == FAILED) {
     return FAILED;
@@ -712,18 +759,16 @@ MSRStatus ShardReader::Open(const std::string &file_path, int n_consumer,
   n_consumer_ = n_consumer;
 
   operators_ = operators;
+  use_mmap_ = use_mmap;
 
   if (block_reader) {
     block_reader_ = true;
-    if (Open() == FAILED) {
+    if ((use_mmap_ ? MapFiles() : Open()) == FAILED) {
       return FAILED;
     }
-    delivery_block_ = std::vector<std::shared_ptr<std::pair<std::vector<std::vector<uint64_t>>, std::vector<json>>>>(
-      kNumPageInBuffer, std::shared_ptr<std::pair<std::vector<std::vector<uint64_t>>, std::vector<json>>>{});
-    buf_ = std::vector<std::vector<uint8_t>>(kNumPageInBuffer, std::vector<uint8_t>(page_size_));
   } else {
     block_reader_ = false;
-    if (Open(n_consumer) == FAILED) {
+    if ((use_mmap_ ? MapFiles() : Open(n_consumer)) == FAILED) {
       return FAILED;
     }
   }
@@ -777,6 +822,19 @@ MSRStatus ShardReader::Launch(bool isSimpleReader) {
     return FAILED;
   }
   MS_LOG(INFO) << "Launching read threads.";
+  if (use_mmap_ && !block_reader_) {
+    PrefetchTasks(0, kNumTaskToPrefetch);
+  }
+
+  bool async_io = io_depth_ > 0 && !use_mmap_;
+  if (block_reader_) {
+    // The async reads go as far ahead of delivery as the page buffer allows
+    num_page_in_buffer_ = async_io ? std::max(kNumPageInBuffer, io_depth_) : kNumPageInBuffer;
+    delivery_block_ = std::vector<std::shared_ptr<std::pair<std::vector<std::vector<uint64_t>>, std::vector<json>>>>(
+      num_page_in_buffer_, std::shared_ptr<std::pair<std::vector<std::vector<uint64_t>>, std::vector<json>>>{});
+    buf_ = std::vector<std::vector<uint8_t>>(num_page_in_buffer_, std::vector<uint8_t>(page_size_));
+    buf_compression_ = std::vector<CompressionType>(num_page_in_buffer_, kCompressionNone);
+  }
 
   if (isSimpleReader) return SUCCESS;
 
@@ -786,6 +844,23 @@ MSRStatus ShardReader::Launch(bool isSimpleReader) {
     return FAILED;
   }
 
+  if (async_io) {
+    // One thread keeps io_depth_ reads in flight instead of n_consumer_ threads blocking on one read each
+    io_engine_ = ShardIoEngine::Create(io_depth_);
+    if (io_engine_ == nullptr || OpenFileDescriptors() == FAILED) {
+      MS_LOG(ERROR) << "Failed to set up async io engine.";
+      return FAILED;
+    }
+    MS_LOG(INFO) << "Launching async read thread, " << io_depth_ << " reads in flight on " << io_engine_->name() << ".";
+    thread_set_ = std::vector<std::thread>(1);
+    if (block_reader_) {
+      thread_set_[0] = std::thread(&ShardReader::AsyncConsumerByBlock, this);
+    } else {
+      thread_set_[0] = std::thread(&ShardReader::AsyncConsumerByRow, this);
+    }
+    return SUCCESS;
+  }
+
   for (int x = 0; x < n_consumer_; ++x) {
     if (block_reader_) {
       thread_set_[x] = std::thread(&ShardReader::ConsumerByBlock, this, x);
@@ -878,18 +953,20 @@ MSRStatus ShardReader::CreateTasksByRow(const std::vector<std::tuple<int, int, i
     return FAILED;
   }
   auto offsets = std::get<1>(ret);
-  auto local_columns = std::get<2>(ret);
   if (shard_count_ <= kMaxShardCount) {
+    // Labels stay in the columns of their shard, the task keeps the row id in them
     for (int shard_id = 0; shard_id < shard_count_; shard_id++) {
       for (uint32_t i = 0; i < offsets[shard_id].size(); i += 1) {
         tasks_.InsertTask(offsets[shard_id][i][0], offsets[shard_id][i][1],
-                          std::vector<uint64_t>{offsets[shard_id][i][2], offsets[shard_id][i][3]},
-                          local_columns[shard_id][i]);
+                          std::vector<uint64_t>{offsets[shard_id][i][2], offsets[shard_id][i][3],
+                                                offsets[shard_id][i][4]},
+                          json{});
       }
     }
   } else {
     return FAILED;
   }
+  label_columns_ = std::move(std::get<2>(ret));
   return SUCCESS;
 }
 
@@ -923,6 +1000,81 @@ MSRStatus ShardReader::CreateTasks(const std::vector<std::tuple<int, int, int, u
   return SUCCESS;
 }
 
+std::pair<MSRStatus, uint64_t> ShardReader::GetBlobOffset(int group_id, int shard_id, uint64_t offset_in_page) {
+  const auto &ret = shard_header_->GetPageByGroupId(group_id, shard_id);
+  if (SUCCESS != ret.first) {
+    return std::make_pair(FAILED, 0);
+  }
+  const std::shared_ptr<Page> &page = ret.second;
+  return std::make_pair(SUCCESS, header_size_ + page_size_ * (page->get_page_id()) + offset_in_page);
+}
+
+CompressionType ShardReader::GetBlobCompression(int group_id, int shard_id) {
+  if (!compressed_) {
+    return kCompressionNone;
+  }
+  const auto &ret = shard_header_->GetPageByGroupId(group_id, shard_id);
+  return SUCCESS == ret.first ? ret.second->get_compression() : kCompressionNone;
+}
+
+MSRStatus ShardReader::UncompressBlob(CompressionType compression, std::vector<uint8_t> *blob) {
+  if (compression == kCompressionNone) {
+    return SUCCESS;
+  }
+  std::vector<uint8_t> raw;
+  if (ShardCompressor::Uncompress(compression, blob->data(), blob->size(), &raw) != SUCCESS) {
+    return FAILED;
+  }
+  blob->swap(raw);
+  return SUCCESS;
+}
+
+const uint8_t *ShardReader::GetMappedBlob(int task_id, int shard_id, uint64_t file_offset, uint64_t blob_size) {
+  if (shard_id < 0 || shard_id >= static_cast<int>(mapped_files_.size()) ||
+      file_offset + blob_size > mapped_files_[shard_id].second) {
+    MS_LOG(ERROR) << "Blob data is out of the mapped file";
+    return nullptr;
+  }
+  // Keep a window of kNumTaskToPrefetch tasks in flight, the first ones were prefetched at launch or shuffle.
+  PrefetchTasks(task_id + kNumTaskToPrefetch, task_id + kNumTaskToPrefetch + 1);
+  return mapped_files_[shard_id].first + file_offset;
+}
+
+void ShardReader::PrefetchTasks(int begin, int end) {
+  static const uint64_t page_mask = ~(static_cast<uint64_t>(sysconf(_SC_PAGESIZE)) - 1);
+  end = std::min(end, static_cast<int>(tasks_.Size()));
+  for (int task_id = std::max(begin, 0); task_id < end; ++task_id) {
+    const auto &task = tasks_.get_task_by_id(tasks_.permutation_[task_id]);
+    auto shard_id = std::get<0>(std::get<0>(task));
+    auto group_id = std::get<1>(std::get<0>(task));
+    const auto &addr = std::get<1>(task);
+    const auto &ret = GetBlobOffset(group_id, shard_id, addr[0]);
+    if (SUCCESS != ret.first || ret.second + addr[1] - addr[0] > mapped_files_[shard_id].second) {
+      continue;
+    }
+    // madvise needs a page aligned address
+    auto start = ret.second & page_mask;
+    (void)madvise(mapped_files_[shard_id].first + start, ret.second + addr[1] - addr[0] - start, MADV_WILLNEED);
+  }
+}
+
+json ShardReader::MergeBlobFields(const json &blob_fields, const json &label_json) {
+  json merge;
+  if (selected_columns_.size() > 0) {
+    for (auto &col : selected_columns_) {
+      if (blob_fields.find(col) != blob_fields.end()) {
+        merge[col] = blob_fields[col];
+      }
+    }
+  } else {
+    merge = blob_fields;
+  }
+  if (label_json != nullptr) {
+    merge.update(label_json);
+  }
+  return merge;
+}
+
 TASK_RETURN_CONTENT ShardReader::ConsumerOneTask(int task_id, uint32_t consumer_id) {
   // All tasks are done
   if (task_id >= static_cast<int>(tasks_.Size())) {
@@ -935,52 +1087,114 @@ TASK_RETURN_CONTENT ShardReader::ConsumerOneTask(int task_id, uint32_t consumer_
   auto shard_id = std::get<0>(std::get<0>(task));
   auto group_id = std::get<1>(std::get<0>(task));
   auto addr = std::get<1>(task);
-  const auto &ret = shard_header_->GetPageByGroupId(group_id, shard_id);
+  const auto &ret = GetBlobOffset(group_id, shard_id, addr[0]);
   if (SUCCESS != ret.first) {
     return std::make_pair(FAILED, std::vector<std::tuple<std::vector<uint8_t>, json>>());
   }
-  const std::shared_ptr<Page> &page = ret.second;
+  auto file_offset = ret.second;
+
   // Pack image list
-  std::vector<uint8_t> images(addr[1] - addr[0]);
-  auto file_offset = header_size_ + page_size_ * (page->get_page_id()) + addr[0];
+  std::vector<uint8_t> images;
+  if (use_mmap_) {
+    const uint8_t *blob = GetMappedBlob(task_id, shard_id, file_offset, addr[1] - addr[0]);
+    if (blob == nullptr) {
+      return std::make_pair(FAILED, std::vector<std::tuple<std::vector<uint8_t>, json>>());
+    }
+    images.assign(blob, blob + addr[1] - addr[0]);
+  } else {
+    images.resize(addr[1] - addr[0]);
+    auto &io_seekg = file_streams_random_[consumer_id][shard_id]->seekg(file_offset, std::ios::beg);
+    if (!io_seekg.good() || io_seekg.fail() || io_seekg.bad()) {
+      MS_LOG(ERROR) << "File seekg failed";
+      file_streams_random_[consumer_id][shard_id]->close();
+      return std::make_pair(FAILED, std::vector<std::tuple<std::vector<uint8_t>, json>>());
+    }
 
-  auto &io_seekg = file_streams_random_[consumer_id][shard_id]->seekg(file_offset, std::ios::beg);
-  if (!io_seekg.good() || io_seekg.fail() || io_seekg.bad()) {
-    MS_LOG(ERROR) << "File seekg failed";
-    file_streams_random_[consumer_id][shard_id]->close();
-    return std::make_pair(FAILED, std::vector<std::tuple<std::vector<uint8_t>, json>>());
+    auto &io_read =
+      file_streams_random_[consumer_id][shard_id]->read(reinterpret_cast<char *>(&images[0]), addr[1] - addr[0]);
+    if (!io_read.good() || io_read.fail() || io_read.bad()) {
+      MS_LOG(ERROR) << "File read failed";
+      file_streams_random_[consumer_id][shard_id]->close();
+      return std::make_pair(FAILED, std::vector<std::tuple<std::vector<uint8_t>, json>>());
+    }
   }
 
-  auto &io_read =
-    file_streams_random_[consumer_id][shard_id]->read(reinterpret_cast<char *>(&images[0]), addr[1] - addr[0]);
-  if (!io_read.good() || io_read.fail() || io_read.bad()) {
-    MS_LOG(ERROR) << "File read failed";
-    file_streams_random_[consumer_id][shard_id]->close();
+  // Compressed blob data is uncompressed by the consumer, ahead of delivery
+  if (UncompressBlob(GetBlobCompression(group_id, shard_id), &images) != SUCCESS) {
     return std::make_pair(FAILED, std::vector<std::tuple<std::vector<uint8_t>, json>>());
   }
 
   // Deliver batch data to output map
+  return std::make_pair(SUCCESS, PackRow(std::move(images), GetLabelJson(task)));
+}
+
+json ShardReader::GetLabelJson(const std::tuple<std::tuple<int, int>, std::vector<uint64_t>, json> &task) {
+  const auto &addr = std::get<1>(task);
+  if (addr.size() <= 2) {
+    return std::get<2>(task);
+  }
+  if (columnar_labels_) {
+    return json();
+  }
+  auto shard_id = std::get<0>(std::get<0>(task));
+  return label_columns_[shard_id]->GetRowJson(addr[2]);
+}
+
+LABEL_ROW ShardReader::GetLabelRow(const int64_t &task_id) {
+  if (task_id < 0 || task_id >= static_cast<int64_t>(tasks_.Size())) {
+    return {nullptr, 0};
+  }
+  const auto &task = tasks_.get_task_by_id(tasks_.permutation_[task_id]);
+  const auto &addr = std::get<1>(task);
+  if (addr.size() <= 2) {
+    return {nullptr, 0};
+  }
+  return {label_columns_[std::get<0>(std::get<0>(task))].get(), addr[2]};
+}
+
+std::vector<std::tuple<std::vector<uint8_t>, json>> ShardReader::PackRow(std::vector<uint8_t> images, json label_json) {
   std::vector<std::tuple<std::vector<uint8_t>, json>> batch;
   if (nlp_) {
-    json blob_fields = json::from_msgpack(images);
+    batch.emplace_back(std::vector<uint8_t>{}, MergeBlobFields(json::from_msgpack(images), label_json));
+  } else {
+    batch.emplace_back(std::move(images), std::move(label_json));
+  }
+  return batch;
+}
 
-    json merge;
-    if (selected_columns_.size() > 0) {
-      for (auto &col : selected_columns_) {
-        if (blob_fields.find(col) != blob_fields.end()) {
-          merge[col] = blob_fields[col];
-        }
-      }
-    } else {
-      merge = blob_fields;
-    }
-    auto label_json = std::get<2>(task);
-    if (label_json != nullptr) {
-      merge.update(label_json);
-    }
-    batch.emplace_back(std::vector<uint8_t>{}, std::move(merge));
+TASK_RETURN_VIEW ShardReader::ConsumerOneTaskView(int task_id) {
+  // All tasks are done
+  if (!use_mmap_ || task_id >= static_cast<int>(tasks_.Size())) {
+    return std::make_pair(FAILED, std::vector<std::tuple<BLOB_VIEW, json>>());
+  }
+  if (compressed_) {
+    MS_LOG(ERROR) << "Rows of compressed blob pages have no views into the mapped file.";
+    return std::make_pair(FAILED, std::vector<std::tuple<BLOB_VIEW, json>>());
+  }
+
+  // Pick up task from task list
+  const auto &task = tasks_.get_task_by_id(tasks_.permutation_[task_id]);
+
+  auto shard_id = std::get<0>(std::get<0>(task));
+  auto group_id = std::get<1>(std::get<0>(task));
+  const auto &addr = std::get<1>(task);
+  const auto &ret = GetBlobOffset(group_id, shard_id, addr[0]);
+  if (SUCCESS != ret.first) {
+    return std::make_pair(FAILED, std::vector<std::tuple<BLOB_VIEW, json>>());
+  }
+  auto blob_size = addr[1] - addr[0];
+  const uint8_t *blob = GetMappedBlob(task_id, shard_id, ret.second, blob_size);
+  if (blob == nullptr) {
+    return std::make_pair(FAILED, std::vector<std::tuple<BLOB_VIEW, json>>());
+  }
+
+  // Deliver views into the mapped file, NLP data is decoded right from the mapped pages
+  std::vector<std::tuple<BLOB_VIEW, json>> batch;
+  if (nlp_) {
+    batch.emplace_back(BLOB_VIEW(nullptr, 0),
+                       MergeBlobFields(json::from_msgpack(blob, blob + blob_size), GetLabelJson(task)));
   } else {
-    batch.emplace_back(std::move(images), std::move(std::get<2>(task)));
+    batch.emplace_back(BLOB_VIEW(blob, blob_size), GetLabelJson(task));
   }
   return std::make_pair(SUCCESS, std::move(batch));
 }
@@ -1020,8 +1234,166 @@ MSRStatus ShardReader::ConsumerByRow(int consumer_id) {
   }
 }
 
+MSRStatus ShardReader::AsyncConsumerByRow() {
+  // Set thread name
+  auto thread_id = kThreadName + "IO";
+  prctl(PR_SET_NAME, common::SafeCStr(thread_id), 0, 0, 0);
+
+  // Blob data of the reads in flight, by task ID
+  std::unordered_map<int, std::vector<uint8_t>> images;
+  auto can_submit = [this] {
+    return task_id_ < static_cast<int>(tasks_.Size()) && task_id_ <= deliver_id_ + kNumBatchInMap;
+  };
+  for (;;) {
+    {
+      std::unique_lock<std::mutex> lck(mtx_delivery_);
+      if (io_engine_->in_flight() == 0) {
+        // All tasks are done
+        if (task_id_ >= static_cast<int>(tasks_.Size())) {
+          return SUCCESS;
+        }
+        // Nothing to reap, hanging until the iterator catches up
+        cv_delivery_.wait(lck, [this, &can_submit] { return interrupt_ || can_submit(); });
+      }
+      if (interrupt_) {
+        break;
+      }
+    }
+
+    // Keep the io engine busy as far ahead of the iterator as the map allows
+    while (io_engine_->in_flight() < io_engine_->queue_depth()) {
+      int task_id = task_id_;
+      {
+        std::lock_guard<std::mutex> lck(mtx_delivery_);
+        if (interrupt_ || !can_submit()) {
+          break;
+        }
+      }
+      const auto &task = tasks_.get_task_by_id(tasks_.permutation_[task_id]);
+      auto shard_id = std::get<0>(std::get<0>(task));
+      auto group_id = std::get<1>(std::get<0>(task));
+      const auto &addr = std::get<1>(task);
+      const auto &ret = GetBlobOffset(group_id, shard_id, addr[0]);
+      if (SUCCESS != ret.first) {
+        io_engine_->Drain();
+        return FAILED;
+      }
+      auto &blob = images[task_id];
+      blob.resize(addr[1] - addr[0]);
+      if (io_engine_->Submit(file_descriptors_[shard_id], ret.second, blob.size(), blob.data(), task_id) != SUCCESS) {
+        io_engine_->Drain();
+        return FAILED;
+      }
+      task_id_++;
+    }
+    if (io_engine_->in_flight() == 0) {
+      continue;
+    }
+
+    uint64_t tag = 0;
+    if (io_engine_->Reap(&tag) != SUCCESS) {
+      io_engine_->Drain();
+      return FAILED;
+    }
+    auto task_id = static_cast<int>(tag);
+    const auto &task = tasks_.get_task_by_id(tasks_.permutation_[task_id]);
+    auto compression = GetBlobCompression(std::get<1>(std::get<0>(task)), std::get<0>(std::get<0>(task)));
+    if (UncompressBlob(compression, &images[task_id]) != SUCCESS) {
+      io_engine_->Drain();
+      return FAILED;
+    }
+    auto batch = PackRow(std::move(images[task_id]), GetLabelJson(task));
+    (void)images.erase(task_id);
+    {
+      std::unique_lock<std::mutex> lck(mtx_delivery_);
+      delivery_map_[task_id] = std::make_shared<std::vector<std::tuple<std::vector<uint8_t>, json>>>(std::move(batch));
+    }
+    cv_iterator_.notify_one();
+  }
+  io_engine_->Drain();
+  return SUCCESS;
+}
+
+MSRStatus ShardReader::AsyncConsumerByBlock() {
+  // Set thread name
+  auto thread_id = kThreadName + "IO";
+  prctl(PR_SET_NAME, common::SafeCStr(thread_id), 0, 0, 0);
+
+  auto can_submit = [this] { return task_id_ < num_blocks_ && task_id_ < deliver_id_ + num_page_in_buffer_; };
+  for (;;) {
+    {
+      std::unique_lock<std::mutex> lck(mtx_delivery_);
+      // Nothing to reap, hanging until a page of the buffer is free or the reader is reset for a new epoch
+      if (io_engine_->in_flight() == 0) {
+        cv_delivery_.wait(lck, [this, &can_submit] { return interrupt_ || can_submit(); });
+      }
+      if (interrupt_) {
+        break;
+      }
+    }
+
+    // Keep the io engine busy as far ahead of the iterator as the page buffer allows
+    while (io_engine_->in_flight() < io_engine_->queue_depth()) {
+      int task_id = task_id_;
+      {
+        std::lock_guard<std::mutex> lck(mtx_delivery_);
+        if (interrupt_ || !can_submit()) {
+          break;
+        }
+      }
+      const auto &task = tasks_.get_task_by_id(tasks_.permutation_[task_id]);
+      auto shard_id = std::get<0>(std::get<0>(task));
+      auto group_id = std::get<1>(std::get<0>(task));
+      auto row_group_brief = ReadRowGroupBrief(group_id, shard_id, selected_columns_);
+      if (SUCCESS != std::get<0>(row_group_brief)) {
+        io_engine_->Drain();
+        return FAILED;
+      }
+      auto page_length = std::get<2>(row_group_brief);
+      auto page_offset = std::get<3>(row_group_brief);
+
+      auto buf_id = task_id % num_page_in_buffer_;
+      delivery_block_[buf_id] = std::make_shared<std::pair<std::vector<std::vector<uint64_t>>, std::vector<json>>>(
+        std::get<4>(row_group_brief), std::get<5>(row_group_brief));
+      buf_compression_[buf_id] = GetBlobCompression(group_id, shard_id);
+      if (io_engine_->Submit(file_descriptors_[shard_id], page_offset, page_length, &buf_[buf_id][0], task_id) !=
+          SUCCESS) {
+        io_engine_->Drain();
+        return FAILED;
+      }
+      task_id_++;
+    }
+    if (io_engine_->in_flight() == 0) {
+      continue;
+    }
+
+    uint64_t tag = 0;
+    if (io_engine_->Reap(&tag) != SUCCESS) {
+      io_engine_->Drain();
+      return FAILED;
+    }
+    {
+      std::unique_lock<std::mutex> lck(mtx_delivery_);
+      delivery_block_set_.insert(static_cast<int>(tag));
+    }
+    cv_iterator_.notify_one();
+  }
+  io_engine_->Drain();
+  return SUCCESS;
+}
+
 MSRStatus ShardReader::ReadBlob(const int &shard_id, const uint64_t &page_offset, const int &page_length,
                                 const int &buf_id) {
+  if (use_mmap_) {
+    if (page_offset + page_length > mapped_files_[shard_id].second) {
+      MS_LOG(ERROR) << "Page is out of the mapped file";
+      return FAILED;
+    }
+    const uint8_t *page = mapped_files_[shard_id].first + page_offset;
+    (void)std::copy(page, page + page_length, buf_[buf_id].begin());
+    return SUCCESS;
+  }
+
   auto &io_seekg = file_streams_[shard_id]->seekg(page_offset, std::ios::beg);
   if (!io_seekg.good() || io_seekg.fail() || io_seekg.bad()) {
     MS_LOG(ERROR) << "File seekg failed";
@@ -1082,15 +1454,16 @@ MSRStatus ShardReader::ConsumerByBlock(int consumer_id) {
     // Hanging if maximum map size exceeded otherwise, set batch data in buffer
     {
       std::unique_lock<std::mutex> lck(mtx_delivery_);
-      cv_delivery_.wait(lck, [task_id, this] { return interrupt_ || task_id < deliver_id_ + kNumPageInBuffer; });
+      cv_delivery_.wait(lck, [task_id, this] { return interrupt_ || task_id < deliver_id_ + num_page_in_buffer_; });
       if (interrupt_) {
         return SUCCESS;
       }
     }
 
-    auto buf_id = task_id % kNumPageInBuffer;
+    auto buf_id = task_id % num_page_in_buffer_;
     delivery_block_[buf_id] =
       std::make_shared<std::pair<std::vector<std::vector<uint64_t>>, std::vector<json>>>(offset_and_labels);
+    buf_compression_[buf_id] = GetBlobCompression(group_id, shard_id);
 
     // Read blob
     if (ReadBlob(shard_id, page_offset, page_length, buf_id) != SUCCESS) {
@@ -1114,6 +1487,9 @@ std::shared_ptr<std::vector<std::tuple<std::vector<uint8_t>, json>>> ShardReader
   auto &addr_end = offsets[rowId][1];
   std::vector<uint8_t> images(blob_page.begin() + addr_start, blob_page.begin() + addr_end);
   std::vector<std::tuple<std::vector<uint8_t>, json>> batch;
+  if (UncompressBlob(buf_compression_[buf_id], &images) != SUCCESS) {
+    return std::make_shared<std::vector<std::tuple<std::vector<uint8_t>, json>>>(std::move(batch));
+  }
   batch.emplace_back(std::move(images), std::move(labels[rowId]));
   return std::make_shared<std::vector<std::tuple<std::vector<uint8_t>, json>>>(std::move(batch));
 }
@@ -1131,7 +1507,7 @@ std::vector<std::tuple<std::vector<uint8_t>, json>> ShardReader::GetBlockNext()
       return std::vector<std::tuple<std::vector<uint8_t>, json>>();
     }
   }
-  auto buf_id = deliver_id_ % kNumPageInBuffer;
+  auto buf_id = deliver_id_ % num_page_in_buffer_;
   auto res = GetRowFromBuffer(buf_id, row_id_);
 
   row_id_++;
@@ -1187,6 +1563,17 @@ std::vector<std::tuple<std::vector<uint8_t>, json>> ShardReader::GetNextById(con
   return std::move(ret.second);
 }
 
+std::vector<std::tuple<BLOB_VIEW, json>> ShardReader::GetNextViewById(const int64_t &task_id) {
+  if (interrupt_ || block_reader_) {
+    return std::vector<std::tuple<BLOB_VIEW, json>>();
+  }
+  const auto &ret = ConsumerOneTaskView(task_id);
+  if (SUCCESS != ret.first) {
+    return std::vector<std::tuple<BLOB_VIEW, json>>();
+  }
+  return std::move(ret.second);
+}
+
 std::vector<std::tuple<std::vector<uint8_t>, pybind11::object>> ShardReader::GetNextPy() {
   auto res = GetNext();
   vector<std::tuple<std::vector<uint8_t>, pybind11::object>> jsonData;
@@ -1215,6 +1602,9 @@ void ShardReader::ShuffleTask() {
       MS_LOG(WARNING) << "Reshuffle reader tasks failed.";
     }
   }
+  if (use_mmap_ && !block_reader_) {
+    PrefetchTasks(0, kNumTaskToPrefetch);
+  }
 }
 
 }  // namespace mindrecord
@@ -226,6 +226,9 @@ std::pair<MSRStatus, std::vector<uint8_t>> ShardSegment::PackImages(int group_id
     return {FAILED, {}};
   }
 
+  if (UncompressBlob(blob_page->get_compression(), &images) != SUCCESS) {
+    return {FAILED, {}};
+  }
   return {SUCCESS, std::move(images)};
 }
 
@@ -15,6 +15,8 @@
  */
 
 #include "mindrecord/include/shard_writer.h"
+#include <fcntl.h>
+#include <stdlib.h>
 #include "common/utils.h"
 #include "mindrecord/include/common/shard_utils.h"
 #include "./securec.h"
@@ -27,17 +29,34 @@ using mindspore::MsLogLevel::INFO;
 
 namespace mindspore {
 namespace mindrecord {
+namespace {
+uint64_t AlignUp(uint64_t n_bytes) {
+  return (n_bytes + kDirectIoAlignment - 1) / kDirectIoAlignment * kDirectIoAlignment;
+}
+}  // namespace
+
 ShardWriter::ShardWriter()
     : shard_count_(1),
       header_size_(kDefaultHeaderSize),
       page_size_(kDefaultPageSize),
       row_count_(0),
-      schema_count_(1) {}
+      schema_count_(1),
+      compression_(kCompressionNone),
+      async_write_(false),
+      direct_io_(false),
+      flush_stop_(false),
+      flush_status_(SUCCESS) {}
 
 ShardWriter::~ShardWriter() {
+  (void)StopFlushWorker();
   for (int i = static_cast<int>(file_streams_.size()) - 1; i >= 0; i--) {
     file_streams_[i]->close();
   }
+  for (auto fd : direct_fds_) {
+    if (fd >= 0) {
+      (void)close(fd);
+    }
+  }
 }
 
 MSRStatus ShardWriter::Open(const std::vector<std::string> &paths, bool append) {
@@ -86,8 +105,8 @@ MSRStatus ShardWriter::Open(const std::vector<std::string> &paths, bool append)
       }
       fs->close();
 
-      // open the mindrecord file to write
-      fs->open(common::SafeCStr(file), std::ios::out | std::ios::binary);
+      // open the mindrecord file to write, and to read back the last row group when it is shifted
+      fs->open(common::SafeCStr(file), std::ios::out | std::ios::in | std::ios::trunc | std::ios::binary);
       if (!fs->good()) {
         MS_LOG(ERROR) << "MindRecord file could not opened.";
         return FAILED;
@@ -102,6 +121,16 @@ MSRStatus ShardWriter::Open(const std::vector<std::string> &paths, bool append)
     }
     MS_LOG(INFO) << "Open shard file successfully.";
     file_streams_.push_back(fs);
+
+    // Pages are written through the page cache if the file system does not support direct io
+    int fd = -1;
+    if (direct_io_) {
+      fd = open(common::SafeCStr(file), O_WRONLY | O_DIRECT);
+      if (fd < 0) {
+        MS_LOG(INFO) << "Direct io is not available, write through the page cache.";
+      }
+    }
+    direct_fds_.push_back(fd);
   }
   return SUCCESS;
 }
@@ -133,6 +162,11 @@ MSRStatus ShardWriter::OpenForAppend(const std::string &path) {
 }
 
 MSRStatus ShardWriter::Commit() {
+  // Wait for the batches written in background
+  if (StopFlushWorker() == FAILED) {
+    MS_LOG(ERROR) << "Write data in background failed";
+    return FAILED;
+  }
   if (WriteShardHeader() == FAILED) {
     MS_LOG(ERROR) << "Write metadata failed";
     return FAILED;
@@ -175,6 +209,7 @@ MSRStatus ShardWriter::SetShardHeader(std::shared_ptr<ShardHeader> header_data)
   }
 
   shard_header_ = header_data;
+  shard_columns_.clear();
   shard_header_->set_header_size(header_size_);
   shard_header_->set_page_size(page_size_);
   return SUCCESS;
@@ -209,6 +244,15 @@ MSRStatus ShardWriter::set_page_size(const uint64_t &page_size) {
   return SUCCESS;
 }
 
+MSRStatus ShardWriter::set_compression(const std::string &compression) {
+  auto ret = ShardCompressor::GetCompressionType(compression);
+  if (ret.first == FAILED) {
+    return FAILED;
+  }
+  compression_ = ret.second;
+  return SUCCESS;
+}
+
 void ShardWriter::DeleteErrorData(std::map<uint64_t, std::vector<json>> &raw_data,
                                   std::vector<std::vector<uint8_t>> &blob_data) {
   // get wrong data location
@@ -424,7 +468,7 @@ std::tuple<MSRStatus, int, int> ShardWriter::ValidateRawData(std::map<uint64_t,
 }
 
 void ShardWriter::FillArray(int start, int end, std::map<uint64_t, vector<json>> &raw_data,
-                            std::vector<std::vector<uint8_t>> &bin_data) {
+                            std::vector<std::vector<uint8_t>> &bin_data, bool binary_labels) {
   // Prevent excessive thread opening and cause cross-border
   if (start >= end) {
     flag_ = true;
@@ -436,7 +480,11 @@ void ShardWriter::FillArray(int start, int end, std::map<uint64_t, vector<json>>
     int cnt = 0;
     for (rawdata_iter = raw_data.begin(); rawdata_iter != raw_data.end(); ++rawdata_iter) {
       const json &line = raw_data.at(rawdata_iter->first)[x];
-      std::vector<std::uint8_t> bline = json::to_msgpack(line);
+      std::vector<std::uint8_t> bline;
+      // Rows which don't fit the schema, like the dummy id, stay msgpack
+      if (!binary_labels || shard_columns_.at(rawdata_iter->first)->SerializeRow(line, &bline) != SUCCESS) {
+        bline = json::to_msgpack(line);
+      }
 
       // Storage form is [Sample1-Schema1, Sample1-Schema2, Sample2-Schema1, Sample2-Schema2]
       bin_data[x * schema_count + cnt] = bline;
@@ -479,36 +527,132 @@ MSRStatus ShardWriter::WriteRawData(std::map<uint64_t, std::vector<json>> &raw_d
     return SUCCESS;
   }
 
-  std::vector<std::vector<uint8_t>> bin_raw_data(row_count * schema_count);
+  auto batch = std::make_shared<WriteBatch>();
+  batch->row_count = row_count;
+  batch->bin_raw_data = std::vector<std::vector<uint8_t>>(row_count * schema_count);
 
   // Serialize raw data
-  if (SerializeRawData(raw_data, bin_raw_data, row_count) == FAILED) {
+  if (SerializeRawData(raw_data, batch->bin_raw_data, row_count, true) == FAILED) {
     MS_LOG(ERROR) << "Serialize raw data failed";
     return FAILED;
   }
 
   // Set row size of raw data
-  if (SetRawDataSize(bin_raw_data) == FAILED) {
+  if (SetRawDataSize(batch->bin_raw_data, row_count, &batch->raw_data_size) == FAILED) {
     MS_LOG(ERROR) << "Set raw data size failed";
     return FAILED;
   }
 
   // Set row size of blob data
-  if (SetBlobDataSize(blob_data) == FAILED) {
+  if (SetBlobDataSize(blob_data, row_count, &batch->blob_data_size) == FAILED) {
     MS_LOG(ERROR) << "Set blob data size failed";
     return FAILED;
   }
 
+  // Write data to disk in background, the caller goes on with the next batch
+  batch->blob_data.swap(blob_data);
+  if (async_write_) {
+    if (PushWriteBatch(batch) == FAILED) {
+      MS_LOG(ERROR) << "Write data in background failed";
+      return FAILED;
+    }
+    MS_LOG(INFO) << "Queue " << row_count << " records to be written.";
+    return SUCCESS;
+  }
+
   // Write data to disk with multi threads
-  if (ParallelWriteData(blob_data, bin_raw_data) == FAILED) {
+  MSRStatus ret = WriteBatchData(batch);
+  blob_data.swap(batch->blob_data);
+  if (ret == FAILED) {
     MS_LOG(ERROR) << "Parallel write data failed";
     return FAILED;
   }
-  MS_LOG(INFO) << "Write " << bin_raw_data.size() << " records successfully.";
+  MS_LOG(INFO) << "Write " << batch->bin_raw_data.size() << " records successfully.";
+
+  return SUCCESS;
+}
+
+MSRStatus ShardWriter::WriteBatchData(const std::shared_ptr<WriteBatch> &batch) {
+  // Page buffers are allocated at the first write, once the page size is set
+  if (page_buffers_.empty()) {
+    for (int i = 0; i < shard_count_; ++i) {
+      void *buf = nullptr;
+      if (posix_memalign(&buf, kDirectIoAlignment, AlignUp(page_size_)) != 0) {
+        MS_LOG(ERROR) << "Allocate page buffer failed";
+        page_buffers_.clear();
+        return FAILED;
+      }
+      page_buffers_.emplace_back(static_cast<uint8_t *>(buf), free);
+    }
+  }
+  raw_data_size_ = std::move(batch->raw_data_size);
+  blob_data_size_ = std::move(batch->blob_data_size);
+  if (compression_ != kCompressionNone) {
+    compressed_blobs_.resize(batch->row_count);
+  }
+  return ParallelWriteData(batch->blob_data, batch->bin_raw_data, batch->row_count);
+}
 
+MSRStatus ShardWriter::PushWriteBatch(const std::shared_ptr<WriteBatch> &batch) {
+  std::unique_lock<std::mutex> lock(queue_mutex_);
+  if (!flush_thread_.joinable()) {
+    flush_stop_ = false;
+    flush_thread_ = std::thread(&ShardWriter::FlushWorker, this);
+  }
+
+  // Wait for room in the queue, the next batch is serialized meanwhile
+  queue_cv_.wait(lock, [this] {
+    return static_cast<int>(write_queue_.size()) < kWriteQueueDepth || flush_status_ == FAILED;
+  });
+  if (flush_status_ == FAILED) {
+    return FAILED;
+  }
+  write_queue_.push_back(batch);
+  queue_cv_.notify_all();
   return SUCCESS;
 }
 
+void ShardWriter::FlushWorker() {
+  while (true) {
+    std::shared_ptr<WriteBatch> batch;
+    {
+      std::unique_lock<std::mutex> lock(queue_mutex_);
+      queue_cv_.wait(lock, [this] { return !write_queue_.empty() || flush_stop_; });
+      if (write_queue_.empty()) {
+        return;
+      }
+      batch = write_queue_.front();
+    }
+
+    // Batches after a failed one are dropped, the file is broken anyway
+    MSRStatus ret = flush_status_ == SUCCESS ? WriteBatchData(batch) : FAILED;
+    if (ret == SUCCESS) {
+      MS_LOG(INFO) << "Write " << batch->bin_raw_data.size() << " records successfully.";
+    }
+    {
+      std::lock_guard<std::mutex> lock(queue_mutex_);
+      write_queue_.pop_front();
+      if (ret == FAILED) {
+        flush_status_ = FAILED;
+      }
+    }
+    queue_cv_.notify_all();
+  }
+}
+
+MSRStatus ShardWriter::StopFlushWorker() {
+  if (!flush_thread_.joinable()) {
+    return flush_status_;
+  }
+  {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    flush_stop_ = true;
+  }
+  queue_cv_.notify_all();
+  flush_thread_.join();
+  return flush_status_;
+}
+
 MSRStatus ShardWriter::WriteRawData(std::map<uint64_t, std::vector<py::handle>> &raw_data,
                                     std::map<uint64_t, std::vector<py::handle>> &blob_data, bool sign) {
   std::map<uint64_t, std::vector<json>> raw_data_json;
@@ -562,8 +706,8 @@ MSRStatus ShardWriter::WriteRawData(std::map<uint64_t, std::vector<py::handle>>
 }
 
 MSRStatus ShardWriter::ParallelWriteData(const std::vector<std::vector<uint8_t>> &blob_data,
-                                         const std::vector<std::vector<uint8_t>> &bin_raw_data) {
-  auto shards = BreakIntoShards();
+                                         const std::vector<std::vector<uint8_t>> &bin_raw_data, uint32_t row_count) {
+  auto shards = BreakIntoShards(row_count);
   // define the number of thread
   int thread_num = static_cast<int>(shard_count_);
   if (thread_num < 0) {
@@ -574,6 +718,7 @@ MSRStatus ShardWriter::ParallelWriteData(const std::vector<std::vector<uint8_t>>
   }
   int left_thread = shard_count_;
   int current_thread = 0;
+  std::vector<MSRStatus> shard_status(shard_count_, SUCCESS);
   while (left_thread) {
     if (left_thread < thread_num) {
       thread_num = left_thread;
@@ -584,8 +729,10 @@ MSRStatus ShardWriter::ParallelWriteData(const std::vector<std::vector<uint8_t>>
       for (int x = 0; x < thread_num; ++x) {
         int start_row = shards[current_thread + x].first;
         int end_row = shards[current_thread + x].second;
-        thread_set[x] = std::thread(&ShardWriter::WriteByShard, this, current_thread + x, start_row, end_row,
-                                    std::ref(blob_data), std::ref(bin_raw_data));
+        int shard_id = current_thread + x;
+        thread_set[x] = std::thread([this, &shard_status, &blob_data, &bin_raw_data, shard_id, start_row, end_row] {
+          shard_status[shard_id] = WriteByShard(shard_id, start_row, end_row, blob_data, bin_raw_data);
+        });
       }
       // Wait for threads done
       for (int x = 0; x < thread_num; ++x) {
@@ -595,6 +742,9 @@ MSRStatus ShardWriter::ParallelWriteData(const std::vector<std::vector<uint8_t>>
       current_thread += thread_num;
     }
   }
+  if (std::any_of(shard_status.begin(), shard_status.end(), [](MSRStatus status) { return status == FAILED; })) {
+    return FAILED;
+  }
   return SUCCESS;
 }
 
@@ -612,7 +762,16 @@ MSRStatus ShardWriter::WriteByShard(int shard_id, int start_row, int end_row,
   SetLastRawPage(shard_id, last_raw_page);
   SetLastBlobPage(shard_id, last_blob_page);
 
-  if (CutRowGroup(start_row, end_row, blob_data, rows_in_group, last_raw_page, last_blob_page) == FAILED) {
+  // Blob data is compressed by the shard thread before the rows are cut into pages by their compressed size
+  if (compression_ != kCompressionNone && CompressBlobData(start_row, end_row, blob_data) == FAILED) {
+    MS_LOG(ERROR) << "Compress blob data failed";
+    return FAILED;
+  }
+
+  // Rows are appended to the last blob page only if it has the codec of the writer
+  auto appendable_blob_page =
+    last_blob_page && last_blob_page->get_compression() == compression_ ? last_blob_page : nullptr;
+  if (CutRowGroup(start_row, end_row, blob_data, rows_in_group, last_raw_page, appendable_blob_page) == FAILED) {
     MS_LOG(ERROR) << "Cut row group failed";
     return FAILED;
   }
@@ -640,6 +799,25 @@ MSRStatus ShardWriter::WriteByShard(int shard_id, int start_row, int end_row,
   return SUCCESS;
 }
 
+MSRStatus ShardWriter::CompressBlobData(int start_row, int end_row,
+                                        const std::vector<std::vector<uint8_t>> &blob_data) {
+  if (end_row > static_cast<int>(compressed_blobs_.size()) || end_row > static_cast<int>(blob_data.size())) {
+    return FAILED;
+  }
+  for (int i = start_row; i < end_row; ++i) {
+    if (ShardCompressor::Compress(compression_, blob_data[i].data(), blob_data[i].size(), &compressed_blobs_[i]) ==
+        FAILED) {
+      return FAILED;
+    }
+    blob_data_size_[i] = kInt64Len + compressed_blobs_[i].size();
+    if (blob_data_size_[i] > page_size_) {
+      MS_LOG(ERROR) << "Page size is too small to save a row!";
+      return FAILED;
+    }
+  }
+  return SUCCESS;
+}
+
 MSRStatus ShardWriter::CutRowGroup(int start_row, int end_row, const std::vector<std::vector<uint8_t>> &blob_data,
                                    std::vector<std::pair<int, int>> &rows_in_group,
                                    const std::shared_ptr<Page> &last_raw_page,
@@ -685,15 +863,10 @@ MSRStatus ShardWriter::AppendBlobPage(const int &shard_id, const std::vector<std
   // Write disk
   auto page_id = last_blob_page->get_page_id();
   auto bytes_page = last_blob_page->get_page_size();
-  auto &io_seekp = file_streams_[shard_id]->seekp(page_size_ * page_id + header_size_ + bytes_page, std::ios::beg);
-  if (!io_seekp.good() || io_seekp.fail() || io_seekp.bad()) {
-    MS_LOG(ERROR) << "File seekp failed";
-    file_streams_[shard_id]->close();
+  if (FlushBlobChunk(shard_id, page_size_ * page_id + header_size_ + bytes_page, blob_data, blob_row) == FAILED) {
     return FAILED;
   }
 
-  (void)FlushBlobChunk(file_streams_[shard_id], blob_data, blob_row);
-
   // Update last blob page
   bytes_page += std::accumulate(blob_data_size_.begin() + blob_row.first, blob_data_size_.begin() + blob_row.second, 0);
   last_blob_page->set_page_size(bytes_page);
@@ -713,22 +886,19 @@ MSRStatus ShardWriter::NewBlobPage(const int &shard_id, const std::vector<std::v
   for (uint32_t i = 1; i < rows_in_group.size(); ++i) {
     auto blob_row = rows_in_group[i];
 
-    // Write 1 blob page to disk
-    auto &io_seekp = file_streams_[shard_id]->seekp(page_size_ * (page_id + 1) + header_size_, std::ios::beg);
-    if (!io_seekp.good() || io_seekp.fail() || io_seekp.bad()) {
-      MS_LOG(ERROR) << "File seekp failed";
-      file_streams_[shard_id]->close();
+    // Write 1 blob page to disk, the page is new so it may go around the page cache
+    if (FlushBlobChunk(shard_id, page_size_ * (page_id + 1) + header_size_, blob_data, blob_row, direct_io_) ==
+        FAILED) {
       return FAILED;
     }
-
-    (void)FlushBlobChunk(file_streams_[shard_id], blob_data, blob_row);
     // Create new page info for header
     auto page_size =
       std::accumulate(blob_data_size_.begin() + blob_row.first, blob_data_size_.begin() + blob_row.second, 0);
     std::vector<std::pair<int, uint64_t>> row_group_ids;
     auto start_row = current_row;
     auto end_row = start_row + blob_row.second - blob_row.first;
-    auto page = Page(++page_id, shard_id, kPageTypeBlob, ++page_type_id, start_row, end_row, row_group_ids, page_size);
+    auto page = Page(++page_id, shard_id, kPageTypeBlob, ++page_type_id, start_row, end_row, row_group_ids, page_size,
+                     compression_);
     (void)shard_header_->AddPage(std::make_shared<Page>(page));
     current_row = end_row;
   }
@@ -842,18 +1012,14 @@ MSRStatus ShardWriter::AppendRawPage(const int &shard_id, const std::vector<std:
   auto n_bytes = last_raw_page->get_page_size();
 
   //  previous raw data page
-  auto &io_seekp =
-    file_streams_[shard_id]->seekp(page_size_ * last_raw_page_id + header_size_ + n_bytes, std::ios::beg);
-  if (!io_seekp.good() || io_seekp.fail() || io_seekp.bad()) {
-    MS_LOG(ERROR) << "File seekp failed";
-    file_streams_[shard_id]->close();
+  if (FlushRawChunk(shard_id, page_size_ * last_raw_page_id + header_size_ + n_bytes, rows_in_group, chunk_id,
+                    bin_raw_data) == FAILED) {
     return FAILED;
   }
 
   if (chunk_id > 0) row_group_ids.emplace_back(++last_row_group_id, n_bytes);
   n_bytes += std::accumulate(raw_data_size_.begin() + rows_in_group[chunk_id].first,
                              raw_data_size_.begin() + rows_in_group[chunk_id].second, 0);
-  (void)FlushRawChunk(file_streams_[shard_id], rows_in_group, chunk_id, bin_raw_data);
 
   // Update previous raw data page
   last_raw_page->set_page_size(n_bytes);
@@ -863,70 +1029,97 @@ MSRStatus ShardWriter::AppendRawPage(const int &shard_id, const std::vector<std:
   return SUCCESS;
 }
 
-MSRStatus ShardWriter::FlushBlobChunk(const std::shared_ptr<std::fstream> &out,
+MSRStatus ShardWriter::FlushBlobChunk(const int &shard_id, uint64_t offset,
                                       const std::vector<std::vector<uint8_t>> &blob_data,
-                                      const std::pair<int, int> &blob_row) {
+                                      const std::pair<int, int> &blob_row, bool direct) {
   if (blob_row.first > blob_row.second) {
     return FAILED;
   }
   if (blob_row.second > static_cast<int>(blob_data.size()) || blob_row.first < 0) {
     return FAILED;
   }
-  for (int j = blob_row.first; j < blob_row.second; ++j) {
-    // Write the size of blob
-    uint64_t line_len = blob_data[j].size();
-    auto &io_handle = out->write(reinterpret_cast<char *>(&line_len), kInt64Len);
-    if (!io_handle.good() || io_handle.fail() || io_handle.bad()) {
-      MS_LOG(ERROR) << "File write failed";
-      out->close();
-      return FAILED;
-    }
 
-    // Write the data of blob
-    auto line = blob_data[j];
-    auto &io_handle_data = out->write(reinterpret_cast<char *>(&line[0]), line_len);
-    if (!io_handle_data.good() || io_handle_data.fail() || io_handle_data.bad()) {
-      MS_LOG(ERROR) << "File write failed";
-      out->close();
+  // Assemble the chunk in the page buffer, the size of each blob before its data, and write it at once
+  const auto &blobs = compression_ == kCompressionNone ? blob_data : compressed_blobs_;
+  uint8_t *buf = page_buffers_[shard_id].get();
+  uint64_t n_bytes = 0;
+  for (int j = blob_row.first; j < blob_row.second; ++j) {
+    uint64_t line_len = blobs[j].size();
+    if (n_bytes + kInt64Len + line_len > page_size_) {
+      MS_LOG(ERROR) << "Blob chunk is larger than a page";
       return FAILED;
     }
+    auto len_bytes = reinterpret_cast<const uint8_t *>(&line_len);
+    (void)std::copy(len_bytes, len_bytes + kInt64Len, buf + n_bytes);
+    (void)std::copy(blobs[j].begin(), blobs[j].end(), buf + n_bytes + kInt64Len);
+    n_bytes += kInt64Len + line_len;
   }
-  return SUCCESS;
+  return WriteChunk(shard_id, offset, n_bytes, direct);
 }
 
-MSRStatus ShardWriter::FlushRawChunk(const std::shared_ptr<std::fstream> &out,
+MSRStatus ShardWriter::FlushRawChunk(const int &shard_id, uint64_t offset,
                                      const std::vector<std::pair<int, int>> &rows_in_group, const int &chunk_id,
                                      const std::vector<std::vector<uint8_t>> &bin_raw_data) {
+  // Assemble the chunk in the page buffer and write it at once
+  uint8_t *buf = page_buffers_[shard_id].get();
+  uint64_t n_bytes = 0;
   for (int i = rows_in_group[chunk_id].first; i < rows_in_group[chunk_id].second; i++) {
-    // Write the size of multi schemas
+    if (n_bytes + raw_data_size_[i] > page_size_) {
+      MS_LOG(ERROR) << "Raw chunk is larger than a page";
+      return FAILED;
+    }
+    // The size of multi schemas
     for (uint32_t j = 0; j < schema_count_; ++j) {
       uint64_t line_len = bin_raw_data[i * schema_count_ + j].size();
-      auto &io_handle = out->write(reinterpret_cast<char *>(&line_len), kInt64Len);
-      if (!io_handle.good() || io_handle.fail() || io_handle.bad()) {
-        MS_LOG(ERROR) << "File write failed";
-        out->close();
-        return FAILED;
-      }
+      auto len_bytes = reinterpret_cast<const uint8_t *>(&line_len);
+      (void)std::copy(len_bytes, len_bytes + kInt64Len, buf + n_bytes);
+      n_bytes += kInt64Len;
     }
-    // Write the data of multi schemas
+    // The data of multi schemas
     for (uint32_t j = 0; j < schema_count_; ++j) {
-      auto line = bin_raw_data[i * schema_count_ + j];
-      auto &io_handle = out->write(reinterpret_cast<char *>(&line[0]), line.size());
-      if (!io_handle.good() || io_handle.fail() || io_handle.bad()) {
-        MS_LOG(ERROR) << "File write failed";
-        out->close();
-        return FAILED;
-      }
+      const auto &line = bin_raw_data[i * schema_count_ + j];
+      (void)std::copy(line.begin(), line.end(), buf + n_bytes);
+      n_bytes += line.size();
+    }
+  }
+  return WriteChunk(shard_id, offset, n_bytes, false);
+}
+
+MSRStatus ShardWriter::WriteChunk(int shard_id, uint64_t offset, uint64_t n_bytes, bool direct) {
+  uint8_t *buf = page_buffers_[shard_id].get();
+  if (direct && direct_fds_[shard_id] >= 0 && offset % kDirectIoAlignment == 0 &&
+      page_size_ % kDirectIoAlignment == 0) {
+    // Pad to the alignment with zeros. The padding stays in the page and rows appended to the page overwrite it
+    uint64_t n_aligned = AlignUp(n_bytes);
+    (void)std::fill(buf + n_bytes, buf + n_aligned, 0);
+    if (pwrite(direct_fds_[shard_id], buf, n_aligned, static_cast<off_t>(offset)) == static_cast<ssize_t>(n_aligned)) {
+      return SUCCESS;
     }
+    MS_LOG(INFO) << "Direct io write failed, write through the page cache.";
+    (void)close(direct_fds_[shard_id]);
+    direct_fds_[shard_id] = -1;
+  }
+
+  auto &io_seekp = file_streams_[shard_id]->seekp(offset, std::ios::beg);
+  if (!io_seekp.good() || io_seekp.fail() || io_seekp.bad()) {
+    MS_LOG(ERROR) << "File seekp failed";
+    file_streams_[shard_id]->close();
+    return FAILED;
+  }
+  auto &io_handle = file_streams_[shard_id]->write(reinterpret_cast<char *>(buf), n_bytes);
+  if (!io_handle.good() || io_handle.fail() || io_handle.bad()) {
+    MS_LOG(ERROR) << "File write failed";
+    file_streams_[shard_id]->close();
+    return FAILED;
   }
   return SUCCESS;
 }
 
 // Allocate data to shards evenly
-std::vector<std::pair<int, int>> ShardWriter::BreakIntoShards() {
+std::vector<std::pair<int, int>> ShardWriter::BreakIntoShards(uint32_t row_count) {
   std::vector<std::pair<int, int>> shards;
-  int row_in_shard = row_count_ / shard_count_;
-  int remains = row_count_ % shard_count_;
+  int row_in_shard = row_count / shard_count_;
+  int remains = row_count % shard_count_;
 
   std::vector<int> v_list(shard_count_);
   std::iota(v_list.begin(), v_list.end(), 0);
@@ -993,7 +1186,20 @@ MSRStatus ShardWriter::WriteShardHeader() {
 }
 
 MSRStatus ShardWriter::SerializeRawData(std::map<uint64_t, std::vector<json>> &raw_data,
-                                        std::vector<std::vector<uint8_t>> &bin_data, uint32_t row_count) {
+                                        std::vector<std::vector<uint8_t>> &bin_data, uint32_t row_count,
+                                        bool binary_labels) {
+  if (binary_labels) {
+    for (const auto &rawdata_iter : raw_data) {
+      if (shard_columns_.find(rawdata_iter.first) != shard_columns_.end()) {
+        continue;
+      }
+      auto result = shard_header_->GetSchemaByID(rawdata_iter.first);
+      if (result.second != SUCCESS) {
+        return FAILED;
+      }
+      shard_columns_[rawdata_iter.first] = std::make_shared<ShardColumn>(result.first);
+    }
+  }
   // define the number of thread
   uint32_t thread_num = std::thread::hardware_concurrency();
   if (thread_num == 0) thread_num = kThreadNumber;
@@ -1009,7 +1215,8 @@ MSRStatus ShardWriter::SerializeRawData(std::map<uint64_t, std::vector<json>> &r
     }
     // Define the run boundary and start the child thread
     thread_set[x] =
-      std::thread(&ShardWriter::FillArray, this, start_num, end_num, std::ref(raw_data), std::ref(bin_data));
+      std::thread(&ShardWriter::FillArray, this, start_num, end_num, std::ref(raw_data), std::ref(bin_data),
+                  binary_labels);
     work_thread_num++;
   }
   for (uint32_t x = 0; x < work_thread_num; ++x) {
@@ -1019,25 +1226,27 @@ MSRStatus ShardWriter::SerializeRawData(std::map<uint64_t, std::vector<json>> &r
   return flag_ == true ? FAILED : SUCCESS;
 }
 
-MSRStatus ShardWriter::SetRawDataSize(const std::vector<std::vector<uint8_t>> &bin_raw_data) {
-  raw_data_size_ = std::vector<uint64_t>(row_count_, 0);
-  for (uint32_t i = 0; i < row_count_; ++i) {
-    raw_data_size_[i] = std::accumulate(
+MSRStatus ShardWriter::SetRawDataSize(const std::vector<std::vector<uint8_t>> &bin_raw_data, uint32_t row_count,
+                                      std::vector<uint64_t> *raw_data_size) {
+  *raw_data_size = std::vector<uint64_t>(row_count, 0);
+  for (uint32_t i = 0; i < row_count; ++i) {
+    (*raw_data_size)[i] = std::accumulate(
       bin_raw_data.begin() + (i * schema_count_), bin_raw_data.begin() + (i * schema_count_) + schema_count_, 0,
       [](uint64_t accumulator, const std::vector<uint8_t> &row) { return accumulator + kInt64Len + row.size(); });
   }
-  if (*std::max_element(raw_data_size_.begin(), raw_data_size_.end()) > page_size_) {
+  if (*std::max_element(raw_data_size->begin(), raw_data_size->end()) > page_size_) {
     MS_LOG(ERROR) << "Page size is too small to save a row!";
     return FAILED;
   }
   return SUCCESS;
 }
 
-MSRStatus ShardWriter::SetBlobDataSize(const std::vector<std::vector<uint8_t>> &blob_data) {
-  blob_data_size_ = std::vector<uint64_t>(row_count_);
-  (void)std::transform(blob_data.begin(), blob_data.end(), blob_data_size_.begin(),
+MSRStatus ShardWriter::SetBlobDataSize(const std::vector<std::vector<uint8_t>> &blob_data, uint32_t row_count,
+                                       std::vector<uint64_t> *blob_data_size) {
+  *blob_data_size = std::vector<uint64_t>(row_count);
+  (void)std::transform(blob_data.begin(), blob_data.end(), blob_data_size->begin(),
                        [](const std::vector<uint8_t> &row) { return kInt64Len + row.size(); });
-  if (*std::max_element(blob_data_size_.begin(), blob_data_size_.end()) > page_size_) {
+  if (*std::max_element(blob_data_size->begin(), blob_data_size->end()) > page_size_) {
     MS_LOG(ERROR) << "Page size is too small to save a row!";
     return FAILED;
   }
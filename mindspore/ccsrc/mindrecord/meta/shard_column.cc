@@ -0,0 +1,405 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mindrecord/include/shard_column.h"
+#include <algorithm>
+#include <limits>
+#include <set>
+#include <sstream>
+#include "common/utils.h"
+
+using mindspore::LogStream;
+using mindspore::ExceptionType::NoExceptionType;
+using mindspore::MsLogLevel::ERROR;
+
+namespace mindspore {
+namespace mindrecord {
+namespace {
+ColumnDataType ColumnDataTypeOf(const std::string &type) {
+  if (type == "int32") return ColumnInt32;
+  if (type == "int64") return ColumnInt64;
+  if (type == "float32") return ColumnFloat32;
+  if (type == "float64") return ColumnFloat64;
+  return ColumnString;
+}
+
+template <typename T>
+void AppendNumber(T value, std::vector<uint8_t> *bin) {
+  auto bytes = reinterpret_cast<const uint8_t *>(&value);
+  (void)bin->insert(bin->end(), bytes, bytes + sizeof(T));
+}
+
+template <typename T>
+T ReadNumber(const uint8_t *data) {
+  T value;
+  (void)std::copy(data, data + sizeof(T), reinterpret_cast<uint8_t *>(&value));
+  return value;
+}
+
+template <typename T>
+T TextToNumber(const std::string &str) {
+  std::istringstream iss(str);
+  T num = 0;
+  iss >> num;
+  return num;
+}
+
+json ValueToJson(ColumnDataType type, const uint8_t *data, uint64_t n_bytes) {
+  switch (type) {
+    case ColumnInt32:
+      return ReadNumber<int32_t>(data);
+    case ColumnInt64:
+      return ReadNumber<int64_t>(data);
+    case ColumnFloat32:
+      return ReadNumber<float>(data);
+    case ColumnFloat64:
+      return ReadNumber<double>(data);
+    default:
+      return std::string(reinterpret_cast<const char *>(data), n_bytes);
+  }
+}
+}  // namespace
+
+ShardColumn::ShardColumn(const std::shared_ptr<Schema> &schema, const std::vector<std::string> &columns)
+    : extra_columns_(columns.begin(), columns.end()), num_rows_(0) {
+  json schema_json = schema->GetSchema()["schema"];
+  std::vector<std::string> blob_fields = schema->get_blob_fields();
+  std::set<std::string> blob_set(blob_fields.begin(), blob_fields.end());
+  for (auto it = schema_json.begin(); it != schema_json.end(); ++it) {
+    if (blob_set.count(it.key()) == 0) {
+      schema_names_.emplace_back(it.key());
+      schema_types_.emplace_back(ColumnDataTypeOf(it.value()["type"].get<std::string>()));
+    }
+  }
+
+  // Columns are held in the order they are asked for
+  std::vector<std::string> names = columns.empty() ? schema_names_ : columns;
+  for (const auto &name : names) {
+    auto it = std::find(schema_names_.begin(), schema_names_.end(), name);
+    if (it == schema_names_.end() || column_ids_.count(name) > 0) {
+      continue;
+    }
+    column_ids_[name] = static_cast<int>(column_names_.size());
+    column_names_.emplace_back(name);
+    column_types_.emplace_back(schema_types_[it - schema_names_.begin()]);
+  }
+  for (const auto &name : schema_names_) {
+    schema_to_column_.emplace_back(GetColumnId(name));
+  }
+
+  values_.resize(column_names_.size());
+  string_offsets_.resize(column_names_.size());
+  for (size_t i = 0; i < column_types_.size(); ++i) {
+    if (column_types_[i] == ColumnString) {
+      string_offsets_[i].emplace_back(0);
+    }
+  }
+}
+
+uint64_t ShardColumn::TypeSize(ColumnDataType type) {
+  switch (type) {
+    case ColumnInt32:
+    case ColumnFloat32:
+      return sizeof(int32_t);
+    case ColumnInt64:
+    case ColumnFloat64:
+      return sizeof(int64_t);
+    default:
+      return 0;
+  }
+}
+
+int ShardColumn::GetColumnId(const std::string &column_name) const {
+  auto it = column_ids_.find(column_name);
+  return it == column_ids_.end() ? -1 : it->second;
+}
+
+MSRStatus ShardColumn::SerializeRow(const json &row, std::vector<uint8_t> *bin) const {
+  if (!row.is_object() || row.size() != schema_names_.size()) {
+    return FAILED;
+  }
+  bin->clear();
+  bin->emplace_back(kBinaryRowMarker);
+  for (size_t i = 0; i < schema_names_.size(); ++i) {
+    auto it = row.find(schema_names_[i]);
+    if (it == row.end()) {
+      return FAILED;
+    }
+    switch (schema_types_[i]) {
+      case ColumnInt32: {
+        if (!it->is_number_integer() || it->get<int64_t>() < std::numeric_limits<int32_t>::min() ||
+            it->get<int64_t>() > std::numeric_limits<int32_t>::max()) {
+          return FAILED;
+        }
+        AppendNumber(it->get<int32_t>(), bin);
+        break;
+      }
+      case ColumnInt64: {
+        if (!it->is_number_integer()) {
+          return FAILED;
+        }
+        AppendNumber(it->get<int64_t>(), bin);
+        break;
+      }
+      case ColumnFloat32: {
+        if (!it->is_number()) {
+          return FAILED;
+        }
+        AppendNumber(it->get<float>(), bin);
+        break;
+      }
+      case ColumnFloat64: {
+        if (!it->is_number()) {
+          return FAILED;
+        }
+        AppendNumber(it->get<double>(), bin);
+        break;
+      }
+      default: {
+        if (!it->is_string()) {
+          return FAILED;
+        }
+        const auto &str = it->get_ref<const std::string &>();
+        AppendNumber(static_cast<uint64_t>(str.size()), bin);
+        (void)bin->insert(bin->end(), str.begin(), str.end());
+        break;
+      }
+    }
+  }
+  return SUCCESS;
+}
+
+MSRStatus ShardColumn::SplitRow(const uint8_t *data, uint64_t size,
+                                std::vector<std::pair<const uint8_t *, uint64_t>> *fields) const {
+  uint64_t pos = 1;
+  for (size_t i = 0; i < schema_names_.size(); ++i) {
+    uint64_t n_bytes = TypeSize(schema_types_[i]);
+    if (schema_types_[i] == ColumnString) {
+      if (kInt64Len > size - pos) break;
+      n_bytes = ReadNumber<uint64_t>(data + pos);
+      pos += kInt64Len;
+    }
+    if (n_bytes > size - pos) break;
+    fields->emplace_back(data + pos, n_bytes);
+    pos += n_bytes;
+  }
+  if (fields->size() != schema_names_.size() || pos != size) {
+    MS_LOG(ERROR) << "Raw data of " << size << " bytes does not match the schema.";
+    return FAILED;
+  }
+  return SUCCESS;
+}
+
+MSRStatus ShardColumn::DeserializeRow(const uint8_t *data, uint64_t size, json *row) const {
+  if (size == 0 || data[0] != kBinaryRowMarker) {
+    // Rows written by older versions are msgpack
+    try {
+      *row = json::from_msgpack(data, data + size);
+    } catch (json::exception &e) {
+      MS_LOG(ERROR) << "Failed to decode raw data: " << e.what();
+      return FAILED;
+    }
+    return SUCCESS;
+  }
+  std::vector<std::pair<const uint8_t *, uint64_t>> fields;
+  if (SplitRow(data, size, &fields) == FAILED) {
+    return FAILED;
+  }
+  json values = json::object();
+  for (size_t i = 0; i < fields.size(); ++i) {
+    values[schema_names_[i]] = ValueToJson(schema_types_[i], fields[i].first, fields[i].second);
+  }
+  *row = std::move(values);
+  return SUCCESS;
+}
+
+MSRStatus ShardColumn::AppendRow(const uint8_t *data, uint64_t size) {
+  if (size == 0 || data[0] != kBinaryRowMarker) {
+    json row;
+    if (DeserializeRow(data, size, &row) == FAILED) {
+      return FAILED;
+    }
+    return AppendRow(row);
+  }
+
+  // Check the whole row before any column grows
+  std::vector<std::pair<const uint8_t *, uint64_t>> fields;
+  if (SplitRow(data, size, &fields) == FAILED) {
+    return FAILED;
+  }
+  for (size_t i = 0; i < fields.size(); ++i) {
+    if (schema_to_column_[i] >= 0) {
+      AppendBytes(schema_to_column_[i], fields[i].first, fields[i].second);
+    }
+  }
+  num_rows_++;
+  return SUCCESS;
+}
+
+MSRStatus ShardColumn::AppendRow(const json &row) {
+  for (size_t i = 0; i < column_names_.size(); ++i) {
+    auto it = row.find(column_names_[i]);
+    if (it == row.end() || AppendValue(static_cast<int>(i), *it) == FAILED) {
+      MS_LOG(ERROR) << "Field " << column_names_[i] << " is missing or of the wrong type in " << row.dump();
+      // Drop the values of the row which were appended already
+      for (size_t j = 0; j < i; ++j) {
+        if (column_types_[j] == ColumnString) {
+          string_offsets_[j].pop_back();
+          values_[j].resize(string_offsets_[j].back());
+        } else {
+          values_[j].resize(num_rows_ * TypeSize(column_types_[j]));
+        }
+      }
+      return FAILED;
+    }
+  }
+  if (row.is_object()) {
+    json extra_fields;
+    for (auto it = row.begin(); it != row.end(); ++it) {
+      if (column_ids_.count(it.key()) == 0 && (extra_columns_.empty() || extra_columns_.count(it.key()) > 0)) {
+        extra_fields[it.key()] = it.value();
+      }
+    }
+    if (!extra_fields.empty()) {
+      extra_fields_[num_rows_] = std::move(extra_fields);
+    }
+  }
+  num_rows_++;
+  return SUCCESS;
+}
+
+MSRStatus ShardColumn::AppendRow(const std::vector<std::string> &columns, const std::vector<std::string> &values,
+                                 size_t first_value) {
+  if (values.size() < first_value + columns.size()) {
+    return FAILED;
+  }
+  std::vector<bool> appended(column_names_.size(), false);
+  for (size_t i = 0; i < columns.size(); ++i) {
+    int column_id = GetColumnId(columns[i]);
+    if (column_id < 0 || appended[column_id]) {
+      continue;
+    }
+    appended[column_id] = true;
+    const std::string &value = values[first_value + i];
+    switch (column_types_[column_id]) {
+      case ColumnInt32:
+        AppendNumber(TextToNumber<int32_t>(value), &values_[column_id]);
+        break;
+      case ColumnInt64:
+        AppendNumber(TextToNumber<int64_t>(value), &values_[column_id]);
+        break;
+      case ColumnFloat32:
+        AppendNumber(TextToNumber<float>(value), &values_[column_id]);
+        break;
+      case ColumnFloat64:
+        AppendNumber(TextToNumber<double>(value), &values_[column_id]);
+        break;
+      default:
+        AppendBytes(column_id, reinterpret_cast<const uint8_t *>(value.data()), value.size());
+        break;
+    }
+  }
+  // Columns without a value read as zero or as an empty string
+  for (size_t i = 0; i < appended.size(); ++i) {
+    if (!appended[i]) {
+      auto n_bytes = TypeSize(column_types_[i]);
+      values_[i].resize(values_[i].size() + n_bytes, 0);
+      AppendBytes(static_cast<int>(i), nullptr, 0);
+    }
+  }
+  num_rows_++;
+  return SUCCESS;
+}
+
+MSRStatus ShardColumn::AppendValue(int column_id, const json &value) {
+  auto &values = values_[column_id];
+  switch (column_types_[column_id]) {
+    case ColumnInt32: {
+      if (!value.is_number()) return FAILED;
+      AppendNumber(value.get<int32_t>(), &values);
+      break;
+    }
+    case ColumnInt64: {
+      if (!value.is_number()) return FAILED;
+      AppendNumber(value.get<int64_t>(), &values);
+      break;
+    }
+    case ColumnFloat32: {
+      if (!value.is_number()) return FAILED;
+      AppendNumber(value.get<float>(), &values);
+      break;
+    }
+    case ColumnFloat64: {
+      if (!value.is_number()) return FAILED;
+      AppendNumber(value.get<double>(), &values);
+      break;
+    }
+    default: {
+      if (!value.is_string()) return FAILED;
+      const auto &str = value.get_ref<const std::string &>();
+      AppendBytes(column_id, reinterpret_cast<const uint8_t *>(str.data()), str.size());
+      break;
+    }
+  }
+  return SUCCESS;
+}
+
+void ShardColumn::AppendBytes(int column_id, const uint8_t *data, uint64_t n_bytes) {
+  auto &values = values_[column_id];
+  if (n_bytes > 0) {
+    (void)values.insert(values.end(), data, data + n_bytes);
+  }
+  if (column_types_[column_id] == ColumnString) {
+    string_offsets_[column_id].emplace_back(values.size());
+  }
+}
+
+MSRStatus ShardColumn::GetColumnValue(uint64_t row_id, int column_id, const uint8_t **data, uint64_t *n_bytes) const {
+  if (row_id >= num_rows_ || column_id < 0 || column_id >= static_cast<int>(column_names_.size())) {
+    return FAILED;
+  }
+  if (column_types_[column_id] == ColumnString) {
+    const auto &offsets = string_offsets_[column_id];
+    *data = values_[column_id].data() + offsets[row_id];
+    *n_bytes = offsets[row_id + 1] - offsets[row_id];
+  } else {
+    *n_bytes = TypeSize(column_types_[column_id]);
+    *data = values_[column_id].data() + row_id * (*n_bytes);
+  }
+  return SUCCESS;
+}
+
+json ShardColumn::GetRowJson(uint64_t row_id) const {
+  json row;
+  for (size_t i = 0; i < column_names_.size(); ++i) {
+    const uint8_t *data = nullptr;
+    uint64_t n_bytes = 0;
+    if (GetColumnValue(row_id, static_cast<int>(i), &data, &n_bytes) == SUCCESS) {
+      row[column_names_[i]] = ValueToJson(column_types_[i], data, n_bytes);
+    }
+  }
+  auto it = extra_fields_.find(row_id);
+  if (it != extra_fields_.end()) {
+    if (row.is_null()) {
+      row = it->second;
+    } else {
+      row.update(it->second);
+    }
+  }
+  return row;
+}
+}  // namespace mindrecord
+}  // namespace mindspore
@@ -0,0 +1,120 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mindrecord/include/shard_compressor.h"
+#include <lz4.h>
+#include <zstd.h>
+#include <algorithm>
+#include "common/utils.h"
+
+using mindspore::LogStream;
+using mindspore::ExceptionType::NoExceptionType;
+using mindspore::MsLogLevel::ERROR;
+
+namespace mindspore {
+namespace mindrecord {
+std::pair<MSRStatus, CompressionType> ShardCompressor::GetCompressionType(const std::string &name) {
+  if (name == "none" || name.empty()) return {SUCCESS, kCompressionNone};
+  if (name == "lz4") return {SUCCESS, kCompressionLz4};
+  if (name == "zstd") return {SUCCESS, kCompressionZstd};
+  MS_LOG(ERROR) << "Unknown compression: " << name;
+  return {FAILED, kCompressionNone};
+}
+
+std::string ShardCompressor::GetCompressionName(CompressionType compression) {
+  switch (compression) {
+    case kCompressionLz4:
+      return "lz4";
+    case kCompressionZstd:
+      return "zstd";
+    default:
+      return "none";
+  }
+}
+
+MSRStatus ShardCompressor::Compress(CompressionType compression, const uint8_t *data, uint64_t size,
+                                    std::vector<uint8_t> *out) {
+  auto size_bytes = reinterpret_cast<const uint8_t *>(&size);
+  out->assign(size_bytes, size_bytes + kInt64Len);
+  if (compression == kCompressionLz4 && size <= LZ4_MAX_INPUT_SIZE) {
+    int bound = LZ4_compressBound(static_cast<int>(size));
+    out->resize(kInt64Len + bound);
+    int n_bytes = LZ4_compress_default(reinterpret_cast<const char *>(data),
+                                       reinterpret_cast<char *>(out->data() + kInt64Len), static_cast<int>(size),
+                                       bound);
+    if (n_bytes <= 0) {
+      MS_LOG(ERROR) << "Lz4 compress failed.";
+      return FAILED;
+    }
+    out->resize(kInt64Len + n_bytes);
+  } else if (compression == kCompressionZstd) {
+    out->resize(kInt64Len + ZSTD_compressBound(size));
+    size_t n_bytes = ZSTD_compress(out->data() + kInt64Len, out->size() - kInt64Len, data, size, kZstdLevel);
+    if (ZSTD_isError(n_bytes)) {
+      MS_LOG(ERROR) << "Zstd compress failed: " << ZSTD_getErrorName(n_bytes);
+      return FAILED;
+    }
+    out->resize(kInt64Len + n_bytes);
+  }
+
+  // Blob data which does not shrink is stored as is, so a blob never grows by more than its size
+  if (out->size() == kInt64Len || out->size() >= kInt64Len + size) {
+    out->resize(kInt64Len);
+    (void)out->insert(out->end(), data, data + size);
+  }
+  return SUCCESS;
+}
+
+MSRStatus ShardCompressor::Uncompress(CompressionType compression, const uint8_t *data, uint64_t size,
+                                      std::vector<uint8_t> *out) {
+  if (size < kInt64Len) {
+    MS_LOG(ERROR) << "Compressed blob is shorter than its header.";
+    return FAILED;
+  }
+  uint64_t raw_size = 0;
+  (void)std::copy(data, data + kInt64Len, reinterpret_cast<uint8_t *>(&raw_size));
+  data += kInt64Len;
+  size -= kInt64Len;
+  if (size == raw_size) {
+    out->assign(data, data + size);
+    return SUCCESS;
+  }
+  if (compression == kCompressionNone || size > raw_size ||
+      (compression == kCompressionLz4 && raw_size > LZ4_MAX_INPUT_SIZE)) {
+    MS_LOG(ERROR) << "Compressed blob is broken, size: " << size << ", uncompressed size: " << raw_size;
+    return FAILED;
+  }
+
+  out->resize(raw_size);
+  if (compression == kCompressionLz4) {
+    // The safe decoder checks every length and offset against the buffers, the blob data comes from a file
+    int n_bytes = LZ4_decompress_safe(reinterpret_cast<const char *>(data), reinterpret_cast<char *>(out->data()),
+                                      static_cast<int>(size), static_cast<int>(raw_size));
+    if (n_bytes < 0 || static_cast<uint64_t>(n_bytes) != raw_size) {
+      MS_LOG(ERROR) << "Lz4 uncompress failed, the compressed blob is broken.";
+      return FAILED;
+    }
+  } else if (compression == kCompressionZstd) {
+    size_t n_bytes = ZSTD_decompress(out->data(), raw_size, data, size);
+    if (ZSTD_isError(n_bytes) || n_bytes != raw_size) {
+      MS_LOG(ERROR) << "Zstd uncompress failed, the compressed blob is broken.";
+      return FAILED;
+    }
+  }
+  return SUCCESS;
+}
+}  // namespace mindrecord
+}  // namespace mindspore
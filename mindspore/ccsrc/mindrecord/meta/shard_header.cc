@@ -16,6 +16,7 @@
 
 #include "mindrecord/include/shard_header.h"
 
+#include <algorithm>
 #include <map>
 #include <memory>
 #include <string>
@@ -23,6 +24,7 @@
 #include <vector>
 
 #include "common/utils.h"
+#include "mindrecord/include/shard_compressor.h"
 #include "mindrecord/include/shard_error.h"
 #include "mindrecord/include/shard_page.h"
 
@@ -54,7 +56,9 @@ MSRStatus ShardHeader::InitializeHeader(const std::vector<json> &headers) {
       header_size_ = header["header_size"].get<uint64_t>();
       page_size_ = header["page_size"].get<uint64_t>();
     }
-    ParsePage(header["page"]);
+    if (ParsePage(header["page"]) != SUCCESS) {
+      return FAILED;
+    }
   }
   return SUCCESS;
 }
@@ -247,7 +251,7 @@ MSRStatus ShardHeader::ParseIndexFields(const json &index_fields) {
   return SUCCESS;
 }
 
-void ShardHeader::ParsePage(const json &pages) {
+MSRStatus ShardHeader::ParsePage(const json &pages) {
   if (pages_.empty() && shard_count_ <= kMaxShardCount) {
     pages_.resize(shard_count_);
   }
@@ -265,10 +269,22 @@ void ShardHeader::ParsePage(const json &pages) {
 
     auto page_size = page["page_size"].get<uint64_t>();
 
+    // Pages written without compression have no codec
+    CompressionType compression = kCompressionNone;
+    if (page.find("compression") != page.end()) {
+      auto ret = ShardCompressor::GetCompressionType(page["compression"].get<std::string>());
+      if (ret.first != SUCCESS) {
+        MS_LOG(ERROR) << "Deserialize page failed, page: " << page.dump();
+        return FAILED;
+      }
+      compression = ret.second;
+    }
+
     std::shared_ptr<Page> parsed_page = std::make_shared<Page>(page_id, shard_id, page_type, page_type_id, start_row_id,
-                                                               end_row_id, row_group_ids, page_size);
+                                                               end_row_id, row_group_ids, page_size, compression);
     pages_[shard_id].push_back(std::move(parsed_page));
   }
+  return SUCCESS;
 }
 
 MSRStatus ShardHeader::ParseStatistics(const json &statistics) {
@@ -459,6 +475,16 @@ const std::pair<MSRStatus, std::shared_ptr<Page>> ShardHeader::GetPageByGroupId(
   return {FAILED, nullptr};
 }
 
+bool ShardHeader::HasCompressedPage() const {
+  for (const auto &shard_pages : pages_) {
+    if (std::any_of(shard_pages.begin(), shard_pages.end(),
+                    [](const std::shared_ptr<Page> &page) { return page->get_compression() != kCompressionNone; })) {
+      return true;
+    }
+  }
+  return false;
+}
+
 int ShardHeader::AddSchema(std::shared_ptr<Schema> schema) {
   if (schema == nullptr) {
     MS_LOG(ERROR) << "Schema is illegal";
@@ -15,6 +15,7 @@
  */
 
 #include "mindrecord/include/shard_page.h"
+#include "mindrecord/include/shard_compressor.h"
 #include "pybind11/pybind11.h"
 
 namespace mindspore {
@@ -41,6 +42,9 @@ json Page::GetPage() const {
     }
   }
   str_page["page_size"] = page_size_;
+  if (compression_ != kCompressionNone) {
+    str_page["compression"] = ShardCompressor::GetCompressionName(compression_);
+  }
   return str_page;
 }
 
@@ -0,0 +1,56 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "pre_activate/cpu/ir_fusion/activation_fusion.h"
+#include <string>
+#include <unordered_set>
+#include "pre_activate/common/helper.h"
+#include "session/anf_runtime_algorithm.h"
+#include "operator/ops.h"
+#include "utils/utils.h"
+
+namespace mindspore {
+namespace opt {
+namespace {
+constexpr size_t kActivationInputNum = 2;
+constexpr size_t kProducerInputIndex = 1;
+const std::unordered_set<std::string> kFusableActivations = {"ReLU", "ReLU6", "Sigmoid", "Tanh"};
+}  // namespace
+
+const AnfNodePtr ActivationFusion::Process(const FuncGraphPtr &graph, const AnfNodePtr &node, const EquivPtr &) const {
+  MS_EXCEPTION_IF_NULL(graph);
+  if (node == nullptr || !AnfAlgo::IsRealCNodeKernel(node)) {
+    return nullptr;
+  }
+  auto cnode = node->cast<CNodePtr>();
+  MS_EXCEPTION_IF_NULL(cnode);
+  std::string activation = AnfAlgo::GetCNodeName(cnode);
+  if (kFusableActivations.find(activation) == kFusableActivations.end() || cnode->size() != kActivationInputNum) {
+    return nullptr;
+  }
+  AnfNodePtr producer = cnode->input(kProducerInputIndex);
+  MS_EXCEPTION_IF_NULL(producer);
+  if (!AnfAlgo::CheckPrimitiveType(producer, prim::kPrimConv2D) &&
+      !AnfAlgo::CheckPrimitiveType(producer, prim::kPrimMatMul)) {
+    return nullptr;
+  }
+  if (AnfAlgo::HasNodeAttr(kAttrFusedActivation, producer) || IsUsedByOthers(graph, producer)) {
+    return nullptr;
+  }
+  AnfAlgo::SetNodeAttr(kAttrFusedActivation, MakeValue(activation), producer);
+  return producer;
+}
+}  // namespace opt
+}  // namespace mindspore
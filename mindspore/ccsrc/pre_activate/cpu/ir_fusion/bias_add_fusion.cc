@@ -0,0 +1,61 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "pre_activate/cpu/ir_fusion/bias_add_fusion.h"
+#include <memory>
+#include "pre_activate/common/helper.h"
+#include "session/anf_runtime_algorithm.h"
+#include "operator/ops.h"
+#include "utils/utils.h"
+
+namespace mindspore {
+namespace opt {
+namespace {
+constexpr size_t kProducerInputIndex = 1;
+constexpr size_t kBiasInputIndex = 2;
+}  // namespace
+
+const BaseRef BiasAddFusion::DefinePattern() const {
+  VarPtr X0 = std::make_shared<Var>();
+  VarPtr X1 = std::make_shared<Var>();
+  const auto prim_bias_add = std::make_shared<Primitive>(kBiasAddOpName);
+  return VectorRef({prim_bias_add, X0, X1});
+}
+
+const AnfNodePtr BiasAddFusion::Process(const FuncGraphPtr &graph, const AnfNodePtr &node, const EquivPtr &) const {
+  MS_EXCEPTION_IF_NULL(graph);
+  MS_EXCEPTION_IF_NULL(node);
+  auto cnode = node->cast<CNodePtr>();
+  MS_EXCEPTION_IF_NULL(cnode);
+  CheckCNodeInputSize(cnode, kBiasAddInputNum);
+  AnfNodePtr producer = cnode->input(kProducerInputIndex);
+  MS_EXCEPTION_IF_NULL(producer);
+  if (!AnfAlgo::CheckPrimitiveType(producer, prim::kPrimConv2D) &&
+      !AnfAlgo::CheckPrimitiveType(producer, prim::kPrimMatMul)) {
+    return nullptr;
+  }
+  // The bias is added before any activation, and the producer output must not be seen without it
+  if (AnfAlgo::HasNodeAttr(kAttrHasBias, producer) || AnfAlgo::HasNodeAttr(kAttrFusedActivation, producer) ||
+      IsUsedByOthers(graph, producer)) {
+    return nullptr;
+  }
+  auto producer_cnode = producer->cast<CNodePtr>();
+  MS_EXCEPTION_IF_NULL(producer_cnode);
+  producer_cnode->add_input(cnode->input(kBiasInputIndex));
+  AnfAlgo::SetNodeAttr(kAttrHasBias, MakeValue(true), producer);
+  return producer;
+}
+}  // namespace opt
+}  // namespace mindspore
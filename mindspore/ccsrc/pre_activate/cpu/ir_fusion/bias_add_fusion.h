@@ -0,0 +1,34 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_PRE_ACTIVATE_CPU_IR_FUSION_BIAS_ADD_FUSION_H_
+#define MINDSPORE_CCSRC_PRE_ACTIVATE_CPU_IR_FUSION_BIAS_ADD_FUSION_H_
+
+#include "pre_activate/common/optimizer.h"
+
+namespace mindspore {
+namespace opt {
+// Folds a BiasAdd into the Conv2D or MatMul producing its input, the cpu kernels add the bias as they write the output
+class BiasAddFusion : public PatternProcessPass {
+ public:
+  explicit BiasAddFusion(bool multigraph = true) : PatternProcessPass("cpu_bias_add_fusion", multigraph) {}
+  ~BiasAddFusion() override = default;
+  const BaseRef DefinePattern() const override;
+  const AnfNodePtr Process(const FuncGraphPtr &, const AnfNodePtr &, const EquivPtr &) const override;
+};
+}  // namespace opt
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_PRE_ACTIVATE_CPU_IR_FUSION_BIAS_ADD_FUSION_H_
@@ -0,0 +1,150 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "pre_activate/cpu/ir_fusion/elementwise_chain_fusion.h"
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include "pre_activate/common/helper.h"
+#include "session/anf_runtime_algorithm.h"
+#include "utils/utils.h"
+
+namespace mindspore {
+namespace opt {
+namespace {
+constexpr int kPreviousStep = -1;
+constexpr size_t kMinChainLength = 2;
+const std::unordered_set<std::string> kFusableUnaryOps = {"Neg", "Abs", "Square",  "Sqrt", "Rsqrt", "Reciprocal",
+                                                          "Exp", "Log", "Sigmoid", "Tanh", "ReLU6", "ReLU"};
+const std::unordered_set<std::string> kFusableBinaryOps = {"TensorAdd", "Sub",     "Mul", "RealDiv", "Div",
+                                                           "Maximum",   "Minimum", "Pow", "Greater", "Less"};
+
+size_t ElementNum(const std::vector<size_t> &shape) {
+  return std::accumulate(shape.begin(), shape.end(), size_t(1), std::multiplies<size_t>());
+}
+
+// The cpu kernels keep int32 tensors as int32 values, the fused kernel only computes float values
+bool IsFloatStorage(TypeId type_id) { return type_id != kNumberTypeInt32 && type_id != kNumberTypeUInt32; }
+
+// Whether the node is an elementwise op of elem_num values whose inputs all have elem_num values or a single one
+bool IsFusableStep(const AnfNodePtr &node, size_t elem_num) {
+  if (node == nullptr || !AnfAlgo::IsRealCNodeKernel(node)) {
+    return false;
+  }
+  auto cnode = node->cast<CNodePtr>();
+  MS_EXCEPTION_IF_NULL(cnode);
+  std::string op_name = AnfAlgo::GetCNodeName(cnode);
+  size_t input_num;
+  if (kFusableUnaryOps.find(op_name) != kFusableUnaryOps.end()) {
+    input_num = 1;
+  } else if (kFusableBinaryOps.find(op_name) != kFusableBinaryOps.end()) {
+    input_num = 2;
+  } else {
+    return false;
+  }
+  if (AnfAlgo::GetInputTensorNum(cnode) != input_num || AnfAlgo::GetOutputTensorNum(cnode) != 1) {
+    return false;
+  }
+  if (ElementNum(AnfAlgo::GetOutputInferShape(cnode, 0)) != elem_num ||
+      !IsFloatStorage(AnfAlgo::GetOutputInferDataType(cnode, 0))) {
+    return false;
+  }
+  for (size_t i = 0; i < input_num; ++i) {
+    size_t input_elem_num = ElementNum(AnfAlgo::GetPrevNodeOutputInferShape(cnode, i));
+    if ((input_elem_num != elem_num && input_elem_num != 1) ||
+        !IsFloatStorage(AnfAlgo::GetPrevNodeOutputInferDataType(cnode, i))) {
+      return false;
+    }
+  }
+  // A unary op runs on a whole block, its input can not be a broadcast value
+  return input_num != 1 || ElementNum(AnfAlgo::GetPrevNodeOutputInferShape(cnode, 0)) == elem_num;
+}
+
+int GetInputIndex(const AnfNodePtr &input, std::vector<AnfNodePtr> *inputs) {
+  auto iter = std::find(inputs->begin(), inputs->end(), input);
+  if (iter != inputs->end()) {
+    return static_cast<int>(iter - inputs->begin());
+  }
+  inputs->push_back(input);
+  return static_cast<int>(inputs->size() - 1);
+}
+}  // namespace
+
+const AnfNodePtr ElementwiseChainFusion::Process(const FuncGraphPtr &graph, const AnfNodePtr &node,
+                                                 const EquivPtr &) const {
+  MS_EXCEPTION_IF_NULL(graph);
+  if (node == nullptr || !AnfAlgo::IsRealCNodeKernel(node) || AnfAlgo::GetOutputTensorNum(node) != 1) {
+    return nullptr;
+  }
+  size_t elem_num = ElementNum(AnfAlgo::GetOutputInferShape(node, 0));
+  if (!IsFusableStep(node, elem_num)) {
+    return nullptr;
+  }
+  // The nodes are visited from the graph output, so the chain is grown upwards from its last step
+  std::vector<CNodePtr> chain{node->cast<CNodePtr>()};
+  while (true) {
+    const auto &step = chain.back();
+    CNodePtr producer = nullptr;
+    for (size_t i = 1; i < step->size(); ++i) {
+      auto input = step->input(i);
+      if (IsFusableStep(input, elem_num) && !IsUsedByOthers(graph, input)) {
+        producer = input->cast<CNodePtr>();
+        break;
+      }
+    }
+    if (producer == nullptr) {
+      break;
+    }
+    chain.push_back(producer);
+  }
+  if (chain.size() < kMinChainLength) {
+    return nullptr;
+  }
+  std::reverse(chain.begin(), chain.end());
+
+  std::vector<AnfNodePtr> inputs;
+  std::vector<std::string> ops;
+  std::vector<int> lhs;
+  std::vector<int> rhs;
+  for (size_t i = 0; i < chain.size(); ++i) {
+    const auto &step = chain[i];
+    std::vector<int> step_inputs;
+    for (size_t j = 1; j < step->size(); ++j) {
+      auto input = step->input(j);
+      step_inputs.push_back(i > 0 && input == chain[i - 1] ? kPreviousStep : GetInputIndex(input, &inputs));
+    }
+    ops.push_back(AnfAlgo::GetCNodeName(step));
+    lhs.push_back(step_inputs[0]);
+    // Unary steps have no rhs, the entry only keeps the attrs the same length
+    rhs.push_back(step_inputs.size() > 1 ? step_inputs[1] : kPreviousStep);
+  }
+
+  std::vector<AnfNodePtr> fused_inputs = {NewValueNode(std::make_shared<Primitive>(kFusedElementwiseOpName))};
+  (void)fused_inputs.insert(fused_inputs.end(), inputs.begin(), inputs.end());
+  auto fused_node = graph->NewCNode(fused_inputs);
+  MS_EXCEPTION_IF_NULL(fused_node);
+  fused_node->set_abstract(node->abstract());
+  fused_node->set_scope(node->scope());
+  AnfAlgo::SetNodeAttr(kAttrFusedOps, MakeValue(ops), fused_node);
+  AnfAlgo::SetNodeAttr(kAttrFusedLhs, MakeValue(lhs), fused_node);
+  AnfAlgo::SetNodeAttr(kAttrFusedRhs, MakeValue(rhs), fused_node);
+  return fused_node;
+}
+}  // namespace opt
+}  // namespace mindspore
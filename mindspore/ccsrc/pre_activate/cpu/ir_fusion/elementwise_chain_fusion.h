@@ -0,0 +1,39 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_PRE_ACTIVATE_CPU_IR_FUSION_ELEMENTWISE_CHAIN_FUSION_H_
+#define MINDSPORE_CCSRC_PRE_ACTIVATE_CPU_IR_FUSION_ELEMENTWISE_CHAIN_FUSION_H_
+
+#include "pre_activate/common/optimizer.h"
+
+namespace mindspore {
+namespace opt {
+// Collapses a chain of elementwise ops, each the only user of the one before, into a FusedElementwise node. The
+// fused kernel runs the whole chain on a block of values before moving to the next block, the intermediate tensors
+// are never written to memory. Every input of the chain must have as many values as the output, or a single value.
+//
+// The chain is kept in three attrs, one entry per step in run order: fused_ops holds the op names, fused_lhs and
+// fused_rhs the inputs of the steps, an index into the node inputs or -1 for the value of the previous step.
+class ElementwiseChainFusion : public PatternProcessPass {
+ public:
+  explicit ElementwiseChainFusion(bool multigraph = true)
+      : PatternProcessPass("cpu_elementwise_chain_fusion", multigraph) {}
+  ~ElementwiseChainFusion() override = default;
+  const AnfNodePtr Process(const FuncGraphPtr &, const AnfNodePtr &, const EquivPtr &) const override;
+};
+}  // namespace opt
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_PRE_ACTIVATE_CPU_IR_FUSION_ELEMENTWISE_CHAIN_FUSION_H_
@@ -115,6 +115,7 @@ constexpr auto kBiasAddOpName = "BiasAdd";
 constexpr auto kConfusionMulGradOpName = "ConfusionMulGrad";
 constexpr auto kSendOpName = "Send";
 constexpr auto kRecvOpName = "Recv";
+constexpr auto kFusedElementwiseOpName = "FusedElementwise";
 
 // attr key name
 constexpr auto kAttrInputNames = "input_names";
@@ -146,6 +147,10 @@ constexpr auto kAttrDynInputSizes = "dyn_input_sizes";
 constexpr auto kAttrSrcFormat = "src_format";
 constexpr auto kAttrOutputUsedNum = "output_used_num";
 constexpr auto kAttrHasBias = "has_bias";
+constexpr auto kAttrFusedActivation = "fused_activation";
+constexpr auto kAttrFusedOps = "fused_ops";
+constexpr auto kAttrFusedLhs = "fused_lhs";
+constexpr auto kAttrFusedRhs = "fused_rhs";
 constexpr auto kAttrN = "N";
 
 // attr value
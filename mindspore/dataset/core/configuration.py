@@ -115,6 +115,213 @@ class ConfigurationManager:
         """
         return self.config.get_num_parallel_workers()
 
+    def set_lock_free_connector(self, lock_free):
+        """
+        Set whether the connectors between dataset operators use the lock free ring queue.
+
+        Args:
+            lock_free (bool): True to use the lock free ring queue, False to use the mutex based queue.
+
+        Raises:
+            TypeError: If lock_free is not a bool.
+
+        Examples:
+            >>> import mindspore.dataset as ds
+            >>> con = ds.engine.ConfigurationManager()
+            >>> # pipelines created from now on use lock free connectors.
+            >>> con.set_lock_free_connector(True)
+        """
+        if not isinstance(lock_free, bool):
+            raise TypeError("lock_free must be a bool")
+        self.config.set_lock_free_connector(lock_free)
+
+    def get_lock_free_connector(self):
+        """
+        Get whether the connectors use the lock free ring queue.
+
+        Returns:
+            Bool, True if the lock free ring queue is used.
+        """
+        return self.config.get_lock_free_connector()
+
+    def set_auto_tune(self, enable):
+        """
+        Set whether the pipeline tunes the number of active workers and the connector sizes while it runs.
+
+        Args:
+            enable (bool): True to turn on auto tuning.
+
+        Raises:
+            TypeError: If enable is not a bool.
+
+        Examples:
+            >>> import mindspore.dataset as ds
+            >>> con = ds.engine.ConfigurationManager()
+            >>> # pipelines launched from now on are tuned at runtime.
+            >>> con.set_auto_tune(True)
+        """
+        if not isinstance(enable, bool):
+            raise TypeError("enable must be a bool")
+        self.config.set_auto_tune(enable)
+
+    def get_auto_tune(self):
+        """
+        Get whether auto tuning is on.
+
+        Returns:
+            Bool, True if auto tuning is on.
+        """
+        return self.config.get_auto_tune()
+
+    def set_auto_tune_interval(self, interval):
+        """
+        Set the interval between two samples of the auto tuner.
+
+        Args:
+            interval (int): interval in milliseconds.
+
+        Raises:
+            ValueError: If interval is invalid (<= 0 or > MAX_INT_32).
+
+        Examples:
+            >>> import mindspore.dataset as ds
+            >>> con = ds.engine.ConfigurationManager()
+            >>> # sample the connectors every 50 milliseconds.
+            >>> con.set_auto_tune_interval(50)
+        """
+        if interval <= 0 or interval > INT32_MAX:
+            raise ValueError("Auto tune interval given is not within the required range")
+        self.config.set_auto_tune_interval(interval)
+
+    def get_auto_tune_interval(self):
+        """
+        Get the interval between two samples of the auto tuner.
+
+        Returns:
+            Int, interval in milliseconds.
+        """
+        return self.config.get_auto_tune_interval()
+
+    def set_auto_tune_cpu_budget(self, budget):
+        """
+        Set the maximum number of workers the auto tuner keeps active over the whole pipeline.
+
+        Args:
+            budget (int): number of workers, 0 to use the number of CPU cores.
+
+        Raises:
+            ValueError: If budget is invalid (< 0 or > MAX_INT_32).
+
+        Examples:
+            >>> import mindspore.dataset as ds
+            >>> con = ds.engine.ConfigurationManager()
+            >>> # keep at most 16 workers busy.
+            >>> con.set_auto_tune_cpu_budget(16)
+        """
+        if budget < 0 or budget > INT32_MAX:
+            raise ValueError("Auto tune cpu budget given is not within the required range")
+        self.config.set_auto_tune_cpu_budget(budget)
+
+    def get_auto_tune_cpu_budget(self):
+        """
+        Get the maximum number of workers the auto tuner keeps active.
+
+        Returns:
+            Int, number of workers.
+        """
+        return self.config.get_auto_tune_cpu_budget()
+
+    def set_profiling_dir(self, path):
+        """
+        Set the directory the pipeline profiler writes to. Pipelines launched afterwards record per operator
+        throughput, connector wait time, worker busy time and TensorOp compute time, and dump them there as a
+        Chrome trace and a JSON summary.
+
+        Args:
+            path (str): output directory, an empty string turns profiling off.
+
+        Raises:
+            TypeError: If path is not a str.
+
+        Examples:
+            >>> import mindspore.dataset as ds
+            >>> con = ds.engine.ConfigurationManager()
+            >>> # profile the pipelines launched from now on.
+            >>> con.set_profiling_dir("/tmp/dataset_profiling")
+        """
+        if not isinstance(path, str):
+            raise TypeError("path must be a str")
+        self.config.set_profiling_dir(path)
+
+    def get_profiling_dir(self):
+        """
+        Get the directory the pipeline profiler writes to.
+
+        Returns:
+            Str, output directory, empty if profiling is off.
+        """
+        return self.config.get_profiling_dir()
+
+    def set_profiling_interval(self, interval):
+        """
+        Set the interval between two samples of the pipeline profiler.
+
+        Args:
+            interval (int): interval in milliseconds.
+
+        Raises:
+            ValueError: If interval is invalid (<= 0 or > MAX_INT_32).
+
+        Examples:
+            >>> import mindspore.dataset as ds
+            >>> con = ds.engine.ConfigurationManager()
+            >>> # sample the pipeline every 20 milliseconds.
+            >>> con.set_profiling_interval(20)
+        """
+        if interval <= 0 or interval > INT32_MAX:
+            raise ValueError("Profiling interval given is not within the required range")
+        self.config.set_profiling_interval(interval)
+
+    def get_profiling_interval(self):
+        """
+        Get the interval between two samples of the pipeline profiler.
+
+        Returns:
+            Int, interval in milliseconds.
+        """
+        return self.config.get_profiling_interval()
+
+    def set_pinned_memory(self, pinned):
+        """
+        Set whether the data of tensors is kept in page aligned, pinned memory.
+
+        Pinned tensors are handed to the device queue by reference instead of being copied.
+
+        Args:
+            pinned (bool): True to allocate tensor data from the pinned memory pool.
+
+        Raises:
+            TypeError: If pinned is not a bool.
+
+        Examples:
+            >>> import mindspore.dataset as ds
+            >>> con = ds.engine.ConfigurationManager()
+            >>> # tensors created from now on are pinned.
+            >>> con.set_pinned_memory(True)
+        """
+        if not isinstance(pinned, bool):
+            raise TypeError("pinned must be a bool")
+        self.config.set_pinned_memory(pinned)
+
+    def get_pinned_memory(self):
+        """
+        Get whether the data of tensors is kept in pinned memory.
+
+        Returns:
+            Bool, True if tensor data is allocated from the pinned memory pool.
+        """
+        return self.config.get_pinned_memory()
+
     def __str__(self):
         """
         String representation of the configurations.
@@ -146,6 +353,13 @@ class ConfigurationManager:
             >>> #     "numParallelWorkers": 4,
             >>> #     "workerConnectorSize": 16,
             >>> #     "opConnectorSize": 16,
+            >>> #     "lockFreeConnector": false,
+            >>> #     "autoTune": false,
+            >>> #     "autoTuneInterval": 100,
+            >>> #     "autoTuneCpuBudget": 0,
+            >>> #     "profilingDir": "",
+            >>> #     "profilingInterval": 100,
+            >>> #     "pinnedMemory": false,
             >>> #     "seed": 5489
             >>> # }
         """
@@ -29,16 +29,18 @@ from importlib import import_module
 
 import numpy as np
 from mindspore._c_dataengine import DataType, TFReaderOp, ImageFolderOp, CifarOp, MnistOp, ManifestOp, \
-    MindRecordOp, CBatchInfo
+    MindRecordOp, CBatchInfo, TensorOp
 from mindspore._c_expression import typing
 
 from mindspore import log as logger
 from . import samplers
 from .iterators import DictIterator, TupleIterator
-from .validators import check, check_batch, check_shuffle, check_map, check_repeat, check_zip, check_rename, \
+from .py_process_pool import PyFuncPool, GeneratorPool
+from .validators import check, check_batch, check_shuffle, check_cache, check_map, check_repeat, check_zip, check_rename, \
     check_project, check_imagefolderdatasetv2, check_mnist_cifar_dataset, check_manifestdataset, \
     check_tfrecorddataset, check_vocdataset, check_celebadataset, check_minddataset, check_generatordataset, \
-    check_zip_dataset, check_add_column
+    check_zip_dataset, check_add_column, check_bucket_batch_by_length
+from ..core.configuration import config
 from ..core.datatypes import mstype_to_detype, mstypelist_to_detypelist
 
 try:
@@ -157,12 +159,13 @@ class Dataset:
 
     @check_batch
     def batch(self, batch_size, drop_remainder=False, num_parallel_workers=None, per_batch_map=None,
-              input_columns=None):
+              input_columns=None, pad_info=None):
         """
         Combines batch_size number of consecutive rows into batches.
 
         For any child node, a batch is treated as a single row.
-        For any column, all the elements within that column must have the same shape.
+        For any column, all the elements within that column must have the same shape, unless the
+        column is padded with pad_info.
         If a per_batch_map callable is provided, it will be applied to the batches of tensors.
 
         Note:
@@ -183,6 +186,9 @@ class Dataset:
                 last parameter of the callable should always be a BatchInfo object.
             input_columns (list of string, optional): List of names of the input columns. The size of the list should
                 match with signature of per_batch_map callable.
+            pad_info (dict, optional): Columns to pad while batching (default=None). pad_info={"col1": ([224, 224], 0)}
+                pads each row of "col1" to the shape [224, 224] with 0. A dim of None pads to the largest dim of the
+                batch, and a shape of None pads every dim to the largest of the batch.
 
         Returns:
             BatchDataset, dataset batched.
@@ -193,11 +199,50 @@ class Dataset:
             >>> # creates a dataset where every 100 rows is combined into a batch
             >>> # and drops the last incomplete batch if there is one.
             >>> data = data.batch(100, True)
+            >>> # pads the sentences of each batch to the longest one with 0
+            >>> data = data.batch(32, pad_info={"sentence": ([None], 0)})
         """
-        return BatchDataset(self, batch_size, drop_remainder, num_parallel_workers, per_batch_map, input_columns)
+        return BatchDataset(self, batch_size, drop_remainder, num_parallel_workers, per_batch_map, input_columns,
+                            pad_info)
+
+    @check_bucket_batch_by_length
+    def bucket_batch_by_length(self, column_name, bucket_boundaries, bucket_batch_sizes, drop_remainder=False,
+                               num_parallel_workers=None, pad_info=None):
+        """
+        Routes the rows into buckets by their length, and combines the rows of each bucket into batches.
+
+        The length of a row is the first dim of column_name. Bucket i takes the rows with a length in
+        [bucket_boundaries[i-1], bucket_boundaries[i]), the first bucket starts at 0 and the last one has no upper
+        bound. A bucket sends a batch as soon as it has bucket_batch_sizes[i] rows, and the rows left in the buckets
+        are sent as smaller batches at the end of each epoch.
+        Giving the buckets of short rows larger batch sizes keeps the number of tokens per batch about the same.
+
+        Args:
+            column_name (str): The name of the column whose first dim is the length of a row.
+            bucket_boundaries (list of int): The increasing upper bounds of the lengths of the buckets.
+            bucket_batch_sizes (list of int): The batch size of each bucket, one more than bucket_boundaries.
+            drop_remainder (bool, optional): Determines whether or not to drop the rows left in the buckets at the
+                end of an epoch (default=False).
+            num_parallel_workers (int, optional): Number of workers to process the Dataset in parallel (default=None).
+            pad_info (dict, optional): Columns to pad while batching, see batch (default=None).
+
+        Returns:
+            BatchDataset, dataset batched by buckets.
+
+        Examples:
+            >>> import mindspore.dataset as ds
+            >>> # data is an instance of Dataset object.
+            >>> # sentences shorter than 16 go in batches of 64, up to 32 in batches of 32 and longer ones
+            >>> # in batches of 16, each batch is padded to its longest sentence
+            >>> data = data.bucket_batch_by_length("sentence", [16, 32], [64, 32, 16],
+            >>>                                    pad_info={"sentence": ([None], 0)})
+        """
+        return BatchDataset(self, max(bucket_batch_sizes), drop_remainder, num_parallel_workers, pad_info=pad_info,
+                            length_column=column_name, bucket_boundaries=bucket_boundaries,
+                            bucket_batch_sizes=bucket_batch_sizes)
 
     @check_shuffle
-    def shuffle(self, buffer_size):
+    def shuffle(self, buffer_size, mem_size=None, block_size=None, spill_dir=None):
         """
         Randomly shuffles the rows of this dataset using the following algorithm:
 
@@ -210,10 +255,24 @@ class Dataset:
         A seed can be provided to be used on the first epoch. In every subsequent
         epoch, the seed is changed to a new one, randomly generated value.
 
+        With mem_size the rows of the shuffle buffer are copied into a memory pool of that size,
+        and the shuffle buffer holds fewer than buffer_size rows when the pool is full.
+
+        With block_size the shuffle has two levels. The rows of each epoch are first written
+        to a spill file on local disk in blocks of block_size rows, and the blocks are read
+        back in a random order through the shuffle buffer. This gives near global randomness
+        with a shuffle buffer much smaller than the dataset.
+
         Args:
             buffer_size (int): The size of the buffer (must be larger than 1) for
                 shuffling. Setting buffer_size equal to the number of rows in the entire
                 dataset will result in a global shuffle.
+            mem_size (int, optional): Size of the memory budget of the shuffle buffer in MB
+                (default=None, no budget).
+            block_size (int, optional): Number of rows per block of the two level shuffle
+                (default=None, single level).
+            spill_dir (str, optional): Directory of the spill file of the two level shuffle
+                (default=None, $TMPDIR or /tmp).
 
         Returns:
             ShuffleDataset, dataset shuffled.
@@ -226,12 +285,44 @@ class Dataset:
             >>>
             >>> # creates a shuffled dataset using a shuffle buffer of size 4
             >>> data = data.shuffle(4)
+            >>>
+            >>> # shuffles blocks of 64 rows, mixed by a shuffle buffer of at most 512 MB
+            >>> data = data.shuffle(10000, mem_size=512, block_size=64)
         """
-        return ShuffleDataset(self, buffer_size)
+        return ShuffleDataset(self, buffer_size, mem_size, block_size, spill_dir)
+
+    @check_cache
+    def cache(self, mem_size=None, spill_dir=None, sampler=None):
+        """
+        Caches the rows of this dataset.
+
+        The rows are kept during the first epoch, and the following epochs of a repeat are served
+        from the cache instead of running the operators before the cache again. Rows that do not
+        fit in the memory budget are written to a spill file on local disk.
+
+        Args:
+            mem_size (int, optional): Size of the memory budget in MB, 0 to keep every row on
+                disk (default=None, 1024 MB).
+            spill_dir (str, optional): Directory of the spill file (default=None, $TMPDIR or /tmp).
+            sampler (Sampler, optional): Object used to choose the order in which the cached rows
+                are read in the following epochs (default=None, in the order they were cached).
+
+        Returns:
+            CacheDataset, dataset cached.
+
+        Examples:
+            >>> import mindspore.dataset as ds
+            >>> # data is an instance of Dataset object
+            >>> # decode the images only once, and read the cached rows in a random order afterwards
+            >>> data = data.map(input_columns="image", operations=decode_op)
+            >>> data = data.cache(mem_size=4096, sampler=ds.RandomSampler())
+            >>> data = data.repeat(10)
+        """
+        return CacheDataset(self, mem_size, spill_dir, sampler)
 
     @check_map
     def map(self, input_columns=None, operations=None, output_columns=None, columns_order=None,
-            num_parallel_workers=None):
+            num_parallel_workers=None, python_multiprocessing=False):
         """
         Applies each operation in operations to this dataset.
 
@@ -270,6 +361,9 @@ class Dataset:
                 same).
             num_parallel_workers (int, optional): Number of threads used to process the dataset in
                 parallel (default=None, the value from the config will be used).
+            python_multiprocessing (bool, optional): Run the python functions of operations in
+                num_parallel_workers processes instead of the threads of the map, which take the python GIL
+                in turn (default=False). The rows go to the processes through shared memory.
 
         Returns:
             MapDataset, dataset after mapping operation.
@@ -383,7 +477,8 @@ class Dataset:
             >>> columns_order = ["mod7", "mod3", "col1"]
             >>> ds_mapped = ds_pyfunc.map(input_columns, operations, output_columns, columns_order)
         """
-        return MapDataset(self, input_columns, operations, output_columns, columns_order, num_parallel_workers)
+        return MapDataset(self, input_columns, operations, output_columns, columns_order, num_parallel_workers,
+                          python_multiprocessing)
 
     @check_repeat
     def repeat(self, count=None):
@@ -557,7 +652,7 @@ class Dataset:
             if isinstance(output_dataset, (Cifar10Dataset, Cifar100Dataset, ImageFolderDatasetV2,
                                            ManifestDataset, MnistDataset, VOCDataset, CelebADataset)):
                 sampler = output_dataset.sampler
-                if isinstance(sampler, samplers.DistributedSampler):
+                if isinstance(sampler, (samplers.DistributedSampler, samplers.ElasticDistributedSampler)):
                     dev_id = sampler.shard_id
                 return "", dev_id
             if isinstance(output_dataset, TFRecordDataset):
@@ -584,7 +679,7 @@ class Dataset:
 
         return TransferDataset(self, queue_name, device_id, device_type, num_batch)
 
-    def create_tuple_iterator(self, columns=None):
+    def create_tuple_iterator(self, columns=None, state=None):
         """
         Create an Iterator over the dataset. The data retrieved will be a list of ndarray of data.
 
@@ -594,6 +689,8 @@ class Dataset:
         Args:
             columns (list[str], optional): List of columns to be used to specify the order of columns
                 (defaults=None, means all columns).
+            state (str, optional): State saved by the save_state of an iterator over the same pipeline, to resume
+                from (default=None, start from the beginning).
 
         Returns:
             Iterator, list of ndarray.
@@ -608,15 +705,19 @@ class Dataset:
             >>>     # convert the returned tuple to a list and print
             >>>     print(list(item))
         """
-        return TupleIterator(self, columns)
+        return TupleIterator(self, columns, state)
 
-    def create_dict_iterator(self):
+    def create_dict_iterator(self, state=None):
         """
         Create an Iterator over the dataset.
 
         The data retrieved will be a dictionary. The order
         of the columns in the dictionary may not be the same as the original order.
 
+        Args:
+            state (str, optional): State saved by the save_state of an iterator over the same pipeline, to resume
+                from (default=None, start from the beginning).
+
         Returns:
             Iterator, dictionary of column_name-ndarray pair.
 
@@ -631,7 +732,7 @@ class Dataset:
             >>>     print(item["column1"])
 
         """
-        return DictIterator(self)
+        return DictIterator(self, state)
 
     def __iter__(self):
         """Create an Iterator over the dataset."""
@@ -813,10 +914,16 @@ class BatchDataset(DatasetOp):
         batch_size (int): The size of the batch.
         drop_remainder (bool, optional): Whether drop the remainder batch of data (drop_remainder=False).
             If True, the last incomplete batch will be dropped.
+        pad_info (dict, optional): Columns to pad while batching, see Dataset.batch (default=None).
+        length_column (str, optional): The column to bucket the rows by, see Dataset.bucket_batch_by_length
+            (default=None, no bucketing).
+        bucket_boundaries (list of int, optional): The upper bounds of the lengths of the buckets (default=None).
+        bucket_batch_sizes (list of int, optional): The batch size of each bucket (default=None).
     """
 
     def __init__(self, input_dataset, batch_size, drop_remainder=False, num_parallel_workers=None,
-                 per_batch_map=None, input_columns=None):
+                 per_batch_map=None, input_columns=None, pad_info=None, length_column=None, bucket_boundaries=None,
+                 bucket_batch_sizes=None):
         super().__init__(num_parallel_workers)
 
         if BatchDataset._is_ancestor_of_repeat(input_dataset):
@@ -826,6 +933,10 @@ class BatchDataset(DatasetOp):
         self.drop_remainder = drop_remainder
         self.per_batch_map = per_batch_map
         self.input_columns = input_columns
+        self.pad_info = pad_info
+        self.length_column = length_column
+        self.bucket_boundaries = bucket_boundaries
+        self.bucket_batch_sizes = bucket_batch_sizes
         self.input.append(input_dataset)
         input_dataset.output.append(self)
         self._input_indexs = input_dataset.input_indexs
@@ -836,6 +947,12 @@ class BatchDataset(DatasetOp):
         args["drop_remainder"] = self.drop_remainder
         args["per_batch_map"] = self.per_batch_map
         args["input_columns"] = self.input_columns
+        if self.pad_info is not None:
+            args["pad_info"] = {col: tuple(shape_and_value) for col, shape_and_value in self.pad_info.items()}
+        if self.length_column is not None:
+            args["length_column"] = self.length_column
+            args["bucket_boundaries"] = self.bucket_boundaries
+            args["bucket_batch_sizes"] = self.bucket_batch_sizes
         return args
 
     def get_dataset_size(self):
@@ -845,6 +962,9 @@ class BatchDataset(DatasetOp):
         Return:
             Number, number of batches.
         """
+        if self.length_column is not None:
+            # The number of batches depends on the lengths of the rows
+            return None
         child_size = self.input[0].get_dataset_size()
         if child_size is not None:
             if self.drop_remainder:
@@ -910,11 +1030,17 @@ class ShuffleDataset(DatasetOp):
     Args:
         input_dataset (Dataset): Input Dataset to be shuffled.
         buffer_size (int): The size of the buffer.
+        mem_size (int, optional): Size of the memory budget of the buffer in MB.
+        block_size (int, optional): Number of rows per block of the two level shuffle.
+        spill_dir (str, optional): Directory of the spill file of the two level shuffle.
     """
 
-    def __init__(self, input_dataset, buffer_size):
+    def __init__(self, input_dataset, buffer_size, mem_size=None, block_size=None, spill_dir=None):
         super().__init__()
         self.buffer_size = buffer_size
+        self.mem_size = mem_size
+        self.block_size = block_size
+        self.spill_dir = spill_dir
         self.input.append(input_dataset)
         input_dataset.output.append(self)
         self._input_indexs = input_dataset.input_indexs
@@ -922,8 +1048,50 @@ class ShuffleDataset(DatasetOp):
     def get_args(self):
         args = super().get_args()
         args["buffer_size"] = self.buffer_size
+        args["mem_size"] = self.mem_size
+        args["block_size"] = self.block_size
+        args["spill_dir"] = self.spill_dir
+        return args
+
+
+class CacheDataset(DatasetOp):
+    """
+    The result of applying Cache operator to the input Dataset.
+
+    Args:
+        input_dataset (Dataset): Input Dataset to be cached.
+        mem_size (int, optional): Size of the memory budget in MB.
+        spill_dir (str, optional): Directory of the spill file.
+        sampler (Sampler, optional): Object used to choose the order of the cached rows.
+    """
+
+    def __init__(self, input_dataset, mem_size=None, spill_dir=None, sampler=None):
+        super().__init__()
+        self.mem_size = mem_size
+        self.spill_dir = spill_dir
+        self.sampler = sampler
+        self.input.append(input_dataset)
+        input_dataset.output.append(self)
+        self._input_indexs = input_dataset.input_indexs
+
+    def get_args(self):
+        args = super().get_args()
+        args["mem_size"] = self.mem_size
+        args["spill_dir"] = self.spill_dir
+        args["sampler"] = self.sampler
         return args
 
+    def get_dataset_size(self):
+        """
+        Get the number of batches in an epoch.
+
+        Return:
+            Number, number of batches.
+        """
+        if self.sampler is None:
+            return self.input[0].get_dataset_size()
+        return None
+
 
 class MapDataset(DatasetOp):
     """
@@ -944,13 +1112,15 @@ class MapDataset(DatasetOp):
             The argument is mandatory if len(input_columns) != len(output_columns).
         num_parallel_workers (int, optional): Number of workers to process the Dataset
             in parallel (default=None).
+        python_multiprocessing (bool, optional): Run the python functions of operations in worker processes
+            (default=False).
 
         Raises:
             ValueError: If len(input_columns) != len(output_columns) and columns_order is not specified.
     """
 
     def __init__(self, input_dataset, input_columns=None, operations=None, output_columns=None, columns_order=None,
-                 num_parallel_workers=None):
+                 num_parallel_workers=None, python_multiprocessing=False):
         super().__init__(num_parallel_workers)
         self.input.append(input_dataset)
         if input_columns is not None and not isinstance(input_columns, list):
@@ -971,6 +1141,8 @@ class MapDataset(DatasetOp):
 
         input_dataset.output.append(self)
         self._input_indexs = input_dataset.input_indexs
+        self.python_multiprocessing = python_multiprocessing
+        self._pooled_ops = None
 
     def get_args(self):
         args = super().get_args()
@@ -979,6 +1151,33 @@ class MapDataset(DatasetOp):
         args["output_columns"] = self.output_columns
         return args
 
+    def process_pool_args(self, args):
+        """
+        Returns the arguments of the pipeline node with each chain of consecutive python functions of the operations
+        replaced with a PyFuncPool.
+
+        The iterator calls it when it builds the pipeline, the pools are forked the first time, before the threads of
+        the pipeline start.
+        """
+        if self._pooled_ops is None:
+            num_workers = self.num_parallel_workers or config.get_num_parallel_workers()
+            self._pooled_ops = []
+            funcs = []
+            for op in (self.operations or []) + [None]:
+                if op is not None and callable(op) and not isinstance(op, TensorOp):
+                    funcs.append(op)
+                    continue
+                if funcs:
+                    self._pooled_ops.append(PyFuncPool(funcs, num_workers))
+                    funcs = []
+                if op is not None:
+                    self._pooled_ops.append(op)
+        for op in self._pooled_ops:
+            if isinstance(op, PyFuncPool):
+                op.start()
+        args["operations"] = self._pooled_ops
+        return args
+
     def get_dataset_size(self):
         """
         Get the number of batches in an epoch.
@@ -1171,10 +1370,10 @@ class TransferDataset(DatasetOp):
         args["num_batch"] = self.__num_batch
         return args
 
-    def create_dict_iterator(self):
+    def create_dict_iterator(self, state=None):
         raise RuntimeError("TransferDataset is not iterable")
 
-    def create_tuple_iterator(self, columns=None):
+    def create_tuple_iterator(self, columns=None, state=None):
         raise RuntimeError("TransferDataset is not iterable")
 
     def __iter__(self):
@@ -1625,6 +1824,10 @@ class MindDataset(SourceDataset):
         sampler (Sampler, optional): Object used to choose samples from the
             dataset (default=None, sampler is exclusive
             with shuffle and block_reader). Support list: SubsetRandomSampler.
+        use_mmap (bool, optional): Whether to map the shard files into memory instead of reading
+            them through file streams, which saves copying the samples (default=False).
+        io_depth (int, optional): Number of page reads kept in flight by an asynchronous reader
+            in block reader mode (default=None, blocking reads).
 
     Raises:
         ValueError: If num_shards is specified but shard_id is None.
@@ -1635,7 +1838,7 @@ class MindDataset(SourceDataset):
     @check_minddataset
     def __init__(self, dataset_file, columns_list=None, num_parallel_workers=None,
                  shuffle=None, num_shards=None, shard_id=None,
-                 block_reader=False, sampler=None):
+                 block_reader=False, sampler=None, use_mmap=False, io_depth=None):
         super().__init__(num_parallel_workers)
         self.dataset_file = dataset_file
         self.columns_list = columns_list
@@ -1673,6 +1876,8 @@ class MindDataset(SourceDataset):
         self.num_shards = num_shards
         self.shard_id = shard_id
         self.block_reader = block_reader
+        self.use_mmap = use_mmap
+        self.io_depth = io_depth
 
     def get_args(self):
         args = super().get_args()
@@ -1681,6 +1886,8 @@ class MindDataset(SourceDataset):
         args["global_shuffle"] = self.global_shuffle
         args["partitions"] = self.partitions
         args["block_reader"] = self.block_reader
+        args["use_mmap"] = self.use_mmap
+        args["io_depth"] = self.io_depth
         args["num_shards"] = self.num_shards
         args["shard_id"] = self.shard_id
         args["sampler"] = self.sampler
@@ -1729,6 +1936,12 @@ class GeneratorDataset(SourceDataset):
             If provided, sanity check will be performed on generator output.
         prefetch_size (int, optional): Prefetch number of records ahead of the user's request (default=None).
         sampler (Sampler, optional): Object used to choose samples from the dataset (default=None).
+        num_parallel_workers (int, optional): Number of worker processes reading the rows when
+            python_multiprocessing is set (default=None, number set in the config).
+        python_multiprocessing (bool, optional): Read the rows in worker processes instead of the pipeline
+            thread, which holds the python GIL while it reads (default=False). The source must support
+            random access, the rows of the sampler, or of range(len(source)) without sampler, are read ahead by
+            the processes and come back through shared memory.
 
     Examples:
         >>> import mindspore.dataset as ds
@@ -1747,9 +1960,17 @@ class GeneratorDataset(SourceDataset):
     """
 
     @check_generatordataset
-    def __init__(self, generator_function, column_names, column_types=None, prefetch_size=None, sampler=None):
+    def __init__(self, generator_function, column_names, column_types=None, prefetch_size=None, sampler=None,
+                 num_parallel_workers=None, python_multiprocessing=False):
         super().__init__(1)
-        if sampler is not None:
+        self.python_multiprocessing = python_multiprocessing
+        self._generator_pool = None
+        if python_multiprocessing:
+            indices = sampler if sampler is not None else range(len(generator_function))
+            self._generator_pool = GeneratorPool(generator_function,
+                                                 num_parallel_workers or config.get_num_parallel_workers())
+            self.generator_function = (lambda: self._generator_pool.generate(indices))
+        elif sampler is not None:
             self.generator_function = (lambda: sampler_fn(sampler, generator_function))
         else:
             try:
@@ -1772,6 +1993,16 @@ class GeneratorDataset(SourceDataset):
         self.prefetch_size = prefetch_size
         self.sampler = sampler
 
+    def process_pool_args(self, args):
+        """
+        Returns the arguments of the pipeline node, after the worker processes reading the rows are started.
+
+        The iterator calls it when it builds the pipeline, the processes are forked the first time, before the
+        threads of the pipeline start.
+        """
+        self._generator_pool.start()
+        return args
+
     def get_args(self):
         args = super().get_args()
         args["generator_function"] = self.generator_function
@@ -14,6 +14,7 @@
 # ==============================================================================
 """Built-in iterators.
 """
+import json
 from abc import abstractmethod
 
 from mindspore._c_dataengine import DEPipeline
@@ -70,9 +71,10 @@ class Iterator:
 
     Attributes:
         dataset: Dataset to be iterated over
+        state (str, optional): State saved by save_state to resume from (default=None, start from the beginning).
     """
 
-    def __init__(self, dataset):
+    def __init__(self, dataset, state=None):
         ITERATORS_LIST.append(self)
         self.dataset = alter_tree(dataset)
         if not self.__is_tree():
@@ -84,6 +86,10 @@ class Iterator:
 
         root = self.__convert_node_postorder(self.dataset)
         self.depipeline.AssignRootNode(root)
+        self._rows_before = 0
+        if state is not None:
+            self._rows_before = json.loads(state)["num_rows"]
+            self.depipeline.SetRestoreState(state)
         self.depipeline.LaunchTreeExec()
         self._index = 0
 
@@ -111,6 +117,8 @@ class Iterator:
         op_type = None
         if isinstance(dataset, de.ShuffleDataset):
             op_type = OpName.SHUFFLE
+        elif isinstance(dataset, de.CacheDataset):
+            op_type = OpName.CACHE
         elif isinstance(dataset, de.MindDataset):
             op_type = OpName.MINDRECORD
         elif isinstance(dataset, de.BatchDataset):
@@ -155,7 +163,10 @@ class Iterator:
     # Convert python node into C node and add to C layer execution tree in postorder traversal.
     def __convert_node_postorder(self, node):
         op_type = self.__get_dataset_type(node)
-        c_node = self.depipeline.AddNodeToTree(op_type, node.get_args())
+        args = node.get_args()
+        if getattr(node, "python_multiprocessing", False):
+            args = node.process_pool_args(args)
+        c_node = self.depipeline.AddNodeToTree(op_type, args)
 
         for py_child in node.input:
             c_child = self.__convert_node_postorder(py_child)
@@ -205,6 +216,24 @@ class Iterator:
         self._index += 1
         return data
 
+    def save_state(self, num_rows=None):
+        """
+        Save the state of the pipeline, to resume it later from the row following num_rows.
+
+        The rows before it are skipped when resuming, most of them without being loaded. The pipeline must be built
+        the same way, the samplers without a seed are only replayed exactly if the seed of the config is set.
+
+        Args:
+            num_rows (int, optional): Number of rows consumed from the start of the pipeline (default=None, the rows
+                returned by this iterator, and the ones skipped if it was resumed from a state).
+
+        Returns:
+            str, the state of the pipeline, to pass to the iterator to resume from.
+        """
+        if num_rows is None:
+            num_rows = self._rows_before + self._index
+        return self.depipeline.SaveState(num_rows)
+
     def get_output_shapes(self):
         return [t for t in self.depipeline.GetOutputShapes()]
 
@@ -248,12 +277,12 @@ class TupleIterator(Iterator):
     The derived class of Iterator with list type.
     """
 
-    def __init__(self, dataset, columns=None):
+    def __init__(self, dataset, columns=None, state=None):
         if columns is not None:
             if not isinstance(columns, list):
                 columns = [columns]
             dataset = dataset.project(columns)
-        super().__init__(dataset)
+        super().__init__(dataset, state)
 
     def __iter__(self):
         return self
@@ -0,0 +1,340 @@
+# Copyright 2019 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ==============================================================================
+"""
+Process pools running the python functions of a pipeline out of the interpreter of the pipeline.
+
+PyFuncOp and GeneratorOp hold the GIL while they call python, so the python transforms of a map and the rows of a
+GeneratorDataset are computed one at a time whatever the number of workers. The pools below fork worker processes
+which each run the python code with their own interpreter. The rows go to the workers and back through rings of
+shared memory slots: the arrays are copied into a slot and read back as views of it, only their dtype and shape are
+pickled. Arrays larger than a slot are pickled as a fallback.
+
+The workers are forked, the functions don't need to be picklable. The pools are started when the pipeline is
+built, before its threads run.
+"""
+
+import ctypes
+import multiprocessing
+import queue
+import threading
+import traceback
+
+import numpy as np
+
+from mindspore import log as logger
+
+# Size of a shared memory slot, the arrays of a row are stored in one slot
+SLOT_SIZE = 16 << 20
+# Number of slots of a ring, the number of rows a worker may compute ahead
+RING_SIZE = 4
+# Seconds between two checks that the worker is alive while waiting for its result
+_POLL_INTERVAL = 1.0
+_ALIGNMENT = 64
+
+
+class _SharedRing:
+    """
+    Ring of shared memory slots carrying rows of numpy arrays from one process to another.
+
+    A single producer writes the slots in order, the consumer gives each slot back with release() once it does not
+    use the views of the row anymore.
+    """
+
+    def __init__(self, ctx, num_slots, slot_size):
+        self._num_slots = num_slots
+        self._slot_size = slot_size
+        self._buffer = np.frombuffer(ctx.RawArray(ctypes.c_uint8, num_slots * slot_size), dtype=np.uint8)
+        self._free_slots = ctx.Semaphore(num_slots)
+        self._messages = ctx.Queue()
+        self._next_slot = 0
+
+    def put(self, row, is_tuple=True, timeout=None):
+        """
+        Copy the arrays of the row into the next slot, blocking until the consumer frees it.
+
+        Raises:
+            queue.Full: if no slot was freed within timeout seconds.
+        """
+        if not self._free_slots.acquire(timeout=timeout):
+            raise queue.Full
+        slot = self._next_slot
+        self._next_slot = (self._next_slot + 1) % self._num_slots
+        pos = slot * self._slot_size
+        end = pos + self._slot_size
+        layout = []
+        for array in row:
+            array = np.asarray(array, order="C")
+            if array.dtype.hasobject or pos + array.nbytes > end:
+                # pickled with the message
+                layout.append(array)
+                continue
+            self._buffer[pos:pos + array.nbytes] = array.reshape(-1).view(np.uint8)
+            layout.append((array.dtype.str, array.shape, pos))
+            pos += -(-array.nbytes // _ALIGNMENT) * _ALIGNMENT
+        self._messages.put((slot, layout, is_tuple))
+
+    def put_error(self, message):
+        """Send an error instead of a row, it does not take a slot."""
+        self._messages.put((None, message, False))
+
+    def get(self, timeout=None):
+        """
+        Returns the next row as views of its slot.
+
+        Returns:
+            tuple, slot to release, list of arrays or error message if slot is None, whether the row was a tuple.
+
+        Raises:
+            queue.Empty: if no row came within timeout seconds.
+        """
+        slot, layout, is_tuple = self._messages.get(timeout=timeout)
+        if slot is None:
+            return slot, layout, is_tuple
+        row = []
+        for item in layout:
+            if isinstance(item, np.ndarray):
+                row.append(item)
+                continue
+            dtype, shape, pos = item
+            dtype = np.dtype(dtype)
+            count = int(np.prod(shape, dtype=np.int64))
+            row.append(self._buffer[pos:pos + count * dtype.itemsize].view(dtype).reshape(shape))
+        return slot, row, is_tuple
+
+    def release(self, slot):
+        if slot is not None:
+            self._free_slots.release()
+
+
+def _as_row(result):
+    """Returns the arrays returned by a python function and whether they came as a tuple."""
+    if isinstance(result, tuple):
+        return [np.asarray(x) for x in result], True
+    return [np.asarray(result)], False
+
+
+def _worker_loop(func, in_ring, out_ring):
+    """Main loop of a worker process: compute func on each row of in_ring and send the result to out_ring."""
+    while True:
+        slot, row, _ = in_ring.get()
+        if slot is None:
+            # stop request
+            return
+        try:
+            result, is_tuple = _as_row(func(*row))
+            out_ring.put(result, is_tuple)
+        except Exception:  # pylint: disable=broad-except
+            out_ring.put_error(traceback.format_exc())
+        in_ring.release(slot)
+
+
+class _Worker:
+    """A worker process and the rings to and from it."""
+
+    def __init__(self, ctx, func, slot_size, ring_size):
+        self.in_ring = _SharedRing(ctx, ring_size, slot_size)
+        self.out_ring = _SharedRing(ctx, ring_size, slot_size)
+        self.process = ctx.Process(target=_worker_loop, args=(func, self.in_ring, self.out_ring), daemon=True)
+        self.process.start()
+
+    def put(self, row):
+        """Send a row to the worker, raises if the worker died."""
+        while True:
+            try:
+                return self.in_ring.put(row, timeout=_POLL_INTERVAL)
+            except queue.Full:
+                self._check_alive()
+
+    def get(self):
+        """Wait for the next result, raises if the worker died."""
+        while True:
+            try:
+                return self.out_ring.get(timeout=_POLL_INTERVAL)
+            except queue.Empty:
+                self._check_alive()
+
+    def _check_alive(self):
+        if not self.process.is_alive():
+            raise RuntimeError("Python worker process {} exited with code {}."
+                               .format(self.process.pid, self.process.exitcode))
+
+    def stop(self):
+        if self.process.is_alive():
+            self.in_ring.put_error(None)
+            self.process.join(_POLL_INTERVAL)
+        if self.process.is_alive():
+            self.process.terminate()
+
+
+class _ProcessPool:
+    """Fork num_workers processes running func on the rows sent to them."""
+
+    def __init__(self, func, num_workers, slot_size=SLOT_SIZE, ring_size=RING_SIZE):
+        self._func = func
+        self._num_workers = num_workers
+        self._slot_size = slot_size
+        self._ring_size = ring_size
+        self._workers = []
+        self._lock = threading.Lock()
+
+    def start(self):
+        """Fork the workers, once."""
+        with self._lock:
+            if self._workers:
+                return
+            ctx = multiprocessing.get_context("fork")
+            self._workers = [_Worker(ctx, self._func, self._slot_size, self._ring_size)
+                             for _ in range(self._num_workers)]
+            logger.info("Started %d python worker processes.", self._num_workers)
+
+    def stop(self):
+        with self._lock:
+            for worker in self._workers:
+                worker.stop()
+            self._workers = []
+
+    def __del__(self):
+        try:
+            self.stop()
+        except Exception:  # pylint: disable=broad-except
+            # the interpreter is shutting down, multiprocessing terminates the daemon workers
+            pass
+
+
+def _check_error(slot, row):
+    if slot is None:
+        raise RuntimeError("Exception in python worker process:\n{}".format(row))
+
+
+class PyFuncPool(_ProcessPool):
+    """
+    Callable running a chain of python functions of a map in worker processes.
+
+    The map threads call it like the functions it replaces, each call takes an idle worker and waits for its result
+    without the GIL, so that up to num_workers rows are computed at once.
+
+    Args:
+        funcs (list[callable]): functions applied one after the other, the output of one is the input of the next.
+        num_workers (int): number of worker processes.
+    """
+
+    def __init__(self, funcs, num_workers):
+        super().__init__(_chain(funcs), num_workers)
+        self._idle = queue.Queue()
+
+    def start(self):
+        was_started = bool(self._workers)
+        super().start()
+        if not was_started:
+            for worker in self._workers:
+                self._idle.put(worker)
+
+    def stop(self):
+        super().stop()
+        self._idle = queue.Queue()
+
+    def __call__(self, *args):
+        worker = self._idle.get()
+        try:
+            worker.put(args)
+            slot, row, is_tuple = worker.get()
+            _check_error(slot, row)
+            # The slot is given back at once, the arrays are copied out of it
+            result = [np.array(x) for x in row]
+            worker.out_ring.release(slot)
+        finally:
+            self._idle.put(worker)
+        return tuple(result) if is_tuple else result[0]
+
+
+def _chain(funcs):
+    """Returns the function applying funcs one after the other."""
+    def chained(*args):
+        for func in funcs:
+            result = func(*args)
+            args = result if isinstance(result, tuple) else (result,)
+        return result
+    return chained
+
+
+class GeneratorPool(_ProcessPool):
+    """
+    Reads the rows of a random accessible source in worker processes.
+
+    Each worker reads the rows of the indices sent to it, up to RING_SIZE rows ahead of the pipeline, the rows come
+    back in the order of the indices.
+
+    Args:
+        source (object): source with __getitem__, returning a tuple of arrays.
+        num_workers (int): number of worker processes.
+    """
+
+    def __init__(self, source, num_workers):
+        super().__init__(lambda index: tuple(np.array(x) for x in source[int(index)]), num_workers)
+        self._source = source
+        self._busy = threading.Lock()
+
+    def generate(self, indices):
+        """
+        Generator of the rows of the given indices.
+
+        A single generator uses the workers at a time, the rows of a generator created while another one runs are
+        read in this process.
+        """
+        if not self._busy.acquire(blocking=False):
+            logger.warning("Python worker processes are busy with another iterator, reading the rows in process.")
+            for index in indices:
+                yield tuple(np.array(x) for x in self._source[index])
+            return
+        # in_flight holds the worker of each index sent and not read yet, in order
+        in_flight = []
+        last = None
+        next_worker = 0
+        try:
+            indices = iter(indices)
+            exhausted = False
+            while True:
+                # Keep RING_SIZE - 1 rows in flight per worker, the last slot holds the row being converted
+                while not exhausted and len(in_flight) < self._num_workers * (self._ring_size - 1):
+                    index = next(indices, None)
+                    if index is None:
+                        exhausted = True
+                        break
+                    worker = self._workers[next_worker]
+                    next_worker = (next_worker + 1) % self._num_workers
+                    worker.put((np.array(index, dtype=np.int64),))
+                    in_flight.append(worker)
+                if last is not None:
+                    last[0].out_ring.release(last[1])
+                    last = None
+                if not in_flight:
+                    return
+                worker = in_flight.pop(0)
+                slot, row, _ = worker.get()
+                _check_error(slot, row)
+                # The row is turned into tensors before the next one is asked for, its slot is given back then
+                last = (worker, slot)
+                yield tuple(row)
+        finally:
+            try:
+                if last is not None:
+                    last[0].out_ring.release(last[1])
+                # Drain the rows computed for an iterator stopped early
+                for worker in in_flight:
+                    slot, _, _ = worker.get()
+                    worker.out_ring.release(slot)
+            finally:
+                # Also when a worker died, or every later iterator would read the rows in process
+                self._busy.release()
@@ -14,11 +14,12 @@
 # ==============================================================================
 """
 Sampler module provides several samplers to generate sampling data from dataset.
-There are following samplers: DistributedSampler, PKSampler, RandomSampler,
-SequentialSampler, SubsetRandomSampler, WeightedRandomSampler.
+There are following samplers: DistributedSampler, ElasticDistributedSampler, PKSampler,
+RandomSampler, SequentialSampler, SubsetRandomSampler, WeightedRandomSampler.
 """
 
 import mindspore._c_dataengine as cde
+from ..core.configuration import config, UINT32_MAX
 
 
 class DistributedSampler():
@@ -66,6 +67,87 @@ class DistributedSampler():
         return cde.DistributedSampler(self.num_shards, self.shard_id, self.shuffle, self.seed)
 
 
+class ElasticDistributedSampler():
+    """
+    Sampler that access a shard of the dataset, and can be resumed from a cursor with a different number of shards.
+
+    The order of the rows of an epoch only depends on the seed and the epoch. All the shards together walk
+    through that order: shard i of n reads the rows at offset + i, offset + i + n, and so on. Once every shard
+    has read the same number of rows, get_cursor gives the (epoch, offset) to resume from. Resuming with any
+    num_shards reads every remaining row of the epoch exactly once. The shards differ by at most one row in
+    the last round of an epoch.
+
+    Args:
+        num_shards (int): Number of shards to divide the dataset into.
+        shard_id (int): Shard ID of the current shard within num_shards.
+        shuffle (bool, optional): If true, the indices are shuffled (default=True).
+        seed (int, optional): Seed of the shuffle, must be the same on all the shards (default=None, the seed
+            of ds.config).
+        epoch (int, optional): Epoch of the cursor to start from (default=0).
+        offset (int, optional): Offset of the cursor to start from (default=0).
+
+    Examples:
+        >>> import mindspore.dataset as ds
+        >>>
+        >>> dataset_dir = "path/to/imagefolder_directory"
+        >>>
+        >>> # the job was checkpointed on 8 devices, each had read 1000 rows of epoch 3
+        >>> epoch, offset = ds.ElasticDistributedSampler(8, 0, epoch=3).get_cursor(3, 1000)
+        >>> # resume on 6 devices, this is device 5
+        >>> sampler = ds.ElasticDistributedSampler(6, 5, epoch=epoch, offset=offset)
+        >>> data = ds.ImageFolderDatasetV2(dataset_dir, num_parallel_workers=8, sampler=sampler)
+
+    Raises:
+        ValueError: If num_shards is not positive.
+        ValueError: If shard_id is smaller than 0 or equal to num_shards or larger than num_shards.
+        ValueError: If shuffle is not a boolean value.
+        ValueError: If seed, epoch or offset is out of range.
+    """
+
+    def __init__(self, num_shards, shard_id, shuffle=True, seed=None, epoch=0, offset=0):
+        if num_shards <= 0:
+            raise ValueError("num_shards should be a positive integer value, but got num_shards={}".format(num_shards))
+
+        if shard_id < 0 or shard_id >= num_shards:
+            raise ValueError("shard_id is invalid, shard_id={}".format(shard_id))
+
+        if not isinstance(shuffle, bool):
+            raise ValueError("shuffle should be a boolean value, but got shuffle={}".format(shuffle))
+
+        if seed is not None and (seed < 0 or seed >= UINT32_MAX):
+            raise ValueError("seed is invalid, seed={}".format(seed))
+
+        if epoch < 0 or offset < 0:
+            raise ValueError("cursor is invalid, epoch={}, offset={}".format(epoch, offset))
+
+        self.num_shards = num_shards
+        self.shard_id = shard_id
+        self.shuffle = shuffle
+        self.seed = seed if seed is not None else config.get_seed()
+        self.epoch = epoch
+        self.offset = offset
+
+    def get_cursor(self, epoch, rows_read):
+        """
+        Get the cursor to save once every shard has read the same number of rows of an epoch.
+
+        Args:
+            epoch (int): Current epoch, counted from the epoch of this sampler.
+            rows_read (int): Number of rows of the epoch read by each shard.
+
+        Returns:
+            tuple, (epoch, offset) of the cursor. An offset past the end of the epoch resumes from the
+            start of the next one.
+        """
+        start = self.offset if epoch == self.epoch else 0
+        return epoch, start + rows_read * self.num_shards
+
+    def create(self):
+        # the seed does not change between iterators, the epoch alone changes the shuffle
+        return cde.ElasticDistributedSampler(self.num_shards, self.shard_id, self.shuffle, self.seed, self.epoch,
+                                             self.offset)
+
+
 class PKSampler():
     """
     Samples K elements for each P class in the dataset.
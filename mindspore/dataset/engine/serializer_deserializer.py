@@ -151,7 +151,7 @@ def traverse(node):
         # Further serialize the object in the arguments if needed.
         if k == 'operations':
             serialize_operations(node_repr, k, v)
-        elif k == 'sampler':
+        elif k == 'sampler' and v is not None:
             serialize_sampler(node_repr, v)
         elif k in set(['schema', 'dataset_files', 'dataset_dir', 'schema_file_path']):
             expand_path(node_repr, k, v)
@@ -303,14 +303,20 @@ def create_node(node):
                                  node.get('columns_order'), node.get('num_parallel_workers'))
 
     elif dataset_op == 'ShuffleDataset':
-        pyobj = de.Dataset().shuffle(node.get('buffer_size'))
+        pyobj = de.Dataset().shuffle(node.get('buffer_size'), node.get('mem_size'), node.get('block_size'),
+                                     node.get('spill_dir'))
 
     elif dataset_op == 'BatchDataset':
-        pyobj = de.Dataset().batch(node['batch_size'], node.get('drop_remainder'))
+        if node.get('length_column') is not None:
+            pyobj = de.Dataset().bucket_batch_by_length(node['length_column'], node['bucket_boundaries'],
+                                                        node['bucket_batch_sizes'], node.get('drop_remainder'),
+                                                        pad_info=node.get('pad_info'))
+        else:
+            pyobj = de.Dataset().batch(node['batch_size'], node.get('drop_remainder'), pad_info=node.get('pad_info'))
 
     elif dataset_op == 'CacheDataset':
-        # Member function cache() is not defined in class Dataset yet.
-        raise RuntimeError(dataset_op + " is not yet supported")
+        sampler = construct_sampler(node.get('sampler')) if node.get('sampler') is not None else None
+        pyobj = de.Dataset().cache(node.get('mem_size'), node.get('spill_dir'), sampler)
 
     elif dataset_op == 'FilterDataset':
         # Member function filter() is not defined in class Dataset yet.
@@ -347,6 +353,9 @@ def construct_sampler(in_sampler):
     sampler = None
     if sampler_name == 'DistributedSampler':
         sampler = sampler_class(in_sampler['num_shards'], in_sampler['shard_id'], in_sampler.get('shuffle'))
+    elif sampler_name == 'ElasticDistributedSampler':
+        sampler = sampler_class(in_sampler['num_shards'], in_sampler['shard_id'], in_sampler.get('shuffle'),
+                                in_sampler.get('seed'), in_sampler.get('epoch', 0), in_sampler.get('offset', 0))
     elif sampler_name == 'PKSampler':
         sampler = sampler_class(in_sampler['num_val'], in_sampler.get('num_class'), in_sampler('shuffle'))
     elif sampler_name == 'RandomSampler':
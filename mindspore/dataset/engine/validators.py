@@ -298,8 +298,8 @@ def check_sampler_shuffle_shard_options(param_dict):
     num_shards, shard_id = param_dict.get('num_shards'), param_dict.get('shard_id')
 
     if sampler is not None and not isinstance(sampler, (
-            samplers.DistributedSampler, samplers.PKSampler, samplers.RandomSampler, samplers.SequentialSampler,
-            samplers.SubsetRandomSampler, samplers.WeightedRandomSampler)):
+            samplers.DistributedSampler, samplers.ElasticDistributedSampler, samplers.PKSampler, samplers.RandomSampler,
+            samplers.SequentialSampler, samplers.SubsetRandomSampler, samplers.WeightedRandomSampler)):
         raise ValueError("sampler is not a valid Sampler type.")
 
     if sampler is not None:
@@ -512,9 +512,9 @@ def check_minddataset(method):
     def new_method(*args, **kwargs):
         param_dict = make_param_dict(method, args, kwargs)
 
-        nreq_param_int = ['num_samples', 'num_parallel_workers', 'seed', 'num_shards', 'shard_id']
+        nreq_param_int = ['num_samples', 'num_parallel_workers', 'seed', 'num_shards', 'shard_id', 'io_depth']
         nreq_param_list = ['columns_list']
-        nreq_param_bool = ['block_reader']
+        nreq_param_bool = ['block_reader', 'use_mmap']
 
         # check dataset_file; required argument
         dataset_file = param_dict.get('dataset_file')
@@ -528,6 +528,10 @@ def check_minddataset(method):
 
         check_param_type(nreq_param_bool, param_dict, bool)
 
+        io_depth = param_dict.get('io_depth')
+        if io_depth is not None:
+            check_positive_int32(io_depth, 'io_depth')
+
         num_shards, shard_id = param_dict.get('num_shards'), param_dict.get('shard_id')
         if (num_shards is not None and shard_id is None) or (num_shards is None and shard_id is not None):
             raise ValueError("num_shards and shard_id need to be set or not set at the same time")
@@ -543,8 +547,9 @@ def check_generatordataset(method):
     def new_method(*args, **kwargs):
         param_dict = make_param_dict(method, args, kwargs)
 
-        nreq_param_int = ['prefetch_size']
+        nreq_param_int = ['prefetch_size', 'num_parallel_workers']
         nreq_param_list = ['column_names', 'column_types']
+        nreq_param_bool = ['python_multiprocessing']
 
         # check generator_function; required argument
         generator_function = param_dict.get('generator_function')
@@ -565,6 +570,17 @@ def check_generatordataset(method):
 
         check_param_type(nreq_param_list, param_dict, list)
 
+        check_param_type(nreq_param_bool, param_dict, bool)
+
+        num_parallel_workers = param_dict.get('num_parallel_workers')
+        if num_parallel_workers is not None:
+            check_num_parallel_workers(num_parallel_workers)
+
+        # the rows read by the worker processes are chosen by index
+        if param_dict.get('python_multiprocessing') and param_dict.get('sampler') is None and \
+                not (hasattr(generator_function, '__getitem__') and hasattr(generator_function, '__len__')):
+            raise ValueError("python_multiprocessing needs a sampler or a source with __getitem__ and __len__.")
+
         return method(*args, **kwargs)
 
     return new_method
@@ -594,6 +610,23 @@ def check_columns(columns, name):
         raise TypeError("{} should be either a list of strings or a single string.".format(name))
 
 
+def check_pad_info(pad_info):
+    """check the pad_info of batch."""
+    check_type(pad_info, 'pad_info', dict)
+    for col, shape_and_value in pad_info.items():
+        check_type(col, 'column name in pad_info', str)
+        if not isinstance(shape_and_value, (tuple, list)) or len(shape_and_value) != 2:
+            raise ValueError("pad_info of column {} should be a tuple of the pad shape and the pad value.".format(col))
+        shape, value = shape_and_value
+        if shape is not None:
+            check_type(shape, 'pad shape of column {}'.format(col), list)
+            for dim in shape:
+                if dim is not None and (not isinstance(dim, int) or isinstance(dim, bool) or dim <= 0):
+                    raise ValueError("pad shape of column {} should be a list of positive int or None.".format(col))
+        if value is not None and (not isinstance(value, (int, float)) or isinstance(value, bool)):
+            raise TypeError("pad value of column {} should be a number.".format(col))
+
+
 def check_batch(method):
     """check the input arguments of batch."""
     @wraps(method)
@@ -630,6 +663,57 @@ def check_batch(method):
             if len(input_columns) != (len(ins.signature(per_batch_map).parameters) - 1):
                 raise ValueError("the signature of per_batch_map should match with input columns")
 
+        pad_info = param_dict.get('pad_info')
+        if pad_info is not None:
+            check_pad_info(pad_info)
+
+        return method(*args, **kwargs)
+
+    return new_method
+
+
+def check_bucket_batch_by_length(method):
+    """check the input arguments of bucket_batch_by_length."""
+    @wraps(method)
+    def new_method(*args, **kwargs):
+        param_dict = make_param_dict(method, args, kwargs)
+
+        nreq_param_int = ['num_parallel_workers']
+        nreq_param_bool = ['drop_remainder']
+
+        column_name = param_dict.get('column_name')
+        if column_name is None:
+            raise ValueError("column_name is not provided.")
+        check_type(column_name, 'column_name', str)
+
+        bucket_boundaries = param_dict.get('bucket_boundaries')
+        if bucket_boundaries is None:
+            raise ValueError("bucket_boundaries is not provided.")
+        check_type(bucket_boundaries, 'bucket_boundaries', list)
+        for i, boundary in enumerate(bucket_boundaries):
+            check_type(boundary, 'bucket_boundaries[{}]'.format(i), int)
+            if boundary <= 0 or (i > 0 and boundary <= bucket_boundaries[i - 1]):
+                raise ValueError("bucket_boundaries should be positive and strictly increasing.")
+
+        bucket_batch_sizes = param_dict.get('bucket_batch_sizes')
+        if bucket_batch_sizes is None:
+            raise ValueError("bucket_batch_sizes is not provided.")
+        check_type(bucket_batch_sizes, 'bucket_batch_sizes', list)
+        if len(bucket_batch_sizes) != len(bucket_boundaries) + 1:
+            raise ValueError("bucket_batch_sizes should have one more element than bucket_boundaries.")
+        for batch_size in bucket_batch_sizes:
+            check_type(batch_size, 'bucket_batch_sizes', int)
+            if batch_size <= 0:
+                raise ValueError("bucket_batch_sizes should be positive.")
+
+        check_param_type(nreq_param_int, param_dict, int)
+
+        check_param_type(nreq_param_bool, param_dict, bool)
+
+        pad_info = param_dict.get('pad_info')
+        if pad_info is not None:
+            check_pad_info(pad_info)
+
         return method(*args, **kwargs)
 
     return new_method
@@ -648,6 +732,47 @@ def check_shuffle(method):
         check_type(buffer_size, 'buffer_size', int)
         check_interval_closed(buffer_size, 'buffer_size', [2, INT32_MAX])
 
+        mem_size = param_dict.get("mem_size")
+        if mem_size is not None:
+            check_type(mem_size, 'mem_size', int)
+            check_interval_closed(mem_size, 'mem_size', [0, INT32_MAX])
+
+        block_size = param_dict.get("block_size")
+        if block_size is not None:
+            check_type(block_size, 'block_size', int)
+            check_interval_closed(block_size, 'block_size', [0, INT32_MAX])
+
+        spill_dir = param_dict.get("spill_dir")
+        if spill_dir is not None:
+            check_type(spill_dir, 'spill_dir', str)
+
+        return method(*args, **kwargs)
+
+    return new_method
+
+
+def check_cache(method):
+    """check the input arguments of cache."""
+    @wraps(method)
+    def new_method(*args, **kwargs):
+        param_dict = make_param_dict(method, args, kwargs)
+
+        mem_size = param_dict.get("mem_size")
+        if mem_size is not None:
+            check_type(mem_size, 'mem_size', int)
+            check_interval_closed(mem_size, 'mem_size', [0, INT32_MAX])
+
+        spill_dir = param_dict.get("spill_dir")
+        if spill_dir is not None:
+            check_type(spill_dir, 'spill_dir', str)
+
+        sampler = param_dict.get("sampler")
+        if sampler is not None and not isinstance(sampler, (
+                samplers.DistributedSampler, samplers.ElasticDistributedSampler, samplers.PKSampler,
+                samplers.RandomSampler, samplers.SequentialSampler, samplers.SubsetRandomSampler,
+                samplers.WeightedRandomSampler)):
+            raise ValueError("sampler is not a valid Sampler type.")
+
         return method(*args, **kwargs)
 
     return new_method
@@ -662,9 +787,11 @@ def check_map(method):
         nreq_param_list = ['columns_order']
         nreq_param_int = ['num_parallel_workers']
         nreq_param_columns = ['input_columns', 'output_columns']
+        nreq_param_bool = ['python_multiprocessing']
 
         check_param_type(nreq_param_list, param_dict, list)
         check_param_type(nreq_param_int, param_dict, int)
+        check_param_type(nreq_param_bool, param_dict, bool)
         for param_name in nreq_param_columns:
             param = param_dict.get(param_name)
             if param is not None:
@@ -44,7 +44,7 @@ import mindspore._c_dataengine as cde
 
 from .utils import Inter, Border
 from .validators import check_prob, check_crop, check_resize_interpolation, check_random_resize_crop, \
-    check_normalize_c, check_random_crop, check_random_color_adjust, check_random_rotation, \
+    check_normalize_c, check_normalize_hwc2chw_c, check_random_crop, check_random_color_adjust, check_random_rotation, \
     check_resize, check_rescale, check_pad, check_cutout
 
 DE_C_INTER_MODE = {Inter.NEAREST: cde.InterpolationMode.DE_INTER_NEAREST_NEIGHBOUR,
@@ -373,6 +373,27 @@ class HWC2CHW(cde.ChannelSwapOp):
     """
 
 
+class NormalizeHWC2CHW(cde.NormalizeHwcToChwOp):
+    """
+    Normalize the input image with respect to mean and standard deviation and transpose it to shape (C, H, W).
+
+    Same result as Normalize followed by HWC2CHW, and by a cast to float16 if to_float16 is True,
+    with a single pass over the image. The input image should be uint8 or float32 of shape (H, W, 3).
+
+    Args:
+        mean (list): List of mean values for each channel, w.r.t channel order.
+        std (list): List of standard deviations for each channel, w.r.t. channel order.
+        to_float16 (bool, optional): Output a float16 image instead of a float32 one (default=False).
+    """
+
+    @check_normalize_hwc2chw_c
+    def __init__(self, mean, std, to_float16=False):
+        self.mean = mean
+        self.std = std
+        self.to_float16 = to_float16
+        super().__init__(*mean, *std, to_float16)
+
+
 class RandomCropDecodeResize(cde.RandomCropDecodeResizeOp):
     """
     Equivalent to RandomResizedCrop, but crops before decodes.
@@ -299,6 +299,36 @@ def check_normalize_c(method):
     return new_method
 
 
+def check_normalize_hwc2chw_c(method):
+    """A wrapper that wrap a parameter checker to the original function(fused normalize and HWC2CHW operation)."""
+
+    @wraps(method)
+    def new_method(self, *args, **kwargs):
+        mean, std, to_float16 = (list(args) + 3 * [None])[:3]
+        if "mean" in kwargs:
+            mean = kwargs.get("mean")
+        if "std" in kwargs:
+            std = kwargs.get("std")
+        if "to_float16" in kwargs:
+            to_float16 = kwargs.get("to_float16")
+
+        if mean is None:
+            raise ValueError("mean is not provided.")
+        if std is None:
+            raise ValueError("std is not provided.")
+        check_normalize_c_param(mean, std)
+        kwargs["mean"] = mean
+        kwargs["std"] = std
+
+        if to_float16 is not None:
+            check_bool(to_float16)
+            kwargs["to_float16"] = to_float16
+
+        return method(self, **kwargs)
+
+    return new_method
+
+
 def check_normalize_py(method):
     """A wrapper that wrap a parameter checker to the original function(normalize operation written in Python)."""
 
@@ -301,6 +301,21 @@ class FileWriter:
         """
         return self._writer.set_page_size(page_size)
 
+    def set_compression(self, compression):
+        """
+        Set the codec of blob pages, blob data is compressed row by row.
+
+        Args:
+           compression (str): "none", "lz4" or "zstd".
+
+        Returns:
+            MSRStatus, SUCCESS or FAILED.
+
+        Raises:
+            ParamValueError: If the codec is unknown.
+        """
+        return self._writer.set_compression(compression)
+
     def commit(self):
         """
         Flush data to disk and generate the correspond db files.
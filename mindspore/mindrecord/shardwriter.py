@@ -19,7 +19,7 @@ import numpy as np
 import mindspore._c_mindrecord as ms
 from mindspore import log as logger
 from .common.exceptions import MRMOpenError, MRMOpenForAppendError, MRMInvalidHeaderSizeError, \
-    MRMInvalidPageSizeError, MRMSetHeaderError, MRMWriteDatasetError, MRMCommitError
+    MRMInvalidPageSizeError, MRMSetHeaderError, MRMWriteDatasetError, MRMCommitError, ParamValueError
 
 __all__ = ['ShardWriter']
 
@@ -112,6 +112,25 @@ class ShardWriter:
             raise MRMInvalidPageSizeError
         return ret
 
+    def set_compression(self, compression):
+        """
+        Set the codec of blob pages.
+
+        Args:
+           compression (str): "none", "lz4" or "zstd".
+
+        Returns:
+            MSRStatus, SUCCESS or FAILED.
+
+        Raises:
+            ParamValueError: If the codec is unknown.
+        """
+        ret = self._writer.set_compression(compression)
+        if ret != ms.MSRStatus.SUCCESS:
+            logger.error("Failed to set compression.")
+            raise ParamValueError("Compression {} is not supported.".format(compression))
+        return ret
+
     def set_shard_header(self, shard_header):
         """
         Set header which contains schema and index before write raw data.
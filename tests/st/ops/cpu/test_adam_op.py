@@ -0,0 +1,57 @@
+# Copyright 2019 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+
+import pytest
+import numpy as np
+import mindspore.nn as nn
+from mindspore.ops import operations as P
+from mindspore.ops import functional as F
+from mindspore.common.parameter import Parameter
+from mindspore import Tensor
+import mindspore.context as context
+
+context.set_context(mode=context.GRAPH_MODE, device_target="CPU")
+
+var_np = np.random.uniform(-1, 1, (3, 100)).astype(np.float32)
+m_np = np.random.uniform(-1, 1, (3, 100)).astype(np.float32)
+v_np = np.random.uniform(0, 1, (3, 100)).astype(np.float32)
+
+class NetAdam(nn.Cell):
+    def __init__(self):
+        super(NetAdam, self).__init__()
+        self.adam = P.Adam()
+        self.var = Parameter(Tensor(var_np), name="var")
+        self.m = Parameter(Tensor(m_np), name="m")
+        self.v = Parameter(Tensor(v_np), name="v")
+
+    def construct(self, beta1_power, beta2_power, lr, beta1, beta2, epsilon, grad):
+        update = self.adam(self.var, self.m, self.v, beta1_power, beta2_power, lr, beta1, beta2, epsilon, grad)
+        return F.depend(self.var, update)
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_adam():
+    beta1_power, beta2_power, lr, beta1, beta2, epsilon = 0.9, 0.999, 0.001, 0.9, 0.999, 1e-8
+    grad = np.random.uniform(-1, 1, (3, 100)).astype(np.float32)
+    scalars = [Tensor(np.array([value]).astype(np.float32))
+               for value in [beta1_power, beta2_power, lr, beta1, beta2, epsilon]]
+    output = NetAdam()(*scalars, Tensor(grad))
+
+    m = m_np * beta1 + grad * (1 - beta1)
+    v = v_np * beta2 + grad * grad * (1 - beta2)
+    lr_t = lr * np.sqrt(1 - beta2_power) / (1 - beta1_power)
+    expect = var_np - lr_t * m / (np.sqrt(v) + epsilon)
+    assert np.allclose(output.asnumpy(), expect, rtol=1e-5, atol=1e-6)
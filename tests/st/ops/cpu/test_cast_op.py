@@ -0,0 +1,45 @@
+# Copyright 2019 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+
+import pytest
+from mindspore import Tensor
+from mindspore.ops import operations as P
+import mindspore.nn as nn
+import mindspore.common.dtype as mstype
+import numpy as np
+import mindspore.context as context
+
+context.set_context(mode=context.GRAPH_MODE, device_target='CPU')
+
+class NetCast(nn.Cell):
+    def __init__(self, dst_type):
+        super(NetCast, self).__init__()
+        self.cast = P.Cast()
+        self.dst_type = dst_type
+
+    def construct(self, x):
+        return self.cast(x, self.dst_type)
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_cast():
+    x = np.array([[1.7, -2.5, 3.0], [0.2, -0.9, 100.4]]).astype(np.float32)
+    output = NetCast(mstype.int32)(Tensor(x))
+    assert (output.asnumpy() == x.astype(np.int32)).all()
+
+    y = x.astype(np.int32)
+    output = NetCast(mstype.float32)(Tensor(y))
+    assert (output.asnumpy() == y.astype(np.float32)).all()
@@ -0,0 +1,96 @@
+# Copyright 2019 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+
+import pytest
+from mindspore import Tensor
+from mindspore.ops import operations as P
+import mindspore.nn as nn
+import numpy as np
+import mindspore.context as context
+
+context.set_context(mode=context.GRAPH_MODE, device_target='CPU')
+
+class NetConvBiasRelu(nn.Cell):
+    def __init__(self):
+        super(NetConvBiasRelu, self).__init__()
+        self.conv = P.Conv2D(out_channel=4, kernel_size=3, pad_mode="valid")
+        self.bias_add = P.BiasAdd()
+        self.relu = P.ReLU()
+
+    def construct(self, x, w, b):
+        return self.relu(self.bias_add(self.conv(x, w), b))
+
+class NetMatMulBiasTanh(nn.Cell):
+    def __init__(self):
+        super(NetMatMulBiasTanh, self).__init__()
+        self.matmul = P.MatMul(transpose_a=True)
+        self.bias_add = P.BiasAdd()
+        self.tanh = P.Tanh()
+
+    def construct(self, x, w, b):
+        return self.tanh(self.bias_add(self.matmul(x, w), b))
+
+class NetElementwiseChain(nn.Cell):
+    def __init__(self):
+        super(NetElementwiseChain, self).__init__()
+        self.exp = P.Exp()
+        self.mul = P.Mul()
+        self.sub = P.Sub()
+        self.sigmoid = P.Sigmoid()
+
+    def construct(self, x, y, z):
+        return self.sigmoid(self.sub(z, self.mul(self.exp(x), y)))
+
+def conv2d_valid(x, w):
+    n, _, h, width = x.shape
+    out_channel, _, kh, kw = w.shape
+    out = np.zeros((n, out_channel, h - kh + 1, width - kw + 1), np.float32)
+    for i in range(h - kh + 1):
+        for j in range(width - kw + 1):
+            out[:, :, i, j] = np.tensordot(x[:, :, i:i + kh, j:j + kw], w, axes=([1, 2, 3], [1, 2, 3]))
+    return out
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_conv_bias_relu():
+    x = np.random.uniform(-1, 1, (2, 3, 8, 8)).astype(np.float32)
+    w = np.random.uniform(-1, 1, (4, 3, 3, 3)).astype(np.float32)
+    b = np.random.uniform(-1, 1, (4,)).astype(np.float32)
+    output = NetConvBiasRelu()(Tensor(x), Tensor(w), Tensor(b))
+    expect = np.maximum(conv2d_valid(x, w) + b.reshape(1, 4, 1, 1), 0)
+    assert np.allclose(output.asnumpy(), expect, rtol=1e-4, atol=1e-5)
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_matmul_bias_tanh():
+    x = np.random.uniform(-1, 1, (64, 300)).astype(np.float32)
+    w = np.random.uniform(-1, 1, (64, 100)).astype(np.float32)
+    b = np.random.uniform(-1, 1, (100,)).astype(np.float32)
+    output = NetMatMulBiasTanh()(Tensor(x), Tensor(w), Tensor(b))
+    expect = np.tanh(np.matmul(x.T, w) + b)
+    assert np.allclose(output.asnumpy(), expect, rtol=1e-4, atol=1e-5)
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_elementwise_chain():
+    x = np.random.uniform(-2, 2, (4, 50000)).astype(np.float32)
+    y = np.random.uniform(-2, 2, (1,)).astype(np.float32)
+    z = np.random.uniform(-2, 2, (4, 50000)).astype(np.float32)
+    output = NetElementwiseChain()(Tensor(x), Tensor(y), Tensor(z))
+    expect = 1 / (1 + np.exp(-(z - np.exp(x) * y)))
+    assert np.allclose(output.asnumpy(), expect, rtol=1e-4, atol=1e-5)
@@ -0,0 +1,47 @@
+# Copyright 2019 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+
+import pytest
+from mindspore import Tensor
+from mindspore.ops import operations as P
+import mindspore.nn as nn
+import numpy as np
+import mindspore.context as context
+
+context.set_context(mode=context.GRAPH_MODE, device_target='CPU')
+
+class NetReduce(nn.Cell):
+    def __init__(self, axis, keep_dims):
+        super(NetReduce, self).__init__()
+        self.axis = axis
+        self.reduce_sum = P.ReduceSum(keep_dims)
+        self.reduce_mean = P.ReduceMean(keep_dims)
+        self.reduce_max = P.ReduceMax(keep_dims)
+
+    def construct(self, x):
+        return (self.reduce_sum(x, self.axis), self.reduce_mean(x, self.axis), self.reduce_max(x, self.axis))
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_reduce():
+    x = np.random.uniform(-2, 2, (4, 5, 6, 7)).astype(np.float32)
+    for axis, keep_dims in [((1,), False), ((0, 2), True), (-1, False), ((), False)]:
+        reduce = NetReduce(axis, keep_dims)
+        output_sum, output_mean, output_max = reduce(Tensor(x))
+        np_axis = None if axis == () else axis
+        assert np.allclose(output_sum.asnumpy(), np.sum(x, np_axis, keepdims=keep_dims), rtol=1e-4, atol=1e-4)
+        assert np.allclose(output_mean.asnumpy(), np.mean(x, np_axis, keepdims=keep_dims), rtol=1e-4, atol=1e-5)
+        assert np.allclose(output_max.asnumpy(), np.max(x, np_axis, keepdims=keep_dims))
@@ -0,0 +1,42 @@
+# Copyright 2019 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+
+import pytest
+from mindspore import Tensor
+from mindspore.ops import operations as P
+import mindspore.nn as nn
+import numpy as np
+import mindspore.context as context
+
+context.set_context(mode=context.GRAPH_MODE, device_target='CPU')
+
+class NetTensorAdd(nn.Cell):
+    def __init__(self):
+        super(NetTensorAdd, self).__init__()
+        self.add = P.TensorAdd()
+
+    def construct(self, x, y):
+        return self.add(x, y)
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_tensor_add():
+    add = NetTensorAdd()
+    x = np.random.uniform(-2, 2, (2, 3, 4, 4)).astype(np.float32)
+    for y_shape in [(2, 3, 4, 4), (3, 1, 4), (1,), (2, 1, 1, 4)]:
+        y = np.random.uniform(-2, 2, y_shape).astype(np.float32)
+        output = add(Tensor(x), Tensor(y))
+        assert np.allclose(output.asnumpy(), x + y)
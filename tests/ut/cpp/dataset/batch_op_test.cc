@@ -13,10 +13,13 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <algorithm>
 #include <iostream>
 #include <memory>
 #include <string>
 #include "dataset/core/client.h"
+#include "dataset/engine/datasetops/source/image_folder_op.h"
+#include "dataset/engine/datasetops/source/manifest_op.h"
 #include "common/common.h"
 #include "common/utils.h"
 #include "gtest/gtest.h"
@@ -64,6 +67,19 @@ std::shared_ptr<de::StorageOp> Storage(std::string schema, int rows_per_buf = 2,
   return so;
 }
 
+std::shared_ptr<de::ImageFolderOp> ImageFolder(int64_t num_works, int64_t rows, int64_t conns, std::string path,
+                                               bool shuf = false, std::unique_ptr<de::Sampler> sampler = nullptr,
+                                               std::map<std::string, int32_t> map = {}, int64_t num_samples = 0,
+                                               bool decode = false);
+
+std::shared_ptr<de::ManifestOp> Manifest(int32_t num_works, int32_t rows, int32_t conns, const std::string &file,
+                                         std::string usage = "train", std::unique_ptr<de::Sampler> sampler = nullptr,
+                                         std::map<std::string, int32_t> map = {}, uint64_t num_samples = 0,
+                                         bool decode = false);
+
+// Reads the undecoded images of a folder in order, each of them is a 1-D tensor of a different length
+std::vector<std::vector<uint8_t>> ReadImages(const std::string &folder_path);
+
 std::shared_ptr<de::ExecutionTree> Build(std::vector<std::shared_ptr<de::DatasetOp>> ops) {
   std::shared_ptr<de::ExecutionTree> tree = std::make_shared<de::ExecutionTree>();
   for (int i = 0; i < ops.size(); i++) {
@@ -325,3 +341,142 @@ TEST_F(MindDataTestBatchOp, TestBatchDropTrueRepeat) {
   }
   EXPECT_EQ(success, true);
 }
+
+std::vector<std::vector<uint8_t>> ReadImages(const std::string &folder_path) {
+  std::vector<std::vector<uint8_t>> images;
+  auto tree = Build({ImageFolder(4, 2, 32, folder_path)});
+  tree->Prepare();
+  Status rc = tree->Launch();
+  EXPECT_TRUE(rc.IsOk());
+  de::DatasetIterator di(tree);
+  TensorMap tensor_map;
+  rc = di.GetNextAsMap(&tensor_map);
+  EXPECT_TRUE(rc.IsOk());
+  while (tensor_map.size() != 0) {
+    std::shared_ptr<de::Tensor> image = tensor_map["image"];
+    images.emplace_back(image->StartAddr(), image->StartAddr() + image->SizeInBytes());
+    rc = di.GetNextAsMap(&tensor_map);
+    EXPECT_TRUE(rc.IsOk());
+  }
+  return images;
+}
+
+// Checks the padded batches of images against the images. Each row of a batch starts with the bytes of its image
+// and is padded with pad_value up to pad_len, or up to the largest image of the batch if pad_len is 0.
+void CheckPaddedBatches(std::shared_ptr<de::ExecutionTree> tree, const std::vector<std::vector<uint8_t>> &images,
+                        int32_t batch_size, int64_t pad_len, uint8_t pad_value) {
+  tree->Prepare();
+  Status rc = tree->Launch();
+  EXPECT_TRUE(rc.IsOk());
+  de::DatasetIterator di(tree);
+  TensorMap tensor_map;
+  rc = di.GetNextAsMap(&tensor_map);
+  EXPECT_TRUE(rc.IsOk());
+  size_t row = 0;
+  while (tensor_map.size() != 0) {
+    std::shared_ptr<de::Tensor> image = tensor_map["image"];
+    int64_t num_rows = std::min(static_cast<int64_t>(batch_size), static_cast<int64_t>(images.size() - row));
+    int64_t len = pad_len;
+    for (int64_t i = 0; pad_len == 0 && i < num_rows; i++) {
+      len = std::max(len, static_cast<int64_t>(images[row + i].size()));
+    }
+    EXPECT_EQ(image->shape(), de::TensorShape({num_rows, len}));
+    EXPECT_EQ(tensor_map["label"]->shape(), de::TensorShape({num_rows}));
+    for (int64_t i = 0; i < num_rows; i++, row++) {
+      const uint8_t *slot = image->StartAddr() + i * len;
+      EXPECT_TRUE(std::equal(images[row].begin(), images[row].end(), slot));
+      EXPECT_TRUE(std::all_of(slot + images[row].size(), slot + len, [pad_value](uint8_t v) { return v == pad_value; }));
+    }
+    rc = di.GetNextAsMap(&tensor_map);
+    EXPECT_TRUE(rc.IsOk());
+  }
+  EXPECT_EQ(row, images.size());
+}
+
+// Pads the images of each batch to the largest one of the batch
+TEST_F(MindDataTestBatchOp, TestPadBatchToMax) {
+  std::string folder_path = datasets_root_path_ + "/testPK/data";
+  std::vector<std::vector<uint8_t>> images = ReadImages(folder_path);
+  ASSERT_FALSE(images.empty());
+  std::shared_ptr<de::BatchOp> batch_op;
+  PadInfo pad_info = {{"image", {de::TensorShape({-1}), 0}}};
+  Status rc = de::BatchOp::Builder(4).SetPaddingMap(pad_info).Build(&batch_op);
+  EXPECT_TRUE(rc.IsOk());
+  CheckPaddedBatches(Build({ImageFolder(4, 2, 32, folder_path), batch_op}), images, 4, 0, 0);
+}
+
+// Pads the images of each batch to a fixed bucket size, with a non zero value
+TEST_F(MindDataTestBatchOp, TestPadBatchToBucket) {
+  std::string folder_path = datasets_root_path_ + "/testPK/data";
+  std::vector<std::vector<uint8_t>> images = ReadImages(folder_path);
+  ASSERT_FALSE(images.empty());
+  std::shared_ptr<de::BatchOp> batch_op;
+  PadInfo pad_info = {{"image", {de::TensorShape({160000}), 255}}};
+  Status rc = de::BatchOp::Builder(5).SetPaddingMap(pad_info).Build(&batch_op);
+  EXPECT_TRUE(rc.IsOk());
+  CheckPaddedBatches(Build({ImageFolder(4, 2, 32, folder_path), batch_op}), images, 5, 160000, 255);
+}
+
+// Test info:
+// - The train images of testManifestData are 2 undecoded images of 172876 and 54214 bytes, repeated 5 times.
+// - Bucket 0 takes the images shorter than 100000 bytes in batches of 3, bucket 1 the others in batches of 2.
+// - The leftovers of both buckets are flushed at the end of the epoch.
+TEST_F(MindDataTestBatchOp, TestBucketBatchByLength) {
+  std::string file = datasets_root_path_ + "/testManifestData/cpp.json";
+  std::shared_ptr<de::BatchOp> batch_op;
+  Status rc = de::BatchOp::Builder(1).SetBucketing("image", {100000}, {3, 2}).Build(&batch_op);
+  EXPECT_TRUE(rc.IsOk());
+  auto tree = Build({Manifest(4, 2, 32, file), Repeat(5), batch_op});
+  tree->Prepare();
+  rc = tree->Launch();
+  EXPECT_TRUE(rc.IsOk());
+  std::vector<de::TensorShape> expected = {de::TensorShape({2, 172876}), de::TensorShape({3, 54214}),
+                                           de::TensorShape({2, 172876}), de::TensorShape({2, 54214}),
+                                           de::TensorShape({1, 172876})};
+  de::DatasetIterator di(tree);
+  TensorMap tensor_map;
+  rc = di.GetNextAsMap(&tensor_map);
+  EXPECT_TRUE(rc.IsOk());
+  size_t i = 0;
+  while (tensor_map.size() != 0) {
+    ASSERT_LT(i, expected.size());
+    EXPECT_EQ(tensor_map["image"]->shape(), expected[i++]);
+    rc = di.GetNextAsMap(&tensor_map);
+    EXPECT_TRUE(rc.IsOk());
+  }
+  EXPECT_EQ(i, expected.size());
+}
+
+// Test info:
+// - Same images, all of them go to bucket 0 in batches of 4 and are padded to the longest image of the batch.
+TEST_F(MindDataTestBatchOp, TestBucketBatchByLengthPadded) {
+  std::string file = datasets_root_path_ + "/testManifestData/cpp.json";
+  std::shared_ptr<de::BatchOp> batch_op;
+  PadInfo pad_info = {{"image", {de::TensorShape({-1}), 0}}};
+  Status rc =
+    de::BatchOp::Builder(1).SetBucketing("image", {200000}, {4, 1}).SetPaddingMap(pad_info).Build(&batch_op);
+  EXPECT_TRUE(rc.IsOk());
+  auto tree = Build({Manifest(4, 2, 32, file), Repeat(5), batch_op});
+  tree->Prepare();
+  rc = tree->Launch();
+  EXPECT_TRUE(rc.IsOk());
+  std::vector<de::TensorShape> expected = {de::TensorShape({4, 172876}), de::TensorShape({4, 172876}),
+                                           de::TensorShape({2, 172876})};
+  de::DatasetIterator di(tree);
+  TensorMap tensor_map;
+  rc = di.GetNextAsMap(&tensor_map);
+  EXPECT_TRUE(rc.IsOk());
+  size_t i = 0;
+  while (tensor_map.size() != 0) {
+    ASSERT_LT(i, expected.size());
+    std::shared_ptr<de::Tensor> image = tensor_map["image"];
+    EXPECT_EQ(image->shape(), expected[i++]);
+    // The second image of each batch is the short one, its tail is padded
+    const uint8_t *slot = image->StartAddr() + 172876;
+    EXPECT_TRUE(std::all_of(slot + 54214, slot + 172876, [](uint8_t v) { return v == 0; }));
+    EXPECT_FALSE(std::all_of(slot, slot + 54214, [](uint8_t v) { return v == 0; }));
+    rc = di.GetNextAsMap(&tensor_map);
+    EXPECT_TRUE(rc.IsOk());
+  }
+  EXPECT_EQ(i, expected.size());
+}
@@ -0,0 +1,137 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "dataset/core/client.h"
+#include "dataset/engine/datasetops/source/sampler/random_sampler.h"
+#include "common/common.h"
+#include "common/utils.h"
+#include "gtest/gtest.h"
+#include "utils/log_adapter.h"
+#include <algorithm>
+#include <memory>
+#include <vector>
+#include <iostream>
+
+namespace common = mindspore::common;
+
+using namespace mindspore::dataset;
+using mindspore::MsLogLevel::INFO;
+using mindspore::ExceptionType::NoExceptionType;
+using mindspore::LogStream;
+
+class MindDataTestCacheOp : public UT::DatasetOpTesting {
+ protected:
+  // Builds the tree repeat over cache over storage, runs it and returns the number of rows.
+  // The rows of every epoch are compared with the rows of the first one.
+  int RunCacheTree(const std::shared_ptr<CacheOp> &cache_op, int32_t num_repeats) {
+    auto my_tree = std::make_shared<ExecutionTree>();
+    std::shared_ptr<StorageOp> my_storage_op;
+    Status rc = StorageOp::Builder()
+                  .SetDatasetFilesDir(datasets_root_path_ + "/testDataset1")
+                  .SetRowsPerBuffer(3)
+                  .SetWorkerConnectorSize(16)
+                  .SetNumWorkers(1)
+                  .Build(&my_storage_op);
+    EXPECT_TRUE(rc.IsOk());
+    std::shared_ptr<RepeatOp> my_repeat_op;
+    rc = RepeatOp::Builder(num_repeats).Build(&my_repeat_op);
+    EXPECT_TRUE(rc.IsOk());
+    EXPECT_TRUE(my_tree->AssociateNode(my_storage_op).IsOk());
+    EXPECT_TRUE(my_tree->AssociateNode(cache_op).IsOk());
+    EXPECT_TRUE(my_tree->AssociateNode(my_repeat_op).IsOk());
+    EXPECT_TRUE(my_repeat_op->AddChild(cache_op).IsOk());
+    EXPECT_TRUE(cache_op->AddChild(my_storage_op).IsOk());
+    EXPECT_TRUE(my_tree->AssignRoot(my_repeat_op).IsOk());
+    rc = my_tree->Prepare();
+    EXPECT_TRUE(rc.IsOk());
+    rc = my_tree->Launch();
+    EXPECT_TRUE(rc.IsOk());
+
+    DatasetIterator di(my_tree);
+    TensorRow tensor_list;
+    rc = di.FetchNextTensorRow(&tensor_list);
+    EXPECT_TRUE(rc.IsOk());
+    std::vector<std::vector<uint8_t>> first_epoch;
+    int row_count = 0;
+    while (!tensor_list.empty()) {
+      // Flatten the row to compare it with the rows of the first epoch
+      std::vector<uint8_t> bytes;
+      for (auto &t : tensor_list) {
+        bytes.insert(bytes.end(), t->StartAddr(), t->StartAddr() + t->SizeInBytes());
+      }
+      if (row_count < 10) {
+        first_epoch.push_back(bytes);
+      } else {
+        EXPECT_NE(std::find(first_epoch.begin(), first_epoch.end(), bytes), first_epoch.end());
+      }
+      rc = di.FetchNextTensorRow(&tensor_list);
+      EXPECT_TRUE(rc.IsOk());
+      row_count++;
+    }
+    return row_count;
+  }
+};
+
+// Test info:
+// - Dataset from testDataset1 has 10 rows, 2 columns.
+// - All the rows fit in memory, epoch 2 and 3 are served from the cache.
+//
+// Tree: repeat over cache over storage
+//
+//    RepeatOp
+//       |
+//    CacheOp
+//       |
+//    StorageOp
+//
+TEST_F(MindDataTestCacheOp, TestCacheInMemory) {
+  MS_LOG(INFO) << "UT test TestCacheInMemory.";
+  std::shared_ptr<CacheOp> my_cache_op;
+  Status rc = CacheOp::Builder().SetMemSize(16).SetRowsPerBuffer(4).Build(&my_cache_op);
+  EXPECT_TRUE(rc.IsOk());
+  ASSERT_EQ(RunCacheTree(my_cache_op, 3), 30);
+  ASSERT_EQ(my_cache_op->num_rows_in_mem(), 10);
+  ASSERT_EQ(my_cache_op->num_rows_spilled(), 0);
+}
+
+// Test info:
+// - Dataset from testDataset1 has 10 rows, 2 columns.
+// - No memory budget, every row goes to the spill file.
+//
+// Tree: repeat over cache over storage
+//
+TEST_F(MindDataTestCacheOp, TestCacheSpill) {
+  MS_LOG(INFO) << "UT test TestCacheSpill.";
+  std::shared_ptr<CacheOp> my_cache_op;
+  Status rc = CacheOp::Builder().SetMemSize(0).SetSpillDir("./cache_op_test").Build(&my_cache_op);
+  EXPECT_TRUE(rc.IsOk());
+  ASSERT_EQ(RunCacheTree(my_cache_op, 3), 30);
+  ASSERT_EQ(my_cache_op->num_rows_in_mem(), 0);
+  ASSERT_EQ(my_cache_op->num_rows_spilled(), 10);
+}
+
+// Test info:
+// - Dataset from testDataset1 has 10 rows, 2 columns.
+// - Epoch 2 and 3 are read from the cache in the order of a random sampler.
+//
+// Tree: repeat over cache over storage
+//
+TEST_F(MindDataTestCacheOp, TestCacheSampler) {
+  MS_LOG(INFO) << "UT test TestCacheSampler.";
+  std::shared_ptr<CacheOp> my_cache_op;
+  Status rc = CacheOp::Builder().SetSampler(std::make_shared<RandomSampler>()).Build(&my_cache_op);
+  EXPECT_TRUE(rc.IsOk());
+  ASSERT_EQ(RunCacheTree(my_cache_op, 3), 30);
+}
@@ -50,10 +50,13 @@ public:
 
   void SetSleepMilliSec(uint32_t ms) { sleep_ms_ = ms; }
 
+  void SetLockFree(bool lock_free) { lock_free_ = lock_free; }
+
 private:
   std::unique_ptr<TaskGroup> tg_;
   uint32_t last_input_;
   uint32_t sleep_ms_ = 0;
+  bool lock_free_ = false;
   std::vector<uint32_t> input_;
 
   // This worker loop is to be called by a single thread. It will pop my_conn Connector
@@ -122,6 +125,43 @@ TEST_F(MindDataTestConnector, Test2) {
 }
 
 
+// Test3: same as Test0 and Test1 but the connectors use the lock free ring queue.
+TEST_F(MindDataTestConnector, Test3) {
+  MS_LOG(INFO) << "MindDataTestConnector Test3.";
+  this->SetLockFree(true);
+  Status rc = this->Run_test_0();
+  ASSERT_TRUE(rc.IsOk());
+  rc = this->Run_test_1();
+  ASSERT_TRUE(rc.IsOk());
+  rc = TaskManager::GetMasterThreadRc();
+  ASSERT_TRUE(rc.IsOk());
+}
+
+// Test4: the time a consumer spends blocked on an empty connector is measured when profiling is on.
+TEST_F(MindDataTestConnector, Test4) {
+  MS_LOG(INFO) << "MindDataTestConnector Test4.";
+  auto my_conn = std::make_shared<Connector<uint32_t>>(1, 1, 10);
+  ASSERT_FALSE(my_conn->profiling());
+  my_conn->EnableProfiling();
+  uint32_t result = 0;
+  TaskGroup vg;
+  Status rc = vg.CreateAsyncTask("Worker Pull", [my_conn, &result]() -> Status {
+    TaskManager::FindMe()->Post();
+    return my_conn->Pop(0, &result);
+  });
+  ASSERT_TRUE(rc.IsOk());
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  rc = my_conn->Push(0, 7);
+  ASSERT_TRUE(rc.IsOk());
+  vg.join_all();
+  ASSERT_EQ(result, 7);
+  ASSERT_EQ(my_conn->push_count(), 1);
+  ASSERT_GE(my_conn->pop_wait_ns(), 40 * 1000000LL);
+  // The queue had room, so the producer never blocked for long.
+  ASSERT_LT(my_conn->push_wait_ns(), my_conn->pop_wait_ns());
+  rc = TaskManager::GetMasterThreadRc();
+  ASSERT_TRUE(rc.IsOk());
+}
 
 // Implementation of MindDataTestConnector class and the helper functions.
 MindDataTestConnector::MindDataTestConnector() : tg_(new TaskGroup()) {
@@ -136,7 +176,8 @@ Status MindDataTestConnector::Run_test_0() {
   std::vector<uint32_t> output;
   auto my_conn = std::make_shared<Connector<uint32_t>>(1,  // num of producers
                                                       1,  // num of consumers
-                                                      10);  // capacity of each queue
+                                                      10,  // capacity of each queue
+                                                      lock_free_);
   DS_ASSERT(my_conn != nullptr);
 
   // Spawn a thread to read input_ vector and put it in my_conn
@@ -178,11 +219,13 @@ Status MindDataTestConnector::Run_test_1() {
 
   auto conn1 = std::make_shared<Connector<uint32_t>>(l1_threads,  // num of producers
                                                      l2_threads,  // num of consumers
-                                                     conn1_qcap);  // the cap of each queue
+                                                     conn1_qcap,  // the cap of each queue
+                                                     lock_free_);
 
   auto conn2 = std::make_shared<Connector<uint32_t>>(l2_threads,
                                                      l3_threads,
-                                                     conn2_qcap);
+                                                     conn2_qcap,
+                                                     lock_free_);
 
   // Instantiating the threads in the first layer
   for (int i = 0; i < l1_threads; i++) {
@@ -487,3 +487,83 @@ TEST_F(MindDataTestImageFolderSampler, TestImageFolderSharding2) {
     EXPECT_TRUE(i == 11);
   }
 }
+
+// ImageFolder -> Shuffle -> Project -> Batch of the labels -> Repeat, the shuffle and the batch are left out if their
+// size is 0
+static std::shared_ptr<ExecutionTree> StateTree(const std::string &folder_path, int32_t shuffle_size,
+                                                int32_t batch_size) {
+  std::vector<std::shared_ptr<DatasetOp>> ops;
+  ops.push_back(ImageFolder(4, 3, 32, folder_path, false, std::make_unique<RandomSampler>()));
+  if (shuffle_size > 0) {
+    std::shared_ptr<ShuffleOp> shuffle;
+    EXPECT_TRUE(ShuffleOp::Builder().SetShuffleSize(shuffle_size).SetRowsPerBuffer(3).Build(&shuffle).IsOk());
+    ops.push_back(shuffle);
+  }
+  if (batch_size > 0) {
+    std::shared_ptr<ProjectOp> project;
+    EXPECT_TRUE(ProjectOp::Builder({"label"}).Build(&project).IsOk());
+    ops.push_back(project);
+    ops.push_back(Batch(batch_size));
+  }
+  ops.push_back(Repeat(2));
+  return Build(ops);
+}
+
+// Reads the rows left in a tree, a row is made of the labels and of the sizes of the images
+static std::vector<std::vector<int64_t>> ReadStateRows(const std::shared_ptr<ExecutionTree> &tree) {
+  std::vector<std::vector<int64_t>> rows;
+  DatasetIterator di(tree);
+  TensorRow row;
+  EXPECT_TRUE(di.FetchNextTensorRow(&row).IsOk());
+  while (!row.empty()) {
+    std::vector<int64_t> values;
+    for (const auto &tensor : row) {
+      if (tensor->type() == DataType(DataType::DE_INT32)) {
+        for (auto itr = tensor->begin<int32_t>(); itr != tensor->end<int32_t>(); ++itr) {
+          values.push_back(*itr);
+        }
+      } else {
+        values.push_back(tensor->SizeInBytes());
+      }
+    }
+    rows.push_back(values);
+    EXPECT_TRUE(di.FetchNextTensorRow(&row).IsOk());
+  }
+  return rows;
+}
+
+TEST_F(MindDataTestImageFolderSampler, TestImageFolderRestoreState) {
+  std::string folder_path = datasets_root_path_ + "/testPK/data";
+  // The skipped rows are left out by the sampler, dropped after the shuffle, or turned into rows for the child by the
+  // batch, which makes 9 batches per epoch, the last one of 4 rows.
+  std::vector<std::pair<int32_t, int32_t>> configs = {{0, 0}, {10, 0}, {10, 5}};
+  for (const auto &config : configs) {
+    auto tree = StateTree(folder_path, config.first, config.second);
+    ASSERT_TRUE(tree->Prepare().IsOk());
+    ASSERT_TRUE(tree->Launch().IsOk());
+    auto rows = ReadStateRows(tree);
+    ASSERT_EQ(rows.size(), config.second > 0 ? 18 : 88);
+
+    for (size_t num_rows : {0, 7, 11, 50}) {
+      if (num_rows >= rows.size()) continue;
+      nlohmann::json state;
+      ASSERT_TRUE(tree->SaveState(num_rows, &state).IsOk());
+      MS_LOG(INFO) << "Saved state: " << state.dump();
+
+      // The state of another pipeline is rejected
+      auto other_tree = StateTree(folder_path, config.first, config.second > 0 ? 0 : 5);
+      ASSERT_TRUE(other_tree->Prepare().IsOk());
+      EXPECT_TRUE(other_tree->RestoreState(state).IsError());
+
+      auto restored_tree = StateTree(folder_path, config.first, config.second);
+      ASSERT_TRUE(restored_tree->Prepare().IsOk());
+      ASSERT_TRUE(restored_tree->RestoreState(state).IsOk());
+      ASSERT_TRUE(restored_tree->Launch().IsOk());
+      auto restored_rows = ReadStateRows(restored_tree);
+      ASSERT_EQ(restored_rows.size(), rows.size() - num_rows);
+      for (size_t i = 0; i < restored_rows.size(); i++) {
+        EXPECT_EQ(restored_rows[i], rows[num_rows + i]);
+      }
+    }
+  }
+}
@@ -66,3 +66,20 @@ TEST_F(MindDataTestIntrpService, Test2) {
   vg_.GetIntrpService()->InterruptAll();
   vg_.join_all();
 }
+
+TEST_F(MindDataTestIntrpService, Test3) {
+  MS_LOG(INFO) << "Test lock free Queue";
+  Status rc;
+  Queue<int> q(3, true);
+  q.Register(&vg_);
+  vg_.CreateAsyncTask("Test3", [&]() -> Status {
+    TaskManager::FindMe()->Post();
+    int v;
+    Status rc;
+    rc = q.PopFront(&v);
+    EXPECT_TRUE(rc.IsInterrupted());
+    return rc;
+  });
+  vg_.GetIntrpService()->InterruptAll();
+  vg_.join_all();
+}
@@ -13,10 +13,13 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <unistd.h>
+#include <fstream>
 #include <iostream>
 #include <memory>
 #include <vector>
 
+#include <nlohmann/json.hpp>
 #include "common/common.h"
 #include "dataset/core/client.h"
 #include "dataset/core/tensor.h"
@@ -24,6 +27,7 @@
 #include "dataset/kernels/image/decode_op.h"
 #include "dataset/kernels/image/resize_op.h"
 #include "dataset/kernels/tensor_op.h"
+#include "dataset/util/path.h"
 #include "utils/log_adapter.h"
 
 using namespace mindspore::dataset;
@@ -434,6 +438,87 @@ TEST_F(MindDataTestMapOp, TestMultiTensorOp) {
   }
 }
 
+// TestProfiling scenario:
+//    Same pipeline as TestByPosition with the pipeline profiler turned on.
+//    Once the tree is destroyed the summary must hold the rows produced by each op and the compute time of the
+//    TensorOp.
+TEST_F(MindDataTestMapOp, TestProfiling) {
+  Status rc;
+  MS_LOG(INFO) << "Doing TestProfiling.";
+  std::string profiling_dir = "/tmp/map_op_test_profiling_" + std::to_string(getpid());
+  std::shared_ptr<ConfigManager> cfg = GlobalContext::config_manager();
+  cfg->set_profiling_dir(profiling_dir);
+  cfg->set_profiling_interval(10);
+
+  // Note: The above storage config yields 5 buffers, each with 2 rows, for a total of 10 rows.
+  auto my_storage_op = this->CreateStorageOp();
+  rc = my_tree_->AssociateNode(my_storage_op);
+  EXPECT_TRUE(rc.IsOk());
+  auto my_no_op = std::make_shared<mindspore::dataset::test::NoOp>();
+  std::vector<std::shared_ptr<TensorOp>> my_func_list;
+  my_func_list.push_back(my_no_op);
+  std::shared_ptr<MapOp> my_map_op;
+  MapOp::Builder builder;
+  builder.SetInColNames({"label"}).SetOutColNames({}).SetTensorFuncs(std::move(my_func_list)).SetNumWorkers(2);
+  rc = builder.Build(&my_map_op);
+  EXPECT_TRUE(rc.IsOk());
+  rc = my_tree_->AssociateNode(my_map_op);
+  EXPECT_TRUE(rc.IsOk());
+  rc = my_map_op->AddChild(my_storage_op);
+  EXPECT_TRUE(rc.IsOk());
+  rc = my_tree_->AssignRoot(my_map_op);
+  EXPECT_TRUE(rc.IsOk());
+  rc = my_tree_->Prepare();
+  EXPECT_TRUE(rc.IsOk());
+  rc = my_tree_->Launch();
+  EXPECT_TRUE(rc.IsOk());
+  EXPECT_TRUE(my_map_op->profiling());
+
+  {
+    DatasetIterator di(my_tree_);
+    TensorRow tensor_list;
+    rc = di.FetchNextTensorRow(&tensor_list);
+    EXPECT_TRUE(rc.IsOk());
+    while (!tensor_list.empty()) {
+      rc = di.FetchNextTensorRow(&tensor_list);
+      EXPECT_TRUE(rc.IsOk());
+    }
+  }
+  // The summary is written when the tree stops the profiler.
+  my_tree_.reset();
+  cfg->set_profiling_dir("");
+  cfg->set_profiling_interval(kCfgProfilingInterval);
+
+  Path dir(profiling_dir);
+  auto dir_it = Path::DirIterator::OpenDirectory(&dir);
+  ASSERT_NE(dir_it.get(), nullptr);
+  int32_t num_traces = 0;
+  int32_t num_summaries = 0;
+  while (dir_it->hasNext()) {
+    Path f = dir_it->next();
+    std::string name = f.toString().substr(profiling_dir.size() + 1);
+    if (name.find("pipeline_trace_") == 0) {
+      num_traces++;
+    } else if (name.find("pipeline_summary_") == 0) {
+      num_summaries++;
+      std::ifstream in(f.toString());
+      nlohmann::json summary;
+      in >> summary;
+      ASSERT_EQ(summary["ops"].size(), 2);
+      for (const auto &op : summary["ops"]) {
+        EXPECT_EQ(op["rows"].get<int64_t>(), 10);
+        if (op["name"].get<std::string>().find("MapOp") == 0) {
+          ASSERT_EQ(op["tensor_ops"].size(), 1);
+          EXPECT_EQ(op["tensor_ops"][0]["name"].get<std::string>(), "NoOp");
+          EXPECT_EQ(op["workers"].size(), 2);
+        }
+      }
+    }
+  }
+  EXPECT_EQ(num_traces, 1);
+  EXPECT_EQ(num_summaries, 1);
+}
+
 TEST_F(MindDataTestMapOp, TestStorageRepeatMap) {
   Status rc;
   MS_LOG(INFO) << "Doing TestStorageRepeatMap.";
@@ -13,6 +13,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <cstring>
 #include <iostream>
 #include <memory>
 #include <vector>
@@ -103,6 +104,61 @@ TEST_F(MindDataTestMindRecordOp, TestMindRecordBasic) {
   }
 }
 
+TEST_F(MindDataTestMindRecordOp, TestMindRecordMmap) {
+  // single MindRecord op and nothing else, read through memory maps
+  //
+  //    MindRecordOp
+
+  MS_LOG(INFO) << "UT test TestMindRecordMmap";
+
+  // Test info:
+  // Dataset from testImageNetData has 20 rows in 4 shard files. The rows read through memory maps are the same as
+  // the rows read through file streams.
+  std::string dataset_file = mindrecord_root_path_ + "/testMindDataSet/testImageNetData/imagenet.mindrecord0";
+  auto read_rows = [&dataset_file](bool use_mmap, std::vector<TensorRow> *rows) {
+    auto my_tree = std::make_shared<ExecutionTree>();
+    std::shared_ptr<MindRecordOp> my_mindrecord_op;
+    MindRecordOp::Builder builder;
+    builder.SetDatasetFile(dataset_file).SetRowsPerBuffer(3).SetNumMindRecordWorkers(4);
+    if (use_mmap) {
+      builder.SetUseMmap();
+    }
+    Status rc = builder.Build(&my_mindrecord_op);
+    ASSERT_TRUE(rc.IsOk());
+    ASSERT_EQ(my_mindrecord_op->use_mmap(), use_mmap);
+
+    my_tree->AssociateNode(my_mindrecord_op);
+    my_tree->AssignRoot(my_mindrecord_op);
+    my_tree->Prepare();
+    my_tree->Launch();
+
+    DatasetIterator di(my_tree);
+    TensorRow tensor_list;
+    rc = di.FetchNextTensorRow(&tensor_list);
+    ASSERT_TRUE(rc.IsOk());
+    while (!tensor_list.empty()) {
+      rows->push_back(tensor_list);
+      rc = di.FetchNextTensorRow(&tensor_list);
+      ASSERT_TRUE(rc.IsOk());
+    }
+  };
+
+  std::vector<TensorRow> rows;
+  std::vector<TensorRow> mapped_rows;
+  read_rows(false, &rows);
+  read_rows(true, &mapped_rows);
+  ASSERT_EQ(rows.size(), 20);
+  ASSERT_EQ(mapped_rows.size(), rows.size());
+  for (size_t i = 0; i < rows.size(); i++) {
+    ASSERT_EQ(mapped_rows[i].size(), rows[i].size());
+    for (size_t j = 0; j < rows[i].size(); j++) {
+      ASSERT_EQ(mapped_rows[i][j]->shape(), rows[i][j]->shape());
+      ASSERT_EQ(mapped_rows[i][j]->type(), rows[i][j]->type());
+      ASSERT_EQ(memcmp(mapped_rows[i][j]->StartAddr(), rows[i][j]->StartAddr(), rows[i][j]->SizeInBytes()), 0);
+    }
+  }
+}
+
 TEST_F(MindDataTestMindRecordOp, TestMindRecordSample) {
   // single MindRecord op and nothing else
   //
@@ -515,3 +571,84 @@ TEST_F(MindDataTestMindRecordOp, TestMindRecordInvalidColumnList) {
   ASSERT_TRUE(rc.IsError());
   ASSERT_TRUE(rc.ToString().find_first_of("illegal column list") != std::string::npos);
 }
+
+TEST_F(MindDataTestMindRecordOp, TestMindRecordRestoreState) {
+  // MindRecordOp -> RepeatOp, resumed from a saved state
+  //
+  //    RepeatOp
+  //       |
+  //    MindRecordOp
+
+  MS_LOG(INFO) << "UT test TestMindRecordRestoreState";
+
+  // Test info:
+  // Dataset from testImageNetData has 20 rows in 4 shard files, repeated twice. The row reader starts at the first
+  // row not skipped, with or without a shuffle, the block reader drops the skipped rows at its connector.
+  std::string dataset_file = mindrecord_root_path_ + "/testMindDataSet/testImageNetData/imagenet.mindrecord0";
+  auto build_tree = [&dataset_file](bool block_reader, bool shuffle) {
+    std::shared_ptr<MindRecordOp> my_mindrecord_op;
+    MindRecordOp::Builder builder;
+    builder.SetDatasetFile(dataset_file).SetRowsPerBuffer(3).SetNumMindRecordWorkers(4).SetColumnsToLoad(
+      {"file_name", "label"});
+    if (block_reader) {
+      builder.SetBlockReader();
+    }
+    if (shuffle) {
+      std::vector<std::shared_ptr<mindspore::mindrecord::ShardOperator>> operators;
+      operators.push_back(std::make_shared<mindspore::mindrecord::ShardShuffle>(1));
+      builder.SetOperators(operators);
+    }
+    EXPECT_TRUE(builder.Build(&my_mindrecord_op).IsOk());
+    std::shared_ptr<RepeatOp> my_repeat_op;
+    EXPECT_TRUE(RepeatOp::Builder(2).Build(&my_repeat_op).IsOk());
+
+    auto my_tree = std::make_shared<ExecutionTree>();
+    EXPECT_TRUE(my_tree->AssociateNode(my_mindrecord_op).IsOk());
+    EXPECT_TRUE(my_tree->AssociateNode(my_repeat_op).IsOk());
+    EXPECT_TRUE(my_repeat_op->AddChild(my_mindrecord_op).IsOk());
+    EXPECT_TRUE(my_tree->AssignRoot(my_repeat_op).IsOk());
+    EXPECT_TRUE(my_tree->Prepare().IsOk());
+    return my_tree;
+  };
+  auto read_rows = [](const std::shared_ptr<ExecutionTree> &my_tree, std::vector<TensorRow> *rows) {
+    DatasetIterator di(my_tree);
+    TensorRow tensor_list;
+    Status rc = di.FetchNextTensorRow(&tensor_list);
+    ASSERT_TRUE(rc.IsOk());
+    while (!tensor_list.empty()) {
+      rows->push_back(tensor_list);
+      rc = di.FetchNextTensorRow(&tensor_list);
+      ASSERT_TRUE(rc.IsOk());
+    }
+  };
+
+  std::vector<std::pair<bool, bool>> configs = {{false, false}, {false, true}, {true, false}};
+  for (const auto &config : configs) {
+    auto my_tree = build_tree(config.first, config.second);
+    ASSERT_TRUE(my_tree->Launch().IsOk());
+    std::vector<TensorRow> rows;
+    read_rows(my_tree, &rows);
+    ASSERT_EQ(rows.size(), 40);
+
+    for (size_t num_rows : {0, 4, 20, 33}) {
+      nlohmann::json state;
+      ASSERT_TRUE(my_tree->SaveState(num_rows, &state).IsOk());
+      MS_LOG(INFO) << "Saved state: " << state.dump();
+
+      auto restored_tree = build_tree(config.first, config.second);
+      ASSERT_TRUE(restored_tree->RestoreState(state).IsOk());
+      ASSERT_TRUE(restored_tree->Launch().IsOk());
+      std::vector<TensorRow> restored_rows;
+      read_rows(restored_tree, &restored_rows);
+      ASSERT_EQ(restored_rows.size(), rows.size() - num_rows);
+      for (size_t i = 0; i < restored_rows.size(); i++) {
+        const TensorRow &row = rows[num_rows + i];
+        ASSERT_EQ(restored_rows[i].size(), row.size());
+        for (size_t j = 0; j < row.size(); j++) {
+          ASSERT_EQ(restored_rows[i][j]->shape(), row[j]->shape());
+          ASSERT_EQ(memcmp(restored_rows[i][j]->StartAddr(), row[j]->StartAddr(), row[j]->SizeInBytes()), 0);
+        }
+      }
+    }
+  }
+}
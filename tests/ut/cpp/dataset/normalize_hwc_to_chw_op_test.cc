@@ -0,0 +1,137 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cmath>
+#include <cstring>
+#include "common/common.h"
+#include "common/cvop_common.h"
+#include "dataset/kernels/data/data_utils.h"
+#include "dataset/kernels/image/image_utils.h"
+#include "dataset/kernels/image/normalize_hwc_to_chw_op.h"
+#include "dataset/kernels/image/normalize_op.h"
+#include "dataset/kernels/simd_kernels.h"
+#include "dataset/core/cv_tensor.h"
+#include "utils/log_adapter.h"
+
+using namespace mindspore::dataset;
+using mindspore::MsLogLevel::INFO;
+using mindspore::ExceptionType::NoExceptionType;
+using mindspore::LogStream;
+
+class MindDataTestNormalizeHwcToChwOp : public UT::CVOP::CVOpCommon {
+ public:
+  MindDataTestNormalizeHwcToChwOp() : CVOpCommon() {}
+
+  // The vector kernels use fused multiply-add, so floats may differ in the last bit
+  template <typename T>
+  static void ExpectNear(const std::shared_ptr<Tensor> &actual, const std::shared_ptr<Tensor> &expect, float tolerance) {
+    ASSERT_EQ(actual->shape(), expect->shape());
+    ASSERT_EQ(actual->type(), expect->type());
+    auto expect_itr = expect->begin<T>();
+    for (auto itr = actual->begin<T>(); itr != actual->end<T>(); ++itr, ++expect_itr) {
+      float value = static_cast<float>(*expect_itr);
+      ASSERT_NEAR(static_cast<float>(*itr), value, tolerance * (1 + std::fabs(value)));
+    }
+  }
+
+  static void ExpectEqual(const std::shared_ptr<Tensor> &actual, const std::shared_ptr<Tensor> &expect) {
+    ASSERT_EQ(actual->shape(), expect->shape());
+    ASSERT_EQ(actual->type(), expect->type());
+    ASSERT_EQ(memcmp(actual->StartAddr(), expect->StartAddr(), actual->SizeInBytes()), 0);
+  }
+};
+
+TEST_F(MindDataTestNormalizeHwcToChwOp, TestOp) {
+  MS_LOG(INFO) << "Doing MindDataTestNormalizeHwcToChwOp::TestOp.";
+  float mean[3] = {121.0, 115.0, 100.0};
+  float std[3] = {70.0, 68.0, 71.0};
+  NormalizeOp normalize_op(mean[0], mean[1], mean[2], std[0], std[1], std[2]);
+  std::shared_ptr<Tensor> normalized;
+  std::shared_ptr<Tensor> expect;
+  ASSERT_TRUE(normalize_op.Compute(input_tensor_, &normalized).IsOk());
+  ASSERT_TRUE(HwcToChw(normalized, &expect).IsOk());
+
+  NormalizeHwcToChwOp op(mean[0], mean[1], mean[2], std[0], std[1], std[2], false);
+  EXPECT_TRUE(op.OneToOne());
+  std::shared_ptr<Tensor> output_tensor;
+  ASSERT_TRUE(op.Compute(input_tensor_, &output_tensor).IsOk());
+  ExpectNear<float>(output_tensor, expect, 1e-6);
+
+  // The float16 version matches a cast of the float32 output, up to one float16 rounding step
+  std::shared_ptr<Tensor> expect_fp16;
+  ASSERT_TRUE(ToFloat16(expect, &expect_fp16).IsOk());
+  NormalizeHwcToChwOp op_fp16(mean[0], mean[1], mean[2], std[0], std[1], std[2], true);
+  ASSERT_TRUE(op_fp16.Compute(input_tensor_, &output_tensor).IsOk());
+  ExpectNear<float16>(output_tensor, expect_fp16, 1e-3);
+
+  // A float32 input image gives the same result
+  std::shared_ptr<Tensor> input_fp32;
+  ASSERT_TRUE(TypeCast(input_tensor_, &input_fp32, DataType(DataType::DE_FLOAT32)).IsOk());
+  ASSERT_TRUE(op.Compute(input_fp32, &output_tensor).IsOk());
+  ExpectNear<float>(output_tensor, expect, 1e-6);
+
+  std::vector<DataType> types;
+  ASSERT_TRUE(op_fp16.OutputType({DataType(DataType::DE_UINT8)}, types).IsOk());
+  EXPECT_EQ(types[0], DataType(DataType::DE_FLOAT16));
+  std::vector<TensorShape> shapes;
+  ASSERT_TRUE(op.OutputShape({input_tensor_->shape()}, shapes).IsOk());
+  EXPECT_EQ(shapes[0], output_tensor->shape());
+}
+
+TEST_F(MindDataTestNormalizeHwcToChwOp, TestSimdLevels) {
+  MS_LOG(INFO) << "Doing MindDataTestNormalizeHwcToChwOp::TestSimdLevels.";
+  SimdLevel level = GetSimdLevel();
+  MS_LOG(INFO) << "Simd level: " << static_cast<int>(level);
+  NormalizeHwcToChwOp op(121.0, 115.0, 100.0, 70.0, 68.0, 71.0, true);
+  NormalizeOp normalize_op(121.0, 115.0, 100.0, 70.0, 68.0, 71.0);
+
+  // Outputs of the image kernels with vector code first, then with scalar code only
+  std::vector<std::shared_ptr<Tensor>> outputs[2];
+  for (auto &output : outputs) {
+    std::shared_ptr<Tensor> tensor;
+    ASSERT_TRUE(normalize_op.Compute(input_tensor_, &tensor).IsOk());
+    output.push_back(tensor);
+    ASSERT_TRUE(op.Compute(input_tensor_, &tensor).IsOk());
+    output.push_back(tensor);
+    ASSERT_TRUE(Rescale(input_tensor_, &tensor, 1.0 / 255, -0.5).IsOk());
+    output.push_back(tensor);
+    ASSERT_TRUE(ToFloat16(output[0], &tensor).IsOk());
+    output.push_back(tensor);
+    ASSERT_TRUE(HwcToChw(input_tensor_, &tensor).IsOk());
+    output.push_back(tensor);
+    ASSERT_TRUE(HwcToChw(output[0], &tensor).IsOk());
+    output.push_back(tensor);
+    ASSERT_TRUE(HorizontalFlip(input_tensor_, &tensor).IsOk());
+    output.push_back(tensor);
+    ASSERT_TRUE(VerticalFlip(input_tensor_, &tensor).IsOk());
+    output.push_back(tensor);
+    SetSimdLevel(SimdLevel::kScalar);
+  }
+  SetSimdLevel(level);
+
+  ExpectNear<float>(outputs[0][0], outputs[1][0], 1e-6);
+  ExpectNear<float16>(outputs[0][1], outputs[1][1], 1e-3);
+  ExpectNear<float>(outputs[0][2], outputs[1][2], 1e-6);
+  for (size_t i = 3; i < outputs[0].size(); ++i) {
+    ExpectEqual(outputs[0][i], outputs[1][i]);
+  }
+
+  // Flipping twice gives back the image
+  std::shared_ptr<Tensor> flipped;
+  ASSERT_TRUE(HorizontalFlip(outputs[0][6], &flipped).IsOk());
+  ExpectEqual(flipped, input_tensor_);
+  ASSERT_TRUE(VerticalFlip(outputs[0][7], &flipped).IsOk());
+  ExpectEqual(flipped, input_tensor_);
+}
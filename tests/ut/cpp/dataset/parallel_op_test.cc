@@ -0,0 +1,183 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "common/common.h"
+#include "dataset/core/client.h"
+#include "dataset/core/config_manager.h"
+#include "dataset/core/global_context.h"
+#include "dataset/engine/datasetops/parallel_op.h"
+#include "dataset/util/task_manager.h"
+#include "utils/log_adapter.h"
+
+using namespace mindspore::dataset;
+using mindspore::MsLogLevel::INFO;
+using mindspore::ExceptionType::NoExceptionType;
+using mindspore::LogStream;
+
+std::shared_ptr<ExecutionTree> Build(std::vector<std::shared_ptr<DatasetOp>> ops);
+
+std::shared_ptr<StorageOp> Storage(std::string schema, int rows_per_buf = 2, int num_works = 8);
+
+namespace {
+// A ParallelOp without workers, it only gives the tests access to the worker slots
+class SlotOp : public ParallelOp {
+ public:
+  explicit SlotOp(int32_t num_workers) : ParallelOp(num_workers, 1) {}
+
+  Status operator()() override { return Status::OK(); }
+
+  using ParallelOp::AcquireWorkerSlot;
+  using ParallelOp::ReleaseWorkerSlot;
+
+ protected:
+  Status WorkerEntry(int32_t worker_id) override { return Status::OK(); }
+};
+
+// Gives the waiting task some time to reach the slow path of AcquireWorkerSlot
+void Nap() { std::this_thread::sleep_for(std::chrono::milliseconds(50)); }
+}  // namespace
+
+class MindDataTestParallelOp : public UT::DatasetOpTesting {
+ public:
+  TaskGroup vg_;
+};
+
+TEST_F(MindDataTestParallelOp, TestSetActiveWorkers) {
+  SlotOp op(4);
+  EXPECT_EQ(op.active_workers(), 4);
+  op.SetActiveWorkers(2);
+  EXPECT_EQ(op.active_workers(), 2);
+  op.SetActiveWorkers(3);
+  EXPECT_EQ(op.active_workers(), 3);
+  // Clamped to [1, num_workers]
+  op.SetActiveWorkers(0);
+  EXPECT_EQ(op.active_workers(), 1);
+  op.SetActiveWorkers(8);
+  EXPECT_EQ(op.active_workers(), 4);
+}
+
+TEST_F(MindDataTestParallelOp, TestReleaseWakesWaiter) {
+  SlotOp op(2);
+  op.SetActiveWorkers(1);
+  ASSERT_TRUE(op.AcquireWorkerSlot(0).IsOk());
+  std::atomic<bool> acquired(false);
+  Status rc = vg_.CreateAsyncTask("Waiter", [&]() -> Status {
+    TaskManager::FindMe()->Post();
+    RETURN_IF_NOT_OK(op.AcquireWorkerSlot(1));
+    acquired = true;
+    op.ReleaseWorkerSlot(1);
+    return Status::OK();
+  });
+  ASSERT_TRUE(rc.IsOk());
+  Nap();
+  // The only active slot is taken, so the waiter must still be blocked
+  EXPECT_FALSE(acquired.load());
+  op.ReleaseWorkerSlot(0);
+  rc = vg_.join_all();
+  EXPECT_TRUE(rc.IsOk());
+  EXPECT_TRUE(acquired.load());
+}
+
+TEST_F(MindDataTestParallelOp, TestGrowWakesWaiter) {
+  SlotOp op(2);
+  op.SetActiveWorkers(1);
+  ASSERT_TRUE(op.AcquireWorkerSlot(0).IsOk());
+  std::atomic<bool> acquired(false);
+  Status rc = vg_.CreateAsyncTask("Waiter", [&]() -> Status {
+    TaskManager::FindMe()->Post();
+    RETURN_IF_NOT_OK(op.AcquireWorkerSlot(1));
+    acquired = true;
+    op.ReleaseWorkerSlot(1);
+    return Status::OK();
+  });
+  ASSERT_TRUE(rc.IsOk());
+  Nap();
+  EXPECT_FALSE(acquired.load());
+  // Raising the limit lets the waiter in while slot 0 is still held
+  op.SetActiveWorkers(2);
+  rc = vg_.join_all();
+  EXPECT_TRUE(rc.IsOk());
+  EXPECT_TRUE(acquired.load());
+  op.ReleaseWorkerSlot(0);
+}
+
+TEST_F(MindDataTestParallelOp, TestShrinkBlocksNewWork) {
+  SlotOp op(2);
+  ASSERT_TRUE(op.AcquireWorkerSlot(0).IsOk());
+  ASSERT_TRUE(op.AcquireWorkerSlot(1).IsOk());
+  // Both workers keep their slot, but once one is released the lower limit keeps it from being taken again
+  op.SetActiveWorkers(1);
+  op.ReleaseWorkerSlot(1);
+  std::atomic<bool> acquired(false);
+  Status rc = vg_.CreateAsyncTask("Waiter", [&]() -> Status {
+    TaskManager::FindMe()->Post();
+    RETURN_IF_NOT_OK(op.AcquireWorkerSlot(1));
+    acquired = true;
+    op.ReleaseWorkerSlot(1);
+    return Status::OK();
+  });
+  ASSERT_TRUE(rc.IsOk());
+  Nap();
+  EXPECT_FALSE(acquired.load());
+  op.ReleaseWorkerSlot(0);
+  rc = vg_.join_all();
+  EXPECT_TRUE(rc.IsOk());
+  EXPECT_TRUE(acquired.load());
+}
+
+// The auto tuner starts a BatchOp at its configured worker count, and trims it when that is over the CPU budget
+TEST_F(MindDataTestParallelOp, TestAutoTuneBudget) {
+  std::shared_ptr<ConfigManager> cfg = GlobalContext::config_manager();
+  bool orig_auto_tune = cfg->auto_tune();
+  int32_t orig_budget = cfg->auto_tune_cpu_budget();
+  cfg->set_auto_tune(true);
+  std::string schema_file = datasets_root_path_ + "/testBatchDataset";
+  for (int32_t budget : {2, 16}) {
+    MS_LOG(INFO) << "Doing TestAutoTuneBudget with budget " << budget << ".";
+    cfg->set_auto_tune_cpu_budget(budget);
+    std::shared_ptr<BatchOp> batch_op;
+    Status rc = BatchOp::Builder(2).SetNumWorkers(4).Build(&batch_op);
+    ASSERT_TRUE(rc.IsOk());
+    auto tree = Build({Storage(schema_file), batch_op});
+    rc = tree->Prepare();
+    ASSERT_TRUE(rc.IsOk());
+    rc = tree->Launch();
+    ASSERT_TRUE(rc.IsOk());
+    int32_t expected = std::min(budget, 4);
+    // The tuner trims the pool from its own task, give it some time to start
+    for (int i = 0; i < 100 && batch_op->active_workers() != expected; i++) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_EQ(batch_op->active_workers(), expected);
+    DatasetIterator di(tree);
+    TensorMap tensor_map;
+    rc = di.GetNextAsMap(&tensor_map);
+    EXPECT_TRUE(rc.IsOk());
+    while (!tensor_map.empty()) {
+      EXPECT_LE(batch_op->active_workers(), expected);
+      rc = di.GetNextAsMap(&tensor_map);
+      EXPECT_TRUE(rc.IsOk());
+    }
+  }
+  cfg->set_auto_tune(orig_auto_tune);
+  cfg->set_auto_tune_cpu_budget(orig_budget);
+}
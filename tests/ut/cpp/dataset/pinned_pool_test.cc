@@ -0,0 +1,131 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "dataset/core/config_manager.h"
+#include "dataset/core/global_context.h"
+#include "dataset/core/tensor.h"
+#include "dataset/engine/datasetops/device_queue_op.h"
+#include "dataset/util/pinned_pool.h"
+#include "common/common.h"
+#include "gtest/gtest.h"
+#include "utils/log_adapter.h"
+
+using namespace mindspore::dataset;
+using mindspore::MsLogLevel::INFO;
+using mindspore::ExceptionType::NoExceptionType;
+using mindspore::LogStream;
+
+class MindDataTestPinnedPool : public UT::Common {
+ public:
+  MindDataTestPinnedPool() {}
+
+ protected:
+  // Hands num_batches batches of images and labels over the way the GPU device queue does, and returns the bytes
+  // copied on the host per batch.
+  int64_t HandOver(int32_t num_batches) {
+    int64_t bytes_copied = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int32_t i = 0; i < num_batches; i++) {
+      // A batch of 32 images of 3x224x224 and the labels
+      TensorRow row;
+      row.push_back(std::make_shared<Tensor>(TensorShape({32, 3, 224, 224}), DataType(DataType::DE_UINT8)));
+      row.push_back(std::make_shared<Tensor>(TensorShape({32}), DataType(DataType::DE_INT32)));
+      std::vector<unsigned char *> addrs;
+      for (auto &t : row) {
+        EXPECT_NE(t->StartAddr(), nullptr);
+        unsigned char *addr = nullptr;
+        int64_t copied = 0;
+        EXPECT_TRUE(DeviceQueueOp::AcquireHostBuffer(t, &addr, &copied).IsOk());
+        bytes_copied += copied;
+        addrs.push_back(addr);
+      }
+      // The row goes away before the device is done with the buffers
+      row.clear();
+      for (auto addr : addrs) {
+        DeviceQueueOp::ReleaseHostBuffer(addr);
+      }
+    }
+    auto end = std::chrono::steady_clock::now();
+    MS_LOG(INFO) << "Handed over " << num_batches << " batches in "
+                 << std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() << " us, "
+                 << bytes_copied / num_batches << " bytes copied per batch.";
+    return bytes_copied / num_batches;
+  }
+};
+
+TEST_F(MindDataTestPinnedPool, TestAllocate) {
+  PinnedPool pool;
+  void *p = nullptr;
+  ASSERT_TRUE(pool.Allocate(100, &p).IsOk());
+  ASSERT_NE(p, nullptr);
+  ASSERT_EQ(reinterpret_cast<uintptr_t>(p) % PinnedPool::PageSize(), 0);
+  ASSERT_TRUE(pool.Owns(p));
+  ASSERT_EQ(pool.ref_count(p), 1);
+
+  ASSERT_TRUE(pool.AddRef(p).IsOk());
+  ASSERT_EQ(pool.ref_count(p), 2);
+  // A shared slab can't move
+  ASSERT_FALSE(pool.Reallocate(&p, 100, 2 * PinnedPool::PageSize()).IsOk());
+  pool.Deallocate(p);
+  ASSERT_EQ(pool.ref_count(p), 1);
+  pool.Deallocate(p);
+  ASSERT_FALSE(pool.Owns(p));
+
+  // A slab of the same number of pages comes from the free list
+  void *q = nullptr;
+  ASSERT_TRUE(pool.Allocate(200, &q).IsOk());
+  ASSERT_EQ(p, q);
+  pool.Deallocate(q);
+}
+
+TEST_F(MindDataTestPinnedPool, TestTensorData) {
+  std::shared_ptr<ConfigManager> cfg = GlobalContext::config_manager();
+  cfg->set_pinned_memory(true);
+  std::shared_ptr<PinnedPool> pool = GlobalContext::Instance()->pinned_pool();
+  auto t = std::make_shared<Tensor>(TensorShape({2, 3}), DataType(DataType::DE_FLOAT32));
+  unsigned char *data = t->StartAddr();
+  cfg->set_pinned_memory(false);
+  ASSERT_TRUE(pool->Owns(data));
+
+  unsigned char *addr = nullptr;
+  int64_t copied = -1;
+  ASSERT_TRUE(DeviceQueueOp::AcquireHostBuffer(t, &addr, &copied).IsOk());
+  ASSERT_EQ(addr, data);
+  ASSERT_EQ(copied, 0);
+  ASSERT_EQ(pool->ref_count(data), 2);
+  // The handed over buffer outlives the tensor
+  t.reset();
+  ASSERT_EQ(pool->ref_count(data), 1);
+  DeviceQueueOp::ReleaseHostBuffer(addr);
+  ASSERT_FALSE(pool->Owns(data));
+}
+
+// Benchmark of the bytes copied on the host per batch handed over to the device queue, before and after.
+TEST_F(MindDataTestPinnedPool, TestHandOverBenchmark) {
+  MS_LOG(INFO) << "Doing MindDataTestPinnedPool-TestHandOverBenchmark.";
+  std::shared_ptr<ConfigManager> cfg = GlobalContext::config_manager();
+  const int64_t batch_bytes = 32 * 3 * 224 * 224 + 32 * 4;
+
+  cfg->set_pinned_memory(false);
+  ASSERT_EQ(HandOver(20), batch_bytes);
+
+  cfg->set_pinned_memory(true);
+  ASSERT_EQ(HandOver(20), 0);
+  cfg->set_pinned_memory(false);
+}
@@ -22,6 +22,8 @@
 #include "dataset/util/task_manager.h"
 #include "dataset/util/queue.h"
 #include <atomic>
+#include <chrono>
+#include <thread>
 #include "utils/log_adapter.h"
 
 using namespace mindspore::dataset;
@@ -172,3 +174,208 @@ TEST_F(MindDataTestQueue, Test6) {
   MS_LOG(INFO) << "Popped value " << *pepped_value << " from queue index " << chosen_queue_index;
   ASSERT_EQ(*pepped_value, 99);
 }
+
+TEST_F(MindDataTestQueue, Test7) {
+  // Same as Test1 but on the lock free ring.
+  Queue<std::shared_ptr<int>> que(3, true);
+  ASSERT_TRUE(que.lock_free());
+  // The ring has 4 slots but reports and keeps to the requested capacity.
+  ASSERT_EQ(que.capacity(), 3);
+  std::shared_ptr<int> a = std::make_shared<int>(20);
+  Status rc = que.Add(a);
+  ASSERT_TRUE(rc.IsOk());
+  ASSERT_EQ(a.use_count(), 2);
+  std::shared_ptr<int> b;
+  rc = que.PopFront(&b);
+  ASSERT_TRUE(rc.IsOk());
+  ASSERT_EQ(*b, 20);
+  ASSERT_EQ(a.use_count(), 2);
+  a.reset(new int(5));
+  rc = que.Add(std::move(a));
+  ASSERT_TRUE(rc.IsOk());
+  ASSERT_EQ(a.use_count(), 0);
+  rc = que.PopFront(&b);
+  ASSERT_TRUE(rc.IsOk());
+  ASSERT_EQ(*b, 5);
+  ASSERT_EQ(b.use_count(), 1);
+  rc = que.EmplaceBack(std::make_shared<int>(100));
+  ASSERT_TRUE(rc.IsOk());
+  rc = que.PopFront(&b);
+  ASSERT_TRUE(rc.IsOk());
+  ASSERT_EQ(*b, 100);
+  ASSERT_TRUE(que.empty());
+  // Leave an element in the queue and let the queue go out of scope.
+  rc = que.EmplaceBack(std::make_shared<int>(2000));
+  ASSERT_TRUE(rc.IsOk());
+  ASSERT_EQ(que.size(), 1);
+}
+
+TEST_F(MindDataTestQueue, TestResize) {
+  Queue<std::shared_ptr<int>> que(3);
+  for (int i = 0; i < 3; i++) {
+    Status rc = que.Add(std::make_shared<int>(i));
+    ASSERT_TRUE(rc.IsOk());
+  }
+  // Wrap the ring around before resizing.
+  std::shared_ptr<int> b;
+  Status rc = que.PopFront(&b);
+  ASSERT_TRUE(rc.IsOk());
+  ASSERT_EQ(*b, 0);
+  rc = que.Add(std::make_shared<int>(3));
+  ASSERT_TRUE(rc.IsOk());
+  rc = que.Resize(8);
+  ASSERT_TRUE(rc.IsOk());
+  ASSERT_EQ(que.capacity(), 8);
+  ASSERT_EQ(que.size(), 3);
+  for (int i = 4; i < 9; i++) {
+    rc = que.Add(std::make_shared<int>(i));
+    ASSERT_TRUE(rc.IsOk());
+  }
+  ASSERT_EQ(que.size(), 8);
+  // Can't shrink below the number of elements in the queue.
+  rc = que.Resize(2);
+  ASSERT_TRUE(rc.IsOk());
+  ASSERT_EQ(que.capacity(), 8);
+  for (int i = 1; i < 9; i++) {
+    rc = que.PopFront(&b);
+    ASSERT_TRUE(rc.IsOk());
+    ASSERT_EQ(*b, i);
+    ASSERT_EQ(b.use_count(), 1);
+  }
+  rc = que.Resize(2);
+  ASSERT_TRUE(rc.IsOk());
+  ASSERT_EQ(que.capacity(), 2);
+  // The lock free ring has a fixed size.
+  Queue<std::shared_ptr<int>> ring(4, true);
+  rc = ring.Resize(8);
+  ASSERT_TRUE(rc.IsError());
+}
+
+TEST_F(MindDataTestQueue, Test8) {
+  // Stale elements left in the lock free ring must be destroyed exactly once.
+  gRefCountDestructorCalled = 0;
+  {
+    Queue<RefCount> que(3, true);
+    RefCount a(3);
+    Status rc = que.Add(a);
+    ASSERT_TRUE(rc.IsOk());
+    RefCount b;
+    rc = que.PopFront(&b);
+    ASSERT_TRUE(rc.IsOk());
+    ASSERT_EQ(b.v_.use_count(), 2);
+    rc = que.EmplaceBack(10);
+    ASSERT_TRUE(rc.IsOk());
+  }
+  // a, b, the popped slot and the stale element.
+  ASSERT_EQ(gRefCountDestructorCalled, 4);
+}
+
+TEST_F(MindDataTestQueue, Test9) {
+  // The lock free ring holds no more than the requested capacity.
+  Queue<int> que(3, true);
+  for (int i = 0; i < 3; i++) {
+    ASSERT_TRUE(que.Add(i).IsOk());
+  }
+  ASSERT_EQ(que.size(), 3);
+  TaskGroup vg;
+  Status rc = que.Register(&vg);
+  ASSERT_TRUE(rc.IsOk());
+  std::atomic<bool> added(false);
+  rc = vg.CreateAsyncTask("Producer", [&que, &added]() -> Status {
+    TaskManager::FindMe()->Post();
+    RETURN_IF_NOT_OK(que.Add(3));
+    added = true;
+    return Status::OK();
+  });
+  ASSERT_TRUE(rc.IsOk());
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  ASSERT_FALSE(added.load());
+  int v;
+  rc = que.PopFront(&v);
+  ASSERT_TRUE(rc.IsOk());
+  ASSERT_EQ(v, 0);
+  rc = vg.join_all();
+  ASSERT_TRUE(rc.IsOk());
+  ASSERT_TRUE(added.load());
+  ASSERT_EQ(que.size(), 3);
+}
+
+TEST_F(MindDataTestQueue, Test10) {
+  // Reset the lock free ring while a producer and a consumer still run, as a connector may be reset between
+  // two epochs before every worker is idle.
+  Queue<std::shared_ptr<int64_t>> que(10, true);
+  TaskGroup vg;
+  Status rc = que.Register(&vg);
+  ASSERT_TRUE(rc.IsOk());
+  std::atomic<bool> stop(false);
+  rc = vg.CreateAsyncTask("Producer", [&que, &stop]() -> Status {
+    TaskManager::FindMe()->Post();
+    while (!stop) {
+      RETURN_IF_NOT_OK(que.Add(std::make_shared<int64_t>(1)));
+    }
+    return Status::OK();
+  });
+  ASSERT_TRUE(rc.IsOk());
+  rc = vg.CreateAsyncTask("Consumer", [&que, &stop]() -> Status {
+    TaskManager::FindMe()->Post();
+    while (!stop) {
+      std::shared_ptr<int64_t> v;
+      RETURN_IF_NOT_OK(que.PopFront(&v));
+      EXPECT_NE(v, nullptr);
+      EXPECT_EQ(*v, 1);
+    }
+    return Status::OK();
+  });
+  ASSERT_TRUE(rc.IsOk());
+  for (int i = 0; i < 1000; i++) {
+    que.Reset();
+  }
+  stop = true;
+  vg.interrupt_all();
+  (void)vg.join_all();
+}
+
+// Push num_elements through a queue with one producer and one consumer thread and check the order is kept.
+// @return the elapsed time in micro seconds
+static int64_t RunQueue(Queue<int64_t> *que, int64_t num_elements) {
+  TaskGroup vg;
+  Status rc = que->Register(&vg);
+  EXPECT_TRUE(rc.IsOk());
+  auto start = std::chrono::steady_clock::now();
+  rc = vg.CreateAsyncTask("Producer", [que, num_elements]() -> Status {
+    TaskManager::FindMe()->Post();
+    for (int64_t i = 0; i < num_elements; i++) {
+      RETURN_IF_NOT_OK(que->Add(i));
+    }
+    return Status::OK();
+  });
+  EXPECT_TRUE(rc.IsOk());
+  rc = vg.CreateAsyncTask("Consumer", [que, num_elements]() -> Status {
+    TaskManager::FindMe()->Post();
+    for (int64_t i = 0; i < num_elements; i++) {
+      int64_t v;
+      RETURN_IF_NOT_OK(que->PopFront(&v));
+      EXPECT_EQ(v, i);
+    }
+    return Status::OK();
+  });
+  EXPECT_TRUE(rc.IsOk());
+  rc = vg.join_all();
+  EXPECT_TRUE(rc.IsOk());
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+}
+
+TEST_F(MindDataTestQueue, TestPerf) {
+  // Micro benchmark comparing the mutex based queue with the lock free ring.
+  const int64_t num_elements = 1000000;
+  const int capacity = 16;
+  Queue<int64_t> locked_que(capacity);
+  Queue<int64_t> lock_free_que(capacity, true);
+  int64_t locked_us = RunQueue(&locked_que, num_elements);
+  int64_t lock_free_us = RunQueue(&lock_free_que, num_elements);
+  MS_LOG(INFO) << "Queue of capacity " << capacity << " passing " << num_elements << " elements. Mutex queue: "
+               << locked_us << " us. Lock free queue: " << lock_free_us << " us.";
+  ASSERT_TRUE(locked_que.empty());
+  ASSERT_TRUE(lock_free_que.empty());
+}
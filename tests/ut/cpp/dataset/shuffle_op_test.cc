@@ -333,3 +333,91 @@ TEST_F(MindDataTestShuffleOp, TestRepeatShuffle) {
   }
   ASSERT_EQ(row_count, 20);
 }
+
+// Test info:
+// - Dataset from testDataset1 has 10 rows, 2 columns.
+// - The shuffle buffer keeps its rows in an Arena of 1 MB.
+// - Block size of 3 turns on the two level shuffle, the last block is partially filled.
+// - Repeat count of 2, the spill file and the Arena are reused by the second epoch.
+//
+// Tree: Repeat over shuffle over storage
+//
+//    Repeat
+//       |
+//    shuffle
+//       |
+//    StorageOp
+//
+TEST_F(MindDataTestShuffleOp, TestShuffleMemSizeBlocks) {
+  Status rc;
+  MS_LOG(INFO) << "UT test TestShuffleMemSizeBlocks.";
+
+  // Start with an empty execution tree
+  auto my_tree = std::make_shared<ExecutionTree>();
+
+  std::string dataset_path;
+  dataset_path = datasets_root_path_ + "/testDataset1";
+  std::shared_ptr<StorageOp> my_storage_op;
+  rc = StorageOp::Builder()
+      .SetDatasetFilesDir(dataset_path)
+      .SetRowsPerBuffer(3)
+      .SetWorkerConnectorSize(16)
+      .SetNumWorkers(2)
+      .Build(&my_storage_op);
+  EXPECT_TRUE(rc.IsOk());
+  rc = my_tree->AssociateNode(my_storage_op);
+  EXPECT_TRUE(rc.IsOk());
+  std::shared_ptr<ShuffleOp> my_shuffle_op;
+  rc = ShuffleOp::Builder()
+      .SetShuffleSize(4)
+      .SetShuffleSeed(100)
+      .SetRowsPerBuffer(3)
+      .SetMemSize(1)
+      .SetBlockSize(3)
+      .Build(&my_shuffle_op);
+  EXPECT_TRUE(rc.IsOk());
+  rc = my_tree->AssociateNode(my_shuffle_op);
+  EXPECT_TRUE(rc.IsOk());
+  std::shared_ptr<RepeatOp> my_repeat_op;
+  rc = RepeatOp::Builder(2).Build(&my_repeat_op);
+  EXPECT_TRUE(rc.IsOk());
+  rc = my_tree->AssociateNode(my_repeat_op);
+  EXPECT_TRUE(rc.IsOk());
+
+  // Set children/root layout.
+  rc = my_repeat_op->AddChild(my_shuffle_op);
+  EXPECT_TRUE(rc.IsOk());
+  rc = my_shuffle_op->AddChild(my_storage_op);
+  EXPECT_TRUE(rc.IsOk());
+  rc = my_tree->AssignRoot(my_repeat_op);
+  EXPECT_TRUE(rc.IsOk());
+  MS_LOG(INFO) << "Launching tree and begin iteration.";
+  rc = my_tree->Prepare();
+  EXPECT_TRUE(rc.IsOk());
+  rc = my_tree->Launch();
+  EXPECT_TRUE(rc.IsOk());
+
+  // Start the loop of reading tensors from our pipeline
+  DatasetIterator di(my_tree);
+  TensorRow tensor_list;
+  rc = di.FetchNextTensorRow(&tensor_list);
+  EXPECT_TRUE(rc.IsOk());
+  int row_count = 0;
+  while (!tensor_list.empty()) {
+    ASSERT_EQ(tensor_list.size(), 2);
+    rc = di.FetchNextTensorRow(&tensor_list);
+    EXPECT_TRUE(rc.IsOk());
+    row_count++;
+  }
+  ASSERT_EQ(row_count, 20);
+}
+
+// Test info:
+// - Negative memory and block sizes are rejected by the builder.
+TEST_F(MindDataTestShuffleOp, TestShuffleBadMemSize) {
+  std::shared_ptr<ShuffleOp> my_shuffle_op;
+  Status rc = ShuffleOp::Builder().SetShuffleSize(4).SetMemSize(-1).Build(&my_shuffle_op);
+  EXPECT_TRUE(rc.IsError());
+  rc = ShuffleOp::Builder().SetShuffleSize(4).SetBlockSize(-1).Build(&my_shuffle_op);
+  EXPECT_TRUE(rc.IsError());
+}
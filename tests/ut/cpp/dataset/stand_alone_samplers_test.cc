@@ -18,6 +18,7 @@
 #include "dataset/core/client.h"
 #include "dataset/core/global_context.h"
 #include "dataset/engine/datasetops/source/sampler/distributed_sampler.h"
+#include "dataset/engine/datasetops/source/sampler/elastic_distributed_sampler.h"
 #include "dataset/engine/datasetops/source/sampler/random_sampler.h"
 #include "dataset/engine/datasetops/source/sampler/sampler.h"
 #include "dataset/engine/datasetops/source/sampler/sequential_sampler.h"
@@ -85,6 +86,64 @@ TEST_F(MindDataTestStandAloneSampler, TestDistributedSampler) {
   }
 }
 
+TEST_F(MindDataTestStandAloneSampler, TestElasticDistributedSampler) {
+  MockStorageOp mock(20);
+  std::unique_ptr<DataBuffer> db;
+  std::shared_ptr<Tensor> tensor;
+  std::vector<int64_t> seen(20, 0);
+  int64_t epoch = 0;
+  int64_t offset = 0;
+
+  // 3 devices read 4 rows each of epoch 0, then the job resumes on 4 devices from the cursor
+  for (int64_t dev = 0; dev < 3; dev++) {
+    ElasticDistributedSampler sampler(3, dev, true, 7);
+    ASSERT_TRUE(sampler.Init(&mock).IsOk());
+    ASSERT_TRUE(sampler.GetNextBuffer(&db).IsOk());
+    db->GetTensor(&tensor, 0, 0);
+    auto ids = reinterpret_cast<const int64_t *>(tensor->StartAddr());
+    for (int i = 0; i < 4; i++) {
+      seen[ids[i]]++;
+    }
+    sampler.GetCursor(4, &epoch, &offset);
+  }
+  EXPECT_EQ(epoch, 0);
+  EXPECT_EQ(offset, 12);
+
+  int64_t rows_left = 0;
+  for (int64_t dev = 0; dev < 4; dev++) {
+    ElasticDistributedSampler sampler(4, dev, true, 7, epoch, offset);
+    ASSERT_TRUE(sampler.Init(&mock).IsOk());
+    ASSERT_TRUE(sampler.GetNextBuffer(&db).IsOk());
+    db->GetTensor(&tensor, 0, 0);
+    auto ids = reinterpret_cast<const int64_t *>(tensor->StartAddr());
+    for (int64_t i = 0; i < tensor->Size(); i++) {
+      seen[ids[i]]++;
+    }
+    rows_left += tensor->Size();
+    ASSERT_TRUE(sampler.GetNextBuffer(&db).IsOk());
+    EXPECT_TRUE(db->eoe());
+  }
+  EXPECT_EQ(rows_left, 8);
+  // Every row of the epoch is read exactly once
+  EXPECT_EQ(seen, std::vector<int64_t>(20, 1));
+
+  // The order only depends on (seed, epoch), so a sampler resumed at epoch 1 reads what a reset one does
+  ElasticDistributedSampler reset_sampler(2, 1, true, 7);
+  ElasticDistributedSampler resumed_sampler(2, 1, true, 7, 0, 20);
+  std::shared_ptr<Tensor> reset_tensor;
+  ASSERT_TRUE(reset_sampler.Init(&mock).IsOk());
+  ASSERT_TRUE(reset_sampler.GetNextBuffer(&db).IsOk());
+  ASSERT_TRUE(reset_sampler.GetNextBuffer(&db).IsOk());
+  ASSERT_TRUE(reset_sampler.Reset().IsOk());
+  ASSERT_TRUE(reset_sampler.GetNextBuffer(&db).IsOk());
+  db->GetTensor(&reset_tensor, 0, 0);
+  ASSERT_TRUE(resumed_sampler.Init(&mock).IsOk());
+  EXPECT_EQ(resumed_sampler.epoch(), 1);
+  ASSERT_TRUE(resumed_sampler.GetNextBuffer(&db).IsOk());
+  db->GetTensor(&tensor, 0, 0);
+  EXPECT_TRUE((*tensor) == (*reset_tensor));
+}
+
 TEST_F(MindDataTestStandAloneSampler, TestStandAoneSequentialSampler) {
   std::vector<std::shared_ptr<Tensor>> row;
   MockStorageOp mock(5);
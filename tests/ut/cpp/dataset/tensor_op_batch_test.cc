@@ -0,0 +1,120 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cstring>
+#include "common/common.h"
+#include "common/cvop_common.h"
+#include "dataset/kernels/data/one_hot_op.h"
+#include "dataset/kernels/data/type_cast_op.h"
+#include "dataset/kernels/image/normalize_op.h"
+#include "dataset/kernels/image/rescale_op.h"
+#include "dataset/kernels/image/resize_op.h"
+#include "utils/log_adapter.h"
+
+using namespace mindspore::dataset;
+using mindspore::MsLogLevel::INFO;
+using mindspore::ExceptionType::NoExceptionType;
+using mindspore::LogStream;
+
+class MindDataTestTensorOpBatch : public UT::CVOP::CVOpCommon {
+ public:
+  MindDataTestTensorOpBatch() : CVOpCommon() {}
+
+  // The batch must give the same Tensors as the rows computed one by one
+  static void CheckBatch(TensorOp *op, const TensorRow &input) {
+    TensorRow batch_output;
+    ASSERT_TRUE(op->ComputeBatch(input, &batch_output).IsOk());
+    ASSERT_EQ(batch_output.size(), input.size());
+    for (size_t i = 0; i < input.size(); i++) {
+      std::shared_ptr<Tensor> output;
+      ASSERT_TRUE(op->Compute(input[i], &output).IsOk());
+      ASSERT_TRUE(batch_output[i]->shape() == output->shape());
+      ASSERT_TRUE(batch_output[i]->type() == output->type());
+      ASSERT_TRUE(*batch_output[i] == *output);
+    }
+  }
+
+  // The test image, a copy of it as float and a smaller version of it
+  TensorRow Images() {
+    std::shared_ptr<Tensor> as_float, smaller;
+    EXPECT_TRUE(TypeCastOp(DataType(DataType::DE_FLOAT32)).Compute(input_tensor_, &as_float).IsOk());
+    EXPECT_TRUE(ResizeOp(64, 48).Compute(input_tensor_, &smaller).IsOk());
+    return {input_tensor_, as_float, smaller, input_tensor_};
+  }
+};
+
+TEST_F(MindDataTestTensorOpBatch, TestImageOps) {
+  MS_LOG(INFO) << "Doing MindDataTestTensorOpBatch-TestImageOps.";
+  TensorRow images = Images();
+  NormalizeOp normalize(121.0, 115.0, 100.0, 70.0, 68.0, 71.0);
+  CheckBatch(&normalize, images);
+  RescaleOp rescale(1.0 / 255, -0.5);
+  CheckBatch(&rescale, images);
+  // Images of the same size share their output size
+  ResizeOp resize(100);
+  CheckBatch(&resize, images);
+  ResizeOp resize_both(50, 70);
+  CheckBatch(&resize_both, images);
+
+  // A batch of images is normalized as a whole
+  std::shared_ptr<Tensor> stacked;
+  TensorShape image_shape = images[1]->shape();
+  ASSERT_TRUE(Tensor::CreateTensor(&stacked, TensorImpl::kFlexible, TensorShape({2}).AppendDim(image_shape[0])
+                                     .AppendDim(image_shape[1]).AppendDim(image_shape[2]),
+                                   DataType(DataType::DE_FLOAT32))
+                .IsOk());
+  size_t image_bytes = images[1]->SizeInBytes();
+  (void)memcpy(stacked->StartAddr(), images[1]->StartAddr(), image_bytes);
+  (void)memcpy(stacked->StartAddr() + image_bytes, images[1]->StartAddr(), image_bytes);
+  TensorRow normalized;
+  ASSERT_TRUE(normalize.ComputeBatch({stacked, images[1]}, &normalized).IsOk());
+  ASSERT_TRUE(normalized[0]->shape() == stacked->shape());
+  ASSERT_EQ(memcmp(normalized[0]->StartAddr(), normalized[1]->StartAddr(), normalized[1]->SizeInBytes()), 0);
+  ASSERT_EQ(memcmp(normalized[0]->StartAddr() + normalized[1]->SizeInBytes(), normalized[1]->StartAddr(),
+                   normalized[1]->SizeInBytes()),
+            0);
+}
+
+TEST_F(MindDataTestTensorOpBatch, TestDataOps) {
+  MS_LOG(INFO) << "Doing MindDataTestTensorOpBatch-TestDataOps.";
+  int32_t labels[3] = {4, 0, 2};
+  uint8_t small_labels[3] = {1, 3, 0};
+  auto int_labels = std::make_shared<Tensor>(TensorShape({3}), DataType(DataType::DE_INT32),
+                                             reinterpret_cast<unsigned char *>(labels));
+  auto uint_labels = std::make_shared<Tensor>(TensorShape({3}), DataType(DataType::DE_UINT8), small_labels);
+  auto scalar_label = std::make_shared<Tensor>(TensorShape::CreateScalar(), DataType(DataType::DE_INT32),
+                                               reinterpret_cast<unsigned char *>(labels));
+
+  OneHotOp one_hot(5);
+  CheckBatch(&one_hot, {int_labels, uint_labels, scalar_label, int_labels});
+  TensorRow output;
+  OneHotOp too_few_classes(4);
+  ASSERT_FALSE(too_few_classes.ComputeBatch({uint_labels, int_labels}, &output).IsOk());
+  int32_t negative = -1;
+  auto negative_label = std::make_shared<Tensor>(TensorShape::CreateScalar(), DataType(DataType::DE_INT32),
+                                                 reinterpret_cast<unsigned char *>(&negative));
+  ASSERT_FALSE(one_hot.ComputeBatch({negative_label}, &output).IsOk());
+
+  // Rows of different types pick their own cast
+  TensorRow mixed = {int_labels, int_labels, uint_labels, input_tensor_};
+  for (auto type : {DataType::DE_FLOAT16, DataType::DE_FLOAT32, DataType::DE_INT64, DataType::DE_UINT8}) {
+    TypeCastOp cast{DataType(type)};
+    CheckBatch(&cast, mixed);
+  }
+  std::shared_ptr<Tensor> as_float;
+  ASSERT_TRUE(TypeCastOp(DataType(DataType::DE_FLOAT32)).Compute(input_tensor_, &as_float).IsOk());
+  TypeCastOp to_half{DataType(DataType::DE_FLOAT16)};
+  CheckBatch(&to_half, {as_float, as_float});
+}
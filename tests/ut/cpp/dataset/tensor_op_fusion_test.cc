@@ -0,0 +1,159 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cmath>
+#include <cstring>
+#include "common/common.h"
+#include "common/cvop_common.h"
+#include "dataset/core/config_manager.h"
+#include "dataset/core/global_context.h"
+#include "dataset/engine/datasetops/map_op.h"
+#include "dataset/kernels/data/data_utils.h"
+#include "dataset/kernels/data/type_cast_op.h"
+#include "dataset/kernels/image/decode_op.h"
+#include "dataset/kernels/image/hwc_to_chw_op.h"
+#include "dataset/kernels/image/normalize_hwc_to_chw_op.h"
+#include "dataset/kernels/image/normalize_op.h"
+#include "dataset/kernels/image/random_crop_and_resize_op.h"
+#include "dataset/kernels/image/random_crop_decode_resize_op.h"
+#include "dataset/kernels/image/random_horizontal_flip_op.h"
+#include "dataset/kernels/image/random_vertical_flip_op.h"
+#include "dataset/kernels/image/rescale_op.h"
+#include "dataset/kernels/tensor_op_fusion.h"
+#include "utils/log_adapter.h"
+
+using namespace mindspore::dataset;
+using mindspore::MsLogLevel::INFO;
+using mindspore::ExceptionType::NoExceptionType;
+using mindspore::LogStream;
+
+class MindDataTestTensorOpFusion : public UT::CVOP::CVOpCommon {
+ public:
+  MindDataTestTensorOpFusion() : CVOpCommon() {}
+
+  // Decode, random crop, random flip, normalize, transpose and cast, as in an ImageNet training pipeline
+  static std::vector<std::shared_ptr<TensorOp>> TrainOps() {
+    return {std::make_shared<DecodeOp>(true),
+            std::make_shared<RandomCropAndResizeOp>(224, 224),
+            std::make_shared<RandomHorizontalFlipOp>(0.5),
+            std::make_shared<NormalizeOp>(121.0, 115.0, 100.0, 70.0, 68.0, 71.0),
+            std::make_shared<HwcToChwOp>(),
+            std::make_shared<TypeCastOp>(DataType(DataType::DE_FLOAT16))};
+  }
+
+  static Status Run(const std::vector<std::shared_ptr<TensorOp>> &ops, std::shared_ptr<Tensor> tensor,
+                    std::shared_ptr<Tensor> *output) {
+    for (const auto &op : ops) {
+      std::shared_ptr<Tensor> result;
+      RETURN_IF_NOT_OK(op->Compute(tensor, &result));
+      tensor = std::move(result);
+    }
+    *output = std::move(tensor);
+    return Status::OK();
+  }
+
+  static std::shared_ptr<Tensor> Copy(const std::shared_ptr<Tensor> &input) {
+    std::shared_ptr<Tensor> output;
+    (void)Tensor::CreateTensor(&output, TensorImpl::kFlexible, input->shape(), input->type(), input->StartAddr());
+    return output;
+  }
+
+  static void ExpectEqual(const std::shared_ptr<Tensor> &actual, const std::shared_ptr<Tensor> &expect) {
+    ASSERT_EQ(actual->shape(), expect->shape());
+    ASSERT_EQ(actual->type(), expect->type());
+    ASSERT_EQ(memcmp(actual->StartAddr(), expect->StartAddr(), actual->SizeInBytes()), 0);
+  }
+};
+
+TEST_F(MindDataTestTensorOpFusion, TestFuseOps) {
+  MS_LOG(INFO) << "Doing MindDataTestTensorOpFusion::TestFuseOps.";
+  uint32_t seed = GlobalContext::config_manager()->seed();
+  GlobalContext::config_manager()->set_seed(42);
+  auto ops = TrainOps();
+  auto fused_ops = FuseTensorOps(TrainOps());
+  GlobalContext::config_manager()->set_seed(seed);
+  ASSERT_EQ(fused_ops.size(), 2);
+  EXPECT_NE(std::dynamic_pointer_cast<RandomCropDecodeResizeOp>(fused_ops[0]), nullptr);
+  EXPECT_NE(std::dynamic_pointer_cast<NormalizeHwcToChwOp>(fused_ops[1]), nullptr);
+
+  // The fused ops draw the same crops and flips, only the decode of the crop and the rounding differ
+  for (int i = 0; i < 10; i++) {
+    std::shared_ptr<Tensor> expect;
+    std::shared_ptr<Tensor> output;
+    ASSERT_TRUE(Run(ops, raw_input_tensor_, &expect).IsOk());
+    ASSERT_TRUE(Run(fused_ops, raw_input_tensor_, &output).IsOk());
+    ASSERT_EQ(output->shape(), expect->shape());
+    ASSERT_EQ(output->type(), expect->type());
+    double diff_sum = 0;
+    auto expect_itr = expect->begin<float16>();
+    for (auto itr = output->begin<float16>(); itr != output->end<float16>(); ++itr, ++expect_itr) {
+      diff_sum += std::fabs(static_cast<float>(*itr) - static_cast<float>(*expect_itr));
+    }
+    EXPECT_LT(diff_sum / output->Size(), 0.05);
+  }
+
+  // Chains which are not complete are kept as is
+  std::vector<std::shared_ptr<TensorOp>> partial = {std::make_shared<DecodeOp>(false),
+                                                    std::make_shared<RandomCropAndResizeOp>(224, 224),
+                                                    std::make_shared<NormalizeOp>(0, 0, 0, 1, 1, 1)};
+  EXPECT_EQ(FuseTensorOps(partial), partial);
+
+  // MapOp fuses its TensorOps unless told otherwise
+  std::shared_ptr<MapOp> map_op;
+  ASSERT_TRUE(MapOp::Builder().SetInColNames({"image"}).SetTensorFuncs(TrainOps()).Build(&map_op).IsOk());
+  EXPECT_EQ(map_op->tfuncs().size(), 2);
+  EXPECT_EQ(map_op->num_fused_ops(), 4);
+  EXPECT_EQ(map_op->allocations_avoided_per_row(), 4);
+  ASSERT_TRUE(
+    MapOp::Builder().SetInColNames({"image"}).SetTensorFuncs(TrainOps()).SetTensorOpFusion(false).Build(&map_op).IsOk());
+  EXPECT_EQ(map_op->tfuncs().size(), 6);
+  EXPECT_EQ(map_op->num_fused_ops(), 0);
+}
+
+TEST_F(MindDataTestTensorOpFusion, TestComputeInPlace) {
+  MS_LOG(INFO) << "Doing MindDataTestTensorOpFusion::TestComputeInPlace.";
+  std::shared_ptr<Tensor> input_fp32;
+  ASSERT_TRUE(TypeCast(input_tensor_, &input_fp32, DataType(DataType::DE_FLOAT32)).IsOk());
+  std::vector<std::shared_ptr<TensorOp>> ops = {std::make_shared<RescaleOp>(1.0 / 255, -0.5),
+                                                std::make_shared<NormalizeOp>(121.0, 115.0, 100.0, 70.0, 68.0, 71.0),
+                                                std::make_shared<RandomHorizontalFlipOp>(1.0),
+                                                std::make_shared<RandomVerticalFlipOp>(1.0)};
+  for (const auto &op : ops) {
+    std::shared_ptr<Tensor> expect;
+    ASSERT_TRUE(op->Compute(input_fp32, &expect).IsOk());
+    std::shared_ptr<Tensor> tensor = Copy(input_fp32);
+    bool done = false;
+    ASSERT_TRUE(op->ComputeInPlace(tensor, &done).IsOk());
+    ASSERT_TRUE(done);
+    ExpectEqual(tensor, expect);
+  }
+
+  // Flips move whole pixels of any type, the other ops change the type of a uint8 image
+  std::shared_ptr<Tensor> tensor = Copy(input_tensor_);
+  bool done = true;
+  ASSERT_TRUE(ops[0]->ComputeInPlace(tensor, &done).IsOk());
+  EXPECT_FALSE(done);
+  ASSERT_TRUE(ops[1]->ComputeInPlace(tensor, &done).IsOk());
+  EXPECT_FALSE(done);
+  ASSERT_TRUE(ops[2]->ComputeInPlace(tensor, &done).IsOk());
+  EXPECT_TRUE(done);
+  ASSERT_TRUE(ops[2]->ComputeInPlace(tensor, &done).IsOk());
+  ExpectEqual(tensor, input_tensor_);
+
+  // A TensorOp that does not override ComputeInPlace() is never done
+  HwcToChwOp hwc_to_chw;
+  ASSERT_TRUE(hwc_to_chw.ComputeInPlace(tensor, &done).IsOk());
+  EXPECT_FALSE(done);
+}
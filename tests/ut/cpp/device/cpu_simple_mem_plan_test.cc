@@ -0,0 +1,90 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <vector>
+
+#include "common/common_test.h"
+#include "device/cpu/cpu_simple_mem_plan.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+class TestCPUSimpleMemPlan : public UT::Common {
+ public:
+  TestCPUSimpleMemPlan() {}
+
+  static MemBlock Block(size_t size, size_t first_use, size_t last_use) {
+    MemBlock block;
+    block.size = size;
+    block.first_use = first_use;
+    block.last_use = last_use;
+    return block;
+  }
+
+  // Blocks used at the same time must not overlap
+  static void CheckNoOverlap(const std::vector<MemBlock> &blocks, size_t mem_size) {
+    for (size_t i = 0; i < blocks.size(); ++i) {
+      ASSERT_LE(blocks[i].offset + blocks[i].size, mem_size);
+      for (size_t j = i + 1; j < blocks.size(); ++j) {
+        bool same_time = blocks[i].first_use <= blocks[j].last_use && blocks[j].first_use <= blocks[i].last_use;
+        bool overlap = blocks[i].offset < blocks[j].offset + blocks[j].size &&
+                       blocks[j].offset < blocks[i].offset + blocks[i].size;
+        ASSERT_FALSE(same_time && overlap);
+      }
+    }
+  }
+};
+
+TEST_F(TestCPUSimpleMemPlan, test_chain) {
+  // Each kernel reads the output of the one before, two outputs are used at a time
+  std::vector<MemBlock> blocks;
+  for (size_t i = 0; i < 10; ++i) {
+    blocks.push_back(Block(1024, i, i + 1));
+  }
+  size_t mem_size = CPUSimpleMemPlan::AssignOffsets(&blocks);
+  CheckNoOverlap(blocks, mem_size);
+  ASSERT_EQ(mem_size, 2048);
+}
+
+TEST_F(TestCPUSimpleMemPlan, test_best_fit) {
+  std::vector<MemBlock> blocks = {Block(4096, 0, 1), Block(512, 0, 4), Block(1024, 0, 2),
+                                  // the memory of the first and third blocks is free, the smaller one fits
+                                  Block(1000, 3, 4), Block(4096, 3, 4), Block(100, 5, 5)};
+  size_t mem_size = CPUSimpleMemPlan::AssignOffsets(&blocks);
+  CheckNoOverlap(blocks, mem_size);
+  ASSERT_EQ(blocks[3].offset, blocks[2].offset);
+  ASSERT_EQ(blocks[4].offset, blocks[0].offset);
+  ASSERT_EQ(mem_size, 4096 + 512 + 1024);
+
+  // A block larger than the free memory at the end of the buffer grows the buffer from it
+  blocks = {Block(512, 0, 2), Block(1024, 0, 0), Block(2048, 1, 1)};
+  mem_size = CPUSimpleMemPlan::AssignOffsets(&blocks);
+  CheckNoOverlap(blocks, mem_size);
+  ASSERT_EQ(blocks[2].offset, 512);
+  ASSERT_EQ(mem_size, 512 + 2048);
+}
+
+TEST_F(TestCPUSimpleMemPlan, test_alignment) {
+  std::vector<MemBlock> blocks = {Block(3, 0, 0), Block(0, 0, 0), Block(65, 0, 0), Block(4, 0, 0)};
+  size_t mem_size = CPUSimpleMemPlan::AssignOffsets(&blocks);
+  CheckNoOverlap(blocks, mem_size);
+  for (auto &block : blocks) {
+    ASSERT_EQ(block.offset % 64, 0);
+  }
+  ASSERT_EQ(mem_size, 64 + 128 + 64);
+}
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
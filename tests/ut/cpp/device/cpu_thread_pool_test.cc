@@ -0,0 +1,87 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <atomic>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "common/common_test.h"
+#include "device/cpu/cpu_thread_pool.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+class TestCPUThreadPool : public UT::Common {
+ public:
+  TestCPUThreadPool() {}
+};
+
+TEST_F(TestCPUThreadPool, test_parallel_for) {
+  auto &thread_pool = CPUThreadPool::GetInstance();
+  ASSERT_GE(thread_pool.GetThreadNum(), 1);
+  std::vector<int> values(100000, 1);
+  std::atomic<int> sum(0);
+  std::atomic<size_t> part_num(0);
+  thread_pool.ParallelFor(values.size(), [&](size_t begin, size_t end) {
+    sum += std::accumulate(values.begin() + begin, values.begin() + end, 0);
+    part_num++;
+  });
+  ASSERT_EQ(sum, 100000);
+  ASSERT_LE(part_num, CPUThreadPool::GetIntraOpThreadNum());
+
+  // The number of parts follows the intra op thread number of the calling thread
+  CPUThreadPool::SetIntraOpThreadNum(1);
+  part_num = 0;
+  thread_pool.ParallelFor(values.size(), [&](size_t, size_t) { part_num++; });
+  ASSERT_EQ(part_num, 1);
+  CPUThreadPool::SetIntraOpThreadNum(0);
+
+  // Parts are never smaller than the minimum part size
+  thread_pool.ParallelFor(
+    values.size(), [&](size_t begin, size_t end) { ASSERT_GE(end - begin, 40000); }, 40000);
+}
+
+TEST_F(TestCPUThreadPool, test_nested_tasks) {
+  // Tasks of the pool split their own work without blocking the threads they wait for
+  auto &thread_pool = CPUThreadPool::GetInstance();
+  std::atomic<int> done(0);
+  std::atomic<size_t> total(0);
+  const int task_num = 32;
+  for (int i = 0; i < task_num; ++i) {
+    thread_pool.Submit([&]() {
+      thread_pool.ParallelFor(1000, [&](size_t begin, size_t end) { total += end - begin; });
+      done++;
+    });
+  }
+  while (done < task_num) {
+    std::this_thread::yield();
+  }
+  ASSERT_EQ(total, task_num * 1000);
+}
+
+TEST_F(TestCPUThreadPool, test_exception) {
+  auto &thread_pool = CPUThreadPool::GetInstance();
+  ASSERT_THROW(thread_pool.ParallelFor(100, [](size_t, size_t end) {
+    if (end == 100) {
+      throw std::runtime_error("last part failed");
+    }
+  }),
+               std::runtime_error);
+}
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
@@ -0,0 +1,232 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "common/common_test.h"
+#include "device/cpu/kernel/cpu_vector_ops.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+class TestCPUVectorOps : public UT::Common {
+ public:
+  TestCPUVectorOps() {}
+  void TearDown() override { SetCPUSimdLevel(CPUSimdLevel::kAvx512); }
+
+  // The levels the cpu supports, the vector loops must agree with the scalar ones on each
+  std::vector<CPUSimdLevel> SupportedLevels() {
+    std::vector<CPUSimdLevel> levels;
+    for (auto level : {CPUSimdLevel::kScalar, CPUSimdLevel::kAvx2, CPUSimdLevel::kAvx512}) {
+      SetCPUSimdLevel(level);
+      if (GetCPUSimdLevel() == level) {
+        levels.push_back(level);
+      }
+    }
+    return levels;
+  }
+
+  // Sizes around the vector widths, so that the tails are covered
+  std::vector<float> Values(size_t count, float low, float high) {
+    std::vector<float> values(count);
+    for (size_t i = 0; i < count; ++i) {
+      values[i] = low + (high - low) * static_cast<float>((i * 7919) % 1000) / 1000.0f;
+    }
+    return values;
+  }
+};
+
+namespace {
+bool Near(float actual, double expected, double tolerance) {
+  if (std::isnan(expected)) {
+    return std::isnan(actual);
+  }
+  if (std::isinf(expected)) {
+    return actual == expected;
+  }
+  return std::fabs(actual - expected) <= tolerance * (1.0 + std::fabs(expected));
+}
+}  // namespace
+
+TEST_F(TestCPUVectorOps, test_binary_broadcast) {
+  const size_t count = 37;
+  auto a = Values(count, -3.0f, 3.0f);
+  auto b = Values(count, 0.5f, 2.0f);
+  for (auto level : SupportedLevels()) {
+    SetCPUSimdLevel(level);
+    std::vector<float> out(count);
+    ElementwiseBinary(BinaryOpType::kSub, a.data(), 1, b.data(), 1, out.data(), count);
+    for (size_t i = 0; i < count; ++i) {
+      ASSERT_EQ(out[i], a[i] - b[i]);
+    }
+    ElementwiseBinary(BinaryOpType::kDiv, a.data(), 0, b.data(), 1, out.data(), count);
+    for (size_t i = 0; i < count; ++i) {
+      ASSERT_EQ(out[i], a[0] / b[i]);
+    }
+    ElementwiseBinary(BinaryOpType::kGreater, a.data(), 1, b.data(), 0, out.data(), count);
+    for (size_t i = 0; i < count; ++i) {
+      ASSERT_EQ(out[i], a[i] > b[0] ? 1.0f : 0.0f);
+    }
+    // The output may be an input
+    std::vector<float> in_place = a;
+    ElementwiseBinary(BinaryOpType::kMaximum, in_place.data(), 1, b.data(), 1, in_place.data(), count);
+    for (size_t i = 0; i < count; ++i) {
+      ASSERT_EQ(in_place[i], std::max(a[i], b[i]));
+    }
+  }
+}
+
+TEST_F(TestCPUVectorOps, test_unary_math) {
+  const size_t count = 101;
+  auto x = Values(count, -20.0f, 20.0f);
+  auto positive = Values(count, 1e-3f, 100.0f);
+  for (auto level : SupportedLevels()) {
+    SetCPUSimdLevel(level);
+    std::vector<float> out(count);
+    ElementwiseUnary(UnaryOpType::kExp, x.data(), out.data(), count);
+    for (size_t i = 0; i < count; ++i) {
+      ASSERT_TRUE(Near(out[i], std::exp(static_cast<double>(x[i])), 1e-5));
+    }
+    ElementwiseUnary(UnaryOpType::kTanh, x.data(), out.data(), count);
+    for (size_t i = 0; i < count; ++i) {
+      ASSERT_TRUE(Near(out[i], std::tanh(static_cast<double>(x[i])), 1e-5));
+    }
+    ElementwiseUnary(UnaryOpType::kSigmoid, x.data(), out.data(), count);
+    for (size_t i = 0; i < count; ++i) {
+      ASSERT_TRUE(Near(out[i], 1.0 / (1.0 + std::exp(-static_cast<double>(x[i]))), 1e-5));
+    }
+    ElementwiseUnary(UnaryOpType::kRelu6, x.data(), out.data(), count);
+    for (size_t i = 0; i < count; ++i) {
+      ASSERT_EQ(out[i], std::min(std::max(x[i], 0.0f), 6.0f));
+    }
+    ElementwiseUnary(UnaryOpType::kRelu, x.data(), out.data(), count);
+    for (size_t i = 0; i < count; ++i) {
+      ASSERT_EQ(out[i], std::max(x[i], 0.0f));
+    }
+    ElementwiseUnary(UnaryOpType::kLog, positive.data(), out.data(), count);
+    for (size_t i = 0; i < count; ++i) {
+      ASSERT_TRUE(Near(out[i], std::log(static_cast<double>(positive[i])), 1e-5));
+    }
+  }
+}
+
+TEST_F(TestCPUVectorOps, test_special_values) {
+  const float inf = std::numeric_limits<float>::infinity();
+  const float nan = std::numeric_limits<float>::quiet_NaN();
+  std::vector<float> x = {0.0f, -1.0f, inf, -inf, nan, 100.0f, -200.0f};
+  for (auto level : SupportedLevels()) {
+    SetCPUSimdLevel(level);
+    std::vector<float> out(x.size());
+    ElementwiseUnary(UnaryOpType::kLog, x.data(), out.data(), x.size());
+    ASSERT_EQ(out[0], -inf);
+    ASSERT_TRUE(std::isnan(out[1]));
+    ASSERT_EQ(out[2], inf);
+    ASSERT_TRUE(std::isnan(out[4]));
+    ElementwiseUnary(UnaryOpType::kExp, x.data(), out.data(), x.size());
+    ASSERT_EQ(out[0], 1.0f);
+    ASSERT_EQ(out[2], inf);
+    ASSERT_EQ(out[3], 0.0f);
+    ASSERT_TRUE(std::isnan(out[4]));
+    ASSERT_EQ(out[5], inf);
+    ASSERT_EQ(out[6], 0.0f);
+  }
+}
+
+TEST_F(TestCPUVectorOps, test_reduce) {
+  for (size_t count : {1, 7, 16, 33, 1000}) {
+    auto x = Values(count, -1.0f, 1.0f);
+    double sum = 0;
+    float max = -std::numeric_limits<float>::infinity();
+    for (float value : x) {
+      sum += value;
+      max = std::max(max, value);
+    }
+    for (auto level : SupportedLevels()) {
+      SetCPUSimdLevel(level);
+      ASSERT_TRUE(Near(ReduceSum(x.data(), count), sum, 1e-5));
+      ASSERT_EQ(ReduceMax(x.data(), count), max);
+    }
+  }
+}
+
+TEST_F(TestCPUVectorOps, test_optimizer_updates) {
+  const size_t count = 45;
+  auto grad = Values(count, -1.0f, 1.0f);
+  auto init = Values(count, -0.5f, 0.5f);
+  const float lr = 0.01f;
+  const float beta1 = 0.9f;
+  const float beta2 = 0.999f;
+  const float epsilon = 1e-8f;
+  for (auto level : SupportedLevels()) {
+    SetCPUSimdLevel(level);
+    for (bool use_nesterov : {false, true}) {
+      std::vector<float> var = init;
+      std::vector<float> accum = grad;
+      MomentumUpdate(var.data(), accum.data(), grad.data(), lr, beta1, use_nesterov, count);
+      for (size_t i = 0; i < count; ++i) {
+        double new_accum = static_cast<double>(grad[i]) * beta1 + grad[i];
+        double delta = use_nesterov ? (grad[i] + new_accum * beta1) * lr : new_accum * lr;
+        ASSERT_TRUE(Near(accum[i], new_accum, 1e-6));
+        ASSERT_TRUE(Near(var[i], init[i] - delta, 1e-6));
+      }
+
+      var = init;
+      std::vector<float> m = grad;
+      std::vector<float> v(count, 0.25f);
+      AdamUpdate(var.data(), m.data(), v.data(), grad.data(), lr, beta1, beta2, epsilon, use_nesterov, count);
+      for (size_t i = 0; i < count; ++i) {
+        double g = grad[i];
+        double new_m = g * beta1 + g * (1 - beta1);
+        double new_v = 0.25 * beta2 + g * g * (1 - beta2);
+        double numerator = use_nesterov ? new_m * beta1 + g * (1 - beta1) : new_m;
+        ASSERT_TRUE(Near(m[i], new_m, 1e-6));
+        ASSERT_TRUE(Near(v[i], new_v, 1e-6));
+        ASSERT_TRUE(Near(var[i], init[i] - lr * numerator / (std::sqrt(new_v) + epsilon), 1e-5));
+      }
+    }
+  }
+}
+
+TEST_F(TestCPUVectorOps, test_select_and_cast) {
+  const size_t count = 19;
+  auto x = Values(count, -9.0f, 9.0f);
+  std::vector<float> y(count, 0.5f);
+  std::vector<float> cond(count);
+  for (size_t i = 0; i < count; ++i) {
+    cond[i] = i % 3 == 0 ? 1.0f : 0.0f;
+  }
+  for (auto level : SupportedLevels()) {
+    SetCPUSimdLevel(level);
+    std::vector<float> out(count);
+    ElementwiseSelect(cond.data(), x.data(), y.data(), out.data(), count);
+    for (size_t i = 0; i < count; ++i) {
+      ASSERT_EQ(out[i], i % 3 == 0 ? x[i] : y[i]);
+    }
+    std::vector<int32_t> ints(count);
+    CastFloatToInt(x.data(), ints.data(), count);
+    CastIntToFloat(ints.data(), out.data(), count);
+    for (size_t i = 0; i < count; ++i) {
+      ASSERT_EQ(ints[i], static_cast<int32_t>(x[i]));
+      ASSERT_EQ(out[i], static_cast<float>(ints[i]));
+    }
+  }
+}
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
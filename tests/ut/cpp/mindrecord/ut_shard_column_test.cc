@@ -0,0 +1,138 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "utils/log_adapter.h"
+#include "mindrecord/include/shard_column.h"
+#include "ut_common.h"
+
+using mindspore::LogStream;
+using mindspore::ExceptionType::NoExceptionType;
+using mindspore::MsLogLevel::INFO;
+
+namespace mindspore {
+namespace mindrecord {
+class TestShardColumn : public UT::Common {
+ public:
+  TestShardColumn() {}
+
+  void SetUp() override {
+    json desc = R"({"id": {"type": "int32"}, "size": {"type": "int64"}, "score": {"type": "float32"},
+                    "ratio": {"type": "float64"}, "name": {"type": "string"}, "data": {"type": "bytes"}})"_json;
+    schema_ = Schema::Build("column", desc);
+  }
+
+  std::shared_ptr<Schema> schema_;
+};
+
+TEST_F(TestShardColumn, TestBinaryRow) {
+  MS_LOG(INFO) << FormatInfo("Test binary label format round trip");
+  ShardColumn codec(schema_);
+  json row = {{"id", -3}, {"size", 1LL << 40}, {"score", 0.5}, {"ratio", 0.25}, {"name", "cat"}};
+  std::vector<uint8_t> bin;
+  ASSERT_EQ(codec.SerializeRow(row, &bin), SUCCESS);
+  ASSERT_EQ(bin[0], kBinaryRowMarker);
+  // marker, 4 + 8 + 4 + 8 bytes of numbers, 8 bytes of length and 3 characters
+  ASSERT_EQ(bin.size(), 1 + 24 + 8 + 3);
+
+  json decoded;
+  ASSERT_EQ(codec.DeserializeRow(bin.data(), bin.size(), &decoded), SUCCESS);
+  ASSERT_EQ(decoded, row);
+
+  // Truncated rows fail
+  ASSERT_EQ(codec.DeserializeRow(bin.data(), bin.size() - 1, &decoded), FAILED);
+
+  // Rows which don't fit the schema are not serialized
+  ASSERT_EQ(codec.SerializeRow(json{{"id", 0}}, &bin), FAILED);
+  json wrong_type = row;
+  wrong_type["id"] = "3";
+  ASSERT_EQ(codec.SerializeRow(wrong_type, &bin), FAILED);
+  json out_of_range = row;
+  out_of_range["id"] = 1LL << 40;
+  ASSERT_EQ(codec.SerializeRow(out_of_range, &bin), FAILED);
+}
+
+TEST_F(TestShardColumn, TestMsgpackRow) {
+  MS_LOG(INFO) << FormatInfo("Test decoding msgpack rows of older files");
+  ShardColumn codec(schema_);
+  json row = {{"id", 7}, {"size", 8}, {"score", 1.5}, {"ratio", 2.5}, {"name", "dog"}};
+  std::vector<uint8_t> bin = json::to_msgpack(row);
+  json decoded;
+  ASSERT_EQ(codec.DeserializeRow(bin.data(), bin.size(), &decoded), SUCCESS);
+  ASSERT_EQ(decoded, row);
+
+  ShardColumn columns(schema_);
+  ASSERT_EQ(columns.AppendRow(bin.data(), bin.size()), SUCCESS);
+  ASSERT_EQ(columns.num_rows(), 1);
+  ASSERT_EQ(columns.GetRowJson(0), row);
+}
+
+TEST_F(TestShardColumn, TestColumnValues) {
+  MS_LOG(INFO) << FormatInfo("Test typed access to the columns");
+  ShardColumn codec(schema_);
+  ShardColumn columns(schema_, {"name", "id"});
+  ASSERT_EQ(columns.get_column_names(), std::vector<std::string>({"name", "id"}));
+  ASSERT_EQ(columns.GetColumnId("score"), -1);
+  ASSERT_EQ(columns.GetColumnType(columns.GetColumnId("id")), ColumnInt32);
+
+  for (int i = 0; i < 10; ++i) {
+    json row = {{"id", i}, {"size", i}, {"score", i}, {"ratio", i}, {"name", std::string(i, 'a')}};
+    std::vector<uint8_t> bin;
+    ASSERT_EQ(codec.SerializeRow(row, &bin), SUCCESS);
+    ASSERT_EQ(columns.AppendRow(bin.data(), bin.size()), SUCCESS);
+  }
+  ASSERT_EQ(columns.num_rows(), 10);
+
+  for (uint64_t i = 0; i < 10; ++i) {
+    const uint8_t *data = nullptr;
+    uint64_t n_bytes = 0;
+    ASSERT_EQ(columns.GetColumnValue(i, columns.GetColumnId("id"), &data, &n_bytes), SUCCESS);
+    int32_t id = 0;
+    ASSERT_EQ(n_bytes, sizeof(id));
+    memcpy(&id, data, n_bytes);
+    ASSERT_EQ(id, i);
+    ASSERT_EQ(columns.GetColumnValue(i, columns.GetColumnId("name"), &data, &n_bytes), SUCCESS);
+    ASSERT_EQ(std::string(reinterpret_cast<const char *>(data), n_bytes), std::string(i, 'a'));
+    ASSERT_EQ(columns.GetRowJson(i), json({{"id", i}, {"name", std::string(i, 'a')}}));
+  }
+  const uint8_t *data = nullptr;
+  uint64_t n_bytes = 0;
+  ASSERT_EQ(columns.GetColumnValue(10, 0, &data, &n_bytes), FAILED);
+}
+
+TEST_F(TestShardColumn, TestTextRow) {
+  MS_LOG(INFO) << FormatInfo("Test appending fields of the index as text");
+  ShardColumn columns(schema_, {"id", "ratio", "name"});
+  ASSERT_EQ(columns.AppendRow({"id", "ratio", "name"}, {"0", "64", "", "-12", "0.125", "bird"}, 3), SUCCESS);
+  ASSERT_EQ(columns.GetRowJson(0), json({{"id", -12}, {"ratio", 0.125}, {"name", "bird"}}));
+}
+
+TEST_F(TestShardColumn, TestExtraFields) {
+  MS_LOG(INFO) << FormatInfo("Test fields kept as json");
+  ShardColumn columns(schema_, {"id", "data"});
+  json row = {{"id", 1}, {"data", {1, 2, 3}}, {"other", "x"}};
+  std::vector<uint8_t> bin = json::to_msgpack(row);
+  ASSERT_EQ(columns.AppendRow(bin.data(), bin.size()), SUCCESS);
+  ASSERT_EQ(columns.GetRowJson(0), json({{"id", 1}, {"data", {1, 2, 3}}}));
+}
+}  // namespace mindrecord
+}  // namespace mindspore
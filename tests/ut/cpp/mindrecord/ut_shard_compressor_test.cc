@@ -0,0 +1,173 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "common/utils.h"
+#include "gtest/gtest.h"
+#include "utils/log_adapter.h"
+#include "mindrecord/include/shard_compressor.h"
+#include "mindrecord/include/shard_index_generator.h"
+#include "mindrecord/include/shard_reader.h"
+#include "mindrecord/include/shard_writer.h"
+#include "ut_common.h"
+
+using mindspore::LogStream;
+using mindspore::ExceptionType::NoExceptionType;
+using mindspore::MsLogLevel::INFO;
+
+namespace mindspore {
+namespace mindrecord {
+class TestShardCompressor : public UT::Common {
+ public:
+  TestShardCompressor() {}
+
+  // A feature vector like blob: small integers stored as floats, with repeated runs
+  static std::vector<uint8_t> FeatureBlob(int row, int n_values) {
+    std::vector<float> values(n_values);
+    for (int i = 0; i < n_values; ++i) {
+      values[i] = static_cast<float>((i / 8 + row) % 16);
+    }
+    auto bytes = reinterpret_cast<const uint8_t *>(values.data());
+    return std::vector<uint8_t>(bytes, bytes + n_values * sizeof(float));
+  }
+
+  static void RoundTrip(CompressionType compression, const std::vector<uint8_t> &data, std::vector<uint8_t> *out) {
+    ASSERT_EQ(ShardCompressor::Compress(compression, data.data(), data.size(), out), SUCCESS);
+    std::vector<uint8_t> raw;
+    ASSERT_EQ(ShardCompressor::Uncompress(compression, out->data(), out->size(), &raw), SUCCESS);
+    ASSERT_EQ(raw, data);
+  }
+};
+
+TEST_F(TestShardCompressor, TestRoundTrip) {
+  for (auto compression : {kCompressionLz4, kCompressionZstd}) {
+    MS_LOG(INFO) << FormatInfo("Test " + ShardCompressor::GetCompressionName(compression) + " codec round trip");
+    std::vector<uint8_t> compressed;
+
+    auto feature = FeatureBlob(3, 4096);
+    RoundTrip(compression, feature, &compressed);
+    ASSERT_LT(compressed.size(), feature.size() / 4);
+
+    std::vector<uint8_t> run(100000, 7);
+    RoundTrip(compression, run, &compressed);
+    ASSERT_LT(compressed.size(), run.size() / 100);
+
+    // Random data does not shrink and is stored as is
+    std::mt19937 gen(1);
+    std::vector<uint8_t> noise(5000);
+    for (auto &byte : noise) {
+      byte = static_cast<uint8_t>(gen());
+    }
+    RoundTrip(compression, noise, &compressed);
+    ASSERT_EQ(compressed.size(), kInt64Len + noise.size());
+
+    // Blobs shorter than a match
+    RoundTrip(compression, std::vector<uint8_t>(), &compressed);
+    RoundTrip(compression, std::vector<uint8_t>{1, 2, 3, 1, 2, 3, 1, 2, 3}, &compressed);
+  }
+}
+
+TEST_F(TestShardCompressor, TestBrokenBlob) {
+  for (auto compression : {kCompressionLz4, kCompressionZstd}) {
+    MS_LOG(INFO) << FormatInfo("Test " + ShardCompressor::GetCompressionName(compression) + " codec on broken blobs");
+    auto feature = FeatureBlob(0, 1024);
+    std::vector<uint8_t> compressed;
+    ASSERT_EQ(ShardCompressor::Compress(compression, feature.data(), feature.size(), &compressed), SUCCESS);
+
+    std::vector<uint8_t> raw;
+    ASSERT_EQ(ShardCompressor::Uncompress(compression, compressed.data(), compressed.size() - 1, &raw), FAILED);
+    ASSERT_EQ(ShardCompressor::Uncompress(compression, compressed.data(), kInt64Len - 1, &raw), FAILED);
+    // The uncompressed size no longer matches the data
+    compressed[0]++;
+    ASSERT_EQ(ShardCompressor::Uncompress(compression, compressed.data(), compressed.size(), &raw), FAILED);
+  }
+
+  ASSERT_EQ(ShardCompressor::GetCompressionType("lz4").second, kCompressionLz4);
+  ASSERT_EQ(ShardCompressor::GetCompressionType("zstd").second, kCompressionZstd);
+  ASSERT_EQ(ShardCompressor::GetCompressionType("gzip").first, FAILED);
+}
+
+TEST_F(TestShardCompressor, TestCompressedFile) {
+  MS_LOG(INFO) << FormatInfo("Test write and read compressed blob pages");
+  const int kNumRows = 200;
+  const int kNumValues = 8192;
+  std::string file_name = "./compressed.mindrecord";
+  std::vector<std::uint64_t> file_sizes;
+  for (const auto &compression : std::vector<std::string>{"none", "lz4", "zstd"}) {
+    remove(common::SafeCStr(file_name));
+    remove(common::SafeCStr(file_name + ".db"));
+    json schema_json = R"({"label": {"type": "int32"}, "data": {"type": "bytes"}})"_json;
+    ShardHeader header_data;
+    (void)header_data.AddSchema(Schema::Build("feature", schema_json));
+    {
+      ShardWriter fw;
+      ASSERT_EQ(fw.Open({file_name}), SUCCESS);
+      ASSERT_EQ(fw.set_compression(compression), SUCCESS);
+      ASSERT_EQ(fw.set_header_size(1 << 16), SUCCESS);
+      ASSERT_EQ(fw.set_page_size(1 << 20), SUCCESS);
+      ASSERT_EQ(fw.SetShardHeader(std::make_shared<ShardHeader>(header_data)), SUCCESS);
+      std::map<std::uint64_t, std::vector<json>> raw_data;
+      std::vector<std::vector<uint8_t>> blob_data;
+      for (int i = 0; i < kNumRows; ++i) {
+        raw_data[0].push_back(json{{"label", i}});
+        blob_data.push_back(FeatureBlob(i, kNumValues));
+      }
+      ASSERT_EQ(fw.WriteRawData(raw_data, blob_data), SUCCESS);
+      ASSERT_EQ(fw.Commit(), SUCCESS);
+    }
+    ShardIndexGenerator sg{file_name};
+    sg.Build();
+    sg.WriteToDatabase();
+
+    std::ifstream in(common::SafeCStr(file_name), std::ios::in | std::ios::binary | std::ios::ate);
+    file_sizes.push_back(static_cast<std::uint64_t>(in.tellg()));
+
+    // Row and block reader deliver the uncompressed blob data
+    for (bool block_reader : {false, true}) {
+      ShardReader dataset;
+      ASSERT_EQ(dataset.Open(file_name, 4, {"label"}, {}, block_reader), SUCCESS);
+      ASSERT_EQ(dataset.get_compressed(), compression != "none");
+      ASSERT_EQ(dataset.Launch(), SUCCESS);
+      int num_rows = 0;
+      while (true) {
+        auto x = dataset.GetNext();
+        if (x.empty()) break;
+        for (auto &row : x) {
+          int label = std::get<1>(row)["label"];
+          ASSERT_EQ(std::get<0>(row), FeatureBlob(label, kNumValues));
+          num_rows++;
+        }
+      }
+      dataset.Close();
+      ASSERT_EQ(num_rows, kNumRows);
+    }
+  }
+  MS_LOG(INFO) << "File size without compression: " << file_sizes[0] << ", with lz4: " << file_sizes[1]
+               << ", with zstd: " << file_sizes[2];
+  ASSERT_LT(file_sizes[1], file_sizes[0] / 2);
+  ASSERT_LT(file_sizes[2], file_sizes[0] / 2);
+  remove(common::SafeCStr(file_name));
+  remove(common::SafeCStr(file_name + ".db"));
+}
+}  // namespace mindrecord
+}  // namespace mindspore
@@ -33,6 +33,7 @@
 #include "mindrecord/include/shard_index_generator.h"
 #include "mindrecord/include/shard_index.h"
 #include "mindrecord/include/shard_statistics.h"
+#include "mindrecord/include/shard_writer.h"
 #include "securec.h"
 #include "ut_common.h"
 
@@ -51,6 +52,58 @@ namespace mindrecord {
 class TestShardIndexGenerator : public UT::Common {
  public:
   TestShardIndexGenerator() {}
+
+  // Writes rows over many small pages, builds their index with the given scan workers and returns its rows
+  std::vector<std::string> BuildIndex(int num_scan_workers) {
+    std::vector<std::string> file_names = {"./index_generator.shard01", "./index_generator.shard02"};
+    for (const auto &file_name : file_names) {
+      (void)remove(common::SafeCStr(file_name));
+      (void)remove(common::SafeCStr(file_name + ".db"));
+    }
+    json schema_json = R"({"id": {"type": "int32"}, "name": {"type": "string"}, "data": {"type": "bytes"}})"_json;
+    ShardHeader header_data;
+    int schema_id = header_data.AddSchema(Schema::Build("index", schema_json));
+    header_data.AddIndexFields(std::vector<std::pair<uint64_t, std::string>>{{schema_id, "id"}, {schema_id, "name"}});
+
+    std::map<uint64_t, std::vector<json>> raw_data;
+    std::vector<std::vector<uint8_t>> blob_data;
+    for (int i = 0; i < 5000; ++i) {
+      raw_data[schema_id].push_back(json{{"id", i}, {"name", "name_" + std::to_string(i % 13)}});
+      blob_data.emplace_back(100, static_cast<uint8_t>(i));
+    }
+    ShardWriter writer;
+    EXPECT_EQ(writer.Open(file_names), SUCCESS);
+    EXPECT_EQ(writer.set_header_size(1 << 22), SUCCESS);
+    EXPECT_EQ(writer.set_page_size(1 << 15), SUCCESS);
+    EXPECT_EQ(writer.SetShardHeader(std::make_shared<ShardHeader>(header_data)), SUCCESS);
+    EXPECT_EQ(writer.WriteRawData(raw_data, blob_data), SUCCESS);
+    EXPECT_EQ(writer.Commit(), SUCCESS);
+
+    ShardIndexGenerator generator(file_names[0]);
+    EXPECT_EQ(generator.Build(), SUCCESS);
+    generator.set_num_scan_workers(num_scan_workers);
+    EXPECT_EQ(generator.WriteToDatabase(), SUCCESS);
+
+    std::vector<std::string> rows;
+    for (const auto &file_name : file_names) {
+      sqlite3 *db = nullptr;
+      EXPECT_EQ(sqlite3_open_v2(common::SafeCStr(file_name + ".db"), &db, SQLITE_OPEN_READONLY, nullptr), SQLITE_OK);
+      sqlite3_stmt *stmt = nullptr;
+      EXPECT_EQ(sqlite3_prepare_v2(db, "SELECT * FROM INDEXES ORDER BY ROW_ID;", -1, &stmt, nullptr), SQLITE_OK);
+      while (sqlite3_step(stmt) == SQLITE_ROW) {
+        std::string row;
+        for (int i = 0; i < sqlite3_column_count(stmt); ++i) {
+          row += std::string(reinterpret_cast<const char *>(sqlite3_column_text(stmt, i))) + "|";
+        }
+        rows.push_back(row);
+      }
+      (void)sqlite3_finalize(stmt);
+      (void)sqlite3_close(db);
+      (void)remove(common::SafeCStr(file_name));
+      (void)remove(common::SafeCStr(file_name + ".db"));
+    }
+    return rows;
+  }
 };
 
 /*
@@ -113,5 +166,13 @@ TEST_F(TestShardIndexGenerator, TakeFieldType) {
   auto type5 = ShardIndexGenerator::TakeFieldType("label", schema2);
   ASSERT_EQ("array", type5);
 }
+
+TEST_F(TestShardIndexGenerator, ParallelBuild) {
+  MS_LOG(INFO) << FormatInfo("Test ShardIndexGenerator: build index with pages scanned concurrently");
+
+  auto rows = BuildIndex(1);
+  ASSERT_EQ(rows.size(), 5000);
+  ASSERT_EQ(BuildIndex(4), rows);
+}
 }  // namespace mindrecord
 }  // namespace mindspore
@@ -0,0 +1,111 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "utils/log_adapter.h"
+#include "mindrecord/include/shard_io_engine.h"
+#include "ut_common.h"
+
+using mindspore::LogStream;
+using mindspore::ExceptionType::NoExceptionType;
+using mindspore::MsLogLevel::INFO;
+
+namespace mindspore {
+namespace mindrecord {
+class TestShardIoEngine : public UT::Common {
+ public:
+  TestShardIoEngine() {}
+
+  // Reads random ranges of a file, with the queue of the engine full, and checks them against the file content
+  void ReadRanges(bool try_io_uring) {
+    const std::string file_name = "./io_engine_test.bin";
+    std::vector<uint8_t> content(1 << 20);
+    for (size_t i = 0; i < content.size(); ++i) {
+      content[i] = static_cast<uint8_t>(i * 31 + i / 251);
+    }
+    std::ofstream out(file_name, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char *>(content.data()), content.size());
+    out.close();
+    int fd = open(file_name.c_str(), O_RDONLY);
+    ASSERT_GE(fd, 0);
+
+    const int kQueueDepth = 8;
+    const uint64_t kNumReads = 100;
+    auto engine = ShardIoEngine::Create(kQueueDepth, try_io_uring);
+    ASSERT_NE(engine, nullptr);
+    MS_LOG(INFO) << "Io engine on " << engine->name();
+
+    std::map<uint64_t, std::vector<uint8_t>> buffers;
+    std::map<uint64_t, uint64_t> offsets;
+    uint64_t submitted = 0;
+    uint64_t reaped = 0;
+    while (reaped < kNumReads) {
+      while (engine->in_flight() < engine->queue_depth() && submitted < kNumReads) {
+        uint64_t offset = (submitted * 7919) % (content.size() / 2);
+        uint64_t length = (submitted % 10 == 0) ? 0 : (submitted * 104729) % 65536;
+        buffers[submitted].resize(length);
+        offsets[submitted] = offset;
+        ASSERT_EQ(engine->Submit(fd, offset, length, buffers[submitted].data(), submitted), SUCCESS);
+        submitted++;
+      }
+      // The queue is full
+      uint8_t byte = 0;
+      if (submitted < kNumReads) {
+        ASSERT_EQ(engine->Submit(fd, 0, 1, &byte, kNumReads), FAILED);
+      }
+      uint64_t tag = 0;
+      ASSERT_EQ(engine->Reap(&tag), SUCCESS);
+      auto &buffer = buffers[tag];
+      ASSERT_EQ(memcmp(buffer.data(), content.data() + offsets[tag], buffer.size()), 0);
+      (void)buffers.erase(tag);
+      reaped++;
+    }
+    ASSERT_EQ(engine->in_flight(), 0);
+
+    // A read past the end of file fails
+    std::vector<uint8_t> buffer(100);
+    ASSERT_EQ(engine->Submit(fd, content.size() - 10, buffer.size(), buffer.data(), 0), SUCCESS);
+    uint64_t tag = 1;
+    ASSERT_EQ(engine->Reap(&tag), FAILED);
+    ASSERT_EQ(tag, 0);
+    ASSERT_EQ(memcmp(buffer.data(), content.data() + content.size() - 10, 10), 0);
+
+    (void)close(fd);
+    (void)remove(file_name.c_str());
+  }
+};
+
+TEST_F(TestShardIoEngine, TestIoUring) {
+  MS_LOG(INFO) << FormatInfo("Test io engine on io_uring, or on thread pool if io_uring is not supported");
+  ReadRanges(true);
+}
+
+TEST_F(TestShardIoEngine, TestThreadPool) {
+  MS_LOG(INFO) << FormatInfo("Test io engine on thread pool");
+  ReadRanges(false);
+}
+}  // namespace mindrecord
+}  // namespace mindspore
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <chrono>
 #include <cstring>
 #include <functional>
 #include <iostream>
@@ -37,6 +38,40 @@ namespace mindrecord {
 class TestShardReader : public UT::Common {
  public:
   TestShardReader() {}
+
+  // Reads num_epochs epochs of file_name, with blocking reads if io_depth is 0, and logs MB/s and samples/s.
+  // Returns the number of rows and of blob bytes read.
+  std::pair<int64_t, int64_t> ReadAll(const std::string &file_name, bool block_reader, int io_depth, int num_epochs) {
+    auto column_list = std::vector<std::string>{"label"};
+    ShardReader dataset;
+    EXPECT_EQ(dataset.Open(file_name, 4, column_list, {}, block_reader), SUCCESS);
+    dataset.set_io_depth(io_depth);
+    EXPECT_EQ(dataset.Launch(), SUCCESS);
+
+    int64_t num_rows = 0;
+    int64_t num_bytes = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int epoch = 0; epoch < num_epochs; ++epoch) {
+      while (true) {
+        auto x = dataset.GetNext();
+        if (x.empty()) break;
+        for (auto& j : x) {
+          num_rows++;
+          num_bytes += std::get<0>(j).size();
+        }
+      }
+      if (block_reader) {
+        dataset.Reset();
+      }
+    }
+    auto end = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(end - start).count();
+    MS_LOG(INFO) << (block_reader ? "Block" : "Row") << " reader, " << io_depth << " reads in flight: " << num_rows
+                 << " samples in " << seconds << " s, " << num_bytes / seconds / 1048576 << " MB/s, "
+                 << num_rows / seconds << " samples/s.";
+    dataset.Close();
+    return std::make_pair(num_rows, num_bytes);
+  }
 };
 
 TEST_F(TestShardReader, TestShardReaderGeneral) {
@@ -109,6 +144,43 @@ TEST_F(TestShardReader, TestShardReaderBlock) {
   dataset.Close();
 }
 
+TEST_F(TestShardReader, TestShardReaderMmap) {
+  MS_LOG(INFO) << FormatInfo("Test read imageNet with mmap way");
+  std::string file_name = "./imagenet.shard01";
+  auto column_list = std::vector<std::string>{"file_name", "label"};
+
+  ShardReader dataset;
+  dataset.Open(file_name, 4, column_list);
+  dataset.Launch(true);
+  ShardReader mapped_dataset;
+  const bool kBlockReader = false;
+  const bool kUseMmap = true;
+  ASSERT_EQ(mapped_dataset.Open(file_name, 4, column_list, {}, kBlockReader, kUseMmap), SUCCESS);
+  ASSERT_TRUE(mapped_dataset.get_use_mmap());
+  mapped_dataset.Launch(true);
+  ASSERT_EQ(dataset.get_num_rows(), mapped_dataset.get_num_rows());
+
+  // The views into the mapped files hold the same bytes as the rows read through the file streams
+  int64_t row_id = 0;
+  while (true) {
+    auto x = dataset.GetNextById(row_id, 0);
+    auto y = mapped_dataset.GetNextViewById(row_id);
+    ASSERT_EQ(x.size(), y.size());
+    if (x.empty()) break;
+    for (size_t i = 0; i < x.size(); ++i) {
+      const auto &blob = std::get<0>(x[i]);
+      const auto &view = std::get<0>(y[i]);
+      ASSERT_EQ(blob.size(), view.second);
+      ASSERT_EQ(std::memcmp(blob.data(), view.first, view.second), 0);
+      ASSERT_EQ(std::get<1>(x[i]), std::get<1>(y[i]));
+    }
+    row_id++;
+  }
+  ASSERT_EQ(row_id, mapped_dataset.get_num_rows());
+  dataset.Close();
+  mapped_dataset.Close();
+}
+
 TEST_F(TestShardReader, TestShardReaderEasy) {
   MS_LOG(INFO) << FormatInfo("Test read imageNet");
   std::string file_name = "./imagenet.shard01";
@@ -209,5 +281,22 @@ TEST_F(TestShardReader, TestShardReaderConsumer) {
   }
   dataset.Finish();
 }
+TEST_F(TestShardReader, TestShardReaderAsyncBenchmark) {
+  MS_LOG(INFO) << FormatInfo("Test read imageNet with async io, against blocking reads");
+  std::string file_name = "./imagenet.shard01";
+  const int kIoDepth = 32;
+
+  // Row reader has no epochs, block reader goes on after Reset
+  auto blocking_rows = ReadAll(file_name, false, 0, 1);
+  auto async_rows = ReadAll(file_name, false, kIoDepth, 1);
+  ASSERT_GT(blocking_rows.first, 0);
+  ASSERT_EQ(blocking_rows, async_rows);
+
+  const int kNumEpochs = 5;
+  auto blocking_blocks = ReadAll(file_name, true, 0, kNumEpochs);
+  auto async_blocks = ReadAll(file_name, true, kIoDepth, kNumEpochs);
+  ASSERT_EQ(blocking_blocks.first, blocking_rows.first * kNumEpochs);
+  ASSERT_EQ(blocking_blocks, async_blocks);
+}
 }  // namespace mindrecord
 }  // namespace mindspore
@@ -17,7 +17,9 @@
 #include <chrono>
 #include <cstring>
 #include <dirent.h>
+#include <fstream>
 #include <iostream>
+#include <iterator>
 #include <memory>
 #include <string>
 #include <vector>
@@ -42,6 +44,52 @@ namespace mindrecord {
 class TestShardWriter : public UT::Common {
  public:
   TestShardWriter() {}
+
+  // Converts num_batches batches of synthetic rows into file_names, and logs rows/s and MB/s.
+  // Returns the content of the files.
+  std::vector<std::string> WriteAll(const std::vector<std::string> &file_names, bool async_write, bool direct_io,
+                                    int num_batches, int batch_size, int blob_size) {
+    for (const auto &file : file_names) {
+      remove(common::SafeCStr(file));
+    }
+    json schema_json = R"({"file_name": {"type": "string"}, "label": {"type": "int32"},
+                           "data": {"type": "bytes"}})"_json;
+    mindrecord::ShardHeader header_data;
+    (void)header_data.AddSchema(mindrecord::Schema::Build("convert", schema_json));
+
+    auto start = std::chrono::steady_clock::now();
+    {
+      mindrecord::ShardWriter fw;
+      fw.set_async_write(async_write);
+      fw.set_direct_io(direct_io);
+      EXPECT_EQ(fw.Open(file_names), SUCCESS);
+      EXPECT_EQ(fw.SetShardHeader(std::make_shared<mindrecord::ShardHeader>(header_data)), SUCCESS);
+      for (int batch = 0; batch < num_batches; ++batch) {
+        std::map<std::uint64_t, std::vector<json>> raw_data;
+        std::vector<std::vector<uint8_t>> blob_data;
+        for (int i = batch * batch_size; i < (batch + 1) * batch_size; ++i) {
+          raw_data[0].push_back(json{{"file_name", "image_" + std::to_string(i) + ".jpg"}, {"label", i % 1000}});
+          blob_data.emplace_back(blob_size, static_cast<uint8_t>(i));
+        }
+        EXPECT_EQ(fw.WriteRawData(raw_data, blob_data), SUCCESS);
+      }
+      EXPECT_EQ(fw.Commit(), SUCCESS);
+    }
+    auto end = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(end - start).count();
+    double num_rows = static_cast<double>(num_batches) * batch_size;
+    MS_LOG(INFO) << (async_write ? "Async" : "Sync") << " writer" << (direct_io ? " with direct io" : "") << ": "
+                 << num_rows << " samples in " << seconds << " s, " << num_rows * blob_size / seconds / 1048576
+                 << " MB/s, " << num_rows / seconds << " samples/s.";
+
+    std::vector<std::string> contents;
+    for (const auto &file : file_names) {
+      std::ifstream in(common::SafeCStr(file), std::ios::in | std::ios::binary);
+      contents.emplace_back(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+      remove(common::SafeCStr(file));
+    }
+    return contents;
+  }
 };
 
 void LoadDataFromImageNet(const std::string &directory, std::vector<json> &json_buffer, const int max_num) {
@@ -295,6 +343,24 @@ TEST_F(TestShardWriter, TestShardWriterBench) {
   }
 }
 
+TEST_F(TestShardWriter, TestShardWriterAsyncBenchmark) {
+  MS_LOG(INFO) << common::SafeCStr(FormatInfo("Test convert with async write, against blocking writes"));
+  std::vector<std::string> file_names;
+  for (int i = 1; i <= 4; i++) {
+    file_names.emplace_back(std::string("./AsyncWrite.shard0") + std::to_string(i));
+  }
+  // Batches split evenly over the shards, so the files are the same whichever way they are written
+  const int kNumBatches = 16;
+  const int kBatchSize = 128;
+  const int kBlobSize = 32 * 1024;
+  auto blocking_files = WriteAll(file_names, false, false, kNumBatches, kBatchSize, kBlobSize);
+  auto async_files = WriteAll(file_names, true, false, kNumBatches, kBatchSize, kBlobSize);
+  auto direct_files = WriteAll(file_names, true, true, kNumBatches, kBatchSize, kBlobSize);
+  ASSERT_GT(blocking_files[0].size(), static_cast<size_t>(kNumBatches) * kBatchSize * kBlobSize / 4);
+  ASSERT_EQ(blocking_files, async_files);
+  ASSERT_EQ(blocking_files, direct_files);
+}
+
 TEST_F(TestShardWriter, TestShardWriterOneSample) {
   MS_LOG(INFO) << common::SafeCStr(FormatInfo("Test write imageNet int32 of sample less than num of shards"));
   TestShardWriterImageNetOneSample();
@@ -0,0 +1,105 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "common/backend_common_test.h"
+#include "common/py_func_graph_fetcher.h"
+#include "session/anf_runtime_algorithm.h"
+#include "pre_activate/common/optimizer.h"
+#include "pre_activate/common/pass_manager.h"
+#include "pre_activate/cpu/ir_fusion/bias_add_fusion.h"
+#include "pre_activate/cpu/ir_fusion/activation_fusion.h"
+#include "pre_activate/cpu/ir_fusion/elementwise_chain_fusion.h"
+#include "utils/utils.h"
+
+namespace mindspore {
+namespace opt {
+class TestHWCPUFusion : public BackendCommon {
+ public:
+  TestHWCPUFusion() : get_py_fun_("gtest_input.pre_activate.cpu_fusion_test", true) {}
+  ~TestHWCPUFusion() override = default;
+
+  // Runs the cpu fusion passes in the order of the cpu session
+  FuncGraphPtr RunFusion(const std::string &test_name, const std::vector<std::vector<int>> &input_shapes) {
+    FuncGraphPtr g = get_py_fun_.CallAndParseRet(test_name, "before");
+    EXPECT_NE(g, nullptr);
+    AbstractBasePtrList args_spec_list;
+    for (const auto &shape : input_shapes) {
+      args_spec_list.push_back(std::make_shared<abstract::AbstractTensor>(kFloat32, shape));
+    }
+    auto kg = GetKernelGraph(g, args_spec_list);
+    auto optimizer = std::make_shared<opt::GraphOptimizer>();
+    auto pm = std::make_shared<opt::PassManager>();
+    pm->AddPass(std::make_shared<opt::BiasAddFusion>());
+    pm->AddPass(std::make_shared<opt::ActivationFusion>());
+    pm->AddPass(std::make_shared<opt::ElementwiseChainFusion>());
+    optimizer->AddPassManager(pm);
+    return optimizer->Optimize(kg);
+  }
+
+  // The node under the make_tuple output of the kernel graph
+  AnfNodePtr GetOutputNode(const FuncGraphPtr &graph) {
+    auto make_tuple = graph->output()->cast<CNodePtr>();
+    EXPECT_NE(make_tuple, nullptr);
+    return make_tuple->input(1);
+  }
+
+  UT::PyFuncGraphFetcher get_py_fun_;
+};
+
+TEST_F(TestHWCPUFusion, test_matmul_biasadd_relu_fusion) {
+  FuncGraphPtr new_graph = RunFusion("test_matmul_biasadd_relu_fusion", {{2, 3}, {3, 4}, {4}});
+  FuncGraphPtr g_after = get_py_fun_.CallAndParseRet("test_matmul_biasadd_relu_fusion", "after");
+  EXPECT_TRUE(CheckEqualGraph(g_after, new_graph));
+  auto matmul = GetOutputNode(new_graph);
+  EXPECT_TRUE(AnfAlgo::GetNodeAttr<bool>(matmul, kAttrHasBias));
+  EXPECT_EQ(AnfAlgo::GetNodeAttr<std::string>(matmul, kAttrFusedActivation), "ReLU");
+}
+
+TEST_F(TestHWCPUFusion, test_conv_biasadd_relu_fusion) {
+  FuncGraphPtr new_graph = RunFusion("test_conv_biasadd_relu_fusion", {{1, 3, 8, 8}, {4, 3, 3, 3}, {4}});
+  FuncGraphPtr g_after = get_py_fun_.CallAndParseRet("test_conv_biasadd_relu_fusion", "after");
+  EXPECT_TRUE(CheckEqualGraph(g_after, new_graph));
+  auto conv = GetOutputNode(new_graph);
+  EXPECT_TRUE(AnfAlgo::GetNodeAttr<bool>(conv, kAttrHasBias));
+  EXPECT_EQ(AnfAlgo::GetNodeAttr<std::string>(conv, kAttrFusedActivation), "ReLU");
+}
+
+TEST_F(TestHWCPUFusion, test_elementwise_chain_fusion) {
+  FuncGraphPtr new_graph = RunFusion("test_elementwise_chain_fusion", {{2, 3}, {1}, {2, 3}});
+  FuncGraphPtr g_after = get_py_fun_.CallAndParseRet("test_elementwise_chain_fusion", "after");
+  EXPECT_TRUE(CheckEqualGraph(g_after, new_graph));
+  auto fused = GetOutputNode(new_graph);
+  std::vector<std::string> ops{"Exp", "Mul", "Sub", "ReLU"};
+  std::vector<int> lhs{0, -1, -1, -1};
+  std::vector<int> rhs{-1, 1, 2, -1};
+  EXPECT_EQ(AnfAlgo::GetNodeAttr<std::vector<std::string>>(fused, kAttrFusedOps), ops);
+  EXPECT_EQ(AnfAlgo::GetNodeAttr<std::vector<int>>(fused, kAttrFusedLhs), lhs);
+  EXPECT_EQ(AnfAlgo::GetNodeAttr<std::vector<int>>(fused, kAttrFusedRhs), rhs);
+}
+
+TEST_F(TestHWCPUFusion, test_elementwise_chain_stops_at_shared_node) {
+  FuncGraphPtr new_graph = RunFusion("test_elementwise_chain_stops_at_shared_node", {{2, 3}, {2, 3}});
+  FuncGraphPtr g_after = get_py_fun_.CallAndParseRet("test_elementwise_chain_stops_at_shared_node", "after");
+  EXPECT_TRUE(CheckEqualGraph(g_after, new_graph));
+  auto fused = GetOutputNode(new_graph);
+  std::vector<std::string> ops{"Mul", "TensorAdd"};
+  std::vector<int> lhs{0, -1};
+  std::vector<int> rhs{1, 0};
+  EXPECT_EQ(AnfAlgo::GetNodeAttr<std::vector<std::string>>(fused, kAttrFusedOps), ops);
+  EXPECT_EQ(AnfAlgo::GetNodeAttr<std::vector<int>>(fused, kAttrFusedLhs), lhs);
+  EXPECT_EQ(AnfAlgo::GetNodeAttr<std::vector<int>>(fused, kAttrFusedRhs), rhs);
+}
+}  // namespace opt
+}  // namespace mindspore
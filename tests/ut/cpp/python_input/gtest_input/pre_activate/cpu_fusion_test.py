@@ -0,0 +1,95 @@
+# Copyright 2019 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+from mindspore.ops import operations as P
+from mindspore.ops import Primitive
+
+MatMul = P.MatMul()
+Conv = P.Conv2D(out_channel=4, kernel_size=3, pad_mode="valid")
+BiasAdd = P.BiasAdd()
+Relu = P.ReLU()
+Exp = P.Exp()
+Mul = P.Mul()
+Sub = P.Sub()
+Add = P.TensorAdd()
+make_tuple = Primitive('make_tuple')
+FusedElementwise = Primitive('FusedElementwise')
+
+
+class FnDict:
+    def __init__(self):
+        self.fnDict = {}
+
+    def __call__(self, fn):
+        self.fnDict[fn.__name__] = fn
+
+    def __getitem__(self, name):
+        return self.fnDict[name]
+
+
+def test_matmul_biasadd_relu_fusion(tag):
+    fns = FnDict()
+
+    @fns
+    def before(x, w, b):
+        return Relu(BiasAdd(MatMul(x, w), b))
+
+    @fns
+    def after(x, w, b):
+        return make_tuple(MatMul(x, w, b))
+
+    return fns[tag]
+
+
+def test_conv_biasadd_relu_fusion(tag):
+    fns = FnDict()
+
+    @fns
+    def before(x, w, b):
+        return Relu(BiasAdd(Conv(x, w), b))
+
+    @fns
+    def after(x, w, b):
+        return make_tuple(Conv(x, w, b))
+
+    return fns[tag]
+
+
+def test_elementwise_chain_fusion(tag):
+    fns = FnDict()
+
+    @fns
+    def before(x, y, z):
+        return Relu(Sub(Mul(Exp(x), y), z))
+
+    @fns
+    def after(x, y, z):
+        return make_tuple(FusedElementwise(x, y, z))
+
+    return fns[tag]
+
+
+def test_elementwise_chain_stops_at_shared_node(tag):
+    fns = FnDict()
+
+    @fns
+    def before(x, y):
+        exp = Exp(x)
+        return Add(Mul(exp, y), exp)
+
+    @fns
+    def after(x, y):
+        return make_tuple(FusedElementwise(Exp(x), y))
+
+    return fns[tag]
@@ -12,6 +12,9 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 # ==============================================================================
+import os
+import signal
+
 import numpy as np
 import pytest
 
@@ -391,6 +394,69 @@ def test_case_13():
         i = i + 1
 
 
+class RandomAccessSource:
+    """Source of 2x2 sequential tensors supporting random access."""
+    def __init__(self, size):
+        self.size = size
+
+    def __getitem__(self, index):
+        return (np.array([index]), np.array([[index, index + 1], [index + 2, index + 3]]))
+
+    def __len__(self):
+        return self.size
+
+
+def test_case_14():
+    """
+    Test rows read and mapped in worker processes.
+    """
+    logger.info("Test rows read and mapped in worker processes.")
+
+    # apply dataset operations
+    data1 = ds.GeneratorDataset(RandomAccessSource(256), ["col0", "col1"], num_parallel_workers=3,
+                                python_multiprocessing=True)
+    data1 = data1.map(input_columns="col1", operations=(lambda x: x * 2), num_parallel_workers=2,
+                      python_multiprocessing=True)
+
+    i = 0
+    for item in data1.create_dict_iterator():  # each data is a dictionary
+        golden = np.array([i])
+        assert np.array_equal(item["col0"], golden)
+        golden = np.array([[i * 2, (i + 1) * 2], [(i + 2) * 2, (i + 3) * 2]])
+        assert np.array_equal(item["col1"], golden)
+        i = i + 1
+    assert i == 256
+
+    # the rows follow the sampler
+    indices = [5, 3, 250, 0]
+    data2 = ds.GeneratorDataset(RandomAccessSource(256), ["col0", "col1"], sampler=indices,
+                                python_multiprocessing=True)
+    assert [int(item[0][0]) for item in data2.create_tuple_iterator()] == indices
+
+
+def test_case_15():
+    """
+    Test a worker process dying during iteration.
+    """
+    logger.info("Test a worker process dying during iteration.")
+
+    data1 = ds.GeneratorDataset(RandomAccessSource(4096), ["col0", "col1"], num_parallel_workers=2,
+                                python_multiprocessing=True)
+    killed = False
+    with pytest.raises(RuntimeError) as info:
+        for _ in data1.create_tuple_iterator():
+            if not killed:
+                os.kill(data1._generator_pool._workers[0].process.pid, signal.SIGKILL)
+                killed = True
+    assert "exited" in str(info.value)
+
+    # the next iterator still reads through the pool and reports the dead worker, rather than reading in process
+    with pytest.raises(RuntimeError) as info:
+        for _ in data1.create_tuple_iterator():
+            pass
+    assert "exited" in str(info.value)
+
+
 def test_case_error_1():
     def generator_np():
         for i in range(64):
@@ -454,6 +520,8 @@ if __name__ == "__main__":
     test_case_11()
     test_case_12()
     test_case_13()
+    test_case_14()
+    test_case_15()
     test_case_error_1()
     test_case_error_2()
     test_case_error_3()
@@ -173,6 +173,23 @@ def test_generator():
     assert data1.get_dataset_size() == 10
 
 
+def test_repeat():
+    data = ds.TFRecordDataset(FILES, SCHEMA_FILE).repeat(3)
+    assert data.get_dataset_size() == 12
+    assert data.get_repeat_count() == 3
+
+
+def test_bucket_batch_repeat():
+    def generator():
+        for i in range(1, 10):
+            yield (np.ones([i], np.int32),)
+
+    data = ds.GeneratorDataset(generator, ["data"])
+    data = data.bucket_batch_by_length("data", [4], [2, 3]).repeat(2)
+    assert data.get_dataset_size() is None
+    assert data.get_repeat_count() == 2
+
+
 if __name__ == '__main__':
     # test_compare_v1_and_2()
     # test_imagefolder()
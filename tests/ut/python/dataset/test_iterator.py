@@ -41,3 +41,40 @@ def test_case_iterator():
     check(COLUMNS[0:7])
     check(COLUMNS[7:8])
     check(COLUMNS[0:2:8])
+
+
+def test_iterator_save_state():
+    """
+    Test resuming an iterator from the state saved in the middle of an epoch
+    """
+    original_seed = ds.config.get_seed()
+    ds.config.set_seed(1)
+
+    def pipeline():
+        data = ds.TFRecordDataset(DATA_DIR, SCHEMA_DIR, columns_list=["col_sint64"], shuffle=False)
+        return data.shuffle(buffer_size=4).repeat(2)
+
+    expected = [item[0] for item in pipeline().create_tuple_iterator()]
+    assert len(expected) == 24
+
+    itr = pipeline().create_tuple_iterator()
+    for _ in range(5):
+        next(itr)
+    state = itr.save_state()
+
+    # the resumed iterator goes on with the rows following the saved ones
+    resumed = pipeline().create_tuple_iterator(state=state)
+    rows = []
+    for _ in range(10):
+        rows.append(next(resumed)[0])
+    # its own state also counts the rows skipped when it was resumed
+    state = resumed.save_state()
+    rows.extend(item[0] for item in resumed)
+    assert len(rows) == len(expected) - 5
+    assert all([np.array_equal(d1, d2) for d1, d2 in zip(rows, expected[5:])])
+
+    rows = [item[0] for item in pipeline().create_tuple_iterator(state=state)]
+    assert len(rows) == len(expected) - 15
+    assert all([np.array_equal(d1, d2) for d1, d2 in zip(rows, expected[15:])])
+
+    ds.config.set_seed(original_seed)
@@ -181,6 +181,28 @@ def test_case_6():
         i = i + 4
 
 
+def test_case_7():
+    """
+    Test PyFunc in worker processes
+    """
+    logger.info("Test PyFunc in worker processes : (lambda x : (x, x + x)), (lambda x, y : x + y)")
+
+    # apply dataset operations
+    data1 = ds.TFRecordDataset(DATA_DIR, SCHEMA_DIR, shuffle=False)
+
+    data1 = data1.map(input_columns="col0", output_columns="out",
+                      operations=[(lambda x: (x, x + x)), (lambda x, y: x + y)],
+                      num_parallel_workers=4, python_multiprocessing=True)
+
+    for _ in range(2):
+        i = 0
+        for item in data1.create_dict_iterator():  # each data is a dictionary
+            # In this test, the dataset is 2x2 sequential tensors
+            golden = np.array([[i * 3, (i + 1) * 3], [(i + 2) * 3, (i + 3) * 3]])
+            assert np.array_equal(item["out"], golden)
+            i = i + 4
+
+
 if __name__ == "__main__":
     test_case_0()
     test_case_1()
@@ -189,3 +211,4 @@ if __name__ == "__main__":
     test_case_4()
     test_case_5()
     test_case_6()
+    test_case_7()